@@ -15,7 +15,7 @@ found in the LICENSE file.
 #include "mitkCommandLineParser.h"
 #include "mitkIOUtil.h"
 
-#include <mitkArithmeticOperation.h>
+#include <mitkArithmeticExpression.h>
 
 static bool ConvertToBool(std::map<std::string, us::Any> &data, std::string name)
 {
@@ -95,70 +95,73 @@ int main(int argc, char* argv[])
   bool resultAsDouble = ConvertToBool(parsedArgs, "as-double");
   MITK_INFO << "Output image as double: " << resultAsDouble;
 
-  mitk::Image::Pointer tmpImage = image->Clone();
+  // All operations are combined into one expression, which is evaluated in a single pass
+  using Expression = mitk::ArithmeticExpression;
+  Expression expression = Expression::Input(0);
 
   if (ConvertToBool(parsedArgs, "tan"))
   {
     MITK_INFO << " Start Doing Operation: TAN()";
-    tmpImage = mitk::ArithmeticOperation::Tan(tmpImage, resultAsDouble);
+    expression = Expression::Tan(expression);
   }
   if (ConvertToBool(parsedArgs, "atan"))
   {
     MITK_INFO << " Start Doing Operation: ATAN()";
-    tmpImage = mitk::ArithmeticOperation::Atan(tmpImage, resultAsDouble);
+    expression = Expression::Atan(expression);
   }
   if (ConvertToBool(parsedArgs, "cos"))
   {
     MITK_INFO << " Start Doing Operation: COS()";
-    tmpImage = mitk::ArithmeticOperation::Cos(tmpImage, resultAsDouble);
+    expression = Expression::Cos(expression);
   }
   if (ConvertToBool(parsedArgs, "acos"))
   {
     MITK_INFO << " Start Doing Operation: ACOS()";
-    tmpImage = mitk::ArithmeticOperation::Acos(tmpImage, resultAsDouble);
+    expression = Expression::Acos(expression);
   }
   if (ConvertToBool(parsedArgs, "sin"))
   {
     MITK_INFO << " Start Doing Operation: SIN()";
-    tmpImage = mitk::ArithmeticOperation::Sin(tmpImage, resultAsDouble);
+    expression = Expression::Sin(expression);
   }
   if (ConvertToBool(parsedArgs, "asin"))
   {
     MITK_INFO << " Start Doing Operation: ASIN()";
-    tmpImage = mitk::ArithmeticOperation::Asin(tmpImage, resultAsDouble);
+    expression = Expression::Asin(expression);
   }
   if (ConvertToBool(parsedArgs, "square"))
   {
     MITK_INFO << " Start Doing Operation: SQUARE()";
-    tmpImage = mitk::ArithmeticOperation::Square(tmpImage, resultAsDouble);
+    expression = Expression::Square(expression);
   }
   if (ConvertToBool(parsedArgs, "sqrt"))
   {
     MITK_INFO << " Start Doing Operation: SQRT()";
-    tmpImage = mitk::ArithmeticOperation::Sqrt(tmpImage, resultAsDouble);
+    expression = Expression::Sqrt(expression);
   }
   if (ConvertToBool(parsedArgs, "abs"))
   {
     MITK_INFO << " Start Doing Operation: ABS()";
-    tmpImage = mitk::ArithmeticOperation::Abs(tmpImage, resultAsDouble);
+    expression = Expression::Abs(expression);
   }
   if (ConvertToBool(parsedArgs, "exp"))
   {
     MITK_INFO << " Start Doing Operation: EXP()";
-    tmpImage = mitk::ArithmeticOperation::Exp(tmpImage, resultAsDouble);
+    expression = Expression::Exp(expression);
   }
   if (ConvertToBool(parsedArgs, "expneg"))
   {
     MITK_INFO << " Start Doing Operation: EXPNEG()";
-    tmpImage = mitk::ArithmeticOperation::ExpNeg(tmpImage, resultAsDouble);
+    expression = Expression::ExpNeg(expression);
   }
   if (ConvertToBool(parsedArgs, "log10"))
   {
     MITK_INFO << " Start Doing Operation: LOG10()";
-    tmpImage = mitk::ArithmeticOperation::Log10(tmpImage, resultAsDouble);
+    expression = Expression::Log10(expression);
   }
 
-  mitk::IOUtil::Save(tmpImage, outputFilename);
+  auto resultImage = expression.Evaluate({ image }, resultAsDouble);
+  mitk::IOUtil::Save(resultImage, outputFilename);
 
   return EXIT_SUCCESS;
 }
@@ -15,7 +15,7 @@ found in the LICENSE file.
 #include "mitkCommandLineParser.h"
 #include "mitkIOUtil.h"
 
-#include <mitkArithmeticOperation.h>
+#include <mitkArithmeticExpression.h>
 
 static bool ConvertToBool(std::map<std::string, us::Any> &data, std::string name)
 {
@@ -101,30 +101,33 @@ int main(int argc, char* argv[])
   bool resultAsDouble = ConvertToBool(parsedArgs, "as-double");
   MITK_INFO << "Output image as double: " << resultAsDouble;
 
-  mitk::Image::Pointer tmpImage = image1->Clone();
+  // All operations are combined into one expression, which is evaluated in a single pass
+  using Expression = mitk::ArithmeticExpression;
+  Expression expression = Expression::Input(0);
 
   if (ConvertToBool(parsedArgs, "add"))
   {
     MITK_INFO << " Start Doing Operation: ADD()";
-    tmpImage = mitk::ArithmeticOperation::Add(tmpImage, image2, resultAsDouble);
+    expression = expression + Expression::Input(1);
   }
   if (ConvertToBool(parsedArgs, "subtract"))
   {
     MITK_INFO << " Start Doing Operation: SUB()";
-    tmpImage = mitk::ArithmeticOperation::Subtract(tmpImage, image2, resultAsDouble);
+    expression = expression - Expression::Input(1);
   }
   if (ConvertToBool(parsedArgs, "multiply"))
   {
     MITK_INFO << " Start Doing Operation: MULT()";
-    tmpImage = mitk::ArithmeticOperation::Multiply(tmpImage, image2, resultAsDouble);
+    expression = expression * Expression::Input(1);
   }
   if (ConvertToBool(parsedArgs, "divide"))
   {
     MITK_INFO << " Start Doing Operation: DIV()";
-    tmpImage = mitk::ArithmeticOperation::Divide(tmpImage, image2, resultAsDouble);
+    expression = expression / Expression::Input(1);
   }
 
-  mitk::IOUtil::Save(tmpImage, outputFilename);
+  auto resultImage = expression.Evaluate({ image1, image2 }, resultAsDouble);
+  mitk::IOUtil::Save(resultImage, outputFilename);
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,125 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkArithmeticExpression_h
+#define mitkArithmeticExpression_h
+
+#include <mitkImage.h>
+#include <MitkBasicImageProcessingExports.h>
+
+#include <memory>
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Expression tree of pixel-wise arithmetic operations on one or more images
+  *
+  * In contrast to chaining calls of ArithmeticOperation, which creates a complete intermediate image for
+  * every single operation, an expression is evaluated in a single pass over the input images. Evaluate()
+  * compiles the tree into a flat list of instructions (sub-expressions without inputs are folded into
+  * constants) and executes it block-wise in parallel, so that intermediate values only live in small,
+  * cache-resident buffers. The output pixel type is chosen once for the whole expression.
+  *
+  * \code
+  * using Expression = mitk::ArithmeticExpression;
+  * auto a = Expression::Input(0);
+  * auto b = Expression::Input(1);
+  * auto result = Expression::Sqrt(Expression::Square(a - b) + 1.0).Evaluate({imageA, imageB});
+  * \endcode
+  *
+  * All calculations are done in double precision, regardless of the input pixel types.
+  */
+  class MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression
+  {
+  public:
+    enum class OperationType
+    {
+      Input,
+      Constant,
+      Add,
+      Subtract,
+      Multiply,
+      Divide,
+      Pow,
+      Tan,
+      Atan,
+      Cos,
+      Acos,
+      Sin,
+      Asin,
+      Square,
+      Sqrt,
+      Abs,
+      Exp,
+      ExpNeg,
+      Log10
+    };
+
+    /** \brief References the pixel values of the input image with the given index (see Evaluate()). */
+    static ArithmeticExpression Input(unsigned int index);
+    static ArithmeticExpression Constant(double value);
+
+    static ArithmeticExpression Pow(const ArithmeticExpression &base, const ArithmeticExpression &exponent);
+    static ArithmeticExpression Tan(const ArithmeticExpression &expression);
+    static ArithmeticExpression Atan(const ArithmeticExpression &expression);
+    static ArithmeticExpression Cos(const ArithmeticExpression &expression);
+    static ArithmeticExpression Acos(const ArithmeticExpression &expression);
+    static ArithmeticExpression Sin(const ArithmeticExpression &expression);
+    static ArithmeticExpression Asin(const ArithmeticExpression &expression);
+    static ArithmeticExpression Square(const ArithmeticExpression &expression);
+    static ArithmeticExpression Sqrt(const ArithmeticExpression &expression);
+    static ArithmeticExpression Abs(const ArithmeticExpression &expression);
+    static ArithmeticExpression Exp(const ArithmeticExpression &expression);
+    static ArithmeticExpression ExpNeg(const ArithmeticExpression &expression);
+    static ArithmeticExpression Log10(const ArithmeticExpression &expression);
+
+    /** \brief Creates a unary (Tan, ..., Log10) or binary (Add, ..., Pow) operation. */
+    static ArithmeticExpression Operation(OperationType type, const ArithmeticExpression &operand);
+    static ArithmeticExpression Operation(OperationType type,
+                                          const ArithmeticExpression &left,
+                                          const ArithmeticExpression &right);
+
+    /** \brief Implicit conversion of constants, e.g. to write expression + 1.0. */
+    ArithmeticExpression(double value);
+
+    /** \brief Number of input images the expression requires (highest input index + 1). */
+    unsigned int GetNumberOfInputs() const;
+
+    /** \brief Evaluates the expression for every pixel of the input images.
+    *
+    * All inputs must be scalar images with identical dimensions. The output has the geometry of the first
+    * input and is of type double if outputAsDouble is true, or of the pixel type of the first input otherwise.
+    * For integral output types the results are truncated and clamped to the range of the type, NaN is stored as 0.
+    * For float outputs, results beyond the range of float are stored as infinity.
+    *
+    * \param numberOfThreads Number of work units executed in parallel. 0 uses the global ITK default.
+    * \throws mitk::Exception if the inputs do not meet the requirements.
+    */
+    Image::Pointer Evaluate(const std::vector<Image::Pointer> &inputs,
+                            bool outputAsDouble = true,
+                            unsigned int numberOfThreads = 0) const;
+
+    /** \brief Node of the expression tree (implementation detail). */
+    struct Node;
+
+  private:
+    explicit ArithmeticExpression(std::shared_ptr<const Node> node);
+
+    std::shared_ptr<const Node> m_Node;
+  };
+
+  MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator+(const ArithmeticExpression &left, const ArithmeticExpression &right);
+  MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator-(const ArithmeticExpression &left, const ArithmeticExpression &right);
+  MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator*(const ArithmeticExpression &left, const ArithmeticExpression &right);
+  MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator/(const ArithmeticExpression &left, const ArithmeticExpression &right);
+}
+#endif
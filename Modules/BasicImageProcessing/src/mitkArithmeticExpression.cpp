@@ -0,0 +1,635 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkArithmeticExpression.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+struct mitk::ArithmeticExpression::Node
+{
+  OperationType Type = OperationType::Constant;
+  unsigned int Index = 0;
+  double Value = 0.0;
+  std::shared_ptr<const Node> Left;
+  std::shared_ptr<const Node> Right;
+};
+
+namespace
+{
+  using OperationType = mitk::ArithmeticExpression::OperationType;
+
+  /** Number of pixels that are processed at once. The intermediate buffers of a block stay in the L1 cache. */
+  constexpr std::size_t BlockSize = 1024;
+
+  /** Number of blocks per parallel work item. */
+  constexpr std::size_t BlocksPerChunk = 64;
+
+  bool IsUnary(OperationType type)
+  {
+    return type >= OperationType::Tan;
+  }
+
+  bool IsBinary(OperationType type)
+  {
+    return type >= OperationType::Add && type <= OperationType::Pow;
+  }
+
+  template <typename TVisitor>
+  void VisitUnary(OperationType type, TVisitor visitor)
+  {
+    switch (type)
+    {
+      case OperationType::Tan:
+        visitor([](double x) { return std::tan(x); });
+        break;
+      case OperationType::Atan:
+        visitor([](double x) { return std::atan(x); });
+        break;
+      case OperationType::Cos:
+        visitor([](double x) { return std::cos(x); });
+        break;
+      case OperationType::Acos:
+        visitor([](double x) { return std::acos(x); });
+        break;
+      case OperationType::Sin:
+        visitor([](double x) { return std::sin(x); });
+        break;
+      case OperationType::Asin:
+        visitor([](double x) { return std::asin(x); });
+        break;
+      case OperationType::Square:
+        visitor([](double x) { return x * x; });
+        break;
+      case OperationType::Sqrt:
+        visitor([](double x) { return std::sqrt(x); });
+        break;
+      case OperationType::Abs:
+        visitor([](double x) { return std::abs(x); });
+        break;
+      case OperationType::Exp:
+        visitor([](double x) { return std::exp(x); });
+        break;
+      case OperationType::ExpNeg:
+        visitor([](double x) { return std::exp(-x); });
+        break;
+      case OperationType::Log10:
+        visitor([](double x) { return std::log10(x); });
+        break;
+      default:
+        mitkThrow() << "Operation " << static_cast<int>(type) << " is not a unary operation";
+    }
+  }
+
+  template <typename TVisitor>
+  void VisitBinary(OperationType type, TVisitor visitor)
+  {
+    switch (type)
+    {
+      case OperationType::Add:
+        visitor([](double x, double y) { return x + y; });
+        break;
+      case OperationType::Subtract:
+        visitor([](double x, double y) { return x - y; });
+        break;
+      case OperationType::Multiply:
+        visitor([](double x, double y) { return x * y; });
+        break;
+      case OperationType::Divide:
+        visitor([](double x, double y) { return x / y; });
+        break;
+      case OperationType::Pow:
+        visitor([](double x, double y) { return std::pow(x, y); });
+        break;
+      default:
+        mitkThrow() << "Operation " << static_cast<int>(type) << " is not a binary operation";
+    }
+  }
+
+  /** Single instruction of the compiled expression, operating on a stack of pixel blocks. */
+  struct Instruction
+  {
+    enum class OperandType
+    {
+      Stack,         // binary: both operands are on the stack
+      ConstantLeft,  // binary: left operand is Value, right operand is on the stack
+      ConstantRight  // binary: left operand is on the stack, right operand is Value
+    };
+
+    OperationType Type;
+    OperandType Operands;
+    unsigned int Index;
+    double Value;
+  };
+
+  struct Program
+  {
+    std::vector<Instruction> Instructions;
+    std::size_t StackSize = 0;
+  };
+
+  using ConstNodePointer = std::shared_ptr<const mitk::ArithmeticExpression::Node>;
+
+  /** Returns true and the value if the sub-expression does not depend on any input. */
+  bool EvaluateConstant(const ConstNodePointer &node, double &value)
+  {
+    if (OperationType::Input == node->Type)
+      return false;
+
+    if (OperationType::Constant == node->Type)
+    {
+      value = node->Value;
+      return true;
+    }
+
+    double left = 0.0;
+
+    if (!EvaluateConstant(node->Left, left))
+      return false;
+
+    if (IsUnary(node->Type))
+    {
+      VisitUnary(node->Type, [&value, left](auto op) { value = op(left); });
+      return true;
+    }
+
+    double right = 0.0;
+
+    if (!EvaluateConstant(node->Right, right))
+      return false;
+
+    VisitBinary(node->Type, [&value, left, right](auto op) { value = op(left, right); });
+    return true;
+  }
+
+  /** Appends the instructions of node to program. depth is the number of blocks on the stack before. */
+  void Compile(const ConstNodePointer &node, Program &program, std::size_t depth)
+  {
+    auto emit = [&program, depth](OperationType type, Instruction::OperandType operands, unsigned int index, double value) {
+      program.Instructions.push_back({type, operands, index, value});
+      program.StackSize = std::max(program.StackSize, depth + 1);
+    };
+
+    double value = 0.0;
+
+    if (EvaluateConstant(node, value))
+    {
+      emit(OperationType::Constant, Instruction::OperandType::Stack, 0, value);
+    }
+    else if (OperationType::Input == node->Type)
+    {
+      emit(OperationType::Input, Instruction::OperandType::Stack, node->Index, 0.0);
+    }
+    else if (IsUnary(node->Type))
+    {
+      Compile(node->Left, program, depth);
+      emit(node->Type, Instruction::OperandType::Stack, 0, 0.0);
+    }
+    // Constant operands of binary operations are passed as values instead of filling a block
+    else if (EvaluateConstant(node->Right, value))
+    {
+      Compile(node->Left, program, depth);
+      emit(node->Type, Instruction::OperandType::ConstantRight, 0, value);
+    }
+    else if (EvaluateConstant(node->Left, value))
+    {
+      Compile(node->Right, program, depth);
+      emit(node->Type, Instruction::OperandType::ConstantLeft, 0, value);
+    }
+    else
+    {
+      Compile(node->Left, program, depth);
+      Compile(node->Right, program, depth + 1);
+      emit(node->Type, Instruction::OperandType::Stack, 0, 0.0);
+    }
+  }
+
+  using LoadFunction = void (*)(const void *data, std::size_t offset, std::size_t count, double *values);
+  using StoreFunction = void (*)(const double *values, std::size_t offset, std::size_t count, void *data);
+
+  template <typename TPixel>
+  void LoadPixels(const void *data, std::size_t offset, std::size_t count, double *values)
+  {
+    const auto *pixels = static_cast<const TPixel *>(data) + offset;
+
+    for (std::size_t i = 0; i < count; ++i)
+      values[i] = static_cast<double>(pixels[i]);
+  }
+
+  /** Converts a result to the output pixel type. A plain conversion of NaN, infinity or values that do not
+   * fit into the type is undefined, so these are clamped to the range of the type (NaN becomes 0).*/
+  template <typename TPixel>
+  TPixel ToPixel(double value)
+  {
+    if constexpr (std::is_integral_v<TPixel>)
+    {
+      if (std::isnan(value))
+        return 0;
+
+      // max() may not be representable as double (64 bit types), in that case it is rounded up
+      if (value >= static_cast<double>(std::numeric_limits<TPixel>::max()))
+        return std::numeric_limits<TPixel>::max();
+
+      if (value <= static_cast<double>(std::numeric_limits<TPixel>::lowest()))
+        return std::numeric_limits<TPixel>::lowest();
+
+      return static_cast<TPixel>(value);
+    }
+    else
+    {
+      if (std::isfinite(value) && std::abs(value) > static_cast<double>(std::numeric_limits<TPixel>::max()))
+        return value > 0 ? std::numeric_limits<TPixel>::infinity() : -std::numeric_limits<TPixel>::infinity();
+
+      return static_cast<TPixel>(value);
+    }
+  }
+
+  template <typename TPixel>
+  void StorePixels(const double *values, std::size_t offset, std::size_t count, void *data)
+  {
+    auto *pixels = static_cast<TPixel *>(data) + offset;
+
+    for (std::size_t i = 0; i < count; ++i)
+      pixels[i] = ToPixel<TPixel>(values[i]);
+  }
+
+  struct PixelAccess
+  {
+    LoadFunction Load;
+    StoreFunction Store;
+  };
+
+  template <typename TPixel>
+  PixelAccess MakePixelAccess()
+  {
+    return {&LoadPixels<TPixel>, &StorePixels<TPixel>};
+  }
+
+  PixelAccess GetPixelAccess(const mitk::PixelType &pixelType)
+  {
+    if (pixelType.GetNumberOfComponents() != 1)
+      mitkThrow() << "Only scalar images are supported by mitk::ArithmeticExpression";
+
+    switch (pixelType.GetComponentType())
+    {
+      case itk::IOComponentEnum::UCHAR:
+        return MakePixelAccess<unsigned char>();
+      case itk::IOComponentEnum::CHAR:
+        return MakePixelAccess<signed char>();
+      case itk::IOComponentEnum::USHORT:
+        return MakePixelAccess<unsigned short>();
+      case itk::IOComponentEnum::SHORT:
+        return MakePixelAccess<short>();
+      case itk::IOComponentEnum::UINT:
+        return MakePixelAccess<unsigned int>();
+      case itk::IOComponentEnum::INT:
+        return MakePixelAccess<int>();
+      case itk::IOComponentEnum::ULONG:
+        return MakePixelAccess<unsigned long>();
+      case itk::IOComponentEnum::LONG:
+        return MakePixelAccess<long>();
+      case itk::IOComponentEnum::ULONGLONG:
+        return MakePixelAccess<unsigned long long>();
+      case itk::IOComponentEnum::LONGLONG:
+        return MakePixelAccess<long long>();
+      case itk::IOComponentEnum::FLOAT:
+        return MakePixelAccess<float>();
+      case itk::IOComponentEnum::DOUBLE:
+        return MakePixelAccess<double>();
+      default:
+        mitkThrow() << "Pixel type " << pixelType.GetComponentTypeAsString()
+                    << " is not supported by mitk::ArithmeticExpression";
+    }
+  }
+
+  void Execute(const Program &program,
+               const std::vector<const void *> &inputData,
+               const std::vector<PixelAccess> &inputAccess,
+               std::size_t offset,
+               std::size_t count,
+               double *stack)
+  {
+    std::size_t top = 0; // number of blocks on the stack
+
+    for (const auto &instruction : program.Instructions)
+    {
+      if (OperationType::Input == instruction.Type)
+      {
+        inputAccess[instruction.Index].Load(inputData[instruction.Index], offset, count, stack + top * BlockSize);
+        ++top;
+      }
+      else if (OperationType::Constant == instruction.Type)
+      {
+        std::fill_n(stack + top * BlockSize, count, instruction.Value);
+        ++top;
+      }
+      else if (IsUnary(instruction.Type))
+      {
+        auto *values = stack + (top - 1) * BlockSize;
+
+        VisitUnary(instruction.Type, [values, count](auto op) {
+          for (std::size_t i = 0; i < count; ++i)
+            values[i] = op(values[i]);
+        });
+      }
+      else if (Instruction::OperandType::ConstantRight == instruction.Operands)
+      {
+        auto *values = stack + (top - 1) * BlockSize;
+        const auto value = instruction.Value;
+
+        VisitBinary(instruction.Type, [values, count, value](auto op) {
+          for (std::size_t i = 0; i < count; ++i)
+            values[i] = op(values[i], value);
+        });
+      }
+      else if (Instruction::OperandType::ConstantLeft == instruction.Operands)
+      {
+        auto *values = stack + (top - 1) * BlockSize;
+        const auto value = instruction.Value;
+
+        VisitBinary(instruction.Type, [values, count, value](auto op) {
+          for (std::size_t i = 0; i < count; ++i)
+            values[i] = op(value, values[i]);
+        });
+      }
+      else
+      {
+        auto *left = stack + (top - 2) * BlockSize;
+        const auto *right = stack + (top - 1) * BlockSize;
+
+        VisitBinary(instruction.Type, [left, right, count](auto op) {
+          for (std::size_t i = 0; i < count; ++i)
+            left[i] = op(left[i], right[i]);
+        });
+
+        --top;
+      }
+    }
+  }
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(std::shared_ptr<const Node> node)
+  : m_Node(node)
+{
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(double value)
+  : ArithmeticExpression(Constant(value))
+{
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Input(unsigned int index)
+{
+  auto node = std::make_shared<Node>();
+  node->Type = OperationType::Input;
+  node->Index = index;
+  return ArithmeticExpression(node);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Constant(double value)
+{
+  auto node = std::make_shared<Node>();
+  node->Type = OperationType::Constant;
+  node->Value = value;
+  return ArithmeticExpression(node);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Operation(OperationType type, const ArithmeticExpression &operand)
+{
+  if (!IsUnary(type))
+    mitkThrow() << "Operation " << static_cast<int>(type) << " is not a unary operation";
+
+  auto node = std::make_shared<Node>();
+  node->Type = type;
+  node->Left = operand.m_Node;
+  return ArithmeticExpression(node);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Operation(OperationType type,
+                                                                 const ArithmeticExpression &left,
+                                                                 const ArithmeticExpression &right)
+{
+  if (!IsBinary(type))
+    mitkThrow() << "Operation " << static_cast<int>(type) << " is not a binary operation";
+
+  auto node = std::make_shared<Node>();
+  node->Type = type;
+  node->Left = left.m_Node;
+  node->Right = right.m_Node;
+  return ArithmeticExpression(node);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Pow(const ArithmeticExpression &base, const ArithmeticExpression &exponent)
+{
+  return Operation(OperationType::Pow, base, exponent);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Tan(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::Tan, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Atan(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::Atan, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Cos(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::Cos, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Acos(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::Acos, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Sin(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::Sin, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Asin(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::Asin, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Square(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::Square, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Sqrt(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::Sqrt, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Abs(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::Abs, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Exp(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::Exp, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::ExpNeg(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::ExpNeg, expression);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Log10(const ArithmeticExpression &expression)
+{
+  return Operation(OperationType::Log10, expression);
+}
+
+unsigned int mitk::ArithmeticExpression::GetNumberOfInputs() const
+{
+  unsigned int numberOfInputs = 0;
+  std::vector<const Node *> nodes = {m_Node.get()};
+
+  while (!nodes.empty())
+  {
+    const auto *node = nodes.back();
+    nodes.pop_back();
+
+    if (OperationType::Input == node->Type)
+      numberOfInputs = std::max(numberOfInputs, node->Index + 1);
+
+    if (nullptr != node->Left)
+      nodes.push_back(node->Left.get());
+
+    if (nullptr != node->Right)
+      nodes.push_back(node->Right.get());
+  }
+
+  return numberOfInputs;
+}
+
+mitk::Image::Pointer mitk::ArithmeticExpression::Evaluate(const std::vector<Image::Pointer> &inputs,
+                                                          bool outputAsDouble,
+                                                          unsigned int numberOfThreads) const
+{
+  if (inputs.empty() || inputs.size() < this->GetNumberOfInputs())
+    mitkThrow() << "Expression requires " << std::max(1u, this->GetNumberOfInputs()) << " input image(s), but "
+                << inputs.size() << " were given";
+
+  for (const auto &input : inputs)
+  {
+    if (input.IsNull())
+      mitkThrow() << "Input image of mitk::ArithmeticExpression is null";
+  }
+
+  const auto &referenceImage = inputs.front();
+  const auto dimension = referenceImage->GetDimension();
+
+  for (const auto &input : inputs)
+  {
+    if (input->GetDimension() != dimension ||
+        !std::equal(referenceImage->GetDimensions(), referenceImage->GetDimensions() + dimension, input->GetDimensions()))
+    {
+      mitkThrow() << "Images have different dimensions. This is not supported by mitk::ArithmeticExpression";
+    }
+  }
+
+  std::size_t numberOfPixels = 1;
+
+  for (unsigned int i = 0; i < dimension; ++i)
+    numberOfPixels *= referenceImage->GetDimension(i);
+
+  std::vector<PixelAccess> inputAccess;
+
+  for (const auto &input : inputs)
+    inputAccess.push_back(GetPixelAccess(input->GetPixelType()));
+
+  const auto outputPixelType = outputAsDouble
+    ? MakeScalarPixelType<double>()
+    : referenceImage->GetPixelType();
+
+  const auto outputAccess = GetPixelAccess(outputPixelType);
+
+  Program program;
+  Compile(m_Node, program, 0);
+
+  auto output = Image::New();
+  output->Initialize(outputPixelType, dimension, referenceImage->GetDimensions());
+  output->SetTimeGeometry(referenceImage->GetTimeGeometry()->Clone());
+
+  std::vector<std::unique_ptr<ImageReadAccessor>> readAccessors;
+  std::vector<const void *> inputData;
+
+  for (const auto &input : inputs)
+  {
+    readAccessors.push_back(std::make_unique<ImageReadAccessor>(input));
+    inputData.push_back(readAccessors.back()->GetData());
+  }
+
+  ImageWriteAccessor writeAccessor(output);
+  auto *outputData = writeAccessor.GetData();
+
+  const auto numberOfBlocks = (numberOfPixels + BlockSize - 1) / BlockSize;
+  const auto numberOfChunks = (numberOfBlocks + BlocksPerChunk - 1) / BlocksPerChunk;
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+
+  if (0 != numberOfThreads)
+  {
+    multiThreader->SetMaximumNumberOfThreads(numberOfThreads);
+    multiThreader->SetNumberOfWorkUnits(numberOfThreads);
+  }
+
+  multiThreader->ParallelizeArray(0, numberOfChunks, [&](itk::SizeValueType chunk) {
+    std::vector<double> stack(program.StackSize * BlockSize);
+
+    const auto firstPixel = static_cast<std::size_t>(chunk) * BlocksPerChunk * BlockSize;
+    const auto lastPixel = std::min(numberOfPixels, firstPixel + BlocksPerChunk * BlockSize);
+
+    for (auto offset = firstPixel; offset < lastPixel; offset += BlockSize)
+    {
+      const auto count = std::min(BlockSize, lastPixel - offset);
+
+      Execute(program, inputData, inputAccess, offset, count, stack.data());
+      outputAccess.Store(stack.data(), offset, count, outputData);
+    }
+  }, nullptr);
+
+  return output;
+}
+
+mitk::ArithmeticExpression mitk::operator+(const ArithmeticExpression &left, const ArithmeticExpression &right)
+{
+  return ArithmeticExpression::Operation(ArithmeticExpression::OperationType::Add, left, right);
+}
+
+mitk::ArithmeticExpression mitk::operator-(const ArithmeticExpression &left, const ArithmeticExpression &right)
+{
+  return ArithmeticExpression::Operation(ArithmeticExpression::OperationType::Subtract, left, right);
+}
+
+mitk::ArithmeticExpression mitk::operator*(const ArithmeticExpression &left, const ArithmeticExpression &right)
+{
+  return ArithmeticExpression::Operation(ArithmeticExpression::OperationType::Multiply, left, right);
+}
+
+mitk::ArithmeticExpression mitk::operator/(const ArithmeticExpression &left, const ArithmeticExpression &right)
+{
+  return ArithmeticExpression::Operation(ArithmeticExpression::OperationType::Divide, left, right);
+}
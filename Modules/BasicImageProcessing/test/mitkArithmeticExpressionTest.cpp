@@ -0,0 +1,254 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkArithmeticExpression.h>
+
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+class mitkArithmeticExpressionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkArithmeticExpressionTestSuite);
+  MITK_TEST(TestNumberOfInputs);
+  MITK_TEST(TestInvalidOperations);
+  MITK_TEST(TestEvaluateTwoInputs);
+  MITK_TEST(TestConstantFolding);
+  MITK_TEST(TestSignedCharInput);
+  MITK_TEST(TestOutputPixelType);
+  MITK_TEST(TestOutOfRangeOutput);
+  MITK_TEST(TestNumberOfThreads);
+  MITK_TEST(TestInvalidInputs);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  using Expression = mitk::ArithmeticExpression;
+
+  // more pixels than one block of the evaluation, so block borders are covered
+  static constexpr unsigned int Width = 45;
+  static constexpr unsigned int Height = 30;
+
+  template <typename TPixel>
+  static mitk::Image::Pointer CreateImage(const std::vector<TPixel>& values, unsigned int width, unsigned int height)
+  {
+    unsigned int dimensions[] = { width, height };
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<TPixel>(), 2, dimensions);
+
+    mitk::ImageWriteAccessor accessor(image);
+    std::copy(values.begin(), values.end(), static_cast<TPixel*>(accessor.GetData()));
+
+    return image;
+  }
+
+  template <typename TPixel>
+  static std::vector<TPixel> GetValues(const mitk::Image::Pointer& image)
+  {
+    mitk::ImageReadAccessor accessor(image);
+    const auto* values = static_cast<const TPixel*>(accessor.GetData());
+    return std::vector<TPixel>(values, values + image->GetDimension(0) * image->GetDimension(1));
+  }
+
+  std::vector<short> m_ShortValues;
+  std::vector<float> m_FloatValues;
+
+public:
+  void setUp() override
+  {
+    m_ShortValues.resize(Width * Height);
+    m_FloatValues.resize(Width * Height);
+
+    for (unsigned int i = 0; i < Width * Height; ++i)
+    {
+      m_ShortValues[i] = static_cast<short>(static_cast<int>(i % 97) - 48);
+      m_FloatValues[i] = 0.25f * static_cast<float>(i % 13);
+    }
+  }
+
+  void tearDown() override
+  {
+    m_ShortValues.clear();
+    m_FloatValues.clear();
+  }
+
+  void TestNumberOfInputs()
+  {
+    CPPUNIT_ASSERT_EQUAL(0u, Expression::Constant(1.0).GetNumberOfInputs());
+    CPPUNIT_ASSERT_EQUAL(1u, Expression::Sqrt(Expression::Input(0)).GetNumberOfInputs());
+    CPPUNIT_ASSERT_EQUAL(3u, (Expression::Input(0) + Expression::Input(2) * 2.0).GetNumberOfInputs());
+  }
+
+  void TestInvalidOperations()
+  {
+    const auto a = Expression::Input(0);
+
+    CPPUNIT_ASSERT_THROW(Expression::Operation(Expression::OperationType::Add, a), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(Expression::Operation(Expression::OperationType::Sqrt, a, a), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(Expression::Operation(Expression::OperationType::Input, a), mitk::Exception);
+  }
+
+  void TestEvaluateTwoInputs()
+  {
+    const auto a = Expression::Input(0);
+    const auto b = Expression::Input(1);
+    const auto expression = Expression::Sqrt(Expression::Square(a - b) + 1.0) / Expression::Abs(b - 5.0);
+
+    const auto output = expression.Evaluate({ CreateImage(m_ShortValues, Width, Height), CreateImage(m_FloatValues, Width, Height) });
+
+    CPPUNIT_ASSERT(itk::IOComponentEnum::DOUBLE == output->GetPixelType().GetComponentType());
+
+    const auto values = GetValues<double>(output);
+    for (unsigned int i = 0; i < Width * Height; ++i)
+    {
+      const double difference = m_ShortValues[i] - static_cast<double>(m_FloatValues[i]);
+      const double expected = std::sqrt(difference * difference + 1.0) / std::abs(m_FloatValues[i] - 5.0);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, values[i], 1e-12);
+    }
+  }
+
+  void TestConstantFolding()
+  {
+    const auto input = CreateImage(m_ShortValues, Width, Height);
+
+    // constant sub-expressions on either side of an operation
+    const auto a = Expression::Input(0);
+    const auto expression = (Expression::Constant(2.0) + 3.0) * a - Expression::Pow(Expression::Constant(2.0), 3.0) / a;
+
+    const auto values = GetValues<double>(expression.Evaluate({ input }));
+    for (unsigned int i = 0; i < Width * Height; ++i)
+    {
+      const double expected = 5.0 * m_ShortValues[i] - 8.0 / m_ShortValues[i];
+      if (std::isfinite(expected))
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, values[i], 1e-12);
+      else
+        CPPUNIT_ASSERT(std::isinf(values[i]));
+    }
+
+    // an expression without any input only takes the geometry from the input
+    const auto constantValues = GetValues<double>(Expression::Exp(Expression::Constant(0.0)).Evaluate({ input }));
+    for (const auto value : constantValues)
+      CPPUNIT_ASSERT_EQUAL(1.0, value);
+  }
+
+  void TestSignedCharInput()
+  {
+    const std::vector<signed char> charValues = { -128, -3, -1, 0, 1, 3, 127, -100 };
+    const auto input = CreateImage(charValues, 4, 2);
+
+    const auto values = GetValues<double>((Expression::Input(0) * 2.0).Evaluate({ input }));
+    for (std::size_t i = 0; i < charValues.size(); ++i)
+      CPPUNIT_ASSERT_EQUAL(2.0 * charValues[i], values[i]);
+  }
+
+  void TestOutputPixelType()
+  {
+    const std::vector<signed char> charValues = { -128, -3, -1, 0, 1, 3, 127, -100 };
+    const auto input = CreateImage(charValues, 4, 2);
+
+    // intermediate values are not truncated, only the result is converted to the input type
+    const auto output = ((Expression::Input(0) / 2.0) * 2.0 - 1.0).Evaluate({ input }, false);
+
+    CPPUNIT_ASSERT(input->GetPixelType() == output->GetPixelType());
+
+    const auto values = GetValues<signed char>(output);
+    for (std::size_t i = 0; i < charValues.size(); ++i)
+    {
+      // -129 does not fit into signed char and is clamped
+      const int expected = std::max(charValues[i] - 1, -128);
+      CPPUNIT_ASSERT_EQUAL(expected, static_cast<int>(values[i]));
+    }
+  }
+
+  void TestOutOfRangeOutput()
+  {
+    const std::vector<short> shortValues = { -2, 0, 1, 30000, -30000, 7 };
+    const auto shortInput = CreateImage(shortValues, 3, 2);
+    const auto a = Expression::Input(0);
+
+    // division by zero: -inf, NaN, inf
+    const auto divided = GetValues<short>((a / 0.0).Evaluate({ shortInput }, false));
+    CPPUNIT_ASSERT_EQUAL(std::numeric_limits<short>::lowest(), divided[0]);
+    CPPUNIT_ASSERT_EQUAL(short(0), divided[1]);
+    CPPUNIT_ASSERT_EQUAL(std::numeric_limits<short>::max(), divided[2]);
+
+    // finite values beyond the range
+    const auto scaled = GetValues<short>((a * 2.0).Evaluate({ shortInput }, false));
+    CPPUNIT_ASSERT_EQUAL(std::numeric_limits<short>::max(), scaled[3]);
+    CPPUNIT_ASSERT_EQUAL(std::numeric_limits<short>::lowest(), scaled[4]);
+    CPPUNIT_ASSERT_EQUAL(short(14), scaled[5]);
+
+    // NaN of an undefined operation
+    const auto roots = GetValues<short>(Expression::Sqrt(a).Evaluate({ shortInput }, false));
+    CPPUNIT_ASSERT_EQUAL(short(0), roots[0]);
+    CPPUNIT_ASSERT_EQUAL(short(1), roots[2]);
+
+    // unsigned types clamp negative values to 0
+    const std::vector<unsigned char> charValues = { 0, 1, 200, 255 };
+    const auto charInput = CreateImage(charValues, 2, 2);
+    const auto shifted = GetValues<unsigned char>((a - 100.0).Evaluate({ charInput }, false));
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(shifted[0]));
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(shifted[1]));
+    CPPUNIT_ASSERT_EQUAL(100, static_cast<int>(shifted[2]));
+    CPPUNIT_ASSERT_EQUAL(155, static_cast<int>(shifted[3]));
+
+    // float outputs keep NaN and infinity, values beyond the float range become infinity
+    const std::vector<float> floatValues = { 1.0f, -1.0f, 0.0f, 2.0f };
+    const auto floatInput = CreateImage(floatValues, 2, 2);
+    const auto huge = GetValues<float>((a * 1e300).Evaluate({ floatInput }, false));
+    CPPUNIT_ASSERT(std::isinf(huge[0]) && huge[0] > 0);
+    CPPUNIT_ASSERT(std::isinf(huge[1]) && huge[1] < 0);
+    CPPUNIT_ASSERT_EQUAL(0.0f, huge[2]);
+    CPPUNIT_ASSERT(std::isnan(GetValues<float>(Expression::Sqrt(a).Evaluate({ floatInput }, false))[1]));
+  }
+
+  void TestNumberOfThreads()
+  {
+    const auto a = Expression::Input(0);
+    const auto b = Expression::Input(1);
+    const auto expression = Expression::Atan(a * b) + Expression::Cos(b);
+    const std::vector<mitk::Image::Pointer> inputs = { CreateImage(m_ShortValues, Width, Height), CreateImage(m_FloatValues, Width, Height) };
+
+    const auto serial = GetValues<double>(expression.Evaluate(inputs, true, 1));
+    const auto parallel = GetValues<double>(expression.Evaluate(inputs, true, 4));
+
+    CPPUNIT_ASSERT(serial == parallel);
+  }
+
+  void TestInvalidInputs()
+  {
+    const auto a = Expression::Input(0);
+    const auto b = Expression::Input(1);
+
+    // missing input
+    CPPUNIT_ASSERT_THROW((a + b).Evaluate({ CreateImage(m_ShortValues, Width, Height) }), mitk::Exception);
+
+    // no input at all
+    CPPUNIT_ASSERT_THROW(Expression::Constant(1.0).Evaluate({}), mitk::Exception);
+
+    // different dimensions
+    CPPUNIT_ASSERT_THROW((a + b).Evaluate({ CreateImage(m_ShortValues, Width, Height),
+                                            CreateImage(m_FloatValues, Height, Width) }),
+                         mitk::Exception);
+
+    // null input
+    CPPUNIT_ASSERT_THROW(a.Evaluate({ nullptr }), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkArithmeticExpression)
@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include <mitkCustomTagParser.h>
 #include <mitkDICOMDCMTKTagScanner.h>
 #include <mitkDICOMFileReaderSelector.h>
+#include <mitkFileContentSniffer.h>
 
 #include <mitkLog.h>
 
@@ -64,39 +65,45 @@ namespace mitk
       return canRead;
     }
 
-    mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
+    // the parsed private tag is shared via the sniffer, so the file is scanned only once
+    auto isCEST = FileContentSniffer::Sniff(path)->GetValue("MitkCEST.HasCESTProperties", [&path]()
+    {
+      mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
 
-    mitk::DICOMTag siemensCESTprivateTag(0x0029, 0x1020);
+      mitk::DICOMTag siemensCESTprivateTag(0x0029, 0x1020);
 
-    mitk::StringList relevantFiles;
-    relevantFiles.push_back(path);
+      mitk::StringList relevantFiles;
+      relevantFiles.push_back(path);
 
-    scanner->AddTag(siemensCESTprivateTag);
-    scanner->SetInputFiles(relevantFiles);
-    scanner->Scan();
-    mitk::DICOMTagCache::Pointer tagCache = scanner->GetScanCache();
+      scanner->AddTag(siemensCESTprivateTag);
+      scanner->SetInputFiles(relevantFiles);
+      scanner->Scan();
+      mitk::DICOMTagCache::Pointer tagCache = scanner->GetScanCache();
 
-    mitk::DICOMImageFrameList imageFrameList = mitk::ConvertToDICOMImageFrameList(tagCache->GetFrameInfoList());
+      mitk::DICOMImageFrameList imageFrameList = mitk::ConvertToDICOMImageFrameList(tagCache->GetFrameInfoList());
 
-    bool mapNotEmpty = false;
+      bool mapNotEmpty = false;
 
-    if (!imageFrameList.empty())
-    {
-      mitk::DICOMImageFrameInfo* firstFrame = imageFrameList.begin()->GetPointer();
+      if (!imageFrameList.empty())
+      {
+        mitk::DICOMImageFrameInfo* firstFrame = imageFrameList.begin()->GetPointer();
 
-      std::string byteString = tagCache->GetTagValue(firstFrame, siemensCESTprivateTag).value;
+        std::string byteString = tagCache->GetTagValue(firstFrame, siemensCESTprivateTag).value;
 
-      if (byteString.empty()) {
-        return false;
-      }
-      mitk::CustomTagParser tagParser(relevantFiles[0]);
+        if (byteString.empty()) {
+          return std::string("0");
+        }
+        mitk::CustomTagParser tagParser(relevantFiles[0]);
 
-      auto parsedPropertyList = tagParser.ParseDicomPropertyString(byteString);
+        auto parsedPropertyList = tagParser.ParseDicomPropertyString(byteString);
 
-      mapNotEmpty = !parsedPropertyList->GetMap()->empty();
-    }
+        mapNotEmpty = !parsedPropertyList->GetMap()->empty();
+      }
+
+      return std::string(mapNotEmpty ? "1" : "0");
+    });
 
-    return mapNotEmpty;
+    return isCEST == "1";
   }
 
   MitkCESTIOMimeTypes::MitkCESTDicomMimeType *MitkCESTIOMimeTypes::MitkCESTDicomMimeType::Clone() const
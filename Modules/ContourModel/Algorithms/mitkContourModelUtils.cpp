@@ -12,13 +12,128 @@ found in the LICENSE file.
 
 #include <mitkContourModelUtils.h>
 
-#include <mitkContourModelToSurfaceFilter.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkLabelSetImage.h>
-#include <mitkSurface.h>
-#include <vtkImageStencil.h>
 #include <vtkPointData.h>
-#include <vtkPolyData.h>
-#include <vtkPolyDataToImageStencil.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  using Span = mitk::ContourModelUtils::ScanlineSpan;
+
+  std::vector<mitk::Point2D> GetContourVertices(const mitk::ContourModel* contour, mitk::TimeStepType timeStep)
+  {
+    std::vector<mitk::Point2D> vertices;
+
+    if (timeStep >= static_cast<mitk::TimeStepType>(contour->GetTimeSteps()))
+      return vertices;
+
+    vertices.reserve(contour->GetNumberOfVertices(timeStep));
+
+    for (auto iter = contour->Begin(timeStep); iter != contour->End(timeStep); ++iter)
+    {
+      mitk::Point2D vertex;
+      vertex[0] = (*iter)->Coordinates[0];
+      vertex[1] = (*iter)->Coordinates[1];
+      vertices.push_back(vertex);
+    }
+
+    return vertices;
+  }
+
+  /** Writes paintingPixelValue into all pixels of the spans for which canPaint(existingValue) is true.*/
+  template <typename TPixel, typename TPredicate>
+  void PaintSpans(void* buffer, int width, const std::vector<Span>& spans, int paintingPixelValue, const TPredicate& canPaint)
+  {
+    auto pixels = static_cast<TPixel*>(buffer);
+    const auto value = static_cast<TPixel>(paintingPixelValue);
+
+    for (const auto& span : spans)
+    {
+      auto rowPixels = pixels + static_cast<std::size_t>(span.Row) * width;
+
+      for (int x = span.Begin; x <= span.End; ++x)
+      {
+        if (canPaint(rowPixels[x]))
+          rowPixels[x] = value;
+      }
+    }
+  }
+
+  template <typename TPredicate>
+  void PaintSpans(mitk::Image* sliceImage, const std::vector<Span>& spans, int paintingPixelValue, const TPredicate& canPaint)
+  {
+    if (spans.empty())
+      return;
+
+    const auto width = static_cast<int>(sliceImage->GetDimension(0));
+
+    {
+      mitk::ImageWriteAccessor accessor(sliceImage, sliceImage->GetVolumeData(0));
+      auto buffer = accessor.GetData();
+
+      switch (sliceImage->GetPixelType().GetComponentType())
+      {
+        case itk::IOComponentEnum::UCHAR:
+          PaintSpans<unsigned char>(buffer, width, spans, paintingPixelValue, canPaint);
+          break;
+        case itk::IOComponentEnum::CHAR:
+          PaintSpans<signed char>(buffer, width, spans, paintingPixelValue, canPaint);
+          break;
+        case itk::IOComponentEnum::USHORT:
+          PaintSpans<unsigned short>(buffer, width, spans, paintingPixelValue, canPaint);
+          break;
+        case itk::IOComponentEnum::SHORT:
+          PaintSpans<short>(buffer, width, spans, paintingPixelValue, canPaint);
+          break;
+        case itk::IOComponentEnum::UINT:
+          PaintSpans<unsigned int>(buffer, width, spans, paintingPixelValue, canPaint);
+          break;
+        case itk::IOComponentEnum::INT:
+          PaintSpans<int>(buffer, width, spans, paintingPixelValue, canPaint);
+          break;
+        case itk::IOComponentEnum::ULONG:
+          PaintSpans<unsigned long>(buffer, width, spans, paintingPixelValue, canPaint);
+          break;
+        case itk::IOComponentEnum::LONG:
+          PaintSpans<long>(buffer, width, spans, paintingPixelValue, canPaint);
+          break;
+        case itk::IOComponentEnum::FLOAT:
+          PaintSpans<float>(buffer, width, spans, paintingPixelValue, canPaint);
+          break;
+        case itk::IOComponentEnum::DOUBLE:
+          PaintSpans<double>(buffer, width, spans, paintingPixelValue, canPaint);
+          break;
+        default:
+          mitkThrow() << "Cannot fill contour in slice. Pixel type " << sliceImage->GetPixelType().GetComponentTypeAsString() << " is not supported.";
+      }
+    }
+
+    sliceImage->Modified();
+  }
+
+  std::vector<Span> RasterizeContour(const mitk::ContourModel* projectedContour, mitk::TimeStepType contourTimeStep, const mitk::Image* sliceImage)
+  {
+    if (nullptr == projectedContour)
+      mitkThrow() << "Cannot fill contour in slice. Passed contour is invalid";
+
+    if (nullptr == sliceImage)
+      mitkThrow() << "Cannot fill contour in slice. Passed slice is invalid";
+
+    if (sliceImage->GetDimension() > 2 && sliceImage->GetDimension(2) > 1)
+      mitkThrow() << "Cannot fill contour in slice. Passed image is not a 2D slice";
+
+    const auto vertices = GetContourVertices(projectedContour, contourTimeStep);
+
+    if (vertices.empty())
+      MITK_WARN << "Could not fill contour. Contour has no vertices at time step " << contourTimeStep << ".";
+
+    return mitk::ContourModelUtils::RasterizePolygons({ vertices }, static_cast<int>(sliceImage->GetDimension(0)), static_cast<int>(sliceImage->GetDimension(1)));
+  }
+}
 
 mitk::ContourModelUtils::ContourModelUtils()
 {
@@ -95,60 +210,99 @@ mitk::ContourModel::Pointer mitk::ContourModelUtils::BackProjectContourFrom2DSli
   return worldContour;
 }
 
-void mitk::ContourModelUtils::FillContourInSlice2(
-  const ContourModel* projectedContour, Image* sliceImage, int paintingPixelValue)
+std::vector<mitk::ContourModelUtils::ScanlineSpan> mitk::ContourModelUtils::RasterizePolygons(
+  const std::vector<std::vector<Point2D>>& polygons, int width, int height)
 {
-  FillContourInSlice2(projectedContour, 0, sliceImage, paintingPixelValue);
-}
+  std::vector<ScanlineSpan> spans;
 
-void mitk::ContourModelUtils::FillContourInSlice2(
-  const ContourModel* projectedContour, TimeStepType contourTimeStep, Image* sliceImage, int paintingPixelValue)
-{
-  if (nullptr == projectedContour)
-  {
-    mitkThrow() << "Cannot fill contour in slice. Passed contour is invalid";
-  }
+  if (width <= 0 || height <= 0)
+    return spans;
+
+  double minY = std::numeric_limits<double>::max();
+  double maxY = std::numeric_limits<double>::lowest();
 
-  if (nullptr == sliceImage)
+  for (const auto& polygon : polygons)
   {
-    mitkThrow() << "Cannot fill contour in slice. Passed slice is invalid";
+    for (const auto& vertex : polygon)
+    {
+      minY = std::min(minY, vertex[1]);
+      maxY = std::max(maxY, vertex[1]);
+    }
   }
 
-  auto contourModelFilter = mitk::ContourModelToSurfaceFilter::New();
-  contourModelFilter->SetInput(projectedContour);
-  contourModelFilter->Update();
+  if (minY > maxY)
+    return spans;
+
+  const int firstRow = static_cast<int>(std::max(0.0, std::ceil(minY - mitk::eps)));
+  const int lastRow = static_cast<int>(std::min(height - 1.0, std::floor(maxY + mitk::eps)));
+
+  auto addSpan = [&spans, width](int row, double begin, double end) {
+    const int first = static_cast<int>(std::max(0.0, std::ceil(begin - mitk::eps)));
+    const int last = static_cast<int>(std::min(width - 1.0, std::floor(end + mitk::eps)));
 
-  auto surface = mitk::Surface::New();
-  surface = contourModelFilter->GetOutput();
+    if (first <= last)
+      spans.push_back({row, first, last});
+  };
 
-  if (nullptr == surface->GetVtkPolyData(contourTimeStep))
+  std::vector<double> crossings;
+
+  for (int row = firstRow; row <= lastRow; ++row)
   {
-    MITK_WARN << "Could not create surface from contour model.";
-    return;
-  }
+    const double y = row;
+    crossings.clear();
+
+    for (const auto& polygon : polygons)
+    {
+      const auto numberOfVertices = polygon.size();
+
+      for (std::size_t i = 0; i < numberOfVertices; ++i)
+      {
+        const auto& a = polygon[i];
+        const auto& b = polygon[(i + 1) % numberOfVertices];
 
-  auto surface2D = vtkSmartPointer<vtkPolyData>::New();
-  surface2D->SetPoints(surface->GetVtkPolyData(contourTimeStep)->GetPoints());
-  surface2D->SetLines(surface->GetVtkPolyData(contourTimeStep)->GetLines());
+        // Half-open rule, so that vertices shared by two edges are counted once
+        if ((a[1] <= y && y < b[1]) || (b[1] <= y && y < a[1]))
+          crossings.push_back(a[0] + (y - a[1]) * (b[0] - a[0]) / (b[1] - a[1]));
 
-  auto polyDataToImageStencil = vtkSmartPointer<vtkPolyDataToImageStencil>::New();
+        // Pixel centers on the boundary are covered as well (including horizontal edges
+        // and vertices that the half-open rule skips)
+        if (std::abs(b[1] - a[1]) < mitk::eps)
+        {
+          if (std::abs(a[1] - y) < mitk::eps)
+            addSpan(row, std::min(a[0], b[0]), std::max(a[0], b[0]));
+        }
+        else if (std::min(a[1], b[1]) - mitk::eps <= y && y <= std::max(a[1], b[1]) + mitk::eps)
+        {
+          const double x = a[0] + (y - a[1]) * (b[0] - a[0]) / (b[1] - a[1]);
+          const double roundedX = std::round(x);
+
+          if (std::abs(x - roundedX) < mitk::eps)
+            addSpan(row, roundedX, roundedX);
+        }
+      }
+    }
+
+    std::sort(crossings.begin(), crossings.end());
 
-  // Set a minimal tolerance, so that clipped pixels will be added to contour as well.
-  polyDataToImageStencil->SetTolerance(mitk::eps);
-  polyDataToImageStencil->SetInputData(surface2D);
-  polyDataToImageStencil->Update();
+    for (std::size_t i = 0; i + 1 < crossings.size(); i += 2)
+      addSpan(row, crossings[i], crossings[i + 1]);
+  }
 
-  auto imageStencil = vtkSmartPointer<vtkImageStencil>::New();
+  return spans;
+}
 
-  imageStencil->SetInputData(sliceImage->GetVtkImageData());
-  imageStencil->SetStencilConnection(polyDataToImageStencil->GetOutputPort());
-  imageStencil->ReverseStencilOn();
-  imageStencil->SetBackgroundValue(paintingPixelValue);
-  imageStencil->Update();
+void mitk::ContourModelUtils::FillContourInSlice2(
+  const ContourModel* projectedContour, Image* sliceImage, int paintingPixelValue)
+{
+  FillContourInSlice2(projectedContour, 0, sliceImage, paintingPixelValue);
+}
 
-  vtkSmartPointer<vtkImageData> filledImage = imageStencil->GetOutput();
+void mitk::ContourModelUtils::FillContourInSlice2(
+  const ContourModel* projectedContour, TimeStepType contourTimeStep, Image* sliceImage, int paintingPixelValue)
+{
+  const auto spans = RasterizeContour(projectedContour, contourTimeStep, sliceImage);
 
-  sliceImage->SetVolume(filledImage->GetScalarPointer());
+  PaintSpans(sliceImage, spans, paintingPixelValue, [](double) { return true; });
 }
 
 void mitk::ContourModelUtils::FillContourInSlice(
@@ -160,63 +314,29 @@ void mitk::ContourModelUtils::FillContourInSlice(
 void mitk::ContourModelUtils::FillContourInSlice(
   const ContourModel *projectedContour, TimeStepType contourTimeStep, Image *sliceImage, const Image* workingImage, int paintingPixelValue)
 {
-  if (nullptr == projectedContour)
+  const auto spans = RasterizeContour(projectedContour, contourTimeStep, sliceImage);
+
+  // Same rules as FillSliceInSlice: locked labels are not overwritten and erasing
+  // (painting the unlabeled value) only removes the active label.
+  auto labelImage = dynamic_cast<const LabelSetImage *>(workingImage);
+
+  if (nullptr == labelImage)
   {
-    mitkThrow() << "Cannot fill contour in slice. Passed contour is invalid";
+    PaintSpans(sliceImage, spans, paintingPixelValue, [](double) { return true; });
   }
-
-  if (nullptr == sliceImage)
+  else if (paintingPixelValue != LabelSetImage::UNLABELED_VALUE)
   {
-    mitkThrow() << "Cannot fill contour in slice. Passed slice is invalid";
+    PaintSpans(sliceImage, spans, paintingPixelValue, [labelImage](double existingValue) {
+      return !labelImage->IsLabelLocked(existingValue);
+    });
   }
-
-  auto contourModelFilter = mitk::ContourModelToSurfaceFilter::New();
-  contourModelFilter->SetInput(projectedContour);
-  contourModelFilter->Update();
-
-  auto surface = mitk::Surface::New();
-  surface = contourModelFilter->GetOutput();
-
-  if (nullptr == surface->GetVtkPolyData(contourTimeStep))
+  else
   {
-    MITK_WARN << "Could not create surface from contour model.";
-    return;
+    const auto activePixelValue = labelImage->GetActiveLabel()->GetValue();
+    PaintSpans(sliceImage, spans, paintingPixelValue, [activePixelValue](double existingValue) {
+      return existingValue == activePixelValue;
+    });
   }
-
-  auto surface2D = vtkSmartPointer<vtkPolyData>::New();
-  surface2D->SetPoints(surface->GetVtkPolyData(contourTimeStep)->GetPoints());
-  surface2D->SetLines(surface->GetVtkPolyData(contourTimeStep)->GetLines());
-
-  auto image = vtkSmartPointer<vtkImageData>::New();
-  image->DeepCopy(sliceImage->GetVtkImageData());
-
-  const double FOREGROUND_VALUE = 255.0;
-  const double BACKGROUND_VALUE = 0.0;
-
-  const vtkIdType count = image->GetNumberOfPoints();
-  for (std::remove_const_t<decltype(count)> i = 0; i < count; ++i)
-    image->GetPointData()->GetScalars()->SetTuple1(i, FOREGROUND_VALUE);
-
-  auto polyDataToImageStencil = vtkSmartPointer<vtkPolyDataToImageStencil>::New();
-
-  // Set a minimal tolerance, so that clipped pixels will be added to contour as well.
-  polyDataToImageStencil->SetTolerance(mitk::eps);
-  polyDataToImageStencil->SetInputData(surface2D);
-  polyDataToImageStencil->Update();
-
-  auto imageStencil = vtkSmartPointer<vtkImageStencil>::New();
-
-  imageStencil->SetInputData(image);
-  imageStencil->SetStencilConnection(polyDataToImageStencil->GetOutputPort());
-  imageStencil->ReverseStencilOff();
-  imageStencil->SetBackgroundValue(BACKGROUND_VALUE);
-  imageStencil->Update();
-
-  vtkSmartPointer<vtkImageData> filledImage = imageStencil->GetOutput();
-  vtkSmartPointer<vtkImageData> resultImage = sliceImage->GetVtkImageData();
-  FillSliceInSlice(filledImage, resultImage, workingImage, paintingPixelValue);
-
-  sliceImage->SetVolume(resultImage->GetScalarPointer());
 }
 
 void mitk::ContourModelUtils::FillSliceInSlice(
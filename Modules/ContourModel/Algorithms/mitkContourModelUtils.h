@@ -82,6 +82,9 @@ namespace mitk
     /**
     \brief Fill a contour in a 2D slice with a specified pixel value.
     This version always uses the contour of time step 0 and fills the image.
+    The contour (in index coordinates of the slice) is treated as closed polygon and
+    rasterized directly into the slice with the even-odd rule. A pixel is filled if its
+    center lies inside the polygon or on its boundary.
     \param projectedContour Pointer to the contour that should be projected.
     \param sliceImage Pointer to the image which content should be altered by
     adding the contour with the specified paintingPixelValue.
@@ -110,6 +113,25 @@ namespace mitk
       Image* sliceImage,
       int paintingPixelValue = 1);
 
+    /**
+    \brief Run of pixels [Begin, End] (inclusive) in row Row of a slice, see RasterizePolygons().
+    */
+    struct ScanlineSpan
+    {
+      int Row;
+      int Begin;
+      int End;
+    };
+
+    /**
+    \brief Rasterizes closed polygons given in index coordinates of a slice with width x height pixels.
+    All polygons are combined with the even-odd rule, thus a polygon nested in another one describes
+    a hole. A pixel is covered if its center lies inside or (within mitk::eps) on the boundary of the
+    polygons. Only the rows and columns of the polygons' bounding box are visited.
+    \return Covered pixel runs, clipped to the slice. Runs may overlap.
+    */
+    static std::vector<ScanlineSpan> RasterizePolygons(const std::vector<std::vector<Point2D>>& polygons, int width, int height);
+
     /**
     \brief Fills the paintingPixelValue into every pixel of resultImage as indicated by filledImage.
     If a LableSet image is specified it also by incorporating the rules of LabelSet images when filling the content.
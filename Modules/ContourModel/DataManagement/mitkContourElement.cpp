@@ -10,9 +10,389 @@ found in the LICENSE file.
 
 ============================================================================*/
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <mitkContourElement.h>
 #include <vtkMath.h>
 
+/** Allocates the vertices of a contour element in blocks, so that the vertices of a contour lie close to each
+ * other in memory and adding a vertex does not need a heap allocation of its own. Released slots are reused.
+ * The address of an allocated vertex does not change until it is released. The first block is small, as most
+ * elements only hold a few vertices; every further block doubles the size up to MaxBlockSize.*/
+class mitk::ContourElement::VertexPool
+{
+public:
+  VertexType *Allocate(const mitk::Point3D &point, bool isControlPoint)
+  {
+    void *slot = nullptr;
+
+    if (!m_FreeSlots.empty())
+    {
+      slot = m_FreeSlots.back();
+      m_FreeSlots.pop_back();
+    }
+    else
+    {
+      if (m_Blocks.empty() || m_LastBlockSize == m_NumberOfUsedSlotsInLastBlock)
+      {
+        m_LastBlockSize = m_Blocks.empty() ? MinBlockSize : std::min(2 * m_LastBlockSize, MaxBlockSize);
+        m_Blocks.emplace_back(new Slot[m_LastBlockSize]);
+        m_NumberOfUsedSlotsInLastBlock = 0;
+      }
+
+      slot = &m_Blocks.back()[m_NumberOfUsedSlotsInLastBlock++];
+    }
+
+    return new (slot) VertexType(point, isControlPoint);
+  }
+
+  void Release(VertexType *vertex)
+  {
+    vertex->~VertexType();
+    m_FreeSlots.push_back(vertex);
+  }
+
+  /** Frees all blocks. All vertices have to be released before.*/
+  void Clear()
+  {
+    m_Blocks.clear();
+    m_FreeSlots.clear();
+    m_LastBlockSize = 0;
+    m_NumberOfUsedSlotsInLastBlock = 0;
+  }
+
+private:
+  struct alignas(VertexType) Slot
+  {
+    unsigned char Data[sizeof(VertexType)];
+  };
+
+  static constexpr std::size_t MinBlockSize = 8;
+  static constexpr std::size_t MaxBlockSize = 1024;
+
+  std::vector<std::unique_ptr<Slot[]>> m_Blocks;
+  std::size_t m_LastBlockSize = 0;
+  std::size_t m_NumberOfUsedSlotsInLastBlock = 0;
+  std::vector<void *> m_FreeSlots;
+};
+
+/** Search structure for the vertices and line segments of a contour element. It holds the vertex coordinates
+ * as contiguous arrays (one per dimension) and a uniform grid over the bounding box of the contour. Every grid
+ * cell references the vertices inside and the line segments overlapping it. Segment i connects vertex i and
+ * vertex (i + 1) % n. Segments that overlap many cells are not stored in the grid but tested by every query.*/
+class mitk::ContourElement::SpatialIndex
+{
+public:
+  using IndexType = unsigned int;
+
+  explicit SpatialIndex(const VertexListType &vertices)
+    : m_NumberOfVertices(vertices.size())
+  {
+    for (auto &coordinates : m_Coordinates)
+      coordinates.resize(m_NumberOfVertices);
+
+    for (std::size_t i = 0; i < m_NumberOfVertices; ++i)
+    {
+      for (int d = 0; d < 3; ++d)
+        m_Coordinates[d][i] = vertices[i]->Coordinates[d];
+    }
+
+    if (m_NumberOfVertices >= MinimumNumberOfVerticesForGrid)
+      this->BuildGrid();
+  }
+
+  std::size_t GetNumberOfVertices() const
+  {
+    return m_NumberOfVertices;
+  }
+
+  double GetSquaredDistanceToVertex(std::size_t index, const mitk::Point3D &point) const
+  {
+    double result = 0.0;
+
+    for (int d = 0; d < 3; ++d)
+    {
+      const double difference = m_Coordinates[d][index] - point[d];
+      result += difference * difference;
+    }
+
+    return result;
+  }
+
+  /** Returns the squared distance of the point to segment index and the closest point on the segment.*/
+  double GetSquaredDistanceToSegment(std::size_t index, const mitk::Point3D &point, mitk::Point3D &closestPoint) const
+  {
+    const auto next = (index + 1) % m_NumberOfVertices;
+    double direction[3];
+    double length2 = 0.0;
+    double dot = 0.0;
+
+    for (int d = 0; d < 3; ++d)
+    {
+      direction[d] = m_Coordinates[d][next] - m_Coordinates[d][index];
+      length2 += direction[d] * direction[d];
+      dot += (point[d] - m_Coordinates[d][index]) * direction[d];
+    }
+
+    // take into account we have line segments and not (infinite) lines
+    const double t = length2 > 0.0 ? std::max(0.0, std::min(1.0, dot / length2)) : 0.0;
+    double result = 0.0;
+
+    for (int d = 0; d < 3; ++d)
+    {
+      closestPoint[d] = m_Coordinates[d][index] + t * direction[d];
+      const double difference = point[d] - closestPoint[d];
+      result += difference * difference;
+    }
+
+    return result;
+  }
+
+  /** Calls visit(vertexIndex) for (at least) every vertex within the given distance of the point.*/
+  template <typename Visitor>
+  void VisitVertices(const mitk::Point3D &point, double distance, Visitor visit) const
+  {
+    this->Visit(m_VertexCellStart, m_VertexIndices, point, distance, visit);
+  }
+
+  /** Calls visit(segmentIndex) for (at least) every segment within the given distance of the point.
+   * A segment might be visited more than once.*/
+  template <typename Visitor>
+  void VisitSegments(const mitk::Point3D &point, double distance, Visitor visit) const
+  {
+    if (!this->Visit(m_SegmentCellStart, m_SegmentIndices, point, distance, visit))
+      return;
+
+    for (auto index : m_LargeSegments)
+      visit(index);
+  }
+
+private:
+  /** Contours with less vertices are searched linearly.*/
+  static constexpr std::size_t MinimumNumberOfVerticesForGrid = 64;
+  /** Average number of vertices per grid cell.*/
+  static constexpr double VerticesPerCell = 4.0;
+  /** Segments overlapping more cells are tested by every query.*/
+  static constexpr std::size_t MaximumNumberOfCellsPerSegment = 64;
+
+  using CellIndexType = std::array<long long, 3>;
+
+  /** Visits the candidates of the cells overlapping the cube around the point, or all indices if there
+   * is no grid or the cube covers more cells than there are vertices. Returns false if no cell overlaps.*/
+  template <typename Visitor>
+  bool Visit(const std::vector<IndexType> &cellStart,
+             const std::vector<IndexType> &indices,
+             const mitk::Point3D &point,
+             double distance,
+             Visitor visit) const
+  {
+    if (cellStart.empty())
+    {
+      for (std::size_t i = 0; i < m_NumberOfVertices; ++i)
+        visit(i);
+
+      return false;
+    }
+
+    CellIndexType first, last;
+    std::size_t numberOfCells = 1;
+
+    for (int d = 0; d < 3; ++d)
+    {
+      first[d] = this->GetCellCoordinate(point[d] - distance, d);
+      last[d] = this->GetCellCoordinate(point[d] + distance, d);
+
+      if (last[d] < 0 || first[d] >= m_Dimensions[d])
+        return false;
+
+      first[d] = std::max(0LL, first[d]);
+      last[d] = std::min(m_Dimensions[d] - 1, last[d]);
+      numberOfCells *= static_cast<std::size_t>(last[d] - first[d] + 1);
+    }
+
+    if (numberOfCells > m_NumberOfVertices)
+    {
+      for (std::size_t i = 0; i < m_NumberOfVertices; ++i)
+        visit(i);
+
+      return false;
+    }
+
+    for (auto z = first[2]; z <= last[2]; ++z)
+    {
+      for (auto y = first[1]; y <= last[1]; ++y)
+      {
+        for (auto x = first[0]; x <= last[0]; ++x)
+        {
+          const auto cell = (z * m_Dimensions[1] + y) * m_Dimensions[0] + x;
+
+          for (auto i = cellStart[cell]; i < cellStart[cell + 1]; ++i)
+            visit(indices[i]);
+        }
+      }
+    }
+
+    return true;
+  }
+
+  long long GetCellCoordinate(double coordinate, int d) const
+  {
+    return static_cast<long long>(std::floor((coordinate - m_Origin[d]) / m_CellSize));
+  }
+
+  long long GetCell(const CellIndexType &cellIndex) const
+  {
+    return (cellIndex[2] * m_Dimensions[1] + cellIndex[1]) * m_Dimensions[0] + cellIndex[0];
+  }
+
+  void BuildGrid()
+  {
+    std::array<double, 3> extent;
+    double maximumExtent = 0.0;
+
+    for (int d = 0; d < 3; ++d)
+    {
+      const auto range = std::minmax_element(m_Coordinates[d].begin(), m_Coordinates[d].end());
+      m_Origin[d] = *range.first;
+      extent[d] = *range.second - *range.first;
+      maximumExtent = std::max(maximumExtent, extent[d]);
+    }
+
+    if (maximumExtent <= 0.0)
+      return; // all vertices coincide
+
+    // Contours are usually planar, thus only the non-degenerated dimensions are considered for the cell size.
+    double volume = 1.0;
+    int numberOfDimensions = 0;
+
+    for (int d = 0; d < 3; ++d)
+    {
+      if (extent[d] > 1e-6 * maximumExtent)
+      {
+        volume *= extent[d];
+        ++numberOfDimensions;
+      }
+    }
+
+    m_CellSize = std::pow(volume * VerticesPerCell / m_NumberOfVertices, 1.0 / numberOfDimensions);
+    std::size_t numberOfCells = 0;
+
+    do
+    {
+      numberOfCells = 1;
+
+      for (int d = 0; d < 3; ++d)
+      {
+        m_Dimensions[d] = static_cast<long long>(extent[d] / m_CellSize) + 1;
+        numberOfCells *= static_cast<std::size_t>(m_Dimensions[d]);
+      }
+
+      if (numberOfCells > 2 * m_NumberOfVertices)
+        m_CellSize *= 1.5; // very thin contours
+    } while (numberOfCells > 2 * m_NumberOfVertices);
+
+    // vertices
+    std::vector<long long> vertexCells(m_NumberOfVertices);
+
+    for (std::size_t i = 0; i < m_NumberOfVertices; ++i)
+      vertexCells[i] = this->GetCell(this->GetVertexCell(i));
+
+    m_VertexCellStart.assign(numberOfCells + 1, 0);
+
+    for (auto cell : vertexCells)
+      ++m_VertexCellStart[cell + 1];
+
+    for (std::size_t cell = 0; cell < numberOfCells; ++cell)
+      m_VertexCellStart[cell + 1] += m_VertexCellStart[cell];
+
+    m_VertexIndices.resize(m_NumberOfVertices);
+    auto vertexInsertPositions = m_VertexCellStart;
+
+    for (std::size_t i = 0; i < m_NumberOfVertices; ++i)
+      m_VertexIndices[vertexInsertPositions[vertexCells[i]]++] = static_cast<IndexType>(i);
+
+    // segments (counted in the first pass, inserted in the second one)
+    m_SegmentCellStart.assign(numberOfCells + 1, 0);
+    std::vector<IndexType> segmentInsertPositions;
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+      if (1 == pass)
+      {
+        for (std::size_t cell = 0; cell < numberOfCells; ++cell)
+          m_SegmentCellStart[cell + 1] += m_SegmentCellStart[cell];
+
+        m_SegmentIndices.resize(m_SegmentCellStart.back());
+        segmentInsertPositions = m_SegmentCellStart;
+      }
+
+      for (std::size_t i = 0; i < m_NumberOfVertices; ++i)
+      {
+        const auto firstCell = this->GetVertexCell(i);
+        const auto secondCell = this->GetVertexCell((i + 1) % m_NumberOfVertices);
+        CellIndexType first, last;
+        std::size_t numberOfSegmentCells = 1;
+
+        for (int d = 0; d < 3; ++d)
+        {
+          first[d] = std::min(firstCell[d], secondCell[d]);
+          last[d] = std::max(firstCell[d], secondCell[d]);
+          numberOfSegmentCells *= static_cast<std::size_t>(last[d] - first[d] + 1);
+        }
+
+        if (numberOfSegmentCells > MaximumNumberOfCellsPerSegment)
+        {
+          if (0 == pass)
+            m_LargeSegments.push_back(static_cast<IndexType>(i));
+
+          continue;
+        }
+
+        for (auto z = first[2]; z <= last[2]; ++z)
+        {
+          for (auto y = first[1]; y <= last[1]; ++y)
+          {
+            for (auto x = first[0]; x <= last[0]; ++x)
+            {
+              const auto cell = this->GetCell({ x, y, z });
+
+              if (0 == pass)
+                ++m_SegmentCellStart[cell + 1];
+              else
+                m_SegmentIndices[segmentInsertPositions[cell]++] = static_cast<IndexType>(i);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  CellIndexType GetVertexCell(std::size_t index) const
+  {
+    CellIndexType cellIndex;
+
+    for (int d = 0; d < 3; ++d)
+      cellIndex[d] = std::min(m_Dimensions[d] - 1, std::max(0LL, this->GetCellCoordinate(m_Coordinates[d][index], d)));
+
+    return cellIndex;
+  }
+
+  std::size_t m_NumberOfVertices;
+  std::array<std::vector<double>, 3> m_Coordinates;
+
+  std::array<double, 3> m_Origin = { 0.0, 0.0, 0.0 };
+  double m_CellSize = 1.0;
+  std::array<long long, 3> m_Dimensions = { 1, 1, 1 };
+
+  std::vector<IndexType> m_VertexCellStart;
+  std::vector<IndexType> m_VertexIndices;
+  std::vector<IndexType> m_SegmentCellStart;
+  std::vector<IndexType> m_SegmentIndices;
+  std::vector<IndexType> m_LargeSegments;
+};
+
 bool mitk::ContourElement::ContourModelVertex::operator==(const ContourModelVertex &other) const
 {
   return this->Coordinates == other.Coordinates && this->IsControlPoint == other.IsControlPoint;
@@ -58,12 +438,19 @@ mitk::ContourElement::VertexIterator mitk::ContourElement::end()
   return this->m_Vertices.end();
 }
 
+mitk::ContourElement::ContourElement()
+  : m_VertexPool(std::make_unique<VertexPool>())
+{
+}
+
 mitk::ContourElement::ContourElement(const mitk::ContourElement &other)
-  : itk::LightObject(), m_IsClosed(other.m_IsClosed)
+  : itk::LightObject(), m_IsClosed(other.m_IsClosed), m_VertexPool(std::make_unique<VertexPool>())
 {
+  m_Vertices.reserve(other.m_Vertices.size());
+
   for (const auto &v : other.m_Vertices)
   {
-    m_Vertices.push_back(new ContourModelVertex(*v));
+    m_Vertices.push_back(m_VertexPool->Allocate(v->Coordinates, v->IsControlPoint));
   }
 }
 
@@ -72,9 +459,11 @@ mitk::ContourElement &mitk::ContourElement::operator=(const ContourElement &othe
   if (this != &other)
   {
     this->Clear();
+    m_Vertices.reserve(other.m_Vertices.size());
+
     for (const auto &v : other.m_Vertices)
     {
-      m_Vertices.push_back(new ContourModelVertex(*v));
+      m_Vertices.push_back(m_VertexPool->Allocate(v->Coordinates, v->IsControlPoint));
     }
   }
 
@@ -94,12 +483,14 @@ mitk::ContourElement::VertexSizeType mitk::ContourElement::GetSize() const
 
 void mitk::ContourElement::AddVertex(const mitk::Point3D &vertex, bool isControlPoint)
 {
-  this->m_Vertices.push_back(new VertexType(vertex, isControlPoint));
+  this->m_Vertices.push_back(m_VertexPool->Allocate(vertex, isControlPoint));
+  this->VerticesModified();
 }
 
 void mitk::ContourElement::AddVertexAtFront(const mitk::Point3D &vertex, bool isControlPoint)
 {
-  this->m_Vertices.push_front(new VertexType(vertex, isControlPoint));
+  this->m_Vertices.insert(this->m_Vertices.begin(), m_VertexPool->Allocate(vertex, isControlPoint));
+  this->VerticesModified();
 }
 
 void mitk::ContourElement::InsertVertexAtIndex(const mitk::Point3D &vertex, bool isControlPoint, VertexSizeType index)
@@ -108,7 +499,8 @@ void mitk::ContourElement::InsertVertexAtIndex(const mitk::Point3D &vertex, bool
   {
     auto _where = this->m_Vertices.begin();
     _where += index;
-    this->m_Vertices.insert(_where, new VertexType(vertex, isControlPoint));
+    this->m_Vertices.insert(_where, m_VertexPool->Allocate(vertex, isControlPoint));
+    this->VerticesModified();
   }
 }
 
@@ -117,6 +509,7 @@ void mitk::ContourElement::SetVertexAt(VertexSizeType pointId, const Point3D &po
   if (this->GetSize() > pointId)
   {
     this->m_Vertices[pointId]->Coordinates = point;
+    this->VerticesModified();
   }
 }
 
@@ -131,6 +524,7 @@ void mitk::ContourElement::SetVertexAt(VertexSizeType pointId, const VertexType
   {
     this->m_Vertices[pointId]->Coordinates = vertex->Coordinates;
     this->m_Vertices[pointId]->IsControlPoint = vertex->IsControlPoint;
+    this->VerticesModified();
   }
 }
 
@@ -151,52 +545,118 @@ bool mitk::ContourElement::IsEmpty() const
 
 mitk::ContourElement::VertexType *mitk::ContourElement::GetControlVertexAt(const mitk::Point3D &point, float eps)
 {
-  /* current version iterates over the whole deque - should some kind of an octree with spatial query*/
-
   if (eps > 0)
   {
-    // currently no method with better performance is available
-    return BruteForceGetVertexAt(point, eps, true);
+    return this->FindVertexAt(point, eps, true, 0);
   } // if eps < 0
   return nullptr;
 }
 
 mitk::ContourElement::VertexType *mitk::ContourElement::GetVertexAt(const mitk::Point3D &point, float eps)
 {
-  /* current version iterates over the whole deque - should some kind of an octree with spatial query*/
-
   if (eps > 0)
   {
-    // currently no method with better performance is available
-    return BruteForceGetVertexAt(point, eps);
+    return this->FindVertexAt(point, eps, false, 0);
   } // if eps < 0
   return nullptr;
 }
 
 mitk::ContourElement::VertexType *mitk::ContourElement::GetNextControlVertexAt(const mitk::Point3D &point, float eps)
 {
-  /* current version iterates over the whole deque - should some kind of an octree with spatial query*/
-
   if (eps > 0)
   {
-    // currently no method with better performance is available
-    return BruteForceGetVertexAt(point, eps, true, 1);
+    return this->FindVertexAt(point, eps, true, 1);
   } // if eps < 0
   return nullptr;
 }
 
 mitk::ContourElement::VertexType *mitk::ContourElement::GetPreviousControlVertexAt(const mitk::Point3D &point, float eps)
 {
-  /* current version iterates over the whole deque - should some kind of an octree with spatial query*/
-
   if (eps > 0)
   {
-    // currently no method with better performance is available
-    return BruteForceGetVertexAt(point, eps, true, -1);
+    return this->FindVertexAt(point, eps, true, -1);
   } // if eps < 0
   return nullptr;
 }
 
+void mitk::ContourElement::VerticesModified()
+{
+  m_SpatialIndex.reset();
+}
+
+const mitk::ContourElement::SpatialIndex &mitk::ContourElement::GetSpatialIndex() const
+{
+  if (nullptr == m_SpatialIndex)
+    m_SpatialIndex = std::make_unique<SpatialIndex>(m_Vertices);
+
+  return *m_SpatialIndex;
+}
+
+mitk::ContourElement::VertexSizeType mitk::ContourElement::FindNearestVertexIndex(const mitk::Point3D &point,
+                                                                                  double eps,
+                                                                                  bool isControlPoint) const
+{
+  if (eps < 0)
+  {
+    mitkThrow() << "Distance cannot be negative";
+  }
+
+  const auto &spatialIndex = this->GetSpatialIndex();
+  const double eps2 = eps * eps;
+
+  VertexSizeType nearestIndex = NPOS;
+  double nearestDistance = std::numeric_limits<double>::max();
+
+  spatialIndex.VisitVertices(point, eps, [&](std::size_t index) {
+    const double distance = spatialIndex.GetSquaredDistanceToVertex(index, point);
+
+    if (distance < eps2 && (distance < nearestDistance || (distance == nearestDistance && index < nearestIndex)) &&
+        (!isControlPoint || m_Vertices[index]->IsControlPoint))
+    {
+      nearestIndex = index;
+      nearestDistance = distance;
+    }
+  });
+
+  return nearestIndex;
+}
+
+mitk::ContourElement::VertexType *mitk::ContourElement::FindVertexAt(const mitk::Point3D &point,
+                                                                     double eps,
+                                                                     bool isControlPoint,
+                                                                     int offset)
+{
+  auto index = this->FindNearestVertexIndex(point, eps, isControlPoint);
+
+  if (NPOS == index)
+    return nullptr;
+
+  if (isControlPoint)
+  {
+    // step to the next/previous control vertex, wrapping around at the ends of the contour
+    const auto size = static_cast<long long>(m_Vertices.size());
+    const auto step = offset < 0 ? -1LL : 1LL;
+    auto current = static_cast<long long>(index);
+
+    for (int i = 0; i < std::abs(offset); ++i)
+    {
+      do
+      {
+        current = (current + step + size) % size;
+      } while (!m_Vertices[current]->IsControlPoint);
+    }
+
+    index = static_cast<VertexSizeType>(current);
+  }
+  else
+  {
+    const auto size = static_cast<long long>(m_Vertices.size());
+    index = static_cast<VertexSizeType>(((static_cast<long long>(index) + offset) % size + size) % size);
+  }
+
+  return m_Vertices[index];
+}
+
 mitk::ContourElement::VertexType *mitk::ContourElement::BruteForceGetVertexAt(const mitk::Point3D &point,
                                                                               double eps,
                                                                               bool isControlPoint,
@@ -299,58 +759,39 @@ bool mitk::ContourElement::IsNearContour(const mitk::Point3D& point, float eps)
 bool mitk::ContourElement::GetLineSegmentForPoint(const mitk::Point3D& point,
   float eps, VertexSizeType& segmentStartIndex, VertexSizeType& segmentEndIndex, mitk::Point3D& closestContourPoint, bool findClosest) const
 {
-  ConstVertexIterator it1 = this->m_Vertices.begin();
-  ConstVertexIterator it2 = this->m_Vertices.begin();
-  it2++; // it2 runs one position ahead
+  // eps bounds the squared distance between point and segment
+  if (this->m_Vertices.empty() || eps <= 0)
+    return false;
 
-  ConstVertexIterator end = this->m_Vertices.end();
+  const auto &spatialIndex = this->GetSpatialIndex();
 
-  bool closePointFound = false;
-  double closestDistance = std::numeric_limits<double>::max();
-  for (; it1 != end; it1++, it2++)
-  {
-    if (it2 == end)
-      it2 = this->m_Vertices.begin();
+  VertexSizeType foundIndex = NPOS;
+  double foundDistance = std::numeric_limits<double>::max();
 
-    mitk::Point3D v1 = (*it1)->Coordinates;
-    mitk::Point3D v2 = (*it2)->Coordinates;
+  // Candidates are not visited in contour order, so the segment with the lowest index wins among
+  // equally close segments (or among all close enough segments, if the closest one is not requested).
+  spatialIndex.VisitSegments(point, std::sqrt(eps), [&](std::size_t index) {
+    if (!findClosest && index >= foundIndex)
+      return;
 
-    const float l2 = v1.SquaredEuclideanDistanceTo(v2);
+    mitk::Point3D crossPoint;
+    const double distance = spatialIndex.GetSquaredDistanceToSegment(index, point, crossPoint);
 
-    mitk::Vector3D p_v1 = point - v1;
-    mitk::Vector3D v2_v1 = v2 - v1;
-
-    double tc = (p_v1 * v2_v1) / l2;
-
-    // take into account we have line segments and not (infinite) lines
-    if (tc < 0.0)
-    {
-      tc = 0.0;
-    }
-    if (tc > 1.0)
-    {
-      tc = 1.0;
-    }
-
-    mitk::Point3D crossPoint = v1 + v2_v1 * tc;
-
-    double distance = point.SquaredEuclideanDistanceTo(crossPoint);
-
-    if (distance < eps && distance < closestDistance)
+    if (distance < eps &&
+        (!findClosest || distance < foundDistance || (distance == foundDistance && index < foundIndex)))
     {
-      closestDistance = distance;
-      closePointFound = true;
+      foundIndex = index;
+      foundDistance = distance;
       closestContourPoint = crossPoint;
-      segmentStartIndex = std::distance(this->m_Vertices.begin(), it1);
-      segmentEndIndex = std::distance(this->m_Vertices.begin(), it2);
-      if (!findClosest)
-      {
-        return true;
-      }
     }
-  }
+  });
+
+  if (NPOS == foundIndex)
+    return false;
 
-  return closePointFound;
+  segmentStartIndex = foundIndex;
+  segmentEndIndex = (foundIndex + 1) % this->m_Vertices.size();
+  return true;
 }
 
 bool mitk::ContourElement::GetLineSegmentForPoint(const mitk::Point3D &point,
@@ -412,27 +853,32 @@ mitk::ContourElement::VertexListType mitk::ContourElement::GetControlVertices()
 
 void mitk::ContourElement::Concatenate(const mitk::ContourElement *other, bool check)
 {
-  if (other->GetSize() > 0)
+  // indices are used, because other might be this element
+  const auto numberOfSourceVertices = other->GetSize();
+
+  for (VertexSizeType i = 0; i < numberOfSourceVertices; ++i)
   {
-    for (const auto &sourceVertex : other->m_Vertices)
+    const auto sourceVertex = other->m_Vertices[i];
+
+    if (check)
     {
-      if (check)
-      {
-        auto finding =
-          std::find_if(this->m_Vertices.begin(), this->m_Vertices.end(), [sourceVertex](const VertexType *v) {
-            return sourceVertex->Coordinates == v->Coordinates;
-          });
+      auto finding =
+        std::find_if(this->m_Vertices.begin(), this->m_Vertices.end(), [sourceVertex](const VertexType *v) {
+          return sourceVertex->Coordinates == v->Coordinates;
+        });
 
-        if (finding == this->m_Vertices.end())
-        {
-          this->m_Vertices.push_back(new ContourModelVertex(*sourceVertex));
-        }
-      }
-      else
+      if (finding != this->m_Vertices.end())
       {
-        this->m_Vertices.push_back(new ContourModelVertex(*sourceVertex));
+        continue;
       }
     }
+
+    this->m_Vertices.push_back(m_VertexPool->Allocate(sourceVertex->Coordinates, sourceVertex->IsControlPoint));
+  }
+
+  if (numberOfSourceVertices > 0)
+  {
+    this->VerticesModified();
   }
 }
 
@@ -470,13 +916,23 @@ bool mitk::ContourElement::RemoveVertexAt(VertexSizeType index)
 
 bool mitk::ContourElement::RemoveVertexAt(const mitk::Point3D &point, double eps)
 {
-  if (eps > 0)
+  if (eps > 0 && !this->m_Vertices.empty())
   {
-    auto finding = std::find_if(this->m_Vertices.begin(), this->m_Vertices.end(), [point, eps](const VertexType *v) {
-      return v->Coordinates.EuclideanDistanceTo(point) < eps;
+    // first vertex (in contour order) closer than eps
+    const auto &spatialIndex = this->GetSpatialIndex();
+    const double eps2 = eps * eps;
+    auto index = NPOS;
+
+    spatialIndex.VisitVertices(point, eps, [&](std::size_t candidate) {
+      if (candidate < index && spatialIndex.GetSquaredDistanceToVertex(candidate, point) < eps2)
+        index = candidate;
     });
 
-    return RemoveVertexByIterator(finding);
+    if (NPOS != index)
+    {
+      auto finding = this->m_Vertices.begin() + index;
+      return RemoveVertexByIterator(finding);
+    }
   }
   return false;
 }
@@ -485,8 +941,9 @@ bool mitk::ContourElement::RemoveVertexByIterator(VertexListType::iterator &iter
 {
   if (iter != this->m_Vertices.end())
   {
-    delete *iter;
+    m_VertexPool->Release(*iter);
     this->m_Vertices.erase(iter);
+    this->VerticesModified();
     return true;
   }
 
@@ -497,9 +954,11 @@ void mitk::ContourElement::Clear()
 {
   for (auto vertex : m_Vertices)
   {
-    delete vertex;
+    m_VertexPool->Release(vertex);
   }
   this->m_Vertices.clear();
+  this->m_VertexPool->Clear();
+  this->VerticesModified();
 }
 
 //----------------------------------------------------------------------
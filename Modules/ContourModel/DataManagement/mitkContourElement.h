@@ -16,16 +16,23 @@ found in the LICENSE file.
 #include <MitkContourModelExports.h>
 #include <mitkNumericTypes.h>
 
-#include <deque>
+#include <memory>
+#include <vector>
 
 namespace mitk
 {
   /** \brief Represents a contour in 3D space.
   A ContourElement is consisting of linked vertices implicitely defining the contour.
-  They are stored in a double ended queue making it possible to add vertices at front and
-  end of the contour and to iterate in both directions.
+  The vertices are allocated block-wise from a pool of the element and referenced in contour order by a
+  contiguous list, making it possible to add vertices at front and end of the contour and to iterate in
+  both directions. Vertex pointers stay valid until the vertex is removed.
   To mark a vertex as a special one it can be set as a control point.
 
+  Spatial queries (e.g. GetVertexAt(const mitk::Point3D&, float) or GetLineSegmentForPoint()) use a search
+  structure (the vertex coordinates in contiguous arrays and a uniform grid over the contour) that is built
+  on the first query after a modification of the element. If coordinates are changed directly via vertex
+  pointers, VerticesModified() has to be called afterwards.
+
   \note This class assumes that it manages its vertices. So if a vertex instance is added to this
   class the ownership of the vertex is transferred to the ContourElement instance.
   The ContourElement instance takes care of deleting vertex instances if needed.
@@ -62,7 +69,7 @@ namespace mitk
     };
 
     using VertexType = ContourModelVertex;
-    using VertexListType = std::deque<VertexType*>;
+    using VertexListType = std::vector<VertexType*>;
     using VertexIterator = VertexListType::iterator;
     using ConstVertexIterator = VertexListType::const_iterator;
     using VertexSizeType = VertexListType::size_type;
@@ -252,6 +259,11 @@ namespace mitk
     */
     void Clear();
 
+    /** \brief Has to be called if coordinates of vertices were changed directly via vertex pointers
+    (e.g. by ContourModel::ShiftVertex()), so that the next spatial query does not use outdated coordinates.
+    */
+    void VerticesModified();
+
     /** \brief Returns the approximate nearest vertex a given position in 3D space. With the parameter 'isControlPoint', 
     one can decide if any vertex should be returned, or just control vertices.
     \param point - query position in 3D space.
@@ -288,7 +300,7 @@ namespace mitk
   protected:
     mitkCloneMacro(Self);
 
-    ContourElement() = default;
+    ContourElement();
     ContourElement(const mitk::ContourElement &other);
     ~ContourElement();
 
@@ -300,8 +312,26 @@ namespace mitk
     \result Indicates if the element indicated by the iterator was removed. If iterator points to end it returns false.*/
     bool RemoveVertexByIterator(VertexListType::iterator& iter);
 
-    VertexListType m_Vertices; // double ended queue with vertices
+    VertexListType m_Vertices; // vertices in contour order
     bool m_IsClosed = false;
+
+  private:
+    class VertexPool;
+    class SpatialIndex;
+
+    /** Returns the search structure of the current vertices (builds it if needed).*/
+    const SpatialIndex& GetSpatialIndex() const;
+
+    /** Index of the nearest (control) vertex with a distance < eps to the point (the first one in
+    case of equal distances) or NPOS.*/
+    VertexSizeType FindNearestVertexIndex(const mitk::Point3D &point, double eps, bool isControlPoint) const;
+
+    /** Nearest (control) vertex like FindNearestVertexIndex(), shifted by offset control vertices (with wrap
+    around) if isControlPoint is true.*/
+    VertexType *FindVertexAt(const mitk::Point3D &point, double eps, bool isControlPoint, int offset);
+
+    std::unique_ptr<VertexPool> m_VertexPool;
+    mutable std::unique_ptr<SpatialIndex> m_SpatialIndex;
   };
 } // namespace mitk
 
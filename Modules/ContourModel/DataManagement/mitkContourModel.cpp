@@ -480,6 +480,13 @@ void mitk::ContourModel::ShiftSelectedVertex(Vector3D &translate)
   if (this->m_SelectedVertex)
   {
     this->ShiftVertex(this->m_SelectedVertex, translate);
+
+    // the selected vertex might belong to any time step
+    for (auto &contourElement : this->m_ContourSeries)
+    {
+      contourElement->VerticesModified();
+    }
+
     this->Modified();
     this->m_UpdateBoundingBox = true;
   }
@@ -495,6 +502,7 @@ void mitk::ContourModel::ShiftContour(Vector3D &translate, TimeStepType timestep
       this->ShiftVertex(vertex, translate);
     }
 
+    this->m_ContourSeries[timestep]->VerticesModified();
     this->Modified();
     this->m_UpdateBoundingBox = true;
     this->InvokeEvent(ContourModelShiftEvent());
@@ -3,6 +3,7 @@ set(MODULE_TESTS
   mitkContourModelTest.cpp
   mitkContourModelIOTest.cpp
   mitkContourModelSetTest.cpp
+  mitkContourModelUtilsTest.cpp
 )
 
 set(MODULE_IMAGE_TESTS
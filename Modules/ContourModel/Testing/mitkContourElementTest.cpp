@@ -14,6 +14,7 @@ found in the LICENSE file.
 
 #include "mitkTestFixture.h"
 #include "mitkTestingMacros.h"
+#include <cmath>
 #include <limits>
 
 class mitkContourElementTestSuite : public mitk::TestFixture
@@ -33,6 +34,9 @@ class mitkContourElementTestSuite : public mitk::TestFixture
   MITK_TEST(GetControlVertices);
   MITK_TEST(RedistributeControlVertices);
   MITK_TEST(Others);
+  MITK_TEST(SpatialQueriesOfLargeContour);
+  MITK_TEST(StableVertexPointers);
+  MITK_TEST(VerticesModified);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -346,6 +350,104 @@ public:
     CPPUNIT_ASSERT(m_Contour5to6->GetSize() == copyConstructed->GetSize());
   }
 
+  static mitk::ContourElement::Pointer GenerateCircle(unsigned int numberOfVertices)
+  {
+    auto contour = mitk::ContourElement::New();
+
+    for (unsigned int i = 0; i < numberOfVertices; ++i)
+    {
+      const double angle = 2.0 * itk::Math::pi * i / numberOfVertices;
+      mitk::Point3D point;
+      point[0] = 50.0 * std::cos(angle);
+      point[1] = 50.0 * std::sin(angle);
+      point[2] = 7.0;
+      contour->AddVertex(point, 0 == i % 5);
+    }
+
+    return contour;
+  }
+
+  void SpatialQueriesOfLargeContour()
+  {
+    auto contour = GenerateCircle(2000);
+
+    for (int x = -60; x <= 60; x += 3)
+    {
+      for (int y = -60; y <= 60; y += 3)
+      {
+        mitk::Point3D point;
+        point[0] = x + 0.25;
+        point[1] = y;
+        point[2] = 7.2;
+
+        CPPUNIT_ASSERT(contour->GetVertexAt(point, 1.5) == contour->BruteForceGetVertexAt(point, 1.5));
+        CPPUNIT_ASSERT(contour->GetControlVertexAt(point, 1.5) == contour->BruteForceGetVertexAt(point, 1.5, true));
+        CPPUNIT_ASSERT(contour->GetNextControlVertexAt(point, 1.5) == contour->BruteForceGetVertexAt(point, 1.5, true, 1));
+        CPPUNIT_ASSERT(contour->GetPreviousControlVertexAt(point, 1.5) == contour->BruteForceGetVertexAt(point, 1.5, true, -1));
+
+        const auto radius = std::sqrt(point[0] * point[0] + point[1] * point[1]);
+        const bool isNear = std::abs(radius - 50.0) < 0.1;
+        const bool isFar = std::abs(radius - 50.0) > 3.0;
+
+        if (isNear)
+          CPPUNIT_ASSERT(contour->IsNearContour(point, 1.0));
+        if (isFar)
+          CPPUNIT_ASSERT(!contour->IsNearContour(point, 1.0));
+      }
+    }
+
+    mitk::Point3D onContour;
+    onContour[0] = 0.5 * (contour->GetVertexAt(10)->Coordinates[0] + contour->GetVertexAt(11)->Coordinates[0]);
+    onContour[1] = 0.5 * (contour->GetVertexAt(10)->Coordinates[1] + contour->GetVertexAt(11)->Coordinates[1]);
+    onContour[2] = 7.0;
+
+    mitk::ContourElement::VertexSizeType segmentStart = 0;
+    mitk::ContourElement::VertexSizeType segmentEnd = 0;
+    mitk::Point3D closestPoint;
+    CPPUNIT_ASSERT(contour->GetLineSegmentForPoint(onContour, 0.01, segmentStart, segmentEnd, closestPoint));
+    CPPUNIT_ASSERT_EQUAL(mitk::ContourElement::VertexSizeType(10), segmentStart);
+    CPPUNIT_ASSERT_EQUAL(mitk::ContourElement::VertexSizeType(11), segmentEnd);
+    CPPUNIT_ASSERT(mitk::Equal(onContour, closestPoint, 1e-6, true));
+  }
+
+  void StableVertexPointers()
+  {
+    auto contour = GenerateCircle(1000);
+    auto vertex = contour->GetVertexAt(500);
+    const auto coordinates = vertex->Coordinates;
+    // lies in the first (smallest) block of the pool
+    auto firstVertex = contour->GetVertexAt(3);
+    const auto firstCoordinates = firstVertex->Coordinates;
+
+    for (int i = 0; i < 1000; ++i)
+      contour->AddVertexAtFront(GeneratePoint(i), false);
+
+    contour->RemoveVertexAt(0);
+    contour->RemoveVertexAt(1998);
+
+    CPPUNIT_ASSERT(vertex->Coordinates == coordinates);
+    CPPUNIT_ASSERT_EQUAL(mitk::ContourElement::VertexSizeType(1499), contour->GetIndex(vertex));
+    CPPUNIT_ASSERT(contour->GetVertexAt(coordinates, 0.01) == vertex);
+    CPPUNIT_ASSERT(firstVertex->Coordinates == firstCoordinates);
+    CPPUNIT_ASSERT_EQUAL(mitk::ContourElement::VertexSizeType(1002), contour->GetIndex(firstVertex));
+  }
+
+  void VerticesModified()
+  {
+    auto contour = GenerateCircle(1000);
+    auto vertex = contour->GetVertexAt(0);
+    const mitk::Point3D target = GeneratePoint(100);
+
+    CPPUNIT_ASSERT(nullptr == contour->GetVertexAt(target, 0.1));
+
+    vertex->Coordinates = target;
+    contour->VerticesModified();
+    CPPUNIT_ASSERT(contour->GetVertexAt(target, 0.1) == vertex);
+
+    contour->SetVertexAt(0, GeneratePoint(200));
+    CPPUNIT_ASSERT(nullptr == contour->GetVertexAt(target, 0.1));
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkContourElement)
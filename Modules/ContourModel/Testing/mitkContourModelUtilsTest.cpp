@@ -0,0 +1,270 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkContourModelToSurfaceFilter.h>
+#include <mitkContourModelUtils.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkSurface.h>
+
+#include <vtkImageStencil.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataToImageStencil.h>
+
+#include <itkMath.h>
+
+#include <algorithm>
+#include <cmath>
+
+class mitkContourModelUtilsTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkContourModelUtilsTestSuite);
+  MITK_TEST(FillSquare);
+  MITK_TEST(FillConcavePolygon);
+  MITK_TEST(FillSelfIntersectingPolygon);
+  MITK_TEST(FillClippedPolygon);
+  MITK_TEST(FillRespectsLockedLabels);
+  MITK_TEST(EraseOnlyActiveLabel);
+  MITK_TEST(CompareWithStencil);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  using PixelType = mitk::LabelSetImage::LabelValueType;
+
+  mitk::Image::Pointer m_Slice;
+
+  static mitk::Image::Pointer CreateSlice(unsigned int width, unsigned int height)
+  {
+    unsigned int dimensions[2] = { width, height };
+    auto slice = mitk::Image::New();
+    slice->Initialize(mitk::MakeScalarPixelType<PixelType>(), 2, dimensions);
+
+    mitk::ImagePixelWriteAccessor<PixelType, 2> accessor(slice);
+    std::fill(accessor.GetData(), accessor.GetData() + width * height, 0);
+
+    return slice;
+  }
+
+  static mitk::ContourModel::Pointer CreateContour(const std::vector<std::pair<double, double>>& points)
+  {
+    auto contour = mitk::ContourModel::New();
+
+    for (const auto& point : points)
+    {
+      mitk::Point3D vertex;
+      vertex[0] = point.first;
+      vertex[1] = point.second;
+      vertex[2] = 0.0;
+      contour->AddVertex(vertex);
+    }
+
+    contour->Close();
+    return contour;
+  }
+
+  static PixelType GetPixel(const mitk::Image* slice, int x, int y)
+  {
+    mitk::ImagePixelReadAccessor<PixelType, 2> accessor(slice);
+    itk::Index<2> index;
+    index[0] = x;
+    index[1] = y;
+    return accessor.GetPixelByIndex(index);
+  }
+
+  static void SetPixel(mitk::Image* slice, int x, int y, PixelType value)
+  {
+    mitk::ImagePixelWriteAccessor<PixelType, 2> accessor(slice);
+    itk::Index<2> index;
+    index[0] = x;
+    index[1] = y;
+    accessor.SetPixelByIndex(index, value);
+  }
+
+  static unsigned int CountPixels(const mitk::Image* slice, PixelType value)
+  {
+    mitk::ImagePixelReadAccessor<PixelType, 2> accessor(slice);
+    const auto numberOfPixels = slice->GetDimension(0) * slice->GetDimension(1);
+    return static_cast<unsigned int>(std::count(accessor.GetData(), accessor.GetData() + numberOfPixels, value));
+  }
+
+  /** Former implementation of FillContourInSlice2, used as reference for the results.*/
+  static void FillWithStencil(const mitk::ContourModel* contour, mitk::Image* slice, int paintingPixelValue)
+  {
+    auto contourModelFilter = mitk::ContourModelToSurfaceFilter::New();
+    contourModelFilter->SetInput(contour);
+    contourModelFilter->Update();
+
+    auto surface = contourModelFilter->GetOutput();
+
+    auto surface2D = vtkSmartPointer<vtkPolyData>::New();
+    surface2D->SetPoints(surface->GetVtkPolyData(0)->GetPoints());
+    surface2D->SetLines(surface->GetVtkPolyData(0)->GetLines());
+
+    auto polyDataToImageStencil = vtkSmartPointer<vtkPolyDataToImageStencil>::New();
+    polyDataToImageStencil->SetTolerance(mitk::eps);
+    polyDataToImageStencil->SetInputData(surface2D);
+    polyDataToImageStencil->Update();
+
+    auto imageStencil = vtkSmartPointer<vtkImageStencil>::New();
+    imageStencil->SetInputData(slice->GetVtkImageData());
+    imageStencil->SetStencilConnection(polyDataToImageStencil->GetOutputPort());
+    imageStencil->ReverseStencilOn();
+    imageStencil->SetBackgroundValue(paintingPixelValue);
+    imageStencil->Update();
+
+    slice->SetVolume(imageStencil->GetOutput()->GetScalarPointer());
+  }
+
+  static mitk::LabelSetImage::Pointer CreateLabelSetImage(const mitk::Image* slice)
+  {
+    auto labelSetImage = mitk::LabelSetImage::New();
+    labelSetImage->Initialize(slice);
+
+    for (PixelType value = 1; value <= 2; ++value)
+    {
+      auto label = mitk::Label::New();
+      label->SetValue(value);
+      label->SetName("Label" + std::to_string(value));
+      labelSetImage->AddLabel(label, 0, true, false);
+    }
+
+    return labelSetImage;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Slice = CreateSlice(12, 10);
+  }
+
+  void tearDown() override
+  {
+    m_Slice = nullptr;
+  }
+
+  void FillSquare()
+  {
+    auto contour = CreateContour({ { 2.0, 2.0 }, { 5.0, 2.0 }, { 5.0, 5.0 }, { 2.0, 5.0 } });
+    mitk::ContourModelUtils::FillContourInSlice2(contour, m_Slice, 1);
+
+    CPPUNIT_ASSERT_EQUAL(16u, CountPixels(m_Slice, 1));
+
+    for (int y = 2; y <= 5; ++y)
+    {
+      for (int x = 2; x <= 5; ++x)
+        CPPUNIT_ASSERT_EQUAL(PixelType(1), GetPixel(m_Slice, x, y));
+    }
+  }
+
+  void FillConcavePolygon()
+  {
+    // U-shape: the notch between x = 3.5 and x = 6.5 above y = 3.5 stays empty
+    auto contour = CreateContour({ { 0.5, 0.5 }, { 9.5, 0.5 }, { 9.5, 7.5 }, { 6.5, 7.5 },
+                                   { 6.5, 3.5 }, { 3.5, 3.5 }, { 3.5, 7.5 }, { 0.5, 7.5 } });
+    mitk::ContourModelUtils::FillContourInSlice2(contour, m_Slice, 3);
+
+    CPPUNIT_ASSERT_EQUAL(PixelType(3), GetPixel(m_Slice, 1, 1));
+    CPPUNIT_ASSERT_EQUAL(PixelType(3), GetPixel(m_Slice, 5, 3));
+    CPPUNIT_ASSERT_EQUAL(PixelType(3), GetPixel(m_Slice, 2, 7));
+    CPPUNIT_ASSERT_EQUAL(PixelType(3), GetPixel(m_Slice, 8, 7));
+    CPPUNIT_ASSERT_EQUAL(PixelType(0), GetPixel(m_Slice, 5, 4));
+    CPPUNIT_ASSERT_EQUAL(PixelType(0), GetPixel(m_Slice, 5, 7));
+    CPPUNIT_ASSERT_EQUAL(PixelType(0), GetPixel(m_Slice, 10, 1));
+    CPPUNIT_ASSERT_EQUAL(9u * 3u + 6u * 4u, CountPixels(m_Slice, 3));
+  }
+
+  void FillSelfIntersectingPolygon()
+  {
+    // Two overlapping rectangles traced as one polygon; the overlap is outside with the even-odd rule.
+    auto contour = CreateContour({ { 0.5, 0.5 }, { 6.5, 0.5 }, { 6.5, 4.5 }, { 3.5, 4.5 }, { 3.5, 2.5 },
+                                   { 9.5, 2.5 }, { 9.5, 8.5 }, { 3.5, 8.5 }, { 3.5, 4.5 }, { 0.5, 4.5 } });
+    mitk::ContourModelUtils::FillContourInSlice2(contour, m_Slice, 1);
+
+    CPPUNIT_ASSERT_EQUAL(PixelType(1), GetPixel(m_Slice, 1, 1));
+    CPPUNIT_ASSERT_EQUAL(PixelType(1), GetPixel(m_Slice, 8, 7));
+    CPPUNIT_ASSERT_EQUAL(PixelType(0), GetPixel(m_Slice, 5, 3));
+  }
+
+  void FillClippedPolygon()
+  {
+    auto contour = CreateContour({ { -5.0, -5.0 }, { 20.0, -5.0 }, { 20.0, 20.0 }, { -5.0, 20.0 } });
+    mitk::ContourModelUtils::FillContourInSlice2(contour, m_Slice, 1);
+
+    CPPUNIT_ASSERT_EQUAL(12u * 10u, CountPixels(m_Slice, 1));
+  }
+
+  void FillRespectsLockedLabels()
+  {
+    auto labelSetImage = CreateLabelSetImage(m_Slice);
+    labelSetImage->GetLabel(2)->SetLocked(true);
+
+    SetPixel(m_Slice, 3, 3, 2);
+    SetPixel(m_Slice, 4, 4, 1);
+
+    auto contour = CreateContour({ { 2.0, 2.0 }, { 5.0, 2.0 }, { 5.0, 5.0 }, { 2.0, 5.0 } });
+    mitk::ContourModelUtils::FillContourInSlice(contour, 0, m_Slice, labelSetImage, 1);
+
+    CPPUNIT_ASSERT_EQUAL(PixelType(2), GetPixel(m_Slice, 3, 3));
+    CPPUNIT_ASSERT_EQUAL(PixelType(1), GetPixel(m_Slice, 4, 4));
+    CPPUNIT_ASSERT_EQUAL(15u, CountPixels(m_Slice, 1));
+  }
+
+  void EraseOnlyActiveLabel()
+  {
+    auto labelSetImage = CreateLabelSetImage(m_Slice);
+    labelSetImage->SetActiveLabel(1);
+
+    SetPixel(m_Slice, 3, 3, 1);
+    SetPixel(m_Slice, 4, 4, 2);
+    SetPixel(m_Slice, 8, 8, 1);
+
+    auto contour = CreateContour({ { 2.0, 2.0 }, { 5.0, 2.0 }, { 5.0, 5.0 }, { 2.0, 5.0 } });
+    mitk::ContourModelUtils::FillContourInSlice(contour, 0, m_Slice, labelSetImage, mitk::LabelSetImage::UNLABELED_VALUE);
+
+    CPPUNIT_ASSERT_EQUAL(PixelType(0), GetPixel(m_Slice, 3, 3));
+    CPPUNIT_ASSERT_EQUAL(PixelType(2), GetPixel(m_Slice, 4, 4));
+    CPPUNIT_ASSERT_EQUAL(PixelType(1), GetPixel(m_Slice, 8, 8));
+  }
+
+  void CompareWithStencil()
+  {
+    constexpr unsigned int size = 512;
+
+    std::vector<std::pair<double, double>> points;
+
+    for (int i = 0; i < 360; ++i)
+    {
+      const double angle = i * itk::Math::pi / 180.0;
+      const double radius = 150.3 + 40.7 * std::sin(5.0 * angle);
+      points.emplace_back(255.17 + radius * std::cos(angle), 255.41 + radius * std::sin(angle));
+    }
+
+    auto contour = CreateContour(points);
+
+    auto referenceSlice = CreateSlice(size, size);
+    auto slice = CreateSlice(size, size);
+
+    FillWithStencil(contour, referenceSlice, 1);
+    mitk::ContourModelUtils::FillContourInSlice2(contour, slice, 1);
+
+    mitk::ImagePixelReadAccessor<PixelType, 2> referenceAccessor(referenceSlice);
+    mitk::ImagePixelReadAccessor<PixelType, 2> accessor(slice);
+    CPPUNIT_ASSERT(std::equal(referenceAccessor.GetData(), referenceAccessor.GetData() + size * size, accessor.GetData()));
+    CPPUNIT_ASSERT(CountPixels(slice, 1) > 0);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkContourModelUtils)
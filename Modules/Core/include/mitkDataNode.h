@@ -29,8 +29,12 @@ found in the LICENSE file.
 
 #include "mitkGeometry3D.h"
 #include "mitkLevelWindow.h"
+#include <condition_variable>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <set>
+#include <thread>
 
 class vtkLinearTransform;
 
@@ -84,12 +88,57 @@ namespace mitk
 
     mitk::Mapper *GetMapper(MapperSlotId id) const;
 
+    /**
+     * \brief Function creating the data object of a node on demand (see SetDataProvider()).
+     *
+     * Returns nullptr if the data could not be created.
+     */
+    using DataProviderFunction = std::function<BaseData::Pointer()>;
+
     /**
      * \brief Get the data object (instance of BaseData, e.g., an Image)
      * managed by this DataNode
+     *
+     * If the node has a data provider but no data yet, the data is created by
+     * the provider first (see SetDataProvider()).
      */
     BaseData *GetData() const;
 
+    /**
+     * \brief Defer the creation of the data object until it is accessed for the first time.
+     *
+     * As long as the node has no data, the first call of GetData() invokes the provider
+     * and assigns its result. In contrast to SetData(), the properties of the node are kept
+     * and only missing default properties are added. The provider is kept after loading to
+     * be able to recreate the data after ReleaseData(). Calling SetData() discards the provider.
+     */
+    void SetDataProvider(const DataProviderFunction &provider);
+
+    /**
+     * \brief Check if the data of this node is created on demand by a data provider.
+     */
+    bool HasDataProvider() const;
+
+    /**
+     * \brief Check if the node currently holds a data object without triggering its data provider.
+     */
+    bool IsDataLoaded() const;
+
+    /**
+     * \brief Get the data object without triggering the data provider.
+     *
+     * Returns nullptr if the node has no data or its data is not loaded yet.
+     */
+    BaseData::Pointer GetLoadedData() const;
+
+    /**
+     * \brief Drop the data object of a node with data provider.
+     *
+     * The data is recreated by the provider on next access. Does nothing if the node has no
+     * data provider.
+     */
+    void ReleaseData();
+
     /**
      * \brief Get the transformation applied prior to displaying the data as
      * a vtkTransform
@@ -583,6 +632,9 @@ namespace mitk
     /// Invoked when the property list was modified. Calls Modified() of the DataNode
     virtual void PropertyListModified(const itk::Object *caller, const itk::EventObject &event);
 
+    /// Assigns the data created by m_DataProvider (see SetDataProvider())
+    void LoadDataFromProvider();
+
     /// \brief Mapper-slots
     mutable MapperVector m_Mappers;
 
@@ -592,6 +644,15 @@ namespace mitk
      */
     BaseData::Pointer m_Data;
 
+    /// \brief Creates m_Data on first access, if set
+    DataProviderFunction m_DataProvider;
+    /// Guards m_DataProvider, the loading state and m_Data while it is created by or released to the provider
+    mutable std::mutex m_DataProviderMutex;
+    /// Signals the end of a provider call to threads waiting for its data
+    std::condition_variable m_DataProviderCondition;
+    bool m_IsLoadingData = false;
+    std::thread::id m_LoadingThread;
+
     /**
      * \brief BaseRenderer-independent PropertyList
      *
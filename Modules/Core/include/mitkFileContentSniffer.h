@@ -0,0 +1,123 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkFileContentSniffer_h
+#define mitkFileContentSniffer_h
+
+#include <MitkCoreExports.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * \ingroup IO
+   *
+   * \brief Shared, cached content sniffing for mime type detection.
+   *
+   * MimeTypeProvider::GetMimeTypesForFile() asks every registered CustomMimeType whether it applies
+   * to a file. Many of them have to look into the file to decide (e.g. all DICOM based mime types), which
+   * used to mean that the same header was opened and parsed once per mime type. CustomMimeType::AppliesTo()
+   * implementations should therefore use Sniff() to get a Content instance for the path. It is shared
+   * between all mime types and calls for the same path and gives access to
+   *   - the first bytes of the file (GetPrefix()),
+   *   - the DICOM header as read by GDCM, parsed at most once (IsDicom(), GetDicomTagValue()),
+   *   - arbitrary classification results of other modules, computed at most once (GetValue()).
+   *
+   * Contents are cached per path. A cached content is reused as long as the modification time and size
+   * of the path did not change. The cache is bounded (see SetMaximumCacheSize()); the entries that were
+   * least recently used are dropped first. All methods are thread-safe.
+   */
+  class MITKCORE_EXPORT FileContentSniffer
+  {
+  public:
+    /** Number of bytes read into the prefix. Covers the DICOM preamble and the "DICM" magic. */
+    static const std::size_t PREFIX_SIZE;
+
+    class MITKCORE_EXPORT Content
+    {
+    public:
+      explicit Content(const std::string &path);
+
+      const std::string &GetPath() const { return m_Path; }
+      bool Exists() const { return m_Exists; }
+      bool IsDirectory() const { return m_IsDirectory; }
+
+      /** First PREFIX_SIZE bytes of the file (less if the file is smaller). Empty for directories. */
+      const std::string &GetPrefix() const { return m_Prefix; }
+
+      /** True if the file starts with a DICOM preamble followed by the "DICM" magic. */
+      bool HasDicomPreamble() const;
+
+      /** True if GDCM could read the image information of the file or, for directories,
+       * of at least one file within the directory. The header is parsed on first request only.*/
+      bool IsDicom() const;
+
+      /** For files the path itself, for directories the first file in the directory that is DICOM.
+       * Empty if IsDicom() is false.*/
+      std::string GetDicomFilePath() const;
+
+      /** Value of a DICOM tag of the file returned by GetDicomFilePath() in GDCM notation
+       * (e.g. "0008|0060" for the modality). Empty if the tag is not present.*/
+      std::string GetDicomTagValue(const std::string &tag) const;
+
+      /** Result of itk::GDCMImageIO::CanReadFile for the file returned by GetDicomFilePath(). */
+      bool CanReadDicomImage() const;
+
+      /** Returns the value stored for key. If there is none, the passed function is called to
+       * compute it. Use this to share results of sniffing code that does not live in the core
+       * (e.g. a DCMTK tag scan) between several mime types. Keys should be prefixed with the
+       * module name to avoid clashes.*/
+      std::string GetValue(const std::string &key, const std::function<std::string()> &compute) const;
+
+    private:
+      void ParseDicomHeader() const;
+
+      std::string m_Path;
+      bool m_Exists;
+      bool m_IsDirectory;
+      std::string m_Prefix;
+
+      mutable std::once_flag m_DicomFlag;
+      mutable bool m_IsDicom;
+      mutable bool m_CanReadDicomImage;
+      mutable std::string m_DicomFilePath;
+      mutable std::map<std::string, std::string> m_DicomTags;
+
+      mutable std::mutex m_ValuesMutex;
+      mutable std::map<std::string, std::string> m_Values;
+    };
+
+    /** Returns the (possibly cached) content of path. Never returns nullptr, also not for
+     * non-existing paths. */
+    static std::shared_ptr<const Content> Sniff(const std::string &path);
+
+    static void ClearCache();
+    static std::size_t GetCacheSize();
+
+    static void SetMaximumCacheSize(std::size_t size);
+    static std::size_t GetMaximumCacheSize();
+
+    /** Number of contents that were created (i.e. not taken from the cache) since the
+     * last call of ClearCache(). Useful to monitor the efficiency of the cache.*/
+    static std::size_t GetNumberOfSniffedPaths();
+
+  private:
+    FileContentSniffer() = delete;
+  };
+}
+
+#endif
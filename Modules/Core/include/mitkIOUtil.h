@@ -24,6 +24,7 @@ found in the LICENSE file.
 #include <mitkIFileReader.h>
 #include <mitkIFileWriter.h>
 
+#include <chrono>
 #include <fstream>
 
 #if !defined(MITK_WINDOWS_NO_UNDEF) && defined(GetTempPath)
@@ -64,6 +65,9 @@ namespace mitk
       bool m_Cancel;
 
       const PropertyList* m_Properties;
+
+      /** Time spent by the selected reader to read m_Path. Set by the load operation. */
+      std::chrono::milliseconds m_ReadDuration;
     };
 
     /**Struct that is the base class for option callbacks used in load operations. The callback is used by IOUtil, if
@@ -321,6 +325,43 @@ namespace mitk
     static std::vector<BaseData::Pointer> Load(const std::vector<std::string> &paths,
                                                const ReaderOptionsFunctorBase *optionsCallback = nullptr);
 
+    /**
+     * @brief Loads a list of LoadInfo objects into the given DataStorage, reading several files concurrently.
+     *
+     * The readers are selected (and \c optionsCallback is called) on the calling thread in the order
+     * of \c loadInfos. Afterwards up to \c maximumNumberOfConcurrentReads files are read in parallel.
+     * The loaded nodes are added to \c storage on the calling thread in the order of \c loadInfos,
+     * independent of the order in which the reads finished. The time spent to read each file is
+     * stored in LoadInfo::m_ReadDuration.
+     *
+     * The selected readers must not depend on each other. Files that are read as part of a previous
+     * file (e.g. the slices of a DICOM series) are read again and their results are dropped, so
+     * the sequential load is the better choice for such input.
+     *
+     * If an entry in \c loadInfos cannot be loaded, this method will continue to load
+     * the remaining entries into \c storage and throw an exception afterwards.
+     *
+     * @param loadInfos The files to load. The loaded data is also available via LoadInfo::m_Output.
+     * @param storage A DataStorage object to which the loaded data will be added.
+     * @param maximumNumberOfConcurrentReads Maximum number of files that are read at the same time.
+     * 0 uses the number of hardware threads, 1 reads the files sequentially.
+     * @param optionsCallback Pointer to a callback instance (see Load(const std::vector<std::string>&, DataStorage&, const ReaderOptionsFunctorBase*)).
+     * @return The set of added DataNode objects.
+     * @throws mitk::Exception if an entry in \c loadInfos could not be loaded.
+     */
+    static DataStorage::SetOfObjects::Pointer Load(std::vector<LoadInfo> &loadInfos,
+                                                   DataStorage &storage,
+                                                   unsigned int maximumNumberOfConcurrentReads,
+                                                   const ReaderOptionsFunctorBase *optionsCallback = nullptr);
+
+    /**
+     * @brief Loads a list of LoadInfo objects, reading several files concurrently.
+     * @sa Load(std::vector<LoadInfo>&, DataStorage&, unsigned int, const ReaderOptionsFunctorBase*)
+     */
+    static std::vector<BaseData::Pointer> Load(std::vector<LoadInfo> &loadInfos,
+                                               unsigned int maximumNumberOfConcurrentReads,
+                                               const ReaderOptionsFunctorBase *optionsCallback = nullptr);
+
     /**
      * @brief Loads the contents of a us::ModuleResource and returns the corresponding mitk::BaseData
      * @param usResource a ModuleResource, representing a BaseData object
@@ -423,7 +464,8 @@ namespace mitk
     static std::string Load(std::vector<LoadInfo> &loadInfos,
                             DataStorage::SetOfObjects *nodeResult,
                             DataStorage *ds,
-                            const ReaderOptionsFunctorBase *optionsCallback);
+                            const ReaderOptionsFunctorBase *optionsCallback,
+                            unsigned int maximumNumberOfConcurrentReads = 1);
 
     static std::string Save(const BaseData *data,
                             const std::string &mimeType,
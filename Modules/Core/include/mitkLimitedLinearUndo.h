@@ -100,6 +100,11 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     void SetUndoLimit(std::size_t limit) override;
 
+    //##Documentation
+    //## @brief Returns the memory in bytes occupied by the data
+    //## of all items in the undo and the redo list.
+    std::size_t GetMemorySize() const override;
+
     //##Documentation
     //## @brief Returns the ObjectEventId of the
     //## top element in the OperationHistory
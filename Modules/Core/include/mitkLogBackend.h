@@ -26,8 +26,11 @@ namespace mitk
     void ProcessMessage(const LogMessage&) override;
 
     /** \brief Registers MITK log backend.
+     *
+     * \param asynchronous If true, the backend is wrapped in a LogBackendAsync, so that formatting and
+     * writing of messages (including the log file) is done by a separate writer thread.
      */
-    static void Register();
+    static void Register(bool asynchronous = false);
 
     /** \brief Unregister MITK log backend.
      */
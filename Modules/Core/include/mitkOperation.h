@@ -39,6 +39,11 @@ namespace mitk
 
     OperationType GetOperationType();
 
+    //##Documentation
+    //## @brief Returns the memory in bytes occupied by the data of the operation
+    //## (e.g. image content kept for undo). The default implementation returns 0.
+    virtual std::size_t GetMemorySize() const;
+
   protected:
     OperationType m_OperationType;
   };
@@ -74,6 +74,11 @@ namespace mitk
     virtual void ReverseOperations();
     virtual void ReverseAndExecute();
 
+    //##Documentation
+    //## @brief Returns the memory in bytes occupied by the data of the item.
+    //## The default implementation returns 0.
+    virtual std::size_t GetMemorySize() const;
+
     //##Documentation
     //## @brief Increases the current ObjectEventId
     //## For example if a button click generates operations the ObjectEventId has to be incremented to be able to undo
@@ -170,6 +175,9 @@ namespace mitk
     //## and false if it already has been deleted
     virtual bool IsValid();
 
+    //## @brief Returns the memory occupied by the operation and the undo operation
+    std::size_t GetMemorySize() const override;
+
   protected:
     void OnObjectDeleted();
 
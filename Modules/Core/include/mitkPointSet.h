@@ -18,8 +18,12 @@ found in the LICENSE file.
 #include <itkDefaultDynamicMeshTraits.h>
 #include <itkMesh.h>
 
+#include <memory>
+
 namespace mitk
 {
+  class PointSetSpatialIndex;
+
   /**
    * \brief Data structure which stores a set of points.
    *
@@ -45,6 +49,13 @@ namespace mitk
    *
    * The class internally uses an itk::Mesh for each time step.
    *
+   * For time steps with many points, SearchPoint() and SearchPointsInSlab() use
+   * a spatial index (a uniform grid), which is built on first use. Point operations
+   * of the PointSet keep it up to date incrementally; after any other modification
+   * of the points container (detected by its MTime) it is rebuilt on next use.
+   * Points that are modified in place through container iterators require a
+   * Modified() call on the container.
+   *
    * \section mitkPointSetDisplayOptions
    *
    * The default mappers for this data structure are mitk::PointSetGLMapper2D and
@@ -250,6 +261,21 @@ namespace mitk
      */
     int SearchPoint(Point3D point, ScalarType distance, int t = 0) const;
 
+    /**
+     * \brief searches all points p with minimum <= normal * p <= maximum
+     *
+     * \param normal is applied to the points as stored in the point set,
+     * i.e. in index coordinates (see Begin() and GetPointSet()).
+     * \param minimum
+     * \param maximum
+     * \param t
+     * returns the identifiers of the matching points in ascending order
+     */
+    std::vector<PointIdentifier> SearchPointsInSlab(const Vector3D &normal,
+                                                    ScalarType minimum,
+                                                    ScalarType maximum,
+                                                    int t = 0) const;
+
     bool IsEmptyTimeStep(unsigned int t) const override;
 
     // virtual methods, that need to be implemented
@@ -278,6 +304,16 @@ namespace mitk
     /** \brief swaps point coordinates and point data of the points with identifiers id1 and id2 */
     bool SwapPointContents(PointIdentifier id1, PointIdentifier id2, int t = 0);
 
+    /** \brief returns the spatial index of time step t (built if necessary), or nullptr for small point sets */
+    PointSetSpatialIndex *GetSpatialIndex(int t) const;
+
+    /** \brief returns the spatial index of time step t if it exists and is up to date, otherwise nullptr */
+    PointSetSpatialIndex *GetUpToDateSpatialIndex(int t) const;
+
+    /** \brief synchronizes the point with identifier id in the spatial index after a point operation.
+     * \param index the result of GetUpToDateSpatialIndex() before the operation*/
+    void UpdateSpatialIndex(PointSetSpatialIndex *index, PointIdentifier id, int t) const;
+
     typedef std::vector<DataType::Pointer> PointSetSeries;
 
     PointSetSeries m_PointSetSeries;
@@ -288,6 +324,11 @@ namespace mitk
     * @brief flag to indicate the right time to call SetBounds
     **/
     bool m_CalculateBoundingBox;
+
+    /**
+    * @brief spatial indices of the time steps, built on demand
+    **/
+    mutable std::vector<std::unique_ptr<PointSetSpatialIndex>> m_SpatialIndices;
   };
 
   /**
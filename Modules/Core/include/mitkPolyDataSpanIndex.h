@@ -0,0 +1,93 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPolyDataSpanIndex_h
+#define mitkPolyDataSpanIndex_h
+
+#include <mitkCommon.h>
+#include <MitkCoreExports.h>
+
+#include <itkObject.h>
+
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <array>
+#include <list>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Span-space index of the cells of a vtkPolyData for cutting it with planes.
+   *
+   * For a plane normal, every cell spans an interval of signed distances along the normal. The intervals
+   * are binned into buckets of equal width, so that the cells that can intersect a plane with this normal
+   * are found by looking at a single bucket instead of testing all cells. The index of a normal direction
+   * is built on first use; the indices of the most recently used directions (e.g. the three standard
+   * views) are kept until the input or its MTime changes. For axis-aligned normals the point coordinates
+   * are used directly.
+   *
+   * The index is used by SurfaceVtkMapper2D, whose render windows share it.
+   */
+  class MITKCORE_EXPORT PolyDataSpanIndex : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(PolyDataSpanIndex, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /** \brief Sets the indexed poly data. All indices are discarded if the input or its MTime changed. */
+    void SetInput(vtkPolyData* input);
+    vtkPolyData* GetInput() const;
+
+    /** \brief Returns a poly data that shares the points and point data of the input and contains all cells
+     * (with their cell data) whose extent along the normal contains the plane. Cutting it with the plane
+     * yields the same result as cutting the input.
+     * \throws mitk::Exception if no input is set.*/
+    vtkSmartPointer<vtkPolyData> ExtractCellsNearPlane(const double origin[3], const double normal[3]);
+
+    /** \brief Number of normal directions whose index is kept. Default is 4. */
+    itkSetMacro(MaximumNumberOfDirections, unsigned int);
+    itkGetConstMacro(MaximumNumberOfDirections, unsigned int);
+
+  protected:
+    PolyDataSpanIndex();
+    ~PolyDataSpanIndex() override;
+
+  private:
+    struct DirectionIndex
+    {
+      std::array<double, 3> Normal;
+      double Origin;
+      double BucketWidth;
+      std::vector<double> CellMinimum;
+      std::vector<double> CellMaximum;
+      /** Cells of bucket i are CellIds[BucketStart[i]] ... CellIds[BucketStart[i + 1] - 1]. */
+      std::vector<vtkIdType> BucketStart;
+      std::vector<vtkIdType> CellIds;
+      /** Cells spanning too many buckets; they are tested by every query. */
+      std::vector<vtkIdType> LargeCells;
+    };
+
+    const DirectionIndex& GetDirectionIndex(const std::array<double, 3>& normal);
+    DirectionIndex BuildDirectionIndex(const std::array<double, 3>& normal) const;
+
+    vtkSmartPointer<vtkPolyData> m_Input;
+    vtkMTimeType m_InputMTime;
+    unsigned int m_MaximumNumberOfDirections;
+
+    /** Most recently used first. */
+    std::list<DirectionIndex> m_DirectionIndices;
+  };
+}
+
+#endif
@@ -15,6 +15,9 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include <itkObject.h>
 
+#include <mutex>
+#include <thread>
+
 namespace mitk
 {
   class ProgressBarImplementation;
@@ -61,6 +64,22 @@ namespace mitk
     //## @brief Sets whether the current progress value is displayed.
     void SetPercentageVisible(bool visible);
 
+    //##Documentation
+    //## @brief Defers AddStepsToDo() and Progress() calls of other threads than the calling one.
+    //## The implementations usually drive GUI elements and must only be accessed by the calling thread.
+    //## It forwards the deferred calls with ForwardDeferredProgress(). Use it while code that reports
+    //## progress (e.g. file readers) is executed in worker threads. Nesting is not supported.
+    void DeferProgressOfOtherThreads();
+
+    //##Documentation
+    //## @brief Forwards the calls that were deferred since the last call to the implementations.
+    //## Has to be called by the thread that called DeferProgressOfOtherThreads().
+    void ForwardDeferredProgress();
+
+    //##Documentation
+    //## @brief Forwards the remaining deferred calls and stops deferring.
+    void StopDeferringProgressOfOtherThreads();
+
   protected:
     typedef std::vector<ProgressBarImplementation *> ProgressBarImplementationsList;
     typedef ProgressBarImplementationsList::iterator ProgressBarImplementationsListIterator;
@@ -71,6 +90,15 @@ namespace mitk
 
     ProgressBarImplementationsList m_Implementations;
 
+    /** Returns true if the call has to be deferred and accumulates its steps in this case.*/
+    bool DeferIfRequired(unsigned int &deferredSteps, unsigned int steps);
+
+    std::mutex m_DeferredProgressMutex;
+    bool m_IsDeferring = false;
+    std::thread::id m_ForwardingThread;
+    unsigned int m_DeferredStepsToDo = 0;
+    unsigned int m_DeferredProgress = 0;
+
     static ProgressBar *m_Instance;
   };
 
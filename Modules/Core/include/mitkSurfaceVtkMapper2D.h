@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include "mitkBaseRenderer.h"
 #include "mitkLocalStorageHandler.h"
+#include "mitkPolyDataSpanIndex.h"
 #include "mitkVtkMapper.h"
 #include <MitkCoreExports.h>
 
@@ -27,6 +28,7 @@ class vtkLookupTable;
 class vtkGlyph3D;
 class vtkArrowSource;
 class vtkReverseSense;
+class vtkTransformPolyDataFilter;
 
 namespace mitk
 {
@@ -36,9 +38,12 @@ namespace mitk
     * @brief Vtk-based mapper for cutting 2D slices out of Surfaces.
     *
     * The mapper uses a vtkCutter filter to cut out slices (contours) of the 3D
-    * volume and render these slices as vtkPolyData. The data is transformed
-    * according to its geometry before cutting, to support the geometry concept
-    * of MITK.
+    * volume and render these slices as vtkPolyData. The plane is transformed
+    * into the coordinates of the data, and only the resulting contour is
+    * transformed according to the geometry of the data, to support the geometry
+    * concept of MITK. Only the cells that may intersect the plane are passed to
+    * the cutter; they are found by a PolyDataSpanIndex that is shared by all
+    * render windows.
     *
     * Properties:
     * \b Surface.2D.Line Width: Thickness of the rendered lines in 2D.
@@ -109,6 +114,10 @@ namespace mitk
          * @brief m_CuttingPlane The plane where to cut off the 2D slice.
          */
       vtkSmartPointer<vtkPlane> m_CuttingPlane;
+      /**
+         * @brief m_CutTransformFilter Transforms the 2D slice according to the geometry of the data.
+         */
+      vtkSmartPointer<vtkTransformPolyDataFilter> m_CutTransformFilter;
 
       /**
        * @brief m_NormalMapper Mapper for the normals.
@@ -155,7 +164,8 @@ namespace mitk
      * The base class transforms the actor according to the respective
      * geometry which is correct for most cases. This mapper, however,
      * uses a vtkCutter to cut out a contour. To cut out the correct
-     * contour, the data has to be transformed beforehand. Else the
+     * contour, the plane has to be transformed into the coordinates of the
+     * data beforehand and the contour is transformed afterwards. Else the
      * current plane geometry will point the cutter to en empty location
      * (if the surface does have a geometry, which is a rather rare case).
      */
@@ -210,6 +220,11 @@ namespace mitk
        * @param renderer The respective renderer of the mitkRenderWindow.
        */
     void Update(BaseRenderer *renderer) override;
+
+    /**
+     * @brief m_SpanIndex Index of the cells of the surface, shared by all render windows.
+     */
+    PolyDataSpanIndex::Pointer m_SpanIndex;
   };
 } // namespace mitk
 #endif
@@ -71,6 +71,11 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     virtual void SetUndoLimit(std::size_t limit) = 0;
 
+    //##Documentation
+    //## @brief Returns the memory in bytes occupied by the data
+    //## of all items in the undo and the redo history.
+    virtual std::size_t GetMemorySize() const = 0;
+
     //##Documentation
     //## @brief returns the ObjectEventId of the
     //## top Element in the OperationHistory of the selected
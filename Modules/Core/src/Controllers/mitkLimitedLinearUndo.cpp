@@ -201,6 +201,19 @@ void mitk::LimitedLinearUndo::SetUndoLimit(std::size_t undoLimit)
   }
 }
 
+std::size_t mitk::LimitedLinearUndo::GetMemorySize() const
+{
+  std::size_t size = 0;
+
+  for (const auto* item : m_UndoList)
+    size += item->GetMemorySize();
+
+  for (const auto* item : m_RedoList)
+    size += item->GetMemorySize();
+
+  return size;
+}
+
 int mitk::LimitedLinearUndo::GetLastObjectEventIdInList()
 {
   return m_UndoList.back()->GetObjectEventId();
@@ -29,6 +29,9 @@ namespace mitk
    */
   void ProgressBar::Progress(unsigned int steps)
   {
+    if (this->DeferIfRequired(m_DeferredProgress, steps))
+      return;
+
     if (!m_Implementations.empty())
     {
       ProgressBarImplementationsListIterator iter;
@@ -67,6 +70,9 @@ namespace mitk
    */
   void ProgressBar::AddStepsToDo(unsigned int steps)
   {
+    if (this->DeferIfRequired(m_DeferredStepsToDo, steps))
+      return;
+
     if (!m_Implementations.empty())
     {
       ProgressBarImplementationsListIterator iter;
@@ -100,6 +106,53 @@ namespace mitk
     }
   }
 
+  void ProgressBar::DeferProgressOfOtherThreads()
+  {
+    std::lock_guard<std::mutex> lock(m_DeferredProgressMutex);
+    m_IsDeferring = true;
+    m_ForwardingThread = std::this_thread::get_id();
+  }
+
+  void ProgressBar::ForwardDeferredProgress()
+  {
+    unsigned int stepsToDo = 0;
+    unsigned int progress = 0;
+
+    {
+      std::lock_guard<std::mutex> lock(m_DeferredProgressMutex);
+      std::swap(stepsToDo, m_DeferredStepsToDo);
+      std::swap(progress, m_DeferredProgress);
+    }
+
+    // steps to do first, otherwise the progress could complete (and reset) the progress bar
+    if (0 != stepsToDo)
+      this->AddStepsToDo(stepsToDo);
+
+    if (0 != progress)
+      this->Progress(progress);
+  }
+
+  void ProgressBar::StopDeferringProgressOfOtherThreads()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_DeferredProgressMutex);
+      m_IsDeferring = false;
+    }
+
+    this->ForwardDeferredProgress();
+  }
+
+  bool ProgressBar::DeferIfRequired(unsigned int &deferredSteps, unsigned int steps)
+  {
+    std::lock_guard<std::mutex> lock(m_DeferredProgressMutex);
+
+    if (!m_IsDeferring || std::this_thread::get_id() == m_ForwardingThread)
+      return false;
+
+    deferredSteps += steps;
+    return true;
+  }
+
   /**
    * Get the instance of this ProgressBar
    */
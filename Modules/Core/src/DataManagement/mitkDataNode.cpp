@@ -48,11 +48,146 @@ mitk::Mapper *mitk::DataNode::GetMapper(MapperSlotId id) const
 
 mitk::BaseData *mitk::DataNode::GetData() const
 {
+  {
+    std::lock_guard<std::mutex> lock(m_DataProviderMutex);
+
+    if (m_Data.IsNotNull() || !m_DataProvider)
+      return m_Data;
+  }
+
+  const_cast<DataNode *>(this)->LoadDataFromProvider();
+
+  std::lock_guard<std::mutex> lock(m_DataProviderMutex);
   return m_Data;
 }
 
+mitk::BaseData::Pointer mitk::DataNode::GetLoadedData() const
+{
+  std::lock_guard<std::mutex> lock(m_DataProviderMutex);
+  return m_Data;
+}
+
+void mitk::DataNode::SetDataProvider(const DataProviderFunction &provider)
+{
+  std::lock_guard<std::mutex> lock(m_DataProviderMutex);
+  m_DataProvider = provider;
+}
+
+bool mitk::DataNode::HasDataProvider() const
+{
+  std::lock_guard<std::mutex> lock(m_DataProviderMutex);
+  return static_cast<bool>(m_DataProvider);
+}
+
+bool mitk::DataNode::IsDataLoaded() const
+{
+  std::lock_guard<std::mutex> lock(m_DataProviderMutex);
+  return m_Data.IsNotNull();
+}
+
+void mitk::DataNode::ReleaseData()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_DataProviderMutex);
+
+    if (!m_DataProvider || m_Data.IsNull())
+      return;
+
+    m_Mappers.clear();
+    m_Mappers.resize(10);
+    m_Data = nullptr;
+  }
+
+  m_DataReferenceChangedTime.Modified();
+  Modified();
+}
+
+void mitk::DataNode::LoadDataFromProvider()
+{
+  DataProviderFunction provider;
+
+  {
+    std::unique_lock<std::mutex> lock(m_DataProviderMutex);
+
+    if (m_IsLoadingData && m_LoadingThread == std::this_thread::get_id())
+    {
+      // The provider accessed the data of its own node. Waiting would never end.
+      MITK_ERROR << "Data provider of node \"" << this->GetName() << "\" accessed the data it is creating.";
+      return;
+    }
+
+    // Only one thread runs the provider, all others wait for its result
+    m_DataProviderCondition.wait(lock, [this] { return !m_IsLoadingData; });
+
+    if (m_Data.IsNotNull() || !m_DataProvider)
+      return;
+
+    m_IsLoadingData = true;
+    m_LoadingThread = std::this_thread::get_id();
+    provider = m_DataProvider;
+  }
+
+  // The provider is called without holding the lock, as it may access other nodes or invoke
+  // events (e.g. release the data of other nodes to meet a memory budget).
+  BaseData::Pointer data;
+
+  try
+  {
+    data = provider();
+  }
+  catch (...)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_DataProviderMutex);
+      m_IsLoadingData = false;
+    }
+
+    m_DataProviderCondition.notify_all();
+    throw;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_DataProviderMutex);
+    m_IsLoadingData = false;
+
+    // SetData() may have discarded the provider in the meantime
+    if (m_DataProvider && data.IsNull())
+    {
+      // Do not try again on every access
+      MITK_ERROR << "Data provider of node \"" << this->GetName() << "\" did not return any data.";
+      m_DataProvider = nullptr;
+    }
+    else if (m_DataProvider && m_Data.IsNull())
+    {
+      m_Mappers.clear();
+      m_Mappers.resize(10);
+      m_Data = data;
+    }
+    else
+    {
+      data = nullptr;
+    }
+  }
+
+  m_DataProviderCondition.notify_all();
+
+  if (data.IsNull())
+    return;
+
+  // Existing properties are kept, only missing ones are added
+  mitk::CoreObjectFactory::GetInstance()->SetDefaultProperties(this);
+
+  m_DataReferenceChangedTime.Modified();
+  Modified();
+}
+
 void mitk::DataNode::SetData(mitk::BaseData *baseData)
 {
+  {
+    std::lock_guard<std::mutex> lock(m_DataProviderMutex);
+    m_DataProvider = nullptr;
+  }
+
   if (m_Data != baseData)
   {
     m_Mappers.clear();
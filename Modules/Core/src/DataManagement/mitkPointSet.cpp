@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkPointSet.h"
 #include "mitkInteractionConst.h"
 #include "mitkPointOperation.h"
+#include "mitkPointSetSpatialIndex.h"
 
 #include <iomanip>
 #include <mitkNumericTypes.h>
@@ -27,6 +28,12 @@ namespace mitk
   itkEventMacroDefinition(PointSetExtendTimeRangeEvent, PointSetEvent);
 }
 
+namespace
+{
+  /** Time steps with fewer points are searched linearly. */
+  constexpr int MinimumNumberOfIndexedPoints = 64;
+}
+
 mitk::PointSet::PointSet() : m_CalculateBoundingBox(true)
 {
   this->InitializeEmpty();
@@ -61,6 +68,7 @@ mitk::PointSet::~PointSet()
 void mitk::PointSet::ClearData()
 {
   m_PointSetSeries.clear();
+  m_SpatialIndices.clear();
   Superclass::ClearData();
 }
 
@@ -218,6 +226,12 @@ int mitk::PointSet::SearchPoint(Point3D point, ScalarType distance, int t) const
     distance = 0.000001;
   }
 
+  if (auto index = this->GetSpatialIndex(t))
+  {
+    PointIdentifier id;
+    return index->SearchNearestPoint(indexPoint, distance, id) ? static_cast<int>(id) : -1;
+  }
+
   ScalarType bestDist = distance;
   ScalarType dist, tmp;
 
@@ -251,6 +265,77 @@ int mitk::PointSet::SearchPoint(Point3D point, ScalarType distance, int t) const
   return bestIndex;
 }
 
+std::vector<mitk::PointSet::PointIdentifier> mitk::PointSet::SearchPointsInSlab(const Vector3D &normal,
+                                                                                ScalarType minimum,
+                                                                                ScalarType maximum,
+                                                                                int t) const
+{
+  std::vector<PointIdentifier> result;
+
+  if (t < 0 || t >= (int)m_PointSetSeries.size())
+  {
+    return result;
+  }
+
+  if (auto index = this->GetSpatialIndex(t))
+  {
+    return index->SearchPointsInSlab(normal, minimum, maximum);
+  }
+
+  const PointsContainer *points = m_PointSetSeries[t]->GetPoints();
+  for (PointsContainer::ConstIterator it = points->Begin(); it != points->End(); ++it)
+  {
+    const PointType &point = it->Value();
+    ScalarType value = normal[0] * point[0] + normal[1] * point[1] + normal[2] * point[2];
+
+    if (minimum <= value && value <= maximum)
+    {
+      result.push_back(it->Index());
+    }
+  }
+  return result;
+}
+
+mitk::PointSetSpatialIndex *mitk::PointSet::GetSpatialIndex(int t) const
+{
+  if (t < 0 || t >= (int)m_PointSetSeries.size() || this->GetSize(t) < MinimumNumberOfIndexedPoints)
+  {
+    return nullptr;
+  }
+
+  if (m_SpatialIndices.size() < m_PointSetSeries.size())
+  {
+    m_SpatialIndices.resize(m_PointSetSeries.size());
+  }
+
+  const PointsContainer *points = m_PointSetSeries[t]->GetPoints();
+  auto &index = m_SpatialIndices[t];
+
+  if (!index || !index->IsUpToDate(points))
+  {
+    index = std::make_unique<PointSetSpatialIndex>(points);
+  }
+  return index.get();
+}
+
+mitk::PointSetSpatialIndex *mitk::PointSet::GetUpToDateSpatialIndex(int t) const
+{
+  if (t < 0 || t >= (int)m_SpatialIndices.size() || !m_SpatialIndices[t] ||
+      !m_SpatialIndices[t]->IsUpToDate(m_PointSetSeries[t]->GetPoints()))
+  {
+    return nullptr;
+  }
+  return m_SpatialIndices[t].get();
+}
+
+void mitk::PointSet::UpdateSpatialIndex(PointSetSpatialIndex *index, PointIdentifier id, int t) const
+{
+  if (index != nullptr)
+  {
+    index->UpdatePoint(m_PointSetSeries[t]->GetPoints(), id);
+  }
+}
+
 mitk::PointSet::PointType mitk::PointSet::GetPoint(PointIdentifier id, int t) const
 {
   PointType out;
@@ -298,7 +383,9 @@ void mitk::PointSet::SetPoint(PointIdentifier id, PointType point, int t)
 
   mitk::Point3D indexPoint;
   this->GetGeometry(t)->WorldToIndex(point, indexPoint);
+  PointSetSpatialIndex *index = this->GetUpToDateSpatialIndex(t);
   m_PointSetSeries[t]->SetPoint(id, indexPoint);
+  this->UpdateSpatialIndex(index, id, t);
   PointDataType defaultPointData;
   defaultPointData.id = id;
   defaultPointData.selected = false;
@@ -317,7 +404,9 @@ void mitk::PointSet::SetPoint(PointIdentifier id, PointType point, PointSpecific
 
   mitk::Point3D indexPoint;
   this->GetGeometry(t)->WorldToIndex(point, indexPoint);
+  PointSetSpatialIndex *index = this->GetUpToDateSpatialIndex(t);
   m_PointSetSeries[t]->SetPoint(id, indexPoint);
+  this->UpdateSpatialIndex(index, id, t);
   PointDataType defaultPointData;
   defaultPointData.id = id;
   defaultPointData.selected = false;
@@ -345,7 +434,9 @@ void mitk::PointSet::InsertPoint(PointIdentifier id, PointType point, PointSpeci
       return;
     }
     tempGeometry->WorldToIndex(point, indexPoint);
+    PointSetSpatialIndex *index = this->GetUpToDateSpatialIndex(t);
     m_PointSetSeries[t]->GetPoints()->InsertElement(id, indexPoint);
+    this->UpdateSpatialIndex(index, id, t);
     PointDataType defaultPointData;
     defaultPointData.id = id;
     defaultPointData.selected = false;
@@ -373,7 +464,9 @@ mitk::PointSet::PointIdentifier mitk::PointSet::InsertPoint(PointType point, int
 
   mitk::Point3D indexPoint;
   this->GetGeometry(t)->WorldToIndex(point, indexPoint);
+  PointSetSpatialIndex *index = this->GetUpToDateSpatialIndex(t);
   m_PointSetSeries[t]->SetPoint(id, indexPoint);
+  this->UpdateSpatialIndex(index, id, t);
   PointDataType defaultPointData;
   defaultPointData.id = id;
   defaultPointData.selected = false;
@@ -399,7 +492,9 @@ bool mitk::PointSet::RemovePointIfExists(PointIdentifier id, int t)
     bool exists = points->IndexExists(id);
     if (exists)
     {
+      PointSetSpatialIndex *index = this->GetUpToDateSpatialIndex(t);
       points->DeleteIndex(id);
+      this->UpdateSpatialIndex(index, id, t);
       pdata->DeleteIndex(id);
       return true;
     }
@@ -422,7 +517,9 @@ mitk::PointSet::PointsIterator mitk::PointSet::RemovePointAtEnd(int t)
     if (eit != bit)
     {
       PointsContainer::ElementIdentifier id = (--eit).Index();
+      PointSetSpatialIndex *index = this->GetUpToDateSpatialIndex(t);
       points->DeleteIndex(id);
+      this->UpdateSpatialIndex(index, id, t);
       pdata->DeleteIndex(id);
       PointsIterator eit2 = points->End();
       return points->empty()? eit2 : --eit2;
@@ -608,7 +705,9 @@ void mitk::PointSet::ExecuteOperation(Operation *operation)
       }
       geometry->WorldToIndex(pt, pt);
 
+      PointSetSpatialIndex *index = this->GetUpToDateSpatialIndex(timeStep);
       m_PointSetSeries[timeStep]->GetPoints()->InsertElement(position, pt);
+      this->UpdateSpatialIndex(index, position, timeStep);
 
       PointDataType pointData = {
         static_cast<unsigned int>(pointOp->GetIndex()), pointOp->GetSelected(), pointOp->GetPointType()};
@@ -634,7 +733,9 @@ void mitk::PointSet::ExecuteOperation(Operation *operation)
       this->GetGeometry(timeStep)->WorldToIndex(pt, pt);
 
       // Copy new point into container
+      PointSetSpatialIndex *index = this->GetUpToDateSpatialIndex(timeStep);
       m_PointSetSeries[timeStep]->SetPoint(pointOp->GetIndex(), pt);
+      this->UpdateSpatialIndex(index, pointOp->GetIndex(), timeStep);
 
       // Insert a default point data object to keep the containers in sync
       // (if no point data object exists yet)
@@ -657,7 +758,9 @@ void mitk::PointSet::ExecuteOperation(Operation *operation)
 
     case OpREMOVE: // removes the point at given by position
     {
+      PointSetSpatialIndex *index = this->GetUpToDateSpatialIndex(timeStep);
       m_PointSetSeries[timeStep]->GetPoints()->DeleteIndex((unsigned)pointOp->GetIndex());
+      this->UpdateSpatialIndex(index, pointOp->GetIndex(), timeStep);
       m_PointSetSeries[timeStep]->GetPointData()->DeleteIndex((unsigned)pointOp->GetIndex());
 
       this->OnPointSetChange();
@@ -877,9 +980,12 @@ bool mitk::PointSet::SwapPointContents(PointIdentifier id1, PointIdentifier id2,
   if (m_PointSetSeries[timeStep]->GetPointData(id2, &data2) == false)
     return false;
   /* now swap contents */
+  PointSetSpatialIndex *index = this->GetUpToDateSpatialIndex(timeStep);
   m_PointSetSeries[timeStep]->SetPoint(id1, p2);
+  this->UpdateSpatialIndex(index, id1, timeStep);
   m_PointSetSeries[timeStep]->SetPointData(id1, data2);
   m_PointSetSeries[timeStep]->SetPoint(id2, p1);
+  this->UpdateSpatialIndex(index, id2, timeStep);
   m_PointSetSeries[timeStep]->SetPointData(id2, data1);
   return true;
 }
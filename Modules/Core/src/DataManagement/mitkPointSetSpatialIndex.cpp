@@ -0,0 +1,364 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPointSetSpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  /** Cell indices are stored with 21 bits per axis. */
+  constexpr int CellIndexBits = 21;
+  constexpr std::int64_t CellIndexOffset = std::int64_t(1) << (CellIndexBits - 1);
+  constexpr std::int64_t MinimumCellIndex = -CellIndexOffset;
+  constexpr std::int64_t MaximumCellIndex = CellIndexOffset - 1;
+  constexpr std::uint64_t CellIndexMask = (std::uint64_t(1) << CellIndexBits) - 1;
+
+  /** Average number of points per cell of a new grid. */
+  constexpr double PointsPerCell = 4.0;
+
+  mitk::ScalarType Dot(const mitk::Vector3D &normal, const mitk::Point3D &point)
+  {
+    return normal[0] * point[0] + normal[1] * point[1] + normal[2] * point[2];
+  }
+}
+
+mitk::PointSetSpatialIndex::PointSetSpatialIndex(const PointsContainer *points)
+{
+  this->Build(points);
+}
+
+bool mitk::PointSetSpatialIndex::IsUpToDate(const PointsContainer *points) const
+{
+  return points == m_Points && points->GetMTime() == m_PointsMTime;
+}
+
+void mitk::PointSetSpatialIndex::Build(const PointsContainer *points)
+{
+  m_Points = points;
+  m_PointsMTime = points->GetMTime();
+  m_Cells.clear();
+  m_CellKeys.clear();
+  m_MinimumCellIndex.fill(MaximumCellIndex);
+  m_MaximumCellIndex.fill(MinimumCellIndex);
+
+  Point3D minimum, maximum;
+  minimum.Fill(std::numeric_limits<ScalarType>::max());
+  maximum.Fill(std::numeric_limits<ScalarType>::lowest());
+  std::size_t numberOfPoints = 0;
+
+  for (auto it = points->Begin(); it != points->End(); ++it)
+  {
+    const auto &point = it->Value();
+
+    if (!std::isfinite(point[0]) || !std::isfinite(point[1]) || !std::isfinite(point[2]))
+      continue;
+
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      minimum[d] = std::min(minimum[d], point[d]);
+      maximum[d] = std::max(maximum[d], point[d]);
+    }
+
+    ++numberOfPoints;
+  }
+
+  m_Origin.Fill(0.0);
+  m_CellSize = 1.0;
+
+  if (0 == numberOfPoints)
+    return;
+
+  // Choose the cell size from the volume (or area, or length) covered by the points
+  double volume = 1.0;
+  double largestExtent = 0.0;
+  int numberOfDimensions = 0;
+
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    const double extent = maximum[d] - minimum[d];
+
+    if (extent > 0.0)
+    {
+      volume *= extent;
+      largestExtent = std::max(largestExtent, extent);
+      ++numberOfDimensions;
+    }
+  }
+
+  if (numberOfDimensions > 0)
+  {
+    m_CellSize = std::pow(volume * PointsPerCell / numberOfPoints, 1.0 / numberOfDimensions);
+    m_CellSize = std::max(m_CellSize, largestExtent / (CellIndexOffset / 2));
+  }
+
+  if (!(m_CellSize > 0.0) || !std::isfinite(m_CellSize))
+    m_CellSize = 1.0;
+
+  m_Origin = minimum;
+
+  for (auto it = points->Begin(); it != points->End(); ++it)
+    this->Insert(it->Index(), it->Value());
+}
+
+void mitk::PointSetSpatialIndex::UpdatePoint(const PointsContainer *points, PointIdentifier id)
+{
+  this->Remove(id);
+
+  Point3D point;
+
+  if (points->GetElementIfIndexExists(id, &point) && !this->Insert(id, point))
+  {
+    // The point left the range of the grid
+    this->Build(points);
+    return;
+  }
+
+  m_Points = points;
+  m_PointsMTime = points->GetMTime();
+}
+
+bool mitk::PointSetSpatialIndex::Insert(PointIdentifier id, const Point3D &point)
+{
+  const auto cellIndex = this->GetCellIndex(point);
+
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    if (cellIndex[d] < MinimumCellIndex || cellIndex[d] > MaximumCellIndex)
+      return false;
+  }
+
+  const auto cellKey = GetCellKey(cellIndex);
+  m_Cells[cellKey].push_back({id, point});
+  m_CellKeys[id] = cellKey;
+
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    m_MinimumCellIndex[d] = std::min(m_MinimumCellIndex[d], cellIndex[d]);
+    m_MaximumCellIndex[d] = std::max(m_MaximumCellIndex[d], cellIndex[d]);
+  }
+
+  return true;
+}
+
+void mitk::PointSetSpatialIndex::Remove(PointIdentifier id)
+{
+  auto cellKey = m_CellKeys.find(id);
+
+  if (cellKey == m_CellKeys.end())
+    return;
+
+  auto cell = m_Cells.find(cellKey->second);
+  auto &entries = cell->second;
+  auto entry = std::find_if(entries.begin(), entries.end(), [id](const Entry &candidate) { return candidate.Id == id; });
+
+  *entry = entries.back();
+  entries.pop_back();
+
+  if (entries.empty())
+    m_Cells.erase(cell);
+
+  m_CellKeys.erase(cellKey);
+}
+
+bool mitk::PointSetSpatialIndex::SearchNearestPoint(const Point3D &point,
+                                                    ScalarType maximumSquaredDistance,
+                                                    PointIdentifier &id) const
+{
+  if (m_Cells.empty())
+    return false;
+
+  bool found = false;
+  ScalarType bestSquaredDistance = maximumSquaredDistance;
+
+  auto testCell = [&](const std::vector<Entry> &entries) {
+    for (const auto &entry : entries)
+    {
+      const auto squaredDistance = point.SquaredEuclideanDistanceTo(entry.Point);
+
+      if (squaredDistance < bestSquaredDistance || (found && squaredDistance == bestSquaredDistance && entry.Id < id))
+      {
+        bestSquaredDistance = squaredDistance;
+        id = entry.Id;
+        found = true;
+      }
+    }
+  };
+
+  const auto radius = std::sqrt(maximumSquaredDistance);
+  CellIndex first, last;
+  double numberOfCellsInRange = 1.0;
+
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    first[d] = std::max(this->GetCellIndex(point[d] - radius, d), m_MinimumCellIndex[d]);
+    last[d] = std::min(this->GetCellIndex(point[d] + radius, d), m_MaximumCellIndex[d]);
+
+    if (first[d] > last[d])
+      return false;
+
+    numberOfCellsInRange *= static_cast<double>(last[d] - first[d] + 1);
+  }
+
+  if (numberOfCellsInRange > static_cast<double>(m_Cells.size()))
+  {
+    for (const auto &cell : m_Cells)
+      testCell(cell.second);
+
+    return found;
+  }
+
+  CellIndex cellIndex;
+
+  for (cellIndex[0] = first[0]; cellIndex[0] <= last[0]; ++cellIndex[0])
+  {
+    for (cellIndex[1] = first[1]; cellIndex[1] <= last[1]; ++cellIndex[1])
+    {
+      for (cellIndex[2] = first[2]; cellIndex[2] <= last[2]; ++cellIndex[2])
+      {
+        auto cell = m_Cells.find(GetCellKey(cellIndex));
+
+        if (cell != m_Cells.end())
+          testCell(cell->second);
+      }
+    }
+  }
+
+  return found;
+}
+
+std::vector<mitk::PointSetSpatialIndex::PointIdentifier> mitk::PointSetSpatialIndex::SearchPointsInSlab(
+  const Vector3D &normal, ScalarType minimum, ScalarType maximum) const
+{
+  std::vector<PointIdentifier> result;
+
+  if (m_Cells.empty() || !(minimum <= maximum))
+    return result;
+
+  auto testCell = [&](const std::vector<Entry> &entries) {
+    for (const auto &entry : entries)
+    {
+      const auto value = Dot(normal, entry.Point);
+
+      if (minimum <= value && value <= maximum)
+        result.push_back(entry.Id);
+    }
+  };
+
+  // The cells are visited in columns along the axis the normal is most aligned with
+  unsigned int k = 0;
+
+  for (unsigned int d = 1; d < 3; ++d)
+  {
+    if (std::abs(normal[d]) > std::abs(normal[k]))
+      k = d;
+  }
+
+  const unsigned int i = (k + 1) % 3;
+  const unsigned int j = (k + 2) % 3;
+
+  const double numberOfColumns = static_cast<double>(m_MaximumCellIndex[i] - m_MinimumCellIndex[i] + 1) *
+                                 static_cast<double>(m_MaximumCellIndex[j] - m_MinimumCellIndex[j] + 1);
+
+  if (0.0 == normal[k] || numberOfColumns > static_cast<double>(m_Cells.size()))
+  {
+    // Sparse grid, test the occupied cells by their bounding boxes
+    const auto halfExtent = 0.5 * m_CellSize * (std::abs(normal[0]) + std::abs(normal[1]) + std::abs(normal[2]));
+
+    for (const auto &cell : m_Cells)
+    {
+      const auto cellIndex = GetCellIndexFromKey(cell.first);
+      Point3D center;
+
+      for (unsigned int d = 0; d < 3; ++d)
+        center[d] = m_Origin[d] + (cellIndex[d] + 0.5) * m_CellSize;
+
+      const auto value = Dot(normal, center);
+
+      if (value + halfExtent >= minimum && value - halfExtent <= maximum)
+        testCell(cell.second);
+    }
+  }
+  else
+  {
+    CellIndex cellIndex;
+
+    for (cellIndex[i] = m_MinimumCellIndex[i]; cellIndex[i] <= m_MaximumCellIndex[i]; ++cellIndex[i])
+    {
+      const ScalarType xi[2] = {m_Origin[i] + cellIndex[i] * m_CellSize, m_Origin[i] + (cellIndex[i] + 1) * m_CellSize};
+
+      for (cellIndex[j] = m_MinimumCellIndex[j]; cellIndex[j] <= m_MaximumCellIndex[j]; ++cellIndex[j])
+      {
+        const ScalarType xj[2] = {m_Origin[j] + cellIndex[j] * m_CellSize, m_Origin[j] + (cellIndex[j] + 1) * m_CellSize};
+
+        // Range of normal[i] * x[i] + normal[j] * x[j] within the column
+        const auto lower = std::min(normal[i] * xi[0], normal[i] * xi[1]) + std::min(normal[j] * xj[0], normal[j] * xj[1]);
+        const auto upper = std::max(normal[i] * xi[0], normal[i] * xi[1]) + std::max(normal[j] * xj[0], normal[j] * xj[1]);
+
+        auto xkFirst = (minimum - upper) / normal[k];
+        auto xkLast = (maximum - lower) / normal[k];
+
+        if (normal[k] < 0.0)
+          std::swap(xkFirst, xkLast);
+
+        const auto first = std::max(this->GetCellIndex(xkFirst, k), m_MinimumCellIndex[k]);
+        const auto last = std::min(this->GetCellIndex(xkLast, k), m_MaximumCellIndex[k]);
+
+        for (cellIndex[k] = first; cellIndex[k] <= last; ++cellIndex[k])
+        {
+          auto cell = m_Cells.find(GetCellKey(cellIndex));
+
+          if (cell != m_Cells.end())
+            testCell(cell->second);
+        }
+      }
+    }
+  }
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+mitk::PointSetSpatialIndex::CellIndex mitk::PointSetSpatialIndex::GetCellIndex(const Point3D &point) const
+{
+  return {this->GetCellIndex(point[0], 0), this->GetCellIndex(point[1], 1), this->GetCellIndex(point[2], 2)};
+}
+
+std::int64_t mitk::PointSetSpatialIndex::GetCellIndex(ScalarType coordinate, unsigned int axis) const
+{
+  const auto cellIndex = std::floor((coordinate - m_Origin[axis]) / m_CellSize);
+
+  // Out of range (or not a number), but still representable
+  if (!(cellIndex >= static_cast<double>(MinimumCellIndex)))
+    return cellIndex > 0.0 ? MaximumCellIndex + 1 : MinimumCellIndex - 1;
+
+  if (cellIndex > static_cast<double>(MaximumCellIndex))
+    return MaximumCellIndex + 1;
+
+  return static_cast<std::int64_t>(cellIndex);
+}
+
+mitk::PointSetSpatialIndex::CellKey mitk::PointSetSpatialIndex::GetCellKey(const CellIndex &cellIndex)
+{
+  return (static_cast<CellKey>(cellIndex[0] + CellIndexOffset) << (2 * CellIndexBits)) |
+         (static_cast<CellKey>(cellIndex[1] + CellIndexOffset) << CellIndexBits) |
+         static_cast<CellKey>(cellIndex[2] + CellIndexOffset);
+}
+
+mitk::PointSetSpatialIndex::CellIndex mitk::PointSetSpatialIndex::GetCellIndexFromKey(CellKey cellKey)
+{
+  return {static_cast<std::int64_t>((cellKey >> (2 * CellIndexBits)) & CellIndexMask) - CellIndexOffset,
+          static_cast<std::int64_t>((cellKey >> CellIndexBits) & CellIndexMask) - CellIndexOffset,
+          static_cast<std::int64_t>(cellKey & CellIndexMask) - CellIndexOffset};
+}
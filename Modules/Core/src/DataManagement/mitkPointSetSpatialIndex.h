@@ -0,0 +1,91 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPointSetSpatialIndex_h
+#define mitkPointSetSpatialIndex_h
+
+#include <mitkPointSet.h>
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * @internal
+   * @brief Uniform grid over the points of a single time step of a mitk::PointSet.
+   *
+   * The grid works on the coordinates as stored in the points container (index coordinates of the point set).
+   * The cell size is chosen on construction, so that a cell contains a few points on average. Single points
+   * can be inserted, moved and removed afterwards; the grid is rebuilt if a point leaves its range.
+   *
+   * The index is up to date as long as the points container is the same object and its MTime did not change
+   * since the last construction or UpdatePoint() call.
+   */
+  class PointSetSpatialIndex
+  {
+  public:
+    using PointIdentifier = PointSet::PointIdentifier;
+    using PointsContainer = PointSet::PointsContainer;
+
+    explicit PointSetSpatialIndex(const PointsContainer *points);
+
+    bool IsUpToDate(const PointsContainer *points) const;
+
+    /** \brief Synchronizes the point with the given identifier with the container after it was inserted, moved
+     * or removed. The index must have been up to date before this single modification.*/
+    void UpdatePoint(const PointsContainer *points, PointIdentifier id);
+
+    /** \brief Finds the point with the smallest squared distance below maximumSquaredDistance. Among points of
+     * equal distance the one with the smallest identifier is returned.*/
+    bool SearchNearestPoint(const Point3D &point, ScalarType maximumSquaredDistance, PointIdentifier &id) const;
+
+    /** \brief Returns the identifiers of all points p with minimum <= normal * p <= maximum in ascending order. */
+    std::vector<PointIdentifier> SearchPointsInSlab(const Vector3D &normal,
+                                                    ScalarType minimum,
+                                                    ScalarType maximum) const;
+
+  private:
+    using CellIndex = std::array<std::int64_t, 3>;
+    using CellKey = std::uint64_t;
+
+    struct Entry
+    {
+      PointIdentifier Id;
+      Point3D Point;
+    };
+
+    void Build(const PointsContainer *points);
+    bool Insert(PointIdentifier id, const Point3D &point);
+    void Remove(PointIdentifier id);
+
+    CellIndex GetCellIndex(const Point3D &point) const;
+    std::int64_t GetCellIndex(ScalarType coordinate, unsigned int axis) const;
+    static CellKey GetCellKey(const CellIndex &cellIndex);
+    static CellIndex GetCellIndexFromKey(CellKey cellKey);
+
+    const PointsContainer *m_Points;
+    itk::ModifiedTimeType m_PointsMTime;
+
+    Point3D m_Origin;
+    ScalarType m_CellSize;
+    CellIndex m_MinimumCellIndex;
+    CellIndex m_MaximumCellIndex;
+
+    std::unordered_map<CellKey, std::vector<Entry>> m_Cells;
+    std::unordered_map<PointIdentifier, CellKey> m_CellKeys;
+  };
+}
+
+#endif
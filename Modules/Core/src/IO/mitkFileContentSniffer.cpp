@@ -0,0 +1,278 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkFileContentSniffer.h"
+
+#include <mitkUtf8Util.h>
+
+#include <itkGDCMImageIO.h>
+#include <itkMetaDataObject.h>
+
+#include <itksys/Directory.hxx>
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+#include <list>
+#include <unordered_map>
+
+namespace
+{
+  struct CacheEntry
+  {
+    std::shared_ptr<const mitk::FileContentSniffer::Content> Content;
+    long ModifiedTime;
+    unsigned long Size;
+    std::list<std::string>::iterator Position;
+  };
+
+  struct Cache
+  {
+    std::mutex Mutex;
+    std::unordered_map<std::string, CacheEntry> Entries;
+    std::list<std::string> LeastRecentlyUsed; // front is the least recently used path
+    std::size_t MaximumSize = 1024;
+    std::size_t NumberOfSniffedPaths = 0;
+
+    void Shrink(std::size_t size)
+    {
+      while (Entries.size() > size)
+      {
+        Entries.erase(LeastRecentlyUsed.front());
+        LeastRecentlyUsed.pop_front();
+      }
+    }
+  };
+
+  Cache &GetCache()
+  {
+    static Cache cache;
+    return cache;
+  }
+
+  bool ReadDicomImageInformation(itk::GDCMImageIO *gdcmIO, const std::string &path)
+  {
+    gdcmIO->SetFileName(path);
+
+    try
+    {
+      gdcmIO->ReadImageInformation();
+    }
+    catch (const itk::ExceptionObject & /*err*/)
+    {
+      return false;
+    }
+
+    return true;
+  }
+}
+
+const std::size_t mitk::FileContentSniffer::PREFIX_SIZE = 132;
+
+mitk::FileContentSniffer::Content::Content(const std::string &path)
+  : m_Path(path),
+    m_Exists(itksys::SystemTools::FileExists(path.c_str())),
+    m_IsDirectory(itksys::SystemTools::FileIsDirectory(Utf8Util::Local8BitToUtf8(path))),
+    m_IsDicom(false),
+    m_CanReadDicomImage(false)
+{
+  if (m_Exists && !m_IsDirectory)
+  {
+    std::ifstream file(path, std::ifstream::binary);
+
+    if (file.is_open())
+    {
+      m_Prefix.resize(PREFIX_SIZE);
+      file.read(&m_Prefix[0], PREFIX_SIZE);
+      m_Prefix.resize(static_cast<std::size_t>(file.gcount()));
+    }
+  }
+}
+
+bool mitk::FileContentSniffer::Content::HasDicomPreamble() const
+{
+  return m_Prefix.size() >= PREFIX_SIZE && 0 == m_Prefix.compare(128, 4, "DICM");
+}
+
+void mitk::FileContentSniffer::Content::ParseDicomHeader() const
+{
+  if (!m_Exists)
+    return;
+
+  auto gdcmIO = itk::GDCMImageIO::New();
+
+  if (m_IsDirectory)
+  {
+    // use the first file within the directory that is DICOM
+    itksys::Directory input;
+    input.Load(m_Path.c_str());
+
+    for (unsigned long idx = 0; idx < input.GetNumberOfFiles(); ++idx)
+    {
+      auto filename = Utf8Util::Local8BitToUtf8(input.GetFile(idx));
+      std::string fullpath = m_Path + "/" + filename;
+
+      if (!itksys::SystemTools::FileIsDirectory(fullpath) && ReadDicomImageInformation(gdcmIO, fullpath))
+      {
+        m_DicomFilePath = fullpath;
+        break;
+      }
+    }
+  }
+  else if (ReadDicomImageInformation(gdcmIO, m_Path))
+  {
+    m_DicomFilePath = m_Path;
+  }
+
+  if (m_DicomFilePath.empty())
+    return;
+
+  m_IsDicom = true;
+
+  const auto &dict = gdcmIO->GetMetaDataDictionary();
+  for (auto iter = dict.Begin(); iter != dict.End(); ++iter)
+  {
+    std::string value;
+    if (itk::ExposeMetaData<std::string>(dict, iter->first, value))
+      m_DicomTags[iter->first] = value;
+  }
+
+  m_CanReadDicomImage = gdcmIO->CanReadFile(m_DicomFilePath.c_str());
+}
+
+bool mitk::FileContentSniffer::Content::IsDicom() const
+{
+  std::call_once(m_DicomFlag, &Content::ParseDicomHeader, this);
+  return m_IsDicom;
+}
+
+std::string mitk::FileContentSniffer::Content::GetDicomFilePath() const
+{
+  std::call_once(m_DicomFlag, &Content::ParseDicomHeader, this);
+  return m_DicomFilePath;
+}
+
+std::string mitk::FileContentSniffer::Content::GetDicomTagValue(const std::string &tag) const
+{
+  std::call_once(m_DicomFlag, &Content::ParseDicomHeader, this);
+
+  auto iter = m_DicomTags.find(tag);
+  return iter != m_DicomTags.end() ? iter->second : std::string();
+}
+
+bool mitk::FileContentSniffer::Content::CanReadDicomImage() const
+{
+  std::call_once(m_DicomFlag, &Content::ParseDicomHeader, this);
+  return m_CanReadDicomImage;
+}
+
+std::string mitk::FileContentSniffer::Content::GetValue(const std::string &key,
+                                                        const std::function<std::string()> &compute) const
+{
+  {
+    std::lock_guard<std::mutex> lock(m_ValuesMutex);
+
+    auto iter = m_Values.find(key);
+    if (iter != m_Values.end())
+      return iter->second;
+  }
+
+  // Compute without holding the lock, compute may sniff other keys of this content.
+  // If two threads race for the same key, the first stored value wins.
+  auto value = compute();
+
+  std::lock_guard<std::mutex> lock(m_ValuesMutex);
+  return m_Values.emplace(key, value).first->second;
+}
+
+std::shared_ptr<const mitk::FileContentSniffer::Content> mitk::FileContentSniffer::Sniff(const std::string &path)
+{
+  const auto modifiedTime = itksys::SystemTools::ModifiedTime(path);
+  const auto size = itksys::SystemTools::FileLength(path);
+
+  auto &cache = GetCache();
+
+  {
+    std::lock_guard<std::mutex> lock(cache.Mutex);
+
+    auto iter = cache.Entries.find(path);
+    if (iter != cache.Entries.end())
+    {
+      if (iter->second.ModifiedTime == modifiedTime && iter->second.Size == size)
+      {
+        cache.LeastRecentlyUsed.splice(cache.LeastRecentlyUsed.end(), cache.LeastRecentlyUsed, iter->second.Position);
+        return iter->second.Content;
+      }
+
+      cache.LeastRecentlyUsed.erase(iter->second.Position);
+      cache.Entries.erase(iter);
+    }
+  }
+
+  // Reading the prefix is done without holding the lock to not serialize sniffing of different paths.
+  auto content = std::make_shared<const Content>(path);
+
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  ++cache.NumberOfSniffedPaths;
+
+  if (0 == cache.MaximumSize)
+    return content;
+
+  auto iter = cache.Entries.find(path);
+  if (iter != cache.Entries.end())
+    return iter->second.Content; // another thread was faster
+
+  cache.Shrink(cache.MaximumSize - 1);
+  auto position = cache.LeastRecentlyUsed.insert(cache.LeastRecentlyUsed.end(), path);
+  cache.Entries.emplace(path, CacheEntry{content, modifiedTime, size, position});
+
+  return content;
+}
+
+void mitk::FileContentSniffer::ClearCache()
+{
+  auto &cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+
+  cache.Entries.clear();
+  cache.LeastRecentlyUsed.clear();
+  cache.NumberOfSniffedPaths = 0;
+}
+
+std::size_t mitk::FileContentSniffer::GetCacheSize()
+{
+  auto &cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.Entries.size();
+}
+
+void mitk::FileContentSniffer::SetMaximumCacheSize(std::size_t size)
+{
+  auto &cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+
+  cache.MaximumSize = size;
+  cache.Shrink(size);
+}
+
+std::size_t mitk::FileContentSniffer::GetMaximumCacheSize()
+{
+  auto &cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.MaximumSize;
+}
+
+std::size_t mitk::FileContentSniffer::GetNumberOfSniffedPaths()
+{
+  auto &cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.NumberOfSniffedPaths;
+}
@@ -13,14 +13,8 @@ found in the LICENSE file.
 #include "mitkIOMimeTypes.h"
 
 #include "mitkCustomMimeType.h"
+#include "mitkFileContentSniffer.h"
 #include "mitkLog.h"
-#include <mitkUtf8Util.h>
-
-#include "itkGDCMImageIO.h"
-#include "itkMetaDataObject.h"
-
-#include <itksys/SystemTools.hxx>
-#include <itksys/Directory.hxx>
 
 namespace mitk
 {
@@ -41,68 +35,23 @@ namespace mitk
 
   bool IOMimeTypes::BaseDicomMimeType::AppliesTo(const std::string &path) const
   {
-    // check whether directory or file
-    // if directory try to find first file within it instead
-    bool pathIsDirectory = itksys::SystemTools::FileIsDirectory(Utf8Util::Local8BitToUtf8(path));
-
-    std::string filepath = path;
-
-    itk::GDCMImageIO::Pointer gdcmIO = itk::GDCMImageIO::New();
-
-    if (pathIsDirectory)
-    {
-      itksys::Directory input;
-      input.Load(path.c_str());
-
-      bool dcmFound = false;
-      for (unsigned long idx = 0; idx<input.GetNumberOfFiles(); idx++)
-      {
-        auto filename = Utf8Util::Local8BitToUtf8(input.GetFile(idx));
-
-        std::string fullpath = path + "/" + filename;
-
-        if (!itksys::SystemTools::FileIsDirectory(fullpath))
-        {
-
-          gdcmIO->SetFileName(fullpath);
-          try
-          {
-            gdcmIO->ReadImageInformation();
-            dcmFound = true;
-            filepath = fullpath;
-            break;
-          }
-          catch (const itk::ExceptionObject& /*err*/)
-          {
-          }
-        }
-      }
-      if (!dcmFound) return false;
-    }
-    else
-    {
-      // Ask the GDCM ImageIO class directly
-      gdcmIO->SetFileName(filepath);
-      try {
-        gdcmIO->ReadImageInformation();
-      }
-      catch (const itk::ExceptionObject& /*err*/) {
-        return false;
-      }
-    }
+    // the header is parsed only once per path and shared with all other mime types
+    // (if path is a directory, the first DICOM file within it is used instead)
+    auto content = FileContentSniffer::Sniff(path);
+
+    if (!content->IsDicom())
+      return false;
 
-    //If we reached that point, there is at least one file (stored under filepath) that is a DICOM
+    //If we reached that point, there is at least one file (stored under content->GetDicomFilePath()) that is a DICOM
 
     //DICOMRT modalities have specific reader, don't read with normal DICOM readers
-    std::string modality;
-    itk::MetaDataDictionary& dict = gdcmIO->GetMetaDataDictionary();
-    itk::ExposeMetaData<std::string>(dict, "0008|0060", modality);
+    std::string modality = content->GetDicomTagValue("0008|0060");
     MITK_DEBUG << "DICOM Modality detected by MimeType "<< this->GetName() << " is " << modality;
     if (modality == "RTSTRUCT" || modality == "RTDOSE" || modality == "RTPLAN") {
       return false;
     }
     else {
-      return gdcmIO->CanReadFile(filepath.c_str());
+      return content->CanReadDicomImage();
     }
   }
 
@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <mitkFileReaderRegistry.h>
 #include <mitkFileWriterRegistry.h>
 #include <mitkIMimeTypeProvider.h>
+#include <mitkLocaleSwitch.h>
 #include <mitkProgressBar.h>
 #include <mitkStandaloneDataStorage.h>
 #include <usGetModuleContext.h>
@@ -36,8 +37,13 @@ found in the LICENSE file.
 #include <vtkSmartPointer.h>
 #include <vtkTriangleFilter.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <mutex>
+#include <thread>
 
 static std::string GetLastErrorStr()
 {
@@ -313,6 +319,32 @@ namespace mitk
     };
 
     static BaseData::Pointer LoadBaseDataFromFile(const std::string &path, const ReaderOptionsFunctorBase* optionsCallback = nullptr);
+
+    /** Selects the reader of loadInfo, re-using the options of previously used readers or asking
+     * optionsCallback. Returns nullptr if the file cannot be read. abort is set to true if the
+     * whole load operation has to be stopped (e.g. it was cancelled).*/
+    static IFileReader *SelectReader(LoadInfo &loadInfo,
+                                     std::map<std::string, FileReaderSelector::Item> &usedReaderItems,
+                                     const ReaderOptionsFunctorBase *optionsCallback,
+                                     std::string &errMsg,
+                                     bool &abort);
+
+    /** Reads without a DataStorage and wraps the results into (not yet added) nodes. */
+    static DataStorage::SetOfObjects::Pointer ReadNodes(IFileReader *reader);
+
+    static void AddOutput(LoadInfo &loadInfo,
+                          const DataStorage::SetOfObjects *nodes,
+                          DataStorage::SetOfObjects *nodeResult,
+                          std::string &errMsg);
+
+    /** Adds nodes to target, keeping the parent/child relations they have in source. */
+    static void TransferNodes(const DataStorage::SetOfObjects *nodes, const DataStorage &source, DataStorage &target);
+
+    static std::string LoadConcurrently(std::vector<LoadInfo> &loadInfos,
+                                        DataStorage::SetOfObjects *nodeResult,
+                                        DataStorage *ds,
+                                        const ReaderOptionsFunctorBase *optionsCallback,
+                                        unsigned int maximumNumberOfConcurrentReads);
   };
 
   BaseData::Pointer IOUtil::Impl::LoadBaseDataFromFile(const std::string &path,
@@ -566,168 +598,471 @@ namespace mitk
     return result;
   }
 
-  std::string IOUtil::Load(std::vector<LoadInfo> &loadInfos,
-                           DataStorage::SetOfObjects *nodeResult,
-                           DataStorage *ds,
-                           const ReaderOptionsFunctorBase *optionsCallback)
+  DataStorage::SetOfObjects::Pointer IOUtil::Load(std::vector<LoadInfo> &loadInfos,
+                                                  DataStorage &storage,
+                                                  unsigned int maximumNumberOfConcurrentReads,
+                                                  const ReaderOptionsFunctorBase *optionsCallback)
   {
-    if (loadInfos.empty())
+    DataStorage::SetOfObjects::Pointer nodeResult = DataStorage::SetOfObjects::New();
+    std::string errMsg = Load(loadInfos, nodeResult, &storage, optionsCallback, maximumNumberOfConcurrentReads);
+    if (!errMsg.empty())
     {
-      return "No input files given";
+      mitkThrow() << errMsg;
     }
+    return nodeResult;
+  }
 
-    int filesToRead = loadInfos.size();
-    mitk::ProgressBar::GetInstance()->AddStepsToDo(2 * filesToRead);
+  std::vector<BaseData::Pointer> IOUtil::Load(std::vector<LoadInfo> &loadInfos,
+                                              unsigned int maximumNumberOfConcurrentReads,
+                                              const ReaderOptionsFunctorBase *optionsCallback)
+  {
+    std::string errMsg = Load(loadInfos, nullptr, nullptr, optionsCallback, maximumNumberOfConcurrentReads);
+    if (!errMsg.empty())
+    {
+      mitkThrow() << errMsg;
+    }
 
-    std::string errMsg;
+    std::vector<BaseData::Pointer> result;
+    for (const auto &loadInfo : loadInfos)
+    {
+      result.insert(result.end(), loadInfo.m_Output.begin(), loadInfo.m_Output.end());
+    }
+    return result;
+  }
 
-    std::map<std::string, FileReaderSelector::Item> usedReaderItems;
+  IFileReader *IOUtil::Impl::SelectReader(LoadInfo &loadInfo,
+                                          std::map<std::string, FileReaderSelector::Item> &usedReaderItems,
+                                          const ReaderOptionsFunctorBase *optionsCallback,
+                                          std::string &errMsg,
+                                          bool &abort)
+  {
+    abort = false;
 
-    std::vector< std::string > read_files;
-    for (auto &loadInfo : loadInfos)
+    std::vector<FileReaderSelector::Item> readers = loadInfo.m_ReaderSelector.Get();
+
+    if (readers.empty())
     {
-      if(std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
+      if (!itksys::SystemTools::FileExists(Utf8Util::Local8BitToUtf8(loadInfo.m_Path).c_str()))
+      {
+        errMsg += "File '" + loadInfo.m_Path + "' does not exist\n";
+      }
+      else
+      {
+        errMsg += "No reader available for '" + loadInfo.m_Path + "'\n";
+      }
+      return nullptr;
+    }
+
+    bool callOptionsCallback = readers.size() > 1 || !readers.front().GetReader()->GetOptions().empty();
+
+    // check if we already used a reader which should be re-used
+    std::vector<MimeType> currMimeTypes = loadInfo.m_ReaderSelector.GetMimeTypes();
+    std::string selectedMimeType;
+    for (std::vector<MimeType>::const_iterator mimeTypeIter = currMimeTypes.begin(),
+                                               mimeTypeIterEnd = currMimeTypes.end();
+         mimeTypeIter != mimeTypeIterEnd;
+         ++mimeTypeIter)
+    {
+      std::map<std::string, FileReaderSelector::Item>::const_iterator oldSelectedItemIter =
+        usedReaderItems.find(mimeTypeIter->GetName());
+      if (oldSelectedItemIter != usedReaderItems.end())
+      {
+        // we found an already used item for a mime-type which is contained
+        // in the current reader set, check all current readers if there service
+        // id equals the old reader
+        for (std::vector<FileReaderSelector::Item>::const_iterator currReaderItem = readers.begin(),
+                                                                   currReaderItemEnd = readers.end();
+             currReaderItem != currReaderItemEnd;
+             ++currReaderItem)
+        {
+          if (currReaderItem->GetMimeType().GetName() == mimeTypeIter->GetName() &&
+              currReaderItem->GetServiceId() == oldSelectedItemIter->second.GetServiceId() &&
+              currReaderItem->GetConfidenceLevel() >= oldSelectedItemIter->second.GetConfidenceLevel())
+          {
+            // okay, we used the same reader already, re-use its options
+            selectedMimeType = mimeTypeIter->GetName();
+            callOptionsCallback = false;
+            loadInfo.m_ReaderSelector.Select(oldSelectedItemIter->second.GetServiceId());
+            loadInfo.m_ReaderSelector.GetSelected().GetReader()->SetOptions(
+              oldSelectedItemIter->second.GetReader()->GetOptions());
+            break;
+          }
+        }
+        if (!selectedMimeType.empty())
+          break;
+      }
+    }
+
+    if (callOptionsCallback && optionsCallback)
+    {
+      callOptionsCallback = (*optionsCallback)(loadInfo);
+      if (!callOptionsCallback && !loadInfo.m_Cancel)
+      {
+        usedReaderItems.erase(selectedMimeType);
+        FileReaderSelector::Item selectedItem = loadInfo.m_ReaderSelector.GetSelected();
+        usedReaderItems.insert(std::make_pair(selectedItem.GetMimeType().GetName(), selectedItem));
+      }
+    }
+
+    if (loadInfo.m_Cancel)
+    {
+      errMsg += "Reading operation(s) cancelled.";
+      abort = true;
+      return nullptr;
+    }
+
+    IFileReader *reader = loadInfo.m_ReaderSelector.GetSelected().GetReader();
+    if (reader == nullptr)
+    {
+      errMsg += "Unexpected nullptr reader.";
+      abort = true;
+      return nullptr;
+    }
+
+    reader->SetProperties(loadInfo.m_Properties);
+    return reader;
+  }
+
+  DataStorage::SetOfObjects::Pointer IOUtil::Impl::ReadNodes(IFileReader *reader)
+  {
+    DataStorage::SetOfObjects::Pointer nodes = DataStorage::SetOfObjects::New();
+    std::vector<mitk::BaseData::Pointer> baseData = reader->Read();
+    for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
+    {
+      if (iter->IsNotNull())
+      {
+        mitk::DataNode::Pointer node = mitk::DataNode::New();
+        node->SetData(*iter);
+        nodes->InsertElement(nodes->Size(), node);
+      }
+    }
+    return nodes;
+  }
+
+  void IOUtil::Impl::AddOutput(LoadInfo &loadInfo,
+                               const DataStorage::SetOfObjects *nodes,
+                               DataStorage::SetOfObjects *nodeResult,
+                               std::string &errMsg)
+  {
+    for (DataStorage::SetOfObjects::ConstIterator nodeIter = nodes->Begin(), nodeIterEnd = nodes->End();
+         nodeIter != nodeIterEnd;
+         ++nodeIter)
+    {
+      const mitk::DataNode::Pointer &node = nodeIter->Value();
+      mitk::BaseData::Pointer data = node->GetData();
+      if (data.IsNull())
+      {
         continue;
+      }
 
-      std::vector<FileReaderSelector::Item> readers = loadInfo.m_ReaderSelector.Get();
+      data->SetProperty("path", mitk::StringProperty::New(Utf8Util::Local8BitToUtf8(loadInfo.m_Path)));
 
-      if (readers.empty())
+      loadInfo.m_Output.push_back(data);
+      if (nodeResult)
       {
-        if (!itksys::SystemTools::FileExists(Utf8Util::Local8BitToUtf8(loadInfo.m_Path).c_str()))
+        nodeResult->push_back(nodeIter->Value());
+      }
+    }
+
+    if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
+    {
+      errMsg += "Unknown read error occurred reading " + loadInfo.m_Path;
+    }
+  }
+
+  void IOUtil::Impl::TransferNodes(const DataStorage::SetOfObjects *nodes, const DataStorage &source, DataStorage &target)
+  {
+    std::vector<DataNode::Pointer> pending(nodes->begin(), nodes->end());
+
+    while (!pending.empty())
+    {
+      const auto numberOfPendingNodes = pending.size();
+
+      for (auto iter = pending.begin(); iter != pending.end();)
+      {
+        auto sources = source.GetSources(*iter, nullptr, true);
+
+        // parents have to be added before their children
+        auto isPending = [&pending](const DataNode::Pointer &parent) {
+          return std::find(pending.begin(), pending.end(), parent) != pending.end();
+        };
+
+        if (std::any_of(sources->begin(), sources->end(), isPending))
         {
-          errMsg += "File '" + loadInfo.m_Path + "' does not exist\n";
+          ++iter;
+          continue;
         }
-        else
+
+        auto parents = DataStorage::SetOfObjects::New();
+        for (const auto &parent : *sources)
         {
-          errMsg += "No reader available for '" + loadInfo.m_Path + "'\n";
+          if (target.Exists(parent))
+            parents->push_back(parent);
         }
-        continue;
+
+        target.Add(*iter, parents);
+        iter = pending.erase(iter);
+      }
+
+      if (pending.size() == numberOfPendingNodes)
+      {
+        MITK_ERROR << "Cyclic node relations found. " << pending.size() << " node(s) could not be added to the data storage.";
+        break;
       }
+    }
+  }
+
+  std::string IOUtil::Impl::LoadConcurrently(std::vector<LoadInfo> &loadInfos,
+                                             DataStorage::SetOfObjects *nodeResult,
+                                             DataStorage *ds,
+                                             const ReaderOptionsFunctorBase *optionsCallback,
+                                             unsigned int maximumNumberOfConcurrentReads)
+  {
+    const auto numberOfFiles = loadInfos.size();
+    mitk::ProgressBar::GetInstance()->AddStepsToDo(static_cast<unsigned int>(2 * numberOfFiles));
+
+    std::string errMsg;
+
+    // Reader selection may ask the user for options, so it is done up front on the calling thread.
+    std::map<std::string, FileReaderSelector::Item> usedReaderItems;
+    std::vector<IFileReader *> readers(numberOfFiles, nullptr);
+    std::size_t numberOfFilesToRead = 0;
+
+    for (std::size_t i = 0; i < numberOfFiles; ++i)
+    {
+      bool abort = false;
+      readers[i] = SelectReader(loadInfos[i], usedReaderItems, optionsCallback, errMsg, abort);
+
+      if (abort)
+        break;
+
+      if (readers[i] != nullptr)
+        ++numberOfFilesToRead;
+    }
+
+    struct ReadResult
+    {
+      StandaloneDataStorage::Pointer Storage;
+      DataStorage::SetOfObjects::Pointer Nodes;
+      std::vector<std::string> ReadFiles;
+      std::string ErrorMessage;
+    };
 
-      bool callOptionsCallback = readers.size() > 1 || !readers.front().GetReader()->GetOptions().empty();
+    std::vector<ReadResult> results(numberOfFiles);
 
-      // check if we already used a reader which should be re-used
-      std::vector<MimeType> currMimeTypes = loadInfo.m_ReaderSelector.GetMimeTypes();
-      std::string selectedMimeType;
-      for (std::vector<MimeType>::const_iterator mimeTypeIter = currMimeTypes.begin(),
-                                                 mimeTypeIterEnd = currMimeTypes.end();
-           mimeTypeIter != mimeTypeIterEnd;
-           ++mimeTypeIter)
+    std::mutex mutex;
+    std::condition_variable fileFinished;
+    std::size_t nextFile = 0;
+    std::size_t numberOfFinishedFiles = 0;
+
+    auto readFiles = [&]() {
+      while (true)
       {
-        std::map<std::string, FileReaderSelector::Item>::const_iterator oldSelectedItemIter =
-          usedReaderItems.find(mimeTypeIter->GetName());
-        if (oldSelectedItemIter != usedReaderItems.end())
+        std::size_t index;
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+
+          while (nextFile < numberOfFiles && readers[nextFile] == nullptr)
+            ++nextFile;
+
+          if (nextFile == numberOfFiles)
+            return;
+
+          index = nextFile++;
+        }
+
+        auto *reader = readers[index];
+        ReadResult result;
+        const auto start = std::chrono::steady_clock::now();
+
+        try
         {
-          // we found an already used item for a mime-type which is contained
-          // in the current reader set, check all current readers if there service
-          // id equals the old reader
-          for (std::vector<FileReaderSelector::Item>::const_iterator currReaderItem = readers.begin(),
-                                                                     currReaderItemEnd = readers.end();
-               currReaderItem != currReaderItemEnd;
-               ++currReaderItem)
+          if (ds != nullptr)
           {
-            if (currReaderItem->GetMimeType().GetName() == mimeTypeIter->GetName() &&
-                currReaderItem->GetServiceId() == oldSelectedItemIter->second.GetServiceId() &&
-                currReaderItem->GetConfidenceLevel() >= oldSelectedItemIter->second.GetConfidenceLevel())
-            {
-              // okay, we used the same reader already, re-use its options
-              selectedMimeType = mimeTypeIter->GetName();
-              callOptionsCallback = false;
-              loadInfo.m_ReaderSelector.Select(oldSelectedItemIter->second.GetServiceId());
-              loadInfo.m_ReaderSelector.GetSelected().GetReader()->SetOptions(
-                oldSelectedItemIter->second.GetReader()->GetOptions());
-              break;
-            }
+            // readers may build node hierarchies, so they get a private storage that is merged afterwards
+            result.Storage = StandaloneDataStorage::New();
+            result.Nodes = reader->Read(*result.Storage);
           }
-          if (!selectedMimeType.empty())
-            break;
+          else
+          {
+            result.Nodes = ReadNodes(reader);
+          }
+
+          result.ReadFiles = reader->GetReadFiles();
+        }
+        catch (const std::exception &e)
+        {
+          result.ErrorMessage = "Exception occurred when reading file " + loadInfos[index].m_Path + ":\n" + e.what() + "\n\n";
+        }
+        catch (...)
+        {
+          result.ErrorMessage = "Unknown exception occurred when reading file " + loadInfos[index].m_Path + "\n\n";
         }
-      }
 
-      if (callOptionsCallback && optionsCallback)
-      {
-        callOptionsCallback = (*optionsCallback)(loadInfo);
-        if (!callOptionsCallback && !loadInfo.m_Cancel)
+        loadInfos[index].m_ReadDuration =
+          std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
         {
-          usedReaderItems.erase(selectedMimeType);
-          FileReaderSelector::Item selectedItem = loadInfo.m_ReaderSelector.GetSelected();
-          usedReaderItems.insert(std::make_pair(selectedItem.GetMimeType().GetName(), selectedItem));
+          std::lock_guard<std::mutex> lock(mutex);
+          results[index] = std::move(result);
+          ++numberOfFinishedFiles;
         }
+
+        fileFinished.notify_one();
       }
+    };
 
-      if (loadInfo.m_Cancel)
+    {
+      // The locale is global. Switching it within concurrently running readers would be a race,
+      // so it is switched once for all of them.
+      LocaleSwitch localeSwitch("C");
+
+      // Readers may report progress themselves (e.g. scene readers). The progress bar drives GUI
+      // elements, thus their progress is forwarded by the calling thread.
+      auto *progressBar = mitk::ProgressBar::GetInstance();
+      progressBar->DeferProgressOfOtherThreads();
+
+      const auto numberOfThreads = std::min<std::size_t>(maximumNumberOfConcurrentReads, numberOfFilesToRead);
+      std::vector<std::thread> threads;
+      threads.reserve(numberOfThreads);
+
+      for (std::size_t i = 0; i < numberOfThreads; ++i)
+        threads.emplace_back(readFiles);
+
+      // report progress on the calling thread
+      std::size_t numberOfReportedFiles = 0;
+      std::unique_lock<std::mutex> lock(mutex);
+
+      while (numberOfReportedFiles < numberOfFilesToRead)
       {
-        errMsg += "Reading operation(s) cancelled.";
-        break;
+        fileFinished.wait_for(lock, std::chrono::milliseconds(100), [&]() { return numberOfFinishedFiles > numberOfReportedFiles; });
+
+        const auto numberOfNewFiles = numberOfFinishedFiles - numberOfReportedFiles;
+        numberOfReportedFiles = numberOfFinishedFiles;
+
+        lock.unlock();
+        progressBar->ForwardDeferredProgress();
+        if (0 != numberOfNewFiles)
+          progressBar->Progress(static_cast<unsigned int>(2 * numberOfNewFiles));
+        lock.lock();
       }
 
-      IFileReader *reader = loadInfo.m_ReaderSelector.GetSelected().GetReader();
-      if (reader == nullptr)
+      lock.unlock();
+
+      for (auto &thread : threads)
+        thread.join();
+
+      progressBar->StopDeferringProgressOfOtherThreads();
+    }
+
+    // Merge the results in the order of loadInfos. Files that were already read as part of a
+    // previous file (e.g. DICOM series) are dropped as it is done by the sequential load.
+    std::vector<std::string> read_files;
+    for (std::size_t i = 0; i < numberOfFiles; ++i)
+    {
+      if (readers[i] == nullptr)
+        continue;
+
+      auto &loadInfo = loadInfos[i];
+      auto &result = results[i];
+
+      if (std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
+        continue;
+
+      read_files.insert(read_files.end(), result.ReadFiles.begin(), result.ReadFiles.end());
+
+      if (!result.ErrorMessage.empty())
       {
-        errMsg += "Unexpected nullptr reader.";
-        break;
+        errMsg += result.ErrorMessage;
+        continue;
       }
 
-      reader->SetProperties(loadInfo.m_Properties);
+      if (ds != nullptr)
+        TransferNodes(result.Nodes, *result.Storage, *ds);
+
+      AddOutput(loadInfo, result.Nodes, nodeResult, errMsg);
+    }
+
+    if (!errMsg.empty())
+    {
+      MITK_ERROR << errMsg;
+    }
+
+    mitk::ProgressBar::GetInstance()->Progress(static_cast<unsigned int>(2 * (numberOfFiles - numberOfFilesToRead)));
+
+    return errMsg;
+  }
+
+  std::string IOUtil::Load(std::vector<LoadInfo> &loadInfos,
+                           DataStorage::SetOfObjects *nodeResult,
+                           DataStorage *ds,
+                           const ReaderOptionsFunctorBase *optionsCallback,
+                           unsigned int maximumNumberOfConcurrentReads)
+  {
+    if (loadInfos.empty())
+    {
+      return "No input files given";
+    }
+
+    if (0 == maximumNumberOfConcurrentReads)
+    {
+      maximumNumberOfConcurrentReads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    if (maximumNumberOfConcurrentReads > 1 && loadInfos.size() > 1)
+    {
+      return Impl::LoadConcurrently(loadInfos, nodeResult, ds, optionsCallback, maximumNumberOfConcurrentReads);
+    }
+
+    int filesToRead = loadInfos.size();
+    mitk::ProgressBar::GetInstance()->AddStepsToDo(2 * filesToRead);
+
+    std::string errMsg;
+
+    std::map<std::string, FileReaderSelector::Item> usedReaderItems;
+
+    std::vector< std::string > read_files;
+    for (auto &loadInfo : loadInfos)
+    {
+      if(std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
+        continue;
+
+      bool abort = false;
+      IFileReader *reader = Impl::SelectReader(loadInfo, usedReaderItems, optionsCallback, errMsg, abort);
+
+      if (abort)
+        break;
+
+      if (reader == nullptr)
+        continue;
 
       // Do the actual reading
+      const auto start = std::chrono::steady_clock::now();
       try
       {
         DataStorage::SetOfObjects::Pointer nodes;
         if (ds != nullptr)
         {
           nodes = reader->Read(*ds);
-
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
         }
         else
         {
-          nodes = DataStorage::SetOfObjects::New();
-          std::vector<mitk::BaseData::Pointer> baseData = reader->Read();
-          for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
-          {
-            if (iter->IsNotNull())
-            {
-              mitk::DataNode::Pointer node = mitk::DataNode::New();
-              node->SetData(*iter);
-              nodes->InsertElement(nodes->Size(), node);
-            }
-          }
-
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
+          nodes = Impl::ReadNodes(reader);
         }
 
-        for (DataStorage::SetOfObjects::ConstIterator nodeIter = nodes->Begin(), nodeIterEnd = nodes->End();
-             nodeIter != nodeIterEnd;
-             ++nodeIter)
-        {
-          const mitk::DataNode::Pointer &node = nodeIter->Value();
-          mitk::BaseData::Pointer data = node->GetData();
-          if (data.IsNull())
-          {
-            continue;
-          }
-
-          data->SetProperty("path", mitk::StringProperty::New(Utf8Util::Local8BitToUtf8(loadInfo.m_Path)));
+        std::vector< std::string > new_files =  reader->GetReadFiles();
+        read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
 
-          loadInfo.m_Output.push_back(data);
-          if (nodeResult)
-          {
-            nodeResult->push_back(nodeIter->Value());
-          }
-        }
-
-        if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
-        {
-          errMsg += "Unknown read error occurred reading " + loadInfo.m_Path;
-        }
+        Impl::AddOutput(loadInfo, nodes, nodeResult, errMsg);
       }
       catch (const std::exception &e)
       {
         errMsg += "Exception occurred when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
       }
+      loadInfo.m_ReadDuration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
       mitk::ProgressBar::GetInstance()->Progress(2);
       --filesToRead;
     }
@@ -1009,7 +1344,8 @@ namespace mitk
     : m_Path(path),
       m_ReaderSelector(path),
       m_Cancel(false),
-      m_Properties(nullptr)
+      m_Properties(nullptr),
+      m_ReadDuration(0)
   {
   }
 }
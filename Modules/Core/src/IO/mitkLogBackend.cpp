@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include <mitkExceptionMacro.h>
 #include <mitkLogBackend.h>
+#include <mitkLogBackendAsync.h>
 
 #include <itkOutputWindow.h>
 
@@ -22,6 +23,7 @@ found in the LICENSE file.
 
 static std::mutex logMutex;
 static mitk::LogBackend *mitkLogBackend = nullptr;
+static mitk::LogBackendAsync *mitkLogBackendAsync = nullptr;
 static std::ofstream *logFile = nullptr;
 static std::string logFileName = "";
 static std::stringstream *outputWindow = nullptr;
@@ -67,12 +69,21 @@ void mitk::LogBackend::ProcessMessage(const LogMessage& message)
   logMutex.unlock();
 }
 
-void mitk::LogBackend::Register()
+void mitk::LogBackend::Register(bool asynchronous)
 {
   if (mitkLogBackend)
     return;
   mitkLogBackend = new LogBackend;
-  RegisterBackend(mitkLogBackend);
+
+  if (asynchronous)
+  {
+    mitkLogBackendAsync = new LogBackendAsync(mitkLogBackend);
+    RegisterBackend(mitkLogBackendAsync);
+  }
+  else
+  {
+    RegisterBackend(mitkLogBackend);
+  }
 }
 
 void mitk::LogBackend::Unregister()
@@ -80,7 +91,19 @@ void mitk::LogBackend::Unregister()
   if (mitkLogBackend)
   {
     SetLogFile("");
-    UnregisterBackend(mitkLogBackend);
+
+    if (mitkLogBackendAsync)
+    {
+      // Deleting the asynchronous backend writes all queued messages
+      UnregisterBackend(mitkLogBackendAsync);
+      delete mitkLogBackendAsync;
+      mitkLogBackendAsync = nullptr;
+    }
+    else
+    {
+      UnregisterBackend(mitkLogBackend);
+    }
+
     delete mitkLogBackend;
     mitkLogBackend = nullptr;
   }
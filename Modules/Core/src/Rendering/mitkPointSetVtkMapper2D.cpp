@@ -14,6 +14,7 @@ found in the LICENSE file.
 
 // mitk includes
 #include "mitkVtkPropRenderer.h"
+#include <mitkAbstractTransformGeometry.h>
 #include <mitkDataNode.h>
 #include <mitkPlaneGeometry.h>
 #include <mitkPointSet.h>
@@ -296,173 +297,239 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
 
   vtkLinearTransform *dataNodeTransform = input->GetGeometry()->GetVtkTransform();
 
-  int count = 0;
-
-  for (pointsIter = itkPointSet->GetPoints()->Begin(); pointsIter != itkPointSet->GetPoints()->End(); pointsIter++)
-  {
-    lastP = p;              // valid for number of points count > 0
-    preLastPt2d = lastPt2d; // valid only for count > 1
-    lastPt2d = pt2d;        // valid for number of points count > 0
+  // Adds the marker and the label of the current point, if it is close to the plane
+  auto addPointMarker = [&](float dist, bool selected, mitk::PointSet::PointIdentifier id) {
+    // is point selected or not?
+    if (selected)
+    {
+      ls->m_SelectedPoints->InsertNextPoint(point[0], point[1], point[2]);
+      // point is scaled according to its distance to the plane
+      ls->m_SelectedScales->InsertNextTuple3(
+          std::max(0.0f, m_Point2DSize - (2 * dist)), 0, 0);
+    }
+    else
+    {
+      ls->m_UnselectedPoints->InsertNextPoint(point[0], point[1], point[2]);
+      // point is scaled according to its distance to the plane
+      ls->m_UnselectedScales->InsertNextTuple3(
+          std::max(0.0f, m_Point2DSize - (2 * dist)), 0, 0);
+    }
 
-    lastVec = vec; // valid only for counter > 1
+    //---- LABEL -----//
+    // paint label for each point if available
+    if (dynamic_cast<mitk::StringProperty *>(this->GetDataNode()->GetProperty("label")) != nullptr)
+    {
+      const char *pointLabel =
+        dynamic_cast<mitk::StringProperty *>(this->GetDataNode()->GetProperty("label"))->GetValue();
+      std::string l = pointLabel;
+      if (input->GetSize() > 1)
+      {
+        std::stringstream ss;
+        ss << id;
+        l.append(ss.str());
+      }
 
-    // get current point in point set
-    point = pointsIter->Value();
+      ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
 
-    // transform point
-    {
-      float vtkp[3];
-      itk2vtk(point, vtkp);
-      dataNodeTransform->TransformPoint(vtkp, vtkp);
-      vtk2itk(vtkp, point);
-    }
+      ls->m_VtkTextActor->SetDisplayPosition(pt2d[0] + text2dDistance, pt2d[1] + text2dDistance);
+      ls->m_VtkTextActor->SetInput(l.c_str());
+      ls->m_VtkTextActor->GetTextProperty()->SetOpacity(100);
 
-    p[0] = point[0];
-    p[1] = point[1];
-    p[2] = point[2];
+      float unselectedColor[4] = {1.0, 1.0, 0.0, 1.0};
 
-    renderer->WorldToDisplay(p, pt2d);
+      // check if there is a color property
+      GetDataNode()->GetColor(unselectedColor);
 
-    vec = p - lastP; // valid only for counter > 0
+      ls->m_VtkTextActor->GetTextProperty()->SetColor(unselectedColor[0], unselectedColor[1], unselectedColor[2]);
 
-    // compute distance to current plane
-    float dist = geo2D->Distance(point);
-    // measure distance in screen pixel units if requested
-    if (m_FixedSizeOnScreen)
-    {
-      dist /= resolution;
+      ls->m_VtkTextLabelActors.push_back(ls->m_VtkTextActor);
     }
+  };
 
-    // draw markers on slices a certain distance away from the points
-    // location according to the tolerance threshold (m_DistanceToPlane)
-    if (dist < m_DistanceToPlane)
+  // Without contours, only the points close to the plane are visited. Their signed distance to an
+  // (affine) plane is an affine function of the stored point coordinates, so they are found by a
+  // slab query, which uses the spatial index of large point sets.
+  if (!m_ShowContour && dynamic_cast<const mitk::AbstractTransformGeometry *>(geo2D) == nullptr)
+  {
+    auto signedDistance = [&](double x, double y, double z) {
+      double coordinates[3] = {x, y, z};
+      dataNodeTransform->TransformPoint(coordinates, coordinates);
+      mitk::Point3D worldPoint;
+      vtk2itk(coordinates, worldPoint);
+      return geo2D->SignedDistance(worldPoint);
+    };
+
+    const ScalarType offset = signedDistance(0.0, 0.0, 0.0);
+    mitk::Vector3D slabNormal;
+    slabNormal[0] = signedDistance(1.0, 0.0, 0.0) - offset;
+    slabNormal[1] = signedDistance(0.0, 1.0, 0.0) - offset;
+    slabNormal[2] = signedDistance(0.0, 0.0, 1.0) - offset;
+
+    // the slab is slightly widened for rounding errors, the points are tested exactly below
+    const ScalarType maxDistance = m_FixedSizeOnScreen ? m_DistanceToPlane * resolution : m_DistanceToPlane;
+    const ScalarType margin = 0.01 * maxDistance + 0.001;
+
+    const auto pointIds =
+      input->SearchPointsInSlab(slabNormal, -maxDistance - margin - offset, maxDistance + margin - offset, timestep);
+
+    for (auto id : pointIds)
     {
-      // is point selected or not?
-      if (pointDataIter->Value().selected)
+      point = itkPointSet->GetPoints()->GetElement(id);
+
+      // transform point
       {
-        ls->m_SelectedPoints->InsertNextPoint(point[0], point[1], point[2]);
-        // point is scaled according to its distance to the plane
-        ls->m_SelectedScales->InsertNextTuple3(
-            std::max(0.0f, m_Point2DSize - (2 * dist)), 0, 0);
+        float vtkp[3];
+        itk2vtk(point, vtkp);
+        dataNodeTransform->TransformPoint(vtkp, vtkp);
+        vtk2itk(vtkp, point);
       }
-      else
+
+      p[0] = point[0];
+      p[1] = point[1];
+      p[2] = point[2];
+
+      renderer->WorldToDisplay(p, pt2d);
+
+      float dist = geo2D->Distance(point);
+      if (m_FixedSizeOnScreen)
       {
-        ls->m_UnselectedPoints->InsertNextPoint(point[0], point[1], point[2]);
-        // point is scaled according to its distance to the plane
-        ls->m_UnselectedScales->InsertNextTuple3(
-            std::max(0.0f, m_Point2DSize - (2 * dist)), 0, 0);
+        dist /= resolution;
       }
 
-      //---- LABEL -----//
-      // paint label for each point if available
-      if (dynamic_cast<mitk::StringProperty *>(this->GetDataNode()->GetProperty("label")) != nullptr)
+      if (dist < m_DistanceToPlane)
       {
-        const char *pointLabel =
-          dynamic_cast<mitk::StringProperty *>(this->GetDataNode()->GetProperty("label"))->GetValue();
-        std::string l = pointLabel;
-        if (input->GetSize() > 1)
-        {
-          std::stringstream ss;
-          ss << pointsIter->Index();
-          l.append(ss.str());
-        }
-
-        ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
-
-        ls->m_VtkTextActor->SetDisplayPosition(pt2d[0] + text2dDistance, pt2d[1] + text2dDistance);
-        ls->m_VtkTextActor->SetInput(l.c_str());
-        ls->m_VtkTextActor->GetTextProperty()->SetOpacity(100);
+        mitk::PointSet::PointDataType pointData = {0, false, PTUNDEFINED};
+        itkPointSet->GetPointData(id, &pointData);
+        addPointMarker(dist, pointData.selected, id);
+      }
+    }
+  }
+  else
+  {
+    int count = 0;
 
-        float unselectedColor[4] = {1.0, 1.0, 0.0, 1.0};
+    for (pointsIter = itkPointSet->GetPoints()->Begin(); pointsIter != itkPointSet->GetPoints()->End(); pointsIter++)
+    {
+      lastP = p;              // valid for number of points count > 0
+      preLastPt2d = lastPt2d; // valid only for count > 1
+      lastPt2d = pt2d;        // valid for number of points count > 0
 
-        // check if there is a color property
-        GetDataNode()->GetColor(unselectedColor);
+      lastVec = vec; // valid only for counter > 1
 
-        ls->m_VtkTextActor->GetTextProperty()->SetColor(unselectedColor[0], unselectedColor[1], unselectedColor[2]);
+      // get current point in point set
+      point = pointsIter->Value();
 
-        ls->m_VtkTextLabelActors.push_back(ls->m_VtkTextActor);
+      // transform point
+      {
+        float vtkp[3];
+        itk2vtk(point, vtkp);
+        dataNodeTransform->TransformPoint(vtkp, vtkp);
+        vtk2itk(vtkp, point);
       }
-    }
 
-    // draw contour, distance text and angle text in render window
+      p[0] = point[0];
+      p[1] = point[1];
+      p[2] = point[2];
 
-    // lines between points, which intersect the current plane, are drawn
-    if (m_ShowContour && count > 0)
-    {
-      ScalarType distance = renderer->GetCurrentWorldPlaneGeometry()->SignedDistance(point);
-      ScalarType lastDistance = renderer->GetCurrentWorldPlaneGeometry()->SignedDistance(lastP);
+      renderer->WorldToDisplay(p, pt2d);
 
-      pointsOnSameSideOfPlane = (distance * lastDistance) > 0.5;
+      vec = p - lastP; // valid only for counter > 0
 
-      // Points must be on different side of plane in order to draw a contour.
-      // If "show distant lines" is enabled this condition is disregarded.
-      if (!pointsOnSameSideOfPlane || m_ShowDistantLines)
+      // compute distance to current plane
+      float dist = geo2D->Distance(point);
+      // measure distance in screen pixel units if requested
+      if (m_FixedSizeOnScreen)
       {
-        vtkSmartPointer<vtkLine> line = vtkSmartPointer<vtkLine>::New();
+        dist /= resolution;
+      }
+
+      // draw markers on slices a certain distance away from the points
+      // location according to the tolerance threshold (m_DistanceToPlane)
+      if (dist < m_DistanceToPlane)
+      {
+        addPointMarker(dist, pointDataIter->Value().selected, pointsIter->Index());
+      }
 
-        ls->m_ContourPoints->InsertNextPoint(lastP[0], lastP[1], lastP[2]);
-        line->GetPointIds()->SetId(0, NumberContourPoints);
-        NumberContourPoints++;
+      // draw contour, distance text and angle text in render window
 
-        ls->m_ContourPoints->InsertNextPoint(point[0], point[1], point[2]);
-        line->GetPointIds()->SetId(1, NumberContourPoints);
-        NumberContourPoints++;
+      // lines between points, which intersect the current plane, are drawn
+      if (m_ShowContour && count > 0)
+      {
+        ScalarType distance = renderer->GetCurrentWorldPlaneGeometry()->SignedDistance(point);
+        ScalarType lastDistance = renderer->GetCurrentWorldPlaneGeometry()->SignedDistance(lastP);
 
-        ls->m_ContourLines->InsertNextCell(line);
+        pointsOnSameSideOfPlane = (distance * lastDistance) > 0.5;
 
-        if (m_ShowDistances) // calculate and print distance between adjacent points
+        // Points must be on different side of plane in order to draw a contour.
+        // If "show distant lines" is enabled this condition is disregarded.
+        if (!pointsOnSameSideOfPlane || m_ShowDistantLines)
         {
-          float distancePoints = point.EuclideanDistanceTo(lastP);
+          vtkSmartPointer<vtkLine> line = vtkSmartPointer<vtkLine>::New();
 
-          std::stringstream buffer;
-          buffer << std::fixed << std::setprecision(m_DistancesDecimalDigits) << distancePoints << " mm";
+          ls->m_ContourPoints->InsertNextPoint(lastP[0], lastP[1], lastP[2]);
+          line->GetPointIds()->SetId(0, NumberContourPoints);
+          NumberContourPoints++;
 
-          // compute desired display position of text
-          Vector2D vec2d = pt2d - lastPt2d;
-          makePerpendicularVector2D(vec2d,
-                                    vec2d); // text is rendered within text2dDistance perpendicular to current line
-          Vector2D pos2d = (lastPt2d.GetVectorFromOrigin() + pt2d.GetVectorFromOrigin()) * 0.5 + vec2d * text2dDistance;
+          ls->m_ContourPoints->InsertNextPoint(point[0], point[1], point[2]);
+          line->GetPointIds()->SetId(1, NumberContourPoints);
+          NumberContourPoints++;
 
-          ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
+          ls->m_ContourLines->InsertNextCell(line);
 
-          ls->m_VtkTextActor->SetDisplayPosition(pos2d[0], pos2d[1]);
-          ls->m_VtkTextActor->SetInput(buffer.str().c_str());
-          ls->m_VtkTextActor->GetTextProperty()->SetColor(0.0, 1.0, 0.0);
+          if (m_ShowDistances) // calculate and print distance between adjacent points
+          {
+            float distancePoints = point.EuclideanDistanceTo(lastP);
 
-          ls->m_VtkTextDistanceActors.push_back(ls->m_VtkTextActor);
-        }
+            std::stringstream buffer;
+            buffer << std::fixed << std::setprecision(m_DistancesDecimalDigits) << distancePoints << " mm";
 
-        if (m_ShowAngles && count > 1) // calculate and print angle between connected lines
-        {
-          std::stringstream buffer;
-          buffer << angle(vec.GetVnlVector(), -lastVec.GetVnlVector()) * 180 / vnl_math::pi << "°";
+            // compute desired display position of text
+            Vector2D vec2d = pt2d - lastPt2d;
+            makePerpendicularVector2D(vec2d,
+                                      vec2d); // text is rendered within text2dDistance perpendicular to current line
+            Vector2D pos2d = (lastPt2d.GetVectorFromOrigin() + pt2d.GetVectorFromOrigin()) * 0.5 + vec2d * text2dDistance;
+
+            ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
+
+            ls->m_VtkTextActor->SetDisplayPosition(pos2d[0], pos2d[1]);
+            ls->m_VtkTextActor->SetInput(buffer.str().c_str());
+            ls->m_VtkTextActor->GetTextProperty()->SetColor(0.0, 1.0, 0.0);
+
+            ls->m_VtkTextDistanceActors.push_back(ls->m_VtkTextActor);
+          }
 
-          // compute desired display position of text
-          Vector2D vec2d = pt2d - lastPt2d; // first arm enclosing the angle
-          vec2d.Normalize();
-          Vector2D lastVec2d = lastPt2d - preLastPt2d; // second arm enclosing the angle
-          lastVec2d.Normalize();
-          vec2d = vec2d - lastVec2d; // vector connecting both arms
-          vec2d.Normalize();
+          if (m_ShowAngles && count > 1) // calculate and print angle between connected lines
+          {
+            std::stringstream buffer;
+            buffer << angle(vec.GetVnlVector(), -lastVec.GetVnlVector()) * 180 / vnl_math::pi << "°";
 
-          // middle between two vectors that enclose the angle
-          Vector2D pos2d = lastPt2d.GetVectorFromOrigin() + vec2d * text2dDistance * text2dDistance;
+            // compute desired display position of text
+            Vector2D vec2d = pt2d - lastPt2d; // first arm enclosing the angle
+            vec2d.Normalize();
+            Vector2D lastVec2d = lastPt2d - preLastPt2d; // second arm enclosing the angle
+            lastVec2d.Normalize();
+            vec2d = vec2d - lastVec2d; // vector connecting both arms
+            vec2d.Normalize();
 
-          ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
+            // middle between two vectors that enclose the angle
+            Vector2D pos2d = lastPt2d.GetVectorFromOrigin() + vec2d * text2dDistance * text2dDistance;
 
-          ls->m_VtkTextActor->SetDisplayPosition(pos2d[0], pos2d[1]);
-          ls->m_VtkTextActor->SetInput(buffer.str().c_str());
-          ls->m_VtkTextActor->GetTextProperty()->SetColor(0.0, 1.0, 0.0);
+            ls->m_VtkTextActor = vtkSmartPointer<vtkTextActor>::New();
 
-          ls->m_VtkTextAngleActors.push_back(ls->m_VtkTextActor);
+            ls->m_VtkTextActor->SetDisplayPosition(pos2d[0], pos2d[1]);
+            ls->m_VtkTextActor->SetInput(buffer.str().c_str());
+            ls->m_VtkTextActor->GetTextProperty()->SetColor(0.0, 1.0, 0.0);
+
+            ls->m_VtkTextAngleActors.push_back(ls->m_VtkTextActor);
+          }
         }
       }
-    }
 
-    if (pointDataIter != itkPointSet->GetPointData()->End())
-    {
-      pointDataIter++;
-      count++;
+      if (pointDataIter != itkPointSet->GetPointData()->End())
+      {
+        pointDataIter++;
+        count++;
+      }
     }
   }
 
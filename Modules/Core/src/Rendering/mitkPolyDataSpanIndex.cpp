@@ -0,0 +1,309 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPolyDataSpanIndex.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <vtkCellData.h>
+#include <vtkIdList.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  /** Normals closer to an axis (or to each other) are treated as parallel. */
+  constexpr double ParallelTolerance = 1e-9;
+
+  /** Cells spanning more buckets are not stored in the buckets but tested by every query. */
+  constexpr vtkIdType MaximumNumberOfBucketsPerCell = 16;
+
+  /** Normalizes the normal and flips it, so that its component with the largest magnitude is positive.
+   * A plane and its flipped version intersect the same cells, thus they share an index.*/
+  bool GetCanonicalNormal(const double normal[3], std::array<double, 3>& result)
+  {
+    const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+    if (length <= 0.0 || !std::isfinite(length))
+      return false;
+
+    int largestComponent = 0;
+
+    for (int d = 1; d < 3; ++d)
+    {
+      if (std::abs(normal[d]) > std::abs(normal[largestComponent]))
+        largestComponent = d;
+    }
+
+    const double factor = normal[largestComponent] < 0.0 ? -1.0 / length : 1.0 / length;
+
+    for (int d = 0; d < 3; ++d)
+      result[d] = normal[d] * factor;
+
+    return true;
+  }
+
+  double Dot(const std::array<double, 3>& a, const double b[3])
+  {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  }
+}
+
+mitk::PolyDataSpanIndex::PolyDataSpanIndex()
+  : m_InputMTime(0),
+    m_MaximumNumberOfDirections(4)
+{
+}
+
+mitk::PolyDataSpanIndex::~PolyDataSpanIndex()
+{
+}
+
+void mitk::PolyDataSpanIndex::SetInput(vtkPolyData* input)
+{
+  if (input == m_Input && (nullptr == input || input->GetMTime() == m_InputMTime))
+    return;
+
+  m_Input = input;
+  m_InputMTime = nullptr != input ? input->GetMTime() : 0;
+  m_DirectionIndices.clear();
+  this->Modified();
+}
+
+vtkPolyData* mitk::PolyDataSpanIndex::GetInput() const
+{
+  return m_Input;
+}
+
+vtkSmartPointer<vtkPolyData> mitk::PolyDataSpanIndex::ExtractCellsNearPlane(const double origin[3], const double normal[3])
+{
+  if (nullptr == m_Input)
+    mitkThrow() << "Cannot extract cells. No input poly data is set.";
+
+  // The input might have been modified in place since SetInput()
+  this->SetInput(m_Input);
+
+  std::array<double, 3> canonicalNormal;
+
+  if (!GetCanonicalNormal(normal, canonicalNormal))
+    mitkThrow() << "Cannot extract cells. The plane normal is invalid.";
+
+  const auto& index = this->GetDirectionIndex(canonicalNormal);
+  const double distance = Dot(canonicalNormal, origin);
+
+  std::vector<vtkIdType> cellIds;
+
+  auto testCell = [&index, &cellIds, distance](vtkIdType cellId) {
+    if (index.CellMinimum[cellId] <= distance && distance <= index.CellMaximum[cellId])
+      cellIds.push_back(cellId);
+  };
+
+  const auto numberOfBuckets = static_cast<vtkIdType>(index.BucketStart.size()) - 1;
+  const auto bucket = std::floor((distance - index.Origin) / index.BucketWidth);
+
+  if (bucket >= 0.0 && bucket < static_cast<double>(numberOfBuckets))
+  {
+    const auto bucketIndex = static_cast<vtkIdType>(bucket);
+
+    for (auto i = index.BucketStart[bucketIndex]; i < index.BucketStart[bucketIndex + 1]; ++i)
+      testCell(index.CellIds[i]);
+  }
+
+  for (auto cellId : index.LargeCells)
+    testCell(cellId);
+
+  // keep the order of the input cells
+  std::sort(cellIds.begin(), cellIds.end());
+
+  auto result = vtkSmartPointer<vtkPolyData>::New();
+  result->SetPoints(m_Input->GetPoints());
+  result->GetPointData()->ShallowCopy(m_Input->GetPointData());
+  result->AllocateEstimate(static_cast<vtkIdType>(cellIds.size()), 3);
+
+  auto inputCellData = m_Input->GetCellData();
+  auto cellData = result->GetCellData();
+  cellData->CopyAllocate(inputCellData, static_cast<vtkIdType>(cellIds.size()));
+
+  vtkNew<vtkIdList> pointIds;
+
+  for (auto cellId : cellIds)
+  {
+    m_Input->GetCellPoints(cellId, pointIds);
+    const auto newCellId = result->InsertNextCell(m_Input->GetCellType(cellId), pointIds);
+    cellData->CopyData(inputCellData, cellId, newCellId);
+  }
+
+  return result;
+}
+
+const mitk::PolyDataSpanIndex::DirectionIndex& mitk::PolyDataSpanIndex::GetDirectionIndex(const std::array<double, 3>& normal)
+{
+  auto finding = std::find_if(m_DirectionIndices.begin(), m_DirectionIndices.end(), [&normal](const DirectionIndex& index) {
+    return Dot(index.Normal, normal.data()) > 1.0 - ParallelTolerance;
+  });
+
+  if (finding != m_DirectionIndices.end())
+  {
+    m_DirectionIndices.splice(m_DirectionIndices.begin(), m_DirectionIndices, finding);
+  }
+  else
+  {
+    m_DirectionIndices.push_front(this->BuildDirectionIndex(normal));
+
+    while (m_DirectionIndices.size() > std::max(1u, m_MaximumNumberOfDirections))
+      m_DirectionIndices.pop_back();
+  }
+
+  return m_DirectionIndices.front();
+}
+
+mitk::PolyDataSpanIndex::DirectionIndex mitk::PolyDataSpanIndex::BuildDirectionIndex(const std::array<double, 3>& normal) const
+{
+  DirectionIndex index;
+  index.Normal = normal;
+
+  // Signed distances of all points along the normal. For axis-aligned normals this is the coordinate.
+  const auto numberOfPoints = m_Input->GetNumberOfPoints();
+  std::vector<double> distances(numberOfPoints);
+
+  int axis = -1;
+
+  for (int d = 0; d < 3; ++d)
+  {
+    if (normal[d] > 1.0 - ParallelTolerance)
+      axis = d;
+  }
+
+  if (auto points = m_Input->GetPoints(); nullptr != points)
+  {
+    double point[3];
+
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+      points->GetPoint(i, point);
+      distances[i] = axis >= 0 ? point[axis] : Dot(normal, point);
+    }
+  }
+
+  // Span of every cell
+  const auto numberOfCells = m_Input->GetNumberOfCells();
+  index.CellMinimum.assign(numberOfCells, std::numeric_limits<double>::max());
+  index.CellMaximum.assign(numberOfCells, std::numeric_limits<double>::lowest());
+
+  double minimum = std::numeric_limits<double>::max();
+  double maximum = std::numeric_limits<double>::lowest();
+  double sumOfSpans = 0.0;
+  vtkIdType numberOfValidCells = 0;
+
+  vtkNew<vtkIdList> pointIds;
+
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    m_Input->GetCellPoints(cellId, pointIds);
+    const auto numberOfCellPoints = pointIds->GetNumberOfIds();
+
+    if (0 == numberOfCellPoints)
+      continue;
+
+    double cellMinimum = std::numeric_limits<double>::max();
+    double cellMaximum = std::numeric_limits<double>::lowest();
+
+    for (vtkIdType i = 0; i < numberOfCellPoints; ++i)
+    {
+      const double distance = distances[pointIds->GetId(i)];
+      cellMinimum = std::min(cellMinimum, distance);
+      cellMaximum = std::max(cellMaximum, distance);
+    }
+
+    index.CellMinimum[cellId] = cellMinimum;
+    index.CellMaximum[cellId] = cellMaximum;
+
+    minimum = std::min(minimum, cellMinimum);
+    maximum = std::max(maximum, cellMaximum);
+    sumOfSpans += cellMaximum - cellMinimum;
+    ++numberOfValidCells;
+  }
+
+  if (0 == numberOfValidCells)
+  {
+    index.Origin = 0.0;
+    index.BucketWidth = 1.0;
+    index.BucketStart.assign(1, 0);
+    return index;
+  }
+
+  // The bucket width is the average span of the cells (but at most one bucket per cell), so that a bucket
+  // holds approximately twice as many cells as intersect a plane.
+  const double range = maximum - minimum;
+  index.Origin = minimum;
+  index.BucketWidth = std::max(sumOfSpans / numberOfValidCells, range / numberOfValidCells);
+
+  if (index.BucketWidth <= 0.0)
+    index.BucketWidth = 1.0; // all points lie in one plane perpendicular to the normal
+
+  const auto numberOfBuckets = static_cast<vtkIdType>(range / index.BucketWidth) + 1;
+
+  auto getBucket = [&index, numberOfBuckets](double distance) {
+    return std::min(numberOfBuckets - 1, static_cast<vtkIdType>(std::floor((distance - index.Origin) / index.BucketWidth)));
+  };
+
+  // Counting pass, then filling pass
+  index.BucketStart.assign(numberOfBuckets + 1, 0);
+
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    if (index.CellMinimum[cellId] > index.CellMaximum[cellId])
+      continue;
+
+    const auto first = getBucket(index.CellMinimum[cellId]);
+    const auto last = getBucket(index.CellMaximum[cellId]);
+
+    if (last - first + 1 > MaximumNumberOfBucketsPerCell)
+    {
+      index.LargeCells.push_back(cellId);
+      continue;
+    }
+
+    for (auto bucket = first; bucket <= last; ++bucket)
+      ++index.BucketStart[bucket + 1];
+  }
+
+  for (vtkIdType bucket = 0; bucket < numberOfBuckets; ++bucket)
+    index.BucketStart[bucket + 1] += index.BucketStart[bucket];
+
+  index.CellIds.resize(index.BucketStart.back());
+  auto insertPositions = index.BucketStart;
+  auto largeCell = index.LargeCells.begin();
+
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    if (index.CellMinimum[cellId] > index.CellMaximum[cellId])
+      continue;
+
+    if (largeCell != index.LargeCells.end() && *largeCell == cellId)
+    {
+      ++largeCell;
+      continue;
+    }
+
+    const auto last = getBucket(index.CellMaximum[cellId]);
+
+    for (auto bucket = getBucket(index.CellMinimum[cellId]); bucket <= last; ++bucket)
+      index.CellIds[insertPositions[bucket]++] = cellId;
+  }
+
+  return index;
+}
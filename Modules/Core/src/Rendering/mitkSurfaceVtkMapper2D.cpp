@@ -48,7 +48,9 @@ mitk::SurfaceVtkMapper2D::LocalStorage::LocalStorage()
   m_CuttingPlane = vtkSmartPointer<vtkPlane>::New();
   m_Cutter = vtkSmartPointer<vtkCutter>::New();
   m_Cutter->SetCutFunction(m_CuttingPlane);
-  m_Mapper->SetInputConnection(m_Cutter->GetOutputPort());
+  m_CutTransformFilter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
+  m_CutTransformFilter->SetInputConnection(m_Cutter->GetOutputPort());
+  m_Mapper->SetInputConnection(m_CutTransformFilter->GetOutputPort());
 
   m_NormalGlyph = vtkSmartPointer<vtkGlyph3D>::New();
 
@@ -100,6 +102,7 @@ const mitk::Surface *mitk::SurfaceVtkMapper2D::GetInput() const
 
 // constructor PointSetVtkMapper2D
 mitk::SurfaceVtkMapper2D::SurfaceVtkMapper2D()
+  : m_SpanIndex(PolyDataSpanIndex::New())
 {
 }
 
@@ -213,32 +216,38 @@ void mitk::SurfaceVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rende
   if (localStorage->m_Actor->GetMapper() == nullptr)
     localStorage->m_Actor->SetMapper(localStorage->m_Mapper);
 
+  // Cut the data in its own coordinates and transform only the cut according to the geometry of the data.
+  // See UpdateVtkTransform documentation for details.
+  vtkSmartPointer<vtkLinearTransform> vtktransform = GetDataNode()->GetVtkTransform(this->GetTimestep());
+  vtkLinearTransform *inverseTransform = vtktransform->GetLinearInverse();
+
   double origin[3];
   origin[0] = planeGeometry->GetOrigin()[0];
   origin[1] = planeGeometry->GetOrigin()[1];
   origin[2] = planeGeometry->GetOrigin()[2];
+  inverseTransform->TransformPoint(origin, origin);
 
   double normal[3];
   normal[0] = planeGeometry->GetNormal()[0];
   normal[1] = planeGeometry->GetNormal()[1];
   normal[2] = planeGeometry->GetNormal()[2];
+  inverseTransform->TransformNormal(normal, normal);
 
   localStorage->m_CuttingPlane->SetOrigin(origin);
   localStorage->m_CuttingPlane->SetNormal(normal);
-  // Transform the data according to its geometry.
-  // See UpdateVtkTransform documentation for details.
-  vtkSmartPointer<vtkLinearTransform> vtktransform = GetDataNode()->GetVtkTransform(this->GetTimestep());
-  vtkSmartPointer<vtkTransformPolyDataFilter> filter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-  filter->SetTransform(vtktransform);
-  filter->SetInputData(inputPolyData);
-  localStorage->m_Cutter->SetInputConnection(filter->GetOutputPort());
-  localStorage->m_Cutter->Update();
+
+  // Only the cells that may intersect the plane are passed to the cutter.
+  m_SpanIndex->SetInput(inputPolyData);
+  localStorage->m_Cutter->SetInputData(m_SpanIndex->ExtractCellsNearPlane(origin, normal));
+
+  localStorage->m_CutTransformFilter->SetTransform(vtktransform);
+  localStorage->m_CutTransformFilter->Update();
 
   bool generateNormals = false;
   node->GetBoolProperty("draw normals 2D", generateNormals);
   if (generateNormals)
   {
-    localStorage->m_NormalGlyph->SetInputConnection(localStorage->m_Cutter->GetOutputPort());
+    localStorage->m_NormalGlyph->SetInputConnection(localStorage->m_CutTransformFilter->GetOutputPort());
     localStorage->m_NormalGlyph->Update();
 
     localStorage->m_NormalMapper->SetInputConnection(localStorage->m_NormalGlyph->GetOutputPort());
@@ -255,7 +264,7 @@ void mitk::SurfaceVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rende
   node->GetBoolProperty("invert normals", generateInverseNormals);
   if (generateInverseNormals)
   {
-    localStorage->m_ReverseSense->SetInputConnection(localStorage->m_Cutter->GetOutputPort());
+    localStorage->m_ReverseSense->SetInputConnection(localStorage->m_CutTransformFilter->GetOutputPort());
     localStorage->m_ReverseSense->ReverseCellsOff();
     localStorage->m_ReverseSense->ReverseNormalsOn();
 
@@ -17,7 +17,10 @@ found in the LICENSE file.
 
 #include "mitkTestingMacros.h"
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 // Basedata Test
 #include <mitkGeometryData.h>
@@ -296,6 +299,58 @@ public:
                         "Testing if SetData cleared previous property list and set the default property list if data "
                         "of different type has been set")
   }
+
+  static void TestDataProvider()
+  {
+    mitk::Image::Pointer image = mitk::ImageGenerator::GenerateRandomImage<unsigned char>(3u, 3u);
+    std::atomic<int> calls(0);
+
+    mitk::DataNode::Pointer dataNode = mitk::DataNode::New();
+    dataNode->SetDataProvider([&calls, image]() {
+      ++calls;
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      return mitk::BaseData::Pointer(image.GetPointer());
+    });
+
+    MITK_TEST_CONDITION(!dataNode->IsDataLoaded() && dataNode->GetLoadedData().IsNull(),
+                        "Testing if the data provider is not called before the data is accessed")
+
+    std::vector<std::thread> threads;
+    std::vector<mitk::BaseData *> results(4, nullptr);
+    for (std::size_t i = 0; i < results.size(); ++i)
+      threads.emplace_back([&results, dataNode, i]() { results[i] = dataNode->GetData(); });
+    for (auto &thread : threads)
+      thread.join();
+
+    bool allResultsCorrect = true;
+    for (const auto result : results)
+      allResultsCorrect = allResultsCorrect && result == image.GetPointer();
+
+    MITK_TEST_CONDITION(1 == calls && allResultsCorrect,
+                        "Testing if concurrent accesses call the data provider once and all get its data")
+
+    dataNode->ReleaseData();
+    MITK_TEST_CONDITION(!dataNode->IsDataLoaded(), "Testing if ReleaseData() drops the data")
+    MITK_TEST_CONDITION(dataNode->GetData() == image.GetPointer() && 2 == calls,
+                        "Testing if the data provider recreates released data")
+
+    // A provider that releases the data of another node (like a memory budget does) or accesses
+    // its own node must neither deadlock nor corrupt the node.
+    mitk::DataNode::Pointer otherNode = mitk::DataNode::New();
+    otherNode->SetDataProvider([image]() { return mitk::BaseData::Pointer(image.GetPointer()); });
+    otherNode->GetData();
+
+    mitk::DataNode::Pointer reentrantNode = mitk::DataNode::New();
+    mitk::DataNode *rawReentrantNode = reentrantNode;
+    reentrantNode->SetDataProvider([otherNode, rawReentrantNode, image]() {
+      otherNode->ReleaseData();
+      rawReentrantNode->GetData();
+      return mitk::BaseData::Pointer(image.GetPointer());
+    });
+
+    MITK_TEST_CONDITION(reentrantNode->GetData() == image.GetPointer() && !otherNode->IsDataLoaded(),
+                        "Testing if a re-entrant data provider does not deadlock")
+  }
 }; // mitkDataNodeTestClass
 int mitkDataNodeTest(int /* argc */, char * /*argv*/ [])
 {
@@ -321,6 +376,7 @@ int mitkDataNodeTest(int /* argc */, char * /*argv*/ [])
   mitkDataNodeTestClass::TestSelected(myDataNode);
   mitkDataNodeTestClass::TestGetMTime(myDataNode);
   mitkDataNodeTestClass::TestSetDataUnderPropertyChange();
+  mitkDataNodeTestClass::TestDataProvider();
 
   // write your own tests here and use the macros from mitkTestingMacros.h !!!
   // do not write to std::cout and do not return from this function yourself!
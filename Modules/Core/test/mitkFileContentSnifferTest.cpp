@@ -0,0 +1,214 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkFileContentSniffer.h>
+
+#include <mitkCoreServices.h>
+#include <mitkFileReaderSelector.h>
+#include <mitkIMimeTypeProvider.h>
+#include <mitkIOUtil.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+
+class mitkFileContentSnifferTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkFileContentSnifferTestSuite);
+  MITK_TEST(TestPrefix);
+  MITK_TEST(TestDicomPreamble);
+  MITK_TEST(TestNonExistingPath);
+  MITK_TEST(TestCacheReuse);
+  MITK_TEST(TestCacheInvalidation);
+  MITK_TEST(TestMaximumCacheSize);
+  MITK_TEST(TestSharedValues);
+  MITK_TEST(TestDicomHeader);
+  MITK_TEST(TestDroppedFiles);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::vector<std::string> m_TempFiles;
+  std::size_t m_MaximumCacheSize;
+
+  std::string CreateFile(const std::string &content)
+  {
+    std::ofstream stream;
+    auto path = mitk::IOUtil::CreateTemporaryFile(stream, std::ios_base::binary, "sniffer-XXXXXX.dcm");
+    stream << content;
+    stream.close();
+
+    m_TempFiles.push_back(path);
+    return path;
+  }
+
+public:
+  void setUp() override
+  {
+    m_MaximumCacheSize = mitk::FileContentSniffer::GetMaximumCacheSize();
+    mitk::FileContentSniffer::ClearCache();
+  }
+
+  void tearDown() override
+  {
+    for (const auto &path : m_TempFiles)
+      itksys::SystemTools::RemoveFile(path);
+
+    m_TempFiles.clear();
+
+    mitk::FileContentSniffer::SetMaximumCacheSize(m_MaximumCacheSize);
+    mitk::FileContentSniffer::ClearCache();
+  }
+
+  void TestPrefix()
+  {
+    auto path = this->CreateFile("Hello");
+    auto content = mitk::FileContentSniffer::Sniff(path);
+
+    CPPUNIT_ASSERT(content->Exists());
+    CPPUNIT_ASSERT(!content->IsDirectory());
+    CPPUNIT_ASSERT_EQUAL(std::string("Hello"), content->GetPrefix());
+    CPPUNIT_ASSERT(!content->HasDicomPreamble());
+    CPPUNIT_ASSERT(!content->IsDicom());
+    CPPUNIT_ASSERT(content->GetDicomFilePath().empty());
+
+    auto longPath = this->CreateFile(std::string(2 * mitk::FileContentSniffer::PREFIX_SIZE, 'x'));
+    CPPUNIT_ASSERT_EQUAL(mitk::FileContentSniffer::PREFIX_SIZE, mitk::FileContentSniffer::Sniff(longPath)->GetPrefix().size());
+  }
+
+  void TestDicomPreamble()
+  {
+    auto path = this->CreateFile(std::string(128, '\0') + "DICM" + "rest of the header");
+    CPPUNIT_ASSERT(mitk::FileContentSniffer::Sniff(path)->HasDicomPreamble());
+
+    auto truncatedPath = this->CreateFile(std::string(128, '\0') + "DIC");
+    CPPUNIT_ASSERT(!mitk::FileContentSniffer::Sniff(truncatedPath)->HasDicomPreamble());
+  }
+
+  void TestNonExistingPath()
+  {
+    auto content = mitk::FileContentSniffer::Sniff(mitk::IOUtil::GetTempPath() + "/sniffer-does-not-exist.dcm");
+
+    CPPUNIT_ASSERT(nullptr != content);
+    CPPUNIT_ASSERT(!content->Exists());
+    CPPUNIT_ASSERT(content->GetPrefix().empty());
+    CPPUNIT_ASSERT(!content->IsDicom());
+  }
+
+  void TestCacheReuse()
+  {
+    auto path = this->CreateFile("Hello");
+
+    auto content = mitk::FileContentSniffer::Sniff(path);
+    CPPUNIT_ASSERT(content == mitk::FileContentSniffer::Sniff(path));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), mitk::FileContentSniffer::GetNumberOfSniffedPaths());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), mitk::FileContentSniffer::GetCacheSize());
+  }
+
+  void TestCacheInvalidation()
+  {
+    auto path = this->CreateFile("Hello");
+    auto content = mitk::FileContentSniffer::Sniff(path);
+
+    std::ofstream stream(path, std::ios_base::app);
+    stream << ", World";
+    stream.close();
+
+    auto newContent = mitk::FileContentSniffer::Sniff(path);
+    CPPUNIT_ASSERT(content != newContent);
+    CPPUNIT_ASSERT_EQUAL(std::string("Hello, World"), newContent->GetPrefix());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), mitk::FileContentSniffer::GetCacheSize());
+  }
+
+  void TestMaximumCacheSize()
+  {
+    mitk::FileContentSniffer::SetMaximumCacheSize(2);
+
+    auto path1 = this->CreateFile("1");
+    auto path2 = this->CreateFile("2");
+    auto path3 = this->CreateFile("3");
+
+    auto content1 = mitk::FileContentSniffer::Sniff(path1);
+    mitk::FileContentSniffer::Sniff(path2);
+    mitk::FileContentSniffer::Sniff(path1); // path2 is now least recently used
+    mitk::FileContentSniffer::Sniff(path3);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), mitk::FileContentSniffer::GetCacheSize());
+    CPPUNIT_ASSERT(content1 == mitk::FileContentSniffer::Sniff(path1));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), mitk::FileContentSniffer::GetNumberOfSniffedPaths());
+
+    mitk::FileContentSniffer::Sniff(path2);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), mitk::FileContentSniffer::GetNumberOfSniffedPaths());
+
+    mitk::FileContentSniffer::SetMaximumCacheSize(0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), mitk::FileContentSniffer::GetCacheSize());
+  }
+
+  void TestSharedValues()
+  {
+    auto path = this->CreateFile("Hello");
+    int numberOfComputations = 0;
+
+    auto compute = [&numberOfComputations]() {
+      ++numberOfComputations;
+      return std::string("value");
+    };
+
+    CPPUNIT_ASSERT_EQUAL(std::string("value"), mitk::FileContentSniffer::Sniff(path)->GetValue("Test.Key", compute));
+    CPPUNIT_ASSERT_EQUAL(std::string("value"), mitk::FileContentSniffer::Sniff(path)->GetValue("Test.Key", compute));
+    CPPUNIT_ASSERT_EQUAL(1, numberOfComputations);
+
+    mitk::FileContentSniffer::Sniff(path)->GetValue("Test.OtherKey", compute);
+    CPPUNIT_ASSERT_EQUAL(2, numberOfComputations);
+  }
+
+  void TestDicomHeader()
+  {
+    auto path = GetTestDataFilePath("UltrasoundImages/4D_TEE_Data_MV.dcm");
+    auto content = mitk::FileContentSniffer::Sniff(path);
+
+    CPPUNIT_ASSERT(content->IsDicom());
+    CPPUNIT_ASSERT_EQUAL(path, content->GetDicomFilePath());
+    CPPUNIT_ASSERT(content->CanReadDicomImage());
+    CPPUNIT_ASSERT(!content->GetDicomTagValue("0008|0060").empty());
+    CPPUNIT_ASSERT(content->GetDicomTagValue("ffff|ffff").empty());
+
+    auto directoryContent = mitk::FileContentSniffer::Sniff(itksys::SystemTools::GetFilenamePath(path));
+    CPPUNIT_ASSERT(directoryContent->IsDirectory());
+    CPPUNIT_ASSERT(directoryContent->IsDicom());
+  }
+
+  /** Dropping files on the application asks for the mime types of every file and later selects a
+   * reader for it, which asks all mime types again. Each file must be read only once nonetheless.*/
+  void TestDroppedFiles()
+  {
+    const std::size_t numberOfFiles = 20;
+    std::vector<std::string> paths;
+
+    for (std::size_t i = 0; i < numberOfFiles; ++i)
+      paths.push_back(this->CreateFile(std::string(128, '\0') + "DICM" + "not a valid header"));
+
+    mitk::CoreServicePointer<mitk::IMimeTypeProvider> mimeTypeProvider(mitk::CoreServices::GetMimeTypeProvider());
+
+    for (const auto &path : paths)
+    {
+      mimeTypeProvider->GetMimeTypesForFile(path);
+      mimeTypeProvider->GetMimeTypesForFile(path);
+      mitk::FileReaderSelector selector(path);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(numberOfFiles, mitk::FileContentSniffer::GetNumberOfSniffedPaths());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkFileContentSniffer)
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <mitkIOUtil.h>
 #include <mitkUtf8Util.h>
 #include <mitkImageGenerator.h>
+#include <mitkStandaloneDataStorage.h>
 #include <mitkIOMetaInformationPropertyConstants.h>
 #include <mitkVersion.h>
 
@@ -34,6 +35,7 @@ class mitkIOUtilTestSuite : public mitk::TestFixture
   MITK_TEST(TestNullSave);
   MITK_TEST(TestLoadAndSavePointSet);
   MITK_TEST(TestLoadAndSaveSurface);
+  MITK_TEST(TestConcurrentLoad);
   MITK_TEST(TestTempMethodsForUniqueFilenames);
   MITK_TEST(TestTempMethodsForUniqueFilenames);
   MITK_TEST(TestIOMetaInformation);
@@ -173,6 +175,41 @@ public:
     std::remove(imagePath3.c_str());
   }
 
+  void TestConcurrentLoad()
+  {
+    std::vector<mitk::IOUtil::LoadInfo> loadInfos = {
+      mitk::IOUtil::LoadInfo(m_ImagePath),
+      mitk::IOUtil::LoadInfo(m_SurfacePath),
+      mitk::IOUtil::LoadInfo(m_PointSetPath)
+    };
+
+    auto storage = mitk::StandaloneDataStorage::New();
+    auto nodes = mitk::IOUtil::Load(loadInfos, *storage, 3);
+
+    // the nodes are added in the order of the load infos, independent of the read order
+    CPPUNIT_ASSERT(nodes->Size() == 3);
+    CPPUNIT_ASSERT(dynamic_cast<mitk::Image *>(nodes->GetElement(0)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(dynamic_cast<mitk::Surface *>(nodes->GetElement(1)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(dynamic_cast<mitk::PointSet *>(nodes->GetElement(2)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(storage->GetAll()->Size() == 3);
+
+    for (const auto &loadInfo : loadInfos)
+    {
+      CPPUNIT_ASSERT_EQUAL(std::size_t(1), loadInfo.m_Output.size());
+      CPPUNIT_ASSERT(loadInfo.m_ReadDuration.count() >= 0);
+    }
+
+    // a file that cannot be read does not prevent the others from being loaded
+    std::vector<mitk::IOUtil::LoadInfo> loadInfosWithError = {
+      mitk::IOUtil::LoadInfo("fileWhichDoesNotExist.nrrd"),
+      mitk::IOUtil::LoadInfo(m_ImagePath)
+    };
+
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::Load(loadInfosWithError, 0), mitk::Exception);
+    CPPUNIT_ASSERT(loadInfosWithError[0].m_Output.empty());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), loadInfosWithError[1].m_Output.size());
+  }
+
   /**
   * \brief This method calls all available load methods with a nullpointer and an empty pathand expects an exception
   **/
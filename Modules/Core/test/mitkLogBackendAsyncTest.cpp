@@ -0,0 +1,337 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkLogBackendAsync.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+  /** Records all messages. Can be blocked to simulate a slow backend. */
+  class RecordingBackend : public mitk::LogBackendBase
+  {
+  public:
+    RecordingBackend()
+      : m_Blocked(false),
+        m_Entered(false)
+    {
+    }
+
+    void ProcessMessage(const mitk::LogMessage& message) override
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+
+      m_Entered = true;
+      m_Condition.notify_all();
+      m_Condition.wait(lock, [this]() { return !m_Blocked; });
+
+      m_Messages.push_back(message.Message);
+      m_Levels.push_back(message.Level);
+    }
+
+    OutputType GetOutputType() const override
+    {
+      return OutputType::File;
+    }
+
+    void Block()
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Blocked = true;
+      m_Entered = false;
+    }
+
+    void WaitUntilEntered()
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Condition.wait(lock, [this]() { return m_Entered; });
+    }
+
+    void Unblock()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Blocked = false;
+      }
+
+      m_Condition.notify_all();
+    }
+
+    std::vector<std::string> GetMessages()
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      return m_Messages;
+    }
+
+    std::vector<mitk::LogLevel> GetLevels()
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      return m_Levels;
+    }
+
+  private:
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    bool m_Blocked;
+    bool m_Entered;
+    std::vector<std::string> m_Messages;
+    std::vector<mitk::LogLevel> m_Levels;
+  };
+
+  mitk::LogMessage CreateMessage(mitk::LogLevel level, const std::string& text, int lineNumber = 1)
+  {
+    mitk::LogMessage message(level, "mitkLogBackendAsyncTest.cpp", lineNumber, "CreateMessage");
+    message.Message = text;
+    return message;
+  }
+
+  /** Logs a fatal message to the asynchronous backend while processing a message, i.e. on its writer thread. */
+  class FatalLoggingBackend : public RecordingBackend
+  {
+  public:
+    FatalLoggingBackend()
+      : m_AsyncBackend(nullptr)
+    {
+    }
+
+    void SetAsyncBackend(mitk::LogBackendAsync* asyncBackend)
+    {
+      m_AsyncBackend = asyncBackend;
+    }
+
+    void ProcessMessage(const mitk::LogMessage& message) override
+    {
+      RecordingBackend::ProcessMessage(message);
+
+      if (nullptr != m_AsyncBackend && mitk::LogLevel::Error == message.Level)
+      {
+        m_AsyncBackend->ProcessMessage(CreateMessage(mitk::LogLevel::Fatal, "fatal"));
+        m_AsyncBackend->Flush();
+      }
+    }
+
+  private:
+    mitk::LogBackendAsync* m_AsyncBackend;
+  };
+}
+
+class mitkLogBackendAsyncTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLogBackendAsyncTestSuite);
+  MITK_TEST(TestForwardingPreservesOrder);
+  MITK_TEST(TestOutputType);
+  MITK_TEST(TestRepetitionsAreAggregated);
+  MITK_TEST(TestFullQueueDropsMessages);
+  MITK_TEST(TestFatalMessagesAreWrittenSynchronously);
+  MITK_TEST(TestFatalMessageOnWriterThread);
+  MITK_TEST(TestStreamOutput);
+  MITK_TEST(TestConcurrentProducers);
+  MITK_TEST(TestDestructorDrainsQueue);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void TestForwardingPreservesOrder()
+  {
+    RecordingBackend backend;
+    mitk::LogBackendAsync asyncBackend(&backend);
+
+    for (int i = 0; i < 100; ++i)
+      asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Info, std::to_string(i)));
+
+    asyncBackend.Flush();
+
+    auto messages = backend.GetMessages();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(100), messages.size());
+
+    for (int i = 0; i < 100; ++i)
+      CPPUNIT_ASSERT_EQUAL(std::to_string(i), messages[i]);
+
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(100), asyncBackend.GetNumberOfMessages(mitk::LogLevel::Info));
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(100), asyncBackend.GetNumberOfWrittenMessages(mitk::LogLevel::Info));
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(0), asyncBackend.GetNumberOfDroppedMessages(mitk::LogLevel::Info));
+  }
+
+  void TestOutputType()
+  {
+    RecordingBackend backend;
+    CPPUNIT_ASSERT(mitk::LogBackendAsync(&backend).GetOutputType() == mitk::LogBackendBase::OutputType::File);
+    CPPUNIT_ASSERT(mitk::LogBackendAsync().GetOutputType() == mitk::LogBackendBase::OutputType::Console);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(128), mitk::LogBackendAsync(100).GetQueueCapacity());
+  }
+
+  void TestRepetitionsAreAggregated()
+  {
+    RecordingBackend backend;
+    mitk::LogBackendAsync asyncBackend(&backend);
+
+    // Block the writer to get all messages into a single batch
+    backend.Block();
+    asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Info, "first"));
+    backend.WaitUntilEntered();
+
+    for (int i = 0; i < 5; ++i)
+      asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Warn, "repeated"));
+
+    asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Warn, "repeated", 2)); // different location
+    asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Info, "last"));
+
+    backend.Unblock();
+    asyncBackend.Flush();
+
+    auto messages = backend.GetMessages();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), messages.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("first"), messages[0]);
+    CPPUNIT_ASSERT_EQUAL(std::string("repeated"), messages[1]);
+    CPPUNIT_ASSERT_EQUAL(std::string("Previous message repeated 4 time(s)"), messages[2]);
+    CPPUNIT_ASSERT_EQUAL(std::string("repeated"), messages[3]);
+    CPPUNIT_ASSERT_EQUAL(std::string("last"), messages[4]);
+
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(6), asyncBackend.GetNumberOfWrittenMessages(mitk::LogLevel::Warn));
+  }
+
+  void TestFullQueueDropsMessages()
+  {
+    RecordingBackend backend;
+    mitk::LogBackendAsync asyncBackend(&backend, 4);
+
+    backend.Block();
+    asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Info, "first"));
+    backend.WaitUntilEntered();
+
+    for (int i = 0; i < 10; ++i)
+      asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Debug, std::to_string(i)));
+
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(6), asyncBackend.GetNumberOfDroppedMessages(mitk::LogLevel::Debug));
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(10), asyncBackend.GetNumberOfMessages(mitk::LogLevel::Debug));
+
+    backend.Unblock();
+    asyncBackend.Flush();
+
+    auto messages = backend.GetMessages();
+    auto levels = backend.GetLevels();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(6), messages.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("3"), messages[4]);
+    CPPUNIT_ASSERT(levels.back() == mitk::LogLevel::Warn);
+    CPPUNIT_ASSERT(messages.back().find("6 log message(s) dropped") == 0);
+  }
+
+  void TestFatalMessagesAreWrittenSynchronously()
+  {
+    RecordingBackend backend;
+    mitk::LogBackendAsync asyncBackend(&backend);
+
+    asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Info, "info"));
+    asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Fatal, "fatal"));
+
+    auto messages = backend.GetMessages();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), messages.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("fatal"), messages[1]);
+  }
+
+  void TestFatalMessageOnWriterThread()
+  {
+    FatalLoggingBackend backend;
+    mitk::LogBackendAsync asyncBackend(&backend);
+    backend.SetAsyncBackend(&asyncBackend);
+
+    // Must neither deadlock nor defer the fatal message
+    asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Error, "error"));
+    asyncBackend.Flush();
+
+    auto messages = backend.GetMessages();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), messages.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("error"), messages[0]);
+    CPPUNIT_ASSERT_EQUAL(std::string("fatal"), messages[1]);
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(1), asyncBackend.GetNumberOfWrittenMessages(mitk::LogLevel::Fatal));
+  }
+
+  void TestStreamOutput()
+  {
+    std::ostringstream out;
+
+    {
+      mitk::LogBackendAsync asyncBackend(16, &out);
+      asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Info, "Hello"));
+      asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Error, "World"));
+      asyncBackend.Flush();
+
+      CPPUNIT_ASSERT_EQUAL(std::uint64_t(1), asyncBackend.GetNumberOfWrittenMessages(mitk::LogLevel::Error));
+    }
+
+    const auto output = out.str();
+    const auto hello = output.find("Hello");
+    const auto world = output.find("World");
+
+    CPPUNIT_ASSERT(hello != std::string::npos);
+    CPPUNIT_ASSERT(world != std::string::npos);
+    CPPUNIT_ASSERT(hello < world);
+  }
+
+  void TestConcurrentProducers()
+  {
+    const int numberOfThreads = 4;
+    const int numberOfMessagesPerThread = 1000;
+
+    RecordingBackend backend;
+    mitk::LogBackendAsync asyncBackend(&backend, numberOfThreads * numberOfMessagesPerThread);
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < numberOfThreads; ++t)
+    {
+      threads.emplace_back([&asyncBackend, t]() {
+        for (int i = 0; i < numberOfMessagesPerThread; ++i)
+          asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Info, std::to_string(t) + "/" + std::to_string(i)));
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    asyncBackend.Flush();
+
+    auto messages = backend.GetMessages();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(numberOfThreads * numberOfMessagesPerThread), messages.size());
+
+    // Messages of each thread keep their order
+    std::vector<int> next(numberOfThreads, 0);
+
+    for (const auto& message : messages)
+    {
+      const auto separator = message.find('/');
+      const auto t = std::stoi(message.substr(0, separator));
+      CPPUNIT_ASSERT_EQUAL(next[t]++, std::stoi(message.substr(separator + 1)));
+    }
+  }
+
+  void TestDestructorDrainsQueue()
+  {
+    RecordingBackend backend;
+
+    {
+      mitk::LogBackendAsync asyncBackend(&backend);
+
+      for (int i = 0; i < 10; ++i)
+        asyncBackend.ProcessMessage(CreateMessage(mitk::LogLevel::Info, std::to_string(i)));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), backend.GetMessages().size());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLogBackendAsync)
@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <mitkPointOperation.h>
 #include <mitkPointSet.h>
 
+#include <algorithm>
 #include <fstream>
 
 /**
@@ -41,6 +42,8 @@ class mitkPointSetTestSuite : public mitk::TestFixture
   MITK_TEST(TestRemovePointInterface);
   MITK_TEST(TestMaxIdAccess);
   MITK_TEST(TestInsertPointAtEnd);
+  MITK_TEST(TestSearchPointInLargePointSet);
+  MITK_TEST(TestSearchPointsInSlab);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -48,6 +51,28 @@ private:
   mitk::PointSet::Pointer pointSet;
   static const mitk::PointSet::PointIdentifier selectedPointId = 2;
 
+  /** Creates a point set with points at all integer coordinates of [0, size)^3, numbered along x first. */
+  static mitk::PointSet::Pointer CreateGridPointSet(int size)
+  {
+    auto gridPointSet = mitk::PointSet::New();
+    mitk::PointSet::PointIdentifier id = 0;
+
+    for (int z = 0; z < size; ++z)
+    {
+      for (int y = 0; y < size; ++y)
+      {
+        for (int x = 0; x < size; ++x)
+        {
+          mitk::Point3D point;
+          mitk::FillVector3D(point, x, y, z);
+          gridPointSet->InsertPoint(id++, point);
+        }
+      }
+    }
+
+    return gridPointSet;
+  }
+
 public:
   void setUp() override
   {
@@ -483,6 +508,66 @@ std::cout<<"[PASSED]"<<std::endl;
     pointSet->InsertPoint(in4, 7);
     MITK_ASSERT_EQUAL(pointSet, refPs4, "Check point insertion for time step 7.");
   }
+
+  void TestSearchPointInLargePointSet()
+  {
+    // large enough to be searched with a spatial index
+    auto gridPointSet = CreateGridPointSet(20);
+
+    mitk::Point3D point;
+    mitk::FillVector3D(point, 3.2, 4.1, 5.0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check nearest point.", 3 + 4 * 20 + 5 * 400, gridPointSet->SearchPoint(point, 0.5));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check distance limit.", -1, gridPointSet->SearchPoint(point, 0.2));
+
+    // equidistant to two points: the one with the smaller id is found
+    mitk::FillVector3D(point, 3.5, 4.0, 5.0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check tie.", 3 + 4 * 20 + 5 * 400, gridPointSet->SearchPoint(point, 1.0));
+
+    // move a point far away by an operation
+    const int movedId = 3 + 4 * 20 + 5 * 400;
+    mitk::Point3D farPoint;
+    mitk::FillVector3D(farPoint, 1000.0, -1000.0, 1000.0);
+    mitk::PointOperation moveOperation(mitk::OpMOVE, 0.0, farPoint, movedId);
+    gridPointSet->ExecuteOperation(&moveOperation);
+
+    mitk::FillVector3D(point, 3.0, 4.0, 5.0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check moved point at old position.", -1, gridPointSet->SearchPoint(point, 0.5));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check moved point at new position.", movedId, gridPointSet->SearchPoint(farPoint, 0.5));
+
+    // remove it
+    gridPointSet->RemovePointIfExists(movedId);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check removed point.", -1, gridPointSet->SearchPoint(farPoint, 0.5));
+
+    // insert a point directly into the container
+    gridPointSet->GetPointSet()->GetPoints()->InsertElement(10000, point);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check point inserted into the container.", 10000, gridPointSet->SearchPoint(point, 0.5));
+  }
+
+  void TestSearchPointsInSlab()
+  {
+    mitk::Vector3D normal;
+    mitk::FillVector3D(normal, 1.0, 1.0, 0.0);
+
+    // large (indexed) and small point set
+    for (int size : {20, 3})
+    {
+      auto gridPointSet = CreateGridPointSet(size);
+      auto ids = gridPointSet->SearchPointsInSlab(normal, 1.5, 2.5);
+
+      // x + y == 2
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Check number of points in slab.", std::size_t(3 * size), ids.size());
+      CPPUNIT_ASSERT_MESSAGE("Check order of points in slab.", std::is_sorted(ids.begin(), ids.end()));
+
+      for (auto id : ids)
+      {
+        auto point = gridPointSet->GetPoint(id);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, point[0] + point[1], mitk::eps);
+      }
+
+      CPPUNIT_ASSERT_MESSAGE("Check empty slab.", gridPointSet->SearchPointsInSlab(normal, 100.0, 200.0).empty());
+      CPPUNIT_ASSERT_MESSAGE("Check invalid time step.", gridPointSet->SearchPointsInSlab(normal, 1.5, 2.5, 1).empty());
+    }
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkPointSet)
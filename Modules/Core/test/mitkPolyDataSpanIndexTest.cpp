@@ -0,0 +1,138 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <mitkExceptionMacro.h>
+#include <mitkPolyDataSpanIndex.h>
+
+#include <vtkCutter.h>
+#include <vtkNew.h>
+#include <vtkPlane.h>
+#include <vtkSphereSource.h>
+
+class mitkPolyDataSpanIndexTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPolyDataSpanIndexTestSuite);
+  MITK_TEST(TestAxisAlignedPlanes);
+  MITK_TEST(TestObliquePlane);
+  MITK_TEST(TestPlaneOutsideOfData);
+  MITK_TEST(TestModifiedInput);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  vtkSmartPointer<vtkPolyData> m_Sphere;
+  mitk::PolyDataSpanIndex::Pointer m_SpanIndex;
+
+  static vtkIdType CountCutLines(vtkPolyData* polyData, const double origin[3], const double normal[3])
+  {
+    vtkNew<vtkPlane> plane;
+    plane->SetOrigin(origin[0], origin[1], origin[2]);
+    plane->SetNormal(normal[0], normal[1], normal[2]);
+
+    vtkNew<vtkCutter> cutter;
+    cutter->SetCutFunction(plane);
+    cutter->SetInputData(polyData);
+    cutter->Update();
+
+    return cutter->GetOutput()->GetNumberOfLines();
+  }
+
+  void CheckCut(const double origin[3], const double normal[3])
+  {
+    auto cells = m_SpanIndex->ExtractCellsNearPlane(origin, normal);
+
+    CPPUNIT_ASSERT(cells->GetNumberOfCells() > 0);
+    CPPUNIT_ASSERT(cells->GetNumberOfCells() < m_Sphere->GetNumberOfCells() / 4);
+    CPPUNIT_ASSERT_EQUAL(CountCutLines(m_Sphere, origin, normal), CountCutLines(cells, origin, normal));
+  }
+
+public:
+  void setUp() override
+  {
+    vtkNew<vtkSphereSource> sphereSource;
+    sphereSource->SetCenter(1.0, 2.0, 3.0);
+    sphereSource->SetRadius(10.0);
+    sphereSource->SetThetaResolution(64);
+    sphereSource->SetPhiResolution(64);
+    sphereSource->Update();
+
+    m_Sphere = sphereSource->GetOutput();
+    m_SpanIndex = mitk::PolyDataSpanIndex::New();
+    m_SpanIndex->SetInput(m_Sphere);
+  }
+
+  void tearDown() override
+  {
+    m_SpanIndex = nullptr;
+    m_Sphere = nullptr;
+  }
+
+  void TestAxisAlignedPlanes()
+  {
+    const double origin[3] = { 1.5, 2.5, 3.5 };
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      double normal[3] = { 0.0, 0.0, 0.0 };
+      normal[axis] = 1.0;
+      this->CheckCut(origin, normal);
+
+      // the flipped normal reuses the index of the same direction
+      normal[axis] = -1.0;
+      this->CheckCut(origin, normal);
+    }
+  }
+
+  void TestObliquePlane()
+  {
+    const double origin[3] = { 0.0, 0.0, 0.0 };
+    const double normal[3] = { 1.0, -2.0, 0.5 };
+
+    this->CheckCut(origin, normal);
+  }
+
+  void TestPlaneOutsideOfData()
+  {
+    const double origin[3] = { 0.0, 0.0, 20.0 };
+    const double normal[3] = { 0.0, 0.0, 1.0 };
+
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), m_SpanIndex->ExtractCellsNearPlane(origin, normal)->GetNumberOfCells());
+  }
+
+  void TestModifiedInput()
+  {
+    const double origin[3] = { 0.0, 0.0, 20.0 };
+    const double normal[3] = { 0.0, 0.0, 1.0 };
+
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), m_SpanIndex->ExtractCellsNearPlane(origin, normal)->GetNumberOfCells());
+
+    // move the sphere into the plane without replacing the input
+    auto points = m_Sphere->GetPoints();
+
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+      double point[3];
+      points->GetPoint(i, point);
+      points->SetPoint(i, point[0], point[1], point[2] + 20.0);
+    }
+
+    points->Modified();
+
+    this->CheckCut(origin, normal);
+
+    CPPUNIT_ASSERT_THROW(mitk::PolyDataSpanIndex::New()->ExtractCellsNearPlane(origin, normal), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPolyDataSpanIndex)
@@ -11,14 +11,45 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkProgressBar.h>
+#include <mitkProgressBarImplementation.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingConfig.h>
 #include <mitkTestingMacros.h>
 
+#include <thread>
+
+namespace
+{
+  class TestProgressBarImplementation : public mitk::ProgressBarImplementation
+  {
+  public:
+    void SetPercentageVisible(bool) override {}
+    void Reset() override {}
+
+    void AddStepsToDo(unsigned int steps) override
+    {
+      StepsToDo += steps;
+      IsCalledByOtherThread |= std::this_thread::get_id() != Thread;
+    }
+
+    void Progress(unsigned int steps) override
+    {
+      Steps += steps;
+      IsCalledByOtherThread |= std::this_thread::get_id() != Thread;
+    }
+
+    std::thread::id Thread = std::this_thread::get_id();
+    unsigned int StepsToDo = 0;
+    unsigned int Steps = 0;
+    bool IsCalledByOtherThread = false;
+  };
+}
+
 class mitkProgressBarTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkProgressBarTestSuite);
   MITK_TEST(TestInstantiation);
+  MITK_TEST(TestDeferProgressOfOtherThreads);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -27,6 +58,40 @@ public:
     mitk::ProgressBar::Pointer pb = mitk::ProgressBar::GetInstance();
     CPPUNIT_ASSERT_MESSAGE("Single instance can be created on demand", pb.IsNotNull());
   }
+
+  void TestDeferProgressOfOtherThreads()
+  {
+    TestProgressBarImplementation implementation;
+    auto *progressBar = mitk::ProgressBar::GetInstance();
+    progressBar->RegisterImplementationInstance(&implementation);
+
+    progressBar->DeferProgressOfOtherThreads();
+
+    std::thread worker([progressBar]() {
+      progressBar->AddStepsToDo(4);
+      progressBar->Progress(3);
+    });
+    worker.join();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Steps to do of other threads are deferred", 0u, implementation.StepsToDo);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Progress of other threads is deferred", 0u, implementation.Steps);
+
+    progressBar->Progress(1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Progress of the forwarding thread is not deferred", 1u, implementation.Steps);
+
+    progressBar->ForwardDeferredProgress();
+    CPPUNIT_ASSERT_EQUAL(4u, implementation.StepsToDo);
+    CPPUNIT_ASSERT_EQUAL(4u, implementation.Steps);
+    CPPUNIT_ASSERT_MESSAGE("Deferred calls are forwarded by the calling thread", !implementation.IsCalledByOtherThread);
+
+    progressBar->StopDeferringProgressOfOtherThreads();
+
+    std::thread otherWorker([progressBar]() { progressBar->Progress(1); });
+    otherWorker.join();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Progress is not deferred anymore", 5u, implementation.Steps);
+
+    progressBar->UnregisterImplementationInstance(&implementation);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkProgressBar)
@@ -152,6 +152,18 @@ public:
    */
   static const std::string& PROP_AUTOLOADED_MODULES();
 
+  /**
+   * Returns the property key with a value of \c module.lazy_activation for
+   * looking up the service interfaces which activate this module.
+   * The property value is a list of interface ids (strings) and is read from
+   * the module's manifest.json file. If the module is auto-loaded, calling
+   * the Load() method of its activator is deferred until a service reference
+   * for one of these interfaces is requested for the first time.
+   *
+   * @return The lazy activation property key.
+   */
+  static const std::string& PROP_LAZY_ACTIVATION();
+
   ~Module();
 
   /**
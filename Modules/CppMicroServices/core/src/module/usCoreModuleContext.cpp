@@ -26,6 +26,12 @@ US_MSVC_DISABLE_WARNING(4355)
 
 #include "usCoreModuleContext_p.h"
 
+#include "usModulePrivate.h"
+#include "usLog_p.h"
+
+#include <algorithm>
+#include <thread>
+
 US_BEGIN_NAMESPACE
 
 CoreModuleContext::CoreModuleContext()
@@ -50,4 +56,110 @@ void CoreModuleContext::Uninit()
   serviceHooks.Close();
 }
 
+void CoreModuleContext::DeferActivation(ModulePrivate* module)
+{
+  DeferredActivations::Lock l(deferredActivations);
+  module->deferredActivation = ModulePrivate::ACTIVATION_PENDING;
+  deferredActivations.modules.push_back(module);
+}
+
+bool CoreModuleContext::CancelDeferredActivation(ModulePrivate* module)
+{
+  DeferredActivations::Lock l(deferredActivations);
+  while (module->deferredActivation == ModulePrivate::ACTIVATION_RUNNING &&
+         module->activatingThread != std::this_thread::get_id())
+  {
+    deferredActivations.Wait();
+  }
+
+  if (module->deferredActivation != ModulePrivate::ACTIVATION_PENDING) return false;
+
+  module->deferredActivation = ModulePrivate::ACTIVATION_NONE;
+  std::vector<ModulePrivate*>& modules = deferredActivations.modules;
+  modules.erase(std::remove(modules.begin(), modules.end(), module), modules.end());
+  return true;
+}
+
+void CoreModuleContext::ActivateDeferred(const std::string& clazz)
+{
+  std::vector<ModulePrivate*> modules;
+  {
+    DeferredActivations::Lock l(deferredActivations);
+    if (deferredActivations.modules.empty()) return;
+
+    for (std::vector<ModulePrivate*>::const_iterator i = deferredActivations.modules.begin();
+         i != deferredActivations.modules.end(); ++i)
+    {
+      const std::vector<std::string>& classes = (*i)->lazyActivationClasses;
+      if ((*i)->deferredActivation == ModulePrivate::ACTIVATION_PENDING &&
+          (clazz.empty() || std::find(classes.begin(), classes.end(), clazz) != classes.end()))
+      {
+        // Claim the activation, concurrent lookups wait for it below
+        (*i)->deferredActivation = ModulePrivate::ACTIVATION_RUNNING;
+        (*i)->activatingThread = std::this_thread::get_id();
+        modules.push_back(*i);
+      }
+    }
+  }
+
+  // Activators register services and may look up services themselves,
+  // so they are called without holding the lock.
+  for (std::vector<ModulePrivate*>::const_iterator i = modules.begin(); i != modules.end(); ++i)
+  {
+    US_DEBUG << "Activating deferred module " << (*i)->info.name << " on lookup of "
+             << (clazz.empty() ? std::string("all services") : clazz);
+    try
+    {
+      (*i)->LoadActivator();
+    }
+    catch (...)
+    {
+      FinishDeferredActivation(*i);
+
+      // Leave the remaining modules to later lookups
+      DeferredActivations::Lock l(deferredActivations);
+      for (++i; i != modules.end(); ++i)
+      {
+        (*i)->deferredActivation = ModulePrivate::ACTIVATION_PENDING;
+      }
+      deferredActivations.NotifyAll();
+      throw;
+    }
+    FinishDeferredActivation(*i);
+  }
+
+  // Modules claimed by another thread have to be activated before the
+  // lookup can see their services.
+  DeferredActivations::Lock l(deferredActivations);
+  while (IsActivatedByOtherThread(clazz))
+  {
+    deferredActivations.Wait();
+  }
+}
+
+bool CoreModuleContext::IsActivatedByOtherThread(const std::string& clazz) const
+{
+  for (std::vector<ModulePrivate*>::const_iterator i = deferredActivations.modules.begin();
+       i != deferredActivations.modules.end(); ++i)
+  {
+    const std::vector<std::string>& classes = (*i)->lazyActivationClasses;
+    if ((*i)->deferredActivation == ModulePrivate::ACTIVATION_RUNNING &&
+        (*i)->activatingThread != std::this_thread::get_id() &&
+        (clazz.empty() || std::find(classes.begin(), classes.end(), clazz) != classes.end()))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void CoreModuleContext::FinishDeferredActivation(ModulePrivate* module)
+{
+  DeferredActivations::Lock l(deferredActivations);
+  module->deferredActivation = ModulePrivate::ACTIVATION_NONE;
+  std::vector<ModulePrivate*>& modules = deferredActivations.modules;
+  modules.erase(std::remove(modules.begin(), modules.end(), module), modules.end());
+  deferredActivations.NotifyAll();
+}
+
 US_END_NAMESPACE
@@ -27,9 +27,15 @@
 #include "usServiceRegistry_p.h"
 #include "usModuleHooks_p.h"
 #include "usServiceHooks_p.h"
+#include "usThreads_p.h"
+
+#include <string>
+#include <vector>
 
 US_BEGIN_NAMESPACE
 
+class ModulePrivate;
+
 /**
  * This class is not part of the public API.
  */
@@ -69,6 +75,44 @@ public:
 
   void Uninit();
 
+  /**
+   * Defers the activation of an auto-loaded module until a service
+   * reference for one of its lazy activation interfaces is requested.
+   */
+  void DeferActivation(ModulePrivate* module);
+
+  /**
+   * Removes a module which is stopped before it was activated. If another
+   * thread is activating the module, waits until the activation finished.
+   *
+   * @return true if the module was not activated
+   */
+  bool CancelDeferredActivation(ModulePrivate* module);
+
+  /**
+   * Activates the deferred modules providing the given interface, or all
+   * deferred modules if the interface is empty (e.g. filter-only lookups).
+   * Returns when these modules are activated, also if another thread
+   * activates them.
+   */
+  void ActivateDeferred(const std::string& clazz);
+
+private:
+
+  bool IsActivatedByOtherThread(const std::string& clazz) const;
+
+  void FinishDeferredActivation(ModulePrivate* module);
+
+  /**
+   * Auto-loaded modules whose activation is pending or running.
+   */
+  struct DeferredActivations : public MultiThreaded<MutexLockingStrategy, WaitCondition>
+  {
+    std::vector<ModulePrivate*> modules;
+  };
+
+  DeferredActivations deferredActivations;
+
 };
 
 US_END_NAMESPACE
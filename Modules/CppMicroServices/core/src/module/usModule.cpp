@@ -78,6 +78,12 @@ const std::string&Module::PROP_AUTOLOADED_MODULES()
   return s;
 }
 
+const std::string&Module::PROP_LAZY_ACTIVATION()
+{
+  static const std::string s("module.lazy_activation");
+  return s;
+}
+
 Module::Module()
 : d(nullptr)
 {
@@ -149,11 +155,22 @@ void Module::Start()
       throw;
     }
 
-    // This method should be "noexcept" and by not catching exceptions
-    // here we semantically treat it that way since any exception during
-    // static initialization will either terminate the program or cause
-    // the dynamic loader to report an error.
-    d->moduleActivator->Load(d->moduleContext);
+#ifdef US_ENABLE_AUTOLOADING_SUPPORT
+    if (!d->lazyActivationClasses.empty() && IsAutoLoading())
+    {
+      // Keep the activator out of the start-up path until one of the
+      // services it provides is looked up.
+      d->coreCtx->DeferActivation(d);
+    }
+    else
+#endif
+    {
+      // This method should be "noexcept" and by not catching exceptions
+      // here we semantically treat it that way since any exception during
+      // static initialization will either terminate the program or cause
+      // the dynamic loader to report an error.
+      d->LoadActivator();
+    }
   }
 
 #ifdef US_ENABLE_AUTOLOADING_SUPPORT
@@ -178,11 +195,14 @@ void Module::Stop()
     return;
   }
 
+  // A module whose activation is still deferred was never activated
+  const bool activated = !d->coreCtx->CancelDeferredActivation(d);
+
   try
   {
     d->coreCtx->listeners.ModuleChanged(ModuleEvent(ModuleEvent::UNLOADING, this));
 
-    if (d->moduleActivator)
+    if (d->moduleActivator && activated)
     {
       d->moduleActivator->Unload(d->moduleContext);
     }
@@ -33,6 +33,7 @@
 #include "usServiceReferenceBasePrivate.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
 #include <cassert>
 #include <cstring>
@@ -48,6 +49,7 @@ ModulePrivate::ModulePrivate(Module* qq, CoreModuleContext* coreCtx,
   , resourceContainer(info)
   , moduleContext(nullptr)
   , moduleActivator(nullptr)
+  , deferredActivation(ACTIVATION_NONE)
   , q(qq)
 {
   // Check if the module provides a manifest.json file and if yes, parse it.
@@ -108,6 +110,28 @@ ModulePrivate::ModulePrivate(Module* qq, CoreModuleContext* coreCtx,
     this->info.autoLoadDir = this->info.name;
     moduleManifest.SetValue(Module::PROP_AUTOLOAD_DIR(), Any(this->info.autoLoadDir));
   }
+
+  if (moduleManifest.Contains(Module::PROP_LAZY_ACTIVATION()))
+  {
+    Any lazyActivationAny = moduleManifest.GetValue(Module::PROP_LAZY_ACTIVATION());
+    if (lazyActivationAny.Type() == typeid(std::vector<Any>))
+    {
+      const std::vector<Any>& interfaceIds = ref_any_cast<std::vector<Any> >(lazyActivationAny);
+      for (std::vector<Any>::const_iterator i = interfaceIds.begin(); i != interfaceIds.end(); ++i)
+      {
+        if (i->Type() == typeid(std::string))
+        {
+          lazyActivationClasses.push_back(ref_any_cast<std::string>(*i));
+        }
+      }
+    }
+
+    if (lazyActivationClasses.empty())
+    {
+      US_WARN << "The Json value for " << Module::PROP_LAZY_ACTIVATION() << " for module "
+              << info->location << " must be a non-empty list of interface ids, ignoring it.";
+    }
+  }
 }
 
 ModulePrivate::~ModulePrivate()
@@ -115,6 +139,15 @@ ModulePrivate::~ModulePrivate()
   delete moduleContext;
 }
 
+void ModulePrivate::LoadActivator()
+{
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  moduleActivator->Load(moduleContext);
+  US_DEBUG << "Activated module " << info.name << " in "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()
+           << " ms";
+}
+
 void ModulePrivate::RemoveModuleResources()
 {
   coreCtx->listeners.RemoveAllListeners(moduleContext);
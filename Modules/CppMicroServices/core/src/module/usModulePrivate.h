@@ -24,6 +24,7 @@
 
 #include <map>
 #include <list>
+#include <thread>
 
 #include "usModuleRegistry.h"
 #include "usModuleVersion.h"
@@ -55,6 +56,11 @@ public:
 
   void RemoveModuleResources();
 
+  /**
+   * Calls the Load() method of the module activator.
+   */
+  void LoadActivator();
+
   CoreModuleContext* const coreCtx;
 
   /**
@@ -73,6 +79,25 @@ public:
 
   ModuleActivator* moduleActivator;
 
+  /**
+   * Service interface ids from the module.lazy_activation manifest property
+   */
+  std::vector<std::string> lazyActivationClasses;
+
+  enum DeferredActivationState
+  {
+    ACTIVATION_NONE,
+    ACTIVATION_PENDING,
+    ACTIVATION_RUNNING
+  };
+
+  /**
+   * State of a deferred activation of the auto-loaded module and the
+   * thread running it. Guarded by the deferred activations of coreCtx.
+   */
+  DeferredActivationState deferredActivation;
+  std::thread::id activatingThread;
+
   ModuleManifest moduleManifest;
 
   std::string baseStoragePath;
@@ -29,6 +29,7 @@
 #include <cstdio>
 #include <cctype>
 #include <algorithm>
+#include <chrono>
 #include <typeinfo>
 
 #ifdef US_PLATFORM_POSIX
@@ -51,6 +52,17 @@
 
 namespace {
 
+// Nesting depth of AutoLoadModules() calls in the current thread. Modules
+// are registered by static initializers while their library is loaded,
+// i.e. in the thread calling AutoLoadModules().
+thread_local int autoLoadDepth = 0;
+
+struct AutoLoadScope
+{
+  AutoLoadScope() { ++autoLoadDepth; }
+  ~AutoLoadScope() { --autoLoadDepth; }
+};
+
 #if !defined(US_PLATFORM_LINUX)
 std::string library_suffix()
 {
@@ -171,12 +183,17 @@ std::vector<std::string> AutoLoadModulesFromPath(const std::string& absoluteBase
       libPath += entryFileName;
       US_DEBUG << "Auto-loading module " << libPath;
 
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
       if (!load_impl(libPath))
       {
         US_WARN << "Auto-loading of module " << libPath << " failed.";
       }
       else
       {
+        // Includes the activators of modules which are not activated lazily
+        US_DEBUG << "Auto-loaded module " << libPath << " in "
+                 << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()
+                 << " ms";
         loadedModules.push_back(libPath);
       }
     }
@@ -213,6 +230,8 @@ std::vector<std::string> AutoLoadModules(const ModuleInfo& moduleInfo)
   // We could have introduced a duplicate above, so remove it.
   std::sort(autoLoadPaths.begin(), autoLoadPaths.end());
   autoLoadPaths.erase(std::unique(autoLoadPaths.begin(), autoLoadPaths.end()), autoLoadPaths.end());
+
+  AutoLoadScope autoLoadScope;
   for (ModuleSettings::PathList::iterator i = autoLoadPaths.begin();
        i != autoLoadPaths.end(); ++i)
   {
@@ -223,6 +242,11 @@ std::vector<std::string> AutoLoadModules(const ModuleInfo& moduleInfo)
   return loadedModules;
 }
 
+bool IsAutoLoading()
+{
+  return autoLoadDepth > 0;
+}
+
 US_END_NAMESPACE
 
 //-------------------------------------------------------------------
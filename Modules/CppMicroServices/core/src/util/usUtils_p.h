@@ -38,6 +38,12 @@ struct ModuleInfo;
 
 std::vector<std::string> AutoLoadModules(const ModuleInfo& moduleInfo);
 
+/**
+ * Returns true if the calling thread is loading modules in AutoLoadModules().
+ * Modules started in the meantime are auto-loaded modules.
+ */
+bool IsAutoLoading();
+
 US_END_NAMESPACE
 
 //-------------------------------------------------------------------
@@ -21,6 +21,7 @@
 
 #include <usModuleContext.h>
 #include <usModuleEvent.h>
+#include <usServiceEvent.h>
 #include <usGetModuleContext.h>
 #include <usModuleRegistry.h>
 #include <usModule.h>
@@ -34,6 +35,10 @@
 
 #include <cassert>
 
+#ifdef US_ENABLE_THREADING_SUPPORT
+#include <thread>
+#endif
+
 US_USE_NAMESPACE
 
 namespace {
@@ -44,6 +49,21 @@ namespace {
   static const std::string LIB_PATH = US_LIBRARY_OUTPUT_DIRECTORY;
 #endif
 
+struct TestServiceListener
+{
+  TestServiceListener() : registered(0) {}
+
+  void ServiceChanged(const ServiceEvent evt)
+  {
+    if (evt.GetType() == ServiceEvent::REGISTERED)
+    {
+      ++registered;
+    }
+  }
+
+  int registered;
+};
+
 void testDefaultAutoLoadPath(bool autoLoadEnabled)
 {
   ModuleContext* mc = GetModuleContext();
@@ -156,6 +176,55 @@ void testCustomAutoLoadPath()
   mc->RemoveModuleListener(&listener, &TestModuleListener::ModuleChanged);
 }
 
+void testLazyActivation()
+{
+  ModuleContext* mc = GetModuleContext();
+  assert(mc);
+  TestServiceListener listener;
+
+  mc->AddServiceListener(&listener, &TestServiceListener::ServiceChanged);
+
+  SharedLibrary libAL3(LIB_PATH, "TestModuleAL3");
+
+  try
+  {
+    libAL3.Load();
+  }
+  catch (const std::exception& e)
+  {
+    US_TEST_FAILED_MSG(<< "Load module exception: " << e.what())
+  }
+
+  Module* moduleAL3_1 = ModuleRegistry::GetModule("TestModuleAL3_1");
+  US_TEST_CONDITION_REQUIRED(moduleAL3_1 != nullptr, "Test for existing auto-loaded module TestModuleAL3_1")
+  US_TEST_CONDITION(moduleAL3_1->IsLoaded(), "Test if TestModuleAL3_1 is loaded")
+  US_TEST_CONDITION(listener.registered == 0, "Test for deferred activation of TestModuleAL3_1")
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+  // The activator of TestModuleAL3_1 takes a while, so the second lookup
+  // arrives while the first one is activating the module.
+  ServiceReferenceU refs[2];
+  std::thread lookups[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    lookups[i] = std::thread([mc, &refs, i]() { refs[i] = mc->GetServiceReference("us::TestModuleAL3_1Service"); });
+  }
+  for (int i = 0; i < 2; ++i)
+  {
+    lookups[i].join();
+  }
+  US_TEST_CONDITION(refs[0] && refs[1], "Test for service references of concurrent lookups activating TestModuleAL3_1")
+#else
+  ServiceReferenceU sr = mc->GetServiceReference("us::TestModuleAL3_1Service");
+  US_TEST_CONDITION(sr, "Test for service reference activating TestModuleAL3_1")
+#endif
+  US_TEST_CONDITION(listener.registered == 1, "Test for service registered by TestModuleAL3_1")
+
+  mc->RemoveServiceListener(&listener, &TestServiceListener::ServiceChanged);
+
+  libAL3.Unload();
+}
+
 } // end unnamed namespace
 
 
@@ -171,5 +240,7 @@ int usModuleAutoLoadTest(int /*argc*/, char* /*argv*/[])
 
   testCustomAutoLoadPath();
 
+  testLazyActivation();
+
   US_TEST_END()
 }
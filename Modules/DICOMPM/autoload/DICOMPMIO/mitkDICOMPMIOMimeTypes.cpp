@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkDICOMPMIOMimeTypes.h"
 #include "mitkIOMimeTypes.h"
 
+#include <mitkFileContentSniffer.h>
 #include <mitkLog.h>
 
 #include <itkGDCMImageIO.h>
@@ -21,6 +22,30 @@ found in the LICENSE file.
 #include <dcmtk/dcmdata/dcfilefo.h>
 #include <dcmtk/dcmdata/dcdeftag.h>
 
+namespace
+{
+  /** Checks the modality of the file with DCMTK. The dataset is only parsed up to the modality.
+   * Files without modality are accepted like before. The result is cached by the FileContentSniffer,
+   * so repeated checks of the same file (e.g. by the reader selection after a drop) do not load it again.*/
+  bool IsParametricMap(const std::string &path)
+  {
+    return "1" == mitk::FileContentSniffer::Sniff(path)->GetValue("DICOMPMIO.IsParametricMap", [&]()
+    {
+      DcmFileFormat dcmFileFormat;
+
+      if (dcmFileFormat.loadFileUntilTag(path.c_str(), EXS_Unknown, EGL_noChange, DCM_MaxReadLength,
+                                         ERM_autoDetect, DCM_Modality).bad())
+        return std::string("0");
+
+      OFString modality;
+      if (dcmFileFormat.getDataset()->findAndGetOFString(DCM_Modality, modality).good() && modality != "RWV")
+        return std::string("0");
+
+      return std::string("1");
+    });
+  }
+}
+
 namespace mitk
 {
   std::vector<CustomMimeType *> MitkDICOMPMIOMimeTypes::Get()
@@ -42,18 +67,10 @@ namespace mitk
 
   bool MitkDICOMPMIOMimeTypes::MitkDICOMPMMimeType::AppliesTo(const std::string &path) const
   {
-    std::ifstream myfile;
-    myfile.open(path, std::ios::binary);
-    //    myfile.seekg (128);
-    char *buffer = new char[128];
-    myfile.read(buffer, 128);
-    myfile.read(buffer, 4);
-    if (std::string(buffer).compare("DICM") != 0)
+    if (!FileContentSniffer::Sniff(path)->HasDicomPreamble())
     {
-      delete[] buffer;
       return false;
     }
-    delete[] buffer;
 
     bool canRead(CustomMimeType::AppliesTo(path));
 
@@ -66,33 +83,13 @@ namespace mitk
       return canRead;
     }
     // end fix for bug 18572
-    DcmFileFormat dcmFileFormat;
-    OFCondition status = dcmFileFormat.loadFile(path.c_str());
-
-    if (status.bad())
-    {
-      canRead = false;
-    }
 
     if (!canRead)
     {
       return canRead;
     }
 
-    OFString modality;
-    if (dcmFileFormat.getDataset()->findAndGetOFString(DCM_Modality, modality).good())
-    {
-      if (modality.compare("RWV") == 0)
-      {
-        canRead = true;
-      }
-      else
-      {
-        canRead = false;
-      }
-    }
-
-    return canRead;
+    return IsParametricMap(path);
   }
 
     MitkDICOMPMIOMimeTypes::MitkDICOMPMMimeType *MitkDICOMPMIOMimeTypes::MitkDICOMPMMimeType::Clone() const
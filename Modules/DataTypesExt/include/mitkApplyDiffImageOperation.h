@@ -80,6 +80,9 @@ namespace mitk
     Image *GetImage() { return m_Image; }
     Image::Pointer GetDiffImage();
 
+    /** \brief Returns the size in bytes of the compressed difference image.*/
+    std::size_t GetMemorySize() const override;
+
     bool IsImageStillValid() { return m_ImageStillValid; }
   };
 
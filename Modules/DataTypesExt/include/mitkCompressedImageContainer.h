@@ -33,6 +33,9 @@ namespace mitk
     void CompressImage(const Image* image);
     Image::Pointer DecompressImage() const;
 
+    /** \brief Returns the size in bytes of the compressed image data.*/
+    std::size_t GetCompressedSize() const;
+
   private:
     using CompressedSliceData = std::pair<int, char*>;
     using CompressedTimeStepData = std::vector<CompressedSliceData>;
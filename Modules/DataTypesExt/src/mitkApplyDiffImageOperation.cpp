@@ -62,3 +62,8 @@ mitk::Image::Pointer mitk::ApplyDiffImageOperation::GetDiffImage()
   // uncompress image to create a valid mitk::Image
   return m_CompressedImageContainer.DecompressImage();
 }
+
+std::size_t mitk::ApplyDiffImageOperation::GetMemorySize() const
+{
+  return m_CompressedImageContainer.GetCompressedSize();
+}
@@ -134,3 +134,16 @@ mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage() const
 
   return image;
 }
+
+std::size_t mitk::CompressedImageContainer::GetCompressedSize() const
+{
+  std::size_t size = 0;
+
+  for (const auto& timeStep : m_CompressedImageData)
+  {
+    for (const auto& slice : timeStep)
+      size += static_cast<std::size_t>(slice.first);
+  }
+
+  return size;
+}
@@ -1,3 +1,4 @@
 set(MODULE_TESTS
+  itkBilateralGridImageFilterTest.cpp
   itkTotalVariationDenoisingImageFilterTest.cpp
 )
@@ -0,0 +1,115 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "itkBilateralGridImageFilter.h"
+#include "itkBilateralImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkTimeProbe.h"
+
+// image typedefs
+typedef itk::Image<float, 3> ImageType;
+typedef itk::ImageRegionIterator<ImageType> IteratorType;
+
+/**
+* 32x32x32 test image: a sphere of intensity 200 on a background of 100, with
+* uniform noise of +-20
+*/
+ImageType::Pointer GenerateTestImage()
+{
+  ImageType::Pointer image = ImageType::New();
+  ImageType::SizeType size = {{32, 32, 32}};
+  image->SetRegions(size);
+  image->Allocate();
+
+  unsigned int seed = 1;
+  for (IteratorType it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    double distance = 0;
+    for (unsigned int i = 0; i < 3; i++)
+      distance += (it.GetIndex()[i] - 16.0) * (it.GetIndex()[i] - 16.0);
+
+    seed = seed * 1103515245 + 12345;
+    const float noise = static_cast<float>((seed >> 16) % 41) - 20.0f;
+    it.Set((distance < 100.0 ? 200.0f : 100.0f) + noise);
+  }
+
+  return image;
+}
+
+/**
+* Compares the bilateral grid approximation with the exact bilateral filter
+*/
+int itkBilateralGridImageFilterTest(int /*argc*/, char * /*argv*/ [])
+{
+  ImageType::Pointer image = GenerateTestImage();
+
+  try
+  {
+    itk::TimeProbe exactProbe;
+    typedef itk::BilateralImageFilter<ImageType, ImageType> BilateralFilterType;
+    BilateralFilterType::Pointer exactFilter = BilateralFilterType::New();
+    exactFilter->SetInput(image);
+    exactFilter->SetDomainSigma(2.0);
+    exactFilter->SetRangeSigma(50.0);
+    exactProbe.Start();
+    exactFilter->Update();
+    exactProbe.Stop();
+
+    itk::TimeProbe gridProbe;
+    typedef itk::BilateralGridImageFilter<ImageType, ImageType> BilateralGridFilterType;
+    BilateralGridFilterType::Pointer gridFilter = BilateralGridFilterType::New();
+    gridFilter->SetInput(image);
+    gridFilter->SetDomainSigma(2.0);
+    gridFilter->SetRangeSigma(50.0);
+    gridProbe.Start();
+    gridFilter->Update();
+    gridProbe.Stop();
+
+    // the approximation error has to be small compared to the smoothing
+    double error = 0;
+    double smoothing = 0;
+    IteratorType iit(image, image->GetLargestPossibleRegion());
+    IteratorType eit(exactFilter->GetOutput(), image->GetLargestPossibleRegion());
+    IteratorType git(gridFilter->GetOutput(), image->GetLargestPossibleRegion());
+    for (; !iit.IsAtEnd(); ++iit, ++eit, ++git)
+    {
+      error += fabs(git.Get() - eit.Get());
+      smoothing += fabs(eit.Get() - iit.Get());
+    }
+
+    std::cout << "Exact filter: " << exactProbe.GetTotal() << " s, bilateral grid: " << gridProbe.GetTotal()
+              << " s, mean absolute error: " << error / image->GetLargestPossibleRegion().GetNumberOfPixels()
+              << ", mean absolute smoothing: " << smoothing / image->GetLargestPossibleRegion().GetNumberOfPixels()
+              << std::endl;
+
+    if (error > 0.25 * smoothing)
+    {
+      return EXIT_FAILURE;
+    }
+
+    // the sphere is not blurred into the background
+    ImageType::IndexType inside = {{16, 16, 16}};
+    ImageType::IndexType outside = {{3, 3, 3}};
+    if (fabs(gridFilter->GetOutput()->GetPixel(inside) - 200.0) > 10.0 ||
+        fabs(gridFilter->GetOutput()->GetPixel(outside) - 100.0) > 10.0)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  catch (const itk::ExceptionObject& e)
+  {
+    e.Print(std::cerr);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -203,6 +203,67 @@ int itkTotalVariationDenoisingImageFilterTest(int /*argc*/, char * /*argv*/ [])
     return EXIT_FAILURE;
   }
 
+  try
+  {
+    // the denoising filter has to match repeated single iterations, also when
+    // the image is processed in several slabs
+    ImageType::Pointer noisyImage = ImageType::New();
+    ImageType::SizeType size = {{9, 7, 6}};
+    noisyImage->SetRegions(size);
+    noisyImage->Allocate();
+    unsigned int seed = 1;
+    for (IteratorType it(noisyImage, noisyImage->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      seed = seed * 1103515245 + 12345;
+      it.Set(static_cast<float>((seed >> 16) % 100));
+    }
+
+    typedef itk::TotalVariationSingleIterationImageFilter<ImageType, ImageType> SingleFilterType;
+    ImageType::Pointer reference = noisyImage;
+    for (int i = 0; i < 5; i++)
+    {
+      SingleFilterType::Pointer sFilter = SingleFilterType::New();
+      sFilter->SetInput(reference);
+      sFilter->SetOriginalImage(noisyImage);
+      sFilter->SetLambda(0.1);
+      sFilter->SetNumberOfWorkUnits(1);
+      sFilter->Update();
+      reference = sFilter->GetOutput();
+    }
+
+    typedef itk::TotalVariationDenoisingImageFilter<ImageType, ImageType> TVFilterType;
+    TVFilterType::Pointer tvFilter = TVFilterType::New();
+    tvFilter->SetInput(noisyImage);
+    tvFilter->SetNumberIterations(5);
+    tvFilter->SetNumberOfWorkUnits(4);
+    tvFilter->SetLambda(0.1);
+    tvFilter->Update();
+
+    IteratorType rit(reference, reference->GetLargestPossibleRegion());
+    IteratorType oit(tvFilter->GetOutput(), reference->GetLargestPossibleRegion());
+    for (; !rit.IsAtEnd(); ++rit, ++oit)
+    {
+      if (fabs(rit.Get() - oit.Get()) > precision)
+      {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // early stopping
+    tvFilter->SetNumberIterations(1000);
+    tvFilter->SetConvergenceTolerance(1e-3);
+    tvFilter->Update();
+    if (tvFilter->GetElapsedIterations() <= 5 || tvFilter->GetElapsedIterations() >= 1000)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  catch (const itk::ExceptionObject& e)
+  {
+    e.Print(std::cerr);
+    return EXIT_FAILURE;
+  }
+
   VectorImageType::Pointer vecImage = GenerateVectorTestImage();
   PrintVectorImage(vecImage);
 
@@ -0,0 +1,109 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkBilateralGridImageFilter_h
+#define __itkBilateralGridImageFilter_h
+
+#include "itkImage.h"
+#include "itkImageToImageFilter.h"
+
+#include <vector>
+
+namespace itk
+{
+  /** \class BilateralGridImageFilter
+   * \brief Approximates a bilateral filter by Gaussian smoothing in a bilateral grid
+   *
+   * The pixels are accumulated ("splatted") into a coarse grid spanned by the image
+   * dimensions and the intensity range, sampled at DomainSigma and RangeSigma. The grid is
+   * smoothed by a separable binomial kernel with a standard deviation of one cell and the
+   * output is interpolated ("sliced") from it. The cost is linear in the number of pixels
+   * plus the number of grid cells and, unlike the kernel of BilateralImageFilter, shrinks
+   * with a growing DomainSigma.
+   *
+   * The grid is processed plane by plane along the outermost image dimension, so only a
+   * few grid planes are kept in memory at a time.
+   *
+   * Reference: Jiawen Chen et al., Real-time edge-aware image processing with the bilateral grid
+   *
+   * \sa BilateralImageFilter
+   *
+   * \ingroup IntensityImageFilters
+   */
+  template <class TInputImage, class TOutputImage>
+  class BilateralGridImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+  {
+  public:
+    /** Extract dimension from input and output image. */
+    itkStaticConstMacro(InputImageDimension, unsigned int, TInputImage::ImageDimension);
+    itkStaticConstMacro(OutputImageDimension, unsigned int, TOutputImage::ImageDimension);
+
+    /** Convenient typedefs for simplifying declarations. */
+    typedef TInputImage InputImageType;
+    typedef TOutputImage OutputImageType;
+
+    /** Standard class typedefs. */
+    typedef BilateralGridImageFilter Self;
+    typedef ImageToImageFilter<InputImageType, OutputImageType> Superclass;
+    typedef SmartPointer<Self> Pointer;
+    typedef SmartPointer<const Self> ConstPointer;
+
+    /** Method for creation through the object factory. */
+    itkFactorylessNewMacro(Self);
+    itkCloneMacro(Self);
+
+    /** Run-time type information (and related methods). */
+    itkTypeMacro(BilateralGridImageFilter, ImageToImageFilter);
+
+    /** Image typedef support. */
+    typedef typename InputImageType::PixelType InputPixelType;
+    typedef typename OutputImageType::PixelType OutputPixelType;
+
+    typedef typename InputImageType::RegionType InputImageRegionType;
+    typedef typename OutputImageType::RegionType OutputImageRegionType;
+
+    /** Sigma of the spatial Gaussian, in physical units (see BilateralImageFilter). */
+    itkSetMacro(DomainSigma, double);
+    itkGetMacro(DomainSigma, double);
+
+    /** Sigma of the intensity Gaussian (see BilateralImageFilter). */
+    itkSetMacro(RangeSigma, double);
+    itkGetMacro(RangeSigma, double);
+
+    /** The whole image is smoothed, so the whole input is required. */
+    void GenerateInputRequestedRegion() override;
+
+  protected:
+    BilateralGridImageFilter();
+    ~BilateralGridImageFilter() override {}
+    void PrintSelf(std::ostream &os, Indent indent) const override;
+
+    void EnlargeOutputRequestedRegion(DataObject *output) override;
+
+    void GenerateData() override;
+
+    double m_DomainSigma;
+
+    double m_RangeSigma;
+
+  private:
+    BilateralGridImageFilter(const Self &); // purposely not implemented
+    void operator=(const Self &);           // purposely not implemented
+  };
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBilateralGridImageFilter.txx"
+#endif
+
+#endif //__itkBilateralGridImageFilter_h
@@ -0,0 +1,331 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef _itkBilateralGridImageFilter_txx
+#define _itkBilateralGridImageFilter_txx
+#include "itkBilateralGridImageFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace itk
+{
+  template <class TInputImage, class TOutputImage>
+  BilateralGridImageFilter<TInputImage, TOutputImage>::BilateralGridImageFilter()
+    : m_DomainSigma(4.0), m_RangeSigma(50.0)
+  {
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void BilateralGridImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+  {
+    Superclass::GenerateInputRequestedRegion();
+
+    auto *input = const_cast<InputImageType *>(this->GetInput());
+
+    if (input != nullptr)
+      input->SetRequestedRegionToLargestPossibleRegion();
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void BilateralGridImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject *output)
+  {
+    Superclass::EnlargeOutputRequestedRegion(output);
+    output->SetRequestedRegionToLargestPossibleRegion();
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void BilateralGridImageFilter<TInputImage, TOutputImage>::GenerateData()
+  {
+    if (m_DomainSigma <= 0.0 || m_RangeSigma <= 0.0)
+    {
+      itkExceptionMacro(<< "DomainSigma and RangeSigma must be positive.");
+    }
+
+    this->AllocateOutputs();
+
+    const InputImageType *input = this->GetInput();
+    OutputImageType *output = this->GetOutput();
+
+    const unsigned int dimension = InputImageDimension;
+    const unsigned int axis = dimension - 1; // the grid is processed plane by plane along this dimension
+    const typename InputImageType::SizeType size = input->GetBufferedRegion().GetSize();
+    const typename InputImageType::SpacingType spacing = input->GetSpacing();
+    const InputPixelType *inputBuffer = input->GetBufferPointer();
+    OutputPixelType *outputBuffer = output->GetBufferPointer();
+
+    const SizeValueType numberOfPixels = input->GetBufferedRegion().GetNumberOfPixels();
+    if (numberOfPixels == 0)
+      return;
+
+    const auto minmax = std::minmax_element(inputBuffer, inputBuffer + numberOfPixels);
+    const double minimum = *minmax.first;
+    const double maximum = *minmax.second;
+
+    // The grid has a cell per sigma plus a padding of the blur radius on each
+    // side. Each cell holds the sum of the splatted values and their count.
+    const int padding = 2;
+    const double kernel[5] = {1.0 / 16, 4.0 / 16, 6.0 / 16, 4.0 / 16, 1.0 / 16};
+
+    double cellsPerPixel[InputImageDimension];
+    SizeValueType gridSize[InputImageDimension];
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      cellsPerPixel[d] = spacing[d] / m_DomainSigma;
+      gridSize[d] = static_cast<SizeValueType>((size[d] - 1) * cellsPerPixel[d]) + 1 + 2 * padding;
+    }
+    const double cellsPerIntensity = 1.0 / m_RangeSigma;
+    const SizeValueType rangeSize =
+      static_cast<SizeValueType>((maximum - minimum) * cellsPerIntensity) + 1 + 2 * padding;
+
+    // The intensity is the innermost dimension of a grid plane, followed by the
+    // image dimensions but the last one.
+    SizeValueType planeStrides[InputImageDimension];
+    SizeValueType planeSize = rangeSize;
+    for (unsigned int d = 0; d < axis; ++d)
+    {
+      planeStrides[d] = planeSize;
+      planeSize *= gridSize[d];
+    }
+
+    const SizeValueType rowLength = axis > 0 ? size[0] : 1;
+    const SizeValueType pixelsPerPlane = numberOfPixels / size[axis];
+
+    // Cell offsets of the image coordinates within a grid plane; nearest cell for
+    // splatting, lower cell and the weight of the upper one for slicing.
+    std::vector<std::vector<SizeValueType>> nearestCell(dimension);
+    std::vector<std::vector<SizeValueType>> lowerCell(dimension);
+    std::vector<std::vector<double>> upperWeight(dimension);
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      const SizeValueType stride = d < axis ? planeStrides[d] : 1;
+      for (SizeValueType i = 0; i < size[d]; ++i)
+      {
+        const double coordinate = i * cellsPerPixel[d] + padding;
+        const double lower = std::floor(coordinate);
+        nearestCell[d].push_back(static_cast<SizeValueType>(coordinate + 0.5) * stride);
+        lowerCell[d].push_back(static_cast<SizeValueType>(lower) * stride);
+        upperWeight[d].push_back(coordinate - lower);
+      }
+    }
+
+    // Calls f(pixelOffset, index) for the first pixel of each row in the given image plane.
+    auto forEachRow = [&](SizeValueType plane, auto f) {
+      typename InputImageType::IndexType index;
+      index.Fill(0);
+
+      while (true)
+      {
+        SizeValueType pixelOffset = plane * pixelsPerPlane;
+        SizeValueType stride = rowLength;
+        for (unsigned int d = 1; d < axis; ++d)
+        {
+          pixelOffset += index[d] * stride;
+          stride *= size[d];
+        }
+
+        f(pixelOffset, index);
+
+        unsigned int d = 1;
+        for (; d < axis; ++d)
+        {
+          if (static_cast<SizeValueType>(++index[d]) < size[d])
+            break;
+          index[d] = 0;
+        }
+        if (d >= axis)
+          break;
+      }
+    };
+
+    auto splat = [&](SizeValueType plane, float *grid) {
+      forEachRow(plane, [&](SizeValueType pixelOffset, const typename InputImageType::IndexType &index) {
+        SizeValueType rowCell = 0;
+        for (unsigned int d = 1; d < axis; ++d)
+          rowCell += nearestCell[d][index[d]];
+
+        const InputPixelType *pixel = inputBuffer + pixelOffset;
+        for (SizeValueType x = 0; x < rowLength; ++x)
+        {
+          const double value = pixel[x];
+          SizeValueType cell = rowCell + static_cast<SizeValueType>((value - minimum) * cellsPerIntensity + padding + 0.5);
+          if (axis > 0)
+            cell += nearestCell[0][x];
+
+          grid[2 * cell] += static_cast<float>(value);
+          grid[2 * cell + 1] += 1.0f;
+        }
+      });
+    };
+
+    // Blurs a grid plane along all of its dimensions. Along each dimension, the
+    // plane consists of blocks of length x stride cells, which are blurred
+    // across whole lines of stride cells at once.
+    std::vector<float> block;
+    auto blurPlane = [&](float *grid) {
+      for (unsigned int d = 0; d <= axis; ++d)
+      {
+        const SizeValueType length = d < axis ? gridSize[d] : rangeSize;
+        const SizeValueType line = 2 * (d < axis ? planeStrides[d] : 1);
+        block.resize(length * line);
+
+        for (float *begin = grid; begin != grid + 2 * planeSize; begin += length * line)
+        {
+          std::copy(begin, begin + length * line, block.begin());
+
+          for (SizeValueType i = 0; i < length; ++i)
+          {
+            float *target = begin + i * line;
+            std::fill(target, target + line, 0.0f);
+
+            for (int k = -padding; k <= padding; ++k)
+            {
+              if (static_cast<IndexValueType>(i) + k < 0 || i + k >= length)
+                continue;
+
+              const float *source = block.data() + (i + k) * line;
+              const float weight = static_cast<float>(kernel[k + padding]);
+              for (SizeValueType j = 0; j < line; ++j)
+                target[j] += weight * source[j];
+            }
+          }
+        }
+      }
+    };
+
+    auto slice = [&](SizeValueType plane, const float *lowerGrid, const float *upperGrid) {
+      const double planeWeight = upperWeight[axis][plane];
+      std::vector<std::pair<SizeValueType, double>> corners;
+
+      forEachRow(plane, [&](SizeValueType pixelOffset, const typename InputImageType::IndexType &index) {
+        // corners and weights of the row dimensions; the first one varies along the row
+        corners.assign(1, std::make_pair(SizeValueType(0), 1.0));
+        for (unsigned int d = 1; d < axis; ++d)
+        {
+          const SizeValueType cell = lowerCell[d][index[d]];
+          const double weight = upperWeight[d][index[d]];
+          const SizeValueType numberOfCorners = corners.size();
+          for (SizeValueType c = 0; c < numberOfCorners; ++c)
+          {
+            corners.push_back(std::make_pair(corners[c].first + cell + planeStrides[d], corners[c].second * weight));
+            corners[c].first += cell;
+            corners[c].second *= 1.0 - weight;
+          }
+        }
+
+        const InputPixelType *pixel = inputBuffer + pixelOffset;
+        OutputPixelType *out = outputBuffer + pixelOffset;
+        for (SizeValueType x = 0; x < rowLength; ++x)
+        {
+          const double value = pixel[x];
+          const double range = (value - minimum) * cellsPerIntensity + padding;
+          const double rangeLower = std::floor(range);
+          const double rangeWeight = range - rangeLower;
+
+          SizeValueType cell = static_cast<SizeValueType>(rangeLower);
+          double xWeight = 0.0;
+          if (axis > 0)
+          {
+            cell += lowerCell[0][x];
+            xWeight = upperWeight[0][x];
+          }
+
+          double sum = 0.0;
+          double count = 0.0;
+          for (const auto &corner : corners)
+          {
+            for (int dx = 0; dx < 2; ++dx)
+            {
+              const double weight = corner.second * (dx ? xWeight : 1.0 - xWeight);
+              if (weight == 0.0)
+                continue;
+
+              const SizeValueType xCell = cell + corner.first + (dx ? planeStrides[0] : 0);
+
+              for (int r = 0; r < 2; ++r)
+              {
+                const SizeValueType c = 2 * (xCell + r);
+                const double w = weight * (r ? rangeWeight : 1.0 - rangeWeight);
+                sum += w * ((1.0 - planeWeight) * lowerGrid[c] + planeWeight * upperGrid[c]);
+                count += w * ((1.0 - planeWeight) * lowerGrid[c + 1] + planeWeight * upperGrid[c + 1]);
+              }
+            }
+          }
+
+          out[x] = static_cast<OutputPixelType>(count > 0.0 ? sum / count : value);
+        }
+      });
+    };
+
+    // Stream through the grid planes: splat and blur grid plane k within the
+    // plane, blur grid plane k - padding across the planes, then slice all
+    // image planes lying in between the last two blurred grid planes.
+    const SizeValueType numberOfGridPlanes = gridSize[axis];
+    std::vector<std::vector<float>> splatted(2 * padding + 1, std::vector<float>(2 * planeSize));
+    std::vector<std::vector<float>> blurred(2, std::vector<float>(2 * planeSize));
+
+    SizeValueType nextSplatPlane = 0;
+    SizeValueType nextSlicePlane = 0;
+
+    for (SizeValueType k = 0; k < numberOfGridPlanes + padding; ++k)
+    {
+      if (k < numberOfGridPlanes)
+      {
+        float *grid = splatted[k % splatted.size()].data();
+        std::fill(grid, grid + 2 * planeSize, 0.0f);
+
+        for (; nextSplatPlane < size[axis] && nearestCell[axis][nextSplatPlane] == k; ++nextSplatPlane)
+          splat(nextSplatPlane, grid);
+
+        blurPlane(grid);
+      }
+
+      if (k < static_cast<SizeValueType>(padding))
+        continue;
+
+      const SizeValueType j = k - padding;
+      float *grid = blurred[j % 2].data();
+      std::fill(grid, grid + 2 * planeSize, 0.0f);
+
+      for (int m = -padding; m <= padding; ++m)
+      {
+        if (static_cast<IndexValueType>(j) + m < 0 || j + m >= numberOfGridPlanes)
+          continue;
+
+        const float *source = splatted[(j + m) % splatted.size()].data();
+        const float weight = static_cast<float>(kernel[m + padding]);
+        for (SizeValueType i = 0; i < 2 * planeSize; ++i)
+          grid[i] += weight * source[i];
+      }
+
+      for (; nextSlicePlane < size[axis] && lowerCell[axis][nextSlicePlane] + 1 == j; ++nextSlicePlane)
+        slice(nextSlicePlane, blurred[(j - 1) % 2].data(), grid);
+
+      this->UpdateProgress(static_cast<float>(nextSlicePlane) / size[axis]);
+    }
+  }
+
+  /**
+  * Standard "PrintSelf" method
+  */
+  template <class TInputImage, class TOutput>
+  void BilateralGridImageFilter<TInputImage, TOutput>::PrintSelf(std::ostream &os, Indent indent) const
+  {
+    Superclass::PrintSelf(os, indent);
+    os << indent << "DomainSigma: " << m_DomainSigma << std::endl;
+    os << indent << "RangeSigma: " << m_RangeSigma << std::endl;
+  }
+
+} // end namespace itk
+
+#endif
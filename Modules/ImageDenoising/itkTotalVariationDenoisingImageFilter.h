@@ -25,6 +25,15 @@ namespace itk
    *
    * Reference: Tony F. Chan et al., The digital TV filter and nonlinear denoising
    *
+   * Each iteration is one sweep of TotalVariationSingleIterationImageFilter, but the
+   * iterations alternate between two image buffers instead of allocating new images.
+   * The image is processed in slabs along its outermost non-trivial dimension, and the
+   * local variation is computed plane by plane ahead of the update, so that it is kept
+   * in three rolling planes per slab instead of an image of its own.
+   *
+   * If a convergence tolerance is set, the iterations stop early as soon as the
+   * relative change ||u_new - u|| / ||u|| of an iteration falls below it.
+   *
    * \sa Image
    * \sa Neighborhood
    * \sa NeighborhoodOperator
@@ -76,17 +85,40 @@ namespace itk
     itkSetMacro(NumberIterations, int);
     itkGetMacro(NumberIterations, int);
 
+    /** Relative change between two iterations below which the filter stops
+     * before reaching the number of iterations. Zero (the default) disables early stopping. */
+    itkSetMacro(ConvergenceTolerance, double);
+    itkGetMacro(ConvergenceTolerance, double);
+
+    /** Number of iterations actually performed by the last update. */
+    itkGetConstMacro(ElapsedIterations, int);
+
+    /** The whole image is denoised, so the whole input is required. */
+    void GenerateInputRequestedRegion() override;
+
   protected:
     TotalVariationDenoisingImageFilter();
     ~TotalVariationDenoisingImageFilter() override {}
     void PrintSelf(std::ostream &os, Indent indent) const override;
 
+    void EnlargeOutputRequestedRegion(DataObject *output) override;
+
     void GenerateData() override;
 
+    /** Computes one iteration from source into target and returns the relative change. */
+    double Iterate(const OutputImageType *image,
+                   const OutputPixelType *original,
+                   const OutputPixelType *source,
+                   OutputPixelType *target);
+
     double m_Lambda;
 
     int m_NumberIterations;
 
+    double m_ConvergenceTolerance;
+
+    int m_ElapsedIterations;
+
   private:
     TotalVariationDenoisingImageFilter(const Self &); // purposely not implemented
     void operator=(const Self &);                     // purposely not implemented
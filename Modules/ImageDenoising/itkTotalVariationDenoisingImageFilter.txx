@@ -19,76 +19,299 @@ This file is based heavily on a corresponding ITK filter.
 #define _itkTotalVariationDenoisingImageFilter_txx
 #include "itkTotalVariationDenoisingImageFilter.h"
 
-#include "itkConstShapedNeighborhoodIterator.h"
-#include "itkImageRegionConstIterator.h"
-#include "itkImageRegionIterator.h"
+#include "itkImageAlgorithm.h"
 #include "itkLocalVariationImageFilter.h"
-#include "itkNeighborhoodAlgorithm.h"
-#include "itkNeighborhoodInnerProduct.h"
-#include "itkOffset.h"
-#include "itkProgressReporter.h"
-#include "itkZeroFluxNeumannBoundaryCondition.h"
 
 #include <algorithm>
+#include <cmath>
+#include <mutex>
 #include <vector>
 
 namespace itk
 {
   template <class TInputImage, class TOutputImage>
   TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::TotalVariationDenoisingImageFilter()
-    : m_Lambda(1.0), m_NumberIterations(0)
+    : m_Lambda(1.0), m_NumberIterations(0), m_ConvergenceTolerance(0.0), m_ElapsedIterations(0)
   {
   }
 
+  template <class TInputImage, class TOutputImage>
+  void TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+  {
+    Superclass::GenerateInputRequestedRegion();
+
+    auto *input = const_cast<InputImageType *>(this->GetInput());
+
+    if (input != nullptr)
+      input->SetRequestedRegionToLargestPossibleRegion();
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject *output)
+  {
+    Superclass::EnlargeOutputRequestedRegion(output);
+    output->SetRequestedRegionToLargestPossibleRegion();
+  }
+
   template <class TInputImage, class TOutputImage>
   void TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::GenerateData()
   {
-    // first we cast the input image to match output type
+    // first we cast the input image to match output type, it is kept as reference
     typename CastType::Pointer infilter = CastType::New();
     infilter->SetInput(this->GetInput());
+    infilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
     infilter->Update();
-    typename TOutputImage::Pointer image = infilter->GetOutput();
+    typename OutputImageType::Pointer origImage = infilter->GetOutput();
 
-    // a second copy of the input image is saved as reference
-    infilter = CastType::New();
-    infilter->SetInput(this->GetInput());
-    infilter->Update();
-    typename TOutputImage::Pointer origImage = infilter->GetOutput();
+    this->AllocateOutputs();
+    OutputImageType *output = this->GetOutput();
+    const OutputImageRegionType region = output->GetBufferedRegion();
+
+    m_ElapsedIterations = 0;
+
+    if (m_NumberIterations <= 0)
+    {
+      ImageAlgorithm::Copy(origImage.GetPointer(), output, region, region);
+      return;
+    }
+
+    // the iterations alternate between the output buffer and a second one
+    typename OutputImageType::Pointer image = OutputImageType::New();
+    image->CopyInformation(output);
+    image->SetRegions(region);
+    image->Allocate();
+
+    OutputPixelType *buffers[2] = {output->GetBufferPointer(), image->GetBufferPointer()};
+    const OutputPixelType *original = origImage->GetBufferPointer();
+    const OutputPixelType *source = original;
 
-    typename SingleIterationFilterType::Pointer filter;
     for (int i = 0; i < m_NumberIterations; i++)
     {
-      filter = SingleIterationFilterType::New();
-      filter->SetInput(image);
-      filter->SetOriginalImage(origImage);
-      filter->SetLambda(m_Lambda);
-      filter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-      filter->UpdateLargestPossibleRegion();
-      image = filter->GetOutput();
-      std::cout << "Iteration " << i + 1 << "/" << m_NumberIterations << std::endl;
+      OutputPixelType *target = buffers[i % 2];
+      const double change = this->Iterate(output, original, source, target);
+      source = target;
+
+      ++m_ElapsedIterations;
+      this->UpdateProgress(static_cast<float>(i + 1) / m_NumberIterations);
+
+      if (change < m_ConvergenceTolerance)
+        break;
     }
 
-    typename OutputImageType::Pointer output = this->GetOutput();
-    output->SetSpacing(image->GetSpacing());
-    typename OutputImageType::RegionType largestPossibleRegion;
-    largestPossibleRegion.SetSize(image->GetLargestPossibleRegion().GetSize());
-    largestPossibleRegion.SetIndex(image->GetLargestPossibleRegion().GetIndex());
-    output->SetLargestPossibleRegion(image->GetLargestPossibleRegion());
-    output->SetBufferedRegion(image->GetLargestPossibleRegion());
-    output->Allocate();
+    if (source != output->GetBufferPointer())
+      output->SetPixelContainer(image->GetPixelContainer());
+  }
+
+  template <class TInputImage, class TOutputImage>
+  double TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::Iterate(const OutputImageType *image,
+                                                                               const OutputPixelType *original,
+                                                                               const OutputPixelType *source,
+                                                                               OutputPixelType *target)
+  {
+    typedef SquaredEuclideanMetric<OutputPixelType> MetricType;
+    const unsigned int dimension = OutputImageDimension;
+
+    const typename OutputImageType::SizeType size = image->GetBufferedRegion().GetSize();
+    const OffsetValueType *offsetTable = image->GetOffsetTable();
 
-    itk::ImageRegionIterator<OutputImageType> oit(output, output->GetLargestPossibleRegion());
-    oit.GoToBegin();
+    // slabs are cut along the outermost dimension with more than one plane
+    unsigned int axis = dimension - 1;
+    while (axis > 0 && size[axis] == 1)
+      --axis;
 
-    itk::ImageRegionConstIterator<OutputImageType> iit(image, image->GetLargestPossibleRegion());
-    iit.GoToBegin();
+    // the innermost remaining dimension is swept in rows
+    unsigned int inner = axis == 0 ? 1 : 0;
+    const SizeValueType rowLength = inner < dimension ? size[inner] : 1;
+    const OffsetValueType rowStride = inner < dimension ? offsetTable[inner] : 0;
 
-    while (!oit.IsAtEnd())
+    // strides of the local variation planes, which contain all dimensions but axis
+    OffsetValueType planeStrides[OutputImageDimension];
+    SizeValueType planeSize = 1;
+    for (unsigned int d = 0; d < dimension; ++d)
     {
-      oit.Set(iit.Get());
-      ++iit;
-      ++oit;
+      planeStrides[d] = d == axis ? 0 : static_cast<OffsetValueType>(planeSize);
+      if (d != axis)
+        planeSize *= size[d];
     }
+
+    const SizeValueType numberOfPlanes = size[axis];
+    const SizeValueType numberOfSlabs =
+      std::min<SizeValueType>(numberOfPlanes, std::max<SizeValueType>(1, this->GetNumberOfWorkUnits()));
+
+    const double lambda = m_Lambda;
+    double change = 0.0;
+    double norm = 0.0;
+    std::mutex mutex;
+
+    // Calls f(pixelOffset, planeOffset, index) for the first pixel of each row in the given plane.
+    auto forEachRow = [&](SizeValueType plane, auto f) {
+      typename OutputImageType::IndexType index;
+      index.Fill(0);
+      index[axis] = static_cast<IndexValueType>(plane);
+
+      while (true)
+      {
+        OffsetValueType pixelOffset = 0;
+        OffsetValueType planeOffset = 0;
+        for (unsigned int d = 0; d < dimension; ++d)
+        {
+          pixelOffset += index[d] * offsetTable[d];
+          planeOffset += index[d] * planeStrides[d];
+        }
+
+        f(pixelOffset, planeOffset, index);
+
+        unsigned int d = 0;
+        for (; d < dimension; ++d)
+        {
+          if (d == axis || d == inner)
+            continue;
+          if (static_cast<SizeValueType>(++index[d]) < size[d])
+            break;
+          index[d] = 0;
+        }
+        if (d == dimension)
+          break;
+      }
+    };
+
+    // The neighbor offsets of a row are the same for all of its pixels but the
+    // ones in the row direction. Neighbors outside of the image are replaced by
+    // the pixel itself (zero flux Neumann boundary condition).
+    auto rowNeighbors = [&](const typename OutputImageType::IndexType &index,
+                            const OffsetValueType *strides,
+                            OffsetValueType *lower,
+                            OffsetValueType *upper) {
+      for (unsigned int d = 0; d < dimension; ++d)
+      {
+        lower[d] = index[d] > 0 ? strides[d] : 0;
+        upper[d] = static_cast<SizeValueType>(index[d] + 1) < size[d] ? strides[d] : 0;
+      }
+    };
+
+    // the planes hold the inverse local variation 1 / ||nabla_alpha(u)||_a, which
+    // is needed for each pixel and all of its neighbors
+    auto computeLocalVariation = [&](SizeValueType plane, float *localVariation) {
+      forEachRow(plane, [&](OffsetValueType pixelOffset, OffsetValueType planeOffset, const typename OutputImageType::IndexType &index) {
+        OffsetValueType lower[OutputImageDimension];
+        OffsetValueType upper[OutputImageDimension];
+        rowNeighbors(index, offsetTable, lower, upper);
+
+        const OutputPixelType *u = source + pixelOffset;
+        float *lv = localVariation + planeOffset;
+
+        for (SizeValueType x = 0; x < rowLength; ++x, u += rowStride)
+        {
+          if (inner < dimension)
+          {
+            lower[inner] = x > 0 ? rowStride : 0;
+            upper[inner] = x + 1 < rowLength ? rowStride : 0;
+          }
+
+          const OutputPixelType center = *u;
+          double variation = 0.0;
+          for (unsigned int d = 0; d < dimension; ++d)
+          {
+            variation += MetricType::Calc(static_cast<OutputPixelType>(*(u - lower[d]) - center));
+            variation += MetricType::Calc(static_cast<OutputPixelType>(*(u + upper[d]) - center));
+          }
+          lv[x] = static_cast<float>(1.0 / std::sqrt(variation + 0.0001));
+        }
+      });
+    };
+
+    auto processSlab = [&](SizeValueType slab) {
+      const SizeValueType firstPlane = slab * numberOfPlanes / numberOfSlabs;
+      const SizeValueType endPlane = (slab + 1) * numberOfPlanes / numberOfSlabs;
+
+      // the local variation of the previous, current and next plane
+      std::vector<float> planes(3 * planeSize);
+      auto localVariationPlane = [&](SizeValueType plane) { return planes.data() + (plane % 3) * planeSize; };
+
+      if (firstPlane > 0)
+        computeLocalVariation(firstPlane - 1, localVariationPlane(firstPlane - 1));
+      computeLocalVariation(firstPlane, localVariationPlane(firstPlane));
+
+      double slabChange = 0.0;
+      double slabNorm = 0.0;
+
+      for (SizeValueType plane = firstPlane; plane < endPlane; ++plane)
+      {
+        if (plane + 1 < numberOfPlanes)
+          computeLocalVariation(plane + 1, localVariationPlane(plane + 1));
+
+        const float *previousPlane = localVariationPlane(plane > 0 ? plane - 1 : plane);
+        const float *currentPlane = localVariationPlane(plane);
+        const float *nextPlane = localVariationPlane(plane + 1 < numberOfPlanes ? plane + 1 : plane);
+
+        forEachRow(plane, [&](OffsetValueType pixelOffset, OffsetValueType planeOffset, const typename OutputImageType::IndexType &index) {
+          OffsetValueType lower[OutputImageDimension];
+          OffsetValueType upper[OutputImageDimension];
+          OffsetValueType planeLower[OutputImageDimension];
+          OffsetValueType planeUpper[OutputImageDimension];
+          rowNeighbors(index, offsetTable, lower, upper);
+          rowNeighbors(index, planeStrides, planeLower, planeUpper);
+
+          const OutputPixelType *u = source + pixelOffset;
+          const OutputPixelType *orig = original + pixelOffset;
+          OutputPixelType *out = target + pixelOffset;
+
+          for (SizeValueType x = 0; x < rowLength; ++x, u += rowStride, orig += rowStride, out += rowStride)
+          {
+            const OffsetValueType lvOffset = planeOffset + static_cast<OffsetValueType>(x);
+            if (inner < dimension)
+            {
+              lower[inner] = x > 0 ? rowStride : 0;
+              upper[inner] = x + 1 < rowLength ? rowStride : 0;
+              planeLower[inner] = x > 0 ? 1 : 0;
+              planeUpper[inner] = x + 1 < rowLength ? 1 : 0;
+            }
+
+            //   1 / ||nabla_alpha(u)||_a
+            const double locvar_alpha_inv = currentPlane[lvOffset];
+
+            // w_alphabeta(u) =
+            //   1 / ||nabla_alpha(u)||_a + 1 / ||nabla_beta(u)||_a
+            double ws[2 * OutputImageDimension];
+            const OutputPixelType *neighbors[2 * OutputImageDimension];
+            double wsum = 0;
+            for (unsigned int d = 0; d < dimension; ++d)
+            {
+              const float lower_inv = d == axis ? previousPlane[lvOffset] : currentPlane[lvOffset - planeLower[d]];
+              const float upper_inv = d == axis ? nextPlane[lvOffset] : currentPlane[lvOffset + planeUpper[d]];
+
+              ws[2 * d] = locvar_alpha_inv + lower_inv;
+              ws[2 * d + 1] = locvar_alpha_inv + upper_inv;
+              neighbors[2 * d] = u - lower[d];
+              neighbors[2 * d + 1] = u + upper[d];
+              wsum += ws[2 * d] + ws[2 * d + 1];
+            }
+
+            const double normalization = 1.0 / (lambda + wsum);
+
+            // h_alphaalpha * u_alpha^zero
+            OutputPixelType res = static_cast<OutputPixelType>(*orig * (lambda * normalization));
+
+            // add the different h_alphabeta * u_beta
+            for (unsigned int n = 0; n < 2 * dimension; ++n)
+              res += *neighbors[n] * (ws[n] * normalization);
+
+            slabChange += MetricType::Calc(static_cast<OutputPixelType>(res - *u));
+            slabNorm += MetricType::Calc(*u);
+
+            *out = res;
+          }
+        });
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      change += slabChange;
+      norm += slabNorm;
+    };
+
+    this->GetMultiThreader()->ParallelizeArray(0, numberOfSlabs, processSlab, nullptr);
+
+    return norm > 0.0 ? std::sqrt(change / norm) : std::sqrt(change);
   }
 
   /**
@@ -98,6 +321,9 @@ namespace itk
   void TotalVariationDenoisingImageFilter<TInputImage, TOutput>::PrintSelf(std::ostream &os, Indent indent) const
   {
     Superclass::PrintSelf(os, indent);
+    os << indent << "Lambda: " << m_Lambda << std::endl;
+    os << indent << "NumberIterations: " << m_NumberIterations << std::endl;
+    os << indent << "ConvergenceTolerance: " << m_ConvergenceTolerance << std::endl;
   }
 
 } // end namespace itk
@@ -13,12 +13,13 @@ found in the LICENSE file.
 #include "mitkBilateralFilter.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
+#include <itkBilateralGridImageFilter.h>
 #include <itkBilateralImageFilter.h>
 
 mitk::BilateralFilter::BilateralFilter()
-  : m_DomainSigma(2.0f), m_RangeSigma(50.0f), m_AutoKernel(true), m_KernelRadius(1u)
+  : m_DomainSigma(2.0f), m_RangeSigma(50.0f), m_AutoKernel(true), m_KernelRadius(1u), m_UseBilateralGrid(false)
 {
-  // default parameters DomainSigma: 2 , RangeSigma: 50, AutoKernel: true, KernelRadius: 1
+  // default parameters DomainSigma: 2 , RangeSigma: 50, AutoKernel: true, KernelRadius: 1, UseBilateralGrid: false
 }
 
 mitk::BilateralFilter::~BilateralFilter()
@@ -62,6 +63,21 @@ void mitk::BilateralFilter::ItkImageProcessing(const itk::Image<TPixel, VImageDi
 {
   // ITK Image type given from the input image
   typedef itk::Image<TPixel, VImageDimension> ItkImageType;
+  // get  Pointer to output image
+  mitk::Image::Pointer resultImage = this->GetOutput();
+
+  if (m_UseBilateralGrid)
+  {
+    typedef itk::BilateralGridImageFilter<ItkImageType, ItkImageType> BilateralGridFilterType;
+    typename BilateralGridFilterType::Pointer bilateralGridFilter = BilateralGridFilterType::New();
+    bilateralGridFilter->SetInput(itkImage);
+    bilateralGridFilter->SetDomainSigma(m_DomainSigma);
+    bilateralGridFilter->SetRangeSigma(m_RangeSigma);
+    bilateralGridFilter->UpdateLargestPossibleRegion();
+    mitk::CastToMitkImage(bilateralGridFilter->GetOutput(), resultImage);
+    return;
+  }
+
   // bilateral filter with same type
   typedef itk::BilateralImageFilter<ItkImageType, ItkImageType> BilateralFilterType;
   typename BilateralFilterType::Pointer bilateralFilter = BilateralFilterType::New();
@@ -75,8 +91,6 @@ void mitk::BilateralFilter::ItkImageProcessing(const itk::Image<TPixel, VImageDi
   bilateralFilter->SetDomainSigma(m_DomainSigma);
   bilateralFilter->SetRangeSigma(m_RangeSigma);
   bilateralFilter->UpdateLargestPossibleRegion();
-  // get  Pointer to output image
-  mitk::Image::Pointer resultImage = this->GetOutput();
   // write into output image
   mitk::CastToMitkImage(bilateralFilter->GetOutput(), resultImage);
 }
@@ -31,11 +31,14 @@ namespace mitk
     itkSetMacro(RangeSigma, float);
     itkSetMacro(AutoKernel, bool);
     itkSetMacro(KernelRadius, unsigned int);
+    itkSetMacro(UseBilateralGrid, bool);
+    itkBooleanMacro(UseBilateralGrid);
 
     itkGetMacro(DomainSigma, float);
     itkGetMacro(RangeSigma, float);
     itkGetMacro(AutoKernel, bool);
     itkGetMacro(KernelRadius, unsigned int);
+    itkGetMacro(UseBilateralGrid, bool);
 
   protected:
     /*!
@@ -59,6 +62,7 @@ namespace mitk
 
     /*!
     \brief Internal templated method calling the ITK bilteral filter. Here the actual filtering is performed.
+    With m_UseBilateralGrid, the itk::BilateralGridImageFilter approximation is used instead.
     */
     template <typename TPixel, unsigned int VImageDimension>
     void ItkImageProcessing(const itk::Image<TPixel, VImageDimension> *itkImage);
@@ -67,6 +71,7 @@ namespace mitk
     float m_RangeSigma;  /// Sigma of the range mask kernel. See ITK docu
     bool m_AutoKernel;   // true: kernel size is calculated from DomainSigma. See ITK Doc; false: set by m_KernelRadius
     unsigned int m_KernelRadius; // use in combination with m_AutoKernel = true
+    bool m_UseBilateralGrid; // true: approximate the filter in a bilateral grid, kernel settings are ignored
   };
 } // END mitk namespace
 #endif
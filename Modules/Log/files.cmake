@@ -3,6 +3,7 @@ set(H_FILES
   include/mitkLogBackendBase.h
   include/mitkLogBackendText.h
   include/mitkLogBackendCout.h
+  include/mitkLogBackendAsync.h
   include/mitkLogLevel.h
   include/mitkLogMessage.h
 )
@@ -12,5 +13,6 @@ set(CPP_FILES
   mitkLogBackendBase.cpp
   mitkLogBackendText.cpp
   mitkLogBackendCout.cpp
+  mitkLogBackendAsync.cpp
   mitkLogMessage.cpp
 )
@@ -0,0 +1,103 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLogBackendAsync_h
+#define mitkLogBackendAsync_h
+
+#include <mitkLogBackendText.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Asynchronous log backend that moves formatting and output off the logging threads.
+   *
+   * ProcessMessage() only copies the message into a bounded lock-free queue. A dedicated writer thread
+   * takes the queued messages in batches and either
+   *   - passes them to another backend (see LogBackendAsync(LogBackendBase*, std::size_t)), which is
+   *     then only ever called from the writer thread, or
+   *   - formats them in the smart format into one buffer per batch and writes the buffer to a stream
+   *     with a single flush (see LogBackendAsync(std::size_t, std::ostream*)).
+   *
+   * If the queue is full, new messages are dropped instead of blocking the logging thread. The writer reports
+   * the number of dropped messages with a warning. Identical consecutive messages (same level, location, and
+   * text) are aggregated into a single line with a repetition count. Fatal messages are written before
+   * ProcessMessage() returns. The writer sleeps while the queue is empty and is woken up by the first
+   * message; messages that arrive while it is writing are taken together in its next batch.
+   *
+   * Per-level counters allow to monitor the logging load, e.g. to check that enabling diagnostics does not
+   * lead to dropped messages.
+   *
+   * \code
+   * mitk::LogBackendAsync asyncBackend;
+   * mitk::RegisterBackend(&asyncBackend);
+   * \endcode
+   *
+   * The MITK log backend uses this backend if registered with mitk::LogBackend::Register(true).
+   */
+  class MITKLOG_EXPORT LogBackendAsync : public LogBackendText
+  {
+  public:
+    /** \brief Formats the messages itself and writes them to out (std::cout if nullptr).
+     *
+     * \param queueCapacity Maximum number of queued messages, rounded up to the next power of two.
+     * \param out Stream the messages are written to. Must outlive the backend.
+     */
+    explicit LogBackendAsync(std::size_t queueCapacity = 8192, std::ostream* out = nullptr);
+
+    /** \brief Passes the messages to backend on the writer thread.
+     *
+     * The backend is not owned and must outlive this instance. It must not be registered itself.
+     * The output type of backend is reported by GetOutputType().
+     */
+    explicit LogBackendAsync(LogBackendBase* backend, std::size_t queueCapacity = 8192);
+
+    /** \brief Writes all queued messages and stops the writer thread. */
+    ~LogBackendAsync() override;
+
+    void ProcessMessage(const LogMessage& message) override;
+
+    /** \brief Output type of the wrapped backend or OutputType::Console. */
+    OutputType GetOutputType() const override;
+
+    /** \brief Use the full/long format instead of the smart/short format. Ignored if a backend is wrapped. */
+    void SetFull(bool full);
+
+    /** \brief Blocks until all messages queued so far are written. Returns immediately on the writer thread. */
+    void Flush();
+
+    std::size_t GetQueueCapacity() const;
+
+    /** \brief Number of messages of the given level that were passed to ProcessMessage(). */
+    std::uint64_t GetNumberOfMessages(LogLevel level) const;
+
+    /** \brief Number of messages of the given level that were dropped because the queue was full. */
+    std::uint64_t GetNumberOfDroppedMessages(LogLevel level) const;
+
+    /** \brief Number of messages of the given level that were written (including aggregated repetitions). */
+    std::uint64_t GetNumberOfWrittenMessages(LogLevel level) const;
+
+  private:
+    LogBackendAsync(LogBackendBase* backend, std::size_t queueCapacity, std::ostream* out);
+
+    void Run();
+    void Write(std::vector<std::unique_ptr<LogMessage>>& batch);
+
+    struct Impl;
+    std::unique_ptr<Impl> m_Impl;
+  };
+}
+
+#endif
@@ -0,0 +1,465 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkLogBackendAsync.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+  constexpr std::size_t NumberOfLevels = 5;
+
+  std::size_t GetIndex(mitk::LogLevel level)
+  {
+    return static_cast<std::size_t>(level) % NumberOfLevels;
+  }
+
+  std::size_t RoundUpToPowerOfTwo(std::size_t value)
+  {
+    std::size_t result = 2;
+
+    while (result < value)
+      result <<= 1;
+
+    return result;
+  }
+
+  bool IsRepetition(const mitk::LogMessage& message, const mitk::LogMessage& previousMessage)
+  {
+    return message.Level == previousMessage.Level &&
+           message.LineNumber == previousMessage.LineNumber &&
+           message.Message == previousMessage.Message &&
+           message.FilePath == previousMessage.FilePath &&
+           message.Category == previousMessage.Category &&
+           message.ModuleName == previousMessage.ModuleName;
+  }
+
+  /** Bounded lock-free multi-producer queue with a single consumer (D. Vyukov's bounded MPMC queue). */
+  class MessageQueue
+  {
+  public:
+    explicit MessageQueue(std::size_t capacity)
+      : m_Cells(RoundUpToPowerOfTwo(capacity)),
+        m_Mask(m_Cells.size() - 1),
+        m_EnqueuePosition(0),
+        m_DequeuePosition(0)
+    {
+      for (std::size_t i = 0; i < m_Cells.size(); ++i)
+        m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    std::size_t GetCapacity() const
+    {
+      return m_Cells.size();
+    }
+
+    bool TryPush(std::unique_ptr<mitk::LogMessage>& message)
+    {
+      Cell* cell = nullptr;
+      auto position = m_EnqueuePosition.load(std::memory_order_relaxed);
+
+      while (true)
+      {
+        cell = &m_Cells[position & m_Mask];
+        const auto sequence = cell->Sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+        if (0 == difference)
+        {
+          if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0)
+        {
+          return false; // full
+        }
+        else
+        {
+          position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        }
+      }
+
+      cell->Message = std::move(message);
+      cell->Sequence.store(position + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /** Must only be called from the consumer thread. */
+    std::unique_ptr<mitk::LogMessage> TryPop()
+    {
+      auto& cell = m_Cells[m_DequeuePosition & m_Mask];
+
+      if (cell.Sequence.load(std::memory_order_acquire) != m_DequeuePosition + 1)
+        return nullptr; // empty or not yet published
+
+      auto message = std::move(cell.Message);
+      cell.Sequence.store(m_DequeuePosition + m_Mask + 1, std::memory_order_release);
+      ++m_DequeuePosition;
+
+      return message;
+    }
+
+  private:
+    struct Cell
+    {
+      std::atomic<std::size_t> Sequence;
+      std::unique_ptr<mitk::LogMessage> Message;
+    };
+
+    std::vector<Cell> m_Cells;
+    const std::size_t m_Mask;
+    alignas(64) std::atomic<std::size_t> m_EnqueuePosition;
+    alignas(64) std::size_t m_DequeuePosition;
+  };
+
+  using Counters = std::array<std::atomic<std::uint64_t>, NumberOfLevels>;
+}
+
+struct mitk::LogBackendAsync::Impl
+{
+  Impl(LogBackendBase* backend, std::size_t queueCapacity, std::ostream* out)
+    : Backend(backend),
+      Out(nullptr != out ? out : &std::cout),
+      Queue(queueCapacity),
+      UseFullOutput(false),
+      WriteRequested(false),
+      Stop(false),
+      WriterId(std::thread::id()),
+      Idle(false),
+      NumberOfQueuedMessages(0),
+      NumberOfTakenMessages(0),
+      NumberOfReportedDroppedMessages(0)
+  {
+    for (std::size_t i = 0; i < NumberOfLevels; ++i)
+    {
+      Messages[i] = 0;
+      DroppedMessages[i] = 0;
+      WrittenMessages[i] = 0;
+    }
+  }
+
+  LogBackendBase* Backend;
+  std::ostream* Out;
+  MessageQueue Queue;
+  std::atomic<bool> UseFullOutput;
+
+  std::mutex Mutex;
+  std::condition_variable WakeUp;
+  std::condition_variable Written;
+  bool WriteRequested;
+  bool Stop;
+  std::thread Writer;
+  std::atomic<std::thread::id> WriterId;
+
+  /** Set by the writer while it waits for messages. Producers only wake up an idle writer. */
+  std::atomic<bool> Idle;
+
+  std::atomic<std::uint64_t> NumberOfQueuedMessages;
+  std::uint64_t NumberOfTakenMessages; // guarded by Mutex
+  std::uint64_t NumberOfReportedDroppedMessages; // only used by the writer
+
+  Counters Messages;
+  Counters DroppedMessages;
+  Counters WrittenMessages;
+
+  void RequestWrite()
+  {
+    {
+      std::lock_guard<std::mutex> lock(Mutex);
+      WriteRequested = true;
+    }
+
+    WakeUp.notify_one();
+  }
+
+  /** Wakes up the writer if it is idle. Must be called after the message was queued or counted as dropped. */
+  void NotifyWriter()
+  {
+    // Both the writer and the producers use sequentially consistent operations: Either the writer sees the new
+    // message when it checks for pending messages after setting Idle, or the producer sees Idle and wakes it up.
+    if (Idle.load() && Idle.exchange(false))
+      RequestWrite();
+  }
+
+  bool IsWriterThread() const
+  {
+    return std::this_thread::get_id() == WriterId.load();
+  }
+
+  std::uint64_t GetNumberOfDroppedMessages() const
+  {
+    std::uint64_t numberOfDroppedMessages = 0;
+
+    for (const auto& droppedMessages : DroppedMessages)
+      numberOfDroppedMessages += droppedMessages;
+
+    return numberOfDroppedMessages;
+  }
+
+  /** Must only be called by the writer while holding Mutex. */
+  bool HasPendingMessages() const
+  {
+    return NumberOfQueuedMessages.load() > NumberOfTakenMessages ||
+           GetNumberOfDroppedMessages() > NumberOfReportedDroppedMessages;
+  }
+};
+
+mitk::LogBackendAsync::LogBackendAsync(std::size_t queueCapacity, std::ostream* out)
+  : LogBackendAsync(nullptr, queueCapacity, out)
+{
+}
+
+mitk::LogBackendAsync::LogBackendAsync(LogBackendBase* backend, std::size_t queueCapacity)
+  : LogBackendAsync(backend, queueCapacity, nullptr)
+{
+}
+
+mitk::LogBackendAsync::LogBackendAsync(LogBackendBase* backend, std::size_t queueCapacity, std::ostream* out)
+  : m_Impl(std::make_unique<Impl>(backend, queueCapacity, out))
+{
+  m_Impl->Writer = std::thread(&LogBackendAsync::Run, this);
+}
+
+mitk::LogBackendAsync::~LogBackendAsync()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->Mutex);
+    m_Impl->Stop = true;
+  }
+
+  m_Impl->WakeUp.notify_one();
+  m_Impl->Writer.join();
+}
+
+void mitk::LogBackendAsync::ProcessMessage(const LogMessage& message)
+{
+  const auto index = GetIndex(message.Level);
+  ++m_Impl->Messages[index];
+
+  auto copy = std::make_unique<LogMessage>(message);
+
+  if (LogLevel::Fatal == message.Level)
+  {
+    // Fatal messages usually precede termination, so they are never dropped and written synchronously.
+    // If the message was logged by the writer thread itself, e.g. by the wrapped backend, it cannot wait
+    // for the writer. It writes the message directly instead.
+    if (m_Impl->IsWriterThread())
+    {
+      std::vector<std::unique_ptr<LogMessage>> batch;
+      batch.push_back(std::move(copy));
+      this->Write(batch);
+      return;
+    }
+
+    while (!m_Impl->Queue.TryPush(copy))
+    {
+      m_Impl->RequestWrite();
+      std::this_thread::yield();
+    }
+
+    ++m_Impl->NumberOfQueuedMessages;
+    this->Flush();
+    return;
+  }
+
+  if (m_Impl->Queue.TryPush(copy))
+  {
+    ++m_Impl->NumberOfQueuedMessages;
+  }
+  else
+  {
+    ++m_Impl->DroppedMessages[index];
+  }
+
+  // Messages that arrive while the writer is busy are taken together in its next batch.
+  m_Impl->NotifyWriter();
+}
+
+mitk::LogBackendAsync::OutputType mitk::LogBackendAsync::GetOutputType() const
+{
+  return nullptr != m_Impl->Backend
+    ? m_Impl->Backend->GetOutputType()
+    : OutputType::Console;
+}
+
+void mitk::LogBackendAsync::SetFull(bool full)
+{
+  m_Impl->UseFullOutput = full;
+}
+
+void mitk::LogBackendAsync::Flush()
+{
+  // The writer cannot wait for itself
+  if (m_Impl->IsWriterThread())
+    return;
+
+  const auto numberOfQueuedMessages = m_Impl->NumberOfQueuedMessages.load();
+
+  std::unique_lock<std::mutex> lock(m_Impl->Mutex);
+
+  if (m_Impl->NumberOfTakenMessages >= numberOfQueuedMessages)
+    return;
+
+  m_Impl->WriteRequested = true;
+  m_Impl->WakeUp.notify_one();
+  m_Impl->Written.wait(lock, [this, numberOfQueuedMessages]() {
+    return m_Impl->NumberOfTakenMessages >= numberOfQueuedMessages || m_Impl->Stop;
+  });
+}
+
+std::size_t mitk::LogBackendAsync::GetQueueCapacity() const
+{
+  return m_Impl->Queue.GetCapacity();
+}
+
+std::uint64_t mitk::LogBackendAsync::GetNumberOfMessages(LogLevel level) const
+{
+  return m_Impl->Messages[GetIndex(level)];
+}
+
+std::uint64_t mitk::LogBackendAsync::GetNumberOfDroppedMessages(LogLevel level) const
+{
+  return m_Impl->DroppedMessages[GetIndex(level)];
+}
+
+std::uint64_t mitk::LogBackendAsync::GetNumberOfWrittenMessages(LogLevel level) const
+{
+  return m_Impl->WrittenMessages[GetIndex(level)];
+}
+
+void mitk::LogBackendAsync::Run()
+{
+  m_Impl->WriterId = std::this_thread::get_id();
+
+  std::vector<std::unique_ptr<LogMessage>> batch;
+  bool stop = false;
+
+  while (!stop)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_Impl->Mutex);
+
+      // Idle has to be set before checking for pending messages, see Impl::NotifyWriter().
+      m_Impl->Idle = true;
+      m_Impl->WakeUp.wait(lock, [this]() { return m_Impl->WriteRequested || m_Impl->Stop || m_Impl->HasPendingMessages(); });
+      m_Impl->Idle = false;
+      m_Impl->WriteRequested = false;
+      stop = m_Impl->Stop;
+    }
+
+    std::uint64_t numberOfTakenMessages = 0;
+
+    // Drain the queue. When stopping, messages of producers that are still publishing are waited for.
+    while (true)
+    {
+      while (auto message = m_Impl->Queue.TryPop())
+      {
+        batch.push_back(std::move(message));
+        ++numberOfTakenMessages;
+      }
+
+      if (!stop || m_Impl->NumberOfQueuedMessages.load() <= m_Impl->NumberOfTakenMessages + numberOfTakenMessages)
+        break;
+
+      std::this_thread::yield();
+    }
+
+    const auto numberOfDroppedMessages = m_Impl->GetNumberOfDroppedMessages();
+
+    if (numberOfDroppedMessages > m_Impl->NumberOfReportedDroppedMessages)
+    {
+      auto warning = std::make_unique<LogMessage>(LogLevel::Warn, __FILE__, __LINE__, __func__);
+      warning->Category = "Log";
+      warning->Message = std::to_string(numberOfDroppedMessages - m_Impl->NumberOfReportedDroppedMessages) +
+                         " log message(s) dropped because the queue of the asynchronous log backend was full";
+      batch.push_back(std::move(warning));
+
+      m_Impl->NumberOfReportedDroppedMessages = numberOfDroppedMessages;
+    }
+
+    if (!batch.empty())
+    {
+      this->Write(batch);
+      batch.clear();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_Impl->Mutex);
+      m_Impl->NumberOfTakenMessages += numberOfTakenMessages;
+    }
+
+    m_Impl->Written.notify_all();
+  }
+}
+
+void mitk::LogBackendAsync::Write(std::vector<std::unique_ptr<LogMessage>>& batch)
+{
+  std::ostringstream buffer;
+  const bool useFullOutput = m_Impl->UseFullOutput;
+
+  auto write = [this, &buffer, useFullOutput](const LogMessage& message, std::uint64_t count) {
+    if (nullptr != m_Impl->Backend)
+    {
+      m_Impl->Backend->ProcessMessage(message);
+    }
+    else if (useFullOutput)
+    {
+      this->FormatFull(buffer, message);
+    }
+    else
+    {
+      this->FormatSmart(buffer, message);
+    }
+
+    m_Impl->WrittenMessages[GetIndex(message.Level)] += count;
+  };
+
+  auto writeRepetitions = [&write](const LogMessage& message, std::uint64_t numberOfRepetitions) {
+    LogMessage summary(message);
+    summary.Message = "Previous message repeated " + std::to_string(numberOfRepetitions) + " time(s)";
+    write(summary, numberOfRepetitions);
+  };
+
+  const LogMessage* previousMessage = nullptr;
+  std::uint64_t numberOfRepetitions = 0;
+
+  for (const auto& message : batch)
+  {
+    if (nullptr != previousMessage && IsRepetition(*message, *previousMessage))
+    {
+      ++numberOfRepetitions;
+      continue;
+    }
+
+    if (0 != numberOfRepetitions)
+    {
+      writeRepetitions(*previousMessage, numberOfRepetitions);
+      numberOfRepetitions = 0;
+    }
+
+    write(*message, 1);
+    previousMessage = message.get();
+  }
+
+  if (0 != numberOfRepetitions)
+    writeRepetitions(*previousMessage, numberOfRepetitions);
+
+  if (nullptr == m_Impl->Backend)
+    *m_Impl->Out << buffer.str() << std::flush;
+}
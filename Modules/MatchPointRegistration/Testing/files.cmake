@@ -1,4 +1,6 @@
 SET(MODULE_TESTS
   mitkTimeFramesRegistrationHelperTest.cpp
   itkStitchImageFilterTest.cpp
+  mitkDisplacementFieldSliceMapperTest.cpp
+  mitkImageMappingHelperTest.cpp
 )
\ No newline at end of file
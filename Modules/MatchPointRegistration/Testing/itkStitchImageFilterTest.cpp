@@ -25,6 +25,7 @@ class itkStitchImageFilterTestSuite : public mitk::TestFixture
   MITK_TEST(StitchWithNoTransformAndNoInterp);
   MITK_TEST(StitchWithNoInterp);
   MITK_TEST(Stitch);
+  MITK_TEST(StitchWithSmallBricks);
   CPPUNIT_TEST_SUITE_END();
 
   using InputImageType = mitk::TestImageType;
@@ -155,6 +156,23 @@ public:
     CPPUNIT_ASSERT(CheckPixels(output, { 1,2,3,4,5,6,7,8,9,10,20,30,40,50,60,70,80,90,100,200,300,250,350,450,550,650,750 }));
   }
 
+  void StitchWithSmallBricks()
+  {
+    //bricks smaller than the input footprints, so that inputs are skipped for some bricks
+    FilterType::SizeType brickSize = { 2, 2 };
+    m_Filter->SetBrickSize(brickSize);
+    CPPUNIT_ASSERT_EQUAL(brickSize, m_Filter->GetBrickSize());
+
+    m_Filter->SetInput(0, m_Input1);
+    m_Filter->SetInput(1, m_Input2);
+    m_Filter->SetInput(2, m_Input3);
+
+    m_Filter->Update();
+    auto output = m_Filter->GetOutput();
+
+    CPPUNIT_ASSERT(CheckPixels(output, {1, 2, 3, 4, 5, 6, 8.5, 14, 19.5, 40, 50, 60, 85, 140, 195, 400, 500, 600, 700, 800, 900, 1000, 1000, 1000, 1000, 1000, 1000}));
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(itkStitchImageFilter)
@@ -0,0 +1,144 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+#include "mitkDisplacementFieldSliceMapper.h"
+#include "mitkMAPAlgorithmHelper.h"
+
+#include <mitkImageGenerator.h>
+#include <mitkImagePixelReadAccessor.h>
+
+class mitkDisplacementFieldSliceMapperTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDisplacementFieldSliceMapperTestSuite);
+  MITK_TEST(IsSupported);
+  MITK_TEST(MapIdentity);
+  MITK_TEST(MapShiftedGeometry);
+  MITK_TEST(MapCoarseField);
+  MITK_TEST(CacheIsReused);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::DisplacementFieldSliceMapper::Pointer m_Mapper;
+  mitk::Image::Pointer m_Image;
+  mitk::MAPRegistrationWrapper::Pointer m_Registration;
+
+  void CheckValues(const mitk::Image* result, int offsetX, bool expectPadding)
+  {
+    mitk::ImagePixelReadAccessor<float, 3> resultAccessor(result);
+    mitk::ImagePixelReadAccessor<short, 3> imageAccessor(m_Image);
+
+    for (unsigned int z = 0; z < result->GetDimension(2); ++z)
+    {
+      for (unsigned int y = 0; y < result->GetDimension(1); ++y)
+      {
+        for (unsigned int x = 0; x < result->GetDimension(0); ++x)
+        {
+          itk::Index<3> index;
+          index[0] = x;
+          index[1] = y;
+          index[2] = z;
+          itk::Index<3> sourceIndex = index;
+          sourceIndex[0] += offsetX;
+
+          if (sourceIndex[0] < static_cast<itk::IndexValueType>(m_Image->GetDimension(0)))
+          {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(imageAccessor.GetPixelByIndex(sourceIndex), resultAccessor.GetPixelByIndex(index), 1e-3);
+          }
+          else if (expectPadding)
+          {
+            CPPUNIT_ASSERT_EQUAL(-1.f, resultAccessor.GetPixelByIndex(index));
+          }
+        }
+      }
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_Mapper = mitk::DisplacementFieldSliceMapper::New();
+    m_Mapper->SetPaddingValue(-1);
+    m_Image = mitk::ImageGenerator::GenerateGradientImage<short>(10, 8, 6);
+    m_Registration = mitk::GenerateIdentityRegistration3D();
+  }
+
+  void tearDown() override
+  {
+    m_Mapper = nullptr;
+    m_Image = nullptr;
+    m_Registration = nullptr;
+  }
+
+  void IsSupported()
+  {
+    CPPUNIT_ASSERT(mitk::DisplacementFieldSliceMapper::IsSupported(m_Image, m_Registration->GetRegistration()));
+    CPPUNIT_ASSERT(!mitk::DisplacementFieldSliceMapper::IsSupported(nullptr, m_Registration->GetRegistration()));
+    CPPUNIT_ASSERT(!mitk::DisplacementFieldSliceMapper::IsSupported(m_Image, nullptr));
+
+    auto dynamicImage = mitk::ImageGenerator::GenerateRandomImage<short>(10, 8, 6, 3);
+    CPPUNIT_ASSERT(!mitk::DisplacementFieldSliceMapper::IsSupported(dynamicImage, m_Registration->GetRegistration()));
+  }
+
+  void MapIdentity()
+  {
+    auto result = m_Mapper->Map(m_Image, m_Registration->GetRegistration(), m_Image->GetGeometry(), m_Image->GetGeometry());
+
+    CPPUNIT_ASSERT_EQUAL(m_Image->GetDimension(0), result->GetDimension(0));
+    CPPUNIT_ASSERT_EQUAL(m_Image->GetDimension(1), result->GetDimension(1));
+    CPPUNIT_ASSERT_EQUAL(m_Image->GetDimension(2), result->GetDimension(2));
+    CheckValues(result, 0, true);
+  }
+
+  void MapShiftedGeometry()
+  {
+    auto resultGeometry = m_Image->GetGeometry()->Clone();
+    auto origin = resultGeometry->GetOrigin();
+    origin[0] += 2;
+    resultGeometry->SetOrigin(origin);
+
+    auto result = m_Mapper->Map(m_Image, m_Registration->GetRegistration(), m_Image->GetGeometry(), resultGeometry);
+    CheckValues(result, 2, true);
+  }
+
+  void MapCoarseField()
+  {
+    m_Mapper->SetMaximumNumberOfFieldPoints(27);
+
+    auto result = m_Mapper->Map(m_Image, m_Registration->GetRegistration(), m_Image->GetGeometry(), m_Image->GetGeometry());
+    CheckValues(result, 0, true);
+  }
+
+  void CacheIsReused()
+  {
+    CPPUNIT_ASSERT_EQUAL(0u, m_Mapper->GetNumberOfFieldUpdates());
+
+    m_Mapper->Map(m_Image, m_Registration->GetRegistration(), m_Image->GetGeometry(), m_Image->GetGeometry());
+    CPPUNIT_ASSERT_EQUAL(1u, m_Mapper->GetNumberOfFieldUpdates());
+
+    auto resultGeometry = m_Image->GetGeometry()->Clone();
+    m_Mapper->Map(m_Image, m_Registration->GetRegistration(), m_Image->GetGeometry(), resultGeometry);
+    CPPUNIT_ASSERT_EQUAL(1u, m_Mapper->GetNumberOfFieldUpdates());
+
+    m_Registration->GetRegistration()->Modified();
+    m_Mapper->Map(m_Image, m_Registration->GetRegistration(), m_Image->GetGeometry(), resultGeometry);
+    CPPUNIT_ASSERT_EQUAL(2u, m_Mapper->GetNumberOfFieldUpdates());
+
+    m_Mapper->ClearCache();
+    m_Mapper->Map(m_Image, m_Registration->GetRegistration(), m_Image->GetGeometry(), resultGeometry);
+    CPPUNIT_ASSERT_EQUAL(3u, m_Mapper->GetNumberOfFieldUpdates());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDisplacementFieldSliceMapper)
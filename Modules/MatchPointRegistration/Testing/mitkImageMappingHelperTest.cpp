@@ -0,0 +1,135 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+#include "mitkImageMappingHelper.h"
+#include "mitkMAPAlgorithmHelper.h"
+
+#include <mitkImageGenerator.h>
+#include <mitkImageReadAccessor.h>
+
+#include <cstring>
+#include <vector>
+
+class mitkImageMappingHelperTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageMappingHelperTestSuite);
+  MITK_TEST(SetMaximumNumberOfConcurrentTimeSteps_GetMaximumNumberOfConcurrentTimeSteps);
+  MITK_TEST(MapTimeStepsConcurrently);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::MAPRegistrationWrapper::Pointer m_Registration;
+  mitk::BaseGeometry::Pointer m_ResultGeometry;
+  unsigned int m_OriginalNumberOfTimeSteps;
+
+  struct ProgressRecord
+  {
+    std::vector<unsigned int> mappedTimeSteps;
+    std::vector<unsigned int> totalTimeSteps;
+  };
+
+  mitk::Image::Pointer Map(unsigned int numberOfConcurrentTimeSteps, ProgressRecord& progress)
+  {
+    mitk::ImageMappingHelper::SetMaximumNumberOfConcurrentTimeSteps(numberOfConcurrentTimeSteps);
+
+    return mitk::ImageMappingHelper::map(m_Image, m_Registration, false, -1, m_ResultGeometry, true, 0,
+      mitk::ImageMappingInterpolator::Linear, [&progress](unsigned int mapped, unsigned int total)
+      {
+        progress.mappedTimeSteps.push_back(mapped);
+        progress.totalTimeSteps.push_back(total);
+      });
+  }
+
+  void CheckProgress(const ProgressRecord& progress)
+  {
+    const unsigned int timeSteps = m_Image->GetTimeSteps();
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(timeSteps), progress.mappedTimeSteps.size());
+
+    for (unsigned int i = 0; i < timeSteps; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(i + 1, progress.mappedTimeSteps[i]);
+      CPPUNIT_ASSERT_EQUAL(timeSteps, progress.totalTimeSteps[i]);
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_OriginalNumberOfTimeSteps = mitk::ImageMappingHelper::GetMaximumNumberOfConcurrentTimeSteps();
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<short>(12, 10, 8, 6);
+    m_Registration = mitk::GenerateIdentityRegistration3D();
+
+    //shift the result by half a voxel, so that every mapped pixel is interpolated
+    m_ResultGeometry = m_Image->GetGeometry()->Clone();
+    auto origin = m_ResultGeometry->GetOrigin();
+    origin[0] += 0.5;
+    origin[1] += 0.5;
+    m_ResultGeometry->SetOrigin(origin);
+  }
+
+  void tearDown() override
+  {
+    mitk::ImageMappingHelper::SetMaximumNumberOfConcurrentTimeSteps(m_OriginalNumberOfTimeSteps);
+    m_Image = nullptr;
+    m_Registration = nullptr;
+    m_ResultGeometry = nullptr;
+  }
+
+  void SetMaximumNumberOfConcurrentTimeSteps_GetMaximumNumberOfConcurrentTimeSteps()
+  {
+    mitk::ImageMappingHelper::SetMaximumNumberOfConcurrentTimeSteps(3);
+    CPPUNIT_ASSERT_EQUAL(3u, mitk::ImageMappingHelper::GetMaximumNumberOfConcurrentTimeSteps());
+    mitk::ImageMappingHelper::SetMaximumNumberOfConcurrentTimeSteps(0);
+    CPPUNIT_ASSERT_EQUAL(0u, mitk::ImageMappingHelper::GetMaximumNumberOfConcurrentTimeSteps());
+  }
+
+  void MapTimeStepsConcurrently()
+  {
+    ProgressRecord serialProgress;
+    auto serialResult = this->Map(1, serialProgress);
+    CheckProgress(serialProgress);
+
+    ProgressRecord concurrentProgress;
+    auto concurrentResult = this->Map(4, concurrentProgress);
+    CheckProgress(concurrentProgress);
+
+    const unsigned int timeSteps = m_Image->GetTimeSteps();
+    CPPUNIT_ASSERT_EQUAL(timeSteps, serialResult->GetTimeSteps());
+    CPPUNIT_ASSERT_EQUAL(timeSteps, concurrentResult->GetTimeSteps());
+
+    std::size_t volumeSize = serialResult->GetPixelType().GetSize();
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(serialResult->GetDimension(i), concurrentResult->GetDimension(i));
+      volumeSize *= serialResult->GetDimension(i);
+    }
+
+    for (unsigned int t = 0; t < timeSteps; ++t)
+    {
+      mitk::ImageReadAccessor serialAccessor(serialResult, serialResult->GetVolumeData(t));
+      mitk::ImageReadAccessor concurrentAccessor(concurrentResult, concurrentResult->GetVolumeData(t));
+      CPPUNIT_ASSERT_MESSAGE("Time step " + std::to_string(t) + " differs from the serially mapped one",
+        0 == std::memcmp(serialAccessor.GetData(), concurrentAccessor.GetData(), volumeSize));
+    }
+
+    //the time steps differ, so the comparison above also detects time steps written to the wrong volume
+    mitk::ImageReadAccessor firstAccessor(serialResult, serialResult->GetVolumeData(0));
+    mitk::ImageReadAccessor lastAccessor(serialResult, serialResult->GetVolumeData(timeSteps - 1));
+    CPPUNIT_ASSERT(0 != std::memcmp(firstAccessor.GetData(), lastAccessor.GetData(), volumeSize));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageMappingHelper)
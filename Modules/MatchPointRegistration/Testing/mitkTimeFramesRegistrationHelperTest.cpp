@@ -25,6 +25,8 @@ class mitkTimeFramesRegistrationHelperTestSuite : public mitk::TestFixture
   MITK_TEST(SetAllowUnregPixels_GetAllowUnregPixels);
   MITK_TEST(SetInterpolatorType_GetInterpolatorType);
   MITK_TEST(Set_Get_Clear_IgnoreList);
+  MITK_TEST(SetMaximumNumberOfConcurrentFrames_GetMaximumNumberOfConcurrentFrames);
+  MITK_TEST(SetAlgorithmFactory_GetAlgorithmFactory);
   CPPUNIT_TEST_SUITE_END();
 private:
   mitk::TimeFramesRegistrationHelper::Pointer frameRegHelper;
@@ -102,6 +104,28 @@ public:
     CPPUNIT_ASSERT(frameRegHelper->GetIgnoreList().empty());
   }
 
+  void SetMaximumNumberOfConcurrentFrames_GetMaximumNumberOfConcurrentFrames()
+  {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check getter on default value", 0u,
+                                 frameRegHelper->GetMaximumNumberOfConcurrentFrames());
+    frameRegHelper->SetMaximumNumberOfConcurrentFrames(3);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check getter on changed value", 3u,
+                                 frameRegHelper->GetMaximumNumberOfConcurrentFrames());
+  }
+
+  void SetAlgorithmFactory_GetAlgorithmFactory()
+  {
+    CPPUNIT_ASSERT(!frameRegHelper->GetAlgorithmFactory());
+
+    itk::ModifiedTimeType mtime = frameRegHelper->GetMTime();
+    frameRegHelper->SetAlgorithmFactory([]() { return mitk::TimeFramesRegistrationHelper::RegistrationAlgorithmPointer(); });
+    CPPUNIT_ASSERT(mtime < frameRegHelper->GetMTime());
+    CPPUNIT_ASSERT(frameRegHelper->GetAlgorithmFactory());
+
+    frameRegHelper->SetAlgorithmFactory(nullptr);
+    CPPUNIT_ASSERT(!frameRegHelper->GetAlgorithmFactory());
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkTimeFramesRegistrationHelper)
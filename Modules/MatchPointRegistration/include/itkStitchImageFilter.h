@@ -22,6 +22,8 @@ found in the LICENSE file.
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkDataObjectDecorator.h"
 
+#include <vector>
+
 
 namespace itk
 {
@@ -53,6 +55,11 @@ namespace itk
  * - Mean: a weighted sum of all voxels mapped input pixel values will be calculated.
  * - BorderDistance: the voxels will be chosen that have the largest minimal distance to its own image borders.
  *
+ * The output is processed region-parallel. To skip inputs early, the output is divided into bricks
+ * (see BrickSize) and for every brick the inputs that can contribute to it are determined once
+ * before the threaded generation. For inputs with linear transforms this test is exact, inputs
+ * with non linear transforms are assumed to contribute to every brick.
+ *
  * All other behaviors are similar to itk::ResampleImageFilter. See the filter's description for
  * more details.
  */
@@ -223,6 +230,11 @@ public:
   itkSetMacro(StitchStrategy, StitchStrategy);
   itkGetConstMacro(StitchStrategy, StitchStrategy);
 
+  /** Get/Set the size (in output pixels) of the bricks that are used to determine which inputs
+   * contribute to which part of the output. Default is 16 in every dimension.*/
+  itkSetMacro(BrickSize, SizeType);
+  itkGetConstReferenceMacro(BrickSize, SizeType);
+
   /** StitchImageFilter produces an image which is a different size
    * than its input.  As such, it needs to provide an implementation
    * for GenerateOutputInformation() in order to inform the pipeline
@@ -267,17 +279,16 @@ protected:
    */
   virtual void VerifyInputInformation() const ITK_OVERRIDE { }
 
-  /** StitchImageFilter can be implemented as a multithreaded filter.
-   * Therefore, this implementation provides a ThreadedGenerateData()
-   * routine which is called for each processing thread. The output
+  /** StitchImageFilter is implemented as a multithreaded filter.
+   * Therefore, this implementation provides a DynamicThreadedGenerateData()
+   * routine which is called for each piece of the output. The output
    * image data is allocated automatically by the superclass prior
-   * to calling ThreadedGenerateData().
-   * ThreadedGenerateData can only write to the portion of the output image
+   * to calling DynamicThreadedGenerateData().
+   * DynamicThreadedGenerateData can only write to the portion of the output image
    * specified by the parameter "outputRegionForThread"
-   * \sa ImageToImageFilter::ThreadedGenerateData(),
+   * \sa ImageToImageFilter::DynamicThreadedGenerateData(),
    *     ImageToImageFilter::GenerateData() */
-  virtual void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
-                                    ThreadIdType threadId) ITK_OVERRIDE;
+  virtual void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) ITK_OVERRIDE;
 
   /** Cast pixel from interpolator output to PixelType. */
   virtual PixelType CastPixelWithBoundsChecking( const InterpolatorOutputType value,
@@ -302,11 +313,29 @@ private:
   ITK_DISALLOW_COPY_AND_ASSIGN(StitchImageFilter);
 
   typedef std::vector<const InputImageType*> InputImageVectorType;
-  typedef std::map<const InputImageType*, typename TransformType::ConstPointer> TransformMapType;
   typedef std::map<const InputImageType*, InterpolatorPointerType> InterpolatorMapType;
 
   InputImageVectorType GetInputs();
-  TransformMapType GetTransforms();
+
+  /** Everything that is needed to evaluate an input while generating the output.
+   Collected in BeforeThreadedGenerateData, so that the threads only read it.*/
+  struct InputInformation
+  {
+    const InputImageType* Image;
+    const TransformType* Transform;
+    const InterpolatorType* Interpolator;
+    typename InputImageType::IndexType LowerIndex;
+    typename InputImageType::IndexType UpperIndex;
+    typename InputImageType::SpacingType Spacing;
+  };
+
+  /** Determines for every brick of the output the inputs that can contribute to it.*/
+  void GenerateBrickInputs();
+
+  std::vector<InputInformation> m_InputInformation;
+  SizeType m_NumberOfBricks;
+  /** Indices (in m_InputInformation) of the contributing inputs per brick.*/
+  std::vector<std::vector<unsigned int> > m_BrickInputs;
 
   InterpolatorMapType m_Interpolators;   // Image function for
                                           // interpolation
@@ -320,6 +349,7 @@ private:
   IndexType       m_OutputStartIndex;     // output image start index
   bool            m_UseReferenceImage;
   StitchStrategy  m_StitchStrategy;
+  SizeType        m_BrickSize;
 };
 } // end namespace itk
 
@@ -16,13 +16,14 @@ found in the LICENSE file.
 #include "itkStitchImageFilter.h"
 #include "itkObjectFactory.h"
 #include "itkIdentityTransform.h"
-#include "itkProgressReporter.h"
+#include "itkTotalProgressReporter.h"
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageScanlineIterator.h"
 #include "itkSpecialCoordinatesImage.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkSimpleDataObjectDecorator.h"
 
+#include <algorithm>
 #include <numeric>
 
 namespace itk
@@ -39,9 +40,8 @@ StitchImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTrans
   m_UseReferenceImage( false ),
   m_StitchStrategy(StitchStrategy::Mean)
 {
-  this->DynamicMultiThreadingOff();
-
   m_Size.Fill( 0 );
+  m_BrickSize.Fill( 16 );
   m_OutputStartIndex.Fill( 0 );
 
   m_OutputDirection.SetIdentity();
@@ -219,6 +219,24 @@ StitchImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTrans
     interpolator.second->SetInputImage(interpolator.first);
   }
 
+  // Collect the input information in a plain vector. The threads must not use the
+  // maps (operator[] may insert) and should not repeat the look ups for every pixel.
+  m_InputInformation.clear();
+  for (unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); ++i)
+  {
+    InputInformation info;
+    info.Image = this->GetInput(i);
+    info.Transform = this->GetTransform(i);
+    info.Interpolator = m_Interpolators[info.Image].GetPointer();
+    const auto largestRegion = info.Image->GetLargestPossibleRegion();
+    info.LowerIndex = largestRegion.GetIndex();
+    info.UpperIndex = largestRegion.GetUpperIndex();
+    info.Spacing = info.Image->GetSpacing();
+    m_InputInformation.push_back(info);
+  }
+
+  this->GenerateBrickInputs();
+
   unsigned int nComponents
     = DefaultConvertPixelTraits<PixelType>::GetNumberOfComponents(
         m_DefaultPixelValue );
@@ -250,6 +268,105 @@ StitchImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTrans
   {
     interpolator.second->SetInputImage(ITK_NULLPTR);
   }
+
+  m_InputInformation.clear();
+  m_BrickInputs.clear();
+}
+
+template< typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType >
+void
+StitchImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType >
+::GenerateBrickInputs()
+{
+  const OutputImageType* outputPtr = this->GetOutput();
+  const auto outputRegion = outputPtr->GetLargestPossibleRegion();
+
+  SizeValueType numberOfBricks = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    if (0 == m_BrickSize[d])
+    {
+      itkExceptionMacro(<< "Brick size must not be 0 (dimension: " << d << ").");
+    }
+    m_NumberOfBricks[d] = (outputRegion.GetSize(d) + m_BrickSize[d] - 1) / m_BrickSize[d];
+    numberOfBricks *= m_NumberOfBricks[d];
+  }
+
+  m_BrickInputs.assign(numberOfBricks, std::vector<unsigned int>());
+
+  const unsigned int numberOfCorners = 1u << ImageDimension;
+
+  for (SizeValueType brickID = 0; brickID < numberOfBricks; ++brickID)
+  {
+    // Output index range covered by the brick
+    IndexType brickLower;
+    IndexType brickUpper;
+    SizeValueType remainder = brickID;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const auto brickIndex = remainder % m_NumberOfBricks[d];
+      remainder /= m_NumberOfBricks[d];
+      const auto brickSize = static_cast<IndexValueType>(m_BrickSize[d]);
+      brickLower[d] = outputRegion.GetIndex(d) + static_cast<IndexValueType>(brickIndex) * brickSize;
+      brickUpper[d] = std::min<IndexValueType>(brickLower[d] + brickSize, outputRegion.GetUpperIndex()[d] + 1) - 1;
+    }
+
+    for (unsigned int inputID = 0; inputID < m_InputInformation.size(); ++inputID)
+    {
+      const auto& info = m_InputInformation[inputID];
+
+      if (!info.Transform->IsLinear())
+      {
+        // No cheap conservative bound available, the input is checked for every pixel.
+        m_BrickInputs[brickID].push_back(inputID);
+        continue;
+      }
+
+      // All pixel centers of the brick are convex combinations of its corner pixel centers.
+      // With a linear transform the same holds in the input index space, thus the bounding
+      // box of the mapped corners contains every position the input is evaluated at.
+      ContinuousInputIndexType minIndex;
+      ContinuousInputIndexType maxIndex;
+      minIndex.Fill(NumericTraits<TTransformPrecisionType>::max());
+      maxIndex.Fill(NumericTraits<TTransformPrecisionType>::NonpositiveMin());
+
+      for (unsigned int corner = 0; corner < numberOfCorners; ++corner)
+      {
+        IndexType cornerIndex;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          cornerIndex[d] = (corner >> d) & 1u ? brickUpper[d] : brickLower[d];
+        }
+
+        PointType outputPoint;
+        outputPtr->TransformIndexToPhysicalPoint(cornerIndex, outputPoint);
+        const PointType inputPoint = info.Transform->TransformPoint(outputPoint);
+        ContinuousInputIndexType inputIndex;
+        info.Image->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          minIndex[d] = std::min(minIndex[d], inputIndex[d]);
+          maxIndex[d] = std::max(maxIndex[d], inputIndex[d]);
+        }
+      }
+
+      bool overlaps = true;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        // same half pixel margin the interpolators use for IsInsideBuffer
+        overlaps = overlaps && maxIndex[d] >= info.LowerIndex[d] - 0.5 && minIndex[d] <= info.UpperIndex[d] + 0.5;
+      }
+
+      if (overlaps)
+      {
+        m_BrickInputs[brickID].push_back(inputID);
+      }
+    }
+  }
 }
 
 template< typename TInputImage,
@@ -258,8 +375,7 @@ template< typename TInputImage,
           typename TTransformPrecisionType >
 void
 StitchImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType >
-::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
-                       ThreadIdType threadId)
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
 {
 
   if( outputRegionForThread.GetNumberOfPixels() == 0 )
@@ -269,22 +385,10 @@ StitchImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTrans
 
   // Get the output pointers
   OutputImageType* outputPtr = this->GetOutput();
-  // Get this input pointers
-  InputImageVectorType inputs = this->GetInputs();
-  TransformMapType transforms = this->GetTransforms();
+  const auto outputRegion = outputPtr->GetLargestPossibleRegion();
 
-  std::map<const InputImageType*, typename InputImageType::IndexType> lowerIndices;
-  std::map<const InputImageType*, typename InputImageType::IndexType> upperIndices;
-  for (const auto& input : inputs)
-  {
-    const auto largestRegion = input->GetLargestPossibleRegion();
-    lowerIndices[input] = largestRegion.GetIndex();
-    upperIndices[input] = largestRegion.GetUpperIndex();
-  }
-
-  // Create an iterator that will walk the output region for this thread.
-  typedef ImageRegionIteratorWithIndex< OutputImageType > OutputIterator;
-  OutputIterator outIt(outputPtr, outputRegionForThread);
+  // Support for progress methods/callbacks
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
   // Define a few indices that will be used to translate from an input pixel
   // to an output pixel
@@ -293,11 +397,6 @@ StitchImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTrans
 
   ContinuousInputIndexType inputIndex;
 
-  // Support for progress methods/callbacks
-  ProgressReporter progress(this,
-    threadId,
-    outputRegionForThread.GetNumberOfPixels());
-
   // Min/max values of the output pixel type AND these values
   // represented as the output type of the interpolator
   const PixelComponentType minValue = NumericTraits< PixelComponentType >::NonpositiveMin();
@@ -307,60 +406,111 @@ StitchImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTrans
   const ComponentType minOutputValue = static_cast<ComponentType>(minValue);
   const ComponentType maxOutputValue = static_cast<ComponentType>(maxValue);
 
-  // Walk the output region
-  outIt.GoToBegin();
+  std::vector<PixelType> pixvals;
+  std::vector<double> pixDistance;
+  pixvals.reserve(m_InputInformation.size());
+  pixDistance.reserve(m_InputInformation.size());
+
+  // Range of bricks that intersect the region of this thread
+  IndexType firstBrick;
+  SizeType brickCount;
+  SizeValueType numberOfBricks = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const auto brickSize = static_cast<IndexValueType>(m_BrickSize[d]);
+    firstBrick[d] = (outputRegionForThread.GetIndex(d) - outputRegion.GetIndex(d)) / brickSize;
+    const IndexValueType lastBrick = (outputRegionForThread.GetUpperIndex()[d] - outputRegion.GetIndex(d)) / brickSize;
+    brickCount[d] = lastBrick - firstBrick[d] + 1;
+    numberOfBricks *= brickCount[d];
+  }
 
-  while (!outIt.IsAtEnd())
+  for (SizeValueType brickNumber = 0; brickNumber < numberOfBricks; ++brickNumber)
   {
-    // Determine the index of the current output pixel
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
+    // Determine the brick and its intersection with the region of this thread
+    SizeValueType remainder = brickNumber;
+    SizeValueType brickID = 0;
+    SizeValueType brickStride = 1;
+    OutputImageRegionType brickRegion;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const IndexValueType brickIndex = firstBrick[d] + static_cast<IndexValueType>(remainder % brickCount[d]);
+      remainder /= brickCount[d];
+      brickID += static_cast<SizeValueType>(brickIndex) * brickStride;
+      brickStride *= m_NumberOfBricks[d];
+
+      const auto brickSize = static_cast<IndexValueType>(m_BrickSize[d]);
+      const IndexValueType lower = std::max<IndexValueType>(outputRegion.GetIndex(d) + brickIndex * brickSize, outputRegionForThread.GetIndex(d));
+      const IndexValueType upper = std::min<IndexValueType>(outputRegion.GetIndex(d) + (brickIndex + 1) * brickSize - 1, outputRegionForThread.GetUpperIndex()[d]);
+      brickRegion.SetIndex(d, lower);
+      brickRegion.SetSize(d, upper - lower + 1);
+    }
 
-    std::vector<PixelType> pixvals;
-    std::vector<double> pixDistance;
+    const auto& brickInputs = m_BrickInputs[brickID];
+
+    // Create an iterator that will walk the part of the brick for this thread.
+    typedef ImageRegionIteratorWithIndex< OutputImageType > OutputIterator;
+    OutputIterator outIt(outputPtr, brickRegion);
+
+    if (brickInputs.empty())
+    {
+      for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+      {
+        outIt.Set(m_DefaultPixelValue); // default background value
+      }
+      progress.Completed(brickRegion.GetNumberOfPixels());
+      continue;
+    }
 
-    for (const auto& input : inputs)
+    for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
     {
-      // Compute corresponding input pixel position
-      inputPoint = transforms[input]->TransformPoint(outputPoint);
-      const bool isInsideInput = input->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+      // Determine the index of the current output pixel
+      outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
+
+      pixvals.clear();
+      pixDistance.clear();
 
-      // Evaluate input at right position and copy to the output
-      if (m_Interpolators[input]->IsInsideBuffer(inputIndex) && isInsideInput)
+      for (const auto inputID : brickInputs)
       {
-        OutputType value = m_Interpolators[input]->EvaluateAtContinuousIndex(inputIndex);
-        pixvals.emplace_back(this->CastPixelWithBoundsChecking(value, minOutputValue, maxOutputValue));
+        const auto& info = m_InputInformation[inputID];
 
-        const auto spacing = input->GetSpacing();
+        // Compute corresponding input pixel position
+        inputPoint = info.Transform->TransformPoint(outputPoint);
+        const bool isInsideInput = info.Image->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
 
-        double minBorderDistance = std::numeric_limits<double>::max();
-        for (unsigned int i = 0; i < ImageDimension; ++i)
+        // Evaluate input at right position and copy to the output
+        if (isInsideInput && info.Interpolator->IsInsideBuffer(inputIndex))
         {
-          minBorderDistance = std::min(minBorderDistance, std::min(std::abs(lowerIndices[input][i] - inputIndex[i]) * spacing[i], std::abs(upperIndices[input][i] - inputIndex[i]) * spacing[i]));
+          OutputType value = info.Interpolator->EvaluateAtContinuousIndex(inputIndex);
+          pixvals.emplace_back(this->CastPixelWithBoundsChecking(value, minOutputValue, maxOutputValue));
+
+          double minBorderDistance = std::numeric_limits<double>::max();
+          for (unsigned int i = 0; i < ImageDimension; ++i)
+          {
+            minBorderDistance = std::min(minBorderDistance, std::min(std::abs(info.LowerIndex[i] - inputIndex[i]) * info.Spacing[i], std::abs(info.UpperIndex[i] - inputIndex[i]) * info.Spacing[i]));
+          }
+          pixDistance.emplace_back(minBorderDistance);
         }
-        pixDistance.emplace_back(minBorderDistance);
       }
-    }
 
-    if (!pixvals.empty())
-    { //at least one input provided a value
-      if (StitchStrategy::Mean == m_StitchStrategy)
-      {
-        double sum = std::accumulate(pixvals.begin(), pixvals.end(), 0.0);
-        outIt.Set(sum / pixvals.size());
+      if (!pixvals.empty())
+      { //at least one input provided a value
+        if (StitchStrategy::Mean == m_StitchStrategy)
+        {
+          double sum = std::accumulate(pixvals.begin(), pixvals.end(), 0.0);
+          outIt.Set(sum / pixvals.size());
+        }
+        else
+        {
+          auto finding = std::max_element(pixDistance.begin(), pixDistance.end());
+          outIt.Set(pixvals[std::distance(pixDistance.begin(), finding)]);
+        }
       }
       else
       {
-        auto finding = std::max_element(pixDistance.begin(), pixDistance.end());
-        outIt.Set(pixvals[std::distance(pixDistance.begin(), finding)]);
+        outIt.Set(m_DefaultPixelValue); // default background value
       }
+      progress.CompletedPixel();
     }
-    else
-    {
-      outIt.Set(m_DefaultPixelValue); // default background value
-    }
-
-    progress.CompletedPixel();
-    ++outIt;
   }
 }
 
@@ -419,21 +569,6 @@ StitchImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransf
   return inputs;
 }
 
-template<typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType, typename TTransformPrecisionType>
-typename StitchImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::TransformMapType
-StitchImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>
-::GetTransforms()
-{
-  TransformMapType transforms;
-  for (unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); ++i)
-  {
-    auto input = this->GetInput(i);
-    auto transform = this->GetTransform(i);
-    transforms[input] = transform;
-  }
-  return transforms;
-}
-
 template< typename TInputImage,
           typename TOutputImage,
           typename TInterpolatorPrecisionType,
@@ -561,6 +696,7 @@ StitchImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTrans
   {
     os << indent << "Interpolator: " << interpolator.second.GetPointer() << std::endl;
   }
+  os << indent << "BrickSize: " << m_BrickSize << std::endl;
   os << indent << "UseReferenceImage: " << ( m_UseReferenceImage ? "On" : "Off" )
      << std::endl;
 }
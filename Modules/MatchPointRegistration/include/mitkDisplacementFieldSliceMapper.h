@@ -0,0 +1,122 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDisplacementFieldSliceMapper_h
+#define mitkDisplacementFieldSliceMapper_h
+
+#include <mitkImage.h>
+
+#include <mapRegistrationBase.h>
+
+#include <itkImage.h>
+
+#include <array>
+#include <vector>
+
+#include "MitkMatchPointRegistrationExports.h"
+
+namespace mitk
+{
+  /** Helper that maps a moving image into (typically thin) result geometries, e.g. the slices shown by
+   * RegEvaluationMapper2D, without starting a MatchPoint mapping task for each of them.
+   *
+   * The inverse kernel of the registration is sampled once on a regular grid covering the field geometry
+   * (usually the target image) and cached as a dense displacement field, together with a float copy of the
+   * moving image. Each call of Map() then only interpolates the cached field and the moving image (both
+   * trilinearly) for every pixel of the result geometry. Rows of the result are processed in parallel.
+   * The cache is rebuilt automatically if the moving image, the registration, or the field geometry changes.
+   *
+   * To bound the memory footprint, the field grid is coarser than the field geometry if the latter has more
+   * than MaximumNumberOfFieldPoints voxels. For affine registrations the result is exact (up to floating point
+   * precision), for deformable registrations the coarser grid is an approximation suitable for visualization.
+   *
+   * Pixels that are mapped outside of the moving image get the padding value, pixels that the registration
+   * cannot map get the error value. The moving image is interpolated linearly, the result is of type float.
+   */
+  class MITKMATCHPOINTREGISTRATION_EXPORT DisplacementFieldSliceMapper : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(DisplacementFieldSliceMapper, itk::Object);
+
+    itkFactorylessNewMacro(Self);
+
+    typedef ::map::core::RegistrationBase RegistrationType;
+
+    itkSetMacro(PaddingValue, double);
+    itkGetConstMacro(PaddingValue, double);
+
+    itkSetMacro(ErrorValue, double);
+    itkGetConstMacro(ErrorValue, double);
+
+    /** Maximum number of grid points of the cached displacement field. Changing it invalidates the cache. */
+    void SetMaximumNumberOfFieldPoints(std::size_t numberOfPoints);
+    itkGetConstMacro(MaximumNumberOfFieldPoints, std::size_t);
+
+    /** Number of times the displacement field was sampled from the registration since construction. */
+    itkGetConstMacro(NumberOfFieldUpdates, unsigned int);
+
+    /** Indicates if the given inputs can be mapped by this helper. Supported are 3D registrations and
+     * moving images with a single time step and scalar pixels that are no LabelSetImage.*/
+    static bool IsSupported(const Image* movingImage, const RegistrationType* registration);
+
+    /** Maps the moving image into the result geometry.
+     * @param movingImage Image that should be mapped.
+     * @param registration Registration whose inverse kernel is used for mapping.
+     * @param fieldGeometry Region of the target space for which the displacement field is cached.
+     * @param resultGeometry Image geometry of the result. It should lie within the field geometry,
+     * outside of it the displacement field is extrapolated by its border values.
+     * @pre IsSupported(movingImage, registration) must be true and both geometries must be valid.*/
+    Image::Pointer Map(const Image* movingImage, const RegistrationType* registration,
+      const BaseGeometry* fieldGeometry, const BaseGeometry* resultGeometry);
+
+    /** Releases the cached displacement field and moving image data. */
+    void ClearCache();
+
+  protected:
+    DisplacementFieldSliceMapper();
+    ~DisplacementFieldSliceMapper() override;
+
+  private:
+    typedef itk::Image<float, 3> MovingImageType;
+
+    struct Affine
+    {
+      std::array<std::array<double, 3>, 3> Matrix;
+      std::array<double, 3> Offset;
+    };
+
+    void UpdateCache(const Image* movingImage, const RegistrationType* registration, const BaseGeometry* fieldGeometry);
+    void UpdateField(const RegistrationType* registration, const BaseGeometry* fieldGeometry);
+
+    double m_PaddingValue;
+    double m_ErrorValue;
+    std::size_t m_MaximumNumberOfFieldPoints;
+    unsigned int m_NumberOfFieldUpdates;
+
+    const Image* m_CachedMovingImage;
+    itk::ModifiedTimeType m_CachedMovingImageTime;
+    const RegistrationType* m_CachedRegistration;
+    itk::ModifiedTimeType m_CachedRegistrationTime;
+    BaseGeometry::ConstPointer m_CachedFieldGeometry;
+    itk::ModifiedTimeType m_CachedFieldGeometryTime;
+
+    MovingImageType::Pointer m_MovingData;
+    Affine m_MovingWorldToIndex;
+
+    /** Displacements in moving index units (3 components per grid point), NaN if not mappable. */
+    std::vector<float> m_Field;
+    std::array<std::size_t, 3> m_FieldSize;
+    Affine m_WorldToFieldGrid;
+  };
+}
+
+#endif
@@ -23,6 +23,8 @@ found in the LICENSE file.
 
 #include "MitkMatchPointRegistrationExports.h"
 
+#include <functional>
+
 namespace mitk
 {
   struct ImageMappingInterpolator
@@ -47,6 +49,20 @@ namespace mitk
     typedef ::mitk::Image InputImageType;
     typedef ::mitk::Image ResultImageType;
 
+    /**Callback that is called whenever a time step of a dynamic image was mapped. Passed are the number of
+     * time steps that are mapped so far and the total number of time steps. The callback may be called from
+     * worker threads, but calls never overlap.*/
+    typedef std::function<void(unsigned int, unsigned int)> TimeStepProgressCallbackType;
+
+    /**Sets the maximum number of time steps of dynamic images that are mapped concurrently. Concurrent mapping
+     * is opt-in: 0 and 1 (default 0) map the time steps one after another. Every time step is already mapped
+     * multi-threaded by ITK and the work units of the MatchPoint mapping tasks cannot be limited, so concurrent
+     * time steps mainly pay off for registrations whose kernels are evaluated single-threaded. Each concurrently
+     * mapped time step holds a copy of its input frame and its mapped frame in memory. The number is never
+     * larger than the number of available cores.*/
+    MITKMATCHPOINTREGISTRATION_EXPORT void SetMaximumNumberOfConcurrentTimeSteps(unsigned int numberOfTimeSteps);
+    MITKMATCHPOINTREGISTRATION_EXPORT unsigned int GetMaximumNumberOfConcurrentTimeSteps();
+
     /**Helper that maps a given input image
      * @param input Image that should be mapped.
      * @param registration Pointer to the registration instance that should be used for mapping
@@ -56,6 +72,7 @@ namespace mitk
      * @param throwOnMappingError Indicates if mapping should fail with an exception (true), if the registration does not cover/support the whole requested region for mapping into the result image.
      * @param errorValue Indicates the value that should be used if an mapping error occurs (and throwOnMappingError is false).
      * @param interpolatorType Indicates the type of interpolation strategy that should be used.
+     * @param progressCallback Optional callback that is called after each mapped time step of a dynamic input image.
      * @pre input must be valid
      * @pre registration must be valid
      * @pre Dimensionality of the registration must match with the input imageinput must be valid
@@ -65,7 +82,8 @@ namespace mitk
     MITKMATCHPOINTREGISTRATION_EXPORT ResultImageType::Pointer map(const InputImageType* input, const RegistrationType* registration,
       bool throwOnOutOfInputAreaError = false, const double& paddingValue = 0,
       const ResultImageGeometryType* resultGeometry = nullptr,
-      bool throwOnMappingError = true, const double& errorValue = 0, mitk::ImageMappingInterpolator::Type interpolatorType = mitk::ImageMappingInterpolator::Linear);
+      bool throwOnMappingError = true, const double& errorValue = 0, mitk::ImageMappingInterpolator::Type interpolatorType = mitk::ImageMappingInterpolator::Linear,
+      const TimeStepProgressCallbackType& progressCallback = nullptr);
 
     /**Helper that maps a given input image.
      * @overload
@@ -77,6 +95,7 @@ namespace mitk
      * @param throwOnMappingError Indicates if mapping should fail with an exception (true), if the registration does not cover/support the whole requested region for mapping into the result image.
      * @param errorValue Indicates the value that should be used if an mapping error occurs (and throwOnMappingError is false).
      * @param interpolatorType Indicates the type of interpolation strategy that should be used.
+     * @param progressCallback Optional callback that is called after each mapped time step of a dynamic input image.
      * @pre input must be valid
      * @pre registration must be valid
      * @pre Dimensionality of the registration must match with the input imageinput must be valid
@@ -86,7 +105,8 @@ namespace mitk
     MITKMATCHPOINTREGISTRATION_EXPORT ResultImageType::Pointer map(const InputImageType* input, const MITKRegistrationType* registration,
       bool throwOnOutOfInputAreaError = false, const double& paddingValue = 0,
       const ResultImageGeometryType* resultGeometry = nullptr,
-      bool throwOnMappingError = true, const double& errorValue = 0, mitk::ImageMappingInterpolator::Type interpolatorType = mitk::ImageMappingInterpolator::Linear);
+      bool throwOnMappingError = true, const double& errorValue = 0, mitk::ImageMappingInterpolator::Type interpolatorType = mitk::ImageMappingInterpolator::Linear,
+      const TimeStepProgressCallbackType& progressCallback = nullptr);
 
     MITKMATCHPOINTREGISTRATION_EXPORT ResultImageGeometryType::Pointer GenerateSuperSampledGeometry(const ResultImageGeometryType* inputGeometry,
       double xScaling, double yScaling, double zScaling);
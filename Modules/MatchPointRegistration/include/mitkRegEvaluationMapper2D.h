@@ -24,6 +24,7 @@ found in the LICENSE file.
 #include "mitkBaseRenderer.h"
 #include "mitkVtkMapper.h"
 #include "mitkExtractSliceFilter.h"
+#include "mitkDisplacementFieldSliceMapper.h"
 
 //VTK
 #include <vtkSmartPointer.h>
@@ -146,6 +147,9 @@ public:
   /** \brief The LocalStorageHandler holds all (three) LocalStorages for the three 2D render windows. */
   mitk::LocalStorageHandler<LocalStorage> m_LSH;
 
+  /** \brief Caches the displacement field of the registration for all renderers and maps the slices of the moving image. */
+  mitk::DisplacementFieldSliceMapper::Pointer m_FieldSliceMapper;
+
   /** \brief Get the LocalStorage corresponding to the current renderer. */
   LocalStorage* GetLocalStorage(mitk::BaseRenderer* renderer);
 
@@ -24,6 +24,9 @@ found in the LICENSE file.
 
 #include "MitkMatchPointRegistrationExports.h"
 
+#include <atomic>
+#include <functional>
+
 namespace mitk
 {
 
@@ -39,6 +42,12 @@ namespace mitk
    * - mitk::FrameRegistrationEvent: when ever a frame was registered.
    * - mitk::FrameMappingEvent: when ever a frame was mapped registered.
    * - itk::ProgressEvent: when ever a new frame was added to the result image.
+   *
+   * Frames are processed concurrently by a bounded number of worker threads (see MaximumNumberOfConcurrentFrames),
+   * thus the events are invoked from worker threads (but never concurrently) and not necessarily in frame order.
+   * A registration algorithm instance is stateful and can only register one frame at a time. If only the algorithm is
+   * set, registrations are serialized and only the mapping of frames runs in parallel. If an algorithm factory is set,
+   * every worker registers its frames with its own algorithm instance.
    */
   class MITKMATCHPOINTREGISTRATION_EXPORT TimeFramesRegistrationHelper : public itk::Object
   {
@@ -54,6 +63,9 @@ namespace mitk
 
     typedef std::vector<mitk::TimeStepType> IgnoreListType;
 
+    /** Function that returns a new, completely configured algorithm instance (equivalent to the algorithm set via SetAlgorithm).*/
+    typedef std::function<RegistrationAlgorithmPointer()> AlgorithmFactoryType;
+
     itkSetConstObjectMacro(4DImage, Image);
     itkGetConstObjectMacro(4DImage, Image);
 
@@ -63,6 +75,18 @@ namespace mitk
     itkSetObjectMacro(Algorithm, RegistrationAlgorithmBaseType);
     itkGetObjectMacro(Algorithm, RegistrationAlgorithmBaseType);
 
+    /** Sets a factory that is used to create an algorithm instance for every worker thread, so that frames can be
+     * registered concurrently. If no factory is set (default), all frames are registered with the set algorithm.*/
+    void SetAlgorithmFactory(const AlgorithmFactoryType& factory);
+    const AlgorithmFactoryType& GetAlgorithmFactory() const;
+
+    /** Maximum number of frames that are processed concurrently. Each processed frame holds its moving and mapped
+     * frame image in memory. As registration and mapping are multi-threaded by ITK, 0 (default) uses the number of
+     * available cores divided by the global default number of ITK threads. The number is never larger than the
+     * number of available cores.*/
+    itkSetMacro(MaximumNumberOfConcurrentFrames, unsigned int);
+    itkGetConstMacro(MaximumNumberOfConcurrentFrames, unsigned int);
+
     itkSetMacro(AllowUndefPixels, bool);
     itkGetConstMacro(AllowUndefPixels, bool);
 
@@ -110,6 +134,7 @@ namespace mitk
       m_AllowUnregPixels(true),
       m_ErrorValue(0),
       m_InterpolatorType(mitk::ImageMappingInterpolator::Linear),
+      m_MaximumNumberOfConcurrentFrames(0),
       m_Progress(0)
     {
       m_4DImage = nullptr;
@@ -121,6 +146,9 @@ namespace mitk
 
     RegistrationPointer DoFrameRegistration(const mitk::Image* movingFrame,
                                             const mitk::Image* targetFrame, const mitk::Image* targetMask) const;
+    /** @overload Registers the frames with the passed algorithm instead of m_Algorithm.*/
+    RegistrationPointer DoFrameRegistration(RegistrationAlgorithmBaseType* algorithm, const mitk::Image* movingFrame,
+                                            const mitk::Image* targetFrame, const mitk::Image* targetMask) const;
 
     mitk::Image::Pointer DoFrameMapping(const mitk::Image* movingFrame, const RegistrationType* reg,
                                         const mitk::Image* targetFrame) const;
@@ -152,7 +180,10 @@ namespace mitk
     /** Type of interpolator. Only relevant for images and if m_doGeometryRefinement is false. */
     mitk::ImageMappingInterpolator::Type m_InterpolatorType;
 
-    double m_Progress;
+    AlgorithmFactoryType m_AlgorithmFactory;
+    unsigned int m_MaximumNumberOfConcurrentFrames;
+
+    std::atomic<double> m_Progress;
   };
 
 }
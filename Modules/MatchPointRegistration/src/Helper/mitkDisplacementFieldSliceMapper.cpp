@@ -0,0 +1,416 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDisplacementFieldSliceMapper.h"
+
+#include <mitkImageCast.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+
+#include <mapRegistration.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  typedef ::map::core::Registration<3, 3> ConcreteRegistrationType;
+  typedef ::map::core::RegistrationKernelBase<3, 3> KernelType;
+
+  template <typename TAffine>
+  void Apply(const TAffine& affine, const double in[3], double out[3])
+  {
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      out[i] = affine.Offset[i];
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        out[i] += affine.Matrix[i][j] * in[j];
+      }
+    }
+  }
+
+  /** Returns the affine a after b (x -> a(b(x))). */
+  template <typename TAffine>
+  TAffine Compose(const TAffine& a, const TAffine& b)
+  {
+    TAffine result;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      result.Offset[i] = a.Offset[i];
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        result.Offset[i] += a.Matrix[i][j] * b.Offset[j];
+        result.Matrix[i][j] = 0.;
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+          result.Matrix[i][j] += a.Matrix[i][k] * b.Matrix[k][j];
+        }
+      }
+    }
+    return result;
+  }
+
+  template <typename TAffine>
+  TAffine GetIndexToWorld(const mitk::BaseGeometry* geometry)
+  {
+    TAffine result;
+    const auto* transform = geometry->GetIndexToWorldTransform();
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      result.Offset[i] = transform->GetOffset()[i];
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        result.Matrix[i][j] = transform->GetMatrix()[i][j];
+      }
+    }
+    return result;
+  }
+
+  template <typename TAffine>
+  TAffine GetWorldToIndex(const mitk::BaseGeometry* geometry)
+  {
+    auto inverse = mitk::AffineTransform3D::New();
+    if (!geometry->GetIndexToWorldTransform()->GetInverse(inverse))
+    {
+      mitkThrow() << "Cannot map image. Index to world transform of geometry is not invertible.";
+    }
+
+    TAffine result;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      result.Offset[i] = inverse->GetOffset()[i];
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        result.Matrix[i][j] = inverse->GetMatrix()[i][j];
+      }
+    }
+    return result;
+  }
+
+  std::size_t GetExtent(const mitk::BaseGeometry* geometry, unsigned int axis)
+  {
+    return static_cast<std::size_t>(std::max(1., std::round(geometry->GetExtent(axis))));
+  }
+
+  /** Trilinear interpolation of a volume with the given number of components per voxel.
+   Coordinates are clamped to the volume, thus border values are extrapolated.*/
+  inline void InterpolateClamped(const float* data, const std::array<std::size_t, 3>& size, unsigned int components,
+    const double position[3], float* result)
+  {
+    std::size_t lower[3];
+    std::size_t upper[3];
+    double weight[3];
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      const double maxPosition = static_cast<double>(size[i] - 1);
+      const double p = std::min(std::max(position[i], 0.), maxPosition);
+      const double floorP = std::floor(p);
+      lower[i] = static_cast<std::size_t>(floorP);
+      upper[i] = std::min(lower[i] + 1, size[i] - 1);
+      weight[i] = p - floorP;
+    }
+
+    const std::size_t strideY = size[0];
+    const std::size_t strideZ = size[0] * size[1];
+
+    for (unsigned int c = 0; c < components; ++c)
+    {
+      auto value = [&](std::size_t x, std::size_t y, std::size_t z) {
+        return static_cast<double>(data[(z * strideZ + y * strideY + x) * components + c]);
+      };
+
+      const double c00 = value(lower[0], lower[1], lower[2]) * (1. - weight[0]) + value(upper[0], lower[1], lower[2]) * weight[0];
+      const double c10 = value(lower[0], upper[1], lower[2]) * (1. - weight[0]) + value(upper[0], upper[1], lower[2]) * weight[0];
+      const double c01 = value(lower[0], lower[1], upper[2]) * (1. - weight[0]) + value(upper[0], lower[1], upper[2]) * weight[0];
+      const double c11 = value(lower[0], upper[1], upper[2]) * (1. - weight[0]) + value(upper[0], upper[1], upper[2]) * weight[0];
+      const double c0 = c00 * (1. - weight[1]) + c10 * weight[1];
+      const double c1 = c01 * (1. - weight[1]) + c11 * weight[1];
+
+      result[c] = static_cast<float>(c0 * (1. - weight[2]) + c1 * weight[2]);
+    }
+  }
+}
+
+mitk::DisplacementFieldSliceMapper::DisplacementFieldSliceMapper()
+  : m_PaddingValue(0.0),
+    m_ErrorValue(0.0),
+    m_MaximumNumberOfFieldPoints(1 << 21),
+    m_NumberOfFieldUpdates(0),
+    m_CachedMovingImage(nullptr),
+    m_CachedMovingImageTime(0),
+    m_CachedRegistration(nullptr),
+    m_CachedRegistrationTime(0),
+    m_CachedFieldGeometryTime(0),
+    m_FieldSize({0, 0, 0})
+{
+}
+
+mitk::DisplacementFieldSliceMapper::~DisplacementFieldSliceMapper()
+{
+}
+
+void mitk::DisplacementFieldSliceMapper::SetMaximumNumberOfFieldPoints(std::size_t numberOfPoints)
+{
+  numberOfPoints = std::max<std::size_t>(numberOfPoints, 8);
+
+  if (numberOfPoints != m_MaximumNumberOfFieldPoints)
+  {
+    m_MaximumNumberOfFieldPoints = numberOfPoints;
+    this->ClearCache();
+    this->Modified();
+  }
+}
+
+bool mitk::DisplacementFieldSliceMapper::IsSupported(const Image* movingImage, const RegistrationType* registration)
+{
+  if (nullptr == movingImage || nullptr == registration)
+  {
+    return false;
+  }
+
+  return nullptr != dynamic_cast<const ConcreteRegistrationType*>(registration) &&
+    nullptr == dynamic_cast<const LabelSetImage*>(movingImage) &&
+    movingImage->IsInitialized() &&
+    movingImage->GetDimension() >= 3 && movingImage->GetTimeSteps() == 1 &&
+    movingImage->GetPixelType().GetNumberOfComponents() == 1;
+}
+
+void mitk::DisplacementFieldSliceMapper::ClearCache()
+{
+  m_CachedMovingImage = nullptr;
+  m_CachedRegistration = nullptr;
+  m_CachedFieldGeometry = nullptr;
+  m_MovingData = nullptr;
+  m_Field.clear();
+  m_Field.shrink_to_fit();
+  m_FieldSize = {0, 0, 0};
+}
+
+void mitk::DisplacementFieldSliceMapper::UpdateCache(const Image* movingImage, const RegistrationType* registration, const BaseGeometry* fieldGeometry)
+{
+  const bool isValid = m_CachedMovingImage == movingImage && m_CachedMovingImageTime == movingImage->GetMTime() &&
+    m_CachedRegistration == registration && m_CachedRegistrationTime == registration->GetMTime() &&
+    m_CachedFieldGeometry.GetPointer() == fieldGeometry && m_CachedFieldGeometryTime == fieldGeometry->GetMTime();
+
+  if (isValid)
+  {
+    return;
+  }
+
+  // the field is stored in index units of the moving image, so every change requires a complete update
+  this->ClearCache();
+
+  CastToItkImage(movingImage, m_MovingData);
+  m_MovingWorldToIndex = GetWorldToIndex<Affine>(movingImage->GetGeometry());
+
+  this->UpdateField(registration, fieldGeometry);
+
+  m_CachedMovingImage = movingImage;
+  m_CachedMovingImageTime = movingImage->GetMTime();
+  m_CachedRegistration = registration;
+  m_CachedRegistrationTime = registration->GetMTime();
+  m_CachedFieldGeometry = fieldGeometry;
+  m_CachedFieldGeometryTime = fieldGeometry->GetMTime();
+}
+
+void mitk::DisplacementFieldSliceMapper::UpdateField(const RegistrationType* registration, const BaseGeometry* fieldGeometry)
+{
+  const auto& kernel = dynamic_cast<const ConcreteRegistrationType*>(registration)->getInverseMapping();
+
+  // Choose the grid: the voxel grid of the field geometry, uniformly coarsened if it exceeds the maximum size.
+  std::array<std::size_t, 3> extent = {GetExtent(fieldGeometry, 0), GetExtent(fieldGeometry, 1), GetExtent(fieldGeometry, 2)};
+  m_FieldSize = extent;
+
+  while (m_FieldSize[0] * m_FieldSize[1] * m_FieldSize[2] > m_MaximumNumberOfFieldPoints)
+  {
+    const double factor = std::cbrt(static_cast<double>(m_FieldSize[0] * m_FieldSize[1] * m_FieldSize[2]) / m_MaximumNumberOfFieldPoints);
+    for (auto& size : m_FieldSize)
+    {
+      if (size > 2)
+      {
+        size = std::max<std::size_t>(2, std::min(size - 1, static_cast<std::size_t>(std::ceil(size / factor))));
+      }
+    }
+  }
+
+  // grid point g is located at the continuous field index g * step
+  double step[3];
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    step[i] = m_FieldSize[i] > 1 ? static_cast<double>(extent[i] - 1) / static_cast<double>(m_FieldSize[i] - 1) : 1.;
+  }
+
+  Affine gridToFieldIndex;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    gridToFieldIndex.Offset[i] = 0.;
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      gridToFieldIndex.Matrix[i][j] = i == j ? step[i] : 0.;
+    }
+  }
+
+  const auto gridToWorld = Compose(GetIndexToWorld<Affine>(fieldGeometry), gridToFieldIndex);
+
+  Affine fieldIndexToGrid = gridToFieldIndex;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    fieldIndexToGrid.Matrix[i][i] = 1. / step[i];
+  }
+  m_WorldToFieldGrid = Compose(fieldIndexToGrid, GetWorldToIndex<Affine>(fieldGeometry));
+
+  m_Field.resize(3 * m_FieldSize[0] * m_FieldSize[1] * m_FieldSize[2]);
+
+  auto mapGridPoint = [this, &kernel, &gridToWorld](std::size_t x, std::size_t y, std::size_t z, float* displacement) {
+    const double gridPoint[3] = {static_cast<double>(x), static_cast<double>(y), static_cast<double>(z)};
+    double world[3];
+    Apply(gridToWorld, gridPoint, world);
+
+    KernelType::InputPointType regInput;
+    KernelType::OutputPointType regOutput;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      regInput[i] = world[i];
+    }
+
+    if (!kernel.mapPoint(regInput, regOutput))
+    {
+      displacement[0] = displacement[1] = displacement[2] = std::numeric_limits<float>::quiet_NaN();
+      return;
+    }
+
+    // store the displacement in index units of the moving image, so that Map() only has to add it
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      double value = 0.;
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        value += m_MovingWorldToIndex.Matrix[i][j] * (regOutput[j] - regInput[j]);
+      }
+      displacement[i] = static_cast<float>(value);
+    }
+  };
+
+  // Map the first point serially. Lazy field kernels generate their field on first access.
+  mapGridPoint(0, 0, 0, m_Field.data());
+
+  const std::size_t numberOfRows = m_FieldSize[1] * m_FieldSize[2];
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(0, numberOfRows, [this, &mapGridPoint](itk::SizeValueType row) {
+    const std::size_t y = row % m_FieldSize[1];
+    const std::size_t z = row / m_FieldSize[1];
+    float* displacement = m_Field.data() + 3 * row * m_FieldSize[0];
+
+    for (std::size_t x = 0; x < m_FieldSize[0]; ++x, displacement += 3)
+    {
+      mapGridPoint(x, y, z, displacement);
+    }
+  }, nullptr);
+
+  ++m_NumberOfFieldUpdates;
+}
+
+mitk::Image::Pointer mitk::DisplacementFieldSliceMapper::Map(const Image* movingImage, const RegistrationType* registration,
+  const BaseGeometry* fieldGeometry, const BaseGeometry* resultGeometry)
+{
+  if (!IsSupported(movingImage, registration))
+  {
+    mitkThrow() << "Cannot map image. Moving image or registration is not supported by DisplacementFieldSliceMapper.";
+  }
+  if (nullptr == fieldGeometry || nullptr == resultGeometry)
+  {
+    mitkThrow() << "Cannot map image. Passed geometry pointer is nullptr.";
+  }
+
+  this->UpdateCache(movingImage, registration, fieldGeometry);
+
+  auto result = Image::New();
+  result->Initialize(MakeScalarPixelType<float>(), *resultGeometry);
+
+  const std::array<std::size_t, 3> resultSize = {result->GetDimension(0), result->GetDimension(1), result->GetDimension(2)};
+
+  const auto resultIndexToWorld = GetIndexToWorld<Affine>(result->GetGeometry());
+  const auto resultToGrid = Compose(m_WorldToFieldGrid, resultIndexToWorld);
+  const auto resultToMoving = Compose(m_MovingWorldToIndex, resultIndexToWorld);
+
+  const auto movingRegionSize = m_MovingData->GetLargestPossibleRegion().GetSize();
+  const std::array<std::size_t, 3> movingSize = {movingRegionSize[0], movingRegionSize[1], movingRegionSize[2]};
+  const float* movingBuffer = m_MovingData->GetBufferPointer();
+
+  const auto padding = static_cast<float>(m_PaddingValue);
+  const auto error = static_cast<float>(m_ErrorValue);
+
+  ImageWriteAccessor accessor(result);
+  auto* resultBuffer = static_cast<float*>(accessor.GetData());
+
+  const std::size_t numberOfRows = resultSize[1] * resultSize[2];
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(0, numberOfRows, [&](itk::SizeValueType row) {
+    const double rowStart[3] = {0., static_cast<double>(row % resultSize[1]), static_cast<double>(row / resultSize[1])};
+
+    // grid and moving positions are affine in the result index, thus they are advanced incrementally along a row
+    double gridPosition[3];
+    double movingPosition[3];
+    Apply(resultToGrid, rowStart, gridPosition);
+    Apply(resultToMoving, rowStart, movingPosition);
+
+    const double gridStep[3] = {resultToGrid.Matrix[0][0], resultToGrid.Matrix[1][0], resultToGrid.Matrix[2][0]};
+    const double movingStep[3] = {resultToMoving.Matrix[0][0], resultToMoving.Matrix[1][0], resultToMoving.Matrix[2][0]};
+
+    float* output = resultBuffer + row * resultSize[0];
+
+    for (std::size_t x = 0; x < resultSize[0]; ++x)
+    {
+      float displacement[3];
+      InterpolateClamped(m_Field.data(), m_FieldSize, 3, gridPosition, displacement);
+
+      if (std::isnan(displacement[0]))
+      {
+        output[x] = error;
+      }
+      else
+      {
+        const double mappedPosition[3] = {movingPosition[0] + displacement[0], movingPosition[1] + displacement[1], movingPosition[2] + displacement[2]};
+
+        bool inside = true;
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          inside = inside && mappedPosition[i] >= -0.5 && mappedPosition[i] <= static_cast<double>(movingSize[i]) - 0.5;
+        }
+
+        if (inside)
+        {
+          InterpolateClamped(movingBuffer, movingSize, 1, mappedPosition, output + x);
+        }
+        else
+        {
+          output[x] = padding;
+        }
+      }
+
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        gridPosition[i] += gridStep[i];
+        movingPosition[i] += movingStep[i];
+      }
+    }
+  }, nullptr);
+
+  return result;
+}
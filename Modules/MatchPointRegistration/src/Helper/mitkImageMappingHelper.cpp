@@ -22,6 +22,13 @@ found in the LICENSE file.
 #include <mitkImageToItk.h>
 #include <mitkImageTimeSelector.h>
 #include <mitkLabelSetImage.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
 
 #include "mapRegistration.h"
 
@@ -70,12 +77,16 @@ typename ::itk::InterpolateImageFunction< TImage >::Pointer generateInterpolator
 };
 
 template <typename TPixelType, unsigned int VImageDimension >
-void doMITKMap(const ::itk::Image<TPixelType,VImageDimension>* input, mitk::ImageMappingHelper::ResultImageType::Pointer& result, const mitk::ImageMappingHelper::RegistrationType*& registration,
-  bool throwOnOutOfInputAreaError, const double& paddingValue, const mitk::ImageMappingHelper::ResultImageGeometryType*& resultGeometry,
+using ImageMappingTaskType = ::map::core::ImageMappingTask< ::map::core::Registration<VImageDimension,VImageDimension>, ::itk::Image<TPixelType,VImageDimension>, ::itk::Image<TPixelType,VImageDimension> >;
+
+/**Helper function that creates and configures the mapping task for an image.*/
+template <typename TPixelType, unsigned int VImageDimension >
+typename ImageMappingTaskType<TPixelType, VImageDimension>::Pointer createMappingTask(const ::itk::Image<TPixelType,VImageDimension>* input, const mitk::ImageMappingHelper::RegistrationType* registration,
+  bool throwOnOutOfInputAreaError, const double& paddingValue, const mitk::ImageMappingHelper::ResultImageGeometryType* resultGeometry,
   bool throwOnMappingError, const double& errorValue, mitk::ImageMappingInterpolator::Type interpolatorType)
 {
   typedef ::map::core::Registration<VImageDimension,VImageDimension> ConcreteRegistrationType;
-  typedef ::map::core::ImageMappingTask<ConcreteRegistrationType, ::itk::Image<TPixelType,VImageDimension>, ::itk::Image<TPixelType,VImageDimension> > MappingTaskType;
+  typedef ImageMappingTaskType<TPixelType, VImageDimension> MappingTaskType;
   typename MappingTaskType::Pointer spTask = MappingTaskType::New();
 
   typedef typename MappingTaskType::ResultImageDescriptorType ResultImageDescriptorType;
@@ -215,27 +226,180 @@ void doMITKMap(const ::itk::Image<TPixelType,VImageDimension>* input, mitk::Imag
   spTask->setThrowOnPaddingError(throwOnOutOfInputAreaError);
   spTask->setPaddingValue(paddingValue);
 
+  return spTask;
+}
+
+template <typename TPixelType, unsigned int VImageDimension >
+void doMITKMap(const ::itk::Image<TPixelType,VImageDimension>* input, mitk::ImageMappingHelper::ResultImageType::Pointer& result, const mitk::ImageMappingHelper::RegistrationType*& registration,
+  bool throwOnOutOfInputAreaError, const double& paddingValue, const mitk::ImageMappingHelper::ResultImageGeometryType*& resultGeometry,
+  bool throwOnMappingError, const double& errorValue, mitk::ImageMappingInterpolator::Type interpolatorType)
+{
+  auto spTask = createMappingTask(input, registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, interpolatorType);
+
   spTask->execute();
   mitk::CastToMitkImage<>(spTask->getResultImage(),result);
 }
 
+/**Maps the input (one time step) and copies the mapped pixels directly into the given time step of the
+ * preallocated result image. The copy is guarded by resultMutex, the mapping itself is not.*/
+template <typename TPixelType, unsigned int VImageDimension >
+void doMITKMapIntoTimeStep(const ::itk::Image<TPixelType,VImageDimension>* input, mitk::Image* result, unsigned int timeStep, std::mutex& resultMutex,
+  const mitk::ImageMappingHelper::RegistrationType* registration,
+  bool throwOnOutOfInputAreaError, double paddingValue, const mitk::ImageMappingHelper::ResultImageGeometryType* resultGeometry,
+  bool throwOnMappingError, double errorValue, mitk::ImageMappingInterpolator::Type interpolatorType)
+{
+  auto spTask = createMappingTask(input, registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, interpolatorType);
+
+  spTask->execute();
+  auto mappedImage = spTask->getResultImage();
+
+  std::size_t numberOfPixels = 1;
+  for (unsigned int i = 0; i < VImageDimension; ++i)
+  {
+    numberOfPixels *= result->GetDimension(i);
+  }
+
+  if (mappedImage->GetLargestPossibleRegion().GetNumberOfPixels() != numberOfPixels)
+  {
+    mitkThrow() << "Cannot map image. Size of mapped time step " << timeStep << " does not match the result image.";
+  }
+
+  std::lock_guard<std::mutex> lock(resultMutex);
+  mitk::ImageWriteAccessor writeAccess(result, result->GetVolumeData(timeStep));
+  std::memcpy(writeAccess.GetData(), mappedImage->GetBufferPointer(), numberOfPixels * sizeof(TPixelType));
+}
+
+namespace
+{
+  std::atomic<unsigned int> maximumNumberOfConcurrentTimeSteps(0);
+}
+
+/**Maps a single point with the inverse kernel of the registration, which is the kernel used by the mapping
+ * tasks. Lazy field kernels generate their field on first access; doing this once before the time steps are
+ * mapped concurrently ensures that the field is generated by a single thread.*/
+template <unsigned int VImageDimension >
+void warmUpInverseKernel(const mitk::ImageMappingHelper::RegistrationType* registration, const mitk::BaseGeometry* geometry)
+{
+  typedef ::map::core::Registration<VImageDimension,VImageDimension> ConcreteRegistrationType;
+  const ConcreteRegistrationType* castedReg = dynamic_cast<const ConcreteRegistrationType*>(registration);
+
+  if (nullptr == castedReg)
+  {
+    return;
+  }
+
+  typename ::map::core::continuous::Elements<VImageDimension>::PointType targetPoint;
+  typename ::map::core::continuous::Elements<VImageDimension>::PointType movingPoint;
+  const mitk::Point3D origin = geometry->GetOrigin();
+  for (unsigned int i = 0; i < VImageDimension; ++i)
+  {
+    targetPoint[i] = origin[i];
+  }
+
+  try
+  {
+    castedReg->mapPointInverse(targetPoint, movingPoint);
+  }
+  catch (...)
+  {
+    // errors of the registration are reported by the mapping tasks themselves
+  }
+}
 
-/**Helper function to ensure the mapping of all time steps of an image.*/
-void doMapTimesteps(const mitk::ImageMappingHelper::InputImageType* input, mitk::Image* result, const mitk::ImageMappingHelper::RegistrationType* registration, bool throwOnOutOfInputAreaError,double paddingValue, const mitk::ImageMappingHelper::ResultImageGeometryType* resultGeometry, bool throwOnMappingError, double errorValue, mitk::ImageMappingInterpolator::Type interpolatorType)
+/**Helper function to ensure the mapping of all time steps of an image.
+ * Time steps are distributed dynamically to a bounded number of worker threads. Accessing the
+ * (shared) input and result images is serialized, only the mapping itself runs concurrently.*/
+void doMapTimesteps(const mitk::ImageMappingHelper::InputImageType* input, mitk::Image* result, const mitk::ImageMappingHelper::RegistrationType* registration, bool throwOnOutOfInputAreaError,double paddingValue, const mitk::ImageMappingHelper::ResultImageGeometryType* resultGeometry, bool throwOnMappingError, double errorValue, mitk::ImageMappingInterpolator::Type interpolatorType,
+  const mitk::ImageMappingHelper::TimeStepProgressCallbackType& progressCallback)
 {
-  for (unsigned int i = 0; i<input->GetTimeSteps(); ++i)
+  const unsigned int timeSteps = input->GetTimeSteps();
+
+  // every mapping task is multi-threaded by ITK itself, thus concurrent time steps are opt-in
+  const unsigned int numberOfCores = std::max(1u, std::thread::hardware_concurrency());
+  const unsigned int numberOfThreads = std::max(1u, std::min({ mitk::ImageMappingHelper::GetMaximumNumberOfConcurrentTimeSteps(), numberOfCores, timeSteps }));
+
+  std::mutex inputMutex;
+  std::mutex resultMutex;
+  std::mutex progressMutex;
+  std::atomic<unsigned int> nextTimeStep(0);
+  std::atomic<bool> failed(false);
+  std::exception_ptr exception;
+  unsigned int mappedTimeSteps = 0;
+
+  auto worker = [&]()
+  {
+    try
+    {
+      for (auto i = nextTimeStep++; i < timeSteps && !failed; i = nextTimeStep++)
+      {
+        mitk::ImageMappingHelper::InputImageType::Pointer timeStepInput;
+
+        {
+          std::lock_guard<std::mutex> lock(inputMutex);
+          mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
+          imageTimeSelector->SetInput(input);
+          imageTimeSelector->SetTimeNr(i);
+          imageTimeSelector->UpdateLargestPossibleRegion();
+          timeStepInput = imageTimeSelector->GetOutput();
+          timeStepInput->DisconnectPipeline();
+        }
+
+        AccessByItk_n(timeStepInput, doMITKMapIntoTimeStep, (result, i, resultMutex, registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, interpolatorType));
+
+        if (progressCallback)
+        {
+          std::lock_guard<std::mutex> lock(progressMutex);
+          progressCallback(++mappedTimeSteps, timeSteps);
+        }
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(progressMutex);
+      if (nullptr == exception)
+      {
+        exception = std::current_exception();
+      }
+      failed = true;
+    }
+  };
+
+  if (numberOfThreads < 2)
+  {
+    worker();
+  }
+  else
   {
-    mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
-    imageTimeSelector->SetInput(input);
-    imageTimeSelector->SetTimeNr(i);
-    imageTimeSelector->UpdateLargestPossibleRegion();
+    const mitk::BaseGeometry* warmUpGeometry = nullptr != resultGeometry ? resultGeometry : input->GetGeometry();
+    if (2 == registration->getTargetDimensions())
+    {
+      warmUpInverseKernel<2>(registration, warmUpGeometry);
+    }
+    else if (3 == registration->getTargetDimensions())
+    {
+      warmUpInverseKernel<3>(registration, warmUpGeometry);
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(numberOfThreads);
+
+    for (unsigned int threadIndex = 0; threadIndex < numberOfThreads; ++threadIndex)
+    {
+      threads.emplace_back(worker);
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
 
-    mitk::ImageMappingHelper::InputImageType::Pointer timeStepInput = imageTimeSelector->GetOutput();
-    mitk::ImageMappingHelper::ResultImageType::Pointer timeStepResult;
-    AccessByItk_n(timeStepInput, doMITKMap, (timeStepResult, registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, interpolatorType));
-    mitk::ImageReadAccessor readAccess(timeStepResult);
-    result->SetVolume(readAccess.GetData(), i);
+  if (nullptr != exception)
+  {
+    std::rethrow_exception(exception);
   }
+
+  result->Modified();
 }
 
 mitk::TimeGeometry::Pointer CreateResultTimeGeometry(const mitk::ImageMappingHelper::InputImageType* input, const mitk::ImageMappingHelper::ResultImageGeometryType* resultGeometry)
@@ -251,10 +415,21 @@ mitk::TimeGeometry::Pointer CreateResultTimeGeometry(const mitk::ImageMappingHel
   return mappedTimeGeometry;
 }
 
+void mitk::ImageMappingHelper::SetMaximumNumberOfConcurrentTimeSteps(unsigned int numberOfTimeSteps)
+{
+  maximumNumberOfConcurrentTimeSteps = numberOfTimeSteps;
+}
+
+unsigned int mitk::ImageMappingHelper::GetMaximumNumberOfConcurrentTimeSteps()
+{
+  return maximumNumberOfConcurrentTimeSteps;
+}
+
 mitk::ImageMappingHelper::ResultImageType::Pointer
   mitk::ImageMappingHelper::map(const InputImageType* input, const RegistrationType* registration,
   bool throwOnOutOfInputAreaError, const double& paddingValue, const ResultImageGeometryType* resultGeometry,
-  bool throwOnMappingError, const double& errorValue, mitk::ImageMappingInterpolator::Type interpolatorType)
+  bool throwOnMappingError, const double& errorValue, mitk::ImageMappingInterpolator::Type interpolatorType,
+  const TimeStepProgressCallbackType& progressCallback)
 {
   if (!registration)
   {
@@ -282,7 +457,7 @@ mitk::ImageMappingHelper::ResultImageType::Pointer
       result = mitk::Image::New();
       result->Initialize(input->GetPixelType(), *mappedTimeGeometry, 1, input->GetTimeSteps());
 
-      doMapTimesteps(input, result, registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, interpolatorType);
+      doMapTimesteps(input, result, registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, interpolatorType, progressCallback);
     }
   }
   else
@@ -315,7 +490,7 @@ mitk::ImageMappingHelper::ResultImageType::Pointer
       cloneInput->SetActiveLayer(layerID);
       resultLabelSetImage->SetActiveLayer(layerID);
 
-      doMapTimesteps(cloneInput, resultLabelSetImage, registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, mitk::ImageMappingInterpolator::Linear);
+      doMapTimesteps(cloneInput, resultLabelSetImage, registration, throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, mitk::ImageMappingInterpolator::Linear, progressCallback);
     }
 
     resultLabelSetImage->SetActiveLayer(inputLabelSetImage->GetActiveLayer());
@@ -329,7 +504,8 @@ mitk::ImageMappingHelper::ResultImageType::Pointer
 mitk::ImageMappingHelper::ResultImageType::Pointer
   mitk::ImageMappingHelper::map(const InputImageType* input, const MITKRegistrationType* registration,
   bool throwOnOutOfInputAreaError, const double& paddingValue, const ResultImageGeometryType* resultGeometry,
-  bool throwOnMappingError, const double& errorValue, mitk::ImageMappingInterpolator::Type)
+  bool throwOnMappingError, const double& errorValue, mitk::ImageMappingInterpolator::Type,
+  const TimeStepProgressCallbackType& progressCallback)
 {
   if (!registration)
   {
@@ -344,7 +520,7 @@ mitk::ImageMappingHelper::ResultImageType::Pointer
     mitkThrow() << "Cannot map image. Passed image pointer is nullptr.";
   }
 
-  ResultImageType::Pointer result = map(input, registration->GetRegistration(), throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue);
+  ResultImageType::Pointer result = map(input, registration->GetRegistration(), throwOnOutOfInputAreaError, paddingValue, resultGeometry, throwOnMappingError, errorValue, mitk::ImageMappingInterpolator::Linear, progressCallback);
   return result;
 }
 
@@ -19,6 +19,12 @@ found in the LICENSE file.
 #include <mitkMaskedAlgorithmHelper.h>
 #include <mitkMAPAlgorithmHelper.h>
 
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
 mitk::Image::Pointer
 mitk::TimeFramesRegistrationHelper::GetFrameImage(const mitk::Image* image,
     mitk::TimePointType timePoint) const
@@ -56,51 +62,134 @@ mitk::TimeFramesRegistrationHelper::Generate()
     }
   }
 
-  double progressDelta = 1.0 / ((this->m_4DImage->GetTimeSteps() - 1) * 3.0);
+  const unsigned int timeSteps = this->m_4DImage->GetTimeSteps();
+  const double progressDelta = 1.0 / ((timeSteps - 1) * 3.0);
   m_Progress = 0.0;
 
-  //process the frames
-  for (unsigned int i = 1; i < this->m_4DImage->GetTimeSteps(); ++i)
+  //registration and mapping of a frame are multi-threaded by ITK itself, so by default only the cores that
+  //are not already used by a single frame are used to process further frames
+  const unsigned int numberOfCores = std::max(1u, std::thread::hardware_concurrency());
+  unsigned int numberOfThreads = m_MaximumNumberOfConcurrentFrames;
+  if (0 == numberOfThreads)
   {
-    Image::Pointer movingFrame = GetFrameImage(this->m_4DImage, i);
-    Image::Pointer mappedFrame;
-
-    IgnoreListType::iterator finding = std::find(m_IgnoreList.begin(), m_IgnoreList.end(), i);
-
+    numberOfThreads = numberOfCores / std::max(1u, static_cast<unsigned int>(::itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads()));
+  }
+  numberOfThreads = std::max(1u, std::min({ numberOfThreads, numberOfCores, timeSteps - 1 }));
+
+  //input and result images are not thread safe, so every access is serialized. The same holds for the
+  //events (and the progress), thus observers are never called concurrently.
+  std::mutex inputMutex;
+  std::mutex resultMutex;
+  std::mutex eventMutex;
+  std::mutex algorithmMutex;
+  std::atomic<unsigned int> nextFrame(1);
+  std::atomic<bool> failed(false);
+  std::exception_ptr exception;
+
+  auto addProgress = [this, &eventMutex](double delta, const ::itk::EventObject& event)
+  {
+    std::lock_guard<std::mutex> lock(eventMutex);
+    m_Progress = m_Progress + delta;
+    this->InvokeEvent(event);
+  };
 
-    if (finding == m_IgnoreList.end())
+  auto worker = [&]()
+  {
+    try
     {
-      //frame should be processed
-      RegistrationPointer reg = DoFrameRegistration(movingFrame, targetFrame, mask);
-
-      m_Progress += progressDelta;
-      this->InvokeEvent(::mitk::FrameRegistrationEvent(nullptr,
-                        "Registered frame #" +::map::core::convert::toStr(i)));
-
-      mappedFrame = DoFrameMapping(movingFrame, reg, targetFrame);
-
-      m_Progress += progressDelta;
-      this->InvokeEvent(::mitk::FrameMappingEvent(nullptr,
-                        "Mapped frame #" + ::map::core::convert::toStr(i)));
-
-      mitk::ImageReadAccessor accessor(mappedFrame, mappedFrame->GetVolumeData(0, 0, nullptr,
-                                       mitk::Image::ReferenceMemory));
-
-
-      this->m_Registered4DImage->SetVolume(accessor.GetData(), i);
-      this->m_Registered4DImage->GetTimeGeometry()->SetTimeStepGeometry(mappedFrame->GetGeometry(), i);
-
-      m_Progress += progressDelta;
+      RegistrationAlgorithmPointer algorithm = m_AlgorithmFactory ? m_AlgorithmFactory() : nullptr;
+
+      if (m_AlgorithmFactory && algorithm.IsNull())
+      {
+        mitkThrow() << "Cannot register image. Algorithm factory did not return an algorithm.";
+      }
+
+      //process the frames
+      for (auto i = nextFrame++; i < timeSteps && !failed; i = nextFrame++)
+      {
+        IgnoreListType::const_iterator finding = std::find(m_IgnoreList.cbegin(), m_IgnoreList.cend(), i);
+
+        if (finding != m_IgnoreList.cend())
+        {
+          addProgress(3 * progressDelta, ::itk::ProgressEvent());
+          continue;
+        }
+
+        //frame should be processed
+        Image::Pointer movingFrame;
+        {
+          std::lock_guard<std::mutex> lock(inputMutex);
+          movingFrame = GetFrameImage(this->m_4DImage, i);
+          movingFrame->DisconnectPipeline();
+        }
+
+        RegistrationPointer reg;
+        if (algorithm.IsNotNull())
+        {
+          reg = DoFrameRegistration(algorithm, movingFrame, targetFrame, mask);
+        }
+        else
+        {
+          std::lock_guard<std::mutex> lock(algorithmMutex);
+          reg = DoFrameRegistration(movingFrame, targetFrame, mask);
+        }
+
+        addProgress(progressDelta, ::mitk::FrameRegistrationEvent(nullptr,
+                    "Registered frame #" +::map::core::convert::toStr(i)));
+
+        Image::Pointer mappedFrame = DoFrameMapping(movingFrame, reg, targetFrame);
+        movingFrame = nullptr;
+
+        addProgress(progressDelta, ::mitk::FrameMappingEvent(nullptr,
+                    "Mapped frame #" + ::map::core::convert::toStr(i)));
+
+        {
+          std::lock_guard<std::mutex> lock(resultMutex);
+          mitk::ImageReadAccessor accessor(mappedFrame, mappedFrame->GetVolumeData(0, 0, nullptr,
+                                           mitk::Image::ReferenceMemory));
+
+          this->m_Registered4DImage->SetVolume(accessor.GetData(), i);
+          this->m_Registered4DImage->GetTimeGeometry()->SetTimeStepGeometry(mappedFrame->GetGeometry(), i);
+        }
+
+        addProgress(progressDelta, ::itk::ProgressEvent());
+      }
     }
-    else
+    catch (...)
     {
-      m_Progress += 3 * progressDelta;
+      std::lock_guard<std::mutex> lock(eventMutex);
+      if (nullptr == exception)
+      {
+        exception = std::current_exception();
+      }
+      failed = true;
     }
+  };
 
-    this->InvokeEvent(::itk::ProgressEvent());
+  if (numberOfThreads < 2)
+  {
+    worker();
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(numberOfThreads);
 
+    for (unsigned int threadIndex = 0; threadIndex < numberOfThreads; ++threadIndex)
+    {
+      threads.emplace_back(worker);
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
   }
 
+  if (nullptr != exception)
+  {
+    std::rethrow_exception(exception);
+  }
 };
 
 mitk::Image::Pointer
@@ -134,19 +223,39 @@ mitk::TimeFramesRegistrationHelper::RegistrationPointer
 mitk::TimeFramesRegistrationHelper::DoFrameRegistration(const mitk::Image* movingFrame,
     const mitk::Image* targetFrame, const mitk::Image* targetMask) const
 {
-  mitk::MAPAlgorithmHelper algHelper(m_Algorithm);
+  return DoFrameRegistration(m_Algorithm, movingFrame, targetFrame, targetMask);
+};
+
+mitk::TimeFramesRegistrationHelper::RegistrationPointer
+mitk::TimeFramesRegistrationHelper::DoFrameRegistration(RegistrationAlgorithmBaseType* algorithm,
+    const mitk::Image* movingFrame, const mitk::Image* targetFrame, const mitk::Image* targetMask) const
+{
+  mitk::MAPAlgorithmHelper algHelper(algorithm);
   algHelper.SetAllowImageCasting(true);
   algHelper.SetData(movingFrame, targetFrame);
 
   if (targetMask)
   {
-    mitk::MaskedAlgorithmHelper maskHelper(m_Algorithm);
+    mitk::MaskedAlgorithmHelper maskHelper(algorithm);
     maskHelper.SetMasks(nullptr, targetMask);
   }
 
   return algHelper.GetRegistration();
 };
 
+void
+mitk::TimeFramesRegistrationHelper::SetAlgorithmFactory(const AlgorithmFactoryType& factory)
+{
+  m_AlgorithmFactory = factory;
+  this->Modified();
+}
+
+const mitk::TimeFramesRegistrationHelper::AlgorithmFactoryType&
+mitk::TimeFramesRegistrationHelper::GetAlgorithmFactory() const
+{
+  return m_AlgorithmFactory;
+}
+
 mitk::Image::Pointer mitk::TimeFramesRegistrationHelper::DoFrameMapping(
   const mitk::Image* movingFrame, const RegistrationType* reg, const mitk::Image* targetFrame) const
 {
@@ -70,6 +70,7 @@ found in the LICENSE file.
 
 mitk::RegEvaluationMapper2D::RegEvaluationMapper2D()
 {
+  m_FieldSliceMapper = mitk::DisplacementFieldSliceMapper::New();
 }
 
 mitk::RegEvaluationMapper2D::~RegEvaluationMapper2D()
@@ -283,7 +284,17 @@ void mitk::RegEvaluationMapper2D::GenerateDataForRenderer( mitk::BaseRenderer *r
     reg->GetMTime() > localStorage->m_LastUpdateTime)
   {
     //Map moving image
-    localStorage->m_slicedMappedImage = mitk::ImageMappingHelper::map(movingInput,reg,false,0,localStorage->m_slicedTargetImage->GetGeometry(),false,0);
+    if (mitk::DisplacementFieldSliceMapper::IsSupported(movingInput, reg->GetRegistration()))
+    {
+      //the field is cached for the whole target geometry, thus changing the slice only needs interpolation
+      localStorage->m_slicedMappedImage = m_FieldSliceMapper->Map(movingInput, reg->GetRegistration(),
+        targetInput->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()),
+        localStorage->m_slicedTargetImage->GetGeometry());
+    }
+    else
+    {
+      localStorage->m_slicedMappedImage = mitk::ImageMappingHelper::map(movingInput,reg,false,0,localStorage->m_slicedTargetImage->GetGeometry(),false,0);
+    }
     updated = true;
   }
 
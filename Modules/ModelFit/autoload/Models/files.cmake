@@ -10,3 +10,7 @@ set(TPP_FILES
 
 set(MOC_H_FILES
 )
+
+set(RESOURCE_FILES
+  manifest.json
+)
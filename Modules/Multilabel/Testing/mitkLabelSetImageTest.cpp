@@ -11,6 +11,8 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLabelSetImage.h>
 #include <mitkLabelSetImageConverter.h>
@@ -77,6 +79,8 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestEraseLabels);
   MITK_TEST(TestMergeLabels);
   MITK_TEST(TestCreateLabelMask);
+  MITK_TEST(TestLabelOccupancy);
+  MITK_TEST(TestLabelOccupancyUnannouncedBeforeAnnouncedWrite);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -659,6 +663,103 @@ public:
     // Count all pixels with value 6 = 507
     CPPUNIT_ASSERT_MESSAGE("Label mask not correctly created", maskImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 507);
   }
+
+  void TestLabelOccupancy()
+  {
+    mitk::Image::Pointer image =
+      mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Multilabel/LabelSetTestInitializeImage.nrrd"));
+
+    m_LabelSetImage = nullptr;
+    m_LabelSetImage = mitk::LabelSetImage::New();
+    m_LabelSetImage->InitializeByLabeledImage(image);
+
+    // Count all pixels with value 6 = 507
+    // Count all pixels with value 7 = 823
+    CPPUNIT_ASSERT_EQUAL(std::size_t(507), m_LabelSetImage->GetLabelVoxelCount(6));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(823), m_LabelSetImage->GetLabelVoxelCount(7));
+    CPPUNIT_ASSERT(!m_LabelSetImage->IsLabelEmpty(1));
+
+    auto statistics = m_LabelSetImage->GetLabelStatistics(6);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      CPPUNIT_ASSERT(statistics.MinIndex[i] <= statistics.MaxIndex[i]);
+      CPPUNIT_ASSERT(statistics.MaxIndex[i] < m_LabelSetImage->GetDimension(i));
+    }
+
+    m_LabelSetImage->MergeLabel(6, 7);
+    CPPUNIT_ASSERT_MESSAGE("Merged label 7 is not empty", m_LabelSetImage->IsLabelEmpty(7));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1330), m_LabelSetImage->GetLabelVoxelCount(6));
+
+    m_LabelSetImage->EraseLabel(1);
+    CPPUNIT_ASSERT_MESSAGE("Erased label 1 is not empty", m_LabelSetImage->IsLabelEmpty(1));
+    CPPUNIT_ASSERT_MESSAGE("Erased label 1 was removed", m_LabelSetImage->ExistLabel(1));
+
+    // unannounced modification of the pixels must be detected
+    const itk::Index<3> index = {{ 0, 0, 0 }};
+    mitk::Label::PixelType originalValue = 0;
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(m_LabelSetImage);
+      originalValue = accessor.GetPixelByIndex(index);
+      accessor.SetPixelByIndex(index, 1);
+    }
+    m_LabelSetImage->Modified();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_LabelSetImage->GetLabelVoxelCount(1));
+
+    const std::size_t expectedCount = 6 == originalValue ? 1330 : 1331;
+
+    // announced modification
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(m_LabelSetImage);
+      accessor.SetPixelByIndex(index, 6);
+    }
+    m_LabelSetImage->Modified();
+    m_LabelSetImage->UpdateLabelOccupancy(m_LabelSetImage->GetActiveLayer(), 0, { {0, 0, 0} }, { {0, 0, 0} });
+    CPPUNIT_ASSERT_MESSAGE("Overwritten label 1 is not empty", m_LabelSetImage->IsLabelEmpty(1));
+    CPPUNIT_ASSERT_EQUAL(expectedCount, m_LabelSetImage->GetLabelVoxelCount(6));
+    CPPUNIT_ASSERT_EQUAL(0u, m_LabelSetImage->GetLabelStatistics(6).MinIndex[0]);
+  }
+
+  void TestLabelOccupancyUnannouncedBeforeAnnouncedWrite()
+  {
+    mitk::Image::Pointer image =
+      mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Multilabel/LabelSetTestInitializeImage.nrrd"));
+
+    m_LabelSetImage = nullptr;
+    m_LabelSetImage = mitk::LabelSetImage::New();
+    m_LabelSetImage->InitializeByLabeledImage(image);
+
+    // build the index
+    CPPUNIT_ASSERT_EQUAL(std::size_t(823), m_LabelSetImage->GetLabelVoxelCount(7));
+
+    itk::Index<3> unannouncedIndex;
+    for (unsigned int i = 0; i < 3; ++i)
+      unannouncedIndex[i] = static_cast<itk::IndexValueType>(m_LabelSetImage->GetDimension(i)) - 1;
+    const itk::Index<3> announcedIndex = {{ 0, 0, 0 }};
+
+    // unannounced write, directly followed by an announced write without a query in between
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(m_LabelSetImage);
+      accessor.SetPixelByIndex(unannouncedIndex, 7);
+    }
+    m_LabelSetImage->Modified();
+
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(m_LabelSetImage);
+      accessor.SetPixelByIndex(announcedIndex, 7);
+    }
+    m_LabelSetImage->Modified();
+    m_LabelSetImage->UpdateLabelOccupancy(m_LabelSetImage->GetActiveLayer(), 0, { {0, 0, 0} }, { {0, 0, 0} });
+
+    // erasing works on the index and must not miss the unannounced voxel
+    m_LabelSetImage->EraseLabel(7);
+    CPPUNIT_ASSERT_MESSAGE("Erased label 7 is not empty", m_LabelSetImage->IsLabelEmpty(7));
+
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> accessor(m_LabelSetImage);
+    CPPUNIT_ASSERT_MESSAGE("Unannounced voxel of label 7 was not erased",
+      7 != accessor.GetPixelByIndex(unannouncedIndex));
+    CPPUNIT_ASSERT_MESSAGE("Announced voxel of label 7 was not erased",
+      7 != accessor.GetPixelByIndex(announcedIndex));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImage)
@@ -13,8 +13,7 @@ found in the LICENSE file.
 #include "mitkDICOMSegIOMimeTypes.h"
 #include "mitkIOMimeTypes.h"
 
-#include <array>
-
+#include <mitkFileContentSniffer.h>
 #include <mitkLog.h>
 
 #include <itkGDCMImageIO.h>
@@ -23,6 +22,35 @@ found in the LICENSE file.
 #include <dcmtk/dcmdata/dcfilefo.h>
 #include <dcmtk/dcmdata/dcdeftag.h>
 
+namespace
+{
+  /** Checks modality and SOP class of the file with DCMTK. Both tags are read from one dataset, which
+   * is only parsed up to the modality. The result is cached by the FileContentSniffer, so repeated
+   * checks of the same file (e.g. by the reader selection after a drop) do not load it again.*/
+  bool IsSegmentationStorage(const std::string &path)
+  {
+    return "1" == mitk::FileContentSniffer::Sniff(path)->GetValue("DICOMSegIO.IsSegmentationStorage", [&]()
+    {
+      DcmFileFormat dcmFileFormat;
+
+      if (dcmFileFormat.loadFileUntilTag(path.c_str(), EXS_Unknown, EGL_noChange, DCM_MaxReadLength,
+                                         ERM_autoDetect, DCM_Modality).bad())
+        return std::string("0");
+
+      OFString modality;
+      OFString sopClassUID;
+      auto *dataset = dcmFileFormat.getDataset();
+
+      //atm we could read SegmentationStorage files. Other storage classes with "SEG" modality, e.g. SurfaceSegmentationStorage (1.2.840.10008.5.1.4.1.1.66.5), are not supported yet.
+      const bool isSegmentationStorage = dataset->findAndGetOFString(DCM_Modality, modality).good() &&
+                                         dataset->findAndGetOFString(DCM_SOPClassUID, sopClassUID).good() &&
+                                         modality == "SEG" && sopClassUID == "1.2.840.10008.5.1.4.1.1.66.4";
+
+      return std::string(isSegmentationStorage ? "1" : "0");
+    });
+  }
+}
+
 namespace mitk
 {
   std::vector<CustomMimeType *> MitkDICOMSEGIOMimeTypes::Get()
@@ -58,62 +86,10 @@ namespace mitk
     }
     // end fix for bug 18572
 
-    const std::size_t offset = 128;
-    const std::size_t bufferSize = 4;
-
-    std::ifstream myfile(path, std::ifstream::binary);
-
-    if (!myfile.is_open())
-      return false;
-
-    myfile.seekg(0, std::ifstream::end);
-    const auto fileSize = static_cast<std::size_t>(myfile.tellg());
-
-    if (fileSize < offset + bufferSize)
-      return false;
-
-    myfile.seekg(offset);
-    std::array<char, bufferSize> buffer;
-    myfile.read(buffer.data(), bufferSize);
-
-    if (0 != std::string(buffer.data(), bufferSize).compare("DICM"))
+    if (!canRead || !FileContentSniffer::Sniff(path)->HasDicomPreamble())
       return false;
 
-    DcmFileFormat dcmFileFormat;
-    OFCondition status = dcmFileFormat.loadFile(path.c_str());
-
-    if (status.bad())
-    {
-      canRead = false;
-    }
-
-    if (!canRead)
-    {
-      return canRead;
-    }
-
-    OFString modality;
-    OFString sopClassUID;
-    if (dcmFileFormat.getDataset()->findAndGetOFString(DCM_Modality, modality).good() && dcmFileFormat.getDataset()->findAndGetOFString(DCM_SOPClassUID, sopClassUID).good())
-    {
-      if (modality.compare("SEG") == 0)
-      {//atm we could read SegmentationStorage files. Other storage classes with "SEG" modality, e.g. SurfaceSegmentationStorage (1.2.840.10008.5.1.4.1.1.66.5), are not supported yet.
-        if (sopClassUID.compare("1.2.840.10008.5.1.4.1.1.66.4") == 0)
-        {
-          canRead = true;
-        }
-        else
-        {
-          canRead = false;
-        }
-      }
-      else
-      {
-        canRead = false;
-      }
-    }
-
-    return canRead;
+    return IsSegmentationStorage(path);
   }
 
   MitkDICOMSEGIOMimeTypes::MitkDICOMSEGMimeType *MitkDICOMSEGIOMimeTypes::MitkDICOMSEGMimeType::Clone() const
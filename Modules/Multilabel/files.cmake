@@ -1,6 +1,7 @@
 set(CPP_FILES
   mitkLabel.cpp
   mitkLabelHighlightGuard.cpp
+  mitkLabelOccupancyIndex.cpp
   mitkLabelSetImage.cpp
   mitkLabelSetImageConverter.cpp
   mitkLabelSetImageSource.cpp
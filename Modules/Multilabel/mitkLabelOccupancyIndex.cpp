@@ -0,0 +1,427 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLabelOccupancyIndex.h"
+
+#include <algorithm>
+#include <set>
+
+mitk::LabelOccupancyIndex::LabelOccupancyIndex()
+  : m_Dimensions({{0, 0, 0}}), m_BrickCounts({{0, 0, 0}}), m_IsBuilt(false)
+{
+}
+
+void mitk::LabelOccupancyIndex::Reset(const IndexType& dimensions)
+{
+  m_Dimensions = dimensions;
+
+  for (unsigned int i = 0; i < 3; ++i)
+    m_BrickCounts[i] = (dimensions[i] + BRICK_SIZE - 1) / BRICK_SIZE;
+
+  m_Bricks.clear();
+  m_Labels.clear();
+  m_IsBuilt = false;
+}
+
+bool mitk::LabelOccupancyIndex::IsBuilt() const
+{
+  return m_IsBuilt;
+}
+
+const mitk::LabelOccupancyIndex::IndexType& mitk::LabelOccupancyIndex::GetDimensions() const
+{
+  return m_Dimensions;
+}
+
+std::size_t mitk::LabelOccupancyIndex::GetBrickIndex(unsigned int bx, unsigned int by, unsigned int bz) const
+{
+  return (static_cast<std::size_t>(bz) * m_BrickCounts[1] + by) * m_BrickCounts[0] + bx;
+}
+
+void mitk::LabelOccupancyIndex::GetBrickRegion(std::size_t brickIndex, IndexType& minIndex, IndexType& maxIndex) const
+{
+  const auto bricksPerSlice = static_cast<std::size_t>(m_BrickCounts[0]) * m_BrickCounts[1];
+  const IndexType brick = {{static_cast<unsigned int>(brickIndex % m_BrickCounts[0]),
+                            static_cast<unsigned int>((brickIndex % bricksPerSlice) / m_BrickCounts[0]),
+                            static_cast<unsigned int>(brickIndex / bricksPerSlice)}};
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    minIndex[i] = brick[i] * BRICK_SIZE;
+    maxIndex[i] = std::min(minIndex[i] + BRICK_SIZE, m_Dimensions[i]) - 1;
+  }
+}
+
+void mitk::LabelOccupancyIndex::ScanBrick(const LabelValueType* buffer, std::size_t brickIndex, BrickLabelsType& labels) const
+{
+  labels.clear();
+
+  IndexType minIndex, maxIndex;
+  this->GetBrickRegion(brickIndex, minIndex, maxIndex);
+
+  const std::size_t lineStride = m_Dimensions[0];
+  const std::size_t sliceStride = lineStride * m_Dimensions[1];
+
+  // cache the entry of the last seen label, labels are spatially coherent
+  LabelValueType lastValue = Label::UNLABELED_VALUE;
+  LabelStatistics* lastStatistics = nullptr;
+
+  for (auto z = minIndex[2]; z <= maxIndex[2]; ++z)
+  {
+    for (auto y = minIndex[1]; y <= maxIndex[1]; ++y)
+    {
+      const auto* line = buffer + z * sliceStride + y * lineStride;
+
+      for (auto x = minIndex[0]; x <= maxIndex[0]; ++x)
+      {
+        const auto value = line[x];
+
+        if (Label::UNLABELED_VALUE == value)
+          continue;
+
+        if (value != lastValue || nullptr == lastStatistics)
+        {
+          lastStatistics = FindInBrick(labels, value);
+
+          if (nullptr == lastStatistics)
+          {
+            LabelStatistics statistics;
+            statistics.MinIndex = {{x, y, z}};
+            statistics.MaxIndex = {{x, y, z}};
+            labels.emplace_back(value, statistics);
+            lastStatistics = &labels.back().second;
+          }
+
+          lastValue = value;
+        }
+
+        ++lastStatistics->VoxelCount;
+        lastStatistics->MinIndex[0] = std::min(lastStatistics->MinIndex[0], x);
+        lastStatistics->MaxIndex[0] = std::max(lastStatistics->MaxIndex[0], x);
+        lastStatistics->MinIndex[1] = std::min(lastStatistics->MinIndex[1], y);
+        lastStatistics->MaxIndex[1] = std::max(lastStatistics->MaxIndex[1], y);
+        lastStatistics->MinIndex[2] = std::min(lastStatistics->MinIndex[2], z);
+        lastStatistics->MaxIndex[2] = std::max(lastStatistics->MaxIndex[2], z);
+      }
+    }
+  }
+}
+
+void mitk::LabelOccupancyIndex::Build(const LabelValueType* buffer)
+{
+  m_Bricks.assign(static_cast<std::size_t>(m_BrickCounts[0]) * m_BrickCounts[1] * m_BrickCounts[2], BrickLabelsType());
+  m_Labels.clear();
+
+  for (std::size_t brickIndex = 0; brickIndex < m_Bricks.size(); ++brickIndex)
+  {
+    this->ScanBrick(buffer, brickIndex, m_Bricks[brickIndex]);
+
+    for (const auto& [value, statistics] : m_Bricks[brickIndex])
+    {
+      auto finding = m_Labels.find(value);
+
+      if (m_Labels.end() == finding)
+      {
+        m_Labels[value] = { statistics, { brickIndex } };
+      }
+      else
+      {
+        Include(finding->second.Statistics, statistics);
+        finding->second.Bricks.push_back(brickIndex); // bricks are visited in ascending order
+      }
+    }
+  }
+
+  m_IsBuilt = true;
+}
+
+void mitk::LabelOccupancyIndex::Update(const LabelValueType* buffer, const IndexType& minIndex, const IndexType& maxIndex)
+{
+  if (!m_IsBuilt)
+  {
+    this->Build(buffer);
+    return;
+  }
+
+  IndexType minBrick, maxBrick;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (minIndex[i] > maxIndex[i] || minIndex[i] >= m_Dimensions[i])
+      return;
+
+    minBrick[i] = minIndex[i] / BRICK_SIZE;
+    maxBrick[i] = std::min(maxIndex[i], m_Dimensions[i] - 1) / BRICK_SIZE;
+  }
+
+  std::set<LabelValueType> changedLabels;
+  BrickLabelsType newLabels;
+
+  for (auto bz = minBrick[2]; bz <= maxBrick[2]; ++bz)
+  {
+    for (auto by = minBrick[1]; by <= maxBrick[1]; ++by)
+    {
+      for (auto bx = minBrick[0]; bx <= maxBrick[0]; ++bx)
+      {
+        const auto brickIndex = this->GetBrickIndex(bx, by, bz);
+        auto& oldLabels = m_Bricks[brickIndex];
+
+        this->ScanBrick(buffer, brickIndex, newLabels);
+
+        for (const auto& [value, statistics] : oldLabels)
+        {
+          auto& entry = m_Labels[value];
+          entry.Statistics.VoxelCount -= statistics.VoxelCount;
+
+          if (nullptr == FindInBrick(newLabels, value))
+          {
+            auto brickFinding = std::lower_bound(entry.Bricks.begin(), entry.Bricks.end(), brickIndex);
+            if (entry.Bricks.end() != brickFinding && *brickFinding == brickIndex)
+              entry.Bricks.erase(brickFinding);
+          }
+
+          changedLabels.insert(value);
+        }
+
+        for (const auto& [value, statistics] : newLabels)
+        {
+          auto& entry = m_Labels[value];
+          entry.Statistics.VoxelCount += statistics.VoxelCount;
+
+          auto brickFinding = std::lower_bound(entry.Bricks.begin(), entry.Bricks.end(), brickIndex);
+          if (entry.Bricks.end() == brickFinding || *brickFinding != brickIndex)
+            entry.Bricks.insert(brickFinding, brickIndex);
+
+          changedLabels.insert(value);
+        }
+
+        oldLabels.swap(newLabels);
+      }
+    }
+  }
+
+  for (const auto value : changedLabels)
+    this->UpdateBoundingBox(value);
+}
+
+void mitk::LabelOccupancyIndex::UpdateBoundingBox(LabelValueType value)
+{
+  auto finding = m_Labels.find(value);
+
+  if (m_Labels.end() == finding)
+    return;
+
+  auto& entry = finding->second;
+
+  if (entry.Bricks.empty())
+  {
+    m_Labels.erase(finding);
+    return;
+  }
+
+  bool first = true;
+
+  for (const auto brickIndex : entry.Bricks)
+  {
+    const auto* statistics = FindInBrick(m_Bricks[brickIndex], value);
+
+    if (first)
+    {
+      entry.Statistics.MinIndex = statistics->MinIndex;
+      entry.Statistics.MaxIndex = statistics->MaxIndex;
+      first = false;
+    }
+    else
+    {
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        entry.Statistics.MinIndex[i] = std::min(entry.Statistics.MinIndex[i], statistics->MinIndex[i]);
+        entry.Statistics.MaxIndex[i] = std::max(entry.Statistics.MaxIndex[i], statistics->MaxIndex[i]);
+      }
+    }
+  }
+}
+
+bool mitk::LabelOccupancyIndex::IsEmpty(LabelValueType value) const
+{
+  return m_Labels.end() == m_Labels.find(value);
+}
+
+std::size_t mitk::LabelOccupancyIndex::GetVoxelCount(LabelValueType value) const
+{
+  auto finding = m_Labels.find(value);
+  return m_Labels.end() == finding ? 0 : finding->second.Statistics.VoxelCount;
+}
+
+const mitk::LabelOccupancyIndex::LabelStatistics* mitk::LabelOccupancyIndex::GetStatistics(LabelValueType value) const
+{
+  auto finding = m_Labels.find(value);
+  return m_Labels.end() == finding ? nullptr : &(finding->second.Statistics);
+}
+
+std::vector<mitk::LabelOccupancyIndex::LabelValueType> mitk::LabelOccupancyIndex::GetLabelValues() const
+{
+  std::vector<LabelValueType> result;
+  result.reserve(m_Labels.size());
+
+  for (const auto& [value, entry] : m_Labels)
+  {
+    (void)entry; // Prevent unused variable error in older compilers
+    result.push_back(value);
+  }
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+void mitk::LabelOccupancyIndex::ReplaceLabel(LabelValueType* buffer, LabelValueType oldValue, LabelValueType newValue)
+{
+  if (oldValue == newValue || Label::UNLABELED_VALUE == oldValue)
+    return;
+
+  auto oldFinding = m_Labels.find(oldValue);
+
+  if (m_Labels.end() == oldFinding)
+    return;
+
+  const auto oldEntry = oldFinding->second;
+  m_Labels.erase(oldFinding);
+
+  const std::size_t lineStride = m_Dimensions[0];
+  const std::size_t sliceStride = lineStride * m_Dimensions[1];
+
+  for (const auto brickIndex : oldEntry.Bricks)
+  {
+    auto& brickLabels = m_Bricks[brickIndex];
+    auto* oldStatistics = FindInBrick(brickLabels, oldValue);
+    const auto statistics = *oldStatistics;
+
+    // only the bounding box of the label within the brick has to be visited
+    for (auto z = statistics.MinIndex[2]; z <= statistics.MaxIndex[2]; ++z)
+    {
+      for (auto y = statistics.MinIndex[1]; y <= statistics.MaxIndex[1]; ++y)
+      {
+        auto* line = buffer + z * sliceStride + y * lineStride;
+
+        for (auto x = statistics.MinIndex[0]; x <= statistics.MaxIndex[0]; ++x)
+        {
+          if (line[x] == oldValue)
+            line[x] = newValue;
+        }
+      }
+    }
+
+    brickLabels.erase(std::remove_if(brickLabels.begin(), brickLabels.end(),
+      [oldValue](const auto& element) { return element.first == oldValue; }), brickLabels.end());
+
+    if (Label::UNLABELED_VALUE == newValue)
+      continue;
+
+    if (auto* newStatistics = FindInBrick(brickLabels, newValue))
+    {
+      Include(*newStatistics, statistics);
+    }
+    else
+    {
+      brickLabels.emplace_back(newValue, statistics);
+    }
+  }
+
+  if (Label::UNLABELED_VALUE == newValue)
+    return;
+
+  auto newFinding = m_Labels.find(newValue);
+
+  if (m_Labels.end() == newFinding)
+  {
+    m_Labels[newValue] = oldEntry;
+  }
+  else
+  {
+    auto& newEntry = newFinding->second;
+    Include(newEntry.Statistics, oldEntry.Statistics);
+
+    std::vector<std::size_t> bricks;
+    bricks.reserve(newEntry.Bricks.size() + oldEntry.Bricks.size());
+    std::set_union(newEntry.Bricks.begin(), newEntry.Bricks.end(), oldEntry.Bricks.begin(), oldEntry.Bricks.end(),
+      std::back_inserter(bricks));
+    newEntry.Bricks.swap(bricks);
+  }
+}
+
+bool mitk::LabelOccupancyIndex::ComputeCenterOfMass(const LabelValueType* buffer, LabelValueType value, std::array<double, 3>& centerOfMass) const
+{
+  auto finding = m_Labels.find(value);
+
+  if (m_Labels.end() == finding)
+    return false;
+
+  const std::size_t lineStride = m_Dimensions[0];
+  const std::size_t sliceStride = lineStride * m_Dimensions[1];
+
+  std::array<double, 3> sum = {{0.0, 0.0, 0.0}};
+  std::size_t count = 0;
+
+  for (const auto brickIndex : finding->second.Bricks)
+  {
+    const auto* statistics = FindInBrick(m_Bricks[brickIndex], value);
+
+    for (auto z = statistics->MinIndex[2]; z <= statistics->MaxIndex[2]; ++z)
+    {
+      for (auto y = statistics->MinIndex[1]; y <= statistics->MaxIndex[1]; ++y)
+      {
+        const auto* line = buffer + z * sliceStride + y * lineStride;
+
+        for (auto x = statistics->MinIndex[0]; x <= statistics->MaxIndex[0]; ++x)
+        {
+          if (line[x] == value)
+          {
+            sum[0] += x;
+            sum[1] += y;
+            sum[2] += z;
+            ++count;
+          }
+        }
+      }
+    }
+  }
+
+  if (0 == count)
+    return false;
+
+  for (unsigned int i = 0; i < 3; ++i)
+    centerOfMass[i] = sum[i] / count;
+
+  return true;
+}
+
+mitk::LabelOccupancyIndex::LabelStatistics* mitk::LabelOccupancyIndex::FindInBrick(BrickLabelsType& labels, LabelValueType value)
+{
+  auto finding = std::find_if(labels.begin(), labels.end(), [value](const auto& element) { return element.first == value; });
+  return labels.end() == finding ? nullptr : &(finding->second);
+}
+
+const mitk::LabelOccupancyIndex::LabelStatistics* mitk::LabelOccupancyIndex::FindInBrick(const BrickLabelsType& labels, LabelValueType value)
+{
+  auto finding = std::find_if(labels.begin(), labels.end(), [value](const auto& element) { return element.first == value; });
+  return labels.end() == finding ? nullptr : &(finding->second);
+}
+
+void mitk::LabelOccupancyIndex::Include(LabelStatistics& statistics, const LabelStatistics& other)
+{
+  statistics.VoxelCount += other.VoxelCount;
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    statistics.MinIndex[i] = std::min(statistics.MinIndex[i], other.MinIndex[i]);
+    statistics.MaxIndex[i] = std::max(statistics.MaxIndex[i], other.MaxIndex[i]);
+  }
+}
@@ -0,0 +1,122 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelOccupancyIndex_h
+#define mitkLabelOccupancyIndex_h
+
+#include <mitkLabel.h>
+
+#include <MitkMultilabelExports.h>
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace mitk
+{
+  /** @brief Spatial index of the label values in one 3D volume of a label image.
+  *
+  * The volume is partitioned into bricks of BRICK_SIZE^3 voxels. For each brick the index
+  * stores the contained label values with their voxel counts and bounding boxes. For each label value
+  * the total voxel count, the bounding box and the occupied bricks are aggregated. Thus voxel count,
+  * bounding box and emptiness of a label can be queried in constant time and operations on a single
+  * label only have to visit the bricks occupied by it.
+  *
+  * The index operates on the raw pixel buffer of the volume (x running fastest). It does not observe
+  * the buffer. Changes of the buffer have to be announced by Update() (which rescans the affected
+  * bricks) or have to be done by the index itself (ReplaceLabel()).
+  *
+  * The unlabeled value (0) is not indexed.
+  */
+  class MITKMULTILABEL_EXPORT LabelOccupancyIndex
+  {
+  public:
+    using LabelValueType = Label::PixelType;
+    using IndexType = std::array<unsigned int, 3>;
+
+    static constexpr unsigned int BRICK_SIZE = 32;
+
+    struct LabelStatistics
+    {
+      std::size_t VoxelCount = 0;
+      /** Inclusive bounding box in index coordinates of the volume.*/
+      IndexType MinIndex = {{0, 0, 0}};
+      IndexType MaxIndex = {{0, 0, 0}};
+    };
+
+    LabelOccupancyIndex();
+
+    /** Clears the index and sets the dimensions of the indexed volume. Afterwards the index is not built.*/
+    void Reset(const IndexType& dimensions);
+
+    /** Indicates if the index reflects a volume (Build() was called since the last Reset()).*/
+    bool IsBuilt() const;
+
+    const IndexType& GetDimensions() const;
+
+    /** Scans the whole volume.*/
+    void Build(const LabelValueType* buffer);
+
+    /** Rescans all bricks intersecting the inclusive index region [minIndex, maxIndex].
+    * Builds the index if it is not yet built.*/
+    void Update(const LabelValueType* buffer, const IndexType& minIndex, const IndexType& maxIndex);
+
+    /** Returns true if the label has no voxel in the volume.*/
+    bool IsEmpty(LabelValueType value) const;
+
+    /** Returns the voxel count of the label in the volume.*/
+    std::size_t GetVoxelCount(LabelValueType value) const;
+
+    /** Returns the statistics of the label or nullptr if the label has no voxel in the volume.*/
+    const LabelStatistics* GetStatistics(LabelValueType value) const;
+
+    /** Returns all label values that have at least one voxel in the volume.*/
+    std::vector<LabelValueType> GetLabelValues() const;
+
+    /** Replaces all voxels of oldValue by newValue. Only the bricks occupied by oldValue are visited.
+    * newValue may be the unlabeled value to erase oldValue.
+    * @pre index is built and reflects buffer.*/
+    void ReplaceLabel(LabelValueType* buffer, LabelValueType oldValue, LabelValueType newValue);
+
+    /** Computes the center of mass of the label in index coordinates. Only the bricks occupied by the label are visited.
+    * @return false if the label has no voxel in the volume.*/
+    bool ComputeCenterOfMass(const LabelValueType* buffer, LabelValueType value, std::array<double, 3>& centerOfMass) const;
+
+  private:
+    using BrickLabelsType = std::vector<std::pair<LabelValueType, LabelStatistics>>;
+
+    struct LabelEntry
+    {
+      LabelStatistics Statistics;
+      /** Sorted indices of all bricks containing the label.*/
+      std::vector<std::size_t> Bricks;
+    };
+
+    std::size_t GetBrickIndex(unsigned int bx, unsigned int by, unsigned int bz) const;
+    void ScanBrick(const LabelValueType* buffer, std::size_t brickIndex, BrickLabelsType& labels) const;
+    void GetBrickRegion(std::size_t brickIndex, IndexType& minIndex, IndexType& maxIndex) const;
+    void UpdateBoundingBox(LabelValueType value);
+
+    static LabelStatistics* FindInBrick(BrickLabelsType& labels, LabelValueType value);
+    static const LabelStatistics* FindInBrick(const BrickLabelsType& labels, LabelValueType value);
+    static void Include(LabelStatistics& statistics, const LabelStatistics& other);
+
+    IndexType m_Dimensions;
+    IndexType m_BrickCounts;
+    bool m_IsBuilt;
+
+    std::vector<BrickLabelsType> m_Bricks;
+    std::unordered_map<LabelValueType, LabelEntry> m_Labels;
+  };
+}
+
+#endif
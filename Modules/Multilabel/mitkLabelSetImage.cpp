@@ -15,15 +15,20 @@ found in the LICENSE file.
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
 #include <mitkImagePixelWriteAccessor.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkPadImageFilter.h>
 #include <mitkDICOMSegmentationPropertyHelper.h>
 #include <mitkDICOMQIPropertyHelper.h>
 #include <mitkNodePredicateGeometry.h>
 
-#include <itkLabelGeometryImageFilter.h>
 #include <itkCommand.h>
 #include <itkBinaryFunctorImageFilter.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 
 namespace mitk
 {
@@ -186,6 +191,12 @@ void mitk::LabelSetImage::RemoveGroup(GroupIndexType indexToDelete)
     m_LayerContainer.erase(m_LayerContainer.begin() + indexToDelete);
   }
 
+  {
+    std::lock_guard<std::mutex> guard(m_OccupancyMutex);
+    if (indexToDelete < m_GroupOccupancies.size())
+      m_GroupOccupancies.erase(m_GroupOccupancies.begin() + indexToDelete);
+  }
+
   //update old indexes in m_GroupToLabelMap to new layer indexes
   for (auto& element : m_LabelToGroupMap)
   {
@@ -290,6 +301,11 @@ mitk::LabelSetImage::GroupIndexType mitk::LabelSetImage::AddLayer(mitk::Image* l
   // push a new working image for the new layer
   m_LayerContainer.push_back(layerImage);
 
+  {
+    std::lock_guard<std::mutex> guard(m_OccupancyMutex);
+    m_GroupOccupancies.resize(m_LayerContainer.size());
+  }
+
   m_Groups.push_back("");
   m_GroupToLabelMap.push_back({});
 
@@ -401,6 +417,9 @@ void mitk::LabelSetImage::SetGroupName(GroupIndexType groupID, const std::string
 
 void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
 {
+  // switching the layer only moves group content between images
+  const auto syncedGroups = this->GetSyncedOccupancyGroups();
+
   try
   {
     if (4 == this->GetDimension())
@@ -451,6 +470,7 @@ void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
     mitkThrow() << e.GetDescription();
   }
   this->Modified();
+  this->SetOccupancySynced(syncedGroups);
 }
 
 void mitk::LabelSetImage::SetActiveLabel(LabelValueType label)
@@ -462,7 +482,7 @@ void mitk::LabelSetImage::SetActiveLabel(LabelValueType label)
     auto groupID = this->GetGroupIndexOfLabel(label);
     if (groupID!=this->GetActiveLayer()) this->SetActiveLayer(groupID);
   }
-  Modified();
+  this->ModifiedKeepingOccupancy();
 }
 
 void mitk::LabelSetImage::ClearBuffer()
@@ -480,42 +500,30 @@ void mitk::LabelSetImage::ClearBuffer()
 
 void mitk::LabelSetImage::MergeLabel(PixelType pixelValue, PixelType sourcePixelValue)
 {
-  try
-  {
-    AccessByItk_2(this, MergeLabelProcessing, pixelValue, sourcePixelValue);
-  }
-  catch (itk::ExceptionObject &e)
-  {
-    mitkThrow() << e.GetDescription();
-  }
+  this->ReplaceLabelInGroup(this->GetActiveLayer(), sourcePixelValue, pixelValue);
+
   this->SetActiveLabel(pixelValue);
   this->InvokeEvent(LabelModifiedEvent(sourcePixelValue));
   this->InvokeEvent(LabelModifiedEvent(pixelValue));
   this->InvokeEvent(LabelsChangedEvent({ sourcePixelValue, pixelValue }));
-  Modified();
+  this->ModifiedKeepingOccupancy();
 }
 
 void mitk::LabelSetImage::MergeLabels(PixelType pixelValue, const std::vector<PixelType>& vectorOfSourcePixelValues)
 {
-  try
-  {
-    for (unsigned int idx = 0; idx < vectorOfSourcePixelValues.size(); idx++)
-    {
-      AccessByItk_2(this, MergeLabelProcessing, pixelValue, vectorOfSourcePixelValues[idx]);
-      this->InvokeEvent(LabelModifiedEvent(vectorOfSourcePixelValues[idx]));
-    }
-  }
-  catch (itk::ExceptionObject &e)
+  for (const auto sourcePixelValue : vectorOfSourcePixelValues)
   {
-    mitkThrow() << e.GetDescription();
+    this->ReplaceLabelInGroup(this->GetActiveLayer(), sourcePixelValue, pixelValue);
+    this->InvokeEvent(LabelModifiedEvent(sourcePixelValue));
   }
+
   this->SetActiveLabel(pixelValue);
   this->InvokeEvent(LabelModifiedEvent(pixelValue));
   auto modifiedValues = vectorOfSourcePixelValues;
   modifiedValues.push_back(pixelValue);
   this->InvokeEvent(LabelsChangedEvent(modifiedValues));
 
-  Modified();
+  this->ModifiedKeepingOccupancy();
 }
 
 void mitk::LabelSetImage::RemoveLabel(LabelValueType pixelValue)
@@ -569,30 +577,13 @@ void mitk::LabelSetImage::RemoveLabels(const LabelValueVectorType& vectorOfLabel
 
 void mitk::LabelSetImage::EraseLabel(LabelValueType pixelValue)
 {
-  try
-  {
-    auto groupID = this->GetGroupIndexOfLabel(pixelValue);
-
-    mitk::Image* groupImage = this->GetGroupImage(groupID);
+  auto groupID = this->GetGroupIndexOfLabel(pixelValue);
 
-    if (4 == this->GetDimension())
-    {
-      AccessFixedDimensionByItk_1(groupImage, EraseLabelProcessing, 4, pixelValue);
-    }
-    else
-    {
-      AccessByItk_1(groupImage, EraseLabelProcessing, pixelValue);
-    }
-    groupImage->Modified();
-  }
-  catch (const itk::ExceptionObject& e)
-  {
-    mitkThrow() << e.GetDescription();
-  }
+  this->ReplaceLabelInGroup(groupID, pixelValue, UNLABELED_VALUE);
 
   this->InvokeEvent(LabelModifiedEvent(pixelValue));
   this->InvokeEvent(LabelsChangedEvent({ pixelValue }));
-  Modified();
+  this->ModifiedKeepingOccupancy();
 }
 
 void mitk::LabelSetImage::EraseLabels(const LabelValueVectorType& labelValues)
@@ -650,7 +641,7 @@ mitk::Label* mitk::LabelSetImage::AddLabel(mitk::Label* label, GroupIndexType gr
 
   this->InvokeEvent(LabelAddedEvent(newLabel->GetValue()));
   m_ActiveLabelValue = newLabel->GetValue();
-  this->Modified();
+  this->ModifiedKeepingOccupancy();
 
   return newLabel;
 }
@@ -667,7 +658,8 @@ mitk::Label* mitk::LabelSetImage::AddLabelWithContent(Label* label, const Image*
     mitk::LabelSetImage::UNLABELED_VALUE, mitk::LabelSetImage::UNLABELED_VALUE, false, { {contentLabelValue, newLabel->GetValue()}},
     mitk::MultiLabelSegmentation::MergeStyle::Replace, mitk::MultiLabelSegmentation::OverwriteStyle::RegardLocks);
 
-  this->Modified();
+  // the transfer has already announced its write
+  this->ModifiedKeepingOccupancy();
 
   return newLabel;
 }
@@ -715,20 +707,257 @@ const mitk::Label* mitk::LabelSetImage::GetActiveLabel() const
 
 void mitk::LabelSetImage::UpdateCenterOfMass(PixelType pixelValue)
 {
-  if (4 == this->GetDimension())
+  if (3 != this->GetDimension())
   {
-    AccessFixedDimensionByItk_1(this->GetGroupImage(this->GetGroupIndexOfLabel(pixelValue)), CalculateCenterOfMassProcessing, 4, pixelValue);
+    return;
   }
-  else
+
+  const auto groupID = this->GetGroupIndexOfLabel(pixelValue);
+  const auto* groupImage = this->GetGroupImage(groupID);
+
+  std::array<double, 3> centerOfMass;
+  bool isEmpty = false;
+
+  {
+    std::lock_guard<std::mutex> guard(m_OccupancyMutex);
+    const auto& index = this->GetOccupancyIndex(groupID, 0);
+    ImageReadAccessor accessor(groupImage, groupImage->GetVolumeData(0));
+    isEmpty = !index.ComputeCenterOfMass(static_cast<const PixelType*>(accessor.GetData()), pixelValue, centerOfMass);
+  }
+
+  if (isEmpty)
+  {
+    return;
+  }
+
+  mitk::Point3D pos;
+  pos[0] = centerOfMass[0];
+  pos[1] = centerOfMass[1];
+  pos[2] = centerOfMass[2];
+
+  auto label = this->GetLabel(pixelValue);
+  if (label.IsNotNull())
+  {
+    label->SetCenterOfMassIndex(pos);
+    this->GetSlicedGeometry()->IndexToWorld(pos, pos);
+    label->SetCenterOfMassCoordinates(pos);
+  }
+}
+
+bool mitk::LabelSetImage::IsLabelEmpty(LabelValueType value, TimeStepType t) const
+{
+  return 0 == this->GetLabelVoxelCount(value, t);
+}
+
+std::size_t mitk::LabelSetImage::GetLabelVoxelCount(LabelValueType value, TimeStepType t) const
+{
+  return this->GetLabelStatistics(value, t).VoxelCount;
+}
+
+mitk::LabelOccupancyIndex::LabelStatistics mitk::LabelSetImage::GetLabelStatistics(LabelValueType value, TimeStepType t) const
+{
+  const auto groupID = this->GetGroupIndexOfLabel(value);
+
+  std::lock_guard<std::mutex> guard(m_OccupancyMutex);
+  const auto* statistics = this->GetOccupancyIndex(groupID, t).GetStatistics(value);
+
+  return nullptr != statistics ? *statistics : LabelOccupancyIndex::LabelStatistics();
+}
+
+void mitk::LabelSetImage::UpdateLabelOccupancy(GroupIndexType groupID, TimeStepType t,
+  const LabelOccupancyIndex::IndexType& minIndex, const LabelOccupancyIndex::IndexType& maxIndex)
+{
+  if (!this->ExistGroup(groupID))
+    mitkThrow() << "Cannot update label occupancy. Group ID is invalid. Invalid ID: " << groupID;
+
+  const auto* groupImage = this->GetGroupImage(groupID);
+
+  std::lock_guard<std::mutex> guard(m_OccupancyMutex);
+
+  if (m_GroupOccupancies.size() <= groupID)
+    return;
+
+  auto& occupancy = m_GroupOccupancies[groupID];
+
+  if (0 == occupancy.SyncedMTime || occupancy.TimeSteps.size() <= t)
+    return; // nothing indexed yet, the index will be built on demand
+
+  // The index may only be updated incrementally if it was in sync with the group image
+  // before the announced write, i.e. the announced write was the only modification since
+  // the last sync (or the write was not followed by Modified() at all).
+  bool syncedBeforeWrite = occupancy.ObservedImage == groupImage && nullptr != occupancy.History;
+  if (syncedBeforeWrite)
+  {
+    std::lock_guard<std::mutex> historyGuard(occupancy.History->Mutex);
+    syncedBeforeWrite = occupancy.SyncedMTime == occupancy.History->CurrentMTime ||
+                        occupancy.SyncedMTime == occupancy.History->PreviousMTime;
+  }
+
+  if (!syncedBeforeWrite)
+  {
+    // group image was also modified without announcement; reindex lazily
+    occupancy.SyncedMTime = 0;
+    return;
+  }
+
+  auto& index = occupancy.TimeSteps[t];
+
+  if (index.IsBuilt())
+  {
+    ImageReadAccessor accessor(groupImage, groupImage->GetVolumeData(t));
+    index.Update(static_cast<const PixelType*>(accessor.GetData()), minIndex, maxIndex);
+  }
+
+  occupancy.SyncedMTime = groupImage->GetMTime();
+}
+
+void mitk::LabelSetImage::UpdateLabelOccupancy(GroupIndexType groupID, TimeStepType t, const BaseGeometry* modifiedRegion)
+{
+  if (nullptr == modifiedRegion)
+    mitkThrow() << "Cannot update label occupancy. Passed geometry is nullptr.";
+
+  const auto* geometry = this->GetGeometry(t);
+
+  LabelOccupancyIndex::IndexType minIndex, maxIndex;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    minIndex[i] = std::numeric_limits<unsigned int>::max();
+    maxIndex[i] = 0;
+  }
+
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    Point3D index;
+    geometry->WorldToIndex(modifiedRegion->GetCornerPoint(corner), index);
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      // one voxel margin to cover the rounding of pixel writers
+      const auto extent = static_cast<double>(this->GetDimension(i)) - 1.;
+      const auto lower = std::clamp(std::floor(index[i]) - 1., 0., extent);
+      const auto upper = std::clamp(std::ceil(index[i]) + 1., 0., extent);
+
+      minIndex[i] = std::min(minIndex[i], static_cast<unsigned int>(lower));
+      maxIndex[i] = std::max(maxIndex[i], static_cast<unsigned int>(upper));
+    }
+  }
+
+  this->UpdateLabelOccupancy(groupID, t, minIndex, maxIndex);
+}
+
+mitk::LabelOccupancyIndex& mitk::LabelSetImage::GetOccupancyIndex(GroupIndexType groupID, TimeStepType t) const
+{
+  const auto* groupImage = this->GetGroupImage(groupID);
+
+  if (m_GroupOccupancies.size() <= groupID)
+    m_GroupOccupancies.resize(m_LayerContainer.size());
+
+  auto& occupancy = m_GroupOccupancies[groupID];
+  const auto timeSteps = groupImage->GetTimeSteps();
+
+  if (t >= timeSteps)
+    mitkThrow() << "Cannot access label occupancy. Time step is invalid. Invalid time step: " << t;
+
+  if (occupancy.SyncedMTime != groupImage->GetMTime() || occupancy.TimeSteps.size() != timeSteps ||
+      occupancy.ObservedImage != groupImage)
+  {
+    // group image was modified without announcement; reindex lazily
+    const LabelOccupancyIndex::IndexType dimensions = { {groupImage->GetDimension(0), groupImage->GetDimension(1),
+      groupImage->GetDimension() > 2 ? groupImage->GetDimension(2) : 1} };
+
+    occupancy.TimeSteps.assign(timeSteps, LabelOccupancyIndex());
+    for (auto& index : occupancy.TimeSteps)
+      index.Reset(dimensions);
+
+    ObserveGroupImage(occupancy, groupImage);
+    occupancy.SyncedMTime = groupImage->GetMTime();
+  }
+
+  auto& index = occupancy.TimeSteps[t];
+
+  if (!index.IsBuilt())
+  {
+    ImageReadAccessor accessor(groupImage, groupImage->GetVolumeData(t));
+    index.Build(static_cast<const PixelType*>(accessor.GetData()));
+  }
+
+  return index;
+}
+
+void mitk::LabelSetImage::ObserveGroupImage(GroupOccupancy& occupancy, const Image* groupImage)
+{
+  if (occupancy.ObservedImage == groupImage && nullptr != occupancy.History)
+    return;
+
+  auto history = std::make_shared<ModificationHistory>();
+  history->CurrentMTime = groupImage->GetMTime();
+
+  occupancy.ObserverGuard.Reset(groupImage, itk::ModifiedEvent(), [history, groupImage](const itk::EventObject&) {
+    std::lock_guard<std::mutex> guard(history->Mutex);
+    history->PreviousMTime = history->CurrentMTime;
+    history->CurrentMTime = groupImage->GetMTime();
+  });
+
+  occupancy.ObservedImage = groupImage;
+  occupancy.History = history;
+}
+
+std::vector<mitk::LabelSetImage::GroupIndexType> mitk::LabelSetImage::GetSyncedOccupancyGroups() const
+{
+  std::vector<GroupIndexType> result;
+
+  std::lock_guard<std::mutex> guard(m_OccupancyMutex);
+  for (GroupIndexType groupID = 0; groupID < m_GroupOccupancies.size() && groupID < m_LayerContainer.size(); ++groupID)
+  {
+    const auto& occupancy = m_GroupOccupancies[groupID];
+    if (0 != occupancy.SyncedMTime && occupancy.SyncedMTime == this->GetGroupImage(groupID)->GetMTime())
+      result.push_back(groupID);
+  }
+
+  return result;
+}
+
+void mitk::LabelSetImage::SetOccupancySynced(const std::vector<GroupIndexType>& groupIDs) const
+{
+  std::lock_guard<std::mutex> guard(m_OccupancyMutex);
+  for (const auto groupID : groupIDs)
+  {
+    if (groupID < m_GroupOccupancies.size() && this->ExistGroup(groupID))
+      m_GroupOccupancies[groupID].SyncedMTime = this->GetGroupImage(groupID)->GetMTime();
+  }
+}
+
+void mitk::LabelSetImage::ModifiedKeepingOccupancy()
+{
+  const auto syncedGroups = this->GetSyncedOccupancyGroups();
+  this->Modified();
+  this->SetOccupancySynced(syncedGroups);
+}
+
+void mitk::LabelSetImage::ReplaceLabelInGroup(GroupIndexType groupID, PixelType oldValue, PixelType newValue)
+{
+  auto* groupImage = this->GetGroupImage(groupID);
+
   {
-    AccessByItk_1(this->GetGroupImage(this->GetGroupIndexOfLabel(pixelValue)), CalculateCenterOfMassProcessing, pixelValue);
+    std::lock_guard<std::mutex> guard(m_OccupancyMutex);
+    const auto timeSteps = groupImage->GetTimeSteps();
+
+    for (TimeStepType t = 0; t < timeSteps; ++t)
+    {
+      auto& index = this->GetOccupancyIndex(groupID, t);
+      ImageWriteAccessor accessor(groupImage, groupImage->GetVolumeData(t));
+      index.ReplaceLabel(static_cast<PixelType*>(accessor.GetData()), oldValue, newValue);
+    }
   }
+
+  groupImage->Modified();
+  this->SetOccupancySynced({ groupID });
 }
 
 void mitk::LabelSetImage::SetLookupTable(mitk::LookupTable* lut)
 {
   m_LookupTable = lut;
-  this->Modified();
+  this->ModifiedKeepingOccupancy();
 }
 
 void mitk::LabelSetImage::UpdateLookupTable(PixelType pixelValue)
@@ -924,33 +1153,6 @@ void mitk::LabelSetImage::MaskStampProcessing(ImageType *itkImage, mitk::Image *
   this->Modified();
 }
 
-template <typename ImageType>
-void mitk::LabelSetImage::CalculateCenterOfMassProcessing(ImageType *itkImage, LabelValueType pixelValue)
-{
-  if (ImageType::GetImageDimension() != 3)
-  {
-    return;
-  }
-
-  auto labelGeometryFilter = itk::LabelGeometryImageFilter<ImageType>::New();
-  labelGeometryFilter->SetInput(itkImage);
-  labelGeometryFilter->Update();
-  auto centroid = labelGeometryFilter->GetCentroid(pixelValue);
-
-  mitk::Point3D pos;
-  pos[0] = centroid[0];
-  pos[1] = centroid[1];
-  pos[2] = centroid[2];
-
-  auto label = this->GetLabel(pixelValue);
-  if (label.IsNotNull())
-  {
-    label->SetCenterOfMassIndex(pos);
-    this->GetSlicedGeometry()->IndexToWorld(pos, pos);
-    label->SetCenterOfMassCoordinates(pos);
-  }
-}
-
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::LabelSetImage::LayerContainerToImageProcessing(itk::Image<TPixel, VImageDimension> *target,
                                                           unsigned int layer)
@@ -1004,44 +1206,6 @@ void mitk::LabelSetImage::ImageToLayerContainerProcessing(const itk::Image<TPixe
   m_LayerContainer[layer]->Modified();
 }
 
-template <typename ImageType>
-void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage, PixelType pixelValue)
-{
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
-
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  while (!iter.IsAtEnd())
-  {
-    PixelType value = iter.Get();
-
-    if (value == pixelValue)
-    {
-      iter.Set(0);
-    }
-    ++iter;
-  }
-}
-
-template <typename ImageType>
-void mitk::LabelSetImage::MergeLabelProcessing(ImageType *itkImage, PixelType pixelValue, PixelType index)
-{
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
-
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  while (!iter.IsAtEnd())
-  {
-    if (iter.Get() == index)
-    {
-      iter.Set(pixelValue);
-    }
-    ++iter;
-  }
-}
-
 void mitk::LabelSetImage::AddLabelToMap(LabelValueType labelValue, mitk::Label* label, GroupIndexType groupID)
 {
   if (m_LabelMap.find(labelValue)!=m_LabelMap.end())
@@ -1097,7 +1261,10 @@ void mitk::LabelSetImage::OnLabelModified(const Object* sender, const itk::Event
   if (nullptr == label)
     mitkThrow() << "LabelSet is in wrong state. LabelModified event is not send by a label instance.";
 
+  // label properties do not affect the pixel content
+  const auto syncedGroups = this->GetSyncedOccupancyGroups();
   Superclass::Modified();
+  this->SetOccupancySynced(syncedGroups);
   this->InvokeEvent(LabelModifiedEvent(label->GetValue()));
 }
 
@@ -1674,6 +1841,12 @@ void mitk::TransferLabelContentAtTimeStep(
     AccessFixedPixelTypeByItk_n(sourceImageAtTimeStep, TransferLabelContentAtTimeStepHelper, (Label::PixelType), (destinationImageAtTimeStep, destinationLabels, sourceBackground, destinationBackground, destinationBackgroundLocked, sourceLabel, newDestinationLabel, mergeStyle, overwriteStlye));
   }
   destinationImage->Modified();
+
+  if (auto* labelSetImage = dynamic_cast<LabelSetImage*>(destinationImage))
+  {
+    // only the region covered by the (padded) source image can have changed
+    labelSetImage->UpdateLabelOccupancy(labelSetImage->GetActiveLayer(), timeStep, sourceImageAtTimeStep->GetGeometry());
+  }
 }
 
 void mitk::TransferLabelContent(
@@ -13,9 +13,12 @@ found in the LICENSE file.
 #ifndef mitkLabelSetImage_h
 #define mitkLabelSetImage_h
 
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <mitkImage.h>
 #include <mitkLabel.h>
+#include <mitkLabelOccupancyIndex.h>
 #include <mitkLookupTable.h>
 #include <mitkMultiLabelEvents.h>
 #include <mitkMessage.h>
@@ -284,6 +287,36 @@ namespace mitk
     * @remark is no unused label value can be provided an exception will be thrown.*/
     LabelValueType GetUnusedLabelValue() const;
 
+    /** Returns true if the label has no pixel in the indicated time step.
+    The check uses the label occupancy index of the group of the label (see LabelOccupancyIndex).
+    The index is maintained by the pixel operations of this class and by TransferLabelContentAtTimeStep().
+    Modifications of a group image that are not announced via UpdateLabelOccupancy() are detected by the
+    modification time of the group image and lead to a rebuild of the index on next query.
+    @pre Requested label does exist.*/
+    bool IsLabelEmpty(LabelValueType value, TimeStepType t = 0) const;
+
+    /** Returns the number of pixels of the label in the indicated time step.
+    @pre Requested label does exist.
+    @sa IsLabelEmpty*/
+    std::size_t GetLabelVoxelCount(LabelValueType value, TimeStepType t = 0) const;
+
+    /** Returns voxel count and (inclusive) index bounding box of the label in the indicated time step.
+    The voxel count is 0 and the bounding box undefined if the label is empty.
+    @pre Requested label does exist.
+    @sa IsLabelEmpty*/
+    LabelOccupancyIndex::LabelStatistics GetLabelStatistics(LabelValueType value, TimeStepType t = 0) const;
+
+    /** Announces that the pixels of a group image have been modified only within the passed (inclusive)
+    index region of the indicated time step since the last modification done or announced.
+    This allows to update the label occupancy index incrementally instead of rebuilding it.
+    Call it after the modification (and after calling Modified() for the group image).*/
+    void UpdateLabelOccupancy(GroupIndexType groupID, TimeStepType t,
+      const LabelOccupancyIndex::IndexType& minIndex, const LabelOccupancyIndex::IndexType& maxIndex);
+
+    /** Convenience overload that announces the index region covered by the bounding box of the passed
+    geometry (e.g. the plane geometry of a written slice).*/
+    void UpdateLabelOccupancy(GroupIndexType groupID, TimeStepType t, const BaseGeometry* modifiedRegion);
+
     itkGetConstMacro(UnlabeledLabelLock, bool);
     itkSetMacro(UnlabeledLabelLock, bool);
     itkBooleanMacro(UnlabeledLabelLock);
@@ -413,6 +446,45 @@ namespace mitk
       /** Mutex used to secure manipulations of the internal state of label and group maps.*/
       std::shared_mutex m_LabelNGroupMapsMutex;
 
+      /** Modification times of a group image before and after its latest modification.
+      Recorded by an observer of the ModifiedEvent of the group image.*/
+      struct ModificationHistory
+      {
+        std::mutex Mutex;
+        itk::ModifiedTimeType PreviousMTime = 0;
+        itk::ModifiedTimeType CurrentMTime = 0;
+      };
+
+      struct GroupOccupancy
+      {
+        /** Label occupancy index for each time step of the group image.*/
+        std::vector<LabelOccupancyIndex> TimeSteps;
+        /** Modification time of the group image the indices belong to.*/
+        itk::ModifiedTimeType SyncedMTime = 0;
+        /** Group image whose modifications are recorded in History.*/
+        const Image* ObservedImage = nullptr;
+        ITKEventObserverGuard ObserverGuard;
+        std::shared_ptr<ModificationHistory> History;
+      };
+
+      /** Returns the up-to-date (and built) occupancy index of a group and time step.
+      @pre m_OccupancyMutex is locked.*/
+      LabelOccupancyIndex& GetOccupancyIndex(GroupIndexType groupID, TimeStepType t) const;
+      /** Starts recording the modifications of the passed group image in the history of the occupancy.
+      @pre m_OccupancyMutex is locked.*/
+      static void ObserveGroupImage(GroupOccupancy& occupancy, const Image* groupImage);
+
+      /** Returns all groups whose occupancy indices reflect the current content of the group images.*/
+      std::vector<GroupIndexType> GetSyncedOccupancyGroups() const;
+      /** Marks the occupancy indices of the passed groups as reflecting the current group images.*/
+      void SetOccupancySynced(const std::vector<GroupIndexType>& groupIDs) const;
+      /** Calls Modified() for changes that do not alter pixel content, so the occupancy indices stay valid.*/
+      void ModifiedKeepingOccupancy();
+
+      /** Label occupancy indices per group (see LabelOccupancyIndex).*/
+      mutable std::vector<GroupOccupancy> m_GroupOccupancies;
+      mutable std::mutex m_OccupancyMutex;
+
     public:
 
 
@@ -530,14 +602,9 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void ImageToLayerContainerProcessing(const itk::Image<TPixel, VImageDimension> *source, unsigned int layer) const;
 
-    template <typename ImageType>
-    void CalculateCenterOfMassProcessing(ImageType *input, LabelValueType index);
-
-    template <typename ImageType>
-    void EraseLabelProcessing(ImageType *input, PixelType index);
-
-    template <typename ImageType>
-    void MergeLabelProcessing(ImageType *input, PixelType pixelValue, PixelType index);
+    /** Replaces oldValue by newValue in all time steps of a group image by using the occupancy index
+    (so only bricks containing oldValue are visited).*/
+    void ReplaceLabelInGroup(GroupIndexType groupID, PixelType oldValue, PixelType newValue);
 
     template <typename ImageType>
     void MaskStampProcessing(ImageType *input, mitk::Image *mask, bool forceOverwrite);
@@ -661,6 +728,8 @@ namespace mitk
   /**Helper function that transfers pixels of the specified source label from source image to the destination image by using
   a specified destination label for a specific time step. Function processes the whole image volume of the specified time step.
   @remark the function assumes that it is only called with source and destination image of same geometry.
+  @remark If destinationImage is a LabelSetImage, the written region is announced to its label occupancy index
+  (see LabelSetImage::UpdateLabelOccupancy()).
   @remark CAUTION: The function is not save, if sourceImage and destinationImage are the same instance and you transfer more then one
   label, because the changes are made in-place for performance reasons but not in one pass. If a mapped value A equals a "old value"
   that is later in the mapping, one ends up with a wrong transfer, as a pixel would be first mapped to A and then latter again, because
@@ -8,6 +8,7 @@ SET(CPP_FILES
   mitkIsoDoseLevelVectorProperty.cpp
   mitkDoseImageVtkMapper2D.cpp
   mitkIsoLevelsGenerator.cpp
+  mitkIsoDoseLineGenerator.cpp
   mitkDoseNodeHelper.cpp
   mitkDICOMRTMimeTypes.cpp
 )
@@ -21,12 +21,15 @@ found in the LICENSE file.
 #include "mitkBaseRenderer.h"
 #include "mitkVtkMapper.h"
 #include "mitkExtractSliceFilter.h"
+#include "mitkIsoDoseLineGenerator.h"
 
 //VTK
 #include <vtkSmartPointer.h>
 #include <vtkPropAssembly.h>
 #include <vtkCellArray.h>
 
+#include <list>
+
 class vtkActor;
 class vtkPolyDataMapper;
 class vtkPlaneSource;
@@ -175,6 +178,29 @@ namespace mitk {
       For instance, if you zoom or pann, there is no need to recompute the contour. */
       vtkSmartPointer<vtkPolyData> m_OutlinePolyData;
 
+      /** \brief Identifies the iso lines of a slice: the resliced dose slice and the visible levels. */
+      struct IsoLineCacheKey
+      {
+        /** Origin and both axis vectors of the world plane geometry. */
+        std::array<double, 9> Plane;
+        TimeStepType TimeStep;
+        itk::ModifiedTimeType DoseMTime;
+        int ResliceInterpolation;
+        int ThickSlicesMode;
+        int ThickSlicesNum;
+        std::array<int, 2> Dimensions;
+        std::array<double, 2> Spacing;
+        double Depth;
+        bool Interpolate;
+        std::vector<IsoDoseLineGenerator::Level> Levels;
+
+        bool operator==(const IsoLineCacheKey& other) const;
+      };
+
+      /** \brief Iso lines of the recently rendered slices, most recently used first.
+      Scrolling back to a slice does not require to contour the dose again. */
+      std::list<std::pair<IsoLineCacheKey, vtkSmartPointer<vtkPolyData>>> m_IsoLineCache;
+
       /** \brief Timestamp of last update of stored data. */
       itk::TimeStamp m_LastUpdateTime;
 
@@ -225,11 +251,13 @@ namespace mitk {
     */
     void GeneratePlane(mitk::BaseRenderer* renderer, double planeBounds[6]);
 
-    /** \brief Generates a vtkPolyData object containing the outline of a given binary slice.
+    /** \brief Generates a vtkPolyData object containing the iso lines of all visible iso dose levels
+    of the current slice (see IsoDoseLineGenerator). The result is taken from the iso line cache of the
+    local storage if the slice and the levels did not change.
     \param renderer: Pointer to the renderer containing the needed information
-    \note This code is based on code from the iil library.
+    \param sliceKey: Cache key with the slice related members set; the remaining members are set here.
     */
-    vtkSmartPointer<vtkPolyData> CreateOutlinePolyData(mitk::BaseRenderer* renderer);
+    vtkSmartPointer<vtkPolyData> CreateOutlinePolyData(mitk::BaseRenderer* renderer, LocalStorage::IsoLineCacheKey sliceKey);
 
     /** Default constructor */
     DoseImageVtkMapper2D();
@@ -292,10 +320,6 @@ namespace mitk {
     * If the distances have different sign, there is an intersection.
     **/
     bool RenderingGeometryIntersectsImage( const PlaneGeometry* renderingGeometry, SlicedGeometry3D* imageGeometry );
-
-  private:
-    void CreateLevelOutline(mitk::BaseRenderer* renderer, const mitk::IsoDoseLevel* level, float pref, vtkSmartPointer<vtkPoints> points, vtkSmartPointer<vtkCellArray> lines,  vtkSmartPointer<vtkUnsignedCharArray> colors);
-
   };
 
 } // namespace mitk
@@ -0,0 +1,75 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkIsoDoseLineGenerator_h
+#define mitkIsoDoseLineGenerator_h
+
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <array>
+#include <vector>
+
+#include "MitkRTExports.h"
+
+namespace mitk
+{
+  /**
+  \brief Extracts the iso lines of several dose levels from a 2D dose slice in a single pass.
+
+  Every pixel edge (or marching squares cell) is visited once for all levels: the levels are sorted by their
+  dose values, so that the levels crossed by an edge are found by binary search. The slice is split into row
+  bands that are processed in parallel; all line segments refer to shared vertices.
+
+  Two kinds of iso lines can be generated:
+  - Pixel outlines (default): the outlines of all pixels with a dose >= the level, running along pixel edges
+    (pixel corners are at multiples of the spacing) and along the border of the slice. Adjacent horizontal
+    edges are merged into single line segments.
+  - Interpolated lines: marching squares on the pixel centers (at (index + 0.5) * spacing) with linear
+    interpolation of the vertex positions. Saddle cells are resolved by the average dose of the cell.
+
+  The output contains one line cell per segment with the RGB color of its level as cell scalars ("Colors").
+  */
+  class MITKRT_EXPORT IsoDoseLineGenerator
+  {
+  public:
+    struct Level
+    {
+      /** Absolute dose value of the level. */
+      double DoseValue;
+      std::array<unsigned char, 3> Color;
+
+      bool operator==(const Level& other) const
+      {
+        return DoseValue == other.DoseValue && Color == other.Color;
+      }
+    };
+
+    /** \brief Generates the iso lines of all levels.
+    \param slice Row-major dose values of size width*height.
+    \param spacing Pixel spacing in x and y.
+    \param depth z coordinate of all generated points.
+    \param interpolate Generate interpolated lines instead of pixel outlines.*/
+    static vtkSmartPointer<vtkPolyData> Generate(const float* slice,
+                                                 int width,
+                                                 int height,
+                                                 const double spacing[2],
+                                                 double depth,
+                                                 std::vector<Level> levels,
+                                                 bool interpolate = false);
+
+  private:
+    IsoDoseLineGenerator() = delete;
+  };
+}
+
+#endif
@@ -86,6 +86,12 @@ struct MITKRT_EXPORT RTConstants
       */
   static const std::string DOSE_SHOW_ISOLINES_PROPERTY_NAME;
 
+  /**
+      * Name of the property that encodes if the iso lines should be interpolated between the pixel centers
+      * instead of following the pixel outlines.
+      */
+  static const std::string DOSE_ISO_LINE_INTERPOLATION_PROPERTY_NAME;
+
   /**
       * Name of the property that encodes if the color wash rendering should be activated for the node.
       */
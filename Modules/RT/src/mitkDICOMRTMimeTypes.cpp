@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include <mitkDICOMRTMimeTypes.h>
 
 #include <mitkIOMimeTypes.h>
+#include <mitkFileContentSniffer.h>
 
 #include <mitkDICOMDCMTKTagScanner.h>
 #include <mitkDICOMTagPath.h>
@@ -77,32 +78,41 @@ bool DICOMRTMimeTypes::RTDoseMimeType::AppliesTo(const std::string &path) const
 
 std::string DICOMRTMimeTypes::GetModality(const std::string & path)
 {
-  const auto modalityTagPath = DICOMTagPath(0x0008, 0x0060);
+  // shared between all RT mime types, so the tags are scanned only once per file
+  return FileContentSniffer::Sniff(path)->GetValue("MitkRT.Modality", [&path]()
+  {
+    const auto modalityTagPath = DICOMTagPath(0x0008, 0x0060);
 
-  mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
-  scanner->SetInputFiles({ path });
-  scanner->AddTagPaths({ modalityTagPath });
-  scanner->Scan();
+    mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
+    scanner->SetInputFiles({ path });
+    scanner->AddTagPaths({ modalityTagPath });
+    scanner->Scan();
 
-  mitk::DICOMDatasetAccessingImageFrameList frames = scanner->GetFrameInfoList();
-  std::string modality = "";
-  if (frames.empty())
-    return modality;
-  auto findings = frames.front()->GetTagValueAsString(modalityTagPath);
+    mitk::DICOMDatasetAccessingImageFrameList frames = scanner->GetFrameInfoList();
+    std::string modality = "";
+    if (frames.empty())
+      return modality;
+    auto findings = frames.front()->GetTagValueAsString(modalityTagPath);
 
-  modality = findings.front().value;
-  return modality;
+    modality = findings.front().value;
+    return modality;
+  });
 }
 
 bool DICOMRTMimeTypes::canReadByDicomFileReader(const std::string & filename)
 {
-  mitk::DICOMFileReaderSelector::Pointer selector = mitk::DICOMFileReaderSelector::New();
-  selector->LoadBuiltIn3DConfigs();
-  selector->SetInputFiles({ filename });
+  auto canRead = FileContentSniffer::Sniff(filename)->GetValue("MitkRT.CanReadByDicomFileReader", [&filename]()
+  {
+    mitk::DICOMFileReaderSelector::Pointer selector = mitk::DICOMFileReaderSelector::New();
+    selector->LoadBuiltIn3DConfigs();
+    selector->SetInputFiles({ filename });
+
+    mitk::DICOMFileReader::Pointer reader = selector->GetFirstReaderWithMinimumNumberOfOutputImages();
 
-  mitk::DICOMFileReader::Pointer reader = selector->GetFirstReaderWithMinimumNumberOfOutputImages();
+    return std::string(reader.IsNotNull() ? "1" : "0");
+  });
 
-  return reader.IsNotNull();
+  return canRead == "1";
 }
 
 DICOMRTMimeTypes::RTDoseMimeType* DICOMRTMimeTypes::RTDoseMimeType::Clone() const
@@ -58,6 +58,14 @@ found in the LICENSE file.
 // ITK
 #include <itkRGBAPixel.h>
 
+#include <algorithm>
+
+namespace
+{
+  /** Number of slices whose iso lines are kept per render window. */
+  constexpr std::size_t MaximumNumberOfCachedIsoLineSlices = 16;
+}
+
 mitk::DoseImageVtkMapper2D::DoseImageVtkMapper2D()
 {
 }
@@ -164,12 +172,12 @@ void mitk::DoseImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *ren
 
   // Initialize the interpolation mode for resampling; switch to nearest
   // neighbor if the input image is too small.
+  int interpolationMode = VTK_RESLICE_NEAREST;
   if ((input->GetDimension() >= 3) && (input->GetDimension(2) > 1))
   {
     VtkResliceInterpolationProperty *resliceInterpolationProperty;
     datanode->GetProperty(resliceInterpolationProperty, "reslice interpolation");
 
-    int interpolationMode = VTK_RESLICE_NEAREST;
     if (resliceInterpolationProperty != nullptr)
     {
       interpolationMode = resliceInterpolationProperty->GetInterpolation();
@@ -328,7 +336,18 @@ void mitk::DoseImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *ren
   if (showIsoLines) // contour rendering
   {
     // generate contours/outlines
-    localStorage->m_OutlinePolyData = CreateOutlinePolyData(renderer);
+    LocalStorage::IsoLineCacheKey sliceKey;
+    const auto origin = worldGeometry->GetOrigin();
+    const auto axis0 = worldGeometry->GetAxisVector(0);
+    const auto axis1 = worldGeometry->GetAxisVector(1);
+    sliceKey.Plane = {origin[0], origin[1], origin[2], axis0[0], axis0[1], axis0[2], axis1[0], axis1[1], axis1[2]};
+    sliceKey.TimeStep = this->GetTimestep();
+    sliceKey.DoseMTime = input->GetMTime();
+    sliceKey.ResliceInterpolation = interpolationMode;
+    sliceKey.ThickSlicesMode = thickSlicesMode;
+    sliceKey.ThickSlicesNum = thickSlicesNum;
+
+    localStorage->m_OutlinePolyData = CreateOutlinePolyData(renderer, sliceKey);
 
     float binaryOutlineWidth(1.0);
     if (datanode->GetFloatProperty("outline width", binaryOutlineWidth, renderer))
@@ -676,6 +695,8 @@ void mitk::DoseImageVtkMapper2D::SetDefaultProperties(mitk::DataNode *node,
   node->AddProperty("outline binary shadow", mitk::BoolProperty::New(false), renderer, overwrite);
   node->AddProperty("outline binary shadow color", ColorProperty::New(0.0, 0.0, 0.0), renderer, overwrite);
   node->AddProperty("outline shadow width", mitk::FloatProperty::New(1.5), renderer, overwrite);
+  node->AddProperty(mitk::RTConstants::DOSE_ISO_LINE_INTERPOLATION_PROPERTY_NAME.c_str(),
+                    mitk::BoolProperty::New(false), renderer, overwrite);
   if (image->IsRotated())
     node->AddProperty("reslice interpolation", mitk::VtkResliceInterpolationProperty::New(VTK_RESLICE_CUBIC));
   else
@@ -842,17 +863,22 @@ mitk::DoseImageVtkMapper2D::LocalStorage *mitk::DoseImageVtkMapper2D::GetLocalSt
   return m_LSH.GetLocalStorage(renderer);
 }
 
-vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(mitk::BaseRenderer *renderer)
+vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(mitk::BaseRenderer *renderer,
+                                                                              LocalStorage::IsoLineCacheKey sliceKey)
 {
-  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();      // the points to draw
-  vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New(); // the lines to connect the points
-  vtkSmartPointer<vtkUnsignedCharArray> colors = vtkSmartPointer<vtkUnsignedCharArray>::New();
-  colors->SetNumberOfComponents(3);
-  colors->SetName("Colors");
+  LocalStorage *localStorage = this->GetLocalStorage(renderer);
 
   float pref;
   this->GetDataNode()->GetFloatProperty(mitk::RTConstants::REFERENCE_DOSE_PROPERTY_NAME.c_str(), pref);
 
+  auto addLevel = [&sliceKey, pref](const mitk::IsoDoseLevel *level) {
+    mitk::IsoDoseLevel::ColorType isoColor = level->GetColor();
+    sliceKey.Levels.push_back({level->GetDoseValue() * pref,
+                               {static_cast<unsigned char>(isoColor.GetRed() * 255),
+                                static_cast<unsigned char>(isoColor.GetGreen() * 255),
+                                static_cast<unsigned char>(isoColor.GetBlue() * 255)}});
+  };
+
   mitk::IsoDoseLevelSetProperty::Pointer propIsoSet = dynamic_cast<mitk::IsoDoseLevelSetProperty *>(
     GetDataNode()->GetProperty(mitk::RTConstants::DOSE_ISO_LEVELS_PROPERTY_NAME.c_str()));
   mitk::IsoDoseLevelSet::Pointer isoDoseLevelSet = propIsoSet->GetValue();
@@ -862,7 +888,7 @@ vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m
   {
     if (doseIT->GetVisibleIsoLine())
     {
-      this->CreateLevelOutline(renderer, &(doseIT.Value()), pref, points, lines, colors);
+      addLevel(&(doseIT.Value()));
     } // end of if visible dose value
   }   // end of loop over all does values
 
@@ -876,189 +902,50 @@ vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m
   {
     if (freeDoseIT->Value()->GetVisibleIsoLine())
     {
-      this->CreateLevelOutline(renderer, freeDoseIT->Value(), pref, points, lines, colors);
+      addLevel(freeDoseIT->Value());
     } // end of if visible dose value
   }   // end of loop over all does values
 
-  // Create a polydata to store everything in
-  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
-  // Add the points to the dataset
-  polyData->SetPoints(points);
-  // Add the lines to the dataset
-  polyData->SetLines(lines);
-  polyData->GetCellData()->SetScalars(colors);
-  return polyData;
-}
+  int *dims = localStorage->m_ReslicedImage->GetDimensions();
+  sliceKey.Dimensions = {dims[0], dims[1]};
+  sliceKey.Spacing = {localStorage->m_mmPerPixel[0], localStorage->m_mmPerPixel[1]};
+  sliceKey.Depth = CalculateLayerDepth(renderer);
+  sliceKey.Interpolate = false;
+  this->GetDataNode()->GetBoolProperty(
+    mitk::RTConstants::DOSE_ISO_LINE_INTERPOLATION_PROPERTY_NAME.c_str(), sliceKey.Interpolate, renderer);
 
-void mitk::DoseImageVtkMapper2D::CreateLevelOutline(mitk::BaseRenderer *renderer,
-                                                    const mitk::IsoDoseLevel *level,
-                                                    float pref,
-                                                    vtkSmartPointer<vtkPoints> points,
-                                                    vtkSmartPointer<vtkCellArray> lines,
-                                                    vtkSmartPointer<vtkUnsignedCharArray> colors)
-{
-  LocalStorage *localStorage = this->GetLocalStorage(renderer);
-
-  // get the min and max index values of each direction
-  int *extent = localStorage->m_ReslicedImage->GetExtent();
-  int xMin = extent[0];
-  int xMax = extent[1];
-  int yMin = extent[2];
-  int yMax = extent[3];
-
-  int *dims = localStorage->m_ReslicedImage->GetDimensions(); // dimensions of the image
-  int line = dims[0];                                         // how many pixels per line?
-  // get the depth for each contour
-  float depth = CalculateLayerDepth(renderer);
-
-  double doseValue = level->GetDoseValue() * pref;
-  mitk::IsoDoseLevel::ColorType isoColor = level->GetColor();
-  unsigned char colorLine[3] = {static_cast<unsigned char>(isoColor.GetRed() * 255),
-                                static_cast<unsigned char>(isoColor.GetGreen() * 255),
-                                static_cast<unsigned char>(isoColor.GetBlue() * 255)};
-
-  int x = xMin; // pixel index x
-  int y = yMin; // pixel index y
-  float *currentPixel;
-
-  // We take the pointer to the first pixel of the image
-  currentPixel = static_cast<float *>(localStorage->m_ReslicedImage->GetScalarPointer());
+  auto &cache = localStorage->m_IsoLineCache;
+  auto cacheIT = std::find_if(cache.begin(), cache.end(), [&sliceKey](const auto &entry) {
+    return entry.first == sliceKey;
+  });
 
-  if (!currentPixel){
-    mitkThrow() << "currentPixel invalid";
-  }
-
-  while (y <= yMax)
+  if (cacheIT != cache.end())
   {
-    // if the current pixel value is set to something
-    if ((currentPixel) && (*currentPixel >= doseValue))
-    {
-      // check in which direction a line is necessary
-      // a line is added if the neighbor of the current pixel has the value 0
-      // and if the pixel is located at the edge of the image
-
-      // if   vvvvv  not the first line vvvvv
-      if (y > yMin && *(currentPixel - line) < doseValue)
-      { // x direction - bottom edge of the pixel
-        // add the 2 points
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        // add the line between both points
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
-
-      // if   vvvvv  not the last line vvvvv
-      if (y < yMax && *(currentPixel + line) < doseValue)
-      { // x direction - top edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
-
-      // if   vvvvv  not the first pixel vvvvv
-      if ((x > xMin || y > yMin) && *(currentPixel - 1) < doseValue)
-      { // y direction - left edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
-
-      // if   vvvvv  not the last pixel vvvvv
-      if ((y < yMax || (x < xMax)) && *(currentPixel + 1) < doseValue)
-      { // y direction - right edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
-
-      /*  now consider pixels at the edge of the image  */
-
-      // if   vvvvv  left edge of image vvvvv
-      if (x == xMin)
-      { // draw left edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
+    cache.splice(cache.begin(), cache, cacheIT);
+    return cache.front().second;
+  }
 
-      // if   vvvvv  right edge of image vvvvv
-      if (x == xMax)
-      { // draw right edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
+  const float *slice = static_cast<const float *>(localStorage->m_ReslicedImage->GetScalarPointer());
 
-      // if   vvvvv  bottom edge of image vvvvv
-      if (y == yMin)
-      { // draw bottom edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
+  if (!slice)
+  {
+    mitkThrow() << "Resliced dose image has no valid scalar data.";
+  }
 
-      // if   vvvvv  top edge of image vvvvv
-      if (y == yMax)
-      { // draw top edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
-    } // end if currentpixel is set
+  auto polyData = IsoDoseLineGenerator::Generate(slice,
+                                                 dims[0],
+                                                 dims[1],
+                                                 sliceKey.Spacing.data(),
+                                                 sliceKey.Depth,
+                                                 sliceKey.Levels,
+                                                 sliceKey.Interpolate);
 
-    x++;
+  cache.emplace_front(std::move(sliceKey), polyData);
 
-    if (x > xMax)
-    { // reached end of line
-      x = xMin;
-      y++;
-    }
+  if (cache.size() > MaximumNumberOfCachedIsoLineSlices)
+    cache.pop_back();
 
-    // Increase the pointer-position to the next pixel.
-    // This is safe, as the while-loop and the x-reset logic above makes
-    // sure we do not exceed the bounds of the image
-    currentPixel++;
-  } // end of while
+  return polyData;
 }
 
 void mitk::DoseImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer)
@@ -1110,6 +997,14 @@ bool mitk::DoseImageVtkMapper2D::RenderingGeometryIntersectsImage(const PlaneGeo
   return false;
 }
 
+bool mitk::DoseImageVtkMapper2D::LocalStorage::IsoLineCacheKey::operator==(const IsoLineCacheKey &other) const
+{
+  return Plane == other.Plane && TimeStep == other.TimeStep && DoseMTime == other.DoseMTime &&
+         ResliceInterpolation == other.ResliceInterpolation && ThickSlicesMode == other.ThickSlicesMode &&
+         ThickSlicesNum == other.ThickSlicesNum && Dimensions == other.Dimensions && Spacing == other.Spacing &&
+         Depth == other.Depth && Interpolate == other.Interpolate && Levels == other.Levels;
+}
+
 mitk::DoseImageVtkMapper2D::LocalStorage::~LocalStorage()
 {
 }
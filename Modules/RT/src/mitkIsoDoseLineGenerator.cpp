@@ -0,0 +1,330 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkIsoDoseLineGenerator.h"
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkPoints.h>
+#include <vtkUnsignedCharArray.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace
+{
+  using KeyType = std::uint64_t;
+
+  /** Minimal number of rows per band that is processed by one thread. */
+  constexpr int MinimumRowsPerBand = 16;
+
+  /** Line segment between two vertices. A vertex is identified by a key that encodes its position
+   * (pixel corner for outlines, level and pixel edge for interpolated lines). */
+  struct Segment
+  {
+    KeyType First;
+    KeyType Second;
+    std::size_t Level;
+  };
+
+  /** Returns the range [first, last) of levels with min(a, b) < dose value <= max(a, b),
+   * i.e. the levels whose iso line separates two pixels with the values a and b.*/
+  std::pair<std::size_t, std::size_t> GetCrossedLevels(const std::vector<double>& doseValues, double a, double b)
+  {
+    const auto values = std::minmax(a, b);
+    const auto first = std::upper_bound(doseValues.begin(), doseValues.end(), values.first);
+    const auto last = std::upper_bound(first, doseValues.end(), values.second);
+
+    return { static_cast<std::size_t>(first - doseValues.begin()), static_cast<std::size_t>(last - doseValues.begin()) };
+  }
+
+  /** Pixel outlines of the rows [firstRow, lastRow). Pixel corner (x, y) has the key y * (width + 1) + x. */
+  void GeneratePixelOutlines(const float* slice, int width, int height, const std::vector<double>& doseValues,
+    int firstRow, int lastRow, std::vector<Segment>& segments)
+  {
+    const KeyType cornersPerRow = width + 1;
+    const double outside = std::numeric_limits<double>::lowest();
+
+    auto getValue = [=](int x, int y) -> double {
+      return x < 0 || y < 0 || x >= width || y >= height ? outside : slice[static_cast<std::size_t>(y) * width + x];
+    };
+
+    // Horizontal edges below the rows (and above the last row of the slice). Consecutive edges of
+    // the same level are merged; runStart holds the first corner of the current run of each level.
+    std::vector<int> runStart(doseValues.size(), 0);
+    const int lastCornerRow = lastRow == height ? height : lastRow - 1;
+
+    for (int y = firstRow; y <= lastCornerRow; ++y)
+    {
+      const KeyType rowKey = y * cornersPerRow;
+      std::size_t activeFirst = 0;
+      std::size_t activeLast = 0;
+
+      for (int x = 0; x <= width; ++x)
+      {
+        std::pair<std::size_t, std::size_t> crossed(0, 0);
+
+        if (x < width)
+          crossed = GetCrossedLevels(doseValues, getValue(x, y - 1), getValue(x, y));
+
+        if (crossed.first == activeFirst && crossed.second == activeLast)
+          continue;
+
+        for (auto level = activeFirst; level < activeLast; ++level)
+        {
+          if (level < crossed.first || level >= crossed.second)
+            segments.push_back({ rowKey + runStart[level], rowKey + x, level });
+        }
+
+        for (auto level = crossed.first; level < crossed.second; ++level)
+        {
+          if (level < activeFirst || level >= activeLast)
+            runStart[level] = x;
+        }
+
+        activeFirst = crossed.first;
+        activeLast = crossed.second;
+      }
+    }
+
+    // Vertical edges left and right of the pixels
+    for (int y = firstRow; y < lastRow; ++y)
+    {
+      const KeyType rowKey = y * cornersPerRow;
+
+      for (int x = 0; x <= width; ++x)
+      {
+        const auto crossed = GetCrossedLevels(doseValues, getValue(x - 1, y), getValue(x, y));
+
+        for (auto level = crossed.first; level < crossed.second; ++level)
+          segments.push_back({ rowKey + x, rowKey + cornersPerRow + x, level });
+      }
+    }
+  }
+
+  /** Edges of a marching squares cell: bottom, right, top, left. Pairs of edges connected by
+   * a segment for each case (bit 0: lower left, 1: lower right, 2: upper right, 3: upper left
+   * corner inside). Saddles (5 and 10) are handled separately. */
+  constexpr int CaseTable[16][2] = {
+    { -1, -1 }, { 3, 0 }, { 0, 1 }, { 3, 1 }, { 1, 2 }, { -1, -1 }, { 0, 2 }, { 3, 2 },
+    { 2, 3 }, { 0, 2 }, { -1, -1 }, { 1, 2 }, { 3, 1 }, { 0, 1 }, { 3, 0 }, { -1, -1 } };
+
+  /** Interpolated iso lines of the cells between the pixel centers of the rows [firstRow, lastRow).
+   * The vertex on the edge between pixel (x, y) and (x + 1, y) has the key
+   * level * edgesPerLevel + y * (width - 1) + x, the vertex between (x, y) and (x, y + 1) the key
+   * level * edgesPerLevel + height * (width - 1) + y * width + x.*/
+  void GenerateInterpolatedLines(const float* slice, int width, int height, const std::vector<double>& doseValues,
+    int firstRow, int lastRow, std::vector<Segment>& segments)
+  {
+    const KeyType horizontalEdges = static_cast<KeyType>(height) * (width - 1);
+    const KeyType edgesPerLevel = horizontalEdges + static_cast<KeyType>(height - 1) * width;
+
+    lastRow = std::min(lastRow, height - 1);
+
+    for (int y = firstRow; y < lastRow; ++y)
+    {
+      const auto lowerRow = slice + static_cast<std::size_t>(y) * width;
+      const auto upperRow = lowerRow + width;
+
+      for (int x = 0; x < width - 1; ++x)
+      {
+        const double corners[4] = { lowerRow[x], lowerRow[x + 1], upperRow[x + 1], upperRow[x] };
+        const auto range = std::minmax({ corners[0], corners[1], corners[2], corners[3] });
+        const auto crossed = GetCrossedLevels(doseValues, range.first, range.second);
+
+        for (auto level = crossed.first; level < crossed.second; ++level)
+        {
+          const double doseValue = doseValues[level];
+          const KeyType levelKey = level * edgesPerLevel;
+          const KeyType edgeKeys[4] = { levelKey + y * (width - 1) + x,
+                                        levelKey + horizontalEdges + y * width + x + 1,
+                                        levelKey + (y + 1) * (width - 1) + x,
+                                        levelKey + horizontalEdges + y * width + x };
+
+          int caseIndex = 0;
+
+          for (int corner = 0; corner < 4; ++corner)
+          {
+            if (corners[corner] >= doseValue)
+              caseIndex |= 1 << corner;
+          }
+
+          if (5 == caseIndex || 10 == caseIndex)
+          {
+            const bool centerInside = 0.25 * (corners[0] + corners[1] + corners[2] + corners[3]) >= doseValue;
+
+            if (centerInside == (5 == caseIndex))
+            {
+              segments.push_back({ edgeKeys[0], edgeKeys[1], level });
+              segments.push_back({ edgeKeys[2], edgeKeys[3], level });
+            }
+            else
+            {
+              segments.push_back({ edgeKeys[3], edgeKeys[0], level });
+              segments.push_back({ edgeKeys[1], edgeKeys[2], level });
+            }
+          }
+          else
+          {
+            segments.push_back({ edgeKeys[CaseTable[caseIndex][0]], edgeKeys[CaseTable[caseIndex][1]], level });
+          }
+        }
+      }
+    }
+  }
+}
+
+vtkSmartPointer<vtkPolyData> mitk::IsoDoseLineGenerator::Generate(const float* slice,
+                                                                  int width,
+                                                                  int height,
+                                                                  const double spacing[2],
+                                                                  double depth,
+                                                                  std::vector<Level> levels,
+                                                                  bool interpolate)
+{
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  auto lines = vtkSmartPointer<vtkCellArray>::New();
+  auto colors = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  colors->SetNumberOfComponents(3);
+  colors->SetName("Colors");
+
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  polyData->SetLines(lines);
+  polyData->GetCellData()->SetScalars(colors);
+
+  if (nullptr == slice || width <= 0 || height <= 0 || levels.empty())
+    return polyData;
+
+  std::stable_sort(levels.begin(), levels.end(), [](const Level& left, const Level& right) {
+    return left.DoseValue < right.DoseValue;
+  });
+
+  std::vector<double> doseValues;
+  doseValues.reserve(levels.size());
+
+  for (const auto& level : levels)
+    doseValues.push_back(level.DoseValue);
+
+  // Generate the segments of all levels band-wise in parallel
+
+  const auto maximumNumberOfBands = 2 * static_cast<int>(itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  const auto numberOfBands = std::max(1, std::min(maximumNumberOfBands, height / MinimumRowsPerBand));
+  std::vector<std::vector<Segment>> bandSegments(numberOfBands);
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(0, numberOfBands, [&](itk::SizeValueType band) {
+    const auto firstRow = static_cast<int>(band * height / numberOfBands);
+    const auto lastRow = static_cast<int>((band + 1) * height / numberOfBands);
+
+    if (interpolate)
+      GenerateInterpolatedLines(slice, width, height, doseValues, firstRow, lastRow, bandSegments[band]);
+    else
+      GeneratePixelOutlines(slice, width, height, doseValues, firstRow, lastRow, bandSegments[band]);
+  }, nullptr);
+
+  // Assign shared vertex ids
+
+  std::size_t numberOfSegments = 0;
+
+  for (const auto& segments : bandSegments)
+    numberOfSegments += segments.size();
+
+  std::vector<KeyType> keys;
+  keys.reserve(2 * numberOfSegments);
+
+  for (const auto& segments : bandSegments)
+  {
+    for (const auto& segment : segments)
+    {
+      keys.push_back(segment.First);
+      keys.push_back(segment.Second);
+    }
+  }
+
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  points->SetNumberOfPoints(static_cast<vtkIdType>(keys.size()));
+
+  if (interpolate)
+  {
+    const KeyType horizontalEdges = static_cast<KeyType>(height) * (width - 1);
+    const KeyType edgesPerLevel = horizontalEdges + static_cast<KeyType>(height - 1) * width;
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      const auto level = keys[i] / edgesPerLevel;
+      auto edge = keys[i] % edgesPerLevel;
+      std::size_t x, y, dx = 0, dy = 0;
+
+      if (edge < horizontalEdges)
+      {
+        y = edge / (width - 1);
+        x = edge % (width - 1);
+        dx = 1;
+      }
+      else
+      {
+        edge -= horizontalEdges;
+        y = edge / width;
+        x = edge % width;
+        dy = 1;
+      }
+
+      const double first = slice[y * width + x];
+      const double second = slice[(y + dy) * width + x + dx];
+      const double fraction = (doseValues[level] - first) / (second - first);
+
+      points->SetPoint(static_cast<vtkIdType>(i),
+                       (x + 0.5 + fraction * dx) * spacing[0],
+                       (y + 0.5 + fraction * dy) * spacing[1],
+                       depth);
+    }
+  }
+  else
+  {
+    const KeyType cornersPerRow = width + 1;
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      points->SetPoint(static_cast<vtkIdType>(i),
+                       static_cast<double>(keys[i] % cornersPerRow) * spacing[0],
+                       static_cast<double>(keys[i] / cornersPerRow) * spacing[1],
+                       depth);
+    }
+  }
+
+  auto getPointId = [&keys](KeyType key) {
+    return static_cast<vtkIdType>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+  };
+
+  lines->AllocateExact(static_cast<vtkIdType>(numberOfSegments), static_cast<vtkIdType>(2 * numberOfSegments));
+  colors->SetNumberOfTuples(static_cast<vtkIdType>(numberOfSegments));
+
+  vtkIdType cellId = 0;
+
+  for (const auto& segments : bandSegments)
+  {
+    for (const auto& segment : segments)
+    {
+      const vtkIdType pointIds[2] = { getPointId(segment.First), getPointId(segment.Second) };
+      lines->InsertNextCell(2, pointIds);
+      colors->SetTypedTuple(cellId++, levels[segment.Level].Color.data());
+    }
+  }
+
+  return polyData;
+}
@@ -23,6 +23,7 @@ const std::string mitk::RTConstants::DOSE_SUMMATION_TYPE_PROPERTY_NAME = "dose.s
 const std::string mitk::RTConstants::DOSE_FRACTION_COUNT_PROPERTY_NAME = "dose.fractionCount";
 const std::string mitk::RTConstants::DOSE_FRACTION_NUMBER_OF_BEAMS_PROPERTY_NAME = "dose.numerOfBeams";
 const std::string mitk::RTConstants::DOSE_SHOW_ISOLINES_PROPERTY_NAME = "dose.showIsoLines";
+const std::string mitk::RTConstants::DOSE_ISO_LINE_INTERPOLATION_PROPERTY_NAME = "dose.isoLineInterpolation";
 const std::string mitk::RTConstants::DOSE_SHOW_COLORWASH_PROPERTY_NAME = "dose.showColorWash";
 const std::string mitk::RTConstants::DOSE_ISO_LEVELS_PROPERTY_NAME = "dose.isoLevels";
 const std::string mitk::RTConstants::DOSE_FREE_ISO_VALUES_PROPERTY_NAME = "dose.freeIsoValues";
@@ -2,4 +2,5 @@ SET(MODULE_TESTS
   mitkRTStructureSetReaderServiceTest.cpp
   mitkRTDoseReaderServiceTest.cpp
   mitkRTPlanReaderServiceTest.cpp
+  mitkIsoDoseLineGeneratorTest.cpp
 )
@@ -0,0 +1,143 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <mitkIsoDoseLineGenerator.h>
+
+#include <vtkCellData.h>
+#include <vtkUnsignedCharArray.h>
+
+class mitkIsoDoseLineGeneratorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkIsoDoseLineGeneratorTestSuite);
+  MITK_TEST(TestBlockOutline);
+  MITK_TEST(TestMultipleLevels);
+  MITK_TEST(TestBorderOutline);
+  MITK_TEST(TestInterpolatedLines);
+  MITK_TEST(TestNoLevels);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  const double m_UnitSpacing[2] = { 1.0, 1.0 };
+
+  static mitk::IsoDoseLineGenerator::Level CreateLevel(double doseValue, unsigned char red)
+  {
+    return { doseValue, { red, 0, 0 } };
+  }
+
+  static vtkIdType CountCellsWithColor(vtkPolyData* polyData, unsigned char red)
+  {
+    auto colors = dynamic_cast<vtkUnsignedCharArray*>(polyData->GetCellData()->GetScalars());
+    CPPUNIT_ASSERT(nullptr != colors);
+
+    vtkIdType count = 0;
+
+    for (vtkIdType i = 0; i < colors->GetNumberOfTuples(); ++i)
+    {
+      if (colors->GetValue(3 * i) == red)
+        ++count;
+    }
+
+    return count;
+  }
+
+public:
+  void TestBlockOutline()
+  {
+    const float slice[16] = {
+      0, 0, 0, 0,
+      0, 10, 10, 0,
+      0, 10, 10, 0,
+      0, 0, 0, 0 };
+
+    auto polyData = mitk::IsoDoseLineGenerator::Generate(slice, 4, 4, m_UnitSpacing, 0.0, { CreateLevel(5.0, 255) });
+
+    // merged bottom and top edge plus four unit edges on the left and right, all sharing their corners
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(6), polyData->GetNumberOfLines());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(6), polyData->GetNumberOfPoints());
+
+    double bounds[6];
+    polyData->GetBounds(bounds);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, bounds[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, bounds[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, bounds[2], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, bounds[3], mitk::eps);
+  }
+
+  void TestMultipleLevels()
+  {
+    const float slice[16] = {
+      0, 0, 0, 0,
+      0, 20, 10, 0,
+      0, 10, 10, 0,
+      0, 0, 0, 0 };
+
+    // levels are not sorted on purpose
+    auto polyData = mitk::IsoDoseLineGenerator::Generate(slice, 4, 4, m_UnitSpacing, 0.0,
+      { CreateLevel(15.0, 200), CreateLevel(5.0, 100) });
+
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(10), polyData->GetNumberOfLines());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(8), polyData->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(4), CountCellsWithColor(polyData, 200));
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(6), CountCellsWithColor(polyData, 100));
+  }
+
+  void TestBorderOutline()
+  {
+    const float slice[6] = { 10, 10, 10, 10, 10, 10 };
+    const double spacing[2] = { 2.0, 0.5 };
+
+    auto polyData = mitk::IsoDoseLineGenerator::Generate(slice, 3, 2, spacing, 1.5, { CreateLevel(5.0, 255) });
+
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(6), polyData->GetNumberOfLines());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(6), polyData->GetNumberOfPoints());
+
+    double bounds[6];
+    polyData->GetBounds(bounds);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, bounds[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, bounds[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, bounds[2], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, bounds[3], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, bounds[4], mitk::eps);
+  }
+
+  void TestInterpolatedLines()
+  {
+    const float slice[4] = { 0, 10, 0, 10 };
+
+    auto polyData = mitk::IsoDoseLineGenerator::Generate(slice, 2, 2, m_UnitSpacing, 0.0, { CreateLevel(2.5, 255) }, true);
+
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(1), polyData->GetNumberOfLines());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(2), polyData->GetNumberOfPoints());
+
+    double bounds[6];
+    polyData->GetBounds(bounds);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.75, bounds[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.75, bounds[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, bounds[2], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, bounds[3], mitk::eps);
+  }
+
+  void TestNoLevels()
+  {
+    const float slice[4] = { 0, 10, 0, 10 };
+
+    auto polyData = mitk::IsoDoseLineGenerator::Generate(slice, 2, 2, m_UnitSpacing, 0.0, {});
+
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), polyData->GetNumberOfLines());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), polyData->GetNumberOfPoints());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkIsoDoseLineGenerator)
@@ -0,0 +1,114 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLazySceneDataLoader_h
+#define mitkLazySceneDataLoader_h
+
+#include <MitkSceneSerializationExports.h>
+
+#include <mitkDataNode.h>
+
+#include <itkWeakPointer.h>
+
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Reads the base data of scene nodes on first access instead of at scene load time.
+   *
+   * Used by SceneIO in lazy loading mode (see SceneIO::SetLazyLoading()). The scene reader
+   * registers each node that references a data file and the node receives a data provider
+   * (see DataNode::SetDataProvider()) that reads the file from the unpacked scene directory
+   * as soon as the data is requested by a mapper or any other accessor.
+   *
+   * The loader is kept alive by the data providers of its nodes. If it owns the working
+   * directory, the directory is deleted as soon as the last node has been destroyed.
+   *
+   * If a memory budget is set, the least recently loaded data objects are released
+   * (see DataNode::ReleaseData()) whenever the data of all loaded nodes exceeds the budget.
+   * Only data that was not modified since it was read and that is not referenced elsewhere
+   * is released, as it is read again from the scene directory on next access.
+   */
+  class MITKSCENESERIALIZATION_EXPORT LazySceneDataLoader : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(LazySceneDataLoader, itk::Object);
+    mitkNewMacro1Param(Self, const std::string &);
+
+    /**
+     * \brief Function reading the data of a node from the working directory.
+     *
+     * Returns nullptr if the data could not be read.
+     */
+    using ReadFunction = std::function<BaseData::Pointer(const std::string &workingDirectory)>;
+
+    itkGetStringMacro(WorkingDirectory);
+
+    /**
+     * \brief Delete the working directory when the loader is destroyed.
+     */
+    itkSetMacro(OwnsWorkingDirectory, bool);
+    itkGetConstMacro(OwnsWorkingDirectory, bool);
+
+    /**
+     * \brief Maximum memory in bytes occupied by the data of loaded nodes. 0 means unlimited.
+     */
+    void SetMemoryBudget(std::size_t budget);
+    itkGetConstMacro(MemoryBudget, std::size_t);
+
+    /**
+     * \brief Memory in bytes currently occupied by the data of nodes loaded by this loader.
+     */
+    std::size_t GetLoadedMemorySize() const;
+
+    /**
+     * \brief Install a data provider in node that calls read on first access of the data.
+     */
+    void RegisterNode(DataNode *node, const ReadFunction &read);
+
+    /**
+     * \brief Release loaded data until the memory budget is met.
+     */
+    void EnforceMemoryBudget();
+
+  protected:
+    explicit LazySceneDataLoader(const std::string &workingDirectory);
+    ~LazySceneDataLoader() override;
+
+  private:
+    struct LoadedData
+    {
+      itk::WeakPointer<DataNode> Node;
+      const BaseData *Data;
+      itk::ModifiedTimeType DataMTime;
+      std::size_t Size;
+    };
+
+    BaseData::Pointer Load(DataNode *node, const ReadFunction &read);
+    void EnforceMemoryBudget(std::size_t reserve);
+
+    static std::size_t EstimateMemorySize(const BaseData *data);
+
+    std::string m_WorkingDirectory;
+    bool m_OwnsWorkingDirectory;
+    std::size_t m_MemoryBudget;
+
+    /// Least recently loaded data first
+    std::list<LoadedData> m_LoadedData;
+    mutable std::mutex m_Mutex;
+  };
+}
+
+#endif
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include <MitkSceneSerializationExports.h>
 
 #include "mitkDataStorage.h"
+#include "mitkLazySceneDataLoader.h"
 #include "mitkNodePredicateBase.h"
 
 #include <Poco/Zip/ZipLocalFileHeader.h>
@@ -76,6 +77,36 @@ namespace mitk
       bool clearStorageFirst = false);
 
 
+    /**
+     * \brief Read base data on first access instead of while loading the scene.
+     *
+     * If enabled, LoadScene() and LoadSceneUnzipped() populate the DataStorage with nodes
+     * and their properties only. The base data of each node is read from the (unpacked)
+     * scene as soon as it is requested via DataNode::GetData(), e.g. for rendering.
+     * The unpacked scene is kept in a temporary directory as long as any of these nodes exists.
+     *
+     * Note that the geometry of a node is only known after its data was read, i.e.,
+     * computing the bounds of visible nodes reads their data.
+     */
+    itkSetMacro(LazyLoading, bool);
+    itkGetConstMacro(LazyLoading, bool);
+    itkBooleanMacro(LazyLoading);
+
+    /**
+     * \brief Maximum memory in bytes occupied by lazily loaded data. 0 (default) means unlimited.
+     *
+     * Unmodified data is released from the nodes when the budget is exceeded and read again
+     * on next access. Applies to scenes loaded afterwards, use GetLazyDataLoader() to change
+     * the budget of an already loaded scene.
+     */
+    itkSetMacro(LazyLoadingMemoryBudget, std::size_t);
+    itkGetConstMacro(LazyLoadingMemoryBudget, std::size_t);
+
+    /**
+     * \brief Loader of the base data of the most recently loaded scene in lazy loading mode, nullptr otherwise.
+     */
+    LazySceneDataLoader *GetLazyDataLoader() const;
+
     /**
      * \brief Save a scene of objects to file
      * \return True if complete success, false if any problem occurred. Note that a scene file might still be written if
@@ -132,6 +163,10 @@ namespace mitk
 
     std::string m_WorkingDirectory;
     unsigned int m_UnzipErrors;
+
+    bool m_LazyLoading;
+    std::size_t m_LazyLoadingMemoryBudget;
+    LazySceneDataLoader::Pointer m_LazyDataLoader;
   };
 }
 
@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <itkObjectFactory.h>
 
 #include "mitkDataStorage.h"
+#include "mitkLazySceneDataLoader.h"
 
 namespace tinyxml2
 {
@@ -34,6 +35,17 @@ namespace mitk
     itkCloneMacro(Self);
 
     virtual bool LoadScene(tinyxml2::XMLDocument &document, const std::string &workingDirectory, DataStorage *storage);
+
+    /**
+     * \brief If set, base data is not read by LoadScene() but registered with the loader to be read on first access.
+     *
+     * The loader must refer to workingDirectory of LoadScene().
+     */
+    void SetLazyDataLoader(LazySceneDataLoader *loader);
+    LazySceneDataLoader *GetLazyDataLoader() const;
+
+  protected:
+    LazySceneDataLoader::Pointer m_LazyDataLoader;
   };
 }
 
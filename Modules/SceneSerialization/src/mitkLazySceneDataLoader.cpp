@@ -0,0 +1,193 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkLazySceneDataLoader.h>
+
+#include <mitkImage.h>
+#include <mitkSurface.h>
+
+#include <vtkPolyData.h>
+
+#include <Poco/File.h>
+
+mitk::LazySceneDataLoader::LazySceneDataLoader(const std::string &workingDirectory)
+  : m_WorkingDirectory(workingDirectory),
+    m_OwnsWorkingDirectory(false),
+    m_MemoryBudget(0)
+{
+}
+
+mitk::LazySceneDataLoader::~LazySceneDataLoader()
+{
+  if (!m_OwnsWorkingDirectory || m_WorkingDirectory.empty())
+    return;
+
+  try
+  {
+    Poco::File workingDirectory(m_WorkingDirectory);
+    workingDirectory.remove(true); // recursive
+  }
+  catch (...)
+  {
+    MITK_ERROR << "Could not delete temporary directory " << m_WorkingDirectory;
+  }
+}
+
+void mitk::LazySceneDataLoader::SetMemoryBudget(std::size_t budget)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (m_MemoryBudget == budget)
+      return;
+
+    m_MemoryBudget = budget;
+  }
+
+  this->Modified();
+  this->EnforceMemoryBudget();
+}
+
+std::size_t mitk::LazySceneDataLoader::GetLoadedMemorySize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  std::size_t size = 0;
+
+  for (const auto &loadedData : m_LoadedData)
+    size += loadedData.Size;
+
+  return size;
+}
+
+void mitk::LazySceneDataLoader::RegisterNode(DataNode *node, const ReadFunction &read)
+{
+  if (nullptr == node)
+    return;
+
+  // The provider keeps the loader (and thus the working directory) alive as long as the
+  // node exists. The raw node pointer is safe since the provider is owned by the node.
+  Self::Pointer self = this;
+
+  node->SetDataProvider([self, node, read]() { return self->Load(node, read); });
+}
+
+mitk::BaseData::Pointer mitk::LazySceneDataLoader::Load(DataNode *node, const ReadFunction &read)
+{
+  BaseData::Pointer data;
+
+  try
+  {
+    data = read(m_WorkingDirectory);
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Error while reading data of node \"" << node->GetName() << "\": " << e.what();
+  }
+
+  if (data.IsNull())
+    return nullptr;
+
+  const auto size = EstimateMemorySize(data);
+
+  // Make room before the new data is accounted for. The new node is not part of the list
+  // yet, so it cannot be released by itself.
+  this->EnforceMemoryBudget(size);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_LoadedData.push_back({node, data.GetPointer(), data->GetMTime(), size});
+
+  return data;
+}
+
+void mitk::LazySceneDataLoader::EnforceMemoryBudget()
+{
+  this->EnforceMemoryBudget(0);
+}
+
+void mitk::LazySceneDataLoader::EnforceMemoryBudget(std::size_t reserve)
+{
+  std::vector<DataNode::Pointer> nodesToRelease;
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (0 == m_MemoryBudget)
+      return;
+
+    std::size_t loadedSize = reserve;
+
+    for (auto iter = m_LoadedData.begin(); iter != m_LoadedData.end();)
+    {
+      DataNode::Pointer node = iter->Node.GetPointer();
+
+      // Forget data that was replaced or released in the meantime
+      // (must not trigger the data provider, as loading enforces the budget as well)
+      if (node.IsNull() || node->GetLoadedData().GetPointer() != iter->Data)
+      {
+        iter = m_LoadedData.erase(iter);
+        continue;
+      }
+
+      loadedSize += iter->Size;
+      ++iter;
+    }
+
+    for (auto iter = m_LoadedData.begin(); iter != m_LoadedData.end() && loadedSize > m_MemoryBudget;)
+    {
+      // Modified data or data referenced by anyone else than its node must stay in memory
+      if (iter->Data->GetMTime() != iter->DataMTime || iter->Data->GetReferenceCount() > 1)
+      {
+        ++iter;
+        continue;
+      }
+
+      nodesToRelease.push_back(iter->Node.GetPointer());
+      loadedSize -= iter->Size;
+      iter = m_LoadedData.erase(iter);
+    }
+  }
+
+  // Releasing data invokes events, so do not hold the lock
+  for (const auto &node : nodesToRelease)
+    node->ReleaseData();
+}
+
+std::size_t mitk::LazySceneDataLoader::EstimateMemorySize(const BaseData *data)
+{
+  if (const auto *image = dynamic_cast<const Image *>(data))
+  {
+    if (!image->IsInitialized())
+      return 0;
+
+    std::size_t size = image->GetPixelType().GetSize();
+
+    for (unsigned int i = 0; i < image->GetDimension(); ++i)
+      size *= image->GetDimension(i);
+
+    return size;
+  }
+
+  if (const auto *surface = dynamic_cast<const Surface *>(data))
+  {
+    std::size_t size = 0;
+
+    for (unsigned int t = 0; t < surface->GetSizeOfPolyDataSeries(); ++t)
+    {
+      if (auto *polyData = surface->GetVtkPolyData(t))
+        size += static_cast<std::size_t>(polyData->GetActualMemorySize()) * 1024; // KiB
+    }
+
+    return size;
+  }
+
+  return 0;
+}
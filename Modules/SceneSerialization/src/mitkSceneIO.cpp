@@ -39,7 +39,11 @@ found in the LICENSE file.
 
 #include <tinyxml2.h>
 
-mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0)
+mitk::SceneIO::SceneIO()
+  : m_WorkingDirectory(""),
+    m_UnzipErrors(0),
+    m_LazyLoading(false),
+    m_LazyLoadingMemoryBudget(0)
 {
 }
 
@@ -47,6 +51,11 @@ mitk::SceneIO::~SceneIO()
 {
 }
 
+mitk::LazySceneDataLoader *mitk::SceneIO::GetLazyDataLoader() const
+{
+  return m_LazyDataLoader;
+}
+
 std::string mitk::SceneIO::CreateEmptyTempDirectory()
 {
   mitk::UIDGenerator uidGen;
@@ -143,6 +152,13 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
   auto indexFile = m_WorkingDirectory + mitk::IOUtil::GetDirectorySeparator() + "index.xml";
   storage = LoadSceneUnzipped(indexFile, storage, clearStorageFirst);
 
+  if (m_LazyDataLoader.IsNotNull())
+  {
+    // the temp directory is deleted by the loader as soon as the data of the last node cannot be read anymore
+    m_LazyDataLoader->SetOwnsWorkingDirectory(true);
+    return storage;
+  }
+
   // delete temp directory
   try
   {
@@ -164,6 +180,8 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
 {
   mitk::LocaleSwitch localeSwitch("C");
 
+  m_LazyDataLoader = nullptr;
+
   // prepare data storage
   DataStorage::Pointer storage = pStorage;
   if (storage.IsNull())
@@ -206,6 +224,14 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
   }
 
   SceneReader::Pointer reader = SceneReader::New();
+
+  if (m_LazyLoading)
+  {
+    m_LazyDataLoader = LazySceneDataLoader::New(workingDir);
+    m_LazyDataLoader->SetMemoryBudget(m_LazyLoadingMemoryBudget);
+    reader->SetLazyDataLoader(m_LazyDataLoader);
+  }
+
   if (!reader->LoadScene(document, workingDir, storage))
   {
     MITK_ERROR << "There were errors while loading scene file " << indexfilename << ". Your data may be corrupted";
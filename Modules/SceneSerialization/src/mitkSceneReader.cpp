@@ -13,6 +13,16 @@ found in the LICENSE file.
 #include "mitkSceneReader.h"
 #include <tinyxml2.h>
 
+void mitk::SceneReader::SetLazyDataLoader(LazySceneDataLoader *loader)
+{
+  m_LazyDataLoader = loader;
+}
+
+mitk::LazySceneDataLoader *mitk::SceneReader::GetLazyDataLoader() const
+{
+  return m_LazyDataLoader;
+}
+
 bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::string &workingDirectory, DataStorage *storage)
 {
   // find version node --> note version in some variable
@@ -46,6 +56,8 @@ bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::st
   {
     if (auto *reader = dynamic_cast<SceneReader *>(iter->GetPointer()))
     {
+      reader->SetLazyDataLoader(m_LazyDataLoader);
+
       if (!reader->LoadScene(document, workingDirectory, storage))
       {
         MITK_ERROR << "There were errors while loading scene file "
@@ -167,7 +167,8 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
     if (dataNode.IsNull())
       continue;
 
-    auto* baseData = dataNode->GetData();
+    // Lazily loaded data gets its properties when it is read
+    auto* baseData = dataNode->IsDataLoaded() ? dataNode->GetData() : nullptr;
 
     if (baseData != nullptr && properties != nullptr)
     {
@@ -330,6 +331,38 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyx
   if (dataElement)
   {
     const char *filename = dataElement->Attribute("file");
+    const char* dataUID = dataElement->Attribute("UID");
+
+    if (filename && strlen(filename) != 0 && m_LazyDataLoader.IsNotNull())
+    {
+      node = DataNode::New();
+
+      const std::string file = filename;
+      const std::string uid = dataUID != nullptr ? dataUID : "";
+      PropertyList::ConstPointer dataProperties = properties;
+
+      m_LazyDataLoader->RegisterNode(node, [file, uid, dataProperties](const std::string &directory) {
+        auto propertiesCopy = dataProperties.IsNotNull() ? dataProperties->Clone() : PropertyList::Pointer();
+        auto baseData = IOUtil::Load(directory + Poco::Path::separator() + file, propertiesCopy);
+
+        if (propertiesCopy.IsNotNull())
+        {
+          baseData->SetPropertyList(propertiesCopy);
+          ApplyProportionalTimeGeometryProperties(baseData);
+        }
+
+        if (!uid.empty())
+        {
+          UIDManipulator manip(baseData);
+          manip.SetUID(uid);
+        }
+
+        return baseData;
+      });
+
+      return node;
+    }
+
     if (filename && strlen(filename) != 0)
     {
       try
@@ -357,7 +390,6 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyx
       error = true;
     }
 
-    const char* dataUID = dataElement->Attribute("UID");
     if (!error && dataUID != nullptr)
     {
       UIDManipulator manip(node->GetData());
@@ -377,7 +409,8 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyx
 void mitk::SceneReaderV1::ClearNodePropertyListWithExceptions(DataNode &node, PropertyList &propertyList)
 {
   // Basically call propertyList.Clear(), but implement exceptions (see bug 19354)
-  BaseData *data = node.GetData();
+  // Do not trigger reading lazily loaded data. Missing default properties are added when it is read.
+  BaseData *data = node.IsDataLoaded() ? node.GetData() : nullptr;
 
   PropertyList::Pointer propertiesToKeep = PropertyList::New();
 
@@ -78,6 +78,7 @@ class mitkSceneIOTest2Suite : public mitk::TestFixture
   CPPUNIT_TEST_SUITE(mitkSceneIOTest2Suite);
   MITK_TEST(Test_SceneIOInterfaces);
   MITK_TEST(Test_ReconstructionOfScenes);
+  MITK_TEST(Test_LazyReconstructionOfScenes);
   CPPUNIT_TEST_SUITE_END();
 
   mitk::SceneIOTestScenarioProvider m_TestCaseProvider;
@@ -125,6 +126,59 @@ public:
     }
   }
 
+  void Test_LazyReconstructionOfScenes()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+
+    mitk::SceneIOTestScenarioProvider::ScenarioList scenarios = m_TestCaseProvider.GetAllScenarios();
+    for (const auto& scenario : scenarios)
+    {
+      if (!scenario.serializable)
+        continue;
+
+      MITK_TEST_OUTPUT(<< "\n===== Test_LazyReconstructionOfScenes, scenario '" << scenario.key << "' =====");
+
+      std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+      mitk::SceneIO::Pointer writer = mitk::SceneIO::New();
+      mitk::DataStorage::Pointer originalStorage = scenario.BuildDataStorage();
+      CPPUNIT_ASSERT(writer->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+
+      mitk::SceneIO::Pointer reader = mitk::SceneIO::New();
+      reader->LazyLoadingOn();
+      mitk::DataStorage::Pointer restoredStorage;
+      CPPUNIT_ASSERT_NO_THROW(restoredStorage = reader->LoadScene(archiveFilename));
+      CPPUNIT_ASSERT(reader->GetLazyDataLoader() != nullptr);
+
+      auto restoredNodes = restoredStorage->GetAll();
+      for (const auto& node : *restoredNodes)
+      {
+        CPPUNIT_ASSERT_MESSAGE(std::string("Data of node '") + node->GetName() + "' must not be read before access",
+                               !node->HasDataProvider() || !node->IsDataLoaded());
+      }
+
+      CPPUNIT_ASSERT_MESSAGE(
+        std::string("Comparing lazily restored test scenario '") + scenario.key + "'",
+        mitk::DataStorageCompare(originalStorage,
+                                 restoredStorage,
+                                 mitk::DataStorageCompare::CMP_Hierarchy | mitk::DataStorageCompare::CMP_Data |
+                                   mitk::DataStorageCompare::CMP_Properties |
+                                   mitk::DataStorageCompare::CMP_Mappers,
+                                 scenario.comparisonPrecision)
+          .CompareVerbose());
+
+      // Released data must be read again on next access
+      for (const auto& node : *restoredNodes)
+      {
+        if (!node->HasDataProvider())
+          continue;
+
+        node->ReleaseData();
+        CPPUNIT_ASSERT(!node->IsDataLoaded());
+        CPPUNIT_ASSERT(node->GetData() != nullptr);
+      }
+    }
+  }
+
 }; // class
 
 int mitkSceneIOTest2(int /*argc*/, char * /*argv*/ [])
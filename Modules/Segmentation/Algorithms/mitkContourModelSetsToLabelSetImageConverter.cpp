@@ -0,0 +1,347 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkContourModelSetsToLabelSetImageConverter.h"
+
+#include <mitkContourModelUtils.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImageHelper.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+  using LabelValueType = mitk::LabelSetImage::LabelValueType;
+
+  /** Maximum extent (in voxels) of a contour perpendicular to the slice it is assigned to.*/
+  constexpr double SliceTolerance = 0.5;
+
+  /** Run of voxels starting at Offset (linear index) with the given length and stride.*/
+  struct Run
+  {
+    std::size_t Offset;
+    std::size_t Length;
+    std::size_t Stride;
+  };
+
+  struct Slice
+  {
+    unsigned int Axis;
+    int Index;
+
+    bool operator<(const Slice& other) const
+    {
+      return Axis != other.Axis ? Axis < other.Axis : Index < other.Index;
+    }
+  };
+
+  std::string GetName(const mitk::ContourModelSet* contourModelSet)
+  {
+    auto property = contourModelSet->GetConstProperty("name");
+    return property.IsNotNull() ? property->GetValueAsString() : std::string();
+  }
+
+  /** Rasterizes all contours of the contour set into runs of the volume with the given dimensions.*/
+  std::vector<Run> RasterizeContourModelSet(const mitk::ContourModelSet* contourModelSet,
+    const mitk::BaseGeometry* geometry,
+    const std::array<std::size_t, 3>& dimensions,
+    std::size_t& numberOfSkippedContours)
+  {
+    std::map<Slice, std::vector<std::vector<mitk::Point2D>>> polygonsBySlice;
+    numberOfSkippedContours = 0;
+
+    const auto numberOfContours = contourModelSet->GetSize();
+
+    for (int i = 0; i < numberOfContours; ++i)
+    {
+      const auto contour = contourModelSet->GetContourModelAt(i);
+
+      if (nullptr == contour || contour->GetNumberOfVertices(0) < 3)
+      {
+        ++numberOfSkippedContours;
+        continue;
+      }
+
+      std::vector<mitk::Point3D> indices;
+      indices.reserve(contour->GetNumberOfVertices(0));
+
+      mitk::Point3D minIndex, maxIndex;
+      minIndex.Fill(std::numeric_limits<double>::max());
+      maxIndex.Fill(std::numeric_limits<double>::lowest());
+
+      for (auto iter = contour->Begin(0); iter != contour->End(0); ++iter)
+      {
+        mitk::Point3D index;
+        geometry->WorldToIndex((*iter)->Coordinates, index);
+        indices.push_back(index);
+
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+          minIndex[d] = std::min(minIndex[d], index[d]);
+          maxIndex[d] = std::max(maxIndex[d], index[d]);
+        }
+      }
+
+      unsigned int axis = 0;
+
+      for (unsigned int d = 1; d < 3; ++d)
+      {
+        if (maxIndex[d] - minIndex[d] < maxIndex[axis] - minIndex[axis])
+          axis = d;
+      }
+
+      const auto sliceIndex = static_cast<int>(std::round(0.5 * (minIndex[axis] + maxIndex[axis])));
+
+      if (maxIndex[axis] - minIndex[axis] > SliceTolerance || sliceIndex < 0 || sliceIndex >= static_cast<int>(dimensions[axis]))
+      {
+        ++numberOfSkippedContours;
+        continue;
+      }
+
+      const auto uAxis = axis == 0 ? 1 : 0;
+      const auto vAxis = axis == 2 ? 1 : 2;
+
+      std::vector<mitk::Point2D> polygon;
+      polygon.reserve(indices.size());
+
+      for (const auto& index : indices)
+      {
+        mitk::Point2D point;
+        point[0] = index[uAxis];
+        point[1] = index[vAxis];
+        polygon.push_back(point);
+      }
+
+      polygonsBySlice[{axis, sliceIndex}].push_back(std::move(polygon));
+    }
+
+    const std::array<std::size_t, 3> strides = { 1, dimensions[0], dimensions[0] * dimensions[1] };
+    std::vector<Run> runs;
+
+    for (const auto& [slice, polygons] : polygonsBySlice)
+    {
+      const auto uAxis = slice.Axis == 0 ? 1 : 0;
+      const auto vAxis = slice.Axis == 2 ? 1 : 2;
+
+      // All contours of the slice are rasterized together, so that nested contours become holes
+      const auto spans = mitk::ContourModelUtils::RasterizePolygons(polygons,
+        static_cast<int>(dimensions[uAxis]), static_cast<int>(dimensions[vAxis]));
+
+      for (const auto& span : spans)
+      {
+        runs.push_back({ slice.Index * strides[slice.Axis] + span.Begin * strides[uAxis] + span.Row * strides[vAxis],
+          static_cast<std::size_t>(span.End - span.Begin + 1),
+          strides[uAxis] });
+      }
+    }
+
+    return runs;
+  }
+
+  void WriteRuns(LabelValueType* buffer, const std::vector<Run>& runs, LabelValueType value)
+  {
+    for (const auto& run : runs)
+    {
+      auto voxel = buffer + run.Offset;
+
+      for (std::size_t i = 0; i < run.Length; ++i, voxel += run.Stride)
+        *voxel = value;
+    }
+  }
+}
+
+mitk::ContourModelSetsToLabelSetImageConverter::ContourModelSetsToLabelSetImageConverter()
+  : m_TimeStep(0),
+    m_SeparateGroups(true),
+    m_MaximumNumberOfThreads(0)
+{
+}
+
+mitk::ContourModelSetsToLabelSetImageConverter::~ContourModelSetsToLabelSetImageConverter()
+{
+}
+
+void mitk::ContourModelSetsToLabelSetImageConverter::SetContourModelSets(const ContourModelSetVectorType& contourModelSets)
+{
+  m_ContourModelSets = contourModelSets;
+  this->Modified();
+}
+
+const mitk::ContourModelSetsToLabelSetImageConverter::ContourModelSetVectorType& mitk::ContourModelSetsToLabelSetImageConverter::GetContourModelSets() const
+{
+  return m_ContourModelSets;
+}
+
+const std::vector<mitk::ContourModelSetsToLabelSetImageConverter::ROIStatistics>& mitk::ContourModelSetsToLabelSetImageConverter::GetROIStatistics() const
+{
+  return m_ROIStatistics;
+}
+
+mitk::LabelSetImage::Pointer mitk::ContourModelSetsToLabelSetImageConverter::Convert()
+{
+  if (m_ReferenceImage.IsNull() || !m_ReferenceImage->IsInitialized())
+    mitkThrow() << "Cannot convert contour sets. Reference image is not set or not initialized.";
+
+  auto result = LabelSetImage::New();
+  result->Initialize(m_ReferenceImage);
+
+  if (m_TimeStep >= result->GetTimeSteps())
+    mitkThrow() << "Cannot convert contour sets. Time step " << m_TimeStep << " is invalid for the reference image.";
+
+  const auto numberOfSets = m_ContourModelSets.size();
+  const BaseGeometry* geometry = result->GetGeometry(m_TimeStep);
+  const std::array<std::size_t, 3> dimensions = { result->GetDimension(0), result->GetDimension(1), result->GetDimension(2) };
+
+  m_ROIStatistics.assign(numberOfSets, ROIStatistics());
+
+  // Labels and groups are created up front (not thread-safe), rasterization is done concurrently afterwards.
+  std::vector<LabelSetImage::GroupIndexType> groupIDs;
+  std::vector<LabelValueType> labelValues;
+
+  for (std::size_t i = 0; i < numberOfSets; ++i)
+  {
+    const auto& contourModelSet = m_ContourModelSets[i];
+
+    if (contourModelSet.IsNull())
+      mitkThrow() << "Cannot convert contour sets. Contour set " << i << " is invalid.";
+
+    const auto labelValue = static_cast<LabelValueType>(i + 1);
+    const auto groupID = m_SeparateGroups && i > 0 ? result->AddLayer() : 0;
+
+    auto label = LabelSetImageHelper::CreateNewLabel(result);
+    label->SetValue(labelValue);
+
+    const auto name = GetName(contourModelSet);
+
+    if (!name.empty())
+      label->SetName(name);
+
+    if (auto colorProperty = dynamic_cast<const ColorProperty*>(contourModelSet->GetConstProperty("color").GetPointer()); nullptr != colorProperty)
+      label->SetColor(colorProperty->GetColor());
+
+    result->AddLabel(label, groupID, false, false);
+
+    labelValues.push_back(labelValue);
+
+    if (m_SeparateGroups || 0 == i)
+      groupIDs.push_back(groupID);
+
+    m_ROIStatistics[i].Name = label->GetName();
+    m_ROIStatistics[i].LabelValue = labelValue;
+    m_ROIStatistics[i].NumberOfContours = static_cast<std::size_t>(contourModelSet->GetSize());
+  }
+
+  // Group images are retrieved after all groups exist, because the image of the active group changes with AddLayer().
+  std::vector<Image*> groupImages;
+  std::vector<std::unique_ptr<ImageWriteAccessor>> accessors;
+
+  for (auto groupID : groupIDs)
+    groupImages.push_back(result->GetGroupImage(groupID));
+
+  for (auto groupImage : groupImages)
+    accessors.push_back(std::make_unique<ImageWriteAccessor>(groupImage, groupImage->GetVolumeData(m_TimeStep)));
+
+  std::vector<std::vector<Run>> runs(numberOfSets);
+
+  auto processSet = [&](std::size_t i) {
+    const auto start = std::chrono::steady_clock::now();
+
+    runs[i] = RasterizeContourModelSet(m_ContourModelSets[i], geometry, dimensions, m_ROIStatistics[i].NumberOfSkippedContours);
+
+    if (m_SeparateGroups)
+    {
+      WriteRuns(static_cast<LabelValueType*>(accessors[i]->GetData()), runs[i], labelValues[i]);
+      runs[i].clear();
+    }
+
+    m_ROIStatistics[i].Duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  const auto maximumNumberOfThreads = 0 != m_MaximumNumberOfThreads
+    ? m_MaximumNumberOfThreads
+    : std::max(1u, std::thread::hardware_concurrency());
+  const auto numberOfThreads = std::min<std::size_t>(maximumNumberOfThreads, numberOfSets);
+
+  if (numberOfThreads < 2)
+  {
+    for (std::size_t i = 0; i < numberOfSets; ++i)
+      processSet(i);
+  }
+  else
+  {
+    // ROIs differ a lot in size, thus every thread picks the next unprocessed ROI.
+    std::atomic<std::size_t> nextSet(0);
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    std::vector<std::thread> threads;
+    threads.reserve(numberOfThreads);
+
+    for (std::size_t threadIndex = 0; threadIndex < numberOfThreads; ++threadIndex)
+    {
+      threads.emplace_back([&]() {
+        try
+        {
+          for (auto i = nextSet++; i < numberOfSets; i = nextSet++)
+            processSet(i);
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(exceptionMutex);
+          if (nullptr == exception)
+            exception = std::current_exception();
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    if (nullptr != exception)
+      std::rethrow_exception(exception);
+  }
+
+  if (!m_SeparateGroups && !accessors.empty())
+  {
+    auto buffer = static_cast<LabelValueType*>(accessors.front()->GetData());
+
+    for (std::size_t i = 0; i < numberOfSets; ++i)
+      WriteRuns(buffer, runs[i], labelValues[i]);
+  }
+
+  accessors.clear();
+
+  for (auto groupImage : groupImages)
+    groupImage->Modified();
+
+  for (const auto& statistics : m_ROIStatistics)
+  {
+    MITK_INFO << "Rasterized ROI \"" << statistics.Name << "\" [" << statistics.LabelValue << "] with "
+              << statistics.NumberOfContours << " contour(s) in " << statistics.Duration << " ms";
+
+    if (0 != statistics.NumberOfSkippedContours)
+      MITK_WARN << "Skipped " << statistics.NumberOfSkippedContours << " contour(s) of ROI \"" << statistics.Name
+                << "\" that are degenerated or do not lie in a slice of the reference image.";
+  }
+
+  return result;
+}
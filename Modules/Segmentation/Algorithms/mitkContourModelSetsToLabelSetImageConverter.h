@@ -0,0 +1,104 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkContourModelSetsToLabelSetImageConverter_h
+#define mitkContourModelSetsToLabelSetImageConverter_h
+
+#include <mitkContourModelSet.h>
+#include <mitkLabelSetImage.h>
+
+#include <MitkSegmentationExports.h>
+
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Converts a collection of contour model sets, e.g. the ROIs of an RT structure set as read by the
+   * RTStructureSetReaderService, into a single LabelSetImage.
+   *
+   * Every contour model set becomes a label (value 1, 2, ... in input order) whose name and color are taken from
+   * the "name" and "color" properties of the set. In contrast to ContourModelSetToImageFilter, contours are not
+   * extracted, filled and written back slice by slice. Instead, all contours of a set are transformed into index
+   * coordinates of the reference image, grouped by the image slice they lie in, and rasterized directly into the
+   * label buffer by ContourModelUtils::RasterizePolygons(). Contour sets are processed in parallel.
+   *
+   * Contours of one set that lie in the same slice are combined with the even-odd rule, so that inner contours
+   * describe holes (as in DICOM RT structure sets). Contours have to lie in an image slice, i.e. planes spanned
+   * by two of the image axes; other contours and contours with fewer than three vertices are skipped.
+   * The vertices of time step 0 of every contour are used.
+   *
+   * The time needed for every contour set is logged and can be retrieved by GetROIStatistics().
+   */
+  class MITKSEGMENTATION_EXPORT ContourModelSetsToLabelSetImageConverter : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(ContourModelSetsToLabelSetImageConverter, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    using ContourModelSetVectorType = std::vector<ContourModelSet::ConstPointer>;
+
+    /** \brief Information about the conversion of one contour set (ROI). */
+    struct ROIStatistics
+    {
+      std::string Name;
+      LabelSetImage::LabelValueType LabelValue;
+      std::size_t NumberOfContours;
+      std::size_t NumberOfSkippedContours;
+      /** Time for rasterizing (and in case of separate groups also writing) the ROI in milliseconds. */
+      double Duration;
+    };
+
+    /** \brief The geometry of the reference image (at time step TimeStep) defines the output. */
+    itkSetConstObjectMacro(ReferenceImage, Image);
+    itkGetConstObjectMacro(ReferenceImage, Image);
+
+    void SetContourModelSets(const ContourModelSetVectorType& contourModelSets);
+    const ContourModelSetVectorType& GetContourModelSets() const;
+
+    /** \brief Time step of the output that is filled. Default is 0. */
+    itkSetMacro(TimeStep, TimeStepType);
+    itkGetConstMacro(TimeStep, TimeStepType);
+
+    /** \brief If true (default), every contour set gets its own group, so that overlapping ROIs are
+     * preserved. Otherwise all labels are in one group and later contour sets overwrite earlier ones. */
+    itkSetMacro(SeparateGroups, bool);
+    itkGetConstMacro(SeparateGroups, bool);
+    itkBooleanMacro(SeparateGroups);
+
+    /** \brief Maximum number of contour sets that are rasterized concurrently. 0 (default) uses the
+     * number of hardware threads. */
+    itkSetMacro(MaximumNumberOfThreads, unsigned int);
+    itkGetConstMacro(MaximumNumberOfThreads, unsigned int);
+
+    /** \brief Converts the contour sets.
+     * \throws mitk::Exception if the reference image is missing or the time step is invalid.*/
+    LabelSetImage::Pointer Convert();
+
+    /** \brief Statistics of the last call of Convert(), in the order of the contour sets. */
+    const std::vector<ROIStatistics>& GetROIStatistics() const;
+
+  protected:
+    ContourModelSetsToLabelSetImageConverter();
+    ~ContourModelSetsToLabelSetImageConverter() override;
+
+  private:
+    Image::ConstPointer m_ReferenceImage;
+    ContourModelSetVectorType m_ContourModelSets;
+    TimeStepType m_TimeStep;
+    bool m_SeparateGroups;
+    unsigned int m_MaximumNumberOfThreads;
+    std::vector<ROIStatistics> m_ROIStatistics;
+  };
+}
+
+#endif
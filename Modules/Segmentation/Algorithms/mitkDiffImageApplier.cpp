@@ -316,8 +316,12 @@ void mitk::DiffImageApplier::ItkImageProcessing2DDiff(itk::Image<TPixel1, VImage
     {
       while (!outputIterator.IsAtEndOfLine())
       {
-        TPixel2 newValue = outputIterator.Get() + (TPixel2)((double)diffIterator.Get() * m_Factor);
-        outputIterator.Set(newValue);
+        // diff images are mostly empty, only write changed pixels
+        if (diffIterator.Get() != 0)
+        {
+          TPixel2 newValue = outputIterator.Get() + (TPixel2)((double)diffIterator.Get() * m_Factor);
+          outputIterator.Set(newValue);
+        }
         ++outputIterator;
         ++diffIterator;
       }
@@ -345,8 +349,11 @@ void mitk::DiffImageApplier::ItkImageProcessing3DDiff(itk::Image<TPixel1, VImage
   diffIterator.GoToBegin();
   while (!outputIterator.IsAtEnd())
   {
-    TPixel2 newValue = outputIterator.Get() + (TPixel2)((double)diffIterator.Get() * m_Factor);
-    outputIterator.Set(newValue);
+    if (diffIterator.Get() != 0)
+    {
+      TPixel2 newValue = outputIterator.Get() + (TPixel2)((double)diffIterator.Get() * m_Factor);
+      outputIterator.Set(newValue);
+    }
     ++outputIterator;
     ++diffIterator;
   }
@@ -24,6 +24,8 @@ mitk::DiffSliceOperation::DiffSliceOperation() : Operation(1)
   m_SliceGeometry = nullptr;
   m_ImageIsValid = false;
   m_DeleteObserverTag = 0;
+  m_Revert = false;
+  m_SliceExtent.fill(0);
 }
 
 mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
@@ -31,9 +33,11 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
                                              const SlicedGeometry3D *sliceGeometry,
                                              TimeStepType timestep,
                                              const BaseGeometry *currentWorldGeometry)
-  : Operation(1)
+  : Operation(1), m_Revert(false)
 
 {
+  m_SliceExtent.fill(0);
+
   m_WorldGeometry = currentWorldGeometry->Clone();
 
   /*
@@ -49,6 +53,29 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
 
   m_CompressedImageContainer.CompressImage(slice);
 
+  this->ObserveImage(imageVolume);
+}
+
+mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
+                                             std::shared_ptr<const SparseSliceDiff> diff,
+                                             bool revert,
+                                             const std::array<int, 6> &sliceExtent,
+                                             TimeStepType timestep,
+                                             const BaseGeometry *currentWorldGeometry)
+  : Operation(1), m_SparseDiff(diff), m_Revert(revert), m_SliceExtent(sliceExtent)
+{
+  m_WorldGeometry = currentWorldGeometry->Clone();
+
+  // see constructor above (bug 12338)
+  m_GuardReferenceGeometry = dynamic_cast<const PlaneGeometry *>(m_WorldGeometry.GetPointer())->GetReferenceGeometry();
+
+  m_TimeStep = timestep;
+
+  this->ObserveImage(imageVolume);
+}
+
+void mitk::DiffSliceOperation::ObserveImage(Image *imageVolume)
+{
   m_Image = imageVolume;
   m_DeleteObserverTag = 0;
 
@@ -81,9 +108,20 @@ mitk::DiffSliceOperation::~DiffSliceOperation()
 
 mitk::Image::Pointer mitk::DiffSliceOperation::GetSlice()
 {
+  if (this->IsSparse())
+    return nullptr;
+
   return m_CompressedImageContainer.DecompressImage();
 }
 
+std::size_t mitk::DiffSliceOperation::GetMemorySize() const
+{
+  if (this->IsSparse())
+    return m_Revert ? 0 : m_SparseDiff->GetMemorySize();
+
+  return m_CompressedImageContainer.GetCompressedSize();
+}
+
 bool mitk::DiffSliceOperation::IsValid()
 {
   return m_ImageIsValid && m_WorldGeometry.IsNotNull(); // TODO improve
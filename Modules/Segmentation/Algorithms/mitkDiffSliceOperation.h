@@ -14,11 +14,15 @@ found in the LICENSE file.
 #define mitkDiffSliceOperation_h
 
 #include "mitkCompressedImageContainer.h"
+#include "mitkSparseSliceDiff.h"
 #include <MitkSegmentationExports.h>
 #include <mitkOperation.h>
 
 #include <vtkSmartPointer.h>
 
+#include <array>
+#include <memory>
+
 namespace mitk
 {
   class Image;
@@ -34,6 +38,10 @@ namespace mitk
      currentWorldGeometry   specifies the axis where the slice has to be applied in the volume.
 
     This Operation can be used to realize undo-redo functionality for e.g. segmentation purposes.
+
+    The slice is either stored completely (compressed) or as a SparseSliceDiff. In the latter case only the
+    changed pixels are stored and only those are written when the operation is executed. The do and the undo
+    operation of one edit share the same SparseSliceDiff and differ in the direction it is written.
   */
   class MITKSEGMENTATION_EXPORT DiffSliceOperation : public Operation
   {
@@ -57,6 +65,22 @@ namespace mitk
                        const TimeStepType timestep,
                        const BaseGeometry *currentWorldGeometry);
 
+    /** \brief Creates an operation that writes a sparse slice difference into the volume.
+      \param imageVolume the volume the difference was computed for.
+      \param diff the difference between the slice before and after the edit.
+      \param revert if true, the old values of the difference are written (undo), otherwise the new values (redo).
+      \param sliceExtent the vtk extent of the slice as used by the reslicer when the slice was written
+      (see ExtractSliceFilter). Needed to address the changed pixels.
+      \param timestep the timestep in an 4D image.
+      \param currentWorldGeometry specifies the axis where the slice has to be applied in the volume.
+    */
+    DiffSliceOperation(mitk::Image *imageVolume,
+                       std::shared_ptr<const SparseSliceDiff> diff,
+                       bool revert,
+                       const std::array<int, 6> &sliceExtent,
+                       const TimeStepType timestep,
+                       const BaseGeometry *currentWorldGeometry);
+
     /** \brief Check if it is a valid operation.*/
     bool IsValid();
 
@@ -64,9 +88,23 @@ namespace mitk
     mitk::Image *GetImage() { return this->m_Image; }
     const mitk::Image* GetImage() const { return this->m_Image; }
 
-    /** \brief Get the slice that is applied in the operation.*/
+    /** \brief Get the slice that is applied in the operation.
+      Returns nullptr if the operation stores a sparse difference (see IsSparse()).*/
     Image::Pointer GetSlice();
 
+    /** \brief Indicates if the operation stores a sparse difference instead of the complete slice.*/
+    bool IsSparse() const { return nullptr != m_SparseDiff; }
+    /** \brief Get the sparse difference that is applied in the operation.*/
+    const SparseSliceDiff *GetSparseDiff() const { return m_SparseDiff.get(); }
+    /** \brief Indicates if the old values of the sparse difference are written.*/
+    bool IsRevert() const { return m_Revert; }
+    /** \brief Get the vtk extent of the slice the sparse difference refers to.*/
+    const std::array<int, 6> &GetSliceExtent() const { return m_SliceExtent; }
+
+    /** \brief Returns the memory in bytes occupied by the stored slice data.
+      For a sparse difference shared by a do and an undo operation, only the redo operation accounts for it.*/
+    std::size_t GetMemorySize() const override;
+
     /** \brief Set timeStep*/
     TimeStepType GetTimeStep() const { return this->m_TimeStep; }
     /** \brief Get the axis where the slice has to be applied in the volume.*/
@@ -79,8 +117,17 @@ namespace mitk
     /** \brief Callback for image observer.*/
     void OnImageDeleted();
 
+    /** \brief Sets the image volume and observes its deletion.*/
+    void ObserveImage(mitk::Image *imageVolume);
+
     CompressedImageContainer m_CompressedImageContainer;
 
+    std::shared_ptr<const SparseSliceDiff> m_SparseDiff;
+
+    bool m_Revert;
+
+    std::array<int, 6> m_SliceExtent;
+
     mitk::Image *m_Image;
 
     vtkSmartPointer<vtkImageData> m_Slice;
@@ -13,13 +13,17 @@ found in the LICENSE file.
 #include "mitkDiffSliceOperationApplier.h"
 
 #include "mitkDiffSliceOperation.h"
+#include "mitkMultiDiffSliceOperation.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegTool2D.h"
 #include <mitkExtractSliceFilter.h>
 #include <mitkVtkImageOverwrite.h>
 
 // VTK
+#include <vtkImageData.h>
+#include <vtkImageStencilData.h>
 #include <vtkSmartPointer.h>
+#include <vtkTypeTraits.h>
 
 mitk::DiffSliceOperationApplier::DiffSliceOperationApplier()
 {
@@ -31,21 +35,59 @@ mitk::DiffSliceOperationApplier::~DiffSliceOperationApplier()
 
 void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
 {
-  auto *imageOperation = dynamic_cast<DiffSliceOperation *>(operation);
+  if (auto *multiOperation = dynamic_cast<MultiDiffSliceOperation *>(operation))
+  {
+    for (std::size_t i = 0; i < multiOperation->GetNumberOfOperations(); ++i)
+      this->ApplyDiffSliceOperation(multiOperation->GetOperation(i));
 
-  // as we only support DiffSliceOperation return if operation is not type of DiffSliceOperation
-  if (!imageOperation)
     return;
+  }
+
+  // as we only support DiffSliceOperation return if operation is not type of DiffSliceOperation
+  if (auto *imageOperation = dynamic_cast<DiffSliceOperation *>(operation))
+    this->ApplyDiffSliceOperation(imageOperation);
+}
 
+void mitk::DiffSliceOperationApplier::ApplyDiffSliceOperation(DiffSliceOperation *imageOperation)
+{
   // check if the operation is valid
   if (imageOperation->IsValid())
   {
     // the actual overwrite filter (vtk)
     vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
 
-    mitk::Image::Pointer slice = imageOperation->GetSlice();
-    // Set the slice as 'input'
-    reslice->SetInputSlice(slice->GetVtkImageData());
+    mitk::Image::Pointer slice;
+
+    if (imageOperation->IsSparse())
+    {
+      // Only the changed pixels are written: the slice just carries their values and the
+      // stencil restricts the overwrite to the runs of the difference.
+      const auto* diff = imageOperation->GetSparseDiff();
+      const auto& extent = imageOperation->GetSliceExtent();
+
+      auto sparseSlice = vtkSmartPointer<vtkImageData>::New();
+      sparseSlice->SetExtent(const_cast<int*>(extent.data()));
+      sparseSlice->AllocateScalars(vtkTypeTraits<SparseSliceDiff::ValueType>::VTKTypeID(), 1);
+      diff->Write(static_cast<SparseSliceDiff::ValueType*>(sparseSlice->GetScalarPointer()), imageOperation->IsRevert());
+
+      auto stencil = vtkSmartPointer<vtkImageStencilData>::New();
+      stencil->SetExtent(const_cast<int*>(extent.data()));
+      stencil->AllocateExtents();
+      for (const auto& run : diff->GetRuns())
+      {
+        const int begin = extent[0] + static_cast<int>(run.Begin);
+        stencil->InsertNextExtent(begin, begin + static_cast<int>(run.Length) - 1, extent[2] + static_cast<int>(run.Row), extent[4]);
+      }
+
+      reslice->SetInputSlice(sparseSlice);
+      reslice->SetStencilData(stencil);
+    }
+    else
+    {
+      slice = imageOperation->GetSlice();
+      // Set the slice as 'input'
+      reslice->SetInputSlice(slice->GetVtkImageData());
+    }
 
     // set overwrite mode to true to write back to the image volume
     reslice->SetOverwriteMode(true);
@@ -67,6 +109,11 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     imageOperation->GetImage()->Modified();
 
     PlaneGeometry::ConstPointer plane = dynamic_cast<const PlaneGeometry *>(imageOperation->GetWorldGeometry());
+
+    if (auto* labelSetImage = dynamic_cast<LabelSetImage*>(imageOperation->GetImage()))
+    {
+      labelSetImage->UpdateLabelOccupancy(labelSetImage->GetActiveLayer(), imageOperation->GetTimeStep(), imageOperation->GetWorldGeometry());
+    }
     SegTool2D::UpdateAllSurfaceInterpolations(dynamic_cast<LabelSetImage*>(imageOperation->GetImage()), imageOperation->GetTimeStep(), plane, true);
   }
 }
@@ -19,7 +19,9 @@ found in the LICENSE file.
 
 namespace mitk
 {
-  /** \brief Executes a DiffSliceOperation.
+  class DiffSliceOperation;
+
+  /** \brief Executes a DiffSliceOperation or a MultiDiffSliceOperation.
     \sa DiffSliceOperation
   */
   class MITKSEGMENTATION_EXPORT DiffSliceOperationApplier : public OperationActor
@@ -33,13 +35,16 @@ namespace mitk
     /** \brief Executes a DiffSliceOperation.
       \sa DiffSliceOperation
       Note:
-        Only DiffSliceOperation is supported.
+        Only DiffSliceOperation and MultiDiffSliceOperation are supported.
     */
     void ExecuteOperation(Operation *op) override;
 
   protected:
     DiffSliceOperationApplier();
 
+    /** \brief Writes the slice (difference) of the operation into its image volume.*/
+    void ApplyDiffSliceOperation(DiffSliceOperation *operation);
+
     ~DiffSliceOperationApplier() override;
   };
 }
@@ -28,7 +28,8 @@ mitk::ImageToContourFilter::ImageToContourFilter()
   : m_SliceGeometry(nullptr),
     m_UseProgressBar(false),
     m_ProgressStepSize(1),
-    m_ContourValue(1.0)
+    m_ContourValue(1.0),
+    m_NumberOfWorkUnits(0)
 {
 }
 
@@ -98,6 +99,14 @@ void mitk::ImageToContourFilter::Itk2DContourExtraction(const itk::Image<TPixel,
 
   contourExtractorFilter->SetInput(padFilter->GetOutput());
   contourExtractorFilter->SetContourValue(0.5);
+
+  if (0 != m_NumberOfWorkUnits)
+  {
+    binaryFilter->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+    padFilter->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+    contourExtractorFilter->SetNumberOfWorkUnits(m_NumberOfWorkUnits);
+  }
+
   contourExtractorFilter->Update();
 
   unsigned int foundPaths = contourExtractorFilter->GetNumberOfOutputs();
@@ -77,6 +77,14 @@ namespace mitk
      */
     itkSetMacro (ContourValue, ScalarType);
 
+    /**
+     * @brief Set the number of work units of the internal ITK filters. 0 (default) uses the ITK default.
+     *
+     * Set it to 1 if several filters are executed concurrently.
+     */
+    itkSetMacro(NumberOfWorkUnits, unsigned int);
+    itkGetConstMacro(NumberOfWorkUnits, unsigned int);
+
   protected:
     ImageToContourFilter();
     ~ImageToContourFilter() override;
@@ -88,6 +96,7 @@ namespace mitk
     bool m_UseProgressBar;
     unsigned int m_ProgressStepSize;
     ScalarType m_ContourValue;
+    unsigned int m_NumberOfWorkUnits;
 
     template <typename TPixel, unsigned int VImageDimension>
     void Itk2DContourExtraction(const itk::Image<TPixel, VImageDimension> *sliceImage);
@@ -0,0 +1,46 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkMultiDiffSliceOperation.h"
+
+#include "mitkDiffSliceOperation.h"
+
+mitk::MultiDiffSliceOperation::MultiDiffSliceOperation(const std::vector<DiffSliceOperation *> &operations)
+  : Operation(1)
+{
+  m_Operations.reserve(operations.size());
+
+  for (auto *operation : operations)
+  {
+    if (nullptr != operation)
+      m_Operations.emplace_back(operation);
+  }
+}
+
+mitk::MultiDiffSliceOperation::~MultiDiffSliceOperation()
+{
+}
+
+mitk::DiffSliceOperation *mitk::MultiDiffSliceOperation::GetOperation(std::size_t index) const
+{
+  return static_cast<DiffSliceOperation *>(m_Operations.at(index).get());
+}
+
+std::size_t mitk::MultiDiffSliceOperation::GetMemorySize() const
+{
+  std::size_t size = 0;
+
+  for (const auto &operation : m_Operations)
+    size += operation->GetMemorySize();
+
+  return size;
+}
@@ -0,0 +1,53 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMultiDiffSliceOperation_h
+#define mitkMultiDiffSliceOperation_h
+
+#include <MitkSegmentationExports.h>
+#include <mitkOperation.h>
+
+#include <memory>
+#include <vector>
+
+namespace mitk
+{
+  class DiffSliceOperation;
+
+  /** \brief An Operation that applies several DiffSliceOperations as one undo/redo step.
+
+    Used when many slices are written at once (e.g. when all interpolated slices are confirmed),
+    so that the undo history contains one item instead of one item per slice.
+    The operations are executed in the order they were passed.
+    \sa DiffSliceOperationApplier
+  */
+  class MITKSEGMENTATION_EXPORT MultiDiffSliceOperation : public Operation
+  {
+  public:
+    mitkClassMacro(MultiDiffSliceOperation, Operation);
+
+    /** \brief Creates the operation and takes ownership of the passed operations.*/
+    explicit MultiDiffSliceOperation(const std::vector<DiffSliceOperation *> &operations);
+    ~MultiDiffSliceOperation() override;
+
+    std::size_t GetNumberOfOperations() const { return m_Operations.size(); }
+    DiffSliceOperation *GetOperation(std::size_t index) const;
+
+    /** \brief Returns the sum of the memory occupied by all contained operations.*/
+    std::size_t GetMemorySize() const override;
+
+  private:
+    std::vector<std::unique_ptr<Operation>> m_Operations;
+  };
+}
+
+#endif
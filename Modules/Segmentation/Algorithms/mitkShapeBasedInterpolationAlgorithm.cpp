@@ -13,14 +13,50 @@ found in the LICENSE file.
 #include "mitkShapeBasedInterpolationAlgorithm.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
+#include "mitkSignedDistanceTransform2D.h"
 #include <mitkITKImageImport.h>
 
-#include <itkFastChamferDistanceImageFilter.h>
-#include <itkInvertIntensityImageFilter.h>
-#include <itkIsoContourDistanceImageFilter.h>
-#include <itkSubtractImageFilter.h>
+#include <itkImageRegionConstIterator.h>
 
+#include <algorithm>
 #include <thread>
+#include <vector>
+
+mitk::ShapeBasedInterpolationAlgorithm::ShapeBasedInterpolationAlgorithm()
+  : m_MaximumCacheSize(std::max(64u, 4 * std::thread::hardware_concurrency()))
+{
+}
+
+mitk::ShapeBasedInterpolationAlgorithm::~ShapeBasedInterpolationAlgorithm()
+{
+}
+
+void mitk::ShapeBasedInterpolationAlgorithm::SetMaximumCacheSize(std::size_t maximumCacheSize)
+{
+  std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+
+  m_MaximumCacheSize = maximumCacheSize;
+
+  while (m_DistanceImageCache.size() > m_MaximumCacheSize)
+  {
+    m_DistanceImageCache.erase(m_LeastRecentlyUsedKeys.front());
+    m_LeastRecentlyUsedKeys.pop_front();
+  }
+}
+
+std::size_t mitk::ShapeBasedInterpolationAlgorithm::GetMaximumCacheSize() const
+{
+  std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+  return m_MaximumCacheSize;
+}
+
+void mitk::ShapeBasedInterpolationAlgorithm::ClearDistanceMapCache()
+{
+  std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+
+  m_DistanceImageCache.clear();
+  m_LeastRecentlyUsedKeys.clear();
+}
 
 mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::Interpolate(
   Image::ConstPointer lowerSlice,
@@ -28,13 +64,13 @@ mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::Interpolate(
   Image::ConstPointer upperSlice,
   unsigned int upperSliceIndex,
   unsigned int requestedIndex,
-  unsigned int /*sliceDimension*/, // commented variables are not used
+  unsigned int sliceDimension,
   Image::Pointer resultImage,
-  unsigned int /*timeStep*/,
+  unsigned int timeStep,
   Image::ConstPointer /*referenceImage*/)
 {
-  auto lowerDistanceImage = this->ComputeDistanceMap(lowerSliceIndex, lowerSlice);
-  auto upperDistanceImage = this->ComputeDistanceMap(upperSliceIndex, upperSlice);
+  auto lowerDistanceImage = this->ComputeDistanceMap(CacheKeyType(timeStep, sliceDimension, lowerSliceIndex), lowerSlice);
+  auto upperDistanceImage = this->ComputeDistanceMap(CacheKeyType(timeStep, sliceDimension, upperSliceIndex), upperSlice);
 
   // calculate where the current slice is in comparison to the lower and upper neighboring slices
   float ratio = (float)(requestedIndex - lowerSliceIndex) / (float)(upperSliceIndex - lowerSliceIndex);
@@ -43,18 +79,18 @@ mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::Interpolate(
   return resultImage;
 }
 
-mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(unsigned int sliceIndex, Image::ConstPointer slice)
+mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(const CacheKeyType &key, Image::ConstPointer slice)
 {
-  static const auto MAX_CACHE_SIZE = 2 * std::thread::hardware_concurrency();
-
   {
     std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
 
-    if (0 != m_DistanceImageCache.count(sliceIndex))
-      return m_DistanceImageCache[sliceIndex];
+    auto iter = m_DistanceImageCache.find(key);
 
-    if (MAX_CACHE_SIZE < m_DistanceImageCache.size())
-      m_DistanceImageCache.clear();
+    if (iter != m_DistanceImageCache.end())
+    {
+      m_LeastRecentlyUsedKeys.splice(m_LeastRecentlyUsedKeys.end(), m_LeastRecentlyUsedKeys, iter->second.Position);
+      return iter->second.DistanceImage;
+    }
   }
 
   mitk::Image::Pointer distanceImage;
@@ -62,7 +98,17 @@ mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(
 
   std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
 
-  m_DistanceImageCache[sliceIndex] = distanceImage;
+  if (0 == m_MaximumCacheSize || 0 != m_DistanceImageCache.count(key))
+    return distanceImage;
+
+  while (m_DistanceImageCache.size() >= m_MaximumCacheSize)
+  {
+    m_DistanceImageCache.erase(m_LeastRecentlyUsedKeys.front());
+    m_LeastRecentlyUsedKeys.pop_front();
+  }
+
+  auto position = m_LeastRecentlyUsedKeys.insert(m_LeastRecentlyUsedKeys.end(), key);
+  m_DistanceImageCache[key] = CacheEntry{ distanceImage, position };
 
   return distanceImage;
 }
@@ -71,48 +117,29 @@ template <typename TPixel, unsigned int VImageDimension>
 void mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *binaryImage,
                                                                 mitk::Image::Pointer &result)
 {
-  typedef itk::Image<TPixel, VImageDimension> DistanceFilterInputImageType;
-
-  typedef itk::FastChamferDistanceImageFilter<DistanceFilterImageType, DistanceFilterImageType> DistanceFilterType;
-  typedef itk::IsoContourDistanceImageFilter<DistanceFilterInputImageType, DistanceFilterImageType> IsoContourType;
-  typedef itk::InvertIntensityImageFilter<DistanceFilterInputImageType> InvertIntensityImageFilterType;
-  typedef itk::SubtractImageFilter<DistanceFilterImageType, DistanceFilterImageType> SubtractImageFilterType;
-
-  typename DistanceFilterType::Pointer distanceFilter = DistanceFilterType::New();
-  typename DistanceFilterType::Pointer distanceFilterInverted = DistanceFilterType::New();
-  typename IsoContourType::Pointer isoContourFilter = IsoContourType::New();
-  typename IsoContourType::Pointer isoContourFilterInverted = IsoContourType::New();
-  typename InvertIntensityImageFilterType::Pointer invertFilter = InvertIntensityImageFilterType::New();
-  typename SubtractImageFilterType::Pointer subtractImageFilter = SubtractImageFilterType::New();
-
-  // arbitrary maximum distance
-  int maximumDistance = 100;
+  const auto region = binaryImage->GetLargestPossibleRegion();
+  const auto width = static_cast<unsigned int>(region.GetSize(0));
+  const auto height = static_cast<unsigned int>(region.GetSize(1));
 
   // this assumes the image contains only 1 and 0
-  invertFilter->SetInput(binaryImage);
-  invertFilter->SetMaximum(1);
-
-  // do the processing on the image and the inverted image to get inside and outside distance
-  isoContourFilter->SetInput(binaryImage);
-  isoContourFilter->SetFarValue(maximumDistance + 1);
-  isoContourFilter->SetLevelSetValue(0);
-
-  isoContourFilterInverted->SetInput(invertFilter->GetOutput());
-  isoContourFilterInverted->SetFarValue(maximumDistance + 1);
-  isoContourFilterInverted->SetLevelSetValue(0);
+  std::vector<unsigned char> mask;
+  mask.reserve(static_cast<std::size_t>(width) * height);
 
-  distanceFilter->SetInput(isoContourFilter->GetOutput());
-  distanceFilter->SetMaximumDistance(maximumDistance);
+  itk::ImageRegionConstIterator<itk::Image<TPixel, VImageDimension>> iter(binaryImage, region);
+  for (iter.GoToBegin(); !iter.IsAtEnd(); ++iter)
+    mask.push_back(0 != iter.Get() ? 1 : 0);
 
-  distanceFilterInverted->SetInput(isoContourFilterInverted->GetOutput());
-  distanceFilterInverted->SetMaximumDistance(maximumDistance);
+  auto distanceImage = DistanceFilterImageType::New();
+  distanceImage->SetRegions(region);
+  distanceImage->SetOrigin(binaryImage->GetOrigin());
+  distanceImage->SetSpacing(binaryImage->GetSpacing());
+  distanceImage->SetDirection(binaryImage->GetDirection());
+  distanceImage->Allocate();
 
-  // inside distance should be negative, outside distance positive
-  subtractImageFilter->SetInput2(distanceFilter->GetOutput());
-  subtractImageFilter->SetInput1(distanceFilterInverted->GetOutput());
-  subtractImageFilter->Update();
+  // inside distance is negative, outside distance positive
+  SignedDistanceTransform2D::Compute(mask.data(), width, height, distanceImage->GetBufferPointer());
 
-  result = mitk::GrabItkImageMemory(subtractImageFilter->GetOutput());
+  result = mitk::GrabItkImageMemory(distanceImage.GetPointer());
 }
 
 template <typename TPixel, unsigned int VImageDimension>
@@ -16,8 +16,10 @@ found in the LICENSE file.
 #include "mitkSegmentationInterpolationAlgorithm.h"
 #include <MitkSegmentationExports.h>
 
+#include <list>
 #include <map>
 #include <mutex>
+#include <tuple>
 
 namespace mitk
 {
@@ -30,6 +32,11 @@ namespace mitk
    * G.T. Herman, J. Zheng, C.A. Bucholtz: "Shape-based interpolation"
    * IEEE Computer Graphics & Applications, pp. 69-79,May 1992
    *
+   * The signed distance maps of the neighboring slices are computed by the exact SignedDistanceTransform2D.
+   * Reuse one instance for the interpolation of many slices (e.g. of a whole volume) of the same label:
+   * the distance maps are kept in a least recently used cache (see SetMaximumCacheSize()) keyed by
+   * time step, slice dimension, and slice index.
+   *
    *  Last contributor:
    *  $Author:$
    */
@@ -50,13 +57,32 @@ namespace mitk
                                  unsigned int timeStep,
                                  Image::ConstPointer referenceImage) override;
 
+    /** \brief Maximum number of distance maps that are cached. 0 disables the cache.*/
+    void SetMaximumCacheSize(std::size_t maximumCacheSize);
+    std::size_t GetMaximumCacheSize() const;
+
+    void ClearDistanceMapCache();
+
+  protected:
+    ShapeBasedInterpolationAlgorithm();
+    ~ShapeBasedInterpolationAlgorithm() override;
+
   private:
     typedef itk::Image<mitk::ScalarType, 2> DistanceFilterImageType;
 
+    /** time step, slice dimension, slice index */
+    using CacheKeyType = std::tuple<unsigned int, unsigned int, unsigned int>;
+
+    struct CacheEntry
+    {
+      Image::Pointer DistanceImage;
+      std::list<CacheKeyType>::iterator Position;
+    };
+
     template <typename TPixel, unsigned int VImageDimension>
     void ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *, mitk::Image::Pointer &result);
 
-    Image::Pointer ComputeDistanceMap(unsigned int sliceIndex, Image::ConstPointer slice);
+    Image::Pointer ComputeDistanceMap(const CacheKeyType &key, Image::ConstPointer slice);
 
     template <typename TPixel, unsigned int VImageDimension>
     void InterpolateIntermediateSlice(itk::Image<TPixel, VImageDimension> *result,
@@ -64,8 +90,10 @@ namespace mitk
                                       const mitk::Image::Pointer &upperDistanceImage,
                                       float ratio);
 
-    std::map<unsigned int, Image::Pointer> m_DistanceImageCache;
-    std::mutex m_DistanceImageCacheMutex;
+    std::map<CacheKeyType, CacheEntry> m_DistanceImageCache;
+    std::list<CacheKeyType> m_LeastRecentlyUsedKeys; // front is the least recently used key
+    std::size_t m_MaximumCacheSize;
+    mutable std::mutex m_DistanceImageCacheMutex;
   };
 
 } // namespace
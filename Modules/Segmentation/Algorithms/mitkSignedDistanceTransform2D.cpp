@@ -0,0 +1,148 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSignedDistanceTransform2D.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+  constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+  /** Squared Euclidean distances of all pixels to the nearest pixel with mask value (mask != 0) == feature. */
+  void ComputeSquaredDistances(const unsigned char *mask,
+                               bool feature,
+                               unsigned int width,
+                               unsigned int height,
+                               std::vector<float> &squaredDistances)
+  {
+    const std::size_t numberOfPixels = static_cast<std::size_t>(width) * height;
+    std::vector<float> columnDistances(numberOfPixels);
+
+    // Phase 1: distances along the columns. Both sweeps run over whole rows.
+    for (unsigned int x = 0; x < width; ++x)
+      columnDistances[x] = (0 != mask[x]) == feature ? 0.0f : Infinity;
+
+    for (unsigned int y = 1; y < height; ++y)
+    {
+      const auto *maskRow = mask + static_cast<std::size_t>(y) * width;
+      const auto *previousRow = columnDistances.data() + static_cast<std::size_t>(y - 1) * width;
+      auto *row = columnDistances.data() + static_cast<std::size_t>(y) * width;
+
+      for (unsigned int x = 0; x < width; ++x)
+        row[x] = (0 != maskRow[x]) == feature ? 0.0f : previousRow[x] + 1.0f;
+    }
+
+    for (unsigned int y = height - 1; y > 0; --y)
+    {
+      const auto *nextRow = columnDistances.data() + static_cast<std::size_t>(y) * width;
+      auto *row = columnDistances.data() + static_cast<std::size_t>(y - 1) * width;
+
+      for (unsigned int x = 0; x < width; ++x)
+        row[x] = std::min(row[x], nextRow[x] + 1.0f);
+    }
+
+    // Phase 2: lower envelope of the parabolas f(q) + (x - q)^2 along each row
+    squaredDistances.resize(numberOfPixels);
+
+    std::vector<unsigned int> vertices(width);
+    std::vector<double> boundaries(width + 1);
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      const auto *row = columnDistances.data() + static_cast<std::size_t>(y) * width;
+      auto *result = squaredDistances.data() + static_cast<std::size_t>(y) * width;
+
+      auto f = [row](unsigned int q) { return static_cast<double>(row[q]) * row[q]; };
+
+      auto intersection = [&f](unsigned int p, unsigned int q) {
+        return ((f(q) + static_cast<double>(q) * q) - (f(p) + static_cast<double>(p) * p)) / (2.0 * q - 2.0 * p);
+      };
+
+      int k = -1;
+
+      for (unsigned int q = 0; q < width; ++q)
+      {
+        if (Infinity == row[q])
+          continue; // column without any feature pixel
+
+        if (k < 0)
+        {
+          k = 0;
+          vertices[0] = q;
+          boundaries[0] = -std::numeric_limits<double>::infinity();
+          boundaries[1] = std::numeric_limits<double>::infinity();
+          continue;
+        }
+
+        auto s = intersection(vertices[k], q);
+
+        while (s <= boundaries[k])
+        {
+          --k;
+          s = intersection(vertices[k], q);
+        }
+
+        ++k;
+        vertices[k] = q;
+        boundaries[k] = s;
+        boundaries[k + 1] = std::numeric_limits<double>::infinity();
+      }
+
+      if (k < 0)
+      {
+        std::fill(result, result + width, Infinity);
+        continue;
+      }
+
+      k = 0;
+
+      for (unsigned int q = 0; q < width; ++q)
+      {
+        while (boundaries[k + 1] < q)
+          ++k;
+
+        const double dx = static_cast<double>(q) - vertices[k];
+        result[q] = static_cast<float>(dx * dx + f(vertices[k]));
+      }
+    }
+  }
+}
+
+void mitk::SignedDistanceTransform2D::Compute(const unsigned char *mask,
+                                              unsigned int width,
+                                              unsigned int height,
+                                              ScalarType *distances)
+{
+  if (0 == width || 0 == height)
+    return;
+
+  std::vector<float> toInside;
+  std::vector<float> toOutside;
+
+  ComputeSquaredDistances(mask, true, width, height, toInside);
+  ComputeSquaredDistances(mask, false, width, height, toOutside);
+
+  const auto maximumDistance = static_cast<ScalarType>(width) + height;
+  const std::size_t numberOfPixels = static_cast<std::size_t>(width) * height;
+
+  for (std::size_t i = 0; i < numberOfPixels; ++i)
+  {
+    // the boundary lies half a pixel away from the nearest pixel on the other side
+    distances[i] = 0 != mask[i]
+      ? -std::min(std::sqrt(static_cast<ScalarType>(toOutside[i])) - 0.5, maximumDistance)
+      : std::min(std::sqrt(static_cast<ScalarType>(toInside[i])) - 0.5, maximumDistance);
+  }
+}
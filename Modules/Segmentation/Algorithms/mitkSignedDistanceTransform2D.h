@@ -0,0 +1,48 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSignedDistanceTransform2D_h
+#define mitkSignedDistanceTransform2D_h
+
+#include <mitkNumericConstants.h>
+
+#include <MitkSegmentationExports.h>
+
+namespace mitk
+{
+  /** \brief Exact signed Euclidean distance transform of 2D binary slices.
+
+    Distances are measured in pixels from the boundary between inside and outside, which lies half a pixel
+    away from the centers of the boundary pixels. Thus outside pixels get positive distances, inside pixels get
+    negative distances, and two touching pixels on both sides of the boundary get 0.5 and -0.5 respectively.
+    If a slice has no inside (or no outside) pixels at all, the distances are clamped to width + height.
+
+    The transform is separable and linear in the number of pixels: column distances are computed by a forward
+    and a backward sweep over whole rows (contiguous inner loops that the compiler can vectorize), followed by
+    the lower envelope of parabolas along each row (Felzenszwalb and Huttenlocher, "Distance Transforms of
+    Sampled Functions", Theory of Computing 8, 2012).
+
+    \sa ShapeBasedInterpolationAlgorithm
+  */
+  class MITKSEGMENTATION_EXPORT SignedDistanceTransform2D
+  {
+  public:
+    /** \brief Computes the signed distances of a row-major mask of size width*height.
+      Non-zero mask pixels are inside. distances must provide space for width*height values.*/
+    static void Compute(const unsigned char *mask, unsigned int width, unsigned int height, ScalarType *distances);
+
+  private:
+    SignedDistanceTransform2D() = delete;
+  };
+}
+
+#endif
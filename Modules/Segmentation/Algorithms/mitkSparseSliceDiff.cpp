@@ -0,0 +1,107 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSparseSliceDiff.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+
+#include <algorithm>
+
+namespace
+{
+  unsigned int GetSliceHeight(const mitk::Image *slice)
+  {
+    return slice->GetDimension() > 1 ? slice->GetDimension(1) : 1;
+  }
+}
+
+bool mitk::SparseSliceDiff::IsSupported(const Image *slice)
+{
+  if (nullptr == slice || !slice->IsInitialized())
+    return false;
+
+  if (slice->GetPixelType() != MakeScalarPixelType<ValueType>())
+    return false;
+
+  const auto dimension = slice->GetDimension();
+  return dimension == 2 || (dimension == 3 && slice->GetDimension(2) == 1);
+}
+
+mitk::SparseSliceDiff::SparseSliceDiff(const Image *oldSlice, const Image *newSlice)
+  : m_Width(0), m_Height(0), m_NumberOfChangedPixels(0)
+{
+  if (!IsSupported(oldSlice) || !IsSupported(newSlice))
+    mitkThrow() << "Cannot compute sparse slice difference. Slices must be 2D images of the label pixel type.";
+
+  m_Width = oldSlice->GetDimension(0);
+  m_Height = GetSliceHeight(oldSlice);
+
+  if (newSlice->GetDimension(0) != m_Width || GetSliceHeight(newSlice) != m_Height)
+    mitkThrow() << "Cannot compute sparse slice difference. Slices differ in size.";
+
+  ImageReadAccessor oldAccessor(oldSlice);
+  ImageReadAccessor newAccessor(newSlice);
+
+  this->Compute(static_cast<const ValueType *>(oldAccessor.GetData()), static_cast<const ValueType *>(newAccessor.GetData()));
+}
+
+mitk::SparseSliceDiff::SparseSliceDiff(const ValueType *oldBuffer,
+                                       const ValueType *newBuffer,
+                                       unsigned int width,
+                                       unsigned int height)
+  : m_Width(width), m_Height(height), m_NumberOfChangedPixels(0)
+{
+  this->Compute(oldBuffer, newBuffer);
+}
+
+void mitk::SparseSliceDiff::Compute(const ValueType *oldBuffer, const ValueType *newBuffer)
+{
+  for (unsigned int row = 0; row < m_Height; ++row)
+  {
+    const auto *oldRow = oldBuffer + static_cast<std::size_t>(row) * m_Width;
+    const auto *newRow = newBuffer + static_cast<std::size_t>(row) * m_Width;
+
+    unsigned int x = 0;
+    while (x < m_Width)
+    {
+      if (oldRow[x] == newRow[x])
+      {
+        ++x;
+        continue;
+      }
+
+      Run run = {row, x, 1, oldRow[x], newRow[x]};
+      for (++x; x < m_Width && oldRow[x] == run.OldValue && newRow[x] == run.NewValue; ++x)
+        ++run.Length;
+
+      m_NumberOfChangedPixels += run.Length;
+      m_Runs.push_back(run);
+    }
+  }
+
+  m_Runs.shrink_to_fit();
+}
+
+std::size_t mitk::SparseSliceDiff::GetMemorySize() const
+{
+  return sizeof(*this) + m_Runs.capacity() * sizeof(Run);
+}
+
+void mitk::SparseSliceDiff::Write(ValueType *buffer, bool revert) const
+{
+  for (const auto &run : m_Runs)
+  {
+    auto *pixel = buffer + static_cast<std::size_t>(run.Row) * m_Width + run.Begin;
+    std::fill(pixel, pixel + run.Length, revert ? run.OldValue : run.NewValue);
+  }
+}
@@ -0,0 +1,89 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSparseSliceDiff_h
+#define mitkSparseSliceDiff_h
+
+#include <mitkImage.h>
+#include <mitkLabel.h>
+
+#include <MitkSegmentationExports.h>
+
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Sparse representation of the difference between two versions of a 2D label slice.
+
+    Only the changed pixels are stored. They are stored as runs: consecutive pixels within one row that
+    share the same old and the same new value. Thus the memory footprint depends on the number of
+    changed pixels (more precisely on the length of the changed boundary) and not on the slice size.
+
+    The difference can be written in both directions (see Write()), so one instance serves for undo and redo.
+    Only slices with the pixel type of label images (Label::PixelType) are supported (see IsSupported()).
+
+    \sa DiffSliceOperation
+  */
+  class MITKSEGMENTATION_EXPORT SparseSliceDiff
+  {
+  public:
+    using ValueType = Label::PixelType;
+
+    struct Run
+    {
+      unsigned int Row;
+      unsigned int Begin;
+      unsigned int Length;
+      ValueType OldValue;
+      ValueType NewValue;
+    };
+
+    using RunVectorType = std::vector<Run>;
+
+    /** \brief Checks if a slice has a pixel type and dimension that can be represented.*/
+    static bool IsSupported(const Image *slice);
+
+    /** \brief Computes the difference between two slices.
+      \pre Both slices are supported (see IsSupported()) and have the same size; otherwise an mitk::Exception is thrown.*/
+    SparseSliceDiff(const Image *oldSlice, const Image *newSlice);
+
+    /** \brief Computes the difference between two row-major slice buffers of size width*height.*/
+    SparseSliceDiff(const ValueType *oldBuffer, const ValueType *newBuffer, unsigned int width, unsigned int height);
+
+    unsigned int GetWidth() const { return m_Width; }
+    unsigned int GetHeight() const { return m_Height; }
+
+    const RunVectorType &GetRuns() const { return m_Runs; }
+
+    /** \brief Returns true if both slices were equal.*/
+    bool IsEmpty() const { return m_Runs.empty(); }
+
+    std::size_t GetNumberOfChangedPixels() const { return m_NumberOfChangedPixels; }
+
+    /** \brief Returns the memory in bytes occupied by the instance.*/
+    std::size_t GetMemorySize() const;
+
+    /** \brief Writes the new values (or the old values if revert is true) of all runs into a row-major
+      slice buffer of size width*height. Pixels that are not part of a run are not touched.*/
+    void Write(ValueType *buffer, bool revert) const;
+
+  private:
+    void Compute(const ValueType *oldBuffer, const ValueType *newBuffer);
+
+    unsigned int m_Width;
+    unsigned int m_Height;
+    std::size_t m_NumberOfChangedPixels;
+    RunVectorType m_Runs;
+  };
+}
+
+#endif
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "mitkImageTimeSelector.h"
 #include <mitkExtractSliceFilter.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkLabelSetImageConverter.h>
 //#include <mitkPlaneGeometry.h>
 
 #include <itkCommand.h>
@@ -107,6 +108,29 @@ void mitk::SegmentationInterpolationController::BlockModified(bool block)
 }
 
 void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Image *segmentation)
+{
+  this->InitializeSegmentationVolume(segmentation, {});
+}
+
+void mitk::SegmentationInterpolationController::SetSegmentationVolume(const LabelSetImage *segmentation,
+                                                                      LabelSetImage::LabelValueType labelValue)
+{
+  if (nullptr == segmentation)
+  {
+    this->InitializeSegmentationVolume(nullptr, {});
+    return;
+  }
+
+  // the voxels of the label lie within its bounding box, the rest of the mask need not be scanned
+  std::vector<LabelOccupancyIndex::LabelStatistics> labelRegions;
+  for (unsigned int timeStep = 0; timeStep < segmentation->GetTimeSteps(); ++timeStep)
+    labelRegions.push_back(segmentation->GetLabelStatistics(labelValue, timeStep));
+
+  this->InitializeSegmentationVolume(CreateLabelMask(segmentation, labelValue), labelRegions);
+}
+
+void mitk::SegmentationInterpolationController::InitializeSegmentationVolume(
+  const Image *segmentation, const std::vector<LabelOccupancyIndex::LabelStatistics> &labelRegions)
 {
   // clear old information (remove all time steps
   m_SegmentationCountInSlice.clear();
@@ -161,12 +185,26 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
   // scan whole image
   for (unsigned int timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
   {
+    LabelOccupancyIndex::IndexType minIndex = {{0, 0, 0}};
+    LabelOccupancyIndex::IndexType maxIndex = {{m_Segmentation->GetDimension(0) - 1,
+                                                m_Segmentation->GetDimension(1) - 1,
+                                                m_Segmentation->GetDimension(2) - 1}};
+
+    if (timeStep < labelRegions.size())
+    {
+      if (0 == labelRegions[timeStep].VoxelCount)
+        continue; // nothing to count in this time step
+
+      minIndex = labelRegions[timeStep].MinIndex;
+      maxIndex = labelRegions[timeStep].MaxIndex;
+    }
+
     ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
     timeSelector->SetInput(m_Segmentation);
     timeSelector->SetTimeNr(timeStep);
     timeSelector->UpdateLargestPossibleRegion();
     Image::Pointer segmentation3D = timeSelector->GetOutput();
-    AccessFixedDimensionByItk_2(segmentation3D, ScanWholeVolume, 3, m_Segmentation, timeStep);
+    AccessFixedDimensionByItk_n(segmentation3D, ScanVolume, 3, (m_Segmentation, timeStep, minIndex, maxIndex));
   }
 
   // PrintStatus();
@@ -373,9 +411,11 @@ void mitk::SegmentationInterpolationController::ScanChangedVolume(const itk::Ima
 }
 
 template <typename DATATYPE>
-void mitk::SegmentationInterpolationController::ScanWholeVolume(const itk::Image<DATATYPE, 3> *,
-                                                                const Image *volume,
-                                                                unsigned int timeStep)
+void mitk::SegmentationInterpolationController::ScanVolume(const itk::Image<DATATYPE, 3> *,
+                                                           const Image *volume,
+                                                           unsigned int timeStep,
+                                                           const LabelOccupancyIndex::IndexType &minIndex,
+                                                           const LabelOccupancyIndex::IndexType &maxIndex)
 {
   if (!volume)
     return;
@@ -383,14 +423,33 @@ void mitk::SegmentationInterpolationController::ScanWholeVolume(const itk::Image
     return;
 
   ImageReadAccessor readAccess(volume, volume->GetVolumeData(timeStep));
+  const auto *rawVolume =
+    static_cast<const DATATYPE *>(readAccess.GetData()); // we again promise not to change anything, we'll just count
 
-  for (unsigned int slice = 0; slice < volume->GetDimension(2); ++slice)
+  const std::size_t width = volume->GetDimension(0);
+  const std::size_t height = volume->GetDimension(1);
+  auto &countInSlice = m_SegmentationCountInSlice[timeStep];
+
+  // same counting as ScanChangedSlice() for the axial slices, restricted to the region
+  for (unsigned int z = minIndex[2]; z <= maxIndex[2]; ++z)
   {
-    const auto *rawVolume =
-      static_cast<const DATATYPE *>(readAccess.GetData()); // we again promise not to change anything, we'll just count
-    const DATATYPE *rawSlice = rawVolume + (volume->GetDimension(0) * volume->GetDimension(1) * slice);
+    int numberOfPixels(0); // number of pixels in this slice that are not 0
+
+    for (unsigned int y = minIndex[1]; y <= maxIndex[1]; ++y)
+    {
+      const DATATYPE *rawRow = rawVolume + (z * height + y) * width;
+
+      for (unsigned int x = minIndex[0]; x <= maxIndex[0]; ++x)
+      {
+        DATATYPE value = rawRow[x];
+
+        countInSlice[0][x] = static_cast<unsigned int>(countInSlice[0][x] + value);
+        countInSlice[1][y] = static_cast<unsigned int>(countInSlice[1][y] + value);
+        numberOfPixels += static_cast<int>(value);
+      }
+    }
 
-    ScanChangedSlice<DATATYPE>(nullptr, SetChangedSliceOptions(2, slice, 0, 1, timeStep, rawSlice));
+    countInSlice[2][z] += numberOfPixels;
   }
 }
 
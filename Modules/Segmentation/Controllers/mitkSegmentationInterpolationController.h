@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkCommon.h"
 #include "mitkImage.h"
 #include <MitkSegmentationExports.h>
+#include <mitkLabelSetImage.h>
 #include <mitkShapeBasedInterpolationAlgorithm.h>
 
 #include <itkImage.h>
@@ -99,6 +100,14 @@ namespace mitk
     */
     void SetSegmentationVolume(const Image *segmentation);
 
+    /**
+      \brief Initialize with the mask of one label of a multi-label segmentation.
+
+      Works like SetSegmentationVolume() for the mask of the label (see CreateLabelMask()), but only the
+      bounding box of the label, as known from the label occupancy index of the segmentation, is scanned.
+    */
+    void SetSegmentationVolume(const LabelSetImage *segmentation, LabelSetImage::LabelValueType labelValue);
+
     /**
       \brief Set a reference image (original patient image) - optional.
 
@@ -204,8 +213,17 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void ScanChangedVolume(const itk::Image<TPixel, VImageDimension> *, unsigned int timeStep);
 
+    /// Sets the segmentation and scans it. labelRegions holds the regions to scan per time step (whole volume if empty).
+    void InitializeSegmentationVolume(const Image *segmentation,
+                                      const std::vector<LabelOccupancyIndex::LabelStatistics> &labelRegions);
+
+    /// internal scan of the (inclusive) index region of a volume
     template <typename DATATYPE>
-    void ScanWholeVolume(const itk::Image<DATATYPE, 3> *, const Image *volume, unsigned int timeStep);
+    void ScanVolume(const itk::Image<DATATYPE, 3> *,
+                    const Image *volume,
+                    unsigned int timeStep,
+                    const LabelOccupancyIndex::IndexType &minIndex,
+                    const LabelOccupancyIndex::IndexType &maxIndex);
 
     void PrintStatus();
 
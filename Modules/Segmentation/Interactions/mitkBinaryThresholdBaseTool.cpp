@@ -12,10 +12,15 @@ found in the LICENSE file.
 
 #include "mitkBinaryThresholdBaseTool.h"
 
+#include "mitkDataStorage.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
 #include "mitkImageStatisticsHolder.h"
 #include "mitkLabelSetImage.h"
+#include "mitkRenderingManager.h"
+#include "mitkRenderingModeProperty.h"
+#include "mitkToolManager.h"
+#include "mitkTransferFunctionProperty.h"
 #include <itkBinaryThresholdImageFilter.h>
 #include <itkImageRegionIterator.h>
 
@@ -50,10 +55,135 @@ void mitk::BinaryThresholdBaseTool::SetThresholdValues(double lower, double uppe
 
   if (nullptr != this->GetPreviewSegmentation())
   {
-    UpdatePreview();
+    if (m_SlicePreview)
+    {
+      this->UpdateSlicePreviewNode();
+    }
+    else
+    {
+      UpdatePreview();
+    }
+  }
+}
+
+void mitk::BinaryThresholdBaseTool::SetSlicePreview(bool slicePreview)
+{
+  if (m_SlicePreview == slicePreview)
+    return;
+
+  m_SlicePreview = slicePreview;
+  this->Modified();
+
+  if (nullptr != this->GetPreviewSegmentation())
+  {
+    if (m_SlicePreview)
+    {
+      this->UpdateSlicePreviewNode();
+    }
+    else
+    {
+      this->RemoveSlicePreviewNode();
+      this->UpdatePreview();
+    }
   }
 }
 
+void mitk::BinaryThresholdBaseTool::Deactivated()
+{
+  this->RemoveSlicePreviewNode();
+  m_SlicePreviewNode = nullptr;
+
+  Superclass::Deactivated();
+}
+
+void mitk::BinaryThresholdBaseTool::UpdateSlicePreviewNode()
+{
+  const auto input = this->GetSegmentationInput();
+  auto previewNode = this->GetPreviewSegmentationNode();
+
+  if (nullptr == input || nullptr == previewNode)
+    return;
+
+  if (m_SlicePreviewNode.IsNull())
+  {
+    m_SlicePreviewNode = DataNode::New();
+    m_SlicePreviewNode->SetName(std::string(this->GetName()) + " slice preview");
+    m_SlicePreviewNode->SetBoolProperty("helper object", true);
+    m_SlicePreviewNode->SetProperty("Image Rendering.Mode",
+      RenderingModeProperty::New(RenderingModeProperty::COLORTRANSFERFUNCTION_COLOR));
+  }
+
+  if (m_SlicePreviewNode->GetData() != input)
+  {
+    // the node is only used for rendering, the input is not modified
+    m_SlicePreviewNode->SetData(const_cast<Image*>(input));
+  }
+
+  auto referenceNode = this->GetToolManager()->GetReferenceData(0);
+  int layer = 50;
+  if (nullptr != referenceNode)
+    referenceNode->GetIntProperty("layer", layer);
+  m_SlicePreviewNode->SetIntProperty("layer", layer + 2);
+  m_SlicePreviewNode->SetOpacity(0.5);
+
+  float color[3] = { 0.0f, 1.0f, 0.0f };
+  previewNode->GetColor(color);
+
+  // Integer images only contain integral values, thus a margin of 0.5 separates the
+  // interval borders from their neighbors. For float images use a fraction of the range.
+  const auto componentType = input->GetPixelType().GetComponentType();
+  const bool isFloatImage = componentType == itk::IOComponentEnum::FLOAT || componentType == itk::IOComponentEnum::DOUBLE;
+  const auto margin = isFloatImage
+    ? std::max((m_SensibleMaximumThreshold - m_SensibleMinimumThreshold) * 1e-6, 1e-6)
+    : 0.5;
+
+  auto transferFunction = TransferFunction::New();
+  transferFunction->AddRGBPoint(m_LowerThreshold, color[0], color[1], color[2]);
+  transferFunction->AddScalarOpacityPoint(m_LowerThreshold - margin, 0.0);
+  transferFunction->AddScalarOpacityPoint(m_LowerThreshold, 1.0);
+  transferFunction->AddScalarOpacityPoint(m_UpperThreshold, 1.0);
+  transferFunction->AddScalarOpacityPoint(m_UpperThreshold + margin, 0.0);
+
+  m_SlicePreviewNode->SetProperty("Image Rendering.Transfer Function", TransferFunctionProperty::New(transferFunction));
+
+  // the preview segmentation is not updated while the slice preview is shown
+  previewNode->SetVisibility(false);
+  this->InvalidatePreview();
+
+  if (DataStorage* storage = this->GetToolManager()->GetDataStorage())
+  {
+    if (!storage->Exists(m_SlicePreviewNode))
+      storage->Add(m_SlicePreviewNode, referenceNode);
+  }
+
+  RenderingManager::GetInstance()->RequestUpdateAll();
+}
+
+void mitk::BinaryThresholdBaseTool::RemoveSlicePreviewNode()
+{
+  if (m_SlicePreviewNode.IsNull())
+    return;
+
+  if (auto previewNode = this->GetPreviewSegmentationNode())
+    previewNode->SetVisibility(true);
+
+  try
+  {
+    if (DataStorage* storage = this->GetToolManager()->GetDataStorage())
+    {
+      if (storage->Exists(m_SlicePreviewNode))
+        storage->Remove(m_SlicePreviewNode);
+      RenderingManager::GetInstance()->RequestUpdateAll();
+    }
+  }
+  catch (...)
+  {
+    // don't care
+  }
+
+  m_SlicePreviewNode->SetData(nullptr);
+}
+
 void mitk::BinaryThresholdBaseTool::InitiateToolByInput()
 {
   const auto referenceImage = this->GetReferenceData();
@@ -101,6 +231,26 @@ void mitk::BinaryThresholdBaseTool::DoUpdatePreview(const Image* inputAtTimeStep
   }
 }
 
+bool mitk::BinaryThresholdBaseTool::SupportsAsynchronousPreview() const
+{
+  return true;
+}
+
+void mitk::BinaryThresholdBaseTool::UpdatePrepare()
+{
+  Superclass::UpdatePrepare();
+  // Done here and not in ITKThresholding() as the latter may be executed in a background thread.
+  this->SetSelectedLabels({this->GetActiveLabelValueOfPreview()});
+}
+
+std::shared_ptr<mitk::SegWithPreviewTool::PreviewUpdateSettings> mitk::BinaryThresholdBaseTool::CreatePreviewUpdateSettings() const
+{
+  auto settings = std::make_shared<ThresholdingSettings>();
+  settings->LowerThreshold = m_LowerThreshold;
+  settings->UpperThreshold = m_UpperThreshold;
+  return settings;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::BinaryThresholdBaseTool::ITKThresholding(const itk::Image<TPixel, VImageDimension>* inputImage,
                                                     LabelSetImage *segmentation,
@@ -110,14 +260,18 @@ void mitk::BinaryThresholdBaseTool::ITKThresholding(const itk::Image<TPixel, VIm
   typedef itk::Image<Tool::DefaultSegmentationDataType, VImageDimension> SegmentationType;
   typedef itk::BinaryThresholdImageFilter<ImageType, SegmentationType> ThresholdFilterType;
 
-  const auto activeValue = this->GetActiveLabelValueOfPreview();
-  this->SetSelectedLabels({activeValue});
+  // only the captured settings are used, as this may be executed in a background thread
+  const auto settings = static_cast<const ThresholdingSettings*>(this->GetPreviewUpdateSettings());
 
   typename ThresholdFilterType::Pointer filter = ThresholdFilterType::New();
+  if (this->GetAsynchronousPreview())
+  { // allows canceling of outdated background updates
+    filter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
+  }
   filter->SetInput(inputImage);
-  filter->SetLowerThreshold(m_LowerThreshold);
-  filter->SetUpperThreshold(m_UpperThreshold);
-  filter->SetInsideValue(activeValue);
+  filter->SetLowerThreshold(settings->LowerThreshold);
+  filter->SetUpperThreshold(settings->UpperThreshold);
+  filter->SetInsideValue(settings->ActiveLabelValue);
   filter->SetOutsideValue(0);
   filter->Update();
 
@@ -42,6 +42,19 @@ namespace mitk
 
     virtual void SetThresholdValues(double lower, double upper);
 
+    /** Controls the slice preview mode. If enabled, changing the threshold values does not
+    threshold the whole input volume. Instead the input image is shown with a transfer function
+    that only renders the pixels within the threshold interval. Thus only the slices visible in
+    the render windows are processed and the feedback no longer depends on the volume size.
+    The whole volume is thresholded when the segmentation is confirmed.*/
+    void SetSlicePreview(bool slicePreview);
+    itkGetConstMacro(SlicePreview, bool);
+    itkBooleanMacro(SlicePreview);
+
+    void Deactivated() override;
+
+    bool SupportsAsynchronousPreview() const override;
+
   protected:
     BinaryThresholdBaseTool(); // purposely hidden
     ~BinaryThresholdBaseTool() override;
@@ -54,6 +67,8 @@ namespace mitk
     itkGetMacro(SensibleMaximumThreshold, ScalarType);
 
     void InitiateToolByInput() override;
+    void UpdatePrepare() override;
+    std::shared_ptr<PreviewUpdateSettings> CreatePreviewUpdateSettings() const override;
     void DoUpdatePreview(const Image* inputAtTimeStep, const Image* oldSegAtTimeStep, LabelSetImage* previewImage, TimeStepType timeStep) override;
 
     template <typename TPixel, unsigned int VImageDimension>
@@ -61,6 +76,16 @@ namespace mitk
                          LabelSetImage *segmentation,
                          unsigned int timeStep);
 
+    /** Creates or updates the helper node that renders the threshold interval on the input image.*/
+    void UpdateSlicePreviewNode();
+    void RemoveSlicePreviewNode();
+
+    struct ThresholdingSettings : PreviewUpdateSettings
+    {
+      ScalarType LowerThreshold;
+      ScalarType UpperThreshold;
+    };
+
   private:
     ScalarType m_SensibleMinimumThreshold;
     ScalarType m_SensibleMaximumThreshold;
@@ -71,6 +96,10 @@ namespace mitk
       or like a upper/lower threshold tool (false)*/
     bool m_LockedUpperThreshold = false;
 
+    bool m_SlicePreview = false;
+
+    /** Helper node that renders the input image with the threshold transfer function in slice preview mode.*/
+    DataNode::Pointer m_SlicePreviewNode;
   };
 
 } // namespace
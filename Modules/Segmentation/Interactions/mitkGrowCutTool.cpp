@@ -69,6 +69,11 @@ void mitk::GrowCutTool::Deactivated()
   Superclass::Deactivated();
 }
 
+bool mitk::GrowCutTool::SupportsAsynchronousPreview() const
+{
+  return true;
+}
+
 bool mitk::GrowCutTool::SeedImageIsValid()
 {
   if (nullptr == this->GetToolManager()->GetWorkingData(0))
@@ -94,6 +99,13 @@ bool mitk::GrowCutTool::SeedImageIsValid()
   return false;
 }
 
+std::shared_ptr<mitk::SegWithPreviewTool::PreviewUpdateSettings> mitk::GrowCutTool::CreatePreviewUpdateSettings() const
+{
+  auto settings = std::make_shared<GrowCutSettings>();
+  settings->DistancePenalty = m_DistancePenalty;
+  return settings;
+}
+
 void mitk::GrowCutTool::DoUpdatePreview(const Image *inputAtTimeStep,
                                         const Image * oldSegAtTimeStep,
                                         LabelSetImage *previewImage,
@@ -113,7 +125,7 @@ void mitk::GrowCutTool::DoUpdatePreview(const Image *inputAtTimeStep,
       CastToItkImage(oldSegAtTimeStep, seedImage);
 
       growCutFilter->SetSeedImage(seedImage);
-      growCutFilter->SetDistancePenalty(m_DistancePenalty);
+      growCutFilter->SetDistancePenalty(static_cast<const GrowCutSettings*>(this->GetPreviewUpdateSettings())->DistancePenalty);
       growCutFilter->SetInput(inputAtTimeStep);
       growCutFilter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
 
@@ -43,6 +43,8 @@ namespace mitk
     void Activated() override;
     void Deactivated() override;
 
+    bool SupportsAsynchronousPreview() const override;
+
     bool SeedImageIsValid();
 
   protected:
@@ -54,7 +56,15 @@ namespace mitk
                          LabelSetImage *previewImage,
                          TimeStepType timeStep) override;
 
+    std::shared_ptr<PreviewUpdateSettings> CreatePreviewUpdateSettings() const override;
+
     double m_DistancePenalty = 0.0;
+
+  private:
+    struct GrowCutSettings : PreviewUpdateSettings
+    {
+      double DistancePenalty;
+    };
   };
 
 } // namespace mitk
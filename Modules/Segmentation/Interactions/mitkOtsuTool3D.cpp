@@ -45,6 +45,11 @@ void mitk::OtsuTool3D::Activated()
   this->SetLabelTransferMode(LabelTransferMode::AddLabel);
 }
 
+bool mitk::OtsuTool3D::SupportsAsynchronousPreview() const
+{
+  return true;
+}
+
 const char **mitk::OtsuTool3D::GetXPM() const
 {
   return nullptr;
@@ -64,12 +69,13 @@ const char* mitk::OtsuTool3D::GetName() const
 
 void mitk::OtsuTool3D::DoUpdatePreview(const Image* inputAtTimeStep, const Image* /*oldSegAtTimeStep*/, LabelSetImage* previewImage, TimeStepType timeStep)
 {
-  int numberOfThresholds = m_NumberOfRegions - 1;
+  const auto settings = static_cast<const OtsuSettings*>(this->GetPreviewUpdateSettings());
+  int numberOfThresholds = settings->NumberOfRegions - 1;
 
   mitk::OtsuSegmentationFilter::Pointer otsuFilter = mitk::OtsuSegmentationFilter::New();
   otsuFilter->SetNumberOfThresholds(numberOfThresholds);
-  otsuFilter->SetValleyEmphasis(m_UseValley);
-  otsuFilter->SetNumberOfBins(m_NumberOfBins);
+  otsuFilter->SetValleyEmphasis(settings->UseValley);
+  otsuFilter->SetNumberOfBins(settings->NumberOfBins);
   otsuFilter->SetInput(inputAtTimeStep);
   otsuFilter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
 
@@ -100,6 +106,15 @@ void mitk::OtsuTool3D::UpdatePrepare()
   }
 }
 
+std::shared_ptr<mitk::SegWithPreviewTool::PreviewUpdateSettings> mitk::OtsuTool3D::CreatePreviewUpdateSettings() const
+{
+  auto settings = std::make_shared<OtsuSettings>();
+  settings->NumberOfBins = m_NumberOfBins;
+  settings->NumberOfRegions = m_NumberOfRegions;
+  settings->UseValley = m_UseValley;
+  return settings;
+}
+
 unsigned int mitk::OtsuTool3D::GetMaxNumberOfBins() const
 {
   const auto min = this->GetReferenceData()->GetStatistics()->GetScalarValueMin();
@@ -37,6 +37,8 @@ namespace mitk
 
     void Activated() override;
 
+    bool SupportsAsynchronousPreview() const override;
+
     itkSetMacro(NumberOfBins, unsigned int);
     itkGetConstMacro(NumberOfBins, unsigned int);
 
@@ -55,11 +57,20 @@ namespace mitk
     ~OtsuTool3D() = default;
 
     void UpdatePrepare() override;
+    std::shared_ptr<PreviewUpdateSettings> CreatePreviewUpdateSettings() const override;
     void DoUpdatePreview(const Image* inputAtTimeStep, const Image* oldSegAtTimeStep, LabelSetImage* previewImage, TimeStepType timeStep) override;
 
     unsigned int m_NumberOfBins = 128;
     unsigned int m_NumberOfRegions = 2;
     bool m_UseValley = false;
+
+  private:
+    struct OtsuSettings : PreviewUpdateSettings
+    {
+      unsigned int NumberOfBins;
+      unsigned int NumberOfRegions;
+      bool UseValley;
+    };
   }; // class
 } // namespace
 #endif
@@ -32,13 +32,16 @@ found in the LICENSE file.
 
 // includes for resling and overwriting
 #include <mitkExtractSliceFilter.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkVtkImageOverwrite.h>
 #include <vtkImageData.h>
 #include <vtkSmartPointer.h>
 
 #include "mitkOperationEvent.h"
 #include "mitkUndoController.h"
+#include <mitkDiffSliceOperation.h>
 #include <mitkDiffSliceOperationApplier.h>
+#include <mitkMultiDiffSliceOperation.h>
 
 #include "mitkAbstractTransformGeometry.h"
 #include "mitkLabelSetImage.h"
@@ -50,8 +53,66 @@ found in the LICENSE file.
 #include <vtkAbstractArray.h>
 #include <vtkFieldData.h>
 
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <tuple>
+
 #define ROUND(a) ((a) > 0 ? (int)((a) + 0.5) : -(int)(0.5 - (a)))
 
+namespace
+{
+  /** Calls function(i) for all i in [0, count), distributed round-robin to multiple threads.
+   * The first exception thrown by any call is rethrown after all threads have finished.*/
+  template <typename TFunction>
+  void ParallelFor(std::size_t count, const TFunction& function)
+  {
+    const auto numThreads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), count);
+
+    if (numThreads < 2)
+    {
+      for (std::size_t i = 0; i < count; ++i)
+        function(i);
+
+      return;
+    }
+
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+
+    for (std::size_t threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+    {
+      threads.emplace_back([&, threadIndex]()
+      {
+        try
+        {
+          for (auto i = threadIndex; i < count; i += numThreads)
+            function(i);
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(exceptionMutex);
+          if (nullptr == exception)
+            exception = std::current_exception();
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    if (nullptr != exception)
+      std::rethrow_exception(exception);
+  }
+}
+
 bool mitk::SegTool2D::m_SurfaceInterpolationEnabled = true;
 
 mitk::SegTool2D::SliceInformation::SliceInformation(const mitk::Image* aSlice, const mitk::PlaneGeometry* aPlane, mitk::TimeStepType aTimestep) :
@@ -202,17 +263,13 @@ void mitk::SegTool2D::UpdateSurfaceInterpolation(const std::vector<SliceInformat
   if (dimRefImg != 3)
     return;
 
-  std::vector<mitk::Surface::Pointer> contourList;
-  contourList.reserve(sliceInfos.size());
-
-  ImageToContourFilter::Pointer contourExtractor = ImageToContourFilter::New();
-
   std::vector<SliceInformation> relevantSlices = sliceInfos;
 
   if (detectIntersection)
   {
     relevantSlices.clear();
 
+    // Not done concurrently, as the erosion runs multithreaded ITK filters that cannot be limited to one work unit
     for (const auto& sliceInfo : sliceInfos)
     {
       // Test whether there is something to extract or whether the slice just contains intersections of others
@@ -232,6 +289,7 @@ void mitk::SegTool2D::UpdateSurfaceInterpolation(const std::vector<SliceInformat
       //Workarround ends
 
       mitk::MorphologicalOperations::Erode(slice2, 2, mitk::MorphologicalOperations::Ball);
+      auto contourExtractor = ImageToContourFilter::New();
       contourExtractor->SetInput(slice2);
       contourExtractor->SetContourValue(erodeValue);
       contourExtractor->Update();
@@ -248,21 +306,37 @@ void mitk::SegTool2D::UpdateSurfaceInterpolation(const std::vector<SliceInformat
     }
   }
 
-  SurfaceInterpolationController::CPIVector cpis;
+  // The contours of the slices are extracted concurrently. Every task works on its own copy of the
+  // slice (slices may be shared between slice infos) and runs its filters with one work unit to not
+  // oversubscribe the ITK thread pool. The interpolation controller is only updated afterwards in
+  // the calling thread.
+  std::vector<Image::Pointer> slices;
+  slices.reserve(relevantSlices.size());
   for (const auto& sliceInfo : relevantSlices)
+    slices.push_back(sliceInfo.slice->Clone());
+
+  std::vector<mitk::Surface::Pointer> contours(relevantSlices.size());
+
+  ParallelFor(relevantSlices.size(), [&](std::size_t i)
   {
-    contourExtractor->SetInput(sliceInfo.slice);
+    auto contourExtractor = ImageToContourFilter::New();
+    contourExtractor->SetInput(slices[i]);
     contourExtractor->SetContourValue(activeLabelValue);
+    contourExtractor->SetNumberOfWorkUnits(1);
     contourExtractor->Update();
-    mitk::Surface::Pointer contour = contourExtractor->GetOutput();
+    contours[i] = contourExtractor->GetOutput();
+  });
 
-    if (contour->GetVtkPolyData()->GetNumberOfPoints() == 0)
+  SurfaceInterpolationController::CPIVector cpis;
+  for (std::size_t i = 0; i < relevantSlices.size(); ++i)
+  {
+    if (contours[i]->GetVtkPolyData()->GetNumberOfPoints() == 0)
     {
-      Self::RemoveContourFromInterpolator(sliceInfo, activeLabelValue);
+      Self::RemoveContourFromInterpolator(relevantSlices[i], activeLabelValue);
     }
     else
     {
-      cpis.emplace_back(contour, sliceInfo.plane->Clone(), activeLabelValue, sliceInfo.timestep);
+      cpis.emplace_back(contours[i], relevantSlices[i].plane->Clone(), activeLabelValue, relevantSlices[i].timestep);
     }
   }
 
@@ -581,12 +655,9 @@ void mitk::SegTool2D::WriteBackSegmentationResults(const DataNode* workingNode,
     mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
   }
 
-  for (const auto& sliceInfo : sliceList)
+  if (writeSliceToVolume)
   {
-    if (writeSliceToVolume && nullptr != sliceInfo.plane && sliceInfo.slice.IsNotNull())
-    {
-      SegTool2D::WriteSliceToVolume(image, sliceInfo, true);
-    }
+    SegTool2D::WriteSlicesToVolume(image, sliceList, true);
   }
 
   SegTool2D::UpdateSurfaceInterpolation(sliceList, image, false, activeLabelValue);
@@ -612,22 +683,213 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
     mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
   }
 
+  DiffSliceOperation* doOperation = nullptr;
   DiffSliceOperation* undoOperation = nullptr;
 
+  OverwriteSlice(workingImage, sliceInfo, allowUndo, doOperation, undoOperation);
+
+  // the image was modified within the pipeline, but not marked so
+  workingImage->Modified();
+  workingImage->GetVtkImageData()->Modified();
+
+  if (auto* labelSetImage = dynamic_cast<LabelSetImage*>(workingImage))
+  {
+    labelSetImage->UpdateLabelOccupancy(labelSetImage->GetActiveLayer(), sliceInfo.timestep, sliceInfo.plane);
+  }
+
   if (allowUndo)
+  {
+    /*============= BEGIN undo/redo feature block ========================*/
+    // create an operation event for the undo stack
+    OperationEvent* undoStackItem =
+      new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation");
+
+    // add it to the undo controller
+    UndoStackItem::IncCurrObjectEventId();
+    UndoStackItem::IncCurrGroupEventId();
+    UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
+    /*============= END undo/redo feature block ========================*/
+  }
+}
+
+void mitk::SegTool2D::WriteSlicesToVolume(Image* workingImage, const std::vector<SliceInformation>& sliceList, bool allowUndo)
+{
+  if (nullptr == workingImage)
+  {
+    mitkThrow() << "Cannot write slices to working node. Working node does not contain an image.";
+  }
+
+  std::vector<const SliceInformation*> slices;
+  slices.reserve(sliceList.size());
+
+  for (const auto& sliceInfo : sliceList)
+  {
+    if (nullptr != sliceInfo.plane && sliceInfo.slice.IsNotNull())
+      slices.push_back(&sliceInfo);
+  }
+
+  if (slices.empty())
+    return;
+
+  if (1 == slices.size())
+  {
+    WriteSliceToVolume(workingImage, *slices.front(), allowUndo);
+    return;
+  }
+
+  std::vector<DiffSliceOperation*> doOperations(slices.size(), nullptr);
+  std::vector<DiffSliceOperation*> undoOperations(slices.size(), nullptr);
+
+  if (AreSlicesDisjoint(workingImage, slices))
+  {
+    // Only the writes run concurrently. The extraction of the original slices and the creation of
+    // the undo/redo operations (which register observers at the working image) stay in this thread.
+    std::vector<Image::ConstPointer> originalSlices(slices.size());
+    if (allowUndo)
+    {
+      for (std::size_t i = 0; i < slices.size(); ++i)
+        originalSlices[i] = GetAffectedImageSliceAs2DImage(slices[i]->plane, workingImage, slices[i]->timestep);
+    }
+
+    // The pipelines of the writes must not share their input, as it is modified by them (e.g. the requested
+    // region and the vtk representation). Thus every write gets its own volume that references the memory of
+    // the affected time step of the working image.
+    std::map<TimeStepType, std::unique_ptr<ImageWriteAccessor>> accessors;
+    std::vector<Image::Pointer> volumes(slices.size());
+
+    for (std::size_t i = 0; i < slices.size(); ++i)
+    {
+      const auto timeStep = slices[i]->timestep;
+      auto& accessor = accessors[timeStep];
+      if (nullptr == accessor)
+        accessor = std::make_unique<ImageWriteAccessor>(workingImage, workingImage->GetVolumeData(timeStep));
+
+      volumes[i] = Image::New();
+      volumes[i]->Initialize(workingImage->GetPixelType(), *(workingImage->GetGeometry(timeStep)));
+      volumes[i]->SetImportVolume(accessor->GetData(), 0, 0, Image::ReferenceMemory);
+    }
+
+    std::vector<SliceWriteResult> writeResults(slices.size());
+
+    ParallelFor(slices.size(), [&](std::size_t i)
+    {
+      writeResults[i] = WriteSlice(volumes[i], 0, *slices[i], originalSlices[i]);
+    });
+
+    volumes.clear();
+    accessors.clear();
+
+    if (allowUndo)
+    {
+      for (std::size_t i = 0; i < slices.size(); ++i)
+        CreateDiffSliceOperations(workingImage, *slices[i], writeResults[i], doOperations[i], undoOperations[i]);
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < slices.size(); ++i)
+      OverwriteSlice(workingImage, *slices[i], allowUndo, doOperations[i], undoOperations[i]);
+  }
+
+  // the image was modified within the pipeline, but not marked so
+  workingImage->Modified();
+  workingImage->GetVtkImageData()->Modified();
+
+  if (auto* labelSetImage = dynamic_cast<LabelSetImage*>(workingImage))
+  {
+    for (const auto* sliceInfo : slices)
+      labelSetImage->UpdateLabelOccupancy(labelSetImage->GetActiveLayer(), sliceInfo->timestep, sliceInfo->plane);
+  }
+
+  if (allowUndo)
+  {
+    /*============= BEGIN undo/redo feature block ========================*/
+    // all slices are undone in one step; undo in reverse order in case slices overlap
+    std::reverse(undoOperations.begin(), undoOperations.end());
+
+    auto* doOperation = new MultiDiffSliceOperation(doOperations);
+    auto* undoOperation = new MultiDiffSliceOperation(undoOperations);
+
+    OperationEvent* undoStackItem =
+      new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation");
+
+    UndoStackItem::IncCurrObjectEventId();
+    UndoStackItem::IncCurrGroupEventId();
+    UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
+    /*============= END undo/redo feature block ========================*/
+  }
+}
+
+bool mitk::SegTool2D::AreSlicesDisjoint(const Image* workingImage, const std::vector<const SliceInformation*>& slices)
+{
+  // Only slices that are aligned with the image axes are known to cover disjoint voxels
+  // if they differ in slice index or time step. Oblique slices may share voxels due to
+  // the nearest neighbor sampling of the reslicer.
+  std::set<std::tuple<TimeStepType, int, int>> affectedSlices;
+
+  for (const auto* sliceInfo : slices)
+  {
+    int affectedDimension = -1;
+    int affectedSlice = -1;
+
+    if (!DetermineAffectedImageSlice(workingImage, sliceInfo->plane, affectedDimension, affectedSlice))
+      return false;
+
+    if (!affectedSlices.emplace(sliceInfo->timestep, affectedDimension, affectedSlice).second)
+      return false;
+  }
+
+  // slices of different orientations intersect
+  std::set<int> dimensions;
+  for (const auto& affectedSlice : affectedSlices)
+    dimensions.insert(std::get<1>(affectedSlice));
+
+  return 1 == dimensions.size();
+}
+
+void mitk::SegTool2D::OverwriteSlice(Image* workingImage,
+                                     const SliceInformation& sliceInfo,
+                                     bool createUndoOperations,
+                                     DiffSliceOperation*& doOperation,
+                                     DiffSliceOperation*& undoOperation)
+{
+  doOperation = nullptr;
+  undoOperation = nullptr;
+
+  Image::ConstPointer originalSlice;
+
+  if (createUndoOperations)
   {
     /*============= BEGIN undo/redo feature block ========================*/
     // Create undo operation by caching the not yet modified slices
-    mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
-    undoOperation =
-      new DiffSliceOperation(workingImage,
-        originalSlice,
-        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
-        sliceInfo.timestep,
-        sliceInfo.plane);
+    originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
     /*============= END undo/redo feature block ========================*/
   }
 
+  const auto writeResult = WriteSlice(workingImage, sliceInfo.timestep, sliceInfo, originalSlice);
+
+  if (createUndoOperations)
+  {
+    CreateDiffSliceOperations(workingImage, sliceInfo, writeResult, doOperation, undoOperation);
+  }
+}
+
+mitk::SegTool2D::SliceWriteResult mitk::SegTool2D::WriteSlice(Image* volume,
+                                                              TimeStepType timeStep,
+                                                              const SliceInformation& sliceInfo,
+                                                              const Image* originalSlice)
+{
+  SliceWriteResult result;
+  result.OriginalSlice = originalSlice;
+
+  if (nullptr != originalSlice && SparseSliceDiff::IsSupported(originalSlice) && SparseSliceDiff::IsSupported(sliceInfo.slice) &&
+      originalSlice->GetDimension(0) == sliceInfo.slice->GetDimension(0) &&
+      originalSlice->GetDimension(1) == sliceInfo.slice->GetDimension(1))
+  {
+    // label slices: only keep the changed pixels
+    result.SparseDiff = std::make_shared<const SparseSliceDiff>(originalSlice, sliceInfo.slice);
+  }
+
   // Make sure that for reslicing and overwriting the same algorithm is used. We can specify the mode of the vtk
   // reslicer
   vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
@@ -645,40 +907,58 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   reslice->Modified();
 
   mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-  extractor->SetInput(workingImage);
-  extractor->SetTimeStep(sliceInfo.timestep);
+  extractor->SetInput(volume);
+  extractor->SetTimeStep(timeStep);
   extractor->SetWorldGeometry(sliceInfo.plane);
   extractor->SetVtkOutputRequest(false);
-  extractor->SetResliceTransformByGeometry(workingImage->GetGeometry(sliceInfo.timestep));
+  extractor->SetResliceTransformByGeometry(volume->GetGeometry(timeStep));
 
   extractor->Modified();
   extractor->Update();
 
-  // the image was modified within the pipeline, but not marked so
-  workingImage->Modified();
-  workingImage->GetVtkImageData()->Modified();
+  if (nullptr != result.SparseDiff)
+  {
+    // the extent of the written slice is needed to address the changed pixels on undo/redo
+    reslice->GetOutputExtent(result.SliceExtent.data());
+  }
+  else
+  {
+    result.WrittenSlice = extractor->GetOutput();
+  }
 
-  if (allowUndo)
+  return result;
+}
+
+void mitk::SegTool2D::CreateDiffSliceOperations(Image* workingImage,
+                                                const SliceInformation& sliceInfo,
+                                                const SliceWriteResult& writeResult,
+                                                DiffSliceOperation*& doOperation,
+                                                DiffSliceOperation*& undoOperation)
+{
+  /*============= BEGIN undo/redo feature block ========================*/
+  if (nullptr != writeResult.SparseDiff)
   {
-    /*============= BEGIN undo/redo feature block ========================*/
-    // specify the redo operation with the edited slice
-    auto* doOperation =
+    undoOperation = new DiffSliceOperation(workingImage, writeResult.SparseDiff, true, writeResult.SliceExtent, sliceInfo.timestep, sliceInfo.plane);
+    doOperation = new DiffSliceOperation(workingImage, writeResult.SparseDiff, false, writeResult.SliceExtent, sliceInfo.timestep, sliceInfo.plane);
+  }
+  else
+  {
+    undoOperation =
       new DiffSliceOperation(workingImage,
-        extractor->GetOutput(),
-        dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
+        writeResult.OriginalSlice,
+        dynamic_cast<const SlicedGeometry3D*>(writeResult.OriginalSlice->GetGeometry()),
         sliceInfo.timestep,
         sliceInfo.plane);
 
-    // create an operation event for the undo stack
-    OperationEvent* undoStackItem =
-      new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation");
-
-    // add it to the undo controller
-    UndoStackItem::IncCurrObjectEventId();
-    UndoStackItem::IncCurrGroupEventId();
-    UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
-    /*============= END undo/redo feature block ========================*/
+    // specify the redo operation with the edited slice
+    doOperation =
+      new DiffSliceOperation(workingImage,
+        writeResult.WrittenSlice,
+        dynamic_cast<const SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
+        sliceInfo.timestep,
+        sliceInfo.plane);
   }
+  /*============= END undo/redo feature block ========================*/
 }
 
 
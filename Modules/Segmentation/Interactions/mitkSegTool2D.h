@@ -225,7 +225,8 @@ namespace mitk
     void WriteBackSegmentationResults(const std::vector<SliceInformation> &sliceList, bool writeSliceToVolume = true);
 
     /** \brief Writes all provided source slices into the data of the passed workingNode.
-     * The function does the following: 1) for every passed slice write it to workingNode (and generate and undo/redo step);
+     * The function does the following: 1) write all passed slices to workingNode (see WriteSlicesToVolume(),
+     * one undo/redo step is generated for all slices);
      * 2) update the surface interpolation and 3) mark the node as modified.
      * @param workingNode Pointer to the node that contains the working image.
      * @param sliceList Vector of all slices that should be written into the workingNode. If the list is
@@ -246,6 +247,14 @@ namespace mitk
     * @pre workingImage must point to a valid instance.*/
     static void WriteSliceToVolume(Image* workingImage, const SliceInformation &sliceInfo, bool allowUndo);
 
+    /** Writes all provided slices into the passed working image (see WriteSliceToVolume()).
+    * Slices that are aligned with the image axes and cover different image slices are written
+    * concurrently; all other slice lists are written sequentially in the given order.
+    * If asked for it, one undo/redo step is generated that reverts/redoes all slices.
+    * Slices without plane or image are ignored.
+    * @pre workingImage must point to a valid instance.*/
+    static void WriteSlicesToVolume(Image* workingImage, const std::vector<SliceInformation>& sliceList, bool allowUndo);
+
     /**
       \brief Adds a new node called Contourmarker to the datastorage which holds a mitk::PlanarFigure.
       By selecting this node the slicestack will be reoriented according to the passed
@@ -272,6 +281,40 @@ namespace mitk
 
     static void  RemoveContourFromInterpolator(const SliceInformation& sliceInfo, LabelSetImage::LabelValueType labelValue);
 
+    /** Checks if the slices cover disjoint voxels of the working image and thus can be written concurrently.*/
+    static bool AreSlicesDisjoint(const Image* workingImage, const std::vector<const SliceInformation*>& slices);
+
+    /** Writes the slice into the working image without any further bookkeeping (modification,
+    * label occupancy, undo stack). If createUndoOperations is true, the do and undo operations
+    * of the write are returned; the caller takes their ownership.*/
+    static void OverwriteSlice(Image* workingImage,
+                               const SliceInformation& sliceInfo,
+                               bool createUndoOperations,
+                               DiffSliceOperation*& doOperation,
+                               DiffSliceOperation*& undoOperation);
+
+    /** Data of a write that is needed to create its undo/redo operations (see WriteSlice()).*/
+    struct SliceWriteResult
+    {
+      Image::ConstPointer OriginalSlice;
+      Image::ConstPointer WrittenSlice;
+      std::shared_ptr<const SparseSliceDiff> SparseDiff;
+      std::array<int, 6> SliceExtent = {};
+    };
+
+    /** Writes the slice into the passed time step of the volume. Only the passed images are accessed, thus
+    * writes into different volumes may run concurrently. If originalSlice is set, the data needed to create
+    * the undo/redo operations is returned.*/
+    static SliceWriteResult WriteSlice(Image* volume, TimeStepType timeStep, const SliceInformation& sliceInfo, const Image* originalSlice);
+
+    /** Creates the do and undo operations of a write; the caller takes their ownership. As the operations
+    * observe the working image, it must not be called concurrently.*/
+    static void CreateDiffSliceOperations(Image* workingImage,
+                                          const SliceInformation& sliceInfo,
+                                          const SliceWriteResult& writeResult,
+                                          DiffSliceOperation*& doOperation,
+                                          DiffSliceOperation*& undoOperation);
+
     // The prefix of the contourmarkername. Suffix is a consecutive number
     const std::string m_Contourmarkername;
 
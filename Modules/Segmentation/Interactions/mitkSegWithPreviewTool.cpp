@@ -19,6 +19,8 @@ found in the LICENSE file.
 
 #include "mitkDataStorage.h"
 #include "mitkRenderingManager.h"
+#include <mitkCallbackFromGUIThread.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkTimeNavigationController.h>
 
 #include "mitkImageAccessByItk.h"
@@ -41,6 +43,7 @@ mitk::SegWithPreviewTool::SegWithPreviewTool(bool lazyDynamicPreviews, const cha
 
 mitk::SegWithPreviewTool::~SegWithPreviewTool()
 {
+  this->StopAsynchronousPreviewWorker();
 }
 
 void mitk::SegWithPreviewTool::SetMergeStyle(MultiLabelSegmentation::MergeStyle mergeStyle)
@@ -137,6 +140,10 @@ void mitk::SegWithPreviewTool::Activated()
 
 void mitk::SegWithPreviewTool::Deactivated()
 {
+  this->StopAsynchronousPreviewWorker();
+  this->CleanUpAsynchronousPreviewUpdate();
+  m_AsynchronousPreviewSource = nullptr;
+
   this->GetToolManager()->RoiDataChanged -=
     MessageDelegate<SegWithPreviewTool>(this, &SegWithPreviewTool::OnRoiDataChanged);
 
@@ -146,6 +153,7 @@ void mitk::SegWithPreviewTool::Deactivated()
   m_SegmentationInputNode = nullptr;
   m_ReferenceDataNode = nullptr;
   m_WorkingPlaneGeometry = nullptr;
+  m_IsPreviewOutdated = false;
 
   try
   {
@@ -170,11 +178,16 @@ void mitk::SegWithPreviewTool::Deactivated()
 
 void mitk::SegWithPreviewTool::ConfirmSegmentation()
 {
+  // a running background update would be superseded by the synchronous one anyway
+  this->CancelAsynchronousPreviewUpdate();
+  this->CleanUpAsynchronousPreviewUpdate();
+
   bool labelChanged = this->EnsureUpToDateUserDefinedActiveLabel();
-  if ((m_LazyDynamicPreviews && m_CreateAllTimeSteps) || labelChanged)
+  if ((m_LazyDynamicPreviews && m_CreateAllTimeSteps) || labelChanged || m_IsPreviewOutdated)
   { // The tool should create all time steps but is currently in lazy mode,
-    // thus ensure that a preview for all time steps is available.
-    this->UpdatePreview(true);
+    // or the preview was invalidated, thus ensure that an up to date preview
+    // for all time steps is available.
+    this->UpdatePreviewSynchronously(true);
   }
 
   CreateResultSegmentationFromPreview();
@@ -274,6 +287,10 @@ void mitk::SegWithPreviewTool::ResetPreviewNode()
     mitkThrow() << "Used tool is implemented incorrectly. ResetPreviewNode is called while preview update is ongoing. Check implementation!";
   }
 
+  this->CancelAsynchronousPreviewUpdate();
+  this->CleanUpAsynchronousPreviewUpdate();
+  m_AsynchronousPreviewSource = nullptr;
+
   itk::RGBPixel<float> previewColor;
   previewColor[0] = 0.0f;
   previewColor[1] = 1.0f;
@@ -602,6 +619,74 @@ bool mitk::SegWithPreviewTool::EnsureUpToDateUserDefinedActiveLabel()
 }
 
 void mitk::SegWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
+{
+  if (m_AsynchronousPreview)
+  {
+    this->RequestAsynchronousPreviewUpdate(ignoreLazyPreviewSetting);
+  }
+  else
+  {
+    this->UpdatePreviewSynchronously(ignoreLazyPreviewSetting);
+  }
+}
+
+mitk::SegWithPreviewTool::PreviewUpdateStepVectorType mitk::SegWithPreviewTool::GetPreviewUpdateSteps(
+  const LabelSetImage* previewImage, bool ignoreLazyPreviewSetting, TimePointType timePoint) const
+{
+  PreviewUpdateStepVectorType steps;
+
+  if (previewImage->GetTimeSteps() > 1 && (ignoreLazyPreviewSetting || !m_LazyDynamicPreviews))
+  {
+    for (unsigned int timeStep = 0; timeStep < previewImage->GetTimeSteps(); ++timeStep)
+    {
+      steps.push_back({ previewImage->GetTimeGeometry()->TimeStepToTimePoint(timeStep), timeStep });
+    }
+  }
+  else
+  {
+    steps.push_back({ timePoint, previewImage->GetTimeGeometry()->TimePointToTimeStep(timePoint) });
+  }
+
+  return steps;
+}
+
+void mitk::SegWithPreviewTool::DoUpdatePreviewStep(const Image* inputImage, const Image* workingImage, LabelSetImage* previewImage, const PreviewUpdateStep& step)
+{
+  Image::ConstPointer feedBackImage;
+  Image::ConstPointer currentSegImage;
+
+  if (nullptr != this->GetWorkingPlaneGeometry())
+  { //only extract a specific slice defined by the working plane as feedback referenceImage.
+    feedBackImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), inputImage, step.TimePoint);
+    currentSegImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), workingImage, step.TimePoint);
+  }
+  else
+  { //work on the whole feedback referenceImage
+    feedBackImage = this->GetImageByTimePoint(inputImage, step.TimePoint);
+    currentSegImage = this->GetImageByTimePoint(workingImage, step.TimePoint);
+  }
+
+  this->DoUpdatePreview(feedBackImage, currentSegImage, previewImage, step.TimeStep);
+}
+
+std::shared_ptr<mitk::SegWithPreviewTool::PreviewUpdateSettings> mitk::SegWithPreviewTool::CreatePreviewUpdateSettings() const
+{
+  return std::make_shared<PreviewUpdateSettings>();
+}
+
+std::shared_ptr<const mitk::SegWithPreviewTool::PreviewUpdateSettings> mitk::SegWithPreviewTool::CapturePreviewUpdateSettings() const
+{
+  auto settings = this->CreatePreviewUpdateSettings();
+  settings->ActiveLabelValue = this->GetActiveLabelValueOfPreview();
+  return settings;
+}
+
+const mitk::SegWithPreviewTool::PreviewUpdateSettings* mitk::SegWithPreviewTool::GetPreviewUpdateSettings() const
+{
+  return m_PreviewUpdateSettings.get();
+}
+
+void mitk::SegWithPreviewTool::UpdatePreviewSynchronously(bool ignoreLazyPreviewSetting)
 {
   const auto inputImage = this->GetSegmentationInput();
   auto previewImage = this->GetPreviewSegmentation();
@@ -613,7 +698,12 @@ void mitk::SegWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
   this->CurrentlyBusy.Send(true);
   m_IsUpdating = true;
   m_IsPreviewGenerated = false;
+  // the flag may still be set by the cancellation of an asynchronous update
+  m_ProgressCommand->SetStopProcessing(false);
+  m_ProgressCommand->SetReportProgress(true);
   this->UpdatePrepare();
+  if (nullptr != previewImage)
+    m_PreviewUpdateSettings = this->CapturePreviewUpdateSettings();
 
   const TimePointType timePoint = RenderingManager::GetInstance()->GetTimeNavigationController()->GetSelectedTimePoint();
 
@@ -623,50 +713,12 @@ void mitk::SegWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
     {
       m_ProgressCommand->AddStepsToDo(progress_steps);
 
-      if (previewImage->GetTimeSteps() > 1 && (ignoreLazyPreviewSetting || !m_LazyDynamicPreviews))
+      for (const auto& step : this->GetPreviewUpdateSteps(previewImage, ignoreLazyPreviewSetting, timePoint))
       {
-        for (unsigned int timeStep = 0; timeStep < previewImage->GetTimeSteps(); ++timeStep)
-        {
-          Image::ConstPointer feedBackImage;
-          Image::ConstPointer currentSegImage;
-
-          auto previewTimePoint = previewImage->GetTimeGeometry()->TimeStepToTimePoint(timeStep);
-          auto inputTimeStep = inputImage->GetTimeGeometry()->TimePointToTimeStep(previewTimePoint);
-
-          if (nullptr != this->GetWorkingPlaneGeometry())
-          { //only extract a specific slice defined by the working plane as feedback referenceImage.
-            feedBackImage = SegTool2D::GetAffectedImageSliceAs2DImage(this->GetWorkingPlaneGeometry(), inputImage, inputTimeStep);
-            currentSegImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), workingImage, previewTimePoint);
-          }
-          else
-          { //work on the whole feedback referenceImage
-            feedBackImage = this->GetImageByTimeStep(inputImage, inputTimeStep);
-            currentSegImage = this->GetImageByTimePoint(workingImage, previewTimePoint);
-          }
-
-          this->DoUpdatePreview(feedBackImage, currentSegImage, previewImage, timeStep);
-        }
+        this->DoUpdatePreviewStep(inputImage, workingImage, previewImage, step);
       }
-      else
-      {
-        Image::ConstPointer feedBackImage;
-        Image::ConstPointer currentSegImage;
 
-        if (nullptr != this->GetWorkingPlaneGeometry())
-        {
-          feedBackImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), inputImage, timePoint);
-          currentSegImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), workingImage, timePoint);
-        }
-        else
-        {
-          feedBackImage = this->GetImageByTimePoint(inputImage, timePoint);
-          currentSegImage = this->GetImageByTimePoint(workingImage, timePoint);
-        }
-
-        auto timeStep = previewImage->GetTimeGeometry()->TimePointToTimeStep(timePoint);
-
-        this->DoUpdatePreview(feedBackImage, currentSegImage, previewImage, timeStep);
-      }
+      m_IsPreviewOutdated = false;
       RenderingManager::GetInstance()->RequestUpdateAll();
       if (!previewImage->GetAllLabelValues().empty())
       { // check if labels exits for the preview
@@ -698,6 +750,275 @@ void mitk::SegWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
   CurrentlyBusy.Send(false);
 }
 
+void mitk::SegWithPreviewTool::SetAsynchronousPreview(bool asynchronousPreview)
+{
+  if (asynchronousPreview && !this->SupportsAsynchronousPreview())
+  {
+    MITK_WARN << this->GetNameOfClass() << " does not support asynchronous previews. Setting is ignored.";
+    return;
+  }
+
+  if (m_AsynchronousPreview == asynchronousPreview)
+    return;
+
+  if (!asynchronousPreview)
+  {
+    this->StopAsynchronousPreviewWorker();
+    this->CleanUpAsynchronousPreviewUpdate();
+      m_AsynchronousPreviewSource = nullptr;
+  }
+
+  m_AsynchronousPreview = asynchronousPreview;
+  this->Modified();
+}
+
+bool mitk::SegWithPreviewTool::SupportsAsynchronousPreview() const
+{
+  return false;
+}
+
+bool mitk::SegWithPreviewTool::IsPreviewUpdateCanceled() const
+{
+  return m_ProgressCommand->GetStopProcessing();
+}
+
+void mitk::SegWithPreviewTool::RequestAsynchronousPreviewUpdate(bool ignoreLazyPreviewSetting)
+{
+  const auto inputImage = this->GetSegmentationInput();
+  auto previewImage = this->GetPreviewSegmentation();
+
+  if (nullptr == inputImage || nullptr == previewImage)
+    return;
+
+  this->EnsureUpToDateUserDefinedActiveLabel();
+
+  // a superseded request is not cleaned up by its publication anymore
+  this->CleanUpAsynchronousPreviewUpdate();
+  this->UpdatePrepare();
+  m_IsAsynchronousUpdatePrepared = true;
+
+  // Every request computes into its own private image, so the preview and the image of a superseded
+  // request that may still be in progress are never written by the worker.
+  m_AsynchronousPreviewSource = previewImage;
+
+  m_RequestedTimePoint = RenderingManager::GetInstance()->GetTimeNavigationController()->GetSelectedTimePoint();
+
+  auto request = std::make_unique<AsynchronousPreviewRequest>();
+  request->Input = inputImage;
+  request->Segmentation = dynamic_cast<const Image*>(this->GetToolManager()->GetWorkingData(0)->GetData());
+  request->Target = previewImage->Clone();
+  request->Steps = this->GetPreviewUpdateSteps(previewImage, ignoreLazyPreviewSetting, m_RequestedTimePoint);
+  request->Settings = this->CapturePreviewUpdateSettings();
+  request->Generation = ++m_PreviewGeneration;
+
+  m_IsPreviewOutdated = true;
+  m_IsPreviewGenerated = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_AsynchronousMutex);
+
+    // coalesce: a request that was not started yet is simply replaced
+    m_PendingPreviewRequest = std::move(request);
+
+    if (m_IsAsynchronousUpdateRunning)
+      m_ProgressCommand->SetStopProcessing(true);
+
+    m_ProgressCommand->SetReportProgress(false);
+    m_StopAsynchronousWorker = false;
+
+    if (!m_AsynchronousWorker.joinable())
+      m_AsynchronousWorker = std::thread(&SegWithPreviewTool::AsynchronousPreviewWorker, this);
+  }
+
+  m_AsynchronousCondition.notify_all();
+}
+
+void mitk::SegWithPreviewTool::CancelAsynchronousPreviewUpdate()
+{
+  std::unique_lock<std::mutex> lock(m_AsynchronousMutex);
+
+  // invalidate all results that are already queued for publication
+  ++m_PreviewGeneration;
+  m_PendingPreviewRequest.reset();
+
+  if (m_IsAsynchronousUpdateRunning)
+  {
+    m_ProgressCommand->SetStopProcessing(true);
+    m_AsynchronousCondition.wait(lock, [this] { return !m_IsAsynchronousUpdateRunning; });
+    // the worker is idle now, so the flag must not abort subsequent synchronous updates
+    m_ProgressCommand->SetStopProcessing(false);
+  }
+}
+
+void mitk::SegWithPreviewTool::CleanUpAsynchronousPreviewUpdate()
+{
+  if (m_IsAsynchronousUpdatePrepared)
+  {
+    m_IsAsynchronousUpdatePrepared = false;
+    this->UpdateCleanUp();
+  }
+}
+
+void mitk::SegWithPreviewTool::StopAsynchronousPreviewWorker()
+{
+  this->CancelAsynchronousPreviewUpdate();
+
+  {
+    std::lock_guard<std::mutex> lock(m_AsynchronousMutex);
+    m_StopAsynchronousWorker = true;
+  }
+
+  m_AsynchronousCondition.notify_all();
+
+  if (m_AsynchronousWorker.joinable())
+    m_AsynchronousWorker.join();
+}
+
+namespace
+{
+  /** Copy of one computed time step. It is owned by the event, so the GUI thread can swap it into
+  the preview while the worker already computes the next time step.*/
+  struct AsynchronousPreviewStepResult
+  {
+    unsigned long Generation;
+    mitk::TimeStepType TimeStep;
+    std::shared_ptr<const std::vector<char>> Volume;
+    std::vector<mitk::Label::Pointer> Labels;
+    bool IsLastStep;
+  };
+
+  AsynchronousPreviewStepResult CopyAsynchronousPreviewStep(unsigned long generation, mitk::LabelSetImage* image,
+    mitk::TimeStepType timeStep, bool isLastStep)
+  {
+    auto volumeData = image->GetVolumeData(timeStep);
+    mitk::ImageReadAccessor accessor(image, volumeData);
+    const auto* data = static_cast<const char*>(accessor.GetData());
+    auto volume = std::make_shared<const std::vector<char>>(data, data + volumeData->GetSize());
+
+    std::vector<mitk::Label::Pointer> labels;
+    for (const auto& label : image->GetConstLabelsByValue(image->GetLabelValuesByGroup(image->GetActiveLayer())))
+    {
+      labels.push_back(label->Clone());
+    }
+
+    return { generation, timeStep, volume, labels, isLastStep };
+  }
+
+  struct AsynchronousPreviewError
+  {
+    unsigned long Generation;
+    std::string Message;
+  };
+
+  using AsynchronousPreviewStepEvent = mitk::CallbackEventOneParameter<AsynchronousPreviewStepResult>;
+  using AsynchronousPreviewErrorEvent = mitk::CallbackEventOneParameter<AsynchronousPreviewError>;
+}
+
+void mitk::SegWithPreviewTool::AsynchronousPreviewWorker()
+{
+  std::unique_lock<std::mutex> lock(m_AsynchronousMutex);
+
+  while (true)
+  {
+    m_AsynchronousCondition.wait(lock, [this] { return m_StopAsynchronousWorker || nullptr != m_PendingPreviewRequest; });
+
+    if (m_StopAsynchronousWorker)
+      break;
+
+    auto request = std::move(m_PendingPreviewRequest);
+    m_IsAsynchronousUpdateRunning = true;
+    m_ProgressCommand->SetStopProcessing(false);
+    m_PreviewUpdateSettings = request->Settings;
+    lock.unlock();
+
+    for (std::size_t i = 0; i < request->Steps.size() && !this->IsPreviewUpdateCanceled(); ++i)
+    {
+      std::string errorMessage;
+
+      try
+      {
+        this->DoUpdatePreviewStep(request->Input, request->Segmentation, request->Target, request->Steps[i]);
+      }
+      catch (const itk::ExceptionObject& e)
+      {
+        errorMessage = e.GetDescription();
+      }
+      catch (const std::exception& e)
+      {
+        errorMessage = e.what();
+      }
+
+      // aborted filters throw as well, so check for cancellation first
+      if (this->IsPreviewUpdateCanceled())
+        break;
+
+      auto command = itk::ReceptorMemberCommand<SegWithPreviewTool>::New();
+
+      if (!errorMessage.empty())
+      {
+        command->SetCallbackFunction(this, &SegWithPreviewTool::OnAsynchronousPreviewFailed);
+        CallbackFromGUIThread::GetInstance()->CallThisFromGUIThread(command,
+          new AsynchronousPreviewErrorEvent({ request->Generation, errorMessage }));
+        break;
+      }
+
+      command->SetCallbackFunction(this, &SegWithPreviewTool::OnAsynchronousPreviewStepFinished);
+      CallbackFromGUIThread::GetInstance()->CallThisFromGUIThread(command,
+        new AsynchronousPreviewStepEvent(CopyAsynchronousPreviewStep(request->Generation, request->Target,
+          request->Steps[i].TimeStep, i + 1 == request->Steps.size())));
+    }
+
+    lock.lock();
+    m_IsAsynchronousUpdateRunning = false;
+    m_AsynchronousCondition.notify_all();
+  }
+}
+
+void mitk::SegWithPreviewTool::OnAsynchronousPreviewStepFinished(const itk::EventObject& e)
+{
+  const auto* event = dynamic_cast<const AsynchronousPreviewStepEvent*>(&e);
+  if (nullptr == event)
+    return;
+
+  const auto result = event->GetData();
+  auto previewImage = this->GetPreviewSegmentation();
+
+  // Results of requests that were superseded, canceled or started before the last InvalidatePreview()
+  // are discarded. The generation is only changed in the GUI thread, so no stale result can pass.
+  if (result.Generation != m_PreviewGeneration || nullptr == previewImage || previewImage != m_AsynchronousPreviewSource)
+    return;
+
+  for (const auto& label : result.Labels)
+  {
+    if (!previewImage->ExistLabel(label->GetValue(), previewImage->GetActiveLayer()))
+      previewImage->AddLabel(label->Clone(), previewImage->GetActiveLayer(), false, false);
+  }
+
+  previewImage->SetVolume(result.Volume->data(), result.TimeStep);
+
+  if (result.IsLastStep)
+  {
+    m_IsPreviewOutdated = false;
+    m_IsPreviewGenerated = !previewImage->GetAllLabelValues().empty();
+    m_LastTimePointOfUpdate = m_RequestedTimePoint;
+    this->CleanUpAsynchronousPreviewUpdate();
+  }
+
+  RenderingManager::GetInstance()->RequestUpdateAll();
+}
+
+void mitk::SegWithPreviewTool::OnAsynchronousPreviewFailed(const itk::EventObject& e)
+{
+  const auto* event = dynamic_cast<const AsynchronousPreviewErrorEvent*>(&e);
+  if (nullptr == event || event->GetData().Generation != m_PreviewGeneration)
+    return;
+
+  this->CleanUpAsynchronousPreviewUpdate();
+
+  MITK_ERROR << "Exception caught: " << event->GetData().Message;
+  ErrorMessage.Send(event->GetData().Message);
+}
+
 bool mitk::SegWithPreviewTool::IsUpdating() const
 {
   return m_IsUpdating;
@@ -760,6 +1081,25 @@ void mitk::SegWithPreviewTool::PreparePreviewToResultTransfer(const LabelMapping
   }
 }
 
+void mitk::SegWithPreviewTool::InvalidatePreview()
+{
+  m_IsPreviewOutdated = true;
+
+  {
+    std::lock_guard<std::mutex> lock(m_AsynchronousMutex);
+
+    // only a request issued after the invalidation may mark the preview as up to date again
+    ++m_PreviewGeneration;
+    m_PendingPreviewRequest.reset();
+
+    // the running update is aborted, but not waited for, as its result is discarded anyway
+    if (m_IsAsynchronousUpdateRunning)
+      m_ProgressCommand->SetStopProcessing(true);
+  }
+
+  this->CleanUpAsynchronousPreviewUpdate();
+}
+
 mitk::TimePointType mitk::SegWithPreviewTool::GetLastTimePointOfUpdate() const
 {
   return m_LastTimePointOfUpdate;
@@ -19,6 +19,11 @@ found in the LICENSE file.
 #include "mitkToolCommand.h"
 #include <MitkSegmentationExports.h>
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace mitk
 {
   /**
@@ -123,6 +128,29 @@ namespace mitk
     /** Indicate if currently UpdatePreview is triggered (true) or not (false).*/
     bool IsUpdating() const;
 
+    /** Controls if UpdatePreview() computes the preview in a background thread.
+     * In asynchronous mode UpdatePreview() returns immediately. Requests that arrive while
+     * a preview is computed are coalesced, the running computation is canceled and only the
+     * latest request is computed. The results are published per time step in the GUI thread
+     * (see CallbackFromGUIThread) as soon as they are available.
+     * ConfirmSegmentation() cancels pending computations and computes the preview synchronously
+     * if it is outdated.
+     * Only tools that indicate SupportsAsynchronousPreview() can be switched to asynchronous mode.
+     * @remark Requires a registered CallbackFromGUIThread implementation.*/
+    void SetAsynchronousPreview(bool asynchronousPreview);
+    itkGetConstMacro(AsynchronousPreview, bool);
+
+    /** Indicates if DoUpdatePreview() of the tool can be executed in a background thread.
+     * Tools have to reimplement it (returning true) to support asynchronous mode. In this case
+     * DoUpdatePreview() must only modify the passed preview image and must not change the tool,
+     * the data storage or any GUI element. ITK filters should be observed by m_ProgressCommand
+     * to support their cancellation. Tool settings should only be changed in the GUI thread
+     * followed by a call of UpdatePreview(). DoUpdatePreview() must access them via
+     * GetPreviewUpdateSettings() (see CreatePreviewUpdateSettings()). UpdatePrepare() and
+     * UpdateCleanUp() are always called in the GUI thread, every UpdatePrepare() is followed by
+     * exactly one UpdateCleanUp(). The default implementation returns false.*/
+    virtual bool SupportsAsynchronousPreview() const;
+
     /**
    * @brief Gets the name of the currently selected segmentation node
    * @return the name of the segmentation node or an empty string if
@@ -179,6 +207,27 @@ namespace mitk
     UpdatePreview. Default implementation does nothing.*/
     virtual void UpdateCleanUp();
 
+    /** Indicates if the preview update that currently runs in the background was superseded or canceled.
+    Long running DoUpdatePreview() implementations in asynchronous mode may poll it to stop early.*/
+    bool IsPreviewUpdateCanceled() const;
+
+    /** Settings of the tool that DoUpdatePreview() depends on. They are captured in the GUI thread
+    when an update is requested, so an update that runs in the background does not read members
+    that are changed in the GUI thread meanwhile. Derived tools extend it by inheritance.*/
+    struct PreviewUpdateSettings
+    {
+      virtual ~PreviewUpdateSettings() = default;
+      LabelSetImage::LabelValueType ActiveLabelValue = 0;
+    };
+
+    /** Creates the settings for the next preview update. It is called in the GUI thread directly after
+    UpdatePrepare(). ActiveLabelValue is set by the caller. Reimplement it to return derived settings.*/
+    virtual std::shared_ptr<PreviewUpdateSettings> CreatePreviewUpdateSettings() const;
+
+    /** Returns the settings of the preview update that is currently executed.
+    Only valid within DoUpdatePreview().*/
+    const PreviewUpdateSettings* GetPreviewUpdateSettings() const;
+
     /** This member function offers derived classes the possibility to alter what should
     happen directly after the Confirmation of the preview is performed. It is called by
     ConfirmSegmentation. Default implementation does nothing.*/
@@ -236,6 +285,12 @@ namespace mitk
     time step does not exist, nothing happens.*/
     void ResetPreviewContentAtTimeStep(unsigned int timeStep);
 
+    /** Marks the content of the preview as outdated. An outdated preview is updated before
+    the segmentation is confirmed. Derived classes can use it to defer the generation of the
+    preview until ConfirmSegmentation() is called (e.g. if they show a cheaper feedback in the
+    meantime). A running asynchronous update is aborted and its result is discarded.*/
+    void InvalidatePreview();
+
     TimePointType GetLastTimePointOfUpdate() const;
 
     LabelSetImage::LabelValueType GetActiveLabelValueOfPreview() const;
@@ -248,6 +303,40 @@ namespace mitk
     bool ConfirmBeforeDeactivation() override;
 
   private:
+    /** Time step of the preview and the time point of the input that should be used to generate it.*/
+    struct PreviewUpdateStep
+    {
+      TimePointType TimePoint;
+      TimeStepType TimeStep;
+    };
+    using PreviewUpdateStepVectorType = std::vector<PreviewUpdateStep>;
+
+    struct AsynchronousPreviewRequest
+    {
+      Image::ConstPointer Input;
+      Image::ConstPointer Segmentation;
+      LabelSetImage::Pointer Target;
+      PreviewUpdateStepVectorType Steps;
+      std::shared_ptr<const PreviewUpdateSettings> Settings;
+      unsigned long Generation;
+    };
+
+    PreviewUpdateStepVectorType GetPreviewUpdateSteps(const LabelSetImage* previewImage, bool ignoreLazyPreviewSetting, TimePointType timePoint) const;
+    void DoUpdatePreviewStep(const Image* inputImage, const Image* workingImage, LabelSetImage* previewImage, const PreviewUpdateStep& step);
+    std::shared_ptr<const PreviewUpdateSettings> CapturePreviewUpdateSettings() const;
+
+    void UpdatePreviewSynchronously(bool ignoreLazyPreviewSetting);
+    void RequestAsynchronousPreviewUpdate(bool ignoreLazyPreviewSetting);
+    /** Cancels a pending or running asynchronous preview update and waits until the worker is idle.*/
+    void CancelAsynchronousPreviewUpdate();
+    void StopAsynchronousPreviewWorker();
+    /** Calls UpdateCleanUp() for the last asynchronous request, if this was not done yet.*/
+    void CleanUpAsynchronousPreviewUpdate();
+    void AsynchronousPreviewWorker();
+    /** Called in the GUI thread if the worker has finished a time step or failed.*/
+    void OnAsynchronousPreviewStepFinished(const itk::EventObject& e);
+    void OnAsynchronousPreviewFailed(const itk::EventObject& e);
+
     void TransferImageAtTimeStep(const Image* sourceImage, Image* destinationImage, const TimeStepType timeStep, const LabelMappingType& labelMapping);
 
     void CreateResultSegmentationFromPreview();
@@ -328,6 +417,31 @@ namespace mitk
 
     bool m_IsPreviewGenerated = false;
 
+    /** Indicates that the content of the preview does not reflect the current tool settings (see InvalidatePreview()).*/
+    bool m_IsPreviewOutdated = false;
+
+    bool m_AsynchronousPreview = false;
+    /** Generation of the latest asynchronous preview request. Results of older generations are discarded.
+    Only accessed in the GUI thread.*/
+    unsigned long m_PreviewGeneration = 0;
+    TimePointType m_RequestedTimePoint = 0.;
+    /** Preview image the latest asynchronous request was issued for. The worker computes into a private
+    clone of it and the GUI thread copies each finished time step into the preview.*/
+    const LabelSetImage* m_AsynchronousPreviewSource = nullptr;
+    /** Indicates that UpdatePrepare() was called for an asynchronous request, but UpdateCleanUp() was not.
+    Only accessed in the GUI thread.*/
+    bool m_IsAsynchronousUpdatePrepared = false;
+    /** Settings of the update that is currently executed. Written by the thread that executes it, i.e. by
+    the worker or, while the worker is idle, by the GUI thread.*/
+    std::shared_ptr<const PreviewUpdateSettings> m_PreviewUpdateSettings;
+
+    std::unique_ptr<AsynchronousPreviewRequest> m_PendingPreviewRequest;
+    bool m_IsAsynchronousUpdateRunning = false;
+    bool m_StopAsynchronousWorker = false;
+    std::thread m_AsynchronousWorker;
+    std::mutex m_AsynchronousMutex;
+    std::condition_variable m_AsynchronousCondition;
+
     /** This variable tracks if there should be a user-confirmation before a tool is deactivated or not.
      * Call RequestDeactivationConfirmationOn() in the tool class to avail this feature.
      */
@@ -13,12 +13,20 @@ found in the LICENSE file.
 #include "mitkToolCommand.h"
 #include "mitkProgressBar.h"
 
-mitk::ToolCommand::ToolCommand() : m_ProgressValue(0), m_StopProcessing(false)
+#include <itkProcessObject.h>
+
+mitk::ToolCommand::ToolCommand() : m_ProgressValue(0), m_StopProcessing(false), m_ReportProgress(true)
 {
 }
 
-void mitk::ToolCommand::Execute(itk::Object *, const itk::EventObject &event)
+void mitk::ToolCommand::Execute(itk::Object *caller, const itk::EventObject &event)
 {
+  if (m_StopProcessing)
+  {
+    if (auto *process = dynamic_cast<itk::ProcessObject *>(caller))
+      process->AbortGenerateDataOn();
+  }
+
   if (typeid(event) == typeid(itk::IterationEvent))
   {
     // MITK_INFO << "IterationEvent";
@@ -59,7 +67,8 @@ void mitk::ToolCommand::Execute(itk::Object *, const itk::EventObject &event)
     // MITK_INFO << "FunctionAndGradientEvaluationIterationEvent";
   }
 
-  mitk::ProgressBar::GetInstance()->Progress();
+  if (m_ReportProgress)
+    mitk::ProgressBar::GetInstance()->Progress();
 }
 
 void mitk::ToolCommand::Execute(const itk::Object * /*caller*/, const itk::EventObject & /*event*/)
@@ -68,12 +77,14 @@ void mitk::ToolCommand::Execute(const itk::Object * /*caller*/, const itk::Event
 
 void mitk::ToolCommand::AddStepsToDo(int steps)
 {
-  mitk::ProgressBar::GetInstance()->AddStepsToDo(steps);
+  if (m_ReportProgress)
+    mitk::ProgressBar::GetInstance()->AddStepsToDo(steps);
 }
 
 void mitk::ToolCommand::SetProgress(int steps)
 {
-  mitk::ProgressBar::GetInstance()->Progress(steps);
+  if (m_ReportProgress)
+    mitk::ProgressBar::GetInstance()->Progress(steps);
 }
 
 double mitk::ToolCommand::GetCurrentProgressValue()
@@ -85,3 +96,13 @@ void mitk::ToolCommand::SetStopProcessing(bool value)
 {
   m_StopProcessing = value;
 }
+
+bool mitk::ToolCommand::GetStopProcessing() const
+{
+  return m_StopProcessing;
+}
+
+void mitk::ToolCommand::SetReportProgress(bool value)
+{
+  m_ReportProgress = value;
+}
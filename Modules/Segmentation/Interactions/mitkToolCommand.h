@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include "mitkCommon.h"
 #include <MitkSegmentationExports.h>
 
+#include <atomic>
+
 namespace mitk
 {
   /**
@@ -65,17 +67,29 @@ namespace mitk
     double GetCurrentProgressValue();
 
     /**
-    * \brief Sets the stop processing flag, which is used to call ...
+    * \brief Sets the stop processing flag. If set, any itk::ProcessObject that invokes
+    * an event observed by this command is asked to abort (see itk::ProcessObject::AbortGenerateDataOn()).
+    * This can be used to cooperatively cancel computations from another thread.
     *
     */
     void SetStopProcessing(bool value);
 
+    bool GetStopProcessing() const;
+
+    /**
+    * \brief Controls if the progress is forwarded to the progress bar (default).
+    * Switch it off if the observed filters are executed outside of the GUI thread.
+    *
+    */
+    void SetReportProgress(bool value);
+
   protected:
     ToolCommand();
 
   private:
     double m_ProgressValue;
-    bool m_StopProcessing;
+    std::atomic<bool> m_StopProcessing;
+    std::atomic<bool> m_ReportProgress;
   };
 
 } // namespace mitk
@@ -2,9 +2,12 @@ set(MODULE_TESTS
   mitkContourMapper2DTest.cpp
   mitkContourTest.cpp
   mitkContourModelSetToImageFilterTest.cpp
+  mitkContourModelSetsToLabelSetImageConverterTest.cpp
   mitkDataNodeSegmentationTest.cpp
   mitkImageToContourFilterTest.cpp
   mitkSegmentationInterpolationTest.cpp
+  mitkSignedDistanceTransform2DTest.cpp
+  mitkSparseSliceDiffTest.cpp
   mitkOverwriteSliceFilterTest.cpp
   mitkOverwriteSliceFilterObliquePlaneTest.cpp
 #  mitkToolManagerTest.cpp
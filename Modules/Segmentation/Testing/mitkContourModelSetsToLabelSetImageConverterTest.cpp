@@ -0,0 +1,208 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkContourModelSetsToLabelSetImageConverter.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <algorithm>
+
+class mitkContourModelSetsToLabelSetImageConverterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkContourModelSetsToLabelSetImageConverterTestSuite);
+  MITK_TEST(ConvertSeparateGroups);
+  MITK_TEST(ConvertSingleGroup);
+  MITK_TEST(ConvertWithHoles);
+  MITK_TEST(ConvertSagittalContour);
+  MITK_TEST(SkipInvalidContours);
+  MITK_TEST(ConvertWithoutReferenceImage);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  using LabelValueType = mitk::LabelSetImage::LabelValueType;
+
+  mitk::Image::Pointer m_ReferenceImage;
+  mitk::ContourModelSetsToLabelSetImageConverter::Pointer m_Converter;
+
+  static mitk::ContourModel::Pointer CreateRectangle(double x0, double y0, double x1, double y1, double z)
+  {
+    auto contour = mitk::ContourModel::New();
+    const double coordinates[4][2] = { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 } };
+
+    for (const auto& coordinate : coordinates)
+    {
+      mitk::Point3D vertex;
+      vertex[0] = coordinate[0];
+      vertex[1] = coordinate[1];
+      vertex[2] = z;
+      contour->AddVertex(vertex);
+    }
+
+    contour->Close();
+    return contour;
+  }
+
+  static mitk::ContourModelSet::Pointer CreateContourModelSet(const std::string& name, const std::vector<mitk::ContourModel::Pointer>& contours)
+  {
+    auto contourModelSet = mitk::ContourModelSet::New();
+
+    for (const auto& contour : contours)
+      contourModelSet->AddContourModel(contour);
+
+    contourModelSet->SetProperty("name", mitk::StringProperty::New(name));
+    contourModelSet->SetProperty("color", mitk::ColorProperty::New(0.0, 1.0, 0.0));
+    return contourModelSet;
+  }
+
+  static LabelValueType GetValue(const mitk::Image* image, int x, int y, int z)
+  {
+    mitk::ImagePixelReadAccessor<LabelValueType, 3> accessor(image);
+    itk::Index<3> index;
+    index[0] = x;
+    index[1] = y;
+    index[2] = z;
+    return accessor.GetPixelByIndex(index);
+  }
+
+  static unsigned int CountVoxels(const mitk::Image* image, LabelValueType value)
+  {
+    mitk::ImagePixelReadAccessor<LabelValueType, 3> accessor(image);
+    const auto numberOfVoxels = image->GetDimension(0) * image->GetDimension(1) * image->GetDimension(2);
+    return static_cast<unsigned int>(std::count(accessor.GetData(), accessor.GetData() + numberOfVoxels, value));
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[3] = { 20, 16, 8 };
+    m_ReferenceImage = mitk::Image::New();
+    m_ReferenceImage->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+
+    m_Converter = mitk::ContourModelSetsToLabelSetImageConverter::New();
+    m_Converter->SetReferenceImage(m_ReferenceImage);
+    m_Converter->SetMaximumNumberOfThreads(2);
+  }
+
+  void tearDown() override
+  {
+    m_ReferenceImage = nullptr;
+    m_Converter = nullptr;
+  }
+
+  void ConvertSeparateGroups()
+  {
+    m_Converter->SetContourModelSets({
+      CreateContourModelSet("Body", { CreateRectangle(1, 1, 10, 10, 2), CreateRectangle(1, 1, 10, 10, 3) }),
+      CreateContourModelSet("Organ", { CreateRectangle(4, 4, 6, 6, 3) }) });
+
+    auto result = m_Converter->Convert();
+
+    CPPUNIT_ASSERT_EQUAL(2u, result->GetNumberOfLayers());
+    CPPUNIT_ASSERT_EQUAL(std::string("Body"), result->GetLabel(1)->GetName());
+    CPPUNIT_ASSERT_EQUAL(std::string("Organ"), result->GetLabel(2)->GetName());
+
+    const auto bodyImage = result->GetGroupImage(0);
+    const auto organImage = result->GetGroupImage(1);
+
+    CPPUNIT_ASSERT_EQUAL(2u * 100u, CountVoxels(bodyImage, 1));
+    CPPUNIT_ASSERT_EQUAL(LabelValueType(1), GetValue(bodyImage, 5, 5, 3));
+    CPPUNIT_ASSERT_EQUAL(LabelValueType(0), GetValue(bodyImage, 5, 5, 4));
+    CPPUNIT_ASSERT_EQUAL(9u, CountVoxels(organImage, 2));
+    CPPUNIT_ASSERT_EQUAL(LabelValueType(2), GetValue(organImage, 5, 5, 3));
+
+    const auto& statistics = m_Converter->GetROIStatistics();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), statistics.size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), statistics[0].NumberOfContours);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), statistics[0].NumberOfSkippedContours);
+    CPPUNIT_ASSERT_EQUAL(LabelValueType(2), statistics[1].LabelValue);
+  }
+
+  void ConvertSingleGroup()
+  {
+    m_Converter->SeparateGroupsOff();
+    m_Converter->SetContourModelSets({
+      CreateContourModelSet("Body", { CreateRectangle(1, 1, 10, 10, 3) }),
+      CreateContourModelSet("Organ", { CreateRectangle(4, 4, 6, 6, 3) }) });
+
+    auto result = m_Converter->Convert();
+
+    CPPUNIT_ASSERT_EQUAL(1u, result->GetNumberOfLayers());
+    CPPUNIT_ASSERT_EQUAL(LabelValueType(2), GetValue(result, 5, 5, 3));
+    CPPUNIT_ASSERT_EQUAL(LabelValueType(1), GetValue(result, 2, 2, 3));
+    CPPUNIT_ASSERT_EQUAL(100u - 9u, CountVoxels(result, 1));
+  }
+
+  void ConvertWithHoles()
+  {
+    m_Converter->SetContourModelSets({
+      CreateContourModelSet("Ring", { CreateRectangle(0.5, 0.5, 10.5, 10.5, 3), CreateRectangle(3.5, 3.5, 6.5, 6.5, 3) }) });
+
+    auto result = m_Converter->Convert();
+
+    CPPUNIT_ASSERT_EQUAL(LabelValueType(1), GetValue(result, 1, 1, 3));
+    CPPUNIT_ASSERT_EQUAL(LabelValueType(0), GetValue(result, 5, 5, 3));
+    CPPUNIT_ASSERT_EQUAL(100u - 9u, CountVoxels(result, 1));
+  }
+
+  void ConvertSagittalContour()
+  {
+    auto contour = mitk::ContourModel::New();
+    const double coordinates[4][2] = { { 2, 1 }, { 5, 1 }, { 5, 4 }, { 2, 4 } };
+
+    for (const auto& coordinate : coordinates)
+    {
+      mitk::Point3D vertex;
+      vertex[0] = 7;
+      vertex[1] = coordinate[0];
+      vertex[2] = coordinate[1];
+      contour->AddVertex(vertex);
+    }
+
+    m_Converter->SetContourModelSets({ CreateContourModelSet("Sagittal", { contour }) });
+
+    auto result = m_Converter->Convert();
+
+    CPPUNIT_ASSERT_EQUAL(16u, CountVoxels(result, 1));
+    CPPUNIT_ASSERT_EQUAL(LabelValueType(1), GetValue(result, 7, 3, 2));
+    CPPUNIT_ASSERT_EQUAL(LabelValueType(0), GetValue(result, 6, 3, 2));
+  }
+
+  void SkipInvalidContours()
+  {
+    auto obliqueContour = CreateRectangle(1, 1, 5, 5, 2);
+    mitk::Point3D vertex;
+    vertex[0] = 3;
+    vertex[1] = 3;
+    vertex[2] = 5;
+    obliqueContour->AddVertex(vertex);
+
+    auto lineContour = mitk::ContourModel::New();
+    lineContour->AddVertex(vertex);
+    lineContour->AddVertex(vertex);
+
+    m_Converter->SetContourModelSets({ CreateContourModelSet("Invalid", { obliqueContour, lineContour, CreateRectangle(1, 1, 2, 2, 20) }) });
+
+    auto result = m_Converter->Convert();
+
+    CPPUNIT_ASSERT_EQUAL(0u, CountVoxels(result, 1));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), m_Converter->GetROIStatistics().front().NumberOfSkippedContours);
+  }
+
+  void ConvertWithoutReferenceImage()
+  {
+    m_Converter->SetReferenceImage(nullptr);
+    CPPUNIT_ASSERT_THROW(m_Converter->Convert(), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkContourModelSetsToLabelSetImageConverter)
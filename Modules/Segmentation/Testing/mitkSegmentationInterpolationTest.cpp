@@ -20,6 +20,8 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImagePixelReadAccessor.h>
 #include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkLabelSetImageConverter.h>
 #include <mitkSegmentationInterpolationController.h>
 #include <mitkSliceNavigationController.h>
 #include <mitkTool.h>
@@ -31,6 +33,7 @@ class mitkSegmentationInterpolationTestSuite : public mitk::TestFixture
   MITK_TEST(Equal_Axial_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Coronal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Sagittal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(Equal_LabelSetImage_TestInterpolationOfLabelAndOfLabelMask_ReturnsTrue);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -199,6 +202,55 @@ public:
     mitk::AnatomicalPlane viewDirection = mitk::AnatomicalPlane::Sagittal;
     testRoutine(viewDirection);
   }
+
+  void Equal_LabelSetImage_TestInterpolationOfLabelAndOfLabelMask_ReturnsTrue()
+  {
+    // 3x3 square in the axial slice below the center and a single pixel in the slice above
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Tool::DefaultSegmentationDataType, 3> writeAccessor(m_SegmentationImage);
+      itk::Index<3> currentPoint = m_CenterPoint;
+
+      currentPoint[2] = m_CenterPoint[2] - 1;
+      for (int i = -1; i <= 1; ++i)
+      {
+        for (int j = -1; j <= 1; ++j)
+        {
+          currentPoint[0] = m_CenterPoint[0] + i;
+          currentPoint[1] = m_CenterPoint[1] + j;
+          writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
+        }
+      }
+      currentPoint[2] = m_CenterPoint[2] + 1;
+      writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
+    }
+
+    auto labelSetImage = mitk::LabelSetImage::New();
+    labelSetImage->InitializeByLabeledImage(m_SegmentationImage);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), labelSetImage->GetLabelVoxelCount(1));
+
+    mitk::SliceNavigationController::Pointer navigationController = mitk::SliceNavigationController::New();
+    navigationController->SetInputWorldTimeGeometry(m_SegmentationImage->GetTimeGeometry());
+    navigationController->Update(mitk::AnatomicalPlane::Axial);
+    mitk::Point3D pointMM;
+    m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0)->IndexToWorld(m_CenterPoint, pointMM);
+    navigationController->SelectSliceByPoint(pointMM);
+    auto plane = navigationController->GetCurrentPlaneGeometry();
+
+    // whole volume scan of the mask
+    m_InterpolationController->SetSegmentationVolume(mitk::CreateLabelMask(labelSetImage, 1));
+    m_InterpolationController->SetReferenceVolume(m_ReferenceImage);
+    auto expectedResult = m_InterpolationController->Interpolate(2, m_CenterPoint[2], plane, 0);
+
+    // scan of the bounding box of the label only
+    m_InterpolationController->SetSegmentationVolume(labelSetImage, 1);
+    m_InterpolationController->SetReferenceVolume(m_ReferenceImage);
+    auto interpolationResult = m_InterpolationController->Interpolate(2, m_CenterPoint[2], plane, 0);
+
+    CPPUNIT_ASSERT(expectedResult.IsNotNull());
+    CPPUNIT_ASSERT(interpolationResult.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Interpolation of the label differs from the interpolation of its mask",
+                           mitk::Equal(*expectedResult, *interpolationResult, mitk::eps, true));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkSegmentationInterpolation)
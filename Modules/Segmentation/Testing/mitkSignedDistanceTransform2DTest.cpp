@@ -0,0 +1,122 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkSignedDistanceTransform2D.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+class mitkSignedDistanceTransform2DTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSignedDistanceTransform2DTestSuite);
+  MITK_TEST(TestSinglePixel);
+  MITK_TEST(TestRandomMasks);
+  MITK_TEST(TestUniformMasks);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  /** Brute force reference: distance to the nearest pixel on the other side minus half a pixel. */
+  static std::vector<mitk::ScalarType> ComputeReference(const std::vector<unsigned char> &mask, unsigned int width, unsigned int height)
+  {
+    std::vector<mitk::ScalarType> distances(mask.size());
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      for (unsigned int x = 0; x < width; ++x)
+      {
+        const bool inside = 0 != mask[y * width + x];
+        auto minimum = std::numeric_limits<mitk::ScalarType>::max();
+
+        for (unsigned int yy = 0; yy < height; ++yy)
+        {
+          for (unsigned int xx = 0; xx < width; ++xx)
+          {
+            if ((0 != mask[yy * width + xx]) != inside)
+              minimum = std::min(minimum, std::hypot(static_cast<mitk::ScalarType>(x) - xx, static_cast<mitk::ScalarType>(y) - yy));
+          }
+        }
+
+        const auto distance = std::min(minimum - 0.5, static_cast<mitk::ScalarType>(width + height));
+        distances[y * width + x] = inside ? -distance : distance;
+      }
+    }
+
+    return distances;
+  }
+
+public:
+  void TestSinglePixel()
+  {
+    const unsigned int width = 5;
+    const unsigned int height = 5;
+    std::vector<unsigned char> mask(width * height, 0);
+    mask[2 * width + 2] = 1;
+
+    std::vector<mitk::ScalarType> distances(mask.size());
+    mitk::SignedDistanceTransform2D::Compute(mask.data(), width, height, distances.data());
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-0.5, distances[2 * width + 2], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, distances[2 * width + 3], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sqrt(2.0) - 0.5, distances[1 * width + 1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sqrt(8.0) - 0.5, distances[0], mitk::eps);
+  }
+
+  void TestRandomMasks()
+  {
+    std::mt19937 generator(42);
+
+    for (int run = 0; run < 50; ++run)
+    {
+      const unsigned int width = 1 + generator() % 20;
+      const unsigned int height = 1 + generator() % 20;
+      std::bernoulli_distribution isInside(0.05 + 0.9 * (run / 50.0));
+
+      std::vector<unsigned char> mask(width * height);
+      for (auto &pixel : mask)
+        pixel = isInside(generator) ? 1 : 0;
+
+      std::vector<mitk::ScalarType> distances(mask.size());
+      mitk::SignedDistanceTransform2D::Compute(mask.data(), width, height, distances.data());
+
+      const auto reference = ComputeReference(mask, width, height);
+
+      for (std::size_t i = 0; i < mask.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(reference[i], distances[i], 1e-5);
+    }
+  }
+
+  void TestUniformMasks()
+  {
+    const unsigned int width = 4;
+    const unsigned int height = 3;
+    std::vector<mitk::ScalarType> distances(width * height);
+
+    std::vector<unsigned char> empty(width * height, 0);
+    mitk::SignedDistanceTransform2D::Compute(empty.data(), width, height, distances.data());
+
+    for (auto distance : distances)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(static_cast<mitk::ScalarType>(width + height), distance, mitk::eps);
+
+    std::vector<unsigned char> full(width * height, 1);
+    mitk::SignedDistanceTransform2D::Compute(full.data(), width, height, distances.data());
+
+    for (auto distance : distances)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(-static_cast<mitk::ScalarType>(width + height), distance, mitk::eps);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSignedDistanceTransform2D)
@@ -0,0 +1,342 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkSparseSliceDiff.h>
+
+#include <mitkDiffSliceOperation.h>
+#include <mitkDiffSliceOperationApplier.h>
+#include <mitkExtractSliceFilter.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkSegTool2D.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+#include <mitkUndoController.h>
+#include <mitkVtkImageOverwrite.h>
+
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+class mitkSparseSliceDiffTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSparseSliceDiffTestSuite);
+  MITK_TEST(TestRuns);
+  MITK_TEST(TestWriteAndRevert);
+  MITK_TEST(TestEqualSlices);
+  MITK_TEST(TestImageSlices);
+  MITK_TEST(TestUnsupportedSlices);
+  MITK_TEST(TestUndoRedoRoundTrip);
+  MITK_TEST(TestWriteSlicesToVolumeUndoRedo);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  using ValueType = mitk::SparseSliceDiff::ValueType;
+
+  /** Gives access to the protected slice writing of SegTool2D.*/
+  struct SegTool2DAccess : public mitk::SegTool2D
+  {
+    using mitk::SegTool2D::SliceInformation;
+    using mitk::SegTool2D::WriteSlicesToVolume;
+  };
+
+  static constexpr unsigned int Width = 8;
+  static constexpr unsigned int Height = 4;
+
+  std::vector<ValueType> m_OldSlice;
+  std::vector<ValueType> m_NewSlice;
+
+  mitk::Image::Pointer CreateSlice(const std::vector<ValueType>& buffer)
+  {
+    unsigned int dimensions[] = { Width, Height };
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<ValueType>(), 2, dimensions);
+
+    mitk::ImageWriteAccessor accessor(image);
+    std::copy(buffer.begin(), buffer.end(), static_cast<ValueType*>(accessor.GetData()));
+
+    return image;
+  }
+
+  /** Writes the slice into the volume the same way SegTool2D does and returns the extent of the written slice.*/
+  static std::array<int, 6> WriteSlice(mitk::Image* volume, const mitk::PlaneGeometry* plane, mitk::Image* slice)
+  {
+    auto reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    reslice->SetInputSlice(slice->GetVtkImageData());
+    reslice->SetOverwriteMode(true);
+    reslice->Modified();
+
+    auto extractor = mitk::ExtractSliceFilter::New(reslice);
+    extractor->SetInput(volume);
+    extractor->SetTimeStep(0);
+    extractor->SetWorldGeometry(plane);
+    extractor->SetVtkOutputRequest(false);
+    extractor->SetResliceTransformByGeometry(volume->GetGeometry(0));
+    extractor->Modified();
+    extractor->Update();
+
+    std::array<int, 6> extent;
+    reslice->GetOutputExtent(extent.data());
+    return extent;
+  }
+
+  static std::vector<ValueType> GetSlice(const mitk::Image* volume, const mitk::PlaneGeometry* plane)
+  {
+    auto slice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, volume, 0);
+    CPPUNIT_ASSERT(slice.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(Width, slice->GetDimension(0));
+    CPPUNIT_ASSERT_EQUAL(Height, slice->GetDimension(1));
+
+    mitk::ImageReadAccessor accessor(slice);
+    const auto* values = static_cast<const ValueType*>(accessor.GetData());
+    return std::vector<ValueType>(values, values + Width * Height);
+  }
+
+  /** Returns the axial plane through the voxel centers of slice z of the volume (spacing 1).*/
+  static mitk::PlaneGeometry::Pointer CreateAxialPlane(const mitk::Image* volume, unsigned int z)
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(volume->GetGeometry(), mitk::AnatomicalPlane::Axial, z, true, false);
+    auto normal = plane->GetNormal();
+    normal.Normalize();
+    auto origin = plane->GetOrigin();
+    origin += normal * 0.5;
+    plane->SetOrigin(origin);
+    return plane;
+  }
+
+  /** Label volume of three slices filled with value.*/
+  static mitk::LabelSetImage::Pointer CreateVolume(ValueType value)
+  {
+    unsigned int dimensions[] = { Width, Height, 3 };
+    auto referenceImage = mitk::Image::New();
+    referenceImage->Initialize(mitk::MakeScalarPixelType<ValueType>(), 3, dimensions);
+
+    auto volume = mitk::LabelSetImage::New();
+    volume->Initialize(referenceImage);
+    {
+      mitk::ImageWriteAccessor accessor(volume);
+      auto* values = static_cast<ValueType*>(accessor.GetData());
+      std::fill(values, values + 3 * Width * Height, value);
+    }
+    volume->Modified();
+
+    return volume;
+  }
+
+  static bool IsFilled(const mitk::Image* volume, unsigned int z, ValueType value)
+  {
+    mitk::ImageReadAccessor accessor(volume);
+    const auto* values = static_cast<const ValueType*>(accessor.GetData()) + z * Width * Height;
+    return std::all_of(values, values + Width * Height, [value](ValueType v) { return v == value; });
+  }
+
+public:
+  void setUp() override
+  {
+    m_OldSlice.assign(Width * Height, 0);
+    m_OldSlice[Width + 4] = 2;
+    m_OldSlice[Width + 5] = 2;
+
+    // row 1: label 1 painted over the background (run of 3) and over label 2 (run of 2)
+    m_NewSlice = m_OldSlice;
+    for (unsigned int x = 1; x < 6; ++x)
+      m_NewSlice[Width + x] = 1;
+
+    // row 3: erased pixel at the row end
+    m_OldSlice[3 * Width + 7] = 1;
+  }
+
+  void tearDown() override
+  {
+    m_OldSlice.clear();
+    m_NewSlice.clear();
+  }
+
+  void TestRuns()
+  {
+    mitk::SparseSliceDiff diff(m_OldSlice.data(), m_NewSlice.data(), Width, Height);
+
+    CPPUNIT_ASSERT(!diff.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(6), diff.GetNumberOfChangedPixels());
+
+    const auto& runs = diff.GetRuns();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), runs.size());
+
+    CPPUNIT_ASSERT_EQUAL(1u, runs[0].Row);
+    CPPUNIT_ASSERT_EQUAL(1u, runs[0].Begin);
+    CPPUNIT_ASSERT_EQUAL(3u, runs[0].Length);
+    CPPUNIT_ASSERT_EQUAL(ValueType(0), runs[0].OldValue);
+    CPPUNIT_ASSERT_EQUAL(ValueType(1), runs[0].NewValue);
+
+    CPPUNIT_ASSERT_EQUAL(4u, runs[1].Begin);
+    CPPUNIT_ASSERT_EQUAL(2u, runs[1].Length);
+    CPPUNIT_ASSERT_EQUAL(ValueType(2), runs[1].OldValue);
+
+    CPPUNIT_ASSERT_EQUAL(3u, runs[2].Row);
+    CPPUNIT_ASSERT_EQUAL(7u, runs[2].Begin);
+    CPPUNIT_ASSERT_EQUAL(ValueType(0), runs[2].NewValue);
+
+    CPPUNIT_ASSERT(diff.GetMemorySize() < Width * Height * sizeof(ValueType) + sizeof(diff));
+  }
+
+  void TestWriteAndRevert()
+  {
+    mitk::SparseSliceDiff diff(m_OldSlice.data(), m_NewSlice.data(), Width, Height);
+
+    auto buffer = m_OldSlice;
+    diff.Write(buffer.data(), false);
+    CPPUNIT_ASSERT_MESSAGE("Redo does not reproduce the new slice", buffer == m_NewSlice);
+
+    diff.Write(buffer.data(), true);
+    CPPUNIT_ASSERT_MESSAGE("Undo does not reproduce the old slice", buffer == m_OldSlice);
+  }
+
+  void TestEqualSlices()
+  {
+    mitk::SparseSliceDiff diff(m_OldSlice.data(), m_OldSlice.data(), Width, Height);
+
+    CPPUNIT_ASSERT(diff.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), diff.GetNumberOfChangedPixels());
+  }
+
+  void TestImageSlices()
+  {
+    auto oldSlice = this->CreateSlice(m_OldSlice);
+    auto newSlice = this->CreateSlice(m_NewSlice);
+
+    CPPUNIT_ASSERT(mitk::SparseSliceDiff::IsSupported(oldSlice));
+
+    mitk::SparseSliceDiff diff(oldSlice, newSlice);
+    CPPUNIT_ASSERT_EQUAL(Width, diff.GetWidth());
+    CPPUNIT_ASSERT_EQUAL(Height, diff.GetHeight());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), diff.GetRuns().size());
+  }
+
+  void TestUnsupportedSlices()
+  {
+    unsigned int dimensions[] = { Width, Height };
+    auto floatSlice = mitk::Image::New();
+    floatSlice->Initialize(mitk::MakeScalarPixelType<float>(), 2, dimensions);
+
+    CPPUNIT_ASSERT(!mitk::SparseSliceDiff::IsSupported(floatSlice));
+    CPPUNIT_ASSERT(!mitk::SparseSliceDiff::IsSupported(nullptr));
+
+    auto slice = this->CreateSlice(m_OldSlice);
+    CPPUNIT_ASSERT_THROW(mitk::SparseSliceDiff(slice, floatSlice), mitk::Exception);
+  }
+
+  void TestUndoRedoRoundTrip()
+  {
+    // label volume of three slices filled with label 3, the edit is applied to the middle one
+    auto volume = CreateVolume(3);
+    auto plane = CreateAxialPlane(volume, 1);
+
+    this->WriteSlice(volume, plane, this->CreateSlice(m_OldSlice));
+    CPPUNIT_ASSERT(GetSlice(volume, plane) == m_OldSlice);
+
+    // edit as done by SegTool2D: keep the difference and the extent of the written slice
+    auto oldSlice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, volume, 0);
+    auto newSlice = this->CreateSlice(m_NewSlice);
+    auto diff = std::make_shared<const mitk::SparseSliceDiff>(oldSlice, newSlice);
+    const auto extent = this->WriteSlice(volume, plane, newSlice);
+    CPPUNIT_ASSERT(GetSlice(volume, plane) == m_NewSlice);
+
+    std::unique_ptr<mitk::Operation> undoOperation(new mitk::DiffSliceOperation(volume, diff, true, extent, 0, plane));
+    std::unique_ptr<mitk::Operation> doOperation(new mitk::DiffSliceOperation(volume, diff, false, extent, 0, plane));
+    auto* applier = mitk::DiffSliceOperationApplier::GetInstance();
+
+    applier->ExecuteOperation(undoOperation.get());
+    CPPUNIT_ASSERT_MESSAGE("Undo does not restore the old slice", GetSlice(volume, plane) == m_OldSlice);
+
+    applier->ExecuteOperation(doOperation.get());
+    CPPUNIT_ASSERT_MESSAGE("Redo does not restore the new slice", GetSlice(volume, plane) == m_NewSlice);
+
+    // only the changed pixels are written, a later change of an untouched pixel survives the undo
+    auto editedSlice = m_NewSlice;
+    editedSlice[0] = 5;
+    this->WriteSlice(volume, plane, this->CreateSlice(editedSlice));
+
+    applier->ExecuteOperation(undoOperation.get());
+    auto expectedSlice = m_OldSlice;
+    expectedSlice[0] = 5;
+    CPPUNIT_ASSERT_MESSAGE("Undo overwrites pixels that are not part of the difference", GetSlice(volume, plane) == expectedSlice);
+
+    // the neighboring slices are not touched
+    CPPUNIT_ASSERT(IsFilled(volume, 0, 3));
+    CPPUNIT_ASSERT(IsFilled(volume, 2, 3));
+  }
+
+  void TestWriteSlicesToVolumeUndoRedo()
+  {
+    mitk::UndoController undoController;
+    auto* undoModel = mitk::UndoController::GetCurrentUndoModel();
+    undoModel->Clear();
+
+    auto volume = CreateVolume(0);
+    std::vector<mitk::PlaneGeometry::Pointer> planes = { CreateAxialPlane(volume, 0), CreateAxialPlane(volume, 1), CreateAxialPlane(volume, 2) };
+    auto newSlice = this->CreateSlice(m_NewSlice);
+    auto emptySlice = this->CreateSlice(std::vector<ValueType>(Width * Height, 0));
+
+    // disjoint slices are written concurrently
+    std::vector<SegTool2DAccess::SliceInformation> disjointSlices = {
+      SegTool2DAccess::SliceInformation(newSlice, planes[0], 0),
+      SegTool2DAccess::SliceInformation(newSlice, planes[2], 0) };
+    SegTool2DAccess::WriteSlicesToVolume(volume, disjointSlices, true);
+
+    CPPUNIT_ASSERT(GetSlice(volume, planes[0]) == m_NewSlice);
+    CPPUNIT_ASSERT(IsFilled(volume, 1, 0));
+    CPPUNIT_ASSERT(GetSlice(volume, planes[2]) == m_NewSlice);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), volume->GetLabelVoxelCount(1));
+
+    // overlapping slices are written in the given order, thus the middle slice ends up empty
+    std::vector<SegTool2DAccess::SliceInformation> overlappingSlices = {
+      SegTool2DAccess::SliceInformation(newSlice, planes[1], 0),
+      SegTool2DAccess::SliceInformation(emptySlice, planes[1], 0),
+      SegTool2DAccess::SliceInformation(emptySlice, planes[2], 0) };
+    SegTool2DAccess::WriteSlicesToVolume(volume, overlappingSlices, true);
+
+    CPPUNIT_ASSERT(GetSlice(volume, planes[0]) == m_NewSlice);
+    CPPUNIT_ASSERT(IsFilled(volume, 1, 0));
+    CPPUNIT_ASSERT(IsFilled(volume, 2, 0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), volume->GetLabelVoxelCount(1));
+
+    // every call is undone and redone as one step
+    CPPUNIT_ASSERT(undoModel->Undo());
+    CPPUNIT_ASSERT_MESSAGE("Undo of overlapping slices does not restore the volume",
+      GetSlice(volume, planes[0]) == m_NewSlice && IsFilled(volume, 1, 0) && GetSlice(volume, planes[2]) == m_NewSlice);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), volume->GetLabelVoxelCount(1));
+
+    CPPUNIT_ASSERT(undoModel->Undo());
+    CPPUNIT_ASSERT_MESSAGE("Undo of disjoint slices does not restore the volume",
+      IsFilled(volume, 0, 0) && IsFilled(volume, 1, 0) && IsFilled(volume, 2, 0));
+    CPPUNIT_ASSERT(volume->IsLabelEmpty(1));
+
+    CPPUNIT_ASSERT(undoModel->Redo());
+    CPPUNIT_ASSERT_MESSAGE("Redo of disjoint slices does not restore the volume",
+      GetSlice(volume, planes[0]) == m_NewSlice && IsFilled(volume, 1, 0) && GetSlice(volume, planes[2]) == m_NewSlice);
+
+    CPPUNIT_ASSERT(undoModel->Redo());
+    CPPUNIT_ASSERT_MESSAGE("Redo of overlapping slices does not restore the volume",
+      GetSlice(volume, planes[0]) == m_NewSlice && IsFilled(volume, 1, 0) && IsFilled(volume, 2, 0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), volume->GetLabelVoxelCount(1));
+
+    undoModel->Clear();
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSparseSliceDiff)
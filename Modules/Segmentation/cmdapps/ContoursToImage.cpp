@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include <mitkCommandLineParser.h>
 #include <mitkContourModelSet.h>
 #include <mitkContourModelSetToImageFilter.h>
+#include <mitkContourModelSetsToLabelSetImageConverter.h>
 #include <mitkDataStorage.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkImageWriteAccessor.h>
@@ -115,10 +116,10 @@ bool SetLabelColor(const mitk::IPropertyProvider* propertyProvider, mitk::Label*
   return false;
 }
 
-void CopyImageToActiveLayerImage(const mitk::Image* image, mitk::LabelSetImage* labelSetImage)
+void CopyImageData(const mitk::Image* image, mitk::Image* targetImage)
 {
   mitk::ImageReadAccessor readAccessor(image);
-  mitk::ImageWriteAccessor writeAccessor(labelSetImage);
+  mitk::ImageWriteAccessor writeAccessor(targetImage);
 
   auto size = sizeof(mitk::Label::PixelType);
 
@@ -149,6 +150,19 @@ OutputFormat ParseOutputFormat(const mitk::IFileIO::Options& args)
   return OutputFormat::Binary;
 }
 
+mitk::Image::Pointer ConvertContourModelSetToImage(mitk::ContourModelSet* input, const mitk::Image* referenceImage, bool labelPixelType, mitk::LabelSetImage::LabelValueType labelValue)
+{
+  auto filter = mitk::ContourModelSetToImageFilter::New();
+  filter->SetMakeOutputLabelPixelType(labelPixelType);
+  filter->SetPaintingPixelValue(labelValue);
+  filter->SetImage(referenceImage);
+  filter->SetInput(input);
+
+  filter->Update();
+
+  return filter->GetOutput();
+}
+
 std::vector<mitk::ContourModelSet::Pointer> FilterValidInputs(const std::vector<mitk::BaseData::Pointer>& inputs)
 {
   std::vector<mitk::ContourModelSet::Pointer> validInputs;
@@ -202,16 +216,58 @@ int main(int argc, char* argv[])
     fs::path outputPath(outputFilename);
     CreateParentDirectories(outputPath);
 
-    mitk::LabelSetImage::Pointer labelSetImage; // Only used for "multilabel" output
+    // For "multilabel" output, all contour sets are rasterized at once (each one into its own group).
+
+    if (format == OutputFormat::Multilabel)
+    {
+      auto converter = mitk::ContourModelSetsToLabelSetImageConverter::New();
+      converter->SetReferenceImage(referenceImage);
+      converter->SetContourModelSets(mitk::ContourModelSetsToLabelSetImageConverter::ContourModelSetVectorType(inputs.begin(), inputs.end()));
+
+      auto labelSetImage = converter->Convert();
+      const auto& roiStatistics = converter->GetROIStatistics();
+
+      for (size_t i = 0; i < roiStatistics.size(); ++i)
+      {
+        const auto& statistics = roiStatistics[i];
+        MITK_INFO << "Creating label: " << statistics.Name << " [" << statistics.LabelValue << ']';
+
+        // The converter skips contours that do not lie in a slice of the reference image (e.g. oblique contours).
+        // Such contour sets are rasterized again by the slower, but general ContourModelSetToImageFilter, which
+        // replaces the content of the label's group.
+
+        if (0 == statistics.NumberOfSkippedContours)
+          continue;
+
+        MITK_INFO << "Falling back to slice-wise conversion of label: " << statistics.Name << " [" << statistics.LabelValue << ']';
+
+        auto image = ConvertContourModelSetToImage(inputs[i], referenceImage, true, statistics.LabelValue);
+
+        if (image.IsNull())
+        {
+          MITK_ERROR << "Contour set to image conversion failed without exception. Continue with next contour set... ";
+          returnValue = EXIT_FAILURE;
+          continue;
+        }
+
+        auto groupImage = labelSetImage->GetGroupImage(labelSetImage->GetGroupIndexOfLabel(statistics.LabelValue));
+        CopyImageData(image, groupImage);
+        groupImage->Modified();
+      }
+
+      mitk::IOUtil::Save(labelSetImage, outputPath.string());
+      return returnValue;
+    }
+
     unsigned int nonameCounter = 0; // Helper variable to generate placeholder names for nameless contour sets
 
     for (auto input : inputs)
     {
-      // If the input file contains multiple contour sets but the output format is not set to "multilabel",
-      // we create separate output files for each contour set. In this case the specified output filename
-      // is used only as a base filename and the names of the individual contour sets are appended accordingly.
+      // If the input file contains multiple contour sets, we create separate output files for each contour
+      // set. In this case the specified output filename is used only as a base filename and the names of the
+      // individual contour sets are appended accordingly.
 
-      if (inputs.size() > 1 && format != OutputFormat::Multilabel)
+      if (inputs.size() > 1)
       {
         outputPath = outputFilename;
         auto name = GetSafeName(input);
@@ -225,22 +281,10 @@ int main(int argc, char* argv[])
       // Do the actual conversion from a contour set to an image with a background pixel value of 0.
       // - For "binary" output, use pixel value 1 and unsigned char as pixel type.
       // - For "label" output, use pixel value 1 and our label pixel type.
-      // - For "multilabel" output, use the next available label value instead.
 
-      const auto labelValue = labelSetImage.IsNotNull()
-        ? labelSetImage->GetUnusedLabelValue()
-        : 1;
+      const mitk::LabelSetImage::LabelValueType labelValue = 1;
 
-      auto filter = mitk::ContourModelSetToImageFilter::New();
-      filter->SetMakeOutputLabelPixelType(format != OutputFormat::Binary);
-      filter->SetPaintingPixelValue(labelValue);
-      filter->SetImage(referenceImage);
-      filter->SetInput(input);
-
-      filter->Update();
-
-      mitk::Image::Pointer image = filter->GetOutput();
-      filter = nullptr;
+      auto image = ConvertContourModelSetToImage(input, referenceImage, format != OutputFormat::Binary, labelValue);
 
       if (image.IsNull())
       {
@@ -255,17 +299,10 @@ int main(int argc, char* argv[])
       }
       else
       {
-        if (labelSetImage.IsNull())
-        {
-          labelSetImage = mitk::LabelSetImage::New();
-          labelSetImage->Initialize(image);
+        auto labelSetImage = mitk::LabelSetImage::New();
+        labelSetImage->Initialize(image);
 
-          CopyImageToActiveLayerImage(image, labelSetImage);
-        }
-        else
-        {
-          labelSetImage->AddLayer(image);
-        }
+        CopyImageData(image, labelSetImage);
 
         auto label = mitk::LabelSetImageHelper::CreateNewLabel(labelSetImage);
         label->SetValue(labelValue);
@@ -273,25 +310,11 @@ int main(int argc, char* argv[])
         SetLabelName(input, label);
         SetLabelColor(input, label);
 
-        if (format == OutputFormat::Multilabel)
-          MITK_INFO << "Creating label: " << label->GetName() << " [" << labelValue << ']';
-
         labelSetImage->AddLabel(label, labelSetImage->GetActiveLayer(), false, false);
 
-        if (format == OutputFormat::Label)
-        {
-          mitk::IOUtil::Save(labelSetImage, outputPath.string());
-          labelSetImage = nullptr;
-        }
+        mitk::IOUtil::Save(labelSetImage, outputPath.string());
       }
     }
-
-    // In case of the "multilabel" output format, eventually save the single output file.
-    // For all other output formats, the output file(s) have been saved already while iterating
-    // over the inputs.
-
-    if (labelSetImage.IsNotNull())
-      mitk::IOUtil::Save(labelSetImage, outputPath.string());
   }
   catch (const mitk::Exception& e)
   {
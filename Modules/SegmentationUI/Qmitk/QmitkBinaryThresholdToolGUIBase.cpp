@@ -108,6 +108,16 @@ void QmitkBinaryThresholdToolGUIBase::OnThresholdSliderChanged(double value)
   }
 }
 
+void QmitkBinaryThresholdToolGUIBase::OnSlicePreviewToggled(bool checked)
+{
+  auto tool = this->GetConnectedToolAs<mitk::BinaryThresholdBaseTool>();
+
+  if (nullptr != tool)
+  {
+    tool->SetSlicePreview(checked);
+  }
+}
+
 void QmitkBinaryThresholdToolGUIBase::DisconnectOldTool(mitk::SegWithPreviewTool* oldTool)
 {
   Superclass::DisconnectOldTool(oldTool);
@@ -139,6 +149,8 @@ void QmitkBinaryThresholdToolGUIBase::ConnectNewTool(mitk::SegWithPreviewTool* n
     tool->ThresholdingValuesChanged +=
       mitk::MessageDelegate2<QmitkBinaryThresholdToolGUIBase, mitk::ScalarType, mitk::ScalarType>(
         this, &QmitkBinaryThresholdToolGUIBase::OnThresholdingValuesChanged);
+
+    tool->SetSlicePreview(m_CheckSlicePreview->isChecked());
   }
 }
 
@@ -174,6 +186,12 @@ void QmitkBinaryThresholdToolGUIBase::InitializeUI(QBoxLayout* mainLayout)
 
   mainLayout->addLayout(layout);
 
+  m_CheckSlicePreview = new QCheckBox("Fast slice preview", this);
+  m_CheckSlicePreview->setChecked(false);
+  m_CheckSlicePreview->setToolTip("If checked, changing the threshold only updates the visible slices. The whole image is thresholded when the segmentation is confirmed. Recommended for large images.");
+  connect(m_CheckSlicePreview, &QCheckBox::toggled, this, &QmitkBinaryThresholdToolGUIBase::OnSlicePreviewToggled);
+  mainLayout->addWidget(m_CheckSlicePreview);
+
   Superclass::InitializeUI(mainLayout);
 }
 
@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include "ctkRangeWidget.h"
 #include "ctkSliderWidget.h"
 
+#include <QCheckBox>
+
 #include <MitkSegmentationUIExports.h>
 
 /**
@@ -39,6 +41,7 @@ protected slots:
 
   void OnThresholdRangeChanged(double min, double max);
   void OnThresholdSliderChanged(double value);
+  void OnSlicePreviewToggled(bool checked);
 
 protected:
   QmitkBinaryThresholdToolGUIBase(bool ulMode);
@@ -52,6 +55,7 @@ protected:
 
   ctkRangeWidget* m_ThresholdRange = nullptr;
   ctkSliderWidget* m_ThresholdSlider = nullptr;
+  QCheckBox* m_CheckSlicePreview = nullptr;
 
   /** Indicates if the tool UI is used for a tool with upper an lower threshold (true)
   or only with one threshold (false)*/
@@ -18,6 +18,8 @@ found in the LICENSE file.
 #include <qlabel.h>
 #include <QApplication>
 
+#include <QtWidgetsExtRegisterClasses.h>
+
 bool DefaultEnableConfirmSegBtnFunction(bool enabled)
 {
   return enabled;
@@ -115,6 +117,7 @@ void QmitkSegWithPreviewToolGUIBase::OnAcceptPreview()
 void QmitkSegWithPreviewToolGUIBase::DisconnectOldTool(mitk::SegWithPreviewTool* oldTool)
 {
   oldTool->CurrentlyBusy -= mitk::MessageDelegate1<QmitkSegWithPreviewToolGUIBase, bool>(this, &QmitkSegWithPreviewToolGUIBase::BusyStateChanged);
+  oldTool->SetAsynchronousPreview(false);
 }
 
 void QmitkSegWithPreviewToolGUIBase::ConnectNewTool(mitk::SegWithPreviewTool* newTool)
@@ -124,6 +127,11 @@ void QmitkSegWithPreviewToolGUIBase::ConnectNewTool(mitk::SegWithPreviewTool* ne
 
   m_CheckProcessAll->setVisible(newTool->GetTargetSegmentationNode()->GetData()->GetTimeSteps() > 1);
 
+  // Keeps the GUI responsive while the preview is computed. Results are published via
+  // mitk::CallbackFromGUIThread, thus ensure the Qt implementation is registered.
+  QtWidgetsExtRegisterClasses();
+  newTool->SetAsynchronousPreview(newTool->SupportsAsynchronousPreview());
+
   this->EnableWidgets(true);
 }
 
@@ -36,6 +36,7 @@ InternalJob::InternalJob(const QString& name)
   , sptr_monitor(nullptr)
   , m_startTime()
   , waitQueueStamp(T_NONE)
+  , m_queuedTime()
   , ptr_thread(nullptr)
 {
   jobEvents.SetExceptionHandler(MessageExceptionHandler<JobListeners>(&ptr_manager->m_JobListeners, &JobListeners::HandleException));
@@ -438,6 +438,12 @@ private:
    */
   Poco::Timestamp waitQueueStamp;
 
+  /**
+   * Time the job was last added to the wait queue. Used by the job manager
+   * to measure how long jobs wait for a worker.
+   */
+  Poco::Timestamp m_queuedTime;
+
   /*
    * The that is currently running this job
    */
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "berryNullProgressMonitor.h"
 #include "berryIStatus.h"
 #include "berryJobStatus.h"
+#include "berryLog.h"
 
 #include <iostream>
 #include <algorithm>
@@ -46,7 +47,8 @@ bool NullRule::Contains(ISchedulingRule::Pointer dummyRule) const
 
 JobManager::JobManager() :
   sptr_testRule(new NullRule()),m_active(true), m_Pool(new WorkerPool(this)), m_sptr_progressProvider(nullptr),
-      m_JobQueueSleeping(true), m_JobQueueWaiting(false),m_suspended(false), m_waitQueueCounter(0)
+      m_JobQueueSleeping(true), m_JobQueueWaiting(false),m_suspended(false), m_waitQueueCounter(0),
+      m_statistics()
 
 {
   m_JobListeners.global.SetExceptionHandler(MessageExceptionHandler<
@@ -181,14 +183,16 @@ bool JobManager::IsIdle()
   }
 }
 
+JobManager::Statistics JobManager::GetStatistics()
+{
+  Poco::ScopedLock<Poco::Mutex> m_managerLock(m_mutex);
+  return m_statistics;
+}
+
 bool JobManager::IsSuspended()
 {
-  {
-    Poco::ScopedLock<Poco::Mutex> m_managerLock(m_mutex);
-    m_suspended = true;
-  }
+  Poco::ScopedLock<Poco::Mutex> m_managerLock(m_mutex);
   return m_suspended;
-
 }
 //
 //    /*
@@ -315,9 +319,9 @@ void JobManager::Resume()
   {
     Poco::ScopedLock<Poco::Mutex> lockMe(m_mutex);
     m_suspended = false;
-    //poke the job pool
-    m_Pool->JobQueued();
   }
+  //poke the job pool outside sync block to avoid deadlock
+  m_Pool->JobQueued();
 }
 
 //TODO implicit Jobs
@@ -449,6 +453,7 @@ void JobManager::ChangeState(InternalJob::Pointer sptr_job, int newState)
       break;
     case Job::WAITING:
       m_JobQueueWaiting.Remove(sptr_job);
+      --m_statistics.waitingJobs;
 
       // assert(false, "Tried to remove a job that wasn't in the queue");
       break;
@@ -485,6 +490,10 @@ void JobManager::ChangeState(InternalJob::Pointer sptr_job, int newState)
       break;
     case Job::WAITING:
       m_JobQueueWaiting.Enqueue(sptr_job);
+      //blocked jobs keep the time they were first queued
+      if (tmp_oldState != InternalJob::BLOCKED)
+        sptr_job->m_queuedTime.update();
+      m_statistics.maxWaitingJobs = std::max(m_statistics.maxWaitingJobs, ++m_statistics.waitingJobs);
       break;
     case Job::SLEEPING:
       //try {
@@ -553,13 +562,13 @@ void JobManager::DoSchedule(InternalJob::Pointer job,
   }
   if (delay > 0)
   {
-    job->SetStartTime(Poco::Timestamp() + delay * 100);
+    job->SetStartTime(Poco::Timestamp() + delay * 1000);
     InternalJob::Pointer sptr_job(job);
     ChangeState(sptr_job, Job::SLEEPING);
   }
   else
   {
-    job->SetStartTime(Poco::Timestamp() + DelayFor(job->GetPriority()) * 100);
+    job->SetStartTime(Poco::Timestamp() + DelayFor(job->GetPriority()) * 1000);
     job->SetWaitQueueStamp(m_waitQueueCounter++);
     InternalJob::Pointer sptr_job(job);
     ChangeState(sptr_job, Job::WAITING);
@@ -580,6 +589,7 @@ void JobManager::DoShutdown()
       //clean up
       m_JobQueueSleeping.Clear();
       m_JobQueueWaiting.Clear();
+      m_statistics.waitingJobs = 0;
       m_running.clear();
     }
   }
@@ -662,7 +672,7 @@ Job::Pointer JobManager::NextJob()
     while (ptr_job != 0 && ptr_job->GetStartTime() < now)
     {
       // a job that slept to long is set a new start time and is put into the waiting queue
-      ptr_job->SetStartTime(now + DelayFor(ptr_job->GetPriority()));
+      ptr_job->SetStartTime(now + DelayFor(ptr_job->GetPriority()) * 1000);
       ptr_job->SetWaitQueueStamp(m_waitQueueCounter++);
       InternalJob::Pointer sptr_job(ptr_job);
       ChangeState(sptr_job, Job::WAITING);
@@ -1094,7 +1104,7 @@ void JobManager::SetPriority(InternalJob::Pointer job, int newPriority)
     if (sptr_job->GetState() == Job::WAITING)
     {
       Poco::Timestamp oldStart = job->GetStartTime();
-      job->SetStartTime(oldStart += (DelayFor(newPriority) - DelayFor(oldPriority)));
+      job->SetStartTime(oldStart += (DelayFor(newPriority) - DelayFor(oldPriority)) * 1000);
       m_JobQueueWaiting.Resort(job);
     }
   }
@@ -1125,6 +1135,7 @@ Poco::Timespan::TimeDiff JobManager::SleepHint()
 Job::Pointer JobManager::StartJob()
 {
   Job::Pointer job(nullptr);
+  Poco::Timestamp::TimeDiff waitTime = 0;
   while (true)
   {
     job = NextJob();
@@ -1147,6 +1158,10 @@ Job::Pointer JobManager::StartJob()
           internal->SetProgressMonitor(CreateMonitor(job));
           //change from ABOUT_TO_RUN to RUNNING
           internal->InternalSetState(Job::RUNNING);
+          waitTime = Poco::Timestamp() - internal->m_queuedTime;
+          ++m_statistics.startedJobs;
+          m_statistics.totalWaitTime += waitTime;
+          m_statistics.maxWaitTime = std::max(m_statistics.maxWaitTime, waitTime);
           break;
         }
         internal->SetAboutToRunCanceled(false);
@@ -1161,6 +1176,8 @@ Job::Pointer JobManager::StartJob()
       continue;
     }
   }
+  if (DEBUG_TIMING)
+    BERRY_INFO << "Starting job " << job->GetName() << " after waiting " << waitTime / 1000 << " ms";
   m_JobListeners.Running(job);
   return job;
 }
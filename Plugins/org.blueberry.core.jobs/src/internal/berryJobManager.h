@@ -120,6 +120,28 @@ public:
 
   bool IsSuspended() override;
 
+  /**
+   * Scheduling statistics for diagnosing job throughput. Wait times are
+   * measured from the time a job is added to the wait queue until a worker
+   * starts running it, in microseconds.
+   */
+  struct Statistics
+  {
+    /** Number of jobs currently in the wait queue */
+    int waitingJobs;
+    /** Largest number of jobs which have been in the wait queue at once */
+    int maxWaitingJobs;
+    /** Number of jobs started by worker threads */
+    long long startedJobs;
+    Poco::Timestamp::TimeDiff totalWaitTime;
+    Poco::Timestamp::TimeDiff maxWaitTime;
+  };
+
+  /**
+   * Returns a snapshot of the scheduling statistics.
+   */
+  Statistics GetStatistics();
+
   //  void Join(final Object family, IProgressMonitor monitor) throws InterruptedException, OperationCanceledException );
 
 
@@ -351,6 +373,11 @@ private:
    */
   long long m_waitQueueCounter;
 
+  /**
+   * Scheduling statistics, protected by m_mutex.
+   */
+  Statistics m_statistics;
+
   //  /**
   //   * For debugging purposes only
   //   */
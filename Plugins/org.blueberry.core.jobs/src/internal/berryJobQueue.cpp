@@ -68,8 +68,10 @@ bool JobQueue::CanOvertake(InternalJob::Pointer newEntry,
   if (newEntry->GetWaitQueueStamp() > 0 && newEntry->GetWaitQueueStamp()
       < queueEntry->GetWaitQueueStamp())
     return true;
-  //if the new entry has lower priority, there is no need to overtake the existing entry
-  if ((queueEntry == newEntry))
+  //if the new entry has lower priority, there is no need to overtake the existing entry.
+  //Start times include the priority delay, so this orders by priority and, within a
+  //priority, first come first served. Appending a job therefore stops at the tail.
+  if (newEntry->GetStartTime() >= queueEntry->GetStartTime())
     return false;
 
   // the new entry has higher priority, but only overtake the existing entry if the queue allows it
@@ -34,6 +34,9 @@ Worker::JobRunnable::JobRunnable(Worker* currentWorker) :
 
 void Worker::JobRunnable::run()
 {
+  // the pool drops its reference when the worker ends, so keep the worker
+  // alive until this method has returned
+  Worker::Pointer sptr_currentWorker(ptr_currentWorker);
   ptr_currentWorker->setPriority(PRIO_NORMAL);
   try
   {
@@ -70,12 +73,10 @@ void Worker::JobRunnable::run()
   } catch (FinallyThrowException&)
   {
     ptr_currentWorker->ptr_currentJob = nullptr;
-    Worker::Pointer sptr_currentWorker(ptr_currentWorker);
     ptr_currentWorker->m_wpPool.Lock()->EndWorker(sptr_currentWorker);
   } catch (...)
   {
     ptr_currentWorker->ptr_currentJob = nullptr;
-    Worker::Pointer sptr_currentWorker(ptr_currentWorker);
     ptr_currentWorker->m_wpPool.Lock()->EndWorker(sptr_currentWorker);
 
   }
@@ -24,8 +24,8 @@ namespace berry
 {
 
 WorkerPool::WorkerPool(JobManager* myJobManager) :
-  m_ptrManager(myJobManager), m_numThreads(0), m_sleepingThreads(0), m_threads(
-      10), m_busyThreads(0)
+  m_ptrManager(myJobManager), m_numThreads(0), m_sleepingThreads(0), m_threads(),
+      m_busyThreads(0)
 // m_isDaemon(false),
 {
 }
@@ -37,16 +37,14 @@ const int WorkerPool::MIN_THREADS = 1;
 void WorkerPool::Shutdown()
 {
   Poco::ScopedLock<Poco::Mutex> LockMe(m_mutexOne);
-  for(int i = 0; i<= m_numThreads; i++)
-    {
-      notify();
-    }
+  m_jobAvailable.broadcast();
 }
 
 void WorkerPool::Add(Worker::Pointer worker)
 {
   Poco::Mutex::ScopedLock lock(m_mutexOne);
   m_threads.push_back(worker);
+  ++m_numThreads;
 }
 
 void WorkerPool::DecrementBusyThreads()
@@ -76,7 +74,11 @@ bool WorkerPool::Remove(Worker::Pointer worker)
   auto end = std::remove(m_threads.begin(),
       m_threads.end(), worker);
   bool removed = end != m_threads.end();
-  m_threads.erase(end);
+  if (removed)
+  {
+    m_threads.erase(end, m_threads.end());
+    --m_numThreads;
+  }
 
   return removed;
 }
@@ -95,7 +97,7 @@ void WorkerPool::Sleep(long duration)
 
   try
   {
-    wait(duration);
+    m_jobAvailable.tryWait(m_mutexOne, duration);
     throw FinallyThrowException();
   } catch (FinallyThrowException&)
   {
@@ -131,15 +133,16 @@ InternalJob::Pointer WorkerPool::StartJob(Worker* worker)
     Poco::Timestamp idleStart;
     while (m_ptrManager->IsActive() && ptr_job == 0)
     {
-      long tmpSleepTime = long(m_ptrManager->SleepHint());
-      if (tmpSleepTime > 0)
-        Sleep(std::min(tmpSleepTime, BEST_BEFORE));
+      // the sleep hint is in microseconds, sleep durations are in milliseconds
+      Poco::Timespan::TimeDiff tmpSleepHint = m_ptrManager->SleepHint();
+      if (tmpSleepHint > 0)
+        Sleep(long(std::min<Poco::Timespan::TimeDiff>(tmpSleepHint / 1000 + 1, BEST_BEFORE)));
       ptr_job = m_ptrManager->StartJob();
       //if we were already idle, and there are still no new jobs, then the thread can expire
       {
         Poco::Mutex::ScopedLock lockOne(m_mutexOne);
         Poco::Timestamp tmpCurrentTime;
-        long long tmpTime = tmpCurrentTime - idleStart;
+        long long tmpTime = (tmpCurrentTime - idleStart) / 1000;
         if (ptr_job == 0 && (tmpTime > BEST_BEFORE) && (m_numThreads
             - m_busyThreads) > MIN_THREADS)
         {
@@ -182,7 +185,7 @@ void WorkerPool::JobQueued()
   //if there is a sleeping thread, wake it up
   if (m_sleepingThreads > 0)
   {
-    notify();
+    m_jobAvailable.signal();
     return;
   }
   //create a thread if all threads are busy
@@ -21,9 +21,9 @@ found in the LICENSE file.
 #include "berryJobExceptions.h"
 
 #include <Poco/ScopedLock.h>
+#include <Poco/Condition.h>
 #include <Poco/Exception.h>
 #include <Poco/Mutex.h>
-#include <Poco/SynchronizedObject.h>
 
 
 namespace berry
@@ -31,7 +31,7 @@ namespace berry
 
 struct JobManager;
 
-class BERRY_JOBS WorkerPool: public Object, public Poco::SynchronizedObject
+class BERRY_JOBS WorkerPool: public Object
 {
 
   friend struct JobManager;
@@ -103,6 +103,13 @@ private:
    */
 
   Poco::Mutex m_mutexOne;
+
+  /**
+   * Signalled when a job has been queued or the pool is shut down. Sleeping
+   * workers wait on it with m_mutexOne released, so scheduling a job never
+   * blocks until a sleeping worker times out.
+   */
+  Poco::Condition m_jobAvailable;
   //
   //   /**
   //   * Records whether new worker threads should be daemon threads.
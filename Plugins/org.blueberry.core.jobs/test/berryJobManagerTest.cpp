@@ -0,0 +1,262 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "berryJob.h"
+#include "berryJobManager.h"
+
+#include <berryStatus.h>
+
+#include <Poco/Condition.h>
+#include <Poco/Mutex.h>
+#include <Poco/Thread.h>
+#include <Poco/Timestamp.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+  /**
+   * Records the order in which the jobs are handed to the workers and the time they
+   * start running.
+   */
+  struct JobRecorder
+  {
+    Poco::Mutex mutex;
+    Poco::Condition finished;
+    std::vector<QString> order;
+    Poco::Timestamp lastStart;
+    int finishedJobs = 0;
+
+    bool WaitForJobs(int numberOfJobs)
+    {
+      Poco::ScopedLock<Poco::Mutex> lock(mutex);
+      while (finishedJobs < numberOfJobs)
+      {
+        if (!finished.tryWait(mutex, 10000))
+          return false;
+      }
+      return true;
+    }
+  };
+
+  class RecordingJob : public berry::Job
+  {
+  public:
+    RecordingJob(const QString& name, JobRecorder& recorder, long duration = 0)
+      : Job(name), m_Recorder(recorder), m_Duration(duration)
+    {
+    }
+
+    /** Called by the worker right after the job left the wait queue */
+    bool ShouldRun() override
+    {
+      Poco::ScopedLock<Poco::Mutex> lock(m_Recorder.mutex);
+      m_Recorder.order.push_back(this->GetName());
+      return true;
+    }
+
+    berry::IStatus::Pointer Run(berry::IProgressMonitor::Pointer) override
+    {
+      {
+        Poco::ScopedLock<Poco::Mutex> lock(m_Recorder.mutex);
+        m_Recorder.lastStart.update();
+      }
+      // keep the worker busy, so the next job is handed to another worker
+      if (m_Duration > 0)
+        Poco::Thread::sleep(m_Duration);
+      {
+        Poco::ScopedLock<Poco::Mutex> lock(m_Recorder.mutex);
+        ++m_Recorder.finishedJobs;
+        m_Recorder.finished.broadcast();
+      }
+      return berry::Status::OK_STATUS(BERRY_STATUS_LOC);
+    }
+
+  private:
+    JobRecorder& m_Recorder;
+    long m_Duration;
+  };
+
+  /**
+   * Jobs scheduled while the job manager is suspended have to run by priority and,
+   * within a priority, in the order they were scheduled.
+   */
+  bool TestPriorityOrdering(berry::JobManager* manager, JobRecorder& recorder)
+  {
+    manager->Suspend();
+    if (!manager->IsSuspended())
+    {
+      std::cout << "The job manager is not suspended" << std::endl;
+      return false;
+    }
+
+    const struct
+    {
+      const char* name;
+      int priority;
+    } priorities[] = {{"long-1", berry::Job::LONG},
+                      {"short-1", berry::Job::SHORT},
+                      {"interactive", berry::Job::INTERACTIVE},
+                      {"short-2", berry::Job::SHORT},
+                      {"long-2", berry::Job::LONG}};
+    std::vector<berry::Job::Pointer> jobs;
+    for (const auto& priority : priorities)
+    {
+      // the job has to be owned by a smart pointer before SetPriority() refers to it
+      berry::Job::Pointer job(new RecordingJob(priority.name, recorder, 100));
+      job->SetPriority(priority.priority);
+      jobs.push_back(job);
+    }
+    for (auto& job : jobs)
+      job->Schedule();
+
+    // let the workers woken by Schedule() go back to sleep
+    Poco::Thread::sleep(100);
+    manager->Resume();
+
+    if (!recorder.WaitForJobs(static_cast<int>(jobs.size())))
+    {
+      std::cout << "Timeout while waiting for the scheduled jobs" << std::endl;
+      return false;
+    }
+
+    const std::vector<QString> expected = {"interactive", "short-1", "short-2", "long-1", "long-2"};
+    Poco::ScopedLock<Poco::Mutex> lock(recorder.mutex);
+    if (recorder.order != expected)
+    {
+      std::cout << "Jobs did not run by priority:";
+      for (const auto& name : recorder.order)
+        std::cout << " " << name.toStdString();
+      std::cout << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * A job scheduled while all workers sleep has to be started right away instead of
+   * when the sleeping worker times out (which used to take up to a minute). The bound
+   * is generous, so a loaded test machine does not fail the test.
+   */
+  bool TestWakeUpLatency(JobRecorder& recorder)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      // let all workers go to sleep
+      Poco::Thread::sleep(200);
+
+      int finishedJobs = 0;
+      {
+        Poco::ScopedLock<Poco::Mutex> lock(recorder.mutex);
+        finishedJobs = recorder.finishedJobs;
+      }
+      berry::Job::Pointer job(new RecordingJob("wake-up", recorder));
+      job->SetPriority(berry::Job::INTERACTIVE);
+      Poco::Timestamp scheduled;
+      job->Schedule();
+      if (!recorder.WaitForJobs(finishedJobs + 1))
+      {
+        std::cout << "Timeout while waiting for a job scheduled to sleeping workers" << std::endl;
+        return false;
+      }
+
+      Poco::ScopedLock<Poco::Mutex> lock(recorder.mutex);
+      const Poco::Timestamp::TimeDiff latency = recorder.lastStart - scheduled;
+      if (latency > 5000000)
+      {
+        std::cout << "Job started " << latency / 1000 << " ms after it was scheduled" << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Schedules many short jobs at once and reports the throughput. Only the completion of
+   * all jobs is checked, the rate depends on the machine.
+   */
+  bool TestThroughput(JobRecorder& recorder, int numberOfJobs)
+  {
+    int finishedJobs = 0;
+    {
+      Poco::ScopedLock<Poco::Mutex> lock(recorder.mutex);
+      finishedJobs = recorder.finishedJobs;
+    }
+
+    std::vector<berry::Job::Pointer> jobs;
+    for (int i = 0; i < numberOfJobs; ++i)
+      jobs.push_back(berry::Job::Pointer(new RecordingJob("throughput", recorder)));
+
+    Poco::Timestamp start;
+    for (auto& job : jobs)
+      job->Schedule();
+
+    if (!recorder.WaitForJobs(finishedJobs + numberOfJobs))
+    {
+      std::cout << "Timeout while waiting for " << numberOfJobs << " short jobs" << std::endl;
+      return false;
+    }
+
+    const double seconds = std::max<Poco::Timestamp::TimeDiff>(start.elapsed(), 1) / 1e6;
+    std::cout << numberOfJobs << " jobs in " << seconds * 1000 << " ms (" << numberOfJobs / seconds
+              << " jobs/s)" << std::endl;
+    return true;
+  }
+
+  bool TestStatistics(berry::JobManager* manager, int startedJobs)
+  {
+    const berry::JobManager::Statistics statistics = manager->GetStatistics();
+    if (statistics.waitingJobs != 0)
+    {
+      std::cout << "Wait queue of the idle job manager holds " << statistics.waitingJobs << " jobs" << std::endl;
+      return false;
+    }
+    if (statistics.maxWaitingJobs < 5)
+    {
+      std::cout << "Maximum wait queue depth is " << statistics.maxWaitingJobs << " instead of at least 5" << std::endl;
+      return false;
+    }
+    if (statistics.startedJobs != startedJobs)
+    {
+      std::cout << statistics.startedJobs << " jobs were started instead of " << startedJobs << std::endl;
+      return false;
+    }
+    // the jobs scheduled to the suspended job manager waited for at least 100 ms
+    if (statistics.maxWaitTime < 100000 || statistics.totalWaitTime < statistics.maxWaitTime)
+    {
+      std::cout << "Inconsistent wait times: maximum " << statistics.maxWaitTime << " us, total "
+                << statistics.totalWaitTime << " us" << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+int berryJobManagerTest(int /*argc*/, char* /*argv*/ [])
+{
+  berry::JobManager* manager = berry::JobManager::GetInstance();
+  JobRecorder recorder;
+
+  const int numberOfThroughputJobs = 1000;
+
+  bool success = TestPriorityOrdering(manager, recorder);
+  success = TestWakeUpLatency(recorder) && success;
+  success = TestThroughput(recorder, numberOfThroughputJobs) && success;
+  success = TestStatistics(manager, 8 + numberOfThroughputJobs) && success;
+
+  berry::JobManager::Shutdown();
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -118,6 +118,8 @@ set(INTERNAL_CPP_FILES
   berryRegistryTimestamp.cpp
   berryRegistrySupport.cpp
   berrySimpleExtensionPointFilter.cpp
+  berryTableReader.cpp
+  berryTableWriter.cpp
   berryTemporaryObjectManager.cpp
   berryThirdLevelConfigurationElementHandle.cpp
 )
@@ -38,10 +38,14 @@ class CTKPluginListener : public QObject {
 
   Q_OBJECT
 
-private:
+public:
 
   static const QString PLUGIN_MANIFEST; // = "plugin.xml"
 
+  static QString GetExtensionPath(QSharedPointer<ctkPlugin> plugin);
+
+private:
+
   ExtensionRegistry* registry;
   RegistryStrategy* strategy;
   QObject* token;
@@ -65,8 +69,6 @@ private:
 
   void RemovePlugin(QSharedPointer<ctkPlugin> plugin);
 
-  static QString GetExtensionPath(QSharedPointer<ctkPlugin> plugin);
-
   void AddPlugin(QSharedPointer<ctkPlugin> plugin);
 
 };
@@ -52,6 +52,7 @@ protected:
   friend class ConfigurationElementHandle;
   friend class ExtensionRegistry;
   friend class ExtensionsParser;
+  friend class TableWriter;
 
   void ThrowException(const QString& message, const ctkException& exc);
 
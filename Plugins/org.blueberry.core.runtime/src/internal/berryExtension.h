@@ -32,6 +32,8 @@ private:
   friend class ExtensionPointHandle;
   friend class ExtensionRegistry;
   friend class RegistryObjectManager;
+  friend class TableReader;
+  friend class TableWriter;
 
   //Extension simple identifier
   QString simpleId;
@@ -36,9 +36,14 @@ found in the LICENSE file.
 #include "berryRegistryProperties.h"
 #include "berryRegistryStrategy.h"
 #include "berryStatus.h"
+#include "berryTableReader.h"
+#include "berryTableWriter.h"
 
-#include <QThread>
+#include <QDir>
 #include <QElapsedTimer>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThread>
 
 namespace berry {
 
@@ -447,19 +452,22 @@ bool ExtensionRegistry::RemoveObject(const SmartPointer<RegistryObject>& registr
   return true;
 }
 
-void ExtensionRegistry::SetFileManager(const QString& /*cacheBase*/, bool /*isCacheReadOnly*/)
+void ExtensionRegistry::SetFileManager(const QString& cacheBase, bool isCacheReadOnly)
 {
-//  if (cacheStorageManager != nullptr)
-//    cacheStorageManager->Close(); // close existing file manager first
+  theTableReader->Close(); // close existing cache file first
 
-//  if (cacheBase != null) {
-//    cacheStorageManager = new StorageManager(cacheBase, isCacheReadOnly ? "none" : null, isCacheReadOnly); //$NON-NLS-1$
-//    try {
-//      cacheStorageManager.open(!isCacheReadOnly);
-//    } catch (IOException e) {
-//      // Ignore the exception. The registry will be rebuilt from source.
-//    }
-//  }
+  this->cacheBase = cacheBase;
+  this->cacheReadOnly = isCacheReadOnly;
+
+  if (!cacheBase.isEmpty())
+  {
+    theTableReader->SetCacheFile(QDir(cacheBase).filePath(TableReader::CACHE_FILE));
+    if (!isCacheReadOnly)
+    {
+      // Ignore failures. The registry will be rebuilt from source.
+      QDir().mkpath(cacheBase);
+    }
+  }
 }
 
 void ExtensionRegistry::EnterRead()
@@ -485,30 +493,23 @@ void ExtensionRegistry::SetElementFactory()
   }
 }
 
-//TableReader ExtensionRegistry::getTableReader() const
-//{
-//  return theTableReader;
-//}
+TableReader* ExtensionRegistry::GetTableReader() const
+{
+  return theTableReader.data();
+}
 
 bool ExtensionRegistry::CheckCache()
 {
-//  for (int index = 0; index < strategy.getLocationsLength(); index++) {
-//    File possibleCacheLocation = strategy.getStorage(index);
-//    if (possibleCacheLocation == null)
-//      break; // bail out on the first null
-//    setFileManager(possibleCacheLocation, strategy.isCacheReadOnly(index));
-//    if (cacheStorageManager != null) {
-//      // check this new location:
-//      File cacheFile = null;
-//      try {
-//        cacheFile = cacheStorageManager.lookup(TableReader.getTestFileName(), false);
-//      } catch (IOException e) {
-//        //Ignore the exception. The registry will be rebuilt from the xml files.
-//      }
-//      if (cacheFile != null && cacheFile.isFile())
-//        return true; // found the appropriate location
-//    }
-//  }
+  for (int index = 0; index < strategy->GetLocationsLength(); index++)
+  {
+    QString possibleCacheLocation = strategy->GetStorage(index);
+    if (possibleCacheLocation.isEmpty())
+      break; // bail out on the first empty location
+    SetFileManager(possibleCacheLocation, strategy->IsCacheReadOnly(index));
+    // check this new location:
+    if (QFileInfo(QDir(possibleCacheLocation).filePath(TableReader::CACHE_FILE)).isFile())
+      return true; // found the appropriate location
+  }
   return false;
 }
 
@@ -776,7 +777,8 @@ void ExtensionRegistry::RemoveListener(IRegistryEventListener* listener)
 }
 
 ExtensionRegistry::ExtensionRegistry(RegistryStrategy* registryStrategy, QObject* masterToken, QObject* userToken)
-  : registryObjects(nullptr), isMultiLanguage(false), mlErrorLogged(false), eventThread(nullptr)
+  : registryObjects(nullptr), isMultiLanguage(false), mlErrorLogged(false), eventThread(nullptr),
+    cacheReadOnly(true)
 {
   isMultiLanguage = RegistryProperties::GetProperty(RegistryConstants::PROP_REGISTRY_MULTI_LANGUAGE) == "true";
 
@@ -787,52 +789,48 @@ ExtensionRegistry::ExtensionRegistry(RegistryStrategy* registryStrategy, QObject
 
   this->masterToken = masterToken;
   this->userToken = userToken;
+  theTableReader.reset(new TableReader(this));
   registryObjects = new RegistryObjectManager(this);
 
   bool isRegistryFilledFromCache = false; // indicates if registry was able to use cache to populate it's content
 
+  // the startup time is reported for both, reading the cache and parsing the plug-in manifests
+  QElapsedTimer timer;
+  timer.start();
+
   if (strategy->CacheUse())
   {
     // Try to read the registry from the cache first. If that fails, create a new registry
-    QElapsedTimer timer;
-    if (Debug())
-      timer.start();
-
-    //The cache is made of several files, find the real names of these other files. If all files are found, try to initialize the objectManager
     if (CheckCache())
     {
-      // TODO Registry Cache
-//      try {
-//        theTableReader.setTableFile(cacheStorageManager.lookup(TableReader.TABLE, false));
-//        theTableReader.setExtraDataFile(cacheStorageManager.lookup(TableReader.EXTRA, false));
-//        theTableReader.setMainDataFile(cacheStorageManager.lookup(TableReader.MAIN, false));
-//        theTableReader.setContributionsFile(cacheStorageManager.lookup(TableReader.CONTRIBUTIONS, false));
-//        theTableReader.setContributorsFile(cacheStorageManager.lookup(TableReader.CONTRIBUTORS, false));
-//        theTableReader.setNamespacesFile(cacheStorageManager.lookup(TableReader.NAMESPACES, false));
-//        theTableReader.setOrphansFile(cacheStorageManager.lookup(TableReader.ORPHANS, false));
-//        long timestamp = strategy.getContributionsTimestamp();
-//        isRegistryFilledFromCache = registryObjects.init(timestamp);
-//        if (isRegistryFilledFromCache)
-//          aggregatedTimestamp.set(timestamp);
-//      } catch (IOException e) {
-//        // The registry will be rebuilt from the xml files. Make sure to clear anything filled
-//        // from cache so that we won't have partially filled items.
-//        isRegistryFilledFromCache = false;
-//        clearRegistryCache();
-//        log(new Status(IStatus.ERROR, RegistryMessages.OWNER_NAME, 0, RegistryMessages.registry_bad_cache, e));
-//      }
+      // The cache is only valid if no plug-in changed since it has been written
+      long timestamp = strategy->GetContributionsTimestamp();
+      isRegistryFilledFromCache = registryObjects->Init(timestamp);
+      if (isRegistryFilledFromCache)
+      {
+        aggregatedTimestamp.Set(timestamp);
+      }
+      else
+      {
+        // The registry is rebuilt from the plug-in manifests. Make sure to drop anything
+        // read from the cache so far. The outdated cache is replaced on Stop().
+        theTableReader->Close();
+        registryObjects = new RegistryObjectManager(this);
+      }
     }
 
-//    if (!isRegistryFilledFromCache)
-//    {
-//      // set cache storage manager to a first writable location
-//      for (int index = 0; index < strategy.getLocationsLength(); index++) {
-//        if (!strategy.isCacheReadOnly(index)) {
-//          setFileManager(strategy.getStorage(index), false);
-//          break;
-//        }
-//      }
-//    }
+    if (!isRegistryFilledFromCache)
+    {
+      // set cache location to a first writable location
+      for (int index = 0; index < strategy->GetLocationsLength(); index++)
+      {
+        if (!strategy->IsCacheReadOnly(index))
+        {
+          SetFileManager(strategy->GetStorage(index), false);
+          break;
+        }
+      }
+    }
 
     if (Debug() && isRegistryFilledFromCache)
       BERRY_INFO << "Reading registry cache: " << timer.elapsed() << "ms";
@@ -895,17 +893,21 @@ ExtensionRegistry::ExtensionRegistry(RegistryStrategy* registryStrategy, QObject
 
   // Do extra start processing if specified in the registry strategy
   strategy->OnStart(this, isRegistryFilledFromCache);
+
+  BERRY_INFO << "Extension registry populated from "
+             << (isRegistryFilledFromCache ? "registry cache" : "plug-in manifests")
+             << " in " << timer.elapsed() << " ms";
 }
 
 ExtensionRegistry::~ExtensionRegistry()
 {
 }
 
-void ExtensionRegistry::Stop(QObject* /*key*/)
+void ExtensionRegistry::Stop(QObject* key)
 {
   // If the registry creator specified a key token, check that the key matches it
   // (it is assumed that registry owner keeps the key to prevent unautorized access).
-  if (masterToken != nullptr && masterToken != nullptr)
+  if (masterToken != nullptr && masterToken != key)
   {
     throw ctkInvalidArgumentException("Unauthorized access to the ExtensionRegistry.stop() method. Check if proper access token is supplied."); //$NON-NLS-1$
   }
@@ -915,81 +917,46 @@ void ExtensionRegistry::Stop(QObject* /*key*/)
 
   StopChangeEventScheduler();
 
-//  if (cacheStorageManager == nullptr)
-//    return;
+  if (cacheBase.isEmpty())
+  {
+    theTableReader->Close();
+    return;
+  }
+
+  if (!registryObjects->IsDirty() || cacheReadOnly)
+  {
+    theTableReader->Close();
+    return;
+  }
 
-//  if (!registryObjects.isDirty() || cacheStorageManager.isReadOnly()) {
-//    cacheStorageManager.close();
-//    theTableReader.close();
-//    return;
-//  }
+  // Timestamps are not tracked for every contribution (see RegistryStrategy::CheckContributionsTimestamp()),
+  // so use the value computed by the strategy. It is compared with the same value on the next startup.
+  long timestamp = strategy->GetContributionsTimestamp();
 
-//  File tableFile = null;
-//  File mainFile = null;
-//  File extraFile = null;
-//  File contributionsFile = null;
-//  File contributorsFile = null;
-//  File namespacesFile = null;
-//  File orphansFile = null;
-
-//  TableWriter theTableWriter = new TableWriter(this);
-
-//  try {
-//    cacheStorageManager.lookup(TableReader.TABLE, true);
-//    cacheStorageManager.lookup(TableReader.MAIN, true);
-//    cacheStorageManager.lookup(TableReader.EXTRA, true);
-//    cacheStorageManager.lookup(TableReader.CONTRIBUTIONS, true);
-//    cacheStorageManager.lookup(TableReader.CONTRIBUTORS, true);
-//    cacheStorageManager.lookup(TableReader.NAMESPACES, true);
-//    cacheStorageManager.lookup(TableReader.ORPHANS, true);
-//    tableFile = File.createTempFile(TableReader.TABLE, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    mainFile = File.createTempFile(TableReader.MAIN, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    extraFile = File.createTempFile(TableReader.EXTRA, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    contributionsFile = File.createTempFile(TableReader.CONTRIBUTIONS, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    contributorsFile = File.createTempFile(TableReader.CONTRIBUTORS, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    namespacesFile = File.createTempFile(TableReader.NAMESPACES, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    orphansFile = File.createTempFile(TableReader.ORPHANS, ".new", cacheStorageManager.getBase()); //$NON-NLS-1$
-//    theTableWriter.setTableFile(tableFile);
-//    theTableWriter.setExtraDataFile(extraFile);
-//    theTableWriter.setMainDataFile(mainFile);
-//    theTableWriter.setContributionsFile(contributionsFile);
-//    theTableWriter.setContributorsFile(contributorsFile);
-//    theTableWriter.setNamespacesFile(namespacesFile);
-//    theTableWriter.setOrphansFile(orphansFile);
-//  } catch (IOException e) {
-//    cacheStorageManager.close();
-//    return; //Ignore the exception since we can recompute the cache
-//  }
-//  try {
-//    long timestamp;
-//    // A bit of backward compatibility: if registry was modified, but timestamp was not,
-//    // it means that the new timestamp tracking mechanism was not used. In this case
-//    // explicitly obtain timestamps for all contributions. Note that this logic
-//    // maintains a problem described in the bug 104267 for contributions that
-//    // don't use the timestamp tracking mechanism.
-//    if (aggregatedTimestamp.isModifed())
-//      timestamp = aggregatedTimestamp.getContentsTimestamp(); // use timestamp tracking
-//    else
-//      timestamp = strategy.getContributionsTimestamp(); // use legacy approach
-
-//    if (theTableWriter.saveCache(registryObjects, timestamp))
-//      cacheStorageManager.update(new   QString[] {TableReader.TABLE, TableReader.MAIN, TableReader.EXTRA, TableReader.CONTRIBUTIONS, TableReader.CONTRIBUTORS, TableReader.NAMESPACES, TableReader.ORPHANS}, new   QString[] {tableFile.getName(), mainFile.getName(), extraFile.getName(), contributionsFile.getName(), contributorsFile.getName(), namespacesFile.getName(), orphansFile.getName()});
-//  } catch (IOException e) {
-//    //Ignore the exception since we can recompute the cache
-//  }
-//  theTableReader.close();
-//  cacheStorageManager.close();
+  // Objects which have not been read from the old cache yet are read while writing the new one,
+  // so the old cache is closed just before it is replaced.
+  QSaveFile cacheFile(QDir(cacheBase).filePath(TableReader::CACHE_FILE));
+  bool saved = false;
+  if (cacheFile.open(QIODevice::WriteOnly))
+  {
+    TableWriter theTableWriter;
+    saved = theTableWriter.SaveCache(registryObjects.GetPointer(), timestamp, &cacheFile);
+  }
+  theTableReader->Close();
+
+  if (saved)
+    saved = cacheFile.commit();
+
+  // Ignore failures, the cache is recomputed on the next startup
+  if (!saved && Debug())
+    BERRY_INFO << "Unable to write registry cache: " << cacheFile.fileName();
 }
 
 void ExtensionRegistry::ClearRegistryCache()
 {
-//  QString[] keys = new   QString[] {TableReader.TABLE, TableReader.MAIN, TableReader.EXTRA, TableReader.CONTRIBUTIONS, TableReader.ORPHANS};
-//  for (int i = 0; i < keys.length; i++)
-//    try {
-//      cacheStorageManager.remove(keys[i]);
-//    } catch (IOException e) {
-//      log(new Status(IStatus.ERROR, RegistryMessages.OWNER_NAME, IStatus.ERROR, RegistryMessages.meta_registryCacheReadProblems, e));
-//    }
+  theTableReader->Close();
+  if (!cacheBase.isEmpty() && !cacheReadOnly)
+    QFile::remove(QDir(cacheBase).filePath(TableReader::CACHE_FILE));
   aggregatedTimestamp.Reset();
 }
 
@@ -39,11 +39,14 @@ class RegistryObject;
 class RegistryObjectFactory;
 class RegistryObjectManager;
 class RegistryStrategy;
+class TableReader;
 
 /**
  * An implementation for the extension registry API.
+ *
+ * Exported for the registry tests only, this class is not part of the API.
  */
-class ExtensionRegistry : public QObject, public IExtensionRegistry
+class org_blueberry_core_runtime_EXPORT ExtensionRegistry : public QObject, public IExtensionRegistry
 {
   Q_OBJECT
   Q_INTERFACES(berry::IExtensionRegistry)
@@ -182,11 +185,12 @@ private:
 
 protected:
 
-  //storage manager associated with the registry cache
-  //StorageManager cacheStorageManager;
+  // location of the registry cache; empty if the cache is not used
+  QString cacheBase;
+  bool cacheReadOnly;
 
   // Table reader associated with this extension registry
-  //TableReader theTableReader = new TableReader(this);
+  QScopedPointer<TableReader> theTableReader;
 
   QScopedPointer<RegistryStrategy> strategy; // overridable portions of the registry functionality
 
@@ -214,8 +218,6 @@ protected:
   // Override to provide domain-specific elements to be stored in the extension registry
   void SetElementFactory();
 
-  //TableReader getTableReader() const;
-
   // Find the first location that contains a cache table file and set file manager to it.
   bool CheckCache();
 
@@ -225,6 +227,8 @@ public:
 
   SmartPointer<RegistryObjectManager> GetObjectManager() const;
 
+  TableReader* GetTableReader() const;
+
   void AddListener(IRegistryEventListener* listener, const QString& extensionPointId = QString()) override;
   void AddListener(IRegistryEventListener *listener, const IExtensionPointFilter& filter) override;
 
@@ -34,8 +34,10 @@ namespace berry {
  * be broken (repeatedly) as the API evolves.
  * </p>
  * @noextend This class is not intended to be subclassed by clients.
+ *
+ * Exported for the registry tests only, this class is not part of the API.
  */
-class RegistryContributor : public IContributor
+class org_blueberry_core_runtime_EXPORT RegistryContributor : public IContributor
 {
 
 private:
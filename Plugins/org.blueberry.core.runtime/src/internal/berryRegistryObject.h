@@ -47,6 +47,7 @@ protected:
   friend class RegistryObjectManager;
   friend class ExtensionRegistry;
   friend class ExtensionsParser;
+  friend class TableWriter;
 
   QList<int> children;
 
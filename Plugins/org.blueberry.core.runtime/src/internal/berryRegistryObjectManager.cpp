@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include "berryExtensionHandle.h"
 #include "berryExtensionPoint.h"
 #include "berryExtensionPointHandle.h"
+#include "berryExtensionRegistry.h"
 #include "berryInvalidRegistryObjectException.h"
 #include "berryRegistryObjectReferenceMap.h"
 #include "berryRegistryConstants.h"
@@ -247,28 +248,35 @@ RegistryObjectManager::GetExtensionsFromNamespace(const QString& namespaceName)
   return result;
 }
 
-bool RegistryObjectManager::Init(long /*timeStamp*/)
+bool RegistryObjectManager::Init(long timeStamp)
 {
-  return false;
-//  QMutexLocker l(&mutex);
-//  TableReader reader = registry.getTableReader();
-//  Object[] results = reader.loadTables(timeStamp);
-//  if (results == null) {
-//    return false;
-//  }
-//  fileOffsets = (OffsetTable) results[0];
-//  extensionPoints = (HashtableOfStringAndInt) results[1];
-//  nextId = ((Integer) results[2]).intValue();
-//  fromCache = true;
-
-//  if (!registry.useLazyCacheLoading()) {
-//    //TODO Here we could grow all the tables to the right size (ReferenceMap)
-//    reader.setHoldObjects(true);
-//    markOrphansHasDirty(getOrphans());
-//    fromCache = reader.readAllCache(this);
-//    formerContributions = getFormerContributions();
-//  }
-//  return fromCache;
+  QMutexLocker l(&mutex);
+  TableReader* reader = registry->GetTableReader();
+  if (!reader->LoadTables(timeStamp, extensionPoints, fileOffsets, nextId))
+  {
+    return false;
+  }
+  fromCache = true;
+
+  if (!registry->UseLazyCacheLoading())
+  {
+    // read the whole cache now; the loaded objects are held, so the file is not needed anymore
+    foreach (int id, fileOffsets.keys())
+    {
+      // an unreadable object makes the whole cache unusable
+      if (cache->Get(id).IsNull() && Load(id, CONFIGURATION_ELEMENT).IsNull())
+      {
+        reader->Close();
+        return false;
+      }
+    }
+    GetContributors();
+    GetFormerContributions();
+    GetNamespacesIndex();
+    GetOrphans();
+    reader->Close();
+  }
+  return fromCache;
 }
 
 void RegistryObjectManager::AddContribution(const SmartPointer<RegistryContribution>& contribution)
@@ -329,8 +337,7 @@ void RegistryObjectManager::Remove(int id, bool release)
 void RegistryObjectManager::Remove_unlocked(int id, bool release)
 {
   RegistryObject::Pointer toRemove = cache->Get(id);
-//  if (fileOffsets != null)
-//    fileOffsets.removeKey(id);
+  fileOffsets.remove(id);
   if (toRemove.IsNotNull())
     Remove(toRemove, release);
 }
@@ -489,7 +496,7 @@ RegistryObjectManager::ContributorsMapType& RegistryObjectManager::GetContributo
   {
     if (fromCache)
     {
-      //contributors = registry->GetTableReader()->LoadContributors();
+      contributors = registry->GetTableReader()->LoadContributors();
     }
     contributorsLoaded = true;
   }
@@ -544,7 +551,7 @@ KeyedHashSet& RegistryObjectManager::GetNamespacesIndex() const
   {
     if (fromCache)
     {
-      //namespacesIndex = registry->GetTableReader()->LoadNamespaces();
+      namespacesIndex = registry->GetTableReader()->LoadNamespaces();
     }
     namespacesIndexLoaded = true;
   }
@@ -764,7 +771,7 @@ KeyedHashSet& RegistryObjectManager::GetFormerContributions() const
   {
     if (fromCache)
     {
-      //formerContributions = registry->GetTableReader()->LoadContributions();
+      formerContributions = registry->GetTableReader()->LoadContributions();
     }
     formerContributionsLoaded = true;
   }
@@ -801,29 +808,34 @@ SmartPointer<RegistryObject> RegistryObjectManager::BasicGetObject(int id, short
   return result;
 }
 
-SmartPointer<RegistryObject> RegistryObjectManager::Load(int /*id*/, short /*type*/) const
+SmartPointer<RegistryObject> RegistryObjectManager::Load(int id, short /*type*/) const
 {
-//  TableReader reader = registry.getTableReader();
-//  if (fileOffsets == null)
-//    return null;
-//  int offset = fileOffsets.get(id);
-//  if (offset == Integer.MIN_VALUE)
-//    return null;
-//  switch (type) {
-//    case CONFIGURATION_ELEMENT :
-//      return reader.loadConfigurationElement(offset);
+  // The records in the cache carry their type
+  TableReader::OffsetTable::const_iterator offset = fileOffsets.find(id);
+  if (offset == fileOffsets.end())
+    return RegistryObject::Pointer();
 
-//    case THIRDLEVEL_CONFIGURATION_ELEMENT :
-//      return reader.loadThirdLevelConfigurationElements(offset, this);
+  RegistryObject::Pointer result = registry->GetTableReader()->LoadObject(offset.value());
+  if (result.IsNull())
+    return result;
 
-//    case EXTENSION :
-//      return reader.loadExtension(offset);
+  // The object cache might only keep weak references. Hold on to the loaded
+  // objects so that every object is read from disk only once.
+  cache->Put(id, result);
+  heldObjects.Add(result);
+  LoadChildren(result);
+  return result;
+}
 
-//    case EXTENSION_POINT :
-//    default : //avoid compile errors. type must always be known
-//      return reader.loadExtensionPointTree(offset, this);
-//  }
-  return RegistryObject::Pointer();
+void RegistryObjectManager::LoadChildren(const SmartPointer<RegistryObject>& parent) const
+{
+  // Children are stored right after their parent, so an extension point is read
+  // together with its extensions and their configuration elements.
+  foreach (int id, parent->GetRawChildren())
+  {
+    if (cache->Get(id).IsNull())
+      Load(id, CONFIGURATION_ELEMENT);
+  }
 }
 
 RegistryObjectManager::OrphansMapType& RegistryObjectManager::GetOrphans() const
@@ -832,7 +844,7 @@ RegistryObjectManager::OrphansMapType& RegistryObjectManager::GetOrphans() const
   {
     if(fromCache)
     {
-      //orphanExtensions = registry->GetTableReader()->LoadOrphans();
+      orphanExtensions = registry->GetTableReader()->LoadOrphans();
     }
     orphanExtensionsLoaded = true;
   }
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "berryIObjectManager.h"
 #include "berryHashtableOfStringAndInt.h"
 #include "berryKeyedHashSet.h"
+#include "berryTableReader.h"
 
 #include <QMutex>
 
@@ -101,6 +102,7 @@ protected:
   friend class ExtensionsParser;
   friend class RegistryContribution;
   friend class RegistryObject;
+  friend class TableWriter;
 
   mutable QMutex mutex;
 
@@ -206,8 +208,8 @@ private:
   HashtableOfStringAndInt extensionPoints; //This is loaded on startup. Then entries can be added when loading a new plugin from the xml.
   // key: object id, value: an object
   RegistryObjectReferenceMap* cache; //Entries are added by getter. The structure is not thread safe.
-  //key: int, value: int
-  //OffsetTable fileOffsets = null; //This is read once on startup when loading from the cache. Entries are never added here. They are only removed to prevent "removed" objects to be reloaded.
+  //key: object id, value: offset in the registry cache
+  TableReader::OffsetTable fileOffsets; //This is read once on startup when loading from the cache. Entries are never added here. They are only removed to prevent "removed" objects to be reloaded.
 
   int nextId; //This is only used to get the next number available.
 
@@ -229,7 +231,7 @@ private:
   // The orphan access does not need to be synchronized because the it is protected by the lock in extension registry.
   mutable QHash<QString, QList<int> > orphanExtensions;
 
-  KeyedHashSet heldObjects; //strong reference to the objects that must be hold on to
+  mutable KeyedHashSet heldObjects; //strong reference to the objects that must be hold on to. Objects read from the cache are added on load.
 
   //Indicate if objects have been removed or added from the table. This only needs to be set in a couple of places (addNamespace and removeNamespace)
   bool isDirty;
@@ -261,8 +263,11 @@ private:
 
   SmartPointer<RegistryObject> BasicGetObject(int id, short type) const;
 
+  // Reads the object and all objects below it (e.g. the extensions of an extension point) from the cache
   SmartPointer<RegistryObject> Load(int id, short type) const;
 
+  void LoadChildren(const SmartPointer<RegistryObject>& parent) const;
+
   OrphansMapType& GetOrphans() const;
 
   // Find or create required index element
@@ -46,6 +46,10 @@ void RegistryProperties::SetProperty(const QString& propertyName, const QString&
 
 QString RegistryProperties::GetContextProperty(const QString& propertyName)
 {
+  // the registry may be used without a running plugin framework
+  if (context == nullptr)
+    return QString();
+
   return context->getProperty(propertyName).toString();
 }
 
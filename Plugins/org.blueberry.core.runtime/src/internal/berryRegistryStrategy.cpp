@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include "berryExtensionType.h"
 #include "berryRegistryConstants.h"
 #include "berryRegistryContributor.h"
+#include "berryRegistryProperties.h"
 #include "berryRegistryMessages.h"
 #include "berryRegistrySupport.h"
 #include "berryStatus.h"
@@ -198,12 +199,12 @@ bool RegistryStrategy::DebugRegistryEvents() const
 
 bool RegistryStrategy::CacheUse() const
 {
-  return true;
+  return RegistryProperties::GetProperty(RegistryConstants::PROP_NO_REGISTRY_CACHE).compare("true", Qt::CaseInsensitive) != 0;
 }
 
 bool RegistryStrategy::CacheLazyLoading() const
 {
-  return true;
+  return RegistryProperties::GetProperty(RegistryConstants::PROP_NO_LAZY_REGISTRY_CACHE_LOADING).compare("true", Qt::CaseInsensitive) != 0;
 }
 
 long RegistryStrategy::GetContainerTimestamp() const
@@ -213,7 +214,21 @@ long RegistryStrategy::GetContainerTimestamp() const
 
 long RegistryStrategy::GetContributionsTimestamp() const
 {
-  return 0;
+  ctkPluginContext* context = org_blueberry_core_runtime_Activator::getPluginContext();
+  if (context == nullptr)
+    return 0;
+
+  // Every installed plugin is considered, independent of its state, so that the
+  // value is the same on startup and shutdown of an unchanged installation.
+  long result = 0;
+  foreach (QSharedPointer<ctkPlugin> plugin, context->getPlugins())
+  {
+    QString pluginManifest = CTKPluginListener::GetExtensionPath(plugin);
+    if (pluginManifest.isEmpty())
+      continue;
+    result ^= GetExtendedTimestamp(plugin, pluginManifest);
+  }
+  return result;
 }
 
 bool RegistryStrategy::CheckContributionsTimestamp() const
@@ -15,6 +15,8 @@ found in the LICENSE file.
 
 #include <berrySmartPointer.h>
 
+#include <org_blueberry_core_runtime_Export.h>
+
 #include <QList>
 #include <QSharedPointer>
 
@@ -44,14 +46,16 @@ class RegistryContributor;
  * </p><p><ul>
  * <li>Logging is done onto <code>System.out</code>;</li>
  * <li>The translation routine assumes that keys are prefixed with <code>'%'/<code>;</li>
- * <li>Caching is enabled and doesn't use state or time stamp validation;</li>
+ * <li>Caching is enabled and validated by the time stamps of the installed plugins;</li>
  * <li>Standard Java class loading is used to create executable extensions.</li>
  * </ul></p><p>
  * This class can be used without OSGi running.
  * </p><p>
  * This class can be overridden and/or instantiated by clients.
+ *
+ * Exported for the registry tests only, this class is not part of the API.
  */
-class RegistryStrategy
+class org_blueberry_core_runtime_EXPORT RegistryStrategy
 {
 
 private:
@@ -109,7 +113,7 @@ public:
   RegistryStrategy(const QList<QString>& storageDirs, const QList<bool>& cacheReadOnly,
                    QObject* key);
 
-  ~RegistryStrategy();
+  virtual ~RegistryStrategy();
 
   /**
    * Returns the number of possible cache locations for this registry.
@@ -176,7 +180,7 @@ public:
    * @param loadedFromCache true is registry contents was loaded from
    * cache when the registry was created
    */
-  void OnStart(IExtensionRegistry* registry, bool loadedFromCache);
+  virtual void OnStart(IExtensionRegistry* registry, bool loadedFromCache);
 
   /**
    * Override this method to provide additional processing to be performed
@@ -184,7 +188,7 @@ public:
    * <code>super.onStop()</code> at the end of the processing.
    * @param registry the extension registry being stopped
    */
-  void OnStop(IExtensionRegistry* registry);
+  virtual void OnStop(IExtensionRegistry* registry);
 
   /**
    * Creates an executable extension. Override this method to supply an alternative processing
@@ -266,23 +270,25 @@ public:
    * Specifies if the extension registry should use cache to store registry data between
    * invocations.
    * <p>
-   * The default implementation enables caching returning <code>true</code>.
+   * The default implementation enables caching returning <code>true</code>, unless
+   * the <code>BlueBerry.noRegistryCache</code> property is set to <code>true</code>.
    * </p>
    *
    * @return <code>true</code> if the cache should be used and <code>false</code> otherwise
    */
-  bool CacheUse() const;
+  virtual bool CacheUse() const;
 
   /**
    * Specifies if lazy cache loading is used.
    * <p>
    * The default implementation specifies that lazy cache loading is going to be used
-   * and therefore returns <code>true</code>.
+   * and therefore returns <code>true</code>, unless the <code>BlueBerry.noLazyRegistryCacheLoading</code>
+   * property is set to <code>true</code>.
    * </p>
    *
    * @return <code>true</code> if lazy cache loading is used and <code>false</code> otherwise
    */
-  bool CacheLazyLoading() const;
+  virtual bool CacheLazyLoading() const;
 
   /**
    * This method is called as a part of the registry cache validation. The cache is valid
@@ -325,11 +331,14 @@ public:
    * to be a hash value aggregating a number of actual timestamps from the contributions.)
    * </p><p>
    * This method may return 0 to indicate that no time stamp verification is required.
+   * </p><p>
+   * The default implementation combines the extended time stamps (see GetExtendedTimestamp())
+   * of all installed plugins.
    * </p>
    * @return a value corresponding to the last modification time of contributions contained
    * in the registry
    */
-  long GetContributionsTimestamp() const;
+  virtual long GetContributionsTimestamp() const;
 
   bool CheckContributionsTimestamp() const;
 
@@ -0,0 +1,362 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "berryTableReader.h"
+
+#include "berryConfigurationElement.h"
+#include "berryExtension.h"
+#include "berryExtensionPoint.h"
+#include "berryExtensionRegistry.h"
+#include "berryLog.h"
+#include "berryRegistryContribution.h"
+#include "berryRegistryContributor.h"
+#include "berryRegistryIndexElement.h"
+#include "berryRegistryObjectFactory.h"
+#include "berryRegistryObjectManager.h"
+
+#include <QCryptographicHash>
+#include <QLocale>
+
+namespace berry {
+
+const QString TableReader::CACHE_FILE = "registry.cache";
+const quint32 TableReader::CACHE_MAGIC = 0x42425243; // "BBRC"
+const qint32 TableReader::CACHE_VERSION = 2;
+const qint64 TableReader::TABLE_OFFSET_POSITION = 16; // after magic, version, and timestamp
+const int TableReader::CHECKSUM_SIZE = 20; // SHA-1
+
+TableReader::TableReader(ExtensionRegistry* registry)
+  : registry(registry), contributionsOffset(-1), contributorsOffset(-1),
+    namespacesOffset(-1), orphansOffset(-1)
+{
+}
+
+TableReader::~TableReader()
+{
+  Close();
+}
+
+void TableReader::SetCacheFile(const QString& fileName)
+{
+  Close();
+  QMutexLocker l(&mutex);
+  cacheFile.setFileName(fileName);
+}
+
+bool TableReader::LoadTables(long expectedTimestamp, HashtableOfStringAndInt& extensionPoints,
+                             OffsetTable& fileOffsets, int& nextId)
+{
+  QMutexLocker l(&mutex);
+
+  qint64 tableOffset = 0;
+  if (!ReadHeader(expectedTimestamp, tableOffset) || !VerifyChecksum() || !Seek(tableOffset))
+    return false;
+
+  QString locale;
+  qint32 storedNextId = 0;
+  QHash<QString, int> storedExtensionPoints;
+  OffsetTable storedOffsets;
+  qint64 sectionOffsets[4];
+
+  stream >> locale >> storedNextId >> storedExtensionPoints >> storedOffsets;
+  for (qint64& offset : sectionOffsets)
+    stream >> offset;
+
+  if (stream.status() != QDataStream::Ok)
+  {
+    LogReadError("tables");
+    return false;
+  }
+
+  // Translated labels and attributes are stored in the cache
+  if (locale != QLocale().name())
+    return false;
+
+  contributionsOffset = sectionOffsets[0];
+  contributorsOffset = sectionOffsets[1];
+  namespacesOffset = sectionOffsets[2];
+  orphansOffset = sectionOffsets[3];
+
+  extensionPoints.swap(storedExtensionPoints);
+  fileOffsets.swap(storedOffsets);
+  nextId = storedNextId;
+  return true;
+}
+
+SmartPointer<RegistryObject> TableReader::LoadObject(qint64 offset)
+{
+  QMutexLocker l(&mutex);
+
+  if (!Seek(offset))
+    return RegistryObject::Pointer();
+
+  qint8 type = 0;
+  stream >> type;
+
+  RegistryObject::Pointer result;
+  switch (type)
+  {
+  case RegistryObjectManager::EXTENSION_POINT :
+    result = ReadExtensionPoint();
+    break;
+  case RegistryObjectManager::EXTENSION :
+    result = ReadExtension();
+    break;
+  case RegistryObjectManager::CONFIGURATION_ELEMENT :
+    result = ReadConfigurationElement();
+    break;
+  default :
+    break;
+  }
+
+  if (result.IsNull() || stream.status() != QDataStream::Ok)
+  {
+    LogReadError("registry object");
+    return RegistryObject::Pointer();
+  }
+  return result;
+}
+
+KeyedHashSet TableReader::LoadContributions()
+{
+  QMutexLocker l(&mutex);
+
+  KeyedHashSet result;
+  if (!Seek(contributionsOffset))
+    return result;
+
+  qint32 size = 0;
+  stream >> size;
+  for (qint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i)
+  {
+    QString contributorId;
+    QList<int> extensionPoints;
+    QList<int> extensions;
+    stream >> contributorId >> extensionPoints >> extensions;
+
+    // [numberOfExtensionPoints, numberOfExtensions, extensionPoint#1, ..., ext#1, ...]
+    QList<int> children;
+    children << static_cast<int>(extensionPoints.size()) << static_cast<int>(extensions.size());
+    children << extensionPoints << extensions;
+
+    RegistryContribution::Pointer contribution = registry->GetElementFactory()->CreateContribution(contributorId, true);
+    contribution->SetRawChildren(children);
+    result.Add(contribution);
+  }
+
+  if (stream.status() != QDataStream::Ok)
+    LogReadError("contributions");
+  return result;
+}
+
+TableReader::ContributorsMapType TableReader::LoadContributors()
+{
+  QMutexLocker l(&mutex);
+
+  ContributorsMapType result;
+  if (!Seek(contributorsOffset))
+    return result;
+
+  qint32 size = 0;
+  stream >> size;
+  for (qint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i)
+  {
+    QString actualId;
+    QString actualName;
+    QString hostId;
+    QString hostName;
+    stream >> actualId >> actualName >> hostId >> hostName;
+
+    RegistryContributor::Pointer contributor(new RegistryContributor(actualId, actualName, hostId, hostName));
+    result.insert(actualId, contributor);
+  }
+
+  if (stream.status() != QDataStream::Ok)
+    LogReadError("contributors");
+  return result;
+}
+
+KeyedHashSet TableReader::LoadNamespaces()
+{
+  QMutexLocker l(&mutex);
+
+  KeyedHashSet result;
+  if (!Seek(namespacesOffset))
+    return result;
+
+  qint32 size = 0;
+  stream >> size;
+  for (qint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i)
+  {
+    QString key;
+    QList<int> extensionPoints;
+    QList<int> extensions;
+    stream >> key >> extensionPoints >> extensions;
+
+    KeyedElement::Pointer indexElement(new RegistryIndexElement(key, extensionPoints, extensions));
+    result.Add(indexElement);
+  }
+
+  if (stream.status() != QDataStream::Ok)
+    LogReadError("namespaces");
+  return result;
+}
+
+TableReader::OrphansMapType TableReader::LoadOrphans()
+{
+  QMutexLocker l(&mutex);
+
+  OrphansMapType result;
+  if (!Seek(orphansOffset))
+    return result;
+
+  stream >> result;
+
+  if (stream.status() != QDataStream::Ok)
+  {
+    LogReadError("orphans");
+    result.clear();
+  }
+  return result;
+}
+
+void TableReader::Close()
+{
+  QMutexLocker l(&mutex);
+  stream.setDevice(nullptr);
+  cacheFile.close();
+}
+
+bool TableReader::Seek(qint64 offset)
+{
+  if (offset < 0)
+    return false;
+
+  if (!cacheFile.isOpen())
+  {
+    if (cacheFile.fileName().isEmpty() || !cacheFile.open(QIODevice::ReadOnly))
+      return false;
+    stream.setDevice(&cacheFile);
+    stream.setVersion(QDataStream::Qt_6_0);
+  }
+
+  stream.resetStatus();
+  return cacheFile.seek(offset);
+}
+
+bool TableReader::ReadHeader(long expectedTimestamp, qint64& tableOffset)
+{
+  if (!Seek(0))
+    return false;
+
+  quint32 magic = 0;
+  qint32 version = 0;
+  qint64 timestamp = 0;
+  stream >> magic >> version >> timestamp >> tableOffset;
+
+  if (stream.status() != QDataStream::Ok || magic != CACHE_MAGIC)
+  {
+    LogReadError("header");
+    return false;
+  }
+
+  // An outdated cache is not an error, the registry is rebuilt from the plug-in manifests
+  return version == CACHE_VERSION && timestamp == static_cast<qint64>(expectedTimestamp);
+}
+
+bool TableReader::VerifyChecksum()
+{
+  const qint64 dataSize = cacheFile.size() - CHECKSUM_SIZE;
+  if (dataSize <= TABLE_OFFSET_POSITION || !cacheFile.seek(0))
+  {
+    LogReadError("checksum");
+    return false;
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  qint64 remaining = dataSize;
+  while (remaining > 0)
+  {
+    const QByteArray data = cacheFile.read(qMin<qint64>(remaining, 64 * 1024));
+    if (data.isEmpty())
+      break;
+    hash.addData(data);
+    remaining -= data.size();
+  }
+
+  if (remaining != 0 || cacheFile.read(CHECKSUM_SIZE) != hash.result())
+  {
+    LogReadError("checksum");
+    return false;
+  }
+  return true;
+}
+
+SmartPointer<RegistryObject> TableReader::ReadExtensionPoint()
+{
+  qint32 id = 0;
+  QList<int> children;
+  QString label;
+  QString schema;
+  QString uniqueId;
+  QString namespaze;
+  QString contributorId;
+  stream >> id >> children >> label >> schema >> uniqueId >> namespaze >> contributorId;
+
+  ExtensionPoint::Pointer result = registry->GetElementFactory()->CreateExtensionPoint(id, children, -1, true);
+  result->SetLabel(label);
+  result->SetSchema(schema);
+  result->SetUniqueIdentifier(uniqueId);
+  result->SetNamespace(namespaze);
+  result->SetContributorId(contributorId);
+  return result;
+}
+
+SmartPointer<RegistryObject> TableReader::ReadExtension()
+{
+  qint32 id = 0;
+  QString simpleId;
+  QString namespaze;
+  QList<int> children;
+  QString label;
+  QString extensionPointId;
+  QString contributorId;
+  stream >> id >> simpleId >> namespaze >> children >> label >> extensionPointId >> contributorId;
+
+  Extension::Pointer result = registry->GetElementFactory()->CreateExtension(id, simpleId, namespaze, children, -1, true);
+  result->SetLabel(label);
+  result->SetExtensionPointIdentifier(extensionPointId);
+  result->SetContributorId(contributorId);
+  return result;
+}
+
+SmartPointer<RegistryObject> TableReader::ReadConfigurationElement()
+{
+  qint32 id = 0;
+  QString contributorId;
+  QString name;
+  QList<QString> propertiesAndValue;
+  QList<int> children;
+  qint32 parentId = 0;
+  qint16 parentType = 0;
+  stream >> id >> contributorId >> name >> propertiesAndValue >> children >> parentId >> parentType;
+
+  return registry->GetElementFactory()->CreateConfigurationElement(id, contributorId, name, propertiesAndValue,
+                                                                   children, -1, parentId, parentType, true);
+}
+
+void TableReader::LogReadError(const QString& what) const
+{
+  BERRY_WARN << "Unable to read the " << what << " from the registry cache " << cacheFile.fileName();
+}
+
+}
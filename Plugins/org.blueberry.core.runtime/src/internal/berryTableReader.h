@@ -0,0 +1,143 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef BERRYTABLEREADER_H
+#define BERRYTABLEREADER_H
+
+#include "berryHashtableOfStringAndInt.h"
+#include "berryKeyedHashSet.h"
+
+#include <org_blueberry_core_runtime_Export.h>
+
+#include <QDataStream>
+#include <QFile>
+#include <QMutex>
+
+namespace berry {
+
+class ExtensionRegistry;
+class RegistryContributor;
+class RegistryObject;
+
+/**
+ * Reads the registry cache written by the TableWriter.
+ * <p>
+ * The cache is a single binary file. Its header identifies the file format version and
+ * the contributions timestamp the cache was written for. The table of extension points
+ * and the file offsets of all registry objects are read on startup. Registry objects,
+ * contributions, contributors, namespaces, and orphans are read when they are accessed
+ * for the first time; the file stays open until Close() is called.
+ * </p><p>
+ * Cache file layout (QDataStream):
+ * <pre>
+ * header:   magic, version, contributions timestamp, offset of the table
+ * main:     registry objects; an extension point is followed by its extensions,
+ *           an extension or configuration element by its configuration elements
+ * sections: contributions, contributors, namespaces, orphans
+ * table:    locale, next object id, extension points, object offsets, section offsets
+ * checksum: SHA-1 of everything above (raw bytes)
+ * </pre>
+ * </p><p>
+ * The checksum is verified on startup, so that a truncated or otherwise corrupt cache
+ * is detected before any object is read lazily.
+ * </p>
+ *
+ * Exported for the registry tests only, this class is not part of the API.
+ */
+class org_blueberry_core_runtime_EXPORT TableReader
+{
+
+public:
+
+  typedef QHash<int, qint64> OffsetTable;
+  typedef QHash<QString, QList<int> > OrphansMapType;
+  typedef QHash<QString, SmartPointer<RegistryContributor> > ContributorsMapType;
+
+  // Name of the cache file in the cache location
+  static const QString CACHE_FILE; // = "registry.cache"
+
+  // Identifies the file as a BlueBerry registry cache
+  static const quint32 CACHE_MAGIC;
+
+  // Increment whenever the layout of the cache file changes
+  static const qint32 CACHE_VERSION;
+
+  // Position of the table offset in the header
+  static const qint64 TABLE_OFFSET_POSITION;
+
+  // Size of the checksum at the end of the file
+  static const int CHECKSUM_SIZE;
+
+  TableReader(ExtensionRegistry* registry);
+
+  ~TableReader();
+
+  void SetCacheFile(const QString& fileName);
+
+  /**
+   * Reads the tables needed on startup. Returns false if the cache can not be read, is
+   * corrupt, or was written for a different version, timestamp, or locale. The output
+   * arguments are only modified on success.
+   */
+  bool LoadTables(long expectedTimestamp, HashtableOfStringAndInt& extensionPoints,
+                  OffsetTable& fileOffsets, int& nextId);
+
+  /**
+   * Reads the registry object at the given offset. Returns a null pointer if the
+   * object can not be read.
+   */
+  SmartPointer<RegistryObject> LoadObject(qint64 offset);
+
+  KeyedHashSet LoadContributions();
+
+  ContributorsMapType LoadContributors();
+
+  KeyedHashSet LoadNamespaces();
+
+  OrphansMapType LoadOrphans();
+
+  void Close();
+
+private:
+
+  ExtensionRegistry* registry;
+
+  QMutex mutex;
+
+  QFile cacheFile;
+  QDataStream stream;
+
+  qint64 contributionsOffset;
+  qint64 contributorsOffset;
+  qint64 namespacesOffset;
+  qint64 orphansOffset;
+
+  // Opens the cache file if necessary and moves to the given offset
+  bool Seek(qint64 offset);
+
+  bool ReadHeader(long expectedTimestamp, qint64& tableOffset);
+
+  bool VerifyChecksum();
+
+  SmartPointer<RegistryObject> ReadExtensionPoint();
+
+  SmartPointer<RegistryObject> ReadExtension();
+
+  SmartPointer<RegistryObject> ReadConfigurationElement();
+
+  void LogReadError(const QString& what) const;
+
+};
+
+}
+
+#endif // BERRYTABLEREADER_H
@@ -0,0 +1,292 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "berryTableWriter.h"
+
+#include "berryConfigurationElement.h"
+#include "berryExtension.h"
+#include "berryExtensionPoint.h"
+#include "berryInvalidRegistryObjectException.h"
+#include "berryRegistryContribution.h"
+#include "berryRegistryContributor.h"
+#include "berryRegistryIndexElement.h"
+#include "berryRegistryObjectManager.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QIODevice>
+#include <QLocale>
+
+namespace berry {
+
+TableWriter::TableWriter()
+  : objectManager(nullptr)
+{
+}
+
+bool TableWriter::SaveCache(RegistryObjectManager* objectManager, long timestamp, QIODevice* device)
+{
+  this->objectManager = objectManager;
+  offsets.clear();
+
+  // The cache is written into memory first, so that its checksum can be appended
+  QByteArray data;
+  QBuffer buffer(&data);
+  buffer.open(QIODevice::WriteOnly);
+
+  stream.setDevice(&buffer);
+  stream.setVersion(QDataStream::Qt_6_0);
+
+  // header; the table offset is known at the end
+  stream << TableReader::CACHE_MAGIC << TableReader::CACHE_VERSION
+         << static_cast<qint64>(timestamp) << static_cast<qint64>(-1);
+
+  // main data: extension point trees first, so that an extension point is read
+  // together with its extensions; then everything not reachable from an extension point
+  foreach (int id, objectManager->GetExtensionPoints())
+  {
+    SaveObject(id, RegistryObjectManager::EXTENSION_POINT);
+  }
+  foreach (const QList<int>& orphans, objectManager->GetOrphanExtensions())
+  {
+    SaveChildren(orphans, RegistryObjectManager::EXTENSION);
+  }
+  foreach (const KeyedHashSet& contributions, objectManager->GetContributions())
+  {
+    foreach (KeyedElement::Pointer element, contributions.Elements())
+    {
+      RegistryContribution::Pointer contribution = element.Cast<RegistryContribution>();
+      SaveChildren(contribution->GetExtensionPoints(), RegistryObjectManager::EXTENSION_POINT);
+      SaveChildren(contribution->GetExtensions(), RegistryObjectManager::EXTENSION);
+    }
+  }
+
+  QList<qint64> sectionOffsets;
+  sectionOffsets << buffer.pos();
+  SaveContributions();
+  sectionOffsets << buffer.pos();
+  SaveContributors();
+  sectionOffsets << buffer.pos();
+  SaveNamespaces();
+  sectionOffsets << buffer.pos();
+  SaveOrphans();
+
+  const qint64 tableOffset = buffer.pos();
+  SaveTables(sectionOffsets);
+
+  bool result = buffer.seek(TableReader::TABLE_OFFSET_POSITION);
+  if (result)
+  {
+    stream << tableOffset;
+    result = stream.status() == QDataStream::Ok;
+  }
+  stream.setDevice(nullptr);
+  if (!result)
+    return false;
+
+  const QByteArray checksum = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+  return device->write(data) == data.size() && device->write(checksum) == TableReader::CHECKSUM_SIZE;
+}
+
+void TableWriter::SaveObject(int id, short type)
+{
+  if (offsets.contains(id))
+    return;
+
+  RegistryObject::Pointer object;
+  try
+  {
+    object = objectManager->GetObject(id, type);
+  }
+  catch (const InvalidRegistryObjectException&)
+  {
+    return; // the object has been removed
+  }
+
+  if (object.IsNull() || !object->ShouldPersist())
+    return;
+
+  offsets.insert(id, stream.device()->pos());
+
+  if (object.Cast<ExtensionPoint>())
+  {
+    SaveExtensionPoint(object);
+    SaveChildren(object->GetRawChildren(), RegistryObjectManager::EXTENSION);
+  }
+  else if (object.Cast<Extension>())
+  {
+    SaveExtension(object);
+    SaveChildren(object->GetRawChildren(), RegistryObjectManager::CONFIGURATION_ELEMENT);
+  }
+  else
+  {
+    SaveConfigurationElement(object);
+    SaveChildren(object->GetRawChildren(), object->NoExtraData() ? RegistryObjectManager::CONFIGURATION_ELEMENT
+                                                                 : RegistryObjectManager::THIRDLEVEL_CONFIGURATION_ELEMENT);
+  }
+}
+
+void TableWriter::SaveExtensionPoint(const SmartPointer<RegistryObject>& object)
+{
+  ExtensionPoint::Pointer extensionPoint = object.Cast<ExtensionPoint>();
+  QList<QString> extraData = extensionPoint->GetExtraData();
+
+  stream << static_cast<qint8>(RegistryObjectManager::EXTENSION_POINT)
+         << static_cast<qint32>(extensionPoint->GetObjectId())
+         << FilterPersisted(extensionPoint->GetRawChildren())
+         << extraData[ExtensionPoint::LABEL]
+         << extraData[ExtensionPoint::SCHEMA]
+         << extraData[ExtensionPoint::QUALIFIED_NAME]
+         << extraData[ExtensionPoint::NAMESPACE]
+         << extraData[ExtensionPoint::CONTRIBUTOR_ID];
+}
+
+void TableWriter::SaveExtension(const SmartPointer<RegistryObject>& object)
+{
+  Extension::Pointer extension = object.Cast<Extension>();
+  QList<QString> extraData = extension->GetExtraData();
+
+  stream << static_cast<qint8>(RegistryObjectManager::EXTENSION)
+         << static_cast<qint32>(extension->GetObjectId())
+         << extension->GetSimpleIdentifier()
+         << extension->GetNamespaceIdentifier()
+         << FilterPersisted(extension->GetRawChildren())
+         << extraData[Extension::LABEL]
+         << extraData[Extension::XPT_NAME]
+         << extraData[Extension::CONTRIBUTOR_ID];
+}
+
+void TableWriter::SaveConfigurationElement(const SmartPointer<RegistryObject>& object)
+{
+  ConfigurationElement::Pointer element = object.Cast<ConfigurationElement>();
+
+  stream << static_cast<qint8>(RegistryObjectManager::CONFIGURATION_ELEMENT)
+         << static_cast<qint32>(element->GetObjectId())
+         << element->GetContributorId()
+         << element->GetName()
+         << element->GetPropertiesAndValue()
+         << FilterPersisted(element->GetRawChildren())
+         << static_cast<qint32>(element->parentId)
+         << static_cast<qint16>(element->parentType);
+}
+
+void TableWriter::SaveChildren(const QList<int>& children, short type)
+{
+  foreach (int id, children)
+  {
+    SaveObject(id, type);
+  }
+}
+
+void TableWriter::SaveContributions()
+{
+  QList<RegistryContribution::Pointer> contributions;
+  foreach (const KeyedHashSet& contributionSet, objectManager->GetContributions())
+  {
+    foreach (KeyedElement::Pointer element, contributionSet.Elements())
+    {
+      RegistryContribution::Pointer contribution = element.Cast<RegistryContribution>();
+      if (contribution->ShouldPersist())
+        contributions.push_back(contribution);
+    }
+  }
+
+  stream << static_cast<qint32>(contributions.size());
+  foreach (RegistryContribution::Pointer contribution, contributions)
+  {
+    stream << contribution->GetContributorId()
+           << FilterSaved(contribution->GetExtensionPoints())
+           << FilterSaved(contribution->GetExtensions());
+  }
+}
+
+void TableWriter::SaveContributors()
+{
+  const RegistryObjectManager::ContributorsMapType& contributors = objectManager->GetContributors();
+
+  stream << static_cast<qint32>(contributors.size());
+  foreach (RegistryContributor::Pointer contributor, contributors)
+  {
+    stream << contributor->GetActualId() << contributor->GetActualName()
+           << contributor->GetId() << contributor->GetName();
+  }
+}
+
+void TableWriter::SaveNamespaces()
+{
+  QList<KeyedElement::Pointer> namespaces = objectManager->GetNamespacesIndex().Elements();
+
+  stream << static_cast<qint32>(namespaces.size());
+  foreach (KeyedElement::Pointer element, namespaces)
+  {
+    RegistryIndexElement::Pointer indexElement = element.Cast<RegistryIndexElement>();
+    stream << indexElement->GetKey()
+           << FilterSaved(indexElement->GetExtensionPoints())
+           << FilterSaved(indexElement->GetExtensions());
+  }
+}
+
+void TableWriter::SaveOrphans()
+{
+  TableReader::OrphansMapType orphans;
+  const TableReader::OrphansMapType orphanExtensions = objectManager->GetOrphanExtensions();
+  for (auto iter = orphanExtensions.cbegin(); iter != orphanExtensions.cend(); ++iter)
+  {
+    QList<int> extensions = FilterSaved(iter.value());
+    if (!extensions.empty())
+      orphans.insert(iter.key(), extensions);
+  }
+
+  stream << orphans;
+}
+
+void TableWriter::SaveTables(const QList<qint64>& sectionOffsets)
+{
+  QHash<QString, int> extensionPoints;
+  const HashtableOfStringAndInt allExtensionPoints = objectManager->GetExtensionPoints();
+  for (auto iter = allExtensionPoints.cbegin(); iter != allExtensionPoints.cend(); ++iter)
+  {
+    if (offsets.contains(iter.value()))
+      extensionPoints.insert(iter.key(), iter.value());
+  }
+
+  stream << QLocale().name() << static_cast<qint32>(objectManager->GetNextId())
+         << extensionPoints << offsets;
+  foreach (qint64 offset, sectionOffsets)
+  {
+    stream << offset;
+  }
+}
+
+QList<int> TableWriter::FilterPersisted(const QList<int>& ids) const
+{
+  QList<int> result;
+  foreach (int id, ids)
+  {
+    if (objectManager->ShouldPersist(id))
+      result.push_back(id);
+  }
+  return result;
+}
+
+QList<int> TableWriter::FilterSaved(const QList<int>& ids) const
+{
+  QList<int> result;
+  foreach (int id, ids)
+  {
+    if (offsets.contains(id))
+      result.push_back(id);
+  }
+  return result;
+}
+
+}
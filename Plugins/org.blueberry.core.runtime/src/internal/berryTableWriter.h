@@ -0,0 +1,84 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef BERRYTABLEWRITER_H
+#define BERRYTABLEWRITER_H
+
+#include "berryTableReader.h"
+
+class QIODevice;
+
+namespace berry {
+
+class RegistryObjectManager;
+
+/**
+ * Writes the persisted content of the registry into the cache read by the TableReader.
+ * Objects which are not persisted (see RegistryObject::ShouldPersist()) are left out,
+ * including their ids in the children of persisted objects.
+ */
+class TableWriter
+{
+
+public:
+
+  TableWriter();
+
+  /**
+   * Writes the cache for the given contributions timestamp, followed by its checksum.
+   * Registry objects which have not been loaded yet are read from the current cache
+   * while writing.
+   *
+   * @return true if the cache was written successfully
+   */
+  bool SaveCache(RegistryObjectManager* objectManager, long timestamp, QIODevice* device);
+
+private:
+
+  RegistryObjectManager* objectManager;
+
+  QDataStream stream;
+
+  // offsets of the objects written so far
+  TableReader::OffsetTable offsets;
+
+  void SaveObject(int id, short type);
+
+  void SaveExtensionPoint(const SmartPointer<RegistryObject>& object);
+
+  void SaveExtension(const SmartPointer<RegistryObject>& object);
+
+  void SaveConfigurationElement(const SmartPointer<RegistryObject>& object);
+
+  void SaveChildren(const QList<int>& children, short type);
+
+  void SaveContributions();
+
+  void SaveContributors();
+
+  void SaveNamespaces();
+
+  void SaveOrphans();
+
+  void SaveTables(const QList<qint64>& sectionOffsets);
+
+  // Used for the children of objects, which are written before their children
+  QList<int> FilterPersisted(const QList<int>& ids) const;
+
+  // Used for the sections, which are written after all objects
+  QList<int> FilterSaved(const QList<int>& ids) const;
+
+};
+
+}
+
+#endif // BERRYTABLEWRITER_H
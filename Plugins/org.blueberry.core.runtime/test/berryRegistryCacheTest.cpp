@@ -0,0 +1,345 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "berryExtensionRegistry.h"
+#include "berryRegistryContributor.h"
+#include "berryRegistryStrategy.h"
+#include "berryTableReader.h"
+
+#include <berryIConfigurationElement.h>
+#include <berryIExtension.h>
+#include <berryIExtensionPoint.h>
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+  const char* const PROVIDER_MANIFEST =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<?BlueBerry version=\"0.1\"?>\n"
+    "<plugin>\n"
+    "  <extension-point id=\"org.blueberry.test.views\" name=\"Views\" schema=\"schema/views.exsd\"/>\n"
+    "  <extension-point id=\"org.blueberry.test.editors\" name=\"Editors\" schema=\"schema/editors.exsd\"/>\n"
+    "  <extension id=\"defaultViews\" name=\"Default Views\" point=\"org.blueberry.test.views\">\n"
+    "    <view id=\"org.blueberry.test.views.first\" name=\"First\" class=\"berry::FirstView\">\n"
+    "      <description>The first view</description>\n"
+    "      <keywordReference id=\"first\"/>\n"
+    "      <keywordReference id=\"view\"/>\n"
+    "    </view>\n"
+    "    <view id=\"org.blueberry.test.views.second\" name=\"Second\" class=\"berry::SecondView\"/>\n"
+    "  </extension>\n"
+    "</plugin>\n";
+
+  const char* const CONSUMER_MANIFEST =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<?BlueBerry version=\"0.1\"?>\n"
+    "<plugin>\n"
+    "  <extension id=\"moreViews\" point=\"org.blueberry.test.views\">\n"
+    "    <view id=\"org.blueberry.test.views.third\" name=\"Third\" class=\"berry::ThirdView\">\n"
+    "      <category id=\"tools\">\n"
+    "        <description>Nested three levels deep</description>\n"
+    "      </category>\n"
+    "    </view>\n"
+    "  </extension>\n"
+    "  <extension id=\"textEditor\" name=\"Text Editor\" point=\"org.blueberry.test.editors\">\n"
+    "    <editor id=\"org.blueberry.test.editors.text\" extensions=\"txt,log\" default=\"true\"/>\n"
+    "  </extension>\n"
+    "  <extension id=\"orphan\" point=\"org.blueberry.test.missing\">\n"
+    "    <element value=\"kept as orphan\"/>\n"
+    "  </extension>\n"
+    "</plugin>\n";
+
+  /**
+   * Registry strategy that uses the given cache location and adds the plug-in manifests
+   * above if the registry could not be filled from the cache, like the plug-in listener
+   * of the default strategy does for the installed plug-ins.
+   */
+  class TestRegistryStrategy : public berry::RegistryStrategy
+  {
+  public:
+    TestRegistryStrategy(const QString& cacheLocation, QObject* key, long timestamp, bool lazyLoading,
+                         bool& loadedFromCache)
+      : RegistryStrategy(QList<QString>() << cacheLocation, QList<bool>() << false, key),
+        m_Key(key), m_Timestamp(timestamp), m_LazyLoading(lazyLoading), m_LoadedFromCache(loadedFromCache)
+    {
+    }
+
+    void OnStart(berry::IExtensionRegistry* registry, bool loadedFromCache) override
+    {
+      m_LoadedFromCache = loadedFromCache;
+      if (loadedFromCache)
+        return;
+
+      AddManifest(registry, "1", "org.blueberry.test.provider", PROVIDER_MANIFEST);
+      AddManifest(registry, "2", "org.blueberry.test.consumer", CONSUMER_MANIFEST);
+    }
+
+    void OnStop(berry::IExtensionRegistry*) override
+    {
+    }
+
+    bool CacheUse() const override
+    {
+      return true;
+    }
+
+    bool CacheLazyLoading() const override
+    {
+      return m_LazyLoading;
+    }
+
+    long GetContributionsTimestamp() const override
+    {
+      return m_Timestamp;
+    }
+
+  private:
+    QObject* m_Key;
+    long m_Timestamp;
+    bool m_LazyLoading;
+    bool& m_LoadedFromCache;
+
+    void AddManifest(berry::IExtensionRegistry* registry, const QString& id, const QString& name, const char* manifest)
+    {
+      QByteArray ba(manifest);
+      QBuffer buffer(&ba);
+      berry::IContributor::Pointer contributor(new berry::RegistryContributor(id, name, QString(), QString()));
+      if (!registry->AddContribution(&buffer, contributor, true, "plugin.xml", nullptr, m_Key))
+        std::cout << "Unable to add the manifest of " << name.toStdString() << std::endl;
+    }
+  };
+
+  QString DescribeContributor(const berry::IContributor::Pointer& contributor)
+  {
+    berry::RegistryContributor::Pointer registryContributor = contributor.Cast<berry::RegistryContributor>();
+    if (registryContributor.IsNull())
+      return "<none>";
+
+    return QString("%1/%2/%3/%4").arg(registryContributor->GetActualId(), registryContributor->GetActualName(),
+                                      registryContributor->GetId(), registryContributor->GetName());
+  }
+
+  void DescribeConfigurationElement(const berry::IConfigurationElement::Pointer& element, const QString& indent,
+                                    QStringList& description)
+  {
+    QStringList attributes;
+    foreach (const QString& name, element->GetAttributeNames())
+    {
+      attributes << name + "=" + element->GetAttribute(name);
+    }
+    attributes.sort();
+
+    description << indent + "element " + element->GetName() + " [" + attributes.join(", ") + "] value=" +
+                     element->GetValue() + " contributor=" + DescribeContributor(element->GetContributor());
+
+    foreach (const berry::IConfigurationElement::Pointer& child, element->GetChildren())
+    {
+      DescribeConfigurationElement(child, indent + "  ", description);
+    }
+  }
+
+  void DescribeExtension(const berry::IExtension::Pointer& extension, const QString& indent, QStringList& description)
+  {
+    description << indent + "extension " + extension->GetUniqueIdentifier() + " label=" + extension->GetLabel() +
+                     " point=" + extension->GetExtensionPointUniqueIdentifier() +
+                     " namespace=" + extension->GetNamespaceIdentifier() +
+                     " contributor=" + DescribeContributor(extension->GetContributor());
+
+    foreach (const berry::IConfigurationElement::Pointer& element, extension->GetConfigurationElements())
+    {
+      DescribeConfigurationElement(element, indent + "  ", description);
+    }
+  }
+
+  template <class T>
+  QList<typename T::Pointer> SortedByIdentifier(QList<typename T::Pointer> objects)
+  {
+    std::sort(objects.begin(), objects.end(), [](const typename T::Pointer& a, const typename T::Pointer& b) {
+      return a->GetUniqueIdentifier() < b->GetUniqueIdentifier();
+    });
+    return objects;
+  }
+
+  /**
+   * Describes everything the registry provides through its public interface, including the
+   * orphaned extension, which is only found through its namespace.
+   */
+  QStringList DescribeRegistry(berry::IExtensionRegistry* registry)
+  {
+    QStringList description;
+
+    QList<QString> namespaces = registry->GetNamespaces();
+    std::sort(namespaces.begin(), namespaces.end());
+
+    foreach (const QString& namespaze, namespaces)
+    {
+      description << "namespace " + namespaze;
+
+      foreach (const berry::IExtensionPoint::Pointer& extensionPoint,
+               SortedByIdentifier<berry::IExtensionPoint>(registry->GetExtensionPoints(namespaze)))
+      {
+        description << "  extension point " + extensionPoint->GetUniqueIdentifier() +
+                           " label=" + extensionPoint->GetLabel() +
+                           " contributor=" + DescribeContributor(extensionPoint->GetContributor());
+
+        foreach (const berry::IExtension::Pointer& extension,
+                 SortedByIdentifier<berry::IExtension>(extensionPoint->GetExtensions()))
+        {
+          DescribeExtension(extension, "    ", description);
+        }
+      }
+
+      foreach (const berry::IExtension::Pointer& extension,
+               SortedByIdentifier<berry::IExtension>(registry->GetExtensions(namespaze)))
+      {
+        DescribeExtension(extension, "  ", description);
+      }
+    }
+
+    return description;
+  }
+
+  QString GetCacheFile(const QString& cacheLocation)
+  {
+    return QDir(cacheLocation).filePath(berry::TableReader::CACHE_FILE);
+  }
+
+  /**
+   * Starts a registry, describes its content, and stops it again. The registry writes the
+   * cache on Stop() if it was filled from the plug-in manifests.
+   *
+   * @param truncateAfterStart empties the cache file right after the registry started
+   */
+  QStringList RunRegistry(const QString& cacheLocation, long timestamp, bool lazyLoading, bool& loadedFromCache,
+                          bool truncateAfterStart = false)
+  {
+    QObject masterToken;
+    QObject userToken;
+    auto strategy = new TestRegistryStrategy(cacheLocation, &masterToken, timestamp, lazyLoading, loadedFromCache);
+    QScopedPointer<berry::ExtensionRegistry> registry(new berry::ExtensionRegistry(strategy, &masterToken, &userToken));
+
+    if (truncateAfterStart)
+    {
+      QFile cacheFile(GetCacheFile(cacheLocation));
+      cacheFile.resize(0);
+    }
+
+    const QStringList description = DescribeRegistry(registry.data());
+    registry->Stop(&masterToken);
+    return description;
+  }
+
+  bool Check(const QString& name, const QStringList& expected, const QStringList& actual,
+             bool expectedFromCache, bool loadedFromCache)
+  {
+    bool result = true;
+    if (expectedFromCache != loadedFromCache)
+    {
+      std::cout << name.toStdString() << ": registry was " << (loadedFromCache ? "" : "not ")
+                << "filled from the cache" << std::endl;
+      result = false;
+    }
+    if (expected != actual)
+    {
+      std::cout << name.toStdString() << ": registry content differs" << std::endl
+                << "expected:" << std::endl << expected.join("\n").toStdString() << std::endl
+                << "actual:" << std::endl << actual.join("\n").toStdString() << std::endl;
+      result = false;
+    }
+    return result;
+  }
+
+  bool ModifyCacheFile(const QString& cacheLocation, qint64 position, const QByteArray& data)
+  {
+    QFile cacheFile(GetCacheFile(cacheLocation));
+    return cacheFile.open(QIODevice::ReadWrite) && cacheFile.seek(position) && cacheFile.write(data) == data.size();
+  }
+
+  bool TruncateCacheFile(const QString& cacheLocation)
+  {
+    QFile cacheFile(GetCacheFile(cacheLocation));
+    return cacheFile.resize(cacheFile.size() / 2);
+  }
+}
+
+int berryRegistryCacheTest(int /*argc*/, char* /*argv*/ [])
+{
+  QTemporaryDir cacheDir;
+  if (!cacheDir.isValid())
+  {
+    std::cout << "Unable to create a temporary cache location" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const QString cacheLocation = cacheDir.path();
+
+  bool success = true;
+  bool loadedFromCache = false;
+
+  // The first start parses the manifests and writes the cache
+  const QStringList expected = RunRegistry(cacheLocation, 1, true, loadedFromCache);
+  success = Check("initial start", expected, expected, false, loadedFromCache) && success;
+  if (expected.size() < 10 || !QFile::exists(GetCacheFile(cacheLocation)))
+  {
+    std::cout << "Manifests were not parsed or the cache was not written" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  QStringList actual = RunRegistry(cacheLocation, 1, true, loadedFromCache);
+  success = Check("lazy loading", expected, actual, true, loadedFromCache) && success;
+
+  actual = RunRegistry(cacheLocation, 1, false, loadedFromCache);
+  success = Check("eager loading", expected, actual, true, loadedFromCache) && success;
+
+  // Eager loading reads everything on startup, the cache file is not needed afterwards
+  actual = RunRegistry(cacheLocation, 1, false, loadedFromCache, true);
+  success = Check("eager loading without cache file", expected, actual, true, loadedFromCache) && success;
+
+  // The emptied cache file is not usable, the manifests are parsed again and the cache is rewritten
+  actual = RunRegistry(cacheLocation, 1, true, loadedFromCache);
+  success = Check("empty cache file", expected, actual, false, loadedFromCache) && success;
+
+  // A changed plug-in invalidates the cache
+  actual = RunRegistry(cacheLocation, 2, true, loadedFromCache);
+  success = Check("timestamp mismatch", expected, actual, false, loadedFromCache) && success;
+
+  actual = RunRegistry(cacheLocation, 2, true, loadedFromCache);
+  success = Check("rewritten cache", expected, actual, true, loadedFromCache) && success;
+
+  success = TruncateCacheFile(cacheLocation) && success;
+  actual = RunRegistry(cacheLocation, 2, true, loadedFromCache);
+  success = Check("truncated cache file", expected, actual, false, loadedFromCache) && success;
+
+  success = ModifyCacheFile(cacheLocation, 0, "XXXX") && success;
+  actual = RunRegistry(cacheLocation, 2, true, loadedFromCache);
+  success = Check("corrupt header", expected, actual, false, loadedFromCache) && success;
+
+  // the type of the first registry object, right after the header
+  success = ModifyCacheFile(cacheLocation, berry::TableReader::TABLE_OFFSET_POSITION + 8, QByteArray(1, '\x7f')) && success;
+  actual = RunRegistry(cacheLocation, 2, true, loadedFromCache);
+  success = Check("corrupt object with lazy loading", expected, actual, false, loadedFromCache) && success;
+
+  success = ModifyCacheFile(cacheLocation, berry::TableReader::TABLE_OFFSET_POSITION + 8, QByteArray(1, '\x7f')) && success;
+  actual = RunRegistry(cacheLocation, 2, false, loadedFromCache);
+  success = Check("corrupt object with eager loading", expected, actual, false, loadedFromCache) && success;
+
+  actual = RunRegistry(cacheLocation, 2, true, loadedFromCache);
+  success = Check("cache rewritten after corruption", expected, actual, true, loadedFromCache) && success;
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -69,8 +69,8 @@ void org_mitk_core_services_Activator::start(ctkPluginContext* context)
 {
   pluginContext = context;
 
-  //initialize logging
-  mitk::LogBackend::Register();
+  //initialize logging (the framework property is set by the "Log.async" command line option)
+  mitk::LogBackend::Register(context->getProperty("Log.async").toBool());
   QString logFilenamePrefix = "mitk";
   QFileInfo path = context->getDataFile(logFilenamePrefix);
   try